@@ -435,7 +435,7 @@ OMR::CodeGenerator::allocateSpill(bool containsCollectedReference, int32_t *offs
 TR_BackingStore *
 OMR::CodeGenerator::allocateSpill(int32_t dataSize, bool containsCollectedReference, int32_t *offset, bool reuse)
    {
-   TR_ASSERT_FATAL(dataSize <= 16, "assertion failure");
+   TR_ASSERT_FATAL(dataSize <= 16 || dataSize == 32 || dataSize == 64, "assertion failure");
    TR_ASSERT_FATAL(!containsCollectedReference || (dataSize == TR::Compiler->om.sizeofReferenceAddress()), "assertion failure");
 
    if (self()->comp()->getOption(TR_TraceRA))
@@ -458,6 +458,8 @@ OMR::CodeGenerator::allocateSpill(int32_t dataSize, bool containsCollectedRefere
    //
    bool try8ByteSpills = (dataSize < 16) && ((TR::Compiler->om.sizeofReferenceAddress() == 8) || !containsCollectedReference);
    bool try16ByteSpills = (dataSize == 16);
+   bool try32ByteSpills = (dataSize == 32);
+   bool try64ByteSpills = (dataSize == 64);
 
    if(reuse)
      {
@@ -476,6 +478,16 @@ OMR::CodeGenerator::allocateSpill(int32_t dataSize, bool containsCollectedRefere
        spill = self()->getSpill16FreeList().front();
        self()->getSpill16FreeList().pop_front();
      }
+     if (!spill && try32ByteSpills && !self()->getSpill32FreeList().empty())
+     {
+       spill = self()->getSpill32FreeList().front();
+       self()->getSpill32FreeList().pop_front();
+     }
+     if (!spill && try64ByteSpills && !self()->getSpill64FreeList().empty())
+     {
+       spill = self()->getSpill64FreeList().front();
+       self()->getSpill64FreeList().pop_front();
+     }
      if (
          (spill && self()->comp()->getOption(TR_TraceRA) && !performTransformation(self()->comp(), "O^O SPILL TEMPS: Reuse spill temp %s\n", self()->getDebug()->getName(spill->getSymbolReference()))))
        {
@@ -504,7 +516,7 @@ OMR::CodeGenerator::allocateSpill(int32_t dataSize, bool containsCollectedRefere
       //
       int spillSize = std::max(dataSize, static_cast<int32_t>(TR::Compiler->om.sizeofReferenceAddress()));
 
-      TR_ASSERT(4 <= spillSize && spillSize <= 16, "Spill temps should be between 4 and 16 bytes");
+      TR_ASSERT((4 <= spillSize && spillSize <= 16) || spillSize == 32 || spillSize == 64, "Spill temps should be between 4 and 16 bytes, or hold a 32 or 64 byte vector");
       spillSymbol = TR::AutomaticSymbol::create(self()->trHeapMemory(),TR::NoType,spillSize);
       spillSymbol->setSpillTempAuto();
       self()->comp()->getMethodSymbol()->addAutomatic(spillSymbol);
@@ -556,9 +568,9 @@ OMR::CodeGenerator::allocateSpill(int32_t dataSize, bool containsCollectedRefere
 void
 OMR::CodeGenerator::freeSpill(TR_BackingStore *spill, int32_t dataSize, int32_t offset)
    {
-   TR_ASSERT(1 <= dataSize && dataSize <= 16, "assertion failure");
+   TR_ASSERT((1 <= dataSize && dataSize <= 16) || dataSize == 32 || dataSize == 64, "assertion failure");
    TR_ASSERT(offset == 0 || offset == 4, "assertion failure");
-   TR_ASSERT(dataSize + offset <= 16, "assertion failure");
+   TR_ASSERT(dataSize + offset <= 16 || offset == 0, "assertion failure");
 
    if (self()->comp()->getOption(TR_TraceRA))
       {
@@ -659,6 +671,18 @@ OMR::CodeGenerator::freeSpill(TR_BackingStore *spill, int32_t dataSize, int32_t
             if (self()->comp()->getOption(TR_TraceRA))
                traceMsg(self()->comp(), "\n -> added to spill16FreeList");
             }
+         else if (spill->getSymbolReference()->getSymbol()->getSize() == 32)
+            {
+            _spill32FreeList.push_front(spill);
+            if (self()->comp()->getOption(TR_TraceRA))
+               traceMsg(self()->comp(), "\n -> added to spill32FreeList");
+            }
+         else if (spill->getSymbolReference()->getSymbol()->getSize() == 64)
+            {
+            _spill64FreeList.push_front(spill);
+            if (self()->comp()->getOption(TR_TraceRA))
+               traceMsg(self()->comp(), "\n -> added to spill64FreeList");
+            }
          }
       }
    }
@@ -671,6 +695,8 @@ OMR::CodeGenerator::jettisonAllSpills()
    _spill4FreeList.clear();
    _spill8FreeList.clear();
    _spill16FreeList.clear();
+   _spill32FreeList.clear();
+   _spill64FreeList.clear();
    _internalPointerSpillFreeList.clear();
    }
 
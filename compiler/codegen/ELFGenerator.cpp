@@ -23,6 +23,7 @@
 #if defined(LINUX)
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <unistd.h>
 #include <elf.h>
@@ -45,6 +46,22 @@ TR::ELFRelocatableGenerator::ELFRelocatableGenerator(TR::RawAllocator rawAllocat
                                 initialize();
                             }
 
+TR::ELFGenerator::~ELFGenerator() throw()
+{
+    ELFSectionHeader *sections[] = { _zeroSection, _textSection, _dataSection, _relaSection,
+                                     _dynSymSection, _shStrTabSection, _dynStrSection };
+    for (size_t i = 0; i < sizeof(sections) / sizeof(sections[0]); i++)
+    {
+        if (sections[i])
+            _rawAllocator.deallocate(sections[i]);
+    }
+
+    if (_programHeader)
+        _rawAllocator.deallocate(_programHeader);
+    if (_header)
+        _rawAllocator.deallocate(_header);
+}
+
 void
 TR::ELFGenerator::initializeELFHeaderForPlatform(void)
 {
@@ -239,61 +256,72 @@ TR::ELFGenerator::emitELFFile(const char * filename)
         return false;
     }
 
-    uint32_t size = 0;
+    writeELFToFile(elfFile);
+
+    fclose(elfFile);
+    
+    return true;
+}
 
-    writeHeaderToFile(elfFile);
+
+void
+TR::ELFGenerator::writeELFToFile(::FILE *fp)
+{
+    writeHeaderToFile(fp);
 
     if (_programHeader)
     {
-        writeProgramHeaderToFile(elfFile);
+        writeProgramHeaderToFile(fp);
     }
 
-    writeCodeSegmentToFile(elfFile);
+    writeCodeSegmentToFile(fp);
     
-    writeDataSegmentToFile(elfFile);
+    writeDataSegmentToFile(fp);
 
-    writeSectionHeaderToFile(elfFile, _zeroSection);
+    writeSectionHeaderToFile(fp, _zeroSection);
 
-    writeSectionHeaderToFile(elfFile, _textSection);
+    writeSectionHeaderToFile(fp, _textSection);
 
-    writeSectionHeaderToFile(elfFile, _dataSection);
+    if (_dataSection)
+    {
+        writeSectionHeaderToFile(fp, _dataSection);
+    }
 
     if (_relaSection)
     {
-        writeSectionHeaderToFile(elfFile, _relaSection);
+        writeSectionHeaderToFile(fp, _relaSection);
     }
 
-    writeSectionHeaderToFile(elfFile, _dynSymSection);
+    writeSectionHeaderToFile(fp, _dynSymSection);
 
-    writeSectionHeaderToFile(elfFile, _shStrTabSection);
+    writeSectionHeaderToFile(fp, _shStrTabSection);
 
-    writeSectionHeaderToFile(elfFile, _dynStrSection);
+    writeSectionHeaderToFile(fp, _dynStrSection);
 
-    writeSectionNameToFile(elfFile, _zeroSectionName, sizeof(_zeroSectionName));
+    writeSectionNameToFile(fp, _zeroSectionName, sizeof(_zeroSectionName));
 
-    writeSectionNameToFile(elfFile, _textSectionName, sizeof(_textSectionName));
+    writeSectionNameToFile(fp, _textSectionName, sizeof(_textSectionName));
 
-    writeSectionNameToFile(elfFile, _dataSectionName, sizeof(_dataSectionName));
+    if (_dataSection)
+    {
+        writeSectionNameToFile(fp, _dataSectionName, sizeof(_dataSectionName));
+    }
 
     if (_relaSection)
     {
-        writeSectionNameToFile(elfFile, _relaSectionName, sizeof(_relaSectionName));
+        writeSectionNameToFile(fp, _relaSectionName, sizeof(_relaSectionName));
     }
-    writeSectionNameToFile(elfFile, _dynSymSectionName, sizeof(_dynSymSectionName));
+    writeSectionNameToFile(fp, _dynSymSectionName, sizeof(_dynSymSectionName));
 
-    writeSectionNameToFile(elfFile, _shStrTabSectionName, sizeof(_shStrTabSectionName));
+    writeSectionNameToFile(fp, _shStrTabSectionName, sizeof(_shStrTabSectionName));
 
-    writeSectionNameToFile(elfFile, _dynStrSectionName, sizeof(_dynStrSectionName));
+    writeSectionNameToFile(fp, _dynStrSectionName, sizeof(_dynStrSectionName));
     
-    writeELFSymbolsToFile(elfFile);
+    writeELFSymbolsToFile(fp);
     if(_relaSection)
     {
-        writeRelaEntriesToFile(elfFile);
+        writeRelaEntriesToFile(fp);
     }
-
-    fclose(elfFile);
-    
-    return true;
 }
 
 
@@ -522,6 +550,38 @@ TR::ELFExecutableGenerator::emitELF(const char * filename,
     return emitELFFile(filename);
 }
 
+bool
+TR::ELFExecutableGenerator::emitELFToMemory(uint8_t **buffer, size_t *size,
+                CodeCacheSymbol *symbols, uint32_t numSymbols,
+                uint32_t totalELFSymbolNamesLength)
+{
+    _symbols = symbols;
+    _numSymbols = numSymbols;
+    _totalELFSymbolNamesLength = totalELFSymbolNamesLength;
+
+    buildSectionHeaders();
+
+    char *image = NULL;
+    size_t imageSize = 0;
+    ::FILE *stream = open_memstream(&image, &imageSize);
+    if (NULL == stream)
+    {
+        return false;
+    }
+
+    writeELFToFile(stream);
+
+    if (fclose(stream) != 0)
+    {
+        free(image);
+        return false;
+    }
+
+    *buffer = reinterpret_cast<uint8_t *>(image);
+    *size = imageSize;
+    return true;
+}
+
 // ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
 
 void
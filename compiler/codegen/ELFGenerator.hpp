@@ -66,9 +66,9 @@ public:
                         }
     
     /**
-     * ELFGenerator destructor
+     * ELFGenerator destructor, releases the headers built for the last emitted file
     */
-    ~ELFGenerator() throw(){};
+    ~ELFGenerator() throw();
 
 protected:
 
@@ -216,6 +216,12 @@ protected:
      */
     bool emitELFFile(const char * filename);
 
+    /**
+     * Write the whole ELF object to an open stream; see emitELFFile
+     * @param[in] fp the file stream ptr
+     */
+    void writeELFToFile(::FILE *fp);
+
     /**
      * Write the ELFEheader field to file
      * @param[in] fp the file stream ptr
@@ -359,6 +365,20 @@ public:
                 CodeCacheSymbol *symbols, uint32_t numSymbols,
                 uint32_t totalELFSymbolNamesLength);
 
+    /**
+     * Builds the same object as emitELF in memory, for consumers such as
+     * the GDB JIT interface that take an in-memory symbol file.
+     * @param[out] buffer set to the ELF image, which the caller must release with free()
+     * @param[out] size set to the size of the ELF image
+     * @param[in] symbols the TR::CodeCacheSymbol*
+     * @param[in] numSymbols the number of symbols not including UNDEF
+     * @param[in] totalELFSymbolNamesLength the sum of symbol name lengths + 1 for UNDEF
+     * @return bool whether building the ELF image succeeded
+    */
+    bool emitELFToMemory(uint8_t **buffer, size_t *size,
+                CodeCacheSymbol *symbols, uint32_t numSymbols,
+                uint32_t totalELFSymbolNamesLength);
+
 }; //class ELFExecutableGenerator
 
 
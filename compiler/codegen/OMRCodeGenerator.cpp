@@ -178,6 +178,8 @@ OMR::CodeGenerator::CodeGenerator(TR::Compilation *comp) :
       _methodStackMap(NULL),
       _binaryBufferStart(NULL),
       _binaryBufferCursor(NULL),
+      _coldCodeStart(NULL),
+      _coldCodeEnd(NULL),
       _largestOutgoingArgSize(0),
       _estimatedCodeLength(0),
       _estimatedSnippetStart(0),
@@ -220,6 +222,8 @@ OMR::CodeGenerator::CodeGenerator(TR::Compilation *comp) :
       _spill4FreeList(getTypedAllocator<TR_BackingStore*>(comp->allocator())),
       _spill8FreeList(getTypedAllocator<TR_BackingStore*>(comp->allocator())),
       _spill16FreeList(getTypedAllocator<TR_BackingStore*>(comp->allocator())),
+      _spill32FreeList(getTypedAllocator<TR_BackingStore*>(comp->allocator())),
+      _spill64FreeList(getTypedAllocator<TR_BackingStore*>(comp->allocator())),
       _internalPointerSpillFreeList(getTypedAllocator<TR_BackingStore*>(comp->allocator())),
       _firstTimeLiveOOLRegisterList(NULL),
       _spilledRegisterList(NULL),
@@ -1035,6 +1039,12 @@ OMR::CodeGenerator::getSupportsBitPermute()
    return false;
    }
 
+bool
+OMR::CodeGenerator::getSupportsVectorLengthForAutoSIMD(TR::VectorLength length, TR::ILOpCode opcode, TR::DataType elementType)
+   {
+   return length == TR::VectorLength128 && self()->getSupportsOpCodeForAutoSIMD(opcode, elementType);
+   }
+
 bool
 OMR::CodeGenerator::getSupportsConstantOffsetInAddressing(int64_t value)
    {
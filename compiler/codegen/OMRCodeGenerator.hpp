@@ -773,6 +773,11 @@ public:
    uint8_t *getBinaryBufferCursor() {return _binaryBufferCursor;}
    uint8_t *setBinaryBufferCursor(uint8_t *b) { return (_binaryBufferCursor = b); }
 
+   /// Bounds of the code emitted into the cold area of the code cache, if any
+   uint8_t *getColdCodeStart() {return _coldCodeStart;}
+   uint8_t *getColdCodeEnd() {return _coldCodeEnd;}
+   void setColdCodeRange(uint8_t *start, uint8_t *end) { _coldCodeStart = start; _coldCodeEnd = end; }
+
    uint8_t *alignBinaryBufferCursor();
 
    uint32_t getBinaryBufferLength() {return (uint32_t)(_binaryBufferCursor - _binaryBufferStart - _jitMethodEntryPaddingSize);} // cast explicitly
@@ -1080,6 +1085,8 @@ public:
    TR::list<TR_BackingStore*>& getSpill4FreeList() {return _spill4FreeList;}
    TR::list<TR_BackingStore*>& getSpill8FreeList() {return _spill8FreeList;}
    TR::list<TR_BackingStore*>& getSpill16FreeList() {return _spill16FreeList;}
+   TR::list<TR_BackingStore*>& getSpill32FreeList() {return _spill32FreeList;}
+   TR::list<TR_BackingStore*>& getSpill64FreeList() {return _spill64FreeList;}
    TR::list<TR_BackingStore*>& getInternalPointerSpillFreeList() {return _internalPointerSpillFreeList;}
    TR::list<TR_BackingStore*>& getCollectedSpillList() {return _collectedSpillList;}
    TR::list<TR_BackingStore*>& getAllSpillList() {return _allSpillList;}
@@ -1507,6 +1514,24 @@ public:
 
    bool getSupportsBitOpCodes() {return false;}
 
+   /**
+    * @brief Relative costs the switch analyzer weighs when choosing how each
+    *        cluster of case values is dispatched: a compare and branch on one
+    *        value, a pair of compares bounding a range, the fixed and the
+    *        per-entry parts of a jump table, and one test against a bit mask.
+    */
+   int32_t getSwitchCompareAndBranchCost() {return 3 + 6;}
+   int32_t getSwitchRangeTestCost() {return 3 + 3 + 6;}
+   int32_t getSwitchJumpTableCost() {return 3 + 3 + 6 + 10;}
+   int32_t getSwitchJumpTableEntryCost() {return 1;}
+   int32_t getSwitchBitTestCost() {return 3 + 6;}
+
+   /**
+    * @brief Widest span of case values the switch analyzer may dispatch with
+    *        bit tests against a mask, or 0 if bit tests are not profitable
+    */
+   int32_t getSwitchBitTestWidth() {return 0;}
+
    bool getMappingAutomatics() {return _flags1.testAny(MappingAutomatics);}
    void setMappingAutomatics() {_flags1.set(MappingAutomatics);}
 
@@ -1632,6 +1657,17 @@ public:
 
    bool getSupportsOpCodeForAutoSIMD(TR::ILOpCode, TR::DataType) { return false; }
 
+   /**
+    * \brief Query whether a vector opcode is supported for vectors of the given length
+    *
+    * \param length      the length of the vector type
+    * \param opcode      the vector opcode
+    * \param elementType the element type of the vector type
+    *
+    * \return True if the opcode can be evaluated for the vector type in codegen
+    */
+   bool getSupportsVectorLengthForAutoSIMD(TR::VectorLength length, TR::ILOpCode opcode, TR::DataType elementType);
+
    bool removeRegisterHogsInLowerTreesWalk() { return _flags3.testAny(RemoveRegisterHogsInLowerTreesWalk);}
    void setRemoveRegisterHogsInLowerTreesWalk() { _flags3.set(RemoveRegisterHogsInLowerTreesWalk);}
    void resetRemoveRegisterHogsInLowerTreesWalk() {_flags3.reset(RemoveRegisterHogsInLowerTreesWalk);}
@@ -1933,6 +1969,8 @@ public:
    TR::list<TR::Block*> _counterBlocks;
    uint8_t *_binaryBufferStart;
    uint8_t *_binaryBufferCursor;
+   uint8_t *_coldCodeStart;
+   uint8_t *_coldCodeEnd;
    TR::SparseBitVector _extendedToInt64GlobalRegisters;
 
    TR_BitVector *_liveButMaybeUnreferencedLocals;
@@ -1954,6 +1992,8 @@ public:
    TR::list<TR_BackingStore*> _spill4FreeList;
    TR::list<TR_BackingStore*> _spill8FreeList;
    TR::list<TR_BackingStore*> _spill16FreeList;
+   TR::list<TR_BackingStore*> _spill32FreeList;
+   TR::list<TR_BackingStore*> _spill64FreeList;
    TR::list<TR_BackingStore*> _internalPointerSpillFreeList;
    TR::list<TR_BackingStore*> _collectedSpillList;
    TR::list<TR_BackingStore*> _allSpillList;
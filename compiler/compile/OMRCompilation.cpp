@@ -92,9 +92,11 @@
 #include "infra/Timer.hpp"
 #include "infra/ThreadLocal.hpp"
 #include "optimizer/DebuggingCounters.hpp"
+#include "optimizer/EdgeProfiler.hpp"
 #include "optimizer/Inliner.hpp"
 #include "optimizer/Optimizations.hpp"
 #include "optimizer/Optimizer.hpp"
+#include "optimizer/RecompilationCounters.hpp"
 #include "optimizer/RegisterCandidate.hpp"
 #include "optimizer/Structure.hpp"
 #include "optimizer/TransformUtil.hpp"
@@ -104,6 +106,7 @@
 #include "ras/ILValidator.hpp"
 #include "ras/IlVerifier.hpp"
 #include "control/Recompilation.hpp"
+#include "runtime/AOTCodeCache.hpp"
 #include "runtime/CodeCacheExceptions.hpp"
 #include "ilgen/IlGen.hpp"
 #include "env/RegionProfiler.hpp"
@@ -283,6 +286,8 @@ OMR::Compilation::Compilation(
    _scratchSpaceLimit(TR::Options::_scratchSpaceLimit),
    _cpuTimeAtStartOfCompilation(-1),
    _ilVerifier(NULL),
+   _recompilationCounter(NULL),
+   _aotCodeCacheKey(0),
    _gpuPtxList(m),
    _gpuKernelLineNumberList(m),
    _gpuPtxCount(0),
@@ -1046,6 +1051,27 @@ int32_t OMR::Compilation::compile()
          }
 #endif
 
+      // A saved body is installed as is, so there is nothing left to optimize or generate
+      TR_AOTCodeCache *aotCodeCache = TR_AOTCodeCache::instance();
+      if (aotCodeCache && !_recompilationCounter && !self()->getOption(TR_EnableEdgeProfiling) &&
+          aotCodeCache->load(self()))
+         {
+         if (printCodegenTime) compTime.stopTiming(self());
+         return COMPILATION_SUCCEEDED;
+         }
+
+      if (self()->getOption(TR_EnableEdgeProfiling))
+         {
+         TR_EdgeProfiler edgeProfiler(self());
+         edgeProfiler.perform();
+         }
+
+      if (_recompilationCounter)
+         {
+         TR_RecompilationCounters recompilationCounters(self(), _recompilationCounter);
+         recompilationCounters.perform();
+         }
+
       if (_recompilationInfo)
          {
          _recompilationInfo->beforeOptimization();
@@ -1119,6 +1145,9 @@ int32_t OMR::Compilation::compile()
       if (_recompilationInfo)
          _recompilationInfo->endOfCompilation();
 
+      if (_aotCodeCacheKey != 0)
+         aotCodeCache->store(self());
+
 #ifdef J9_PROJECT_SPECIFIC
       if (self()->getOptions()->getVerboseOption(TR_VerboseInlining))
          {
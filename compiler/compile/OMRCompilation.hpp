@@ -753,6 +753,31 @@ public:
 
    void setIlVerifier(TR::IlVerifier *ilVerifier) { _ilVerifier = ilVerifier; }
 
+   /**
+    * \brief
+    *    Counter the compiled body decrements on entry and on loop back edges
+    *    so that the runtime can tell when to recompile it at a higher
+    *    optimization level. NULL when the body is not instrumented.
+    */
+   int32_t *getRecompilationCounter() { return _recompilationCounter; }
+   void setRecompilationCounter(int32_t *counter) { _recompilationCounter = counter; }
+
+   /**
+    * \brief
+    *    Key under which the body being compiled will be saved in the
+    *    persistent AOT code cache, or 0 when it will not be saved.
+    */
+   uint64_t getAOTCodeCacheKey() { return _aotCodeCacheKey; }
+   void setAOTCodeCacheKey(uint64_t key) { _aotCodeCacheKey = key; }
+
+   /**
+    * \brief
+    *    Whether the code generator records the symbolic relocations needed
+    *    to move the body elsewhere, either for a relocatable ELF file or for
+    *    the persistent AOT code cache.
+    */
+   bool recordsStaticRelocations() { return getOption(TR_EmitRelocatableELFFile) || _aotCodeCacheKey != 0; }
+
    typedef std::pair<const void * const, TR::DebugCounterBase *> DebugCounterEntry;
    typedef TR::typed_allocator<DebugCounterEntry, TR::Allocator> DebugCounterMapAllocator;
    typedef std::map<const void *, TR::DebugCounterBase *, std::less<const void *>, DebugCounterMapAllocator> DebugCounterMap;
@@ -1318,6 +1343,8 @@ private:
    int64_t                           _cpuTimeAtStartOfCompilation;
 
    TR::IlVerifier                    *_ilVerifier;
+   int32_t                           *_recompilationCounter;
+   uint64_t                          _aotCodeCacheKey;
 
    ListHeadAndTail<char*> _gpuPtxList;
    ListHeadAndTail<int32_t> _gpuKernelLineNumberList; //TODO: fix to get real line numbers
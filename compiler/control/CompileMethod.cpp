@@ -31,6 +31,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
 #include "env/FrontEnd.hpp"
 #include "codegen/LinkageConventionsEnum.hpp"
 #include "compile/Compilation.hpp"
@@ -50,6 +51,8 @@
 #include "env/VerboseLog.hpp"
 #include "env/defines.h"
 #include "env/jittypes.h"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
 #include "il/ResolvedMethodSymbol.hpp"
 #include "ilgen/IlGenRequest.hpp"
 #include "ilgen/IlGeneratorMethodDetails.hpp"
@@ -58,36 +61,40 @@
 #include "ras/Debug.hpp"
 #include "env/SystemSegmentProvider.hpp"
 #include "env/DebugSegmentProvider.hpp"
+#include "env/SegmentCache.hpp"
 #include "omrformatconsts.h"
 #include "runtime/CodeCacheManager.hpp"
+#include "runtime/JitDump.hpp"
+
+// The perf map is opened once, while the JIT is being initialized, so that
+// concurrent compilations only ever append whole lines to it.
+//
+static FILE *perfFile = 0;
 
 static void
-writePerfToolEntry(void *start, uint32_t size, const char *name)
+openPerfToolFile()
    {
-   // race condition
-   static bool firstAttempt = true;
-   static FILE *perfFile = 0;
+   if (perfFile)
+      return;
 
-   if (firstAttempt)
-      {
-      firstAttempt = false;
 #if defined(OMR_OS_WINDOWS)
-      int jvmPid = _getpid();
+   int jvmPid = _getpid();
 #else
-      pid_t jvmPid = getpid();
+   pid_t jvmPid = getpid();
 #endif
-      static const int maxPerfFilenameSize = 15 + sizeof(jvmPid)* 3; // "/tmp/perf-%ld.map"
-      char perfFilename[maxPerfFilenameSize] = { 0 };
+   static const int maxPerfFilenameSize = 15 + sizeof(jvmPid)* 3; // "/tmp/perf-%ld.map"
+   char perfFilename[maxPerfFilenameSize] = { 0 };
 
-      bool truncated = TR::snprintfTrunc(perfFilename, maxPerfFilenameSize, "/tmp/perf-%" OMR_PRId64 ".map", static_cast<int64_t>(jvmPid));
-      if (!truncated)
-         {
-         perfFile = fopen(perfFilename, "a");
-         }
-      if (!perfFile) // couldn't open the file
-         {
-         }
+   bool truncated = TR::snprintfTrunc(perfFilename, maxPerfFilenameSize, "/tmp/perf-%" OMR_PRId64 ".map", static_cast<int64_t>(jvmPid));
+   if (!truncated)
+      {
+      perfFile = fopen(perfFilename, "a");
       }
+   }
+
+static void
+writePerfToolEntry(void *start, uint32_t size, const char *name)
+   {
    if (perfFile)
       {
       // perf does not want 0x leading the hex start address and length of the compiled code region
@@ -113,21 +120,62 @@ writePerfToolEntry(void *start, uint32_t size, const char *name)
 
 
 static void
-generatePerfToolEntry(uint8_t *startPC, uint8_t *endPC, const char *sig, const char *hotness)
+generatePerfToolEntry(uint8_t *startPC, uint8_t *endPC, const char *sig, const char *hotness, bool isCold = false)
    {
    char buffer[1024];
-   char *name;
-   if (strlen(sig) + 1 + strlen(hotness) + 1 < 1024)
+   const char *name;
+   if (strlen(sig) + 1 + strlen(hotness) + 1 < 1000)
       {
-      sprintf(buffer, "%s_%s (compiled code)", sig, hotness);
+      sprintf(buffer, "%s_%s (%s code)", sig, hotness, isCold ? "cold compiled" : "compiled");
       name = buffer;
       }
    else
-      name = "(compiled code)";
+      name = isCold ? "(cold compiled code)" : "(compiled code)";
 
    writePerfToolEntry(startPC, static_cast<uint32_t>(endPC - startPC), name);
    }
 
+// Report the bytecode index of the outermost caller as the line number of
+// every instruction in [start, end) where it changes.
+//
+static void
+generateJitDumpEntry(TR::Compilation &compiler, uint8_t *start, uint8_t *end, const char *name)
+   {
+   TR::JitDump *jitDump = TR::JitDump::instance();
+   if (!jitDump || start >= end)
+      return;
+
+   TR::CodeGenerator *cg = compiler.cg();
+   uint32_t numInstructions = 0;
+   for (TR::Instruction *instr = cg->getFirstInstruction(); instr; instr = instr->getNext())
+      numInstructions++;
+
+   TR::JitDump::LineEntry *lines = static_cast<TR::JitDump::LineEntry *>(
+      compiler.trMemory()->allocateHeapMemory(numInstructions * sizeof(TR::JitDump::LineEntry)));
+   uint32_t numLines = 0;
+   for (TR::Instruction *instr = cg->getFirstInstruction(); instr; instr = instr->getNext())
+      {
+      uint8_t *address = instr->getBinaryEncoding();
+      if (!instr->getNode() || address < start || address >= end)
+         continue;
+
+      TR_ByteCodeInfo bcInfo = instr->getNode()->getByteCodeInfo();
+      while (bcInfo.getCallerIndex() >= 0)
+         bcInfo = compiler.getInlinedCallSite(bcInfo.getCallerIndex())._byteCodeInfo;
+
+      int32_t line = bcInfo.getByteCodeIndex() + 1;
+      if (numLines > 0 && (lines[numLines - 1]._line == line || lines[numLines - 1]._address >= address))
+         continue;
+
+      lines[numLines]._address = address;
+      lines[numLines]._line = line;
+      numLines++;
+      }
+
+   jitDump->codeLoaded(name, start, static_cast<uint32_t>(end - start),
+                       compiler.getCurrentMethod()->classNameChars(), lines, numLines);
+   }
+
 #if defined(TR_TARGET_POWER)
 #include "p/codegen/PPCTableOfConstants.hpp"
 #endif
@@ -139,6 +187,16 @@ int32_t commonJitInit(OMR::FrontEnd &fe, char *cmdLineOptions)
    if (init_options(jitConfig, cmdLineOptions) < 0)
       return -1;
 
+   if (TR::Options::getCmdLineOptions()->getOption(TR_PerfTool))
+      openPerfToolFile();
+
+   if (TR::Options::getCmdLineOptions()->getOption(TR_EnableJitDump)
+       || TR::Options::getCmdLineOptions()->getOption(TR_EnableGDBJitInterface))
+      {
+      TR::JitDump::initialize(TR::Options::getCmdLineOptions()->getOption(TR_EnableJitDump),
+                              TR::Options::getCmdLineOptions()->getOption(TR_EnableGDBJitInterface));
+      }
+
    // This doesn't make sense for non-Power platforms!
    //
    TR::Compiler->target.cpu.setProcessor(TR_DefaultPPCProcessor);
@@ -228,6 +286,9 @@ registerTrampoline(uint8_t *start, uint32_t size, const char *name)
    {
    if (TR::Options::getCmdLineOptions()->getOption(TR_PerfTool))
       writePerfToolEntry(start, size, name);
+
+   if (TR::JitDump *jitDump = TR::JitDump::instance())
+      jitDump->codeLoaded(name, start, size, NULL, NULL, 0);
    }
 
 static void
@@ -270,19 +331,34 @@ compileMethodFromDetails(
       OMR_VMThread *omrVMThread,
       TR::IlGeneratorMethodDetails & details,
       TR_Hotness hotness,
-      int32_t &rc)
+      int32_t &rc,
+      int32_t *recompilationCounter)
    {
    uint64_t translationStartTime = TR::Compiler->vm.getUSecClock();
    OMR::FrontEnd &fe = OMR::FrontEnd::singleton();
    auto jitConfig = fe.jitConfig();
    TR::RawAllocator rawAllocator;
-   TR::SystemSegmentProvider defaultSegmentProvider(1 << 16, rawAllocator);
+   TR::SegmentCache *segmentCache = NULL;
+   if (!TR::Options::getCmdLineOptions()->getOption(TR_DisableSegmentCache))
+      {
+      segmentCache = &TR::SegmentCache::instance();
+      if (TR::Options::getSegmentCacheRetention() != 0 &&
+          TR::Options::getSegmentCacheRetention() != segmentCache->retentionTarget())
+         segmentCache->setRetentionTarget(TR::Options::getSegmentCacheRetention());
+      }
+   TR::SystemSegmentProvider defaultSegmentProvider(1 << 16, rawAllocator, segmentCache);
    TR::DebugSegmentProvider debugSegmentProvider(1 << 16, rawAllocator);
    TR::SegmentAllocator &scratchSegmentProvider =
       TR::Options::getCmdLineOptions()->getOption(TR_EnableScratchMemoryDebugging) ?
          static_cast<TR::SegmentAllocator &>(debugSegmentProvider) :
          static_cast<TR::SegmentAllocator &>(defaultSegmentProvider);
    TR::Region dispatchRegion(scratchSegmentProvider, rawAllocator);
+
+   // Reused memory would hide the use-after-free errors scratch memory debugging looks for
+   if (!TR::Options::getCmdLineOptions()->getOption(TR_DisableRegionFreeLists) &&
+       !TR::Options::getCmdLineOptions()->getOption(TR_EnableScratchMemoryDebugging))
+      dispatchRegion.enableFreeLists();
+
    TR_Memory trMemory(*fe.persistentMemory(), dispatchRegion);
    TR_ResolvedMethod & compilee = *((TR_ResolvedMethod *)details.getMethod());
 
@@ -302,7 +378,7 @@ compileMethodFromDetails(
       return 0;
       }
 
-   if (0 == (plan = TR_OptimizationPlan::alloc(hotness, false, false)))
+   if (0 == (plan = TR_OptimizationPlan::alloc(hotness, recompilationCounter != NULL, false)))
       {
       // FIXME: maybe it would be better to allocate the plan on the stack
       // so that we don't have to deal with OOM ugliness below
@@ -342,6 +418,7 @@ compileMethodFromDetails(
          }
 
       compiler.setIlVerifier(details.getIlVerifier());
+      compiler.setRecompilationCounter(recompilationCounter);
 
       if (TR::Options::getCmdLineOptions()->getVerboseOption(TR_VerboseCompileStart))
          {
@@ -416,9 +493,19 @@ compileMethodFromDetails(
             if (compiler.getOption(TR_PerfTool))
                {
                generatePerfToolEntry(startPC, codeGenerator.getCodeEnd(), compiler.signature(), compiler.getHotnessName(compiler.getMethodHotness()));
+               if (codeGenerator.getColdCodeStart())
+                  generatePerfToolEntry(codeGenerator.getColdCodeStart(), codeGenerator.getColdCodeEnd(), compiler.signature(), compiler.getHotnessName(compiler.getMethodHotness()), true);
                }
             }
 
+         if (TR::JitDump::instance())
+            {
+            TR::CodeGenerator &codeGenerator(*compiler.cg());
+            generateJitDumpEntry(compiler, startPC, codeGenerator.getCodeEnd(), compiler.externalName());
+            if (codeGenerator.getColdCodeStart())
+               generateJitDumpEntry(compiler, codeGenerator.getColdCodeStart(), codeGenerator.getColdCodeEnd(), compiler.externalName());
+            }
+
          if (compiler.getOutFile() != NULL && compiler.getOption(TR_TraceAll))
             traceMsg((&compiler), "<result success=\"true\" startPC=\"%#p\" time=\"%lld.%lldms\"/>\n",
                                   startPC,
@@ -465,6 +552,13 @@ compileMethodFromDetails(
    // before we can get working, and we need to make sure the other
    // frontends are properly calling the destructor
    TR::CodeCache *codeCache = compiler.cg() ? compiler.cg()->getCodeCache() : NULL;
+
+   // The code of a failed compilation is never run, so its warm and cold
+   // parts go back to the code cache
+   //
+   if (rc != COMPILATION_SUCCEEDED && codeCache && compiler.cg()->getBinaryBufferStart())
+      codeCache->freeCodeMemory(compiler.cg()->getBinaryBufferStart(), compiler.cg()->getColdCodeStart());
+
    TR::CodeCacheManager::instance()->unreserveCodeCache(codeCache);
 
    TR_OptimizationPlan::freeOptimizationPlan(plan);
@@ -123,6 +123,8 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"alwaysFatalAssert",       "I\tAlways execute fatal assertion for testing purposes",           SET_OPTION_BIT(TR_AlwaysFatalAssert), "F"},
    {"alwaysSafeFatalAssert", "I\tAlways issue a safe fatal assertion for testing purposes",      SET_OPTION_BIT(TR_AlwaysSafeFatal), "F"},
    {"alwaysWorthInliningThreshold=", "O<nnn>\t", TR::Options::set32BitNumeric, offsetof(OMR::Options, _alwaysWorthInliningThreshold), 0, "F%d" },
+   {"aotCodeCache=", "L<filename>\tload compiled bodies from, and save them to, the persistent AOT code cache in filename",
+        TR::Options::setString, offsetof(OMR::Options,_aotCodeCacheFileName), 0, "P%s", NOT_IN_SUBSET},
    {"aotOnlyFromBootstrap", "O\tahead-of-time compilation allowed only for methods from bootstrap classes",
         SET_OPTION_BIT(TR_AOTCompileOnlyFromBootstrap), "F", NOT_IN_SUBSET },
    {"aotrtDebugLevel=", "R<nnn>\tprint aotrt debug output according to level", TR::Options::set32BitNumeric, offsetof(OMR::Options,_newAotrtDebugLevel), 0, "F%d"},
@@ -185,6 +187,8 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"compilationThreads=",   "R<nnn>\tnumber of compilation threads to use",
                                TR::Options::setStaticNumeric, (intptr_t)&OMR::Options::_numUsableCompilationThreads, 0, "F%d", NOT_IN_SUBSET},
    {"compile",                "D\tCompile these methods immediately. Primarily for use with Compiler.command",  SET_OPTION_BIT(TR_CompileBit),  "F" },
+   {"compileTimeBudget=",      "O<nnn>\tmilliseconds of optimization time above which expensive optimizations are downgraded or skipped (0 = no budget)",
+        TR::Options::set32BitNumeric, offsetof(OMR::Options, _compileTimeBudget), 0, "F%d"},
    {"compThreadCPUEntitlement=", "M<nnn>\tThreshold for CPU utilization of compilation threads",
                                TR::Options::setStaticNumeric, (intptr_t)&OMR::Options::_compThreadCPUEntitlement, 0, "F%d", NOT_IN_SUBSET },
    {"concurrentLPQ", "M\tCompilations from low priority queue can go in parallel with compilations from main queue", SET_OPTION_BIT(TR_ConcurrentLPQ), "F", NOT_IN_SUBSET },
@@ -278,6 +282,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableClassChainValidationCaching",  "M\tdisable class chain validation caching", RESET_OPTION_BIT(TR_EnableClassChainValidationCaching), "F", NOT_IN_SUBSET},
    {"disableClearCodeCacheFullFlag",      "I\tdisable the re-enabling of full code cache when a method body is freed.", SET_OPTION_BIT(TR_DisableClearCodeCacheFullFlag),"F", NOT_IN_SUBSET},
    {"disableCodeCacheConsolidation",      "M\tdisable code cache consolidation", RESET_OPTION_BIT(TR_EnableCodeCacheConsolidation), "F", NOT_IN_SUBSET},
+   {"disableCodeCacheLiteralPool",        "O\tdisable the constant pool shared by the methods of a code cache (x86)", SET_OPTION_BIT(TR_DisableCodeCacheLiteralPool), "F"},
    {"disableCodeCacheReclamation",        "I\tdisable the freeing of compilations.", SET_OPTION_BIT(TR_DisableCodeCacheReclamation),"F", NOT_IN_SUBSET},
    {"disableCodeCacheSnippets",           "O\tdisable code cache snippets (e.g. allocation prefetch snippet) ", SET_OPTION_BIT(TR_DisableCodeCacheSnippets), "F"},
    {"disableColdBlockMarker",             "O\tdisable detection of cold blocks",               TR::Options::disableOptimization, coldBlockMarker, 0, "P"},
@@ -364,6 +369,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
                                           TR::Options::setRegex, offsetof(OMR::Options, _disabledIdiomPatterns), 0, "P"},
    {"disableIdiomRecognition",            "O\tdisable idiom recognition",                       TR::Options::disableOptimization, idiomRecognition, 0, "P"},
 #endif
+   {"disableIfConversion",                "O\tdisable if-conversion of small conditionals into selects", TR::Options::disableOptimization, ifConversion, 0, "P"},
    {"disableImmutableFieldAliasing",      "O\tdisable special handling for immutable fields.", SET_OPTION_BIT(TR_DisableImmutableFieldAliasing), "P"},
    {"disableIncrementalCCR",              "O\tdisable incremental ccr",      SET_OPTION_BIT(TR_DisableIncrementalCCR), "F" ,NOT_IN_SUBSET},
 
@@ -384,6 +390,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableInliningDuringVPAtWarm",       "O\tdisable inlining during VP for warm bodies",    SET_OPTION_BIT(TR_DisableInliningDuringVPAtWarm), "F"},
    {DisableInliningOfNativesString,       "O\tdisable inlining of natives",                    SET_OPTION_BIT(TR_DisableInliningOfNatives), "F"},
    {"disableInnerPreexistence",           "O\tdisable inner preexistence",                     TR::Options::disableOptimization, innerPreexistence, 0, "P"},
+   {"disableInstructionScheduling",       "O\tdisable the post register assignment instruction scheduler (x86)", SET_OPTION_BIT(TR_DisableInstructionScheduling), "F"},
    {"disableIntegerCompareSimplification",      "O\tdisable byte/short/int/long compare simplification  ",      SET_OPTION_BIT(TR_DisableIntegerCompareSimplification), "F"},
    {"disableInterfaceCallCaching",                          "O\tdisable interfaceCall caching   ",      SET_OPTION_BIT(TR_disableInterfaceCallCaching), "F"},
    {"disableInterfaceInlining",           "O\tdisable merge new",                              SET_OPTION_BIT(TR_DisableInterfaceInlining), "F"},
@@ -431,6 +438,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableLoopReplicatorColdSideEntryCheck","I\tdisable cold side-entry check for replicating loops containing hot inner loops", SET_OPTION_BIT(TR_DisableLoopReplicatorColdSideEntryCheck), "P"},
    {"disableLoopStrider",                 "O\tdisable loop strider",                           TR::Options::disableOptimization, loopStrider, 0, "P"},
    {"disableLoopTransfer",                "O\tdisable the loop transfer part of loop versioner", SET_OPTION_BIT(TR_DisableLoopTransfer), "F"},
+   {"disableLoopVectorizer",              "O\tdisable loop vectorizer",                        TR::Options::disableOptimization, loopVectorizer, 0, "P"},
    {"disableLoopVersioner",               "O\tdisable loop versioner",                         TR::Options::disableOptimization, loopVersioner, 0, "P"},
    {"disableMarkingOfHotFields",          "O\tdisable marking of Hot Fields",                  SET_OPTION_BIT(TR_DisableMarkingOfHotFields), "F"},
    {"disableMarshallingIntrinsics",       "O\tDisable packed decimal to binary marshalling and un-marshalling optimization. They will not be inlined.", SET_OPTION_BIT(TR_DisableMarshallingIntrinsics), "F"},
@@ -507,13 +515,16 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableRefinedAliases",              "O\tdisable collecting side-effect summaries from compilations to improve aliasing info in subsequent compilations", SET_OPTION_BIT(TR_DisableRefinedAliases), "F"},
    {"disableRefinedBCDClobberEval",       "O\tdisable trying to minimize the number of BCD clobber evaluate copies ", SET_OPTION_BIT(TR_DisableRefinedBCDClobberEval), "F"},
    {"disableRegDepCopyRemoval",           "O\tdisable register dependency copy removal", TR::Options::disableOptimization, regDepCopyRemoval, 0, "P"},
+   {"disableRegionFreeLists",             "M\tdo not reuse memory freed back to the compilation's memory regions", SET_OPTION_BIT(TR_DisableRegionFreeLists), "F", NOT_IN_SUBSET},
    {"disableRegisterPressureSimulation",  "O\tdon't walk the trees to estimate register pressure during global register allocation", SET_OPTION_BIT(TR_DisableRegisterPressureSimulation), "F"},
    {"disableRematerialization",           "O\tdisable rematerialization",                      TR::Options::disableOptimization, rematerialization, 0, "P"},
    {"disableReorderArrayIndexExpr",       "O\tdisable reordering of index expressions",        TR::Options::disableOptimization, reorderArrayExprGroup, 0, "P"},
    {"disableRMODE64",                     "O\tDisable residence mode of compiled bodies on z/OS to reside above the 2-gigabyte bar", RESET_OPTION_BIT(TR_EnableRMODE64), "F"},
    {"disableRXusage",                     "O\tdisable increased usage of RX instructions",     SET_OPTION_BIT(TR_DisableRXusage), "F"},
    {"disableSamplingJProfiling",          "O\tDisable profiling in the jitted code", SET_OPTION_BIT(TR_DisableSamplingJProfiling), "F" },
+   {"disableSCCP",                         "O\tdisable sparse conditional constant propagation", TR::Options::disableOptimization, sparseConditionalConstantPropagation, 0, "P"},
    {"disableScorchingSampleThresholdScalingBasedOnNumProc", "M\t", SET_OPTION_BIT(TR_DisableScorchingSampleThresholdScalingBasedOnNumProc), "F", NOT_IN_SUBSET},
+   {"disableSegmentCache",                "M\tdo not keep memory segments cached between compilations", SET_OPTION_BIT(TR_DisableSegmentCache), "F", NOT_IN_SUBSET},
    {"disableSelectiveNoServer",           "D\tDisable turning on noServer selectively",        SET_OPTION_BIT(TR_DisableSelectiveNoOptServer), "F" },
    {"disableSeparateInitFromAlloc",        "O\tdisable separating init from alloc",            SET_OPTION_BIT(TR_DisableSeparateInitFromAlloc), "F"},
    {"disableSequenceSimplification",      "O\tdisable arithmetic sequence simplification",     TR::Options::disableOptimization, expressionsSimplification, 0, "P"},
@@ -530,7 +541,9 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableSIMDStringHashCode",           "O\tdisable vectorized java/lang/String.hashCode implementation", SET_OPTION_BIT(TR_DisableSIMDStringHashCode), "F"},
    {"disableSIMDUTF16BEEncoder",           "M\tdisable inlining of SIMD UTF16 Big Endian encoder", SET_OPTION_BIT(TR_DisableSIMDUTF16BEEncoder), "F"},
    {"disableSIMDUTF16LEEncoder",           "M\tdisable inlining of SIMD UTF16 Little Endian encoder", SET_OPTION_BIT(TR_DisableSIMDUTF16LEEncoder), "F"},
+   {"disableSLPVectorizer",                "O\tdisable superword-level parallelism vectorizer", TR::Options::disableOptimization, slpVectorizer, 0, "P"},
    {"disableSmartPlacementOfCodeCaches",   "O\tdisable placement of code caches in memory so they are near each other and the DLLs",  SET_OPTION_BIT(TR_DisableSmartPlacementOfCodeCaches), "F", NOT_IN_SUBSET},
+   {"disableSoftwarePipelining",           "O\tdisable software pipelining of counted loops", TR::Options::disableOptimization, softwarePipelining, 0, "P"},
    {"disableStableAnnotations",            "M\tdisable recognition of @Stable",               SET_OPTION_BIT(TR_DisableStableAnnotations), "F"},
    {"disableStaticFinalFieldFolding",      "O\tdisable generic static final field folding",                        TR::Options::disableOptimization, staticFinalFieldFolding, 0, "P"},
    {"disableStoreOnCondition",                 "O\tdisable store on condition (STOC) code gen",                         SET_OPTION_BIT(TR_DisableStoreOnCondition), "F"},
@@ -549,6 +562,8 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableTarokInlineArrayletAllocation", "O\tdisable Tarok inline Arraylet Allocation in genHeapAlloc", SET_OPTION_BIT(TR_DisableTarokInlineArrayletAllocation), "F"},
    {"disableThrowToGoto",                 "O\tdisable throw to goto",                          SET_OPTION_BIT(TR_DisableThrowToGoto), "F"},
    {"disableThunkTupleJ2I",               "D\tdo not replace initialInvokeExactThunk with J2I thunk / helper address in ThunkTuple",   SET_OPTION_BIT(TR_DisableThunkTupleJ2I), "F", NOT_IN_SUBSET},
+   {"disableTieredBackedgeCounters",      "O\tdo not count loop back edges in the first tier of tiered compilation", SET_OPTION_BIT(TR_DisableTieredBackedgeCounters), "F"},
+   {"disableTieredInvocationCounters",    "O\tdo not count invocations in the first tier of tiered compilation", SET_OPTION_BIT(TR_DisableTieredInvocationCounters), "F"},
    {"disableTLE",                         "O\tdisable transactional lock elision", SET_OPTION_BIT(TR_DisableTLE), "F"},
    {"disableTlhPrefetch",                 "O\tdisable software prefetch on allocation", SET_OPTION_BIT(TR_DisableTLHPrefetch), "F"},
    {"disableTM",                          "O\tdisable transactional memory support", SET_OPTION_BIT(TR_DisableTM), "F"},
@@ -561,6 +576,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"disableTrivialDeadBlockRemoval", "O\tdisable trivial dead block removal ",   SET_OPTION_BIT(TR_DisableTrivialDeadBlockRemover), "F"},
    {"disableTrivialDeadTreeRemoval",      "O\tdisable trivial dead tree removal",              TR::Options::disableOptimization, trivialDeadTreeRemoval, 0, "P"},
    {"disableUncountedUnrolls",            "O\tdisable GLU from unrolling uncounted loops ",SET_OPTION_BIT(TR_DisableUncountedUnrolls), "F"},
+   {"disableUnrollAndJam",                "O\tdisable unroll-and-jam of counted loop nests", TR::Options::disableOptimization, unrollAndJam, 0, "P"},
    {"disableUnsafe",                      "O\tdisable code to inline Unsafe natives",          SET_OPTION_BIT(TR_DisableUnsafe), "F"},
    {"disableUnsafeFastPath",              "O\tdisable unsafe fast path",               TR::Options::disableOptimization, unsafeFastPath, 0, "P"},  // Java specific option
    {"disableUpdateAOTBytesSize",          "M\tDon't send VM size of bodies that could have been AOT'd if the SCC wasn't full", SET_OPTION_BIT(TR_DisableUpdateAOTBytesSize), "F", NOT_IN_SUBSET},
@@ -659,6 +675,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableClassChainValidationCaching",  "M\tenable class chain validation caching", SET_OPTION_BIT(TR_EnableClassChainValidationCaching), "F", NOT_IN_SUBSET},
    {"enableCodeCacheConsolidation",       "M\tenable code cache consolidation", SET_OPTION_BIT(TR_EnableCodeCacheConsolidation), "F", NOT_IN_SUBSET},
    {"enableColdCheapTacticalGRA",         "O\tenable cold cheap tactical GRA", SET_OPTION_BIT(TR_EnableColdCheapTacticalGRA), "F"},
+   {"enableColdCodeSplitting",            "O\temit trailing cold blocks into the cold region of the code cache (x86)", SET_OPTION_BIT(TR_EnableColdCodeSplitting), "F"},
    {"enableCompilationSpreading",         "C\tenable adding spreading invocations to methods before compiling", SET_OPTION_BIT(TR_EnableCompilationSpreading), "F", NOT_IN_SUBSET},
    {"enableCompilationThreadThrottlingDuringStartup", "M\tenable compilation thread throttling during startup", SET_OPTION_BIT(TR_EnableCompThreadThrottlingDuringStartup), "F", NOT_IN_SUBSET },
    {"enableCompilationYieldStats",        "M\tenable statistics on time between 2 consecutive yield points", SET_OPTION_BIT(TR_EnableCompYieldStats), "F", NOT_IN_SUBSET},
@@ -673,6 +690,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableDynamicSamplingWindow",        "M\t", RESET_OPTION_BIT(TR_DisableDynamicSamplingWindow), "F", NOT_IN_SUBSET},
    {"enableEarlyCompilationDuringIdleCpu","M\t", SET_OPTION_BIT(TR_EnableEarlyCompilationDuringIdleCpu), "F", NOT_IN_SUBSET},
    {"enableEBBCCInfo",                    "C\tenable tracking CCInfo in Extended Basic Block scope",  SET_OPTION_BIT(TR_EnableEBBCCInfo), "F"},
+   {"enableEdgeProfiling",                "O\tcollect CFG edge counts in compiled methods and use them to lay out blocks when the method is recompiled", SET_OPTION_BIT(TR_EnableEdgeProfiling), "F"},
    {"enableExecutableELFGeneration",      "I\tenable the generation of executable ELF files", SET_OPTION_BIT(TR_EmitExecutableELFFile), "F", NOT_IN_SUBSET},
    {"enableExpensiveOptsAtWarm",          "O\tenable store sinking and OSR at warm and below", SET_OPTION_BIT(TR_EnableExpensiveOptsAtWarm), "F" },
    {"enableFastHotRecompilation",         "R\ttry to recompile at hot sooner", SET_OPTION_BIT(TR_EnableFastHotRecompilation), "F"},
@@ -680,6 +698,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableFpreductionAnnotation",        "O\tenable fpreduction annotation", SET_OPTION_BIT(TR_EnableFpreductionAnnotation), "F"},
    {"enableFSDGRA",                       "O\tenable basic GRA in FSD mode", SET_OPTION_BIT(TR_FSDGRA), "F"},
    {"enableGCRPatching",                  "R\tenable patching of the GCR guard", SET_OPTION_BIT(TR_EnableGCRPatching), "F"},
+   {"enableGDBJitInterface",              "I\tregister compiled code with gdb through its JIT interface", SET_OPTION_BIT(TR_EnableGDBJitInterface), "F", NOT_IN_SUBSET},
    {"enableGPU",                          "L\tenable GPU support  (basic)",
         TR::Options::setBitsFromStringSet, offsetof(OMR::Options, _enableGPU), TR_EnableGPU, "F"},
    {"enableGPU=",                          "L{regex}\tlist of additional GPU options: enforce, verbose, details, safeMT, enableMath",
@@ -701,6 +720,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableIprofilerChanges",             "O\tenable iprofiler changes", SET_OPTION_BIT(TR_EnableIprofilerChanges), "F"},
    {"enableIVTT",                         "O\tenable IV Type Transformation", TR::Options::enableOptimization, IVTypeTransformation, 0, "P"},
    {"enableJCLInline",                    "O\tenable JCL Integer and Long methods inlining", SET_OPTION_BIT(TR_EnableJCLInline), "F"},
+   {"enableJitDump",                      "I\twrite compiled code and line tables to /tmp/jit-<pid>.dump for perf inject", SET_OPTION_BIT(TR_EnableJitDump), "F", NOT_IN_SUBSET},
    {"enableJITHelpershashCodeImpl",       "O\tenable java version of object hashCode()", SET_OPTION_BIT(TR_EnableJITHelpershashCodeImpl), "F"},
    {"enableJITHelpersoptimizedClone",     "O\tenable java version of object clone()", SET_OPTION_BIT(TR_EnableJITHelpersoptimizedClone), "F"},
    {"enableJITServerFollowRemoteCompileWithLocalCompile", "O\tenable JITServer to perform local compilations for its remotely compiled methods", SET_OPTION_BIT(TR_JITServerFollowRemoteCompileWithLocalCompile), "F"},
@@ -737,6 +757,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableReassociation",                "O\tapply reassociation rules in Simplifier",         SET_OPTION_BIT(TR_EnableReassociation), "F"},
    {"enableRecompilationPushing",         "O\tenable pushing methods to be recompiled",         SET_OPTION_BIT(TR_EnableRecompilationPushing), "F"},
    {"enableRefinedAliases",               "O\tenable collecting side-effect summaries from compilations to improve aliasing info in subsequent compilations", RESET_OPTION_BIT(TR_DisableRefinedAliases), "F"},
+   {"enableRegisterPreferences",          "O\tprefer registers chosen over whole live ranges in local register assignment (x86-64)", SET_OPTION_BIT(TR_EnableRegisterPreferences), "F"},
    {"enableRegisterPressureEstimation",   "O\tdeprecated; same as enableRegisterPressureSimulation", RESET_OPTION_BIT(TR_DisableRegisterPressureSimulation), "F"},
    {"enableRegisterPressureSimulation",   "O\twalk the trees to estimate register pressure during global register allocation", RESET_OPTION_BIT(TR_DisableRegisterPressureSimulation), "F"},
    {"enableRelocatableELFGeneration",     "I\tenable the generation of object files use for static linking", SET_OPTION_BIT(TR_EmitRelocatableELFFile), "F", NOT_IN_SUBSET},
@@ -756,9 +777,11 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"enableSharedCacheTiming",            "M\tenable timing stats for accessing the shared cache", SET_OPTION_BIT(TR_EnableSharedCacheTiming), "F"},
    {"enableSIMDLibrary",                  "M\tEnable recognized methods for SIMD library", SET_OPTION_BIT(TR_EnableSIMDLibrary), "F"},
    {"enableSnapshotBlockOpts",            "O\tenable block ordering/redirecting optimizations in the presences of snapshot nodes", SET_OPTION_BIT(TR_EnableSnapshotBlockOpts), "F"},
+   {"enableSoftwarePipelining",           "O\tenable software pipelining of counted loops", TR::Options::enableOptimization, softwarePipelining, 0, "P"},
    {"enableSymbolValidationManager",      "M\tEnable Symbol Validation Manager for Relocatable Compile Validations", SET_OPTION_BIT(TR_EnableSymbolValidationManager), "F"},
    {"enableTailCallOpt",                  "R\tenable tall call optimization in peephole", SET_OPTION_BIT(TR_EnableTailCallOpt), "F"},
    {"enableThisLiveRangeExtension",       "R\tenable this live range extesion to the end of the method", SET_OPTION_BIT(TR_EnableThisLiveRangeExtension), "F"},
+   {"enableTieredCompilation",            "O\tcompile cold with counters first and recompile at warm once the counters run out", SET_OPTION_BIT(TR_EnableTieredCompilation), "F"},
    {"enableTM",                           "O\tenable transactional memory support", SET_OPTION_BIT(TR_EnableTM), "F"},
    {"enableTraps",                        "C\tenable trap instructions",                     RESET_OPTION_BIT(TR_DisableTraps), "F"},
    {"enableTreePatternMatching",          "O\tEnable opts that use the TR_Pattern framework", RESET_OPTION_BIT(TR_DisableTreePatternMatching), "F"},
@@ -884,6 +907,10 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"iprofilerVerbose",          "O\tEnable Interpreter Profiling output messages",           SET_OPTION_BIT(TR_VerboseInterpreterProfiling), "F"},
 
    {"jitAllAtMain",          "D\tjit all loaded methods when main is called", SET_OPTION_BIT(TR_jitAllAtMain), "F" },
+   {"jitBuilderInlineBudget=", "O<nnn>\tmaximum number of IL nodes JitBuilder may add to a compilation by inlining calls",
+        TR::Options::set32BitNumeric, offsetof(OMR::Options, _jitBuilderInlineBudget), 0, "F%d"},
+   {"jitBuilderInlineMaxSize=", "O<nnn>\tmaximum size in IL nodes of a JitBuilder function inlined for its estimated benefit",
+        TR::Options::set32BitNumeric, offsetof(OMR::Options, _jitBuilderInlineMaxSize), 0, "F%d"},
    {"jProfilingLoopRecompThreshold=",      "C<nnn>\tLoop recompilation threshold for jProfiling",
         TR::Options::set32BitSignedNumeric, offsetof(OMR::Options,_jProfilingLoopRecompThreshold), 0, "F%d"},
    {"jProfilingMethodRecompThreshold=",      "C<nnn>\tMethod invocations for jProfiling body",
@@ -1065,6 +1092,8 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
                                          TR::Options::setStaticNumericKBAdjusted, (intptr_t)&OMR::Options::_scratchSpaceLowerBound, 0, "F%d (bytes)"},
    {"searchCount=",      "O<nnn>\tcount of the max search to perform",
         TR::Options::set32BitSignedNumeric, offsetof(OMR::Options,_lastSearchCount), 0, "F%d"},
+   {"segmentCacheRetention=",    "C<nnn>\tmemory kept cached between compilations, in KB",
+                                         TR::Options::setStaticNumericKBAdjusted, (intptr_t)&OMR::Options::_segmentCacheRetention, 0, "F%d (bytes)"},
    {"slipTrap=",                          "O{regex}\trecord entry/exit for slit/trap for methods listed",
                                           TR::Options::setRegex, offsetof(OMR::Options, _slipTrap), 0, "P"},
    {"softFailOnAssume",   "M\tfail the compilation quietly and use the interpreter if an assume fails", SET_OPTION_BIT(TR_SoftFailOnAssume), "P"},
@@ -1091,6 +1120,8 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
         TR::Options::set32BitNumeric,offsetof(OMR::Options,_test390LitPoolBuffer), 0, "F%d"},
    {"test390StackBufferSize=", "L\tInsert buffer in stack to force testing of large stack sizes",
         TR::Options::set32BitNumeric,offsetof(OMR::Options,_test390StackBuffer), 0, "F%d"},
+   {"tieredRecompileThreshold=", "O<nnn>\tnumber of invocations and loop iterations after which a first tier body is recompiled",
+        TR::Options::set32BitNumeric, offsetof(OMR::Options, _tieredRecompileThreshold), 0, "F%d"},
    {"timing", "M\ttime individual phases and optimizations", SET_OPTION_BIT(TR_Timing), "F" },
    {"timingCumulative", "M\ttime cumulative phases (ILgen,Optimizer,codegen)", SET_OPTION_BIT(TR_CummTiming), "F" },
 #if defined(TR_HOST_X86) || defined(TR_HOST_POWER)
@@ -1123,6 +1154,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"traceColdBlockOutlining",          "L\ttrace outlining of cold blocks",               TR::Options::traceOptimization, coldBlockOutlining, 0, "P"},
    {"traceCompactLocals",               "L\ttrace compact locals",                         TR::Options::traceOptimization, compactLocals, 0, "P"},
    {"traceCompactNullChecks",           "L\ttrace compact null checks",                    TR::Options::traceOptimization, compactNullChecks, 0, "P"},
+   {"traceCompileBudget",               "L\ttrace per optimization costs and compile time budget decisions", SET_OPTION_BIT(TR_TraceCompileBudget), "P" },
    {"traceDeadTreeElimination",         "L\ttrace dead tree elimination",                  TR::Options::traceOptimization, deadTreesElimination, 0, "P"},
    {"traceDominators",                  "L\ttrace dominators and post-dominators",         SET_OPTION_BIT(TR_TraceDominators), "P" },
    {"traceEscapeAnalysis",              "L\ttrace escape analysis",                        TR::Options::traceOptimization, escapeAnalysis, 0, "P"},
@@ -1141,6 +1173,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"traceHandleRecompilationOps",      "L\ttrace handle recompilation operations",        TR::Options::traceOptimization, handleRecompilationOps, 0, "P"},
    {"traceIdiomRecognition",            "L\ttrace idiom recognition",                      TR::Options::traceOptimization, idiomRecognition, 0, "P"},
 #endif
+   {"traceIfConversion",                "L\ttrace if-conversion",                         TR::Options::traceOptimization, ifConversion, 0, "P"},
    {"traceILGen",                       "L\ttrace IL generator",                           SET_OPTION_BIT(TR_TraceILGen), "F"},
    {"traceILValidator",                 "L\ttrace validation over intermediate language constructs",SET_OPTION_BIT(TR_TraceILValidator), "F" },
    {"traceILWalk",                      "L\tsynonym for traceILWalks",                              SET_OPTION_BIT(TR_TraceILWalks), "P" },
@@ -1173,6 +1206,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"traceLoopReduction",               "L\ttrace loop reduction",                         TR::Options::traceOptimization, loopReduction, 0, "P"},
    {"traceLoopReplicator",              "L\ttrace loop replicator",                        TR::Options::traceOptimization, loopReplicator, 0, "P"},
    {"traceLoopStrider",                 "L\ttrace loop strider",                           TR::Options::traceOptimization, loopStrider,   0, "P"},
+   {"traceLoopVectorizer",              "L\ttrace loop vectorizer",                         TR::Options::traceOptimization, loopVectorizer, 0, "P"},
    {"traceLoopVersioner",               "L\ttrace loop versioner",                          TR::Options::traceOptimization, loopVersioner, 0, "P"},
    {"traceMarkingOfHotFields",          "M\ttrace marking of Hot Fields",                 SET_OPTION_BIT(TR_TraceMarkingOfHotFields), "F"},
    {"traceMethodHandleTransformer",     "L\ttrace MethodHandle transformer",               TR::Options::traceOptimization, methodHandleTransformer, 0, "P"},
@@ -1209,11 +1243,14 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"traceRematerialization",           "L\ttrace rematerialization",                      TR::Options::traceOptimization, rematerialization, 0, "P"},
    {"traceReorderArrayIndexExpr",       "L\ttrace reorder array index expressions",        TR::Options::traceOptimization, reorderArrayIndexExpr, 0, "P"},
    {"traceSamplingJProfiling",          "L\ttrace samplingjProfiling",                     TR::Options::traceOptimization, samplingJProfiling, 0, "P"},
+   {"traceSCCP",                        "L\ttrace sparse conditional constant propagation", TR::Options::traceOptimization, sparseConditionalConstantPropagation, 0, "P"},
    {"traceSEL",                         "L\ttrace sign extension load",                    TR::Options::traceOptimization, signExtendLoads, 0, "P"},
    {"traceSequenceSimplification",      "L\ttrace arithmetic sequence simplification",     TR::Options::traceOptimization, expressionsSimplification, 0, "P"},
 #ifdef J9_PROJECT_SPECIFIC
    {"traceSequentialStoreSimplification", "L\ttrace sequential load or store simplification", TR::Options::traceOptimization, sequentialStoreSimplification, 0, "P"},
 #endif
+   {"traceSLPVectorizer",               "L\ttrace superword-level parallelism vectorizer", TR::Options::traceOptimization, slpVectorizer, 0, "P"},
+   {"traceSoftwarePipelining",          "L\ttrace software pipelining",                   TR::Options::traceOptimization, softwarePipelining, 0, "P"},
    {"traceStaticFinalFieldFolding",     "L\ttrace generic static final field folding",             TR::Options::traceOptimization, staticFinalFieldFolding, 0, "P"},
    {"traceStringBuilderTransformer",    "L\ttrace StringBuilder tranfsofermer optimization", TR::Options::traceOptimization, stringBuilderTransformer, 0, "P"},
    {"traceStringPeepholes",             "L\ttrace string peepholes",                       TR::Options::traceOptimization, stringPeepholes, 0, "P"},
@@ -1226,6 +1263,7 @@ TR::OptionTable OMR::Options::_jitOptions[] = {
    {"traceTreeSimplification",          "L\ttrace tree simplification",                    TR::Options::traceOptimization, treeSimplification, 0, "P"},
    {"traceTrivialBlockExtension",       "L\ttrace trivial block extension",                TR::Options::traceOptimization, trivialBlockExtension, 0, "P"},
    {"traceTrivialDeadTreeRemoval",      "L\ttrace trivial dead tree removal",              TR::Options::traceOptimization, trivialDeadTreeRemoval, 0, "P"},
+   {"traceUnrollAndJam",                "L\ttrace unroll-and-jam",                        TR::Options::traceOptimization, unrollAndJam, 0, "P"},
    {"traceUnsafeFastPath",              "L\ttrace unsafe fast path",                       TR::Options::traceOptimization, unsafeFastPath, 0, "P"},  // Java specific option
    {"traceUseDefs",                     "L\ttrace use def info",                           SET_OPTION_BIT(TR_TraceUseDefs), "F"},
    {"traceValueNumbers",                "L\ttrace value number info",                      SET_OPTION_BIT(TR_TraceValueNumbers), "F"},
@@ -1684,6 +1722,7 @@ TR::SimpleRegex *OMR::Options::_debugCounterInsertMethod = NULL;
 
 size_t OMR::Options::_scratchSpaceLimit = 0;
 size_t OMR::Options::_scratchSpaceLowerBound = 0;
+size_t OMR::Options::_segmentCacheRetention = 0;
 
 uint32_t OMR::Options::_minBytesToLeaveAllocatedInSharedPool = 1024*512; // 512kb
 uint32_t OMR::Options::_maxBytesToLeaveAllocatedInSharedPool = 1024*1024*25; //25MB
@@ -2497,6 +2536,7 @@ OMR::Options::jitPreProcess()
    _disabledOptimizations[blockShuffling]    = true;
    _disabledOptimizations[IVTypeTransformation] = true;
    _disabledOptimizations[basicBlockHoisting] = true;
+   _disabledOptimizations[softwarePipelining] = true;
 
    self()->setOption(TR_DisableTreePatternMatching);
    self()->setOption(TR_DisableHalfSlotSpills);
@@ -2571,6 +2611,10 @@ OMR::Options::jitPreProcess()
    _inlinerCGColdBorderFrequency = -1;
    _inlinerCGVeryColdBorderFrequency = -1;
    _alwaysWorthInliningThreshold = 15;
+   _compileTimeBudget = 0;
+   _tieredRecompileThreshold = 1000;
+   _jitBuilderInlineBudget = 1000;
+   _jitBuilderInlineMaxSize = 200;
    _maxLimitedGRACandidates = TR_MAX_LIMITED_GRA_CANDIDATES;
    _maxLimitedGRARegs = TR_MAX_LIMITED_GRA_REGS;
    _counterBucketGranularity = 2;
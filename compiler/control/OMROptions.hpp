@@ -358,7 +358,7 @@ enum TR_CompilationOptions
 
    // Option word 9
    //
-   // Available                           = 0x00000020 + 9,
+   TR_EnableRegisterPreferences           = 0x00000020 + 9,
    // Available                           = 0x00000040 + 9,
    TR_DisableTLHPrefetch                  = 0x00000080 + 9,
    TR_DisableJProfilerThread              = 0x00000100 + 9,
@@ -381,20 +381,20 @@ enum TR_CompilationOptions
    TR_CountWriteBarriersRT                = 0x02000000 + 9,
    TR_DisableNoServerDuringStartup        = 0x04000000 + 9,  // set TR_NoOptServer during startup and insert GCR trees
    TR_BreakOnNew                          = 0x08000000 + 9,
-   // Available                           = 0x10000000 + 9,
-   // Available                           = 0x20000000 + 9,
-   // Available                           = 0x40000000 + 9,
-   // Available                           = 0x80000000 + 9,
+   TR_EnableEdgeProfiling                 = 0x10000000 + 9,
+   TR_EnableColdCodeSplitting             = 0x20000000 + 9,
+   TR_TraceCompileBudget                  = 0x40000000 + 9,
+   TR_EnableTieredCompilation             = 0x80000000 + 9,
 
    // Option word 10
    //
-   // Available                           = 0x00000020 + 10,
-   // Available                           = 0x00000040 + 10,
-   // Available                           = 0x00000080 + 10,
+   TR_DisableTieredBackedgeCounters       = 0x00000020 + 10,
+   TR_DisableTieredInvocationCounters     = 0x00000040 + 10,
+   TR_DisableRegionFreeLists              = 0x00000080 + 10,
    TR_FirstLevelProfiling                 = 0x00000100 + 10,
-   // Available                           = 0x00000200 + 10,
-   // Available                           = 0x00000400 + 10,
-   // Available                           = 0x00000800 + 10,
+   TR_DisableSegmentCache                 = 0x00000200 + 10,
+   TR_EnableJitDump                       = 0x00000400 + 10,
+   TR_EnableGDBJitInterface               = 0x00000800 + 10,
    // Available                           = 0x00001000 + 10,
    TR_DisableNewMethodOverride            = 0x00002000 + 10,
    // Available                           = 0x00004000 + 10,
@@ -418,8 +418,8 @@ enum TR_CompilationOptions
 
    // Option word 11
    //
-   // Available                               = 0x00000020 + 11,
-   // Available                               = 0x00000040 + 11,
+   TR_DisableInstructionScheduling            = 0x00000020 + 11,
+   TR_DisableCodeCacheLiteralPool             = 0x00000040 + 11,
    TR_EnableSelectiveEnterExitHooks           = 0x00000080 + 11,
    // Available                               = 0x00000100 + 11,
    // Available                               = 0x00000200 + 11,
@@ -1663,6 +1663,10 @@ public:
    int32_t getInlinerCGVeryColdBorderFrequency() { return _inlinerCGVeryColdBorderFrequency; }
    void    setInlinerCGVeryColdBorderFrequency(int32_t n) { _inlinerCGVeryColdBorderFrequency = n; }
    int32_t getAlwaysWorthInliningThreshold() const { return _alwaysWorthInliningThreshold; }
+   int32_t getCompileTimeBudget() const { return _compileTimeBudget; }
+   int32_t getTieredRecompileThreshold() const { return _tieredRecompileThreshold; }
+   int32_t getJitBuilderInlineBudget() const { return _jitBuilderInlineBudget; }
+   int32_t getJitBuilderInlineMaxSize() const { return _jitBuilderInlineMaxSize; }
    int32_t getMaxLimitedGRACandidates()   { return _maxLimitedGRACandidates; }
    int32_t getMaxLimitedGRARegs()         { return _maxLimitedGRARegs; }
    int32_t getNumLimitedGRARegsWithheld();
@@ -1685,6 +1689,7 @@ public:
    static void setScratchSpaceLimit(size_t newScratchSpaceLimit) { _scratchSpaceLimit = newScratchSpaceLimit; }
    static size_t getScratchSpaceLowerBound() { return _scratchSpaceLowerBound; }
    static void setScratchSpaceLowerBound(size_t scratchSpaceLowerBound) { _scratchSpaceLowerBound = scratchSpaceLowerBound; }
+   static size_t getSegmentCacheRetention() { return _segmentCacheRetention; }
 
 
    static int32_t getAggressivityLevel() { return _aggressivenessLevel; }
@@ -1748,6 +1753,7 @@ public:
 
    static size_t _scratchSpaceLimit;
    static size_t _scratchSpaceLowerBound;
+   static size_t _segmentCacheRetention; // 0 to keep the segment cache's default retention target
    static uint32_t _minBytesToLeaveAllocatedInSharedPool; // 0 to disable the feature and revert to old behavior
    static uint32_t _maxBytesToLeaveAllocatedInSharedPool; // 0 to disable the feature and revert to old behavior
 
@@ -1849,6 +1855,7 @@ public:
    void disableCHOpts(); // disable CHOpts, but also IPA and prex which depend on the chtable
 
    const char *getObjectFileName() { return _objectFileName; }
+   const char *getAOTCodeCacheFileName() { return _aotCodeCacheFileName; }
 
 protected:
    void  jitPreProcess();
@@ -2289,6 +2296,10 @@ protected:
    int32_t                     _inlinerCGColdBorderFrequency;
    int32_t                     _inlinerCGVeryColdBorderFrequency;
    int32_t                     _alwaysWorthInliningThreshold;
+   int32_t                     _compileTimeBudget;
+   int32_t                     _tieredRecompileThreshold;
+   int32_t                     _jitBuilderInlineBudget;
+   int32_t                     _jitBuilderInlineMaxSize;
 
    int32_t                     _initialSCount;
    int32_t                     _enableSCHintFlags;
@@ -2326,6 +2337,7 @@ protected:
    int32_t                     _loopyAsyncCheckInsertionMaxEntryFreq;
 
    char *                      _objectFileName; //Name of the relocatable ELF file *.o if one is to be generated
+   char *                      _aotCodeCacheFileName; //Name of the file backing the persistent AOT code cache
 
    }; // TR::Options
 
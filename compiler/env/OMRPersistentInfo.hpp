@@ -33,6 +33,7 @@ namespace OMR { typedef PersistentInfo PersistentInfoConnector; }
 #include "codegen/TableOfConstants.hpp"
 
 class TR_AddressSet;
+class TR_EdgeProfile;
 class TR_FrontEnd;
 class TR_PersistentMemory;
 class TR_PseudoRandomNumbersListElement;
@@ -74,7 +75,8 @@ class PersistentInfo
          _curIndex(0),
          _dynamicCounters(NULL),
          _staticCounters(NULL),
-         _persistentTOC(NULL)
+         _persistentTOC(NULL),
+         _edgeProfiles(NULL)
       {}
 
    TR::PersistentInfo * self();
@@ -107,6 +109,11 @@ class PersistentInfo
    TableOfConstants *getPersistentTOC() {return _persistentTOC;}
    void setPersistentTOC(TableOfConstants *toc) {_persistentTOC = toc;}
 
+   // Edge counts collected by methods compiled with enableEdgeProfiling.
+   // The list is only ever prepended to, with a compare-and-swap on its head.
+   TR_EdgeProfile *getEdgeProfiles() { return _edgeProfiles; }
+   TR_EdgeProfile * volatile *getEdgeProfilesAddress() { return &_edgeProfiles; }
+
    bool isObsoleteClass(void *v, TR_FrontEnd *fe) { return false; } // Has class been unloaded, replaced (HCR), etc.
 
    bool isRuntimeInstrumentationEnabled() { return false; }
@@ -125,6 +132,7 @@ class PersistentInfo
    TR::DebugCounterGroup *_dynamicCounters;
    int64_t _lastDebugCounterResetSeconds;
    TableOfConstants *_persistentTOC;
+   TR_EdgeProfile * volatile _edgeProfiles;
    };
 
 }
@@ -19,6 +19,7 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+#include <string.h>
 #include "env/MemorySegment.hpp"
 #include "env/SegmentProvider.hpp"
 #include "env/Region.hpp"
@@ -29,22 +30,32 @@ namespace TR {
 
 Region::Region(TR::SegmentProvider &segmentProvider, TR::RawAllocator rawAllocator) :
    _bytesAllocated(0),
+   _bytesInUse(0),
+   _highWaterMark(0),
+   _bytesRecycled(0),
+   _freeListsEnabled(false),
    _segmentProvider(segmentProvider),
    _rawAllocator(rawAllocator),
    _initialSegment(_initialSegmentArea.data, INITIAL_SEGMENT_SIZE),
    _currentSegment(TR::ref(_initialSegment)),
    _lastDestructable(NULL)
    {
+   memset(_freeLists, 0, sizeof(_freeLists));
    }
 
 Region::Region(const Region &prototype) :
    _bytesAllocated(0),
+   _bytesInUse(0),
+   _highWaterMark(0),
+   _bytesRecycled(0),
+   _freeListsEnabled(prototype._freeListsEnabled),
    _segmentProvider(prototype._segmentProvider),
    _rawAllocator(prototype._rawAllocator),
    _initialSegment(_initialSegmentArea.data, INITIAL_SEGMENT_SIZE),
    _currentSegment(TR::ref(_initialSegment)),
    _lastDestructable(NULL)
    {
+   memset(_freeLists, 0, sizeof(_freeLists));
    }
 
 Region::~Region() throw()
@@ -77,22 +88,103 @@ void *
 Region::allocate(size_t const size, void *hint)
    {
    size_t const roundedSize = round(size);
-   if (_currentSegment.get().remaining() >= roundedSize)
+   _bytesAllocated += roundedSize;
+   _bytesInUse += roundedSize;
+   if (_bytesInUse > _highWaterMark)
+      _highWaterMark = _bytesInUse;
+
+   if (_freeListsEnabled)
       {
-      _bytesAllocated += roundedSize;
-      return _currentSegment.get().allocate(roundedSize);
+      void *block = allocateFromFreeList(roundedSize);
+      if (block)
+         {
+         _bytesRecycled += roundedSize;
+         return block;
+         }
       }
+
+   if (_currentSegment.get().remaining() >= roundedSize)
+      return _currentSegment.get().allocate(roundedSize);
+
    TR::MemorySegment &newSegment = _segmentProvider.request(roundedSize);
    TR_ASSERT(newSegment.remaining() >= roundedSize, "Allocated segment is too small");
    newSegment.link(_currentSegment.get());
    _currentSegment = TR::ref(newSegment);
-   _bytesAllocated += roundedSize;
    return _currentSegment.get().allocate(roundedSize);
    }
 
+void *
+Region::allocateFromFreeList(size_t roundedSize)
+   {
+   if (roundedSize == 0)
+      return NULL;
+
+   size_t sizeClassIndex = sizeClass(roundedSize);
+   FreeBlock *block = _freeLists[sizeClassIndex];
+   if (roundedSize <= MAX_SMALL_BLOCK_SIZE)
+      {
+      if (block)
+         _freeLists[sizeClassIndex] = block->_next;
+      return block;
+      }
+
+   // Look a few blocks into this size class for one that is large enough,
+   // then settle for any block of the next class up
+   FreeBlock **link = &_freeLists[sizeClassIndex];
+   for (int32_t probes = 0; *link && probes < 8; probes++, link = &(*link)->_next)
+      {
+      if ((*link)->_size >= roundedSize)
+         {
+         block = *link;
+         *link = block->_next;
+         return block;
+         }
+      }
+
+   if (sizeClassIndex + 1 < NUM_SIZE_CLASSES && _freeLists[sizeClassIndex + 1])
+      {
+      block = _freeLists[sizeClassIndex + 1];
+      _freeLists[sizeClassIndex + 1] = block->_next;
+      return block;
+      }
+
+   return NULL;
+   }
+
 void
-Region::deallocate(void * allocation, size_t) throw()
+Region::deallocate(void * allocation, size_t size) throw()
+   {
+   if (!allocation || size == 0)
+      return;
+
+   size_t const roundedSize = round(size);
+   _bytesInUse = roundedSize < _bytesInUse ? _bytesInUse - roundedSize : 0;
+
+   if (!_freeListsEnabled)
+      return;
+
+   FreeBlock *block = static_cast<FreeBlock *>(allocation);
+   size_t sizeClassIndex = sizeClass(roundedSize);
+   block->_size = roundedSize;
+   block->_next = _freeLists[sizeClassIndex];
+   _freeLists[sizeClassIndex] = block;
+   }
+
+size_t
+Region::sizeClass(size_t roundedSize)
    {
+   if (roundedSize <= MAX_SMALL_BLOCK_SIZE)
+      return roundedSize / 16 - 1;
+
+   size_t log2Size = 0;
+   for (size_t remaining = roundedSize; remaining > 1; remaining >>= 1)
+      log2Size++;
+
+   // MAX_SMALL_BLOCK_SIZE is 2^8, so the large classes start at 2^8
+   size_t largeClass = log2Size - 8;
+   if (largeClass >= NUM_LARGE_CLASSES)
+      largeClass = NUM_LARGE_CLASSES - 1;
+   return NUM_SMALL_CLASSES + largeClass;
    }
 
 size_t
@@ -36,6 +36,7 @@ namespace TR {
 
 class SegmentProvider;
 class RegionProfiler;
+class SubRegion;
 
 class Region
    {
@@ -137,12 +138,56 @@ public:
 
    size_t bytesAllocated() { return _bytesAllocated; }
    static size_t initialSize() { return INITIAL_SEGMENT_SIZE; }
+
+   /**
+    * @brief Keep sized deallocations on free lists and reuse them for later
+    * allocations of the same size class.
+    *
+    * Only deallocations that pass a size, such as those made by the standard
+    * library containers through TR::typed_allocator, can be reused. Regions
+    * copied from this one inherit the setting.
+    */
+   void enableFreeLists() { _freeListsEnabled = true; }
+   bool freeListsEnabled() { return _freeListsEnabled; }
+
+   /// Bytes handed out and not yet deallocated with their size
+   size_t bytesInUse() { return _bytesInUse; }
+
+   /// Largest value bytesInUse() has reached
+   size_t highWaterMark() { return _highWaterMark; }
+
+   /// Bytes of allocations satisfied from the free lists
+   size_t bytesRecycled() { return _bytesRecycled; }
+
 private:
    friend class TR::RegionProfiler;
+   friend class TR::SubRegion;
+
+   struct FreeBlock
+      {
+      FreeBlock *_next;
+      size_t _size;
+      };
 
    size_t round(size_t bytes);
+   static size_t sizeClass(size_t roundedSize);
+   void *allocateFromFreeList(size_t roundedSize);
+
+   /*
+    * Blocks up to MAX_SMALL_BLOCK_SIZE bytes are kept on exact size lists,
+    * one per 16 byte step. Larger blocks are kept on one list per power of
+    * two and are searched first-fit.
+    */
+   static const size_t MAX_SMALL_BLOCK_SIZE = 256;
+   static const size_t NUM_SMALL_CLASSES = MAX_SMALL_BLOCK_SIZE / 16;
+   static const size_t NUM_LARGE_CLASSES = 32;
+   static const size_t NUM_SIZE_CLASSES = NUM_SMALL_CLASSES + NUM_LARGE_CLASSES;
 
    size_t _bytesAllocated;
+   size_t _bytesInUse;
+   size_t _highWaterMark;
+   size_t _bytesRecycled;
+   bool _freeListsEnabled;
    TR::SegmentProvider &_segmentProvider;
    TR::RawAllocator _rawAllocator;
    TR::MemorySegment _initialSegment;
@@ -150,6 +195,8 @@ private:
 
    Destructable *_lastDestructable;
 
+   FreeBlock *_freeLists[NUM_SIZE_CLASSES];
+
    static const size_t INITIAL_SEGMENT_SIZE = 4096;
 
    union {
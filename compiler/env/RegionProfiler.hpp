@@ -39,10 +39,12 @@ namespace TR {
  * This class makes use of the compiler's debug counter facility to record the
  * difference in memory usage for a region and its segment provider between the
  * two points of execution determined by the invocation of its constructor and
- * the invocation of its destructor. The lifetime of the region tracked by the
- * profiler object must comprehend the lifetime of the profiler itself. The
- * implementation requires a compilation object in order to determine whether
- * or not the facility is active.
+ * the invocation of its destructor. It also records the peak number of bytes
+ * in use in the region, and the bytes reused from its free lists, over the
+ * same span. The lifetime of the region tracked by the profiler object must
+ * comprehend the lifetime of the profiler itself. The implementation requires
+ * a compilation object in order to determine whether or not the facility is
+ * active.
  */
 
 class RegionProfiler
@@ -52,8 +54,14 @@ public:
       _region(region),
       _initialRegionSize(_region.bytesAllocated()),
       _initialSegmentProviderSize(_region._segmentProvider.bytesAllocated()),
+      _initialBytesInUse(_region._bytesInUse),
+      _initialBytesRecycled(_region._bytesRecycled),
+      _enclosingHighWaterMark(_region._highWaterMark),
       _compilation(compilation)
       {
+      // Track the peak of this span alone; the enclosing peak is restored on exit
+      _region._highWaterMark = _region._bytesInUse;
+
       if (_compilation.getOption(TR_ProfileMemoryRegions))
          {
          va_list args;
@@ -67,6 +75,10 @@ public:
 
    ~RegionProfiler()
       {
+      size_t const highWaterMark = _region._highWaterMark;
+      if (_enclosingHighWaterMark > _region._highWaterMark)
+         _region._highWaterMark = _enclosingHighWaterMark;
+
       if (_compilation.getOption(TR_ProfileMemoryRegions))
          {
          TR::DebugCounter::incStaticDebugCounter(
@@ -87,6 +99,24 @@ public:
                 ),
             static_cast<int32_t>((_region._segmentProvider.bytesAllocated() - _initialSegmentProviderSize) / 1024)
             );
+         TR::DebugCounter::incStaticDebugCounter(
+            &_compilation,
+            TR::DebugCounter::debugCounterName(
+               &_compilation,
+               "kbytesPeak.details/%s",
+               _identifier
+               ),
+            static_cast<int32_t>((highWaterMark - _initialBytesInUse) / 1024)
+            );
+         TR::DebugCounter::incStaticDebugCounter(
+            &_compilation,
+            TR::DebugCounter::debugCounterName(
+               &_compilation,
+               "kbytesRecycled.details/%s",
+               _identifier
+               ),
+            static_cast<int32_t>((_region._bytesRecycled - _initialBytesRecycled) / 1024)
+            );
          }
       }
 
@@ -94,6 +124,9 @@ private:
    TR::Region &_region;
    size_t const _initialRegionSize;
    size_t const _initialSegmentProviderSize;
+   size_t const _initialBytesInUse;
+   size_t const _initialBytesRecycled;
+   size_t const _enclosingHighWaterMark;
    TR::Compilation &_compilation;
    char _identifier[256];
    };
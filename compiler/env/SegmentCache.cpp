@@ -0,0 +1,359 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/SegmentCache.hpp"
+
+#include <new>
+#include "AtomicSupport.hpp"
+#include "infra/ThreadLocal.hpp"
+
+#if defined(LINUX)
+#include <unistd.h>
+#include <sys/syscall.h>
+#endif
+
+namespace TR
+{
+tlsDefine(void *, segmentCacheStash);
+}
+
+TR::SegmentCache::SegmentCache(TR::RawAllocator rawAllocator, size_t segmentSize, size_t retentionTarget, bool useThreadStashes) :
+   _rawAllocator(rawAllocator),
+   _segmentSize(segmentSize),
+   _retentionTarget(retentionTarget),
+   _useThreadStashes(useThreadStashes),
+   _stashes(NULL),
+   _retainedSegments(0),
+   _operations(0),
+   _hits(0),
+   _stashHits(0),
+   _misses(0),
+   _bytesTrimmed(0)
+   {
+   for (uint32_t i = 0; i < MAX_NODES; i++)
+      {
+      _shards[i]._lock = 0;
+      _shards[i]._head = NULL;
+      _shards[i]._count = 0;
+      _shards[i]._lowWater = 0;
+      }
+   if (_useThreadStashes)
+      tlsAlloc(segmentCacheStash);
+   }
+
+TR::SegmentCache::~SegmentCache() throw()
+   {
+   flush();
+   Stash *stash = _stashes;
+   while (stash)
+      {
+      Stash *next = stash->_next;
+      _rawAllocator.deallocate(stash);
+      stash = next;
+      }
+   }
+
+TR::SegmentCache &
+TR::SegmentCache::instance()
+   {
+   static SegmentCache cache(TR::RawAllocator(), DEFAULT_SEGMENT_SIZE, DEFAULT_RETENTION_TARGET, true);
+   return cache;
+   }
+
+uint32_t
+TR::SegmentCache::currentNode()
+   {
+#if defined(LINUX) && defined(SYS_getcpu)
+   unsigned cpu = 0;
+   unsigned node = 0;
+   if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0)
+      return node % MAX_NODES;
+#endif
+   return 0;
+   }
+
+void
+TR::SegmentCache::lock(Shard &shard)
+   {
+   while (VM_AtomicSupport::lockCompareExchange(&shard._lock, 0, 1) != 0)
+      VM_AtomicSupport::yieldCPU();
+   VM_AtomicSupport::readBarrier();
+   }
+
+void
+TR::SegmentCache::unlock(Shard &shard)
+   {
+   VM_AtomicSupport::writeBarrier();
+   shard._lock = 0;
+   }
+
+/*
+ * Each thread gets its own stash the first time it touches the process-wide
+ * cache. Stashes are chained together so that trim() can drain the stashes of
+ * threads that have since gone away; they are only freed with the cache.
+ */
+TR::SegmentCache::Stash *
+TR::SegmentCache::threadStash()
+   {
+   if (!_useThreadStashes)
+      return NULL;
+
+   Stash *stash = static_cast<Stash *>(tlsGet(segmentCacheStash, void *));
+   if (stash)
+      return stash;
+
+   stash = static_cast<Stash *>(_rawAllocator.allocate(sizeof(Stash), std::nothrow));
+   if (!stash)
+      return NULL;
+   for (uint32_t i = 0; i < STASH_SLOTS; i++)
+      stash->_slots[i] = 0;
+   stash->_node = currentNode();
+
+   Stash *head;
+   do
+      {
+      head = _stashes;
+      stash->_next = head;
+      }
+   while (VM_AtomicSupport::lockCompareExchange(
+             reinterpret_cast<volatile uintptr_t *>(&_stashes),
+             reinterpret_cast<uintptr_t>(head),
+             reinterpret_cast<uintptr_t>(stash)) != reinterpret_cast<uintptr_t>(head));
+
+   tlsSet(segmentCacheStash, static_cast<void *>(stash));
+   return stash;
+   }
+
+void *
+TR::SegmentCache::takeFromShard(Shard &shard)
+   {
+   lock(shard);
+   CachedSegment *segment = shard._head;
+   if (segment)
+      {
+      shard._head = segment->_next;
+      shard._count--;
+      if (shard._count < shard._lowWater)
+         shard._lowWater = shard._count;
+      }
+   unlock(shard);
+   return segment;
+   }
+
+void
+TR::SegmentCache::putInShard(Shard &shard, void *segment)
+   {
+   CachedSegment *cached = static_cast<CachedSegment *>(segment);
+   lock(shard);
+   cached->_next = shard._head;
+   shard._head = cached;
+   shard._count++;
+   unlock(shard);
+   }
+
+/*
+ * Claim room for one more segment under the retention target.
+ */
+bool
+TR::SegmentCache::reserve()
+   {
+   uintptr_t limit = _retentionTarget / _segmentSize;
+   for (;;)
+      {
+      uintptr_t retained = _retainedSegments;
+      if (retained >= limit)
+         return false;
+      if (VM_AtomicSupport::lockCompareExchange(&_retainedSegments, retained, retained + 1) == retained)
+         return true;
+      }
+   }
+
+void
+TR::SegmentCache::freeSegment(void *segment, bool trimmed) throw()
+   {
+   if (trimmed)
+      {
+      VM_AtomicSupport::subtract(&_retainedSegments, 1);
+      VM_AtomicSupport::add(&_bytesTrimmed, _segmentSize);
+      }
+   _rawAllocator.deallocate(segment);
+   }
+
+void
+TR::SegmentCache::tick()
+   {
+   if (VM_AtomicSupport::add(&_operations, 1) % DECAY_PERIOD == 0)
+      trim();
+   }
+
+void
+TR::SegmentCache::drainStashes()
+   {
+   for (Stash *stash = _stashes; stash; stash = stash->_next)
+      {
+      for (uint32_t i = 0; i < STASH_SLOTS; i++)
+         {
+         void *segment = reinterpret_cast<void *>(VM_AtomicSupport::lockExchange(&stash->_slots[i], 0));
+         if (segment)
+            putInShard(_shards[stash->_node], segment);
+         }
+      }
+   }
+
+void *
+TR::SegmentCache::request()
+   {
+   tick();
+
+   Stash *stash = threadStash();
+   if (stash)
+      {
+      for (uint32_t i = 0; i < STASH_SLOTS; i++)
+         {
+         void *segment = reinterpret_cast<void *>(VM_AtomicSupport::lockExchange(&stash->_slots[i], 0));
+         if (segment)
+            {
+            VM_AtomicSupport::subtract(&_retainedSegments, 1);
+            VM_AtomicSupport::add(&_hits, 1);
+            VM_AtomicSupport::add(&_stashHits, 1);
+            return segment;
+            }
+         }
+      }
+
+   // Prefer memory local to this node, but take a remote segment over a trip to the system
+   uint32_t node = stash ? stash->_node : currentNode();
+   for (uint32_t i = 0; i < MAX_NODES; i++)
+      {
+      void *segment = takeFromShard(_shards[(node + i) % MAX_NODES]);
+      if (segment)
+         {
+         VM_AtomicSupport::subtract(&_retainedSegments, 1);
+         VM_AtomicSupport::add(&_hits, 1);
+         return segment;
+         }
+      }
+
+   VM_AtomicSupport::add(&_misses, 1);
+   return _rawAllocator.allocate(_segmentSize);
+   }
+
+void
+TR::SegmentCache::release(void *segment) throw()
+   {
+   if (!segment)
+      return;
+
+   tick();
+
+   if (!reserve())
+      {
+      freeSegment(segment, false);
+      return;
+      }
+
+   Stash *stash = threadStash();
+   if (stash)
+      {
+      for (uint32_t i = 0; i < STASH_SLOTS; i++)
+         {
+         if (VM_AtomicSupport::lockCompareExchange(&stash->_slots[i], 0, reinterpret_cast<uintptr_t>(segment)) == 0)
+            return;
+         }
+      }
+
+   putInShard(_shards[stash ? stash->_node : currentNode()], segment);
+   }
+
+void
+TR::SegmentCache::setRetentionTarget(size_t bytes)
+   {
+   _retentionTarget = bytes;
+   uintptr_t limit = _retentionTarget / _segmentSize;
+   if (_retainedSegments <= limit)
+      return;
+
+   drainStashes();
+   for (uint32_t i = 0; i < MAX_NODES && _retainedSegments > limit; i++)
+      {
+      void *segment;
+      while (_retainedSegments > limit && (segment = takeFromShard(_shards[i])) != NULL)
+         freeSegment(segment, true);
+      }
+   }
+
+/*
+ * A segment that sat in a shard for a whole decay period is not needed by the
+ * current compilation load. Give half of those back, rounding up so that an
+ * idle cache eventually empties.
+ */
+void
+TR::SegmentCache::trim()
+   {
+   drainStashes();
+   for (uint32_t i = 0; i < MAX_NODES; i++)
+      {
+      Shard &shard = _shards[i];
+      CachedSegment *trimmed = NULL;
+      lock(shard);
+      for (size_t toTrim = (shard._lowWater + 1) / 2; toTrim > 0 && shard._head; toTrim--)
+         {
+         CachedSegment *segment = shard._head;
+         shard._head = segment->_next;
+         shard._count--;
+         segment->_next = trimmed;
+         trimmed = segment;
+         }
+      shard._lowWater = shard._count;
+      unlock(shard);
+
+      while (trimmed)
+         {
+         CachedSegment *next = trimmed->_next;
+         freeSegment(trimmed, true);
+         trimmed = next;
+         }
+      }
+   }
+
+void
+TR::SegmentCache::flush()
+   {
+   drainStashes();
+   for (uint32_t i = 0; i < MAX_NODES; i++)
+      {
+      void *segment;
+      while ((segment = takeFromShard(_shards[i])) != NULL)
+         freeSegment(segment, true);
+      }
+   }
+
+TR::SegmentCache::Statistics
+TR::SegmentCache::statistics()
+   {
+   Statistics stats;
+   stats.hits = _hits;
+   stats.stashHits = _stashHits;
+   stats.misses = _misses;
+   stats.bytesRetained = _retainedSegments * _segmentSize;
+   stats.bytesTrimmed = _bytesTrimmed;
+   return stats;
+   }
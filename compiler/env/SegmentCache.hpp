@@ -0,0 +1,142 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef TR_SEGMENT_CACHE
+#define TR_SEGMENT_CACHE
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+#include "env/RawAllocator.hpp"
+
+namespace TR {
+
+/**
+ * @brief The SegmentCache class keeps raw memory segments of one size alive
+ * between compilations, so that short compilations do not have to go back to
+ * the system allocator for every segment.
+ *
+ * Cached segments are kept in one shard per NUMA node. A segment goes back to
+ * the shard of the thread that releases it, which in practice is the thread
+ * that first touched it. The process-wide instance also gives each thread a
+ * small stash of segments that it can take from and return to without locking.
+ *
+ * The cache never holds more than its retention target. Every DECAY_PERIOD
+ * requests and releases, each shard gives half of the segments that stayed
+ * unused for the whole period back to the system.
+ */
+class SegmentCache
+   {
+public:
+   struct Statistics
+      {
+      size_t hits;           // requests satisfied from a shard or a stash
+      size_t stashHits;      // requests satisfied from the thread's own stash
+      size_t misses;         // requests passed to the raw allocator
+      size_t bytesRetained;  // bytes currently held by the cache
+      size_t bytesTrimmed;   // bytes given back to the raw allocator by decay or flushing
+      };
+
+   SegmentCache(TR::RawAllocator rawAllocator, size_t segmentSize, size_t retentionTarget, bool useThreadStashes = false);
+   ~SegmentCache() throw();
+
+   /// The cache shared by all compilations in the process
+   static SegmentCache &instance();
+
+   size_t segmentSize() const { return _segmentSize; }
+
+   /// Get a segment of segmentSize() bytes
+   void *request();
+
+   /// Give back a segment obtained from request() or from the raw allocator
+   void release(void *segment) throw();
+
+   size_t retentionTarget() const { return _retentionTarget; }
+   void setRetentionTarget(size_t bytes);
+
+   /// Run one decay step now
+   void trim();
+
+   /// Give every cached segment back to the raw allocator
+   void flush();
+
+   Statistics statistics();
+
+   static const size_t DEFAULT_SEGMENT_SIZE = 1 << 16;
+   static const size_t DEFAULT_RETENTION_TARGET = 16 * 1024 * 1024;
+
+private:
+   static const uint32_t MAX_NODES = 8;
+   static const uint32_t STASH_SLOTS = 2;
+   static const uintptr_t DECAY_PERIOD = 256;
+
+   struct CachedSegment
+      {
+      CachedSegment *_next;
+      };
+
+   struct Shard
+      {
+      volatile uintptr_t _lock;
+      CachedSegment *_head;
+      size_t _count;
+      size_t _lowWater;   // smallest _count since the last decay step
+      };
+
+   struct Stash
+      {
+      volatile uintptr_t _slots[STASH_SLOTS];
+      uint32_t _node;
+      Stash *_next;
+      };
+
+   static uint32_t currentNode();
+   static void lock(Shard &shard);
+   static void unlock(Shard &shard);
+
+   Stash *threadStash();
+   void *takeFromShard(Shard &shard);
+   void putInShard(Shard &shard, void *segment);
+   bool reserve();
+   void freeSegment(void *segment, bool trimmed) throw();
+   void tick();
+   void drainStashes();
+
+   TR::RawAllocator _rawAllocator;
+   size_t const _segmentSize;
+   size_t _retentionTarget;
+   bool const _useThreadStashes;
+
+   Shard _shards[MAX_NODES];
+   Stash * volatile _stashes;
+
+   volatile uintptr_t _retainedSegments;
+   volatile uintptr_t _operations;
+   volatile uintptr_t _hits;
+   volatile uintptr_t _stashHits;
+   volatile uintptr_t _misses;
+   volatile uintptr_t _bytesTrimmed;
+   };
+
+}
+
+#endif // TR_SEGMENT_CACHE
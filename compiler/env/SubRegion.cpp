@@ -0,0 +1,94 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "env/SubRegion.hpp"
+
+#include <new>
+#include <stdint.h>
+#include "env/MemorySegment.hpp"
+
+namespace TR {
+
+ParentRegionSegmentProvider::ParentRegionSegmentProvider(TR::Region &parent) :
+   SegmentProvider(DEFAULT_SEGMENT_SIZE),
+   _parent(parent),
+   _currentBytesAllocated(0),
+   _highWaterMark(0)
+   {
+   }
+
+ParentRegionSegmentProvider::~ParentRegionSegmentProvider() throw()
+   {
+   }
+
+// The segment descriptor sits at the front of the memory taken from the
+// parent, padded to keep the segment itself 16 byte aligned
+//
+size_t
+ParentRegionSegmentProvider::headerSize()
+   {
+   return (sizeof(TR::MemorySegment) + 15) & ~static_cast<size_t>(15);
+   }
+
+TR::MemorySegment &
+ParentRegionSegmentProvider::request(size_t requiredSize)
+   {
+   size_t segmentSize = requiredSize > defaultSegmentSize() ? requiredSize : defaultSegmentSize();
+   segmentSize = (segmentSize + 15) & ~static_cast<size_t>(15);
+
+   uint8_t *memory = static_cast<uint8_t *>(_parent.allocate(headerSize() + segmentSize));
+   TR::MemorySegment *segment = new (memory) TR::MemorySegment(memory + headerSize(), segmentSize);
+
+   _currentBytesAllocated += headerSize() + segmentSize;
+   if (_currentBytesAllocated > _highWaterMark)
+      _highWaterMark = _currentBytesAllocated;
+   return *segment;
+   }
+
+void
+ParentRegionSegmentProvider::release(TR::MemorySegment &segment) throw()
+   {
+   size_t totalSize = headerSize() + segment.size();
+   void *memory = &segment;
+   segment.~MemorySegment();
+   _parent.deallocate(memory, totalSize);
+   _currentBytesAllocated -= totalSize;
+   }
+
+size_t
+ParentRegionSegmentProvider::bytesAllocated() const throw()
+   {
+   return _highWaterMark;
+   }
+
+SubRegion::SubRegion(TR::Region &parent) :
+   ParentRegionSegmentProvider(parent),
+   Region(*static_cast<ParentRegionSegmentProvider *>(this), parent._rawAllocator)
+   {
+   if (parent.freeListsEnabled())
+      enableFreeLists();
+   }
+
+SubRegion::~SubRegion() throw()
+   {
+   }
+
+}
@@ -0,0 +1,80 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef TR_SUBREGION_HPP
+#define TR_SUBREGION_HPP
+
+#pragma once
+
+#include <stddef.h>
+#include "env/Region.hpp"
+#include "env/SegmentProvider.hpp"
+
+namespace TR {
+
+class MemorySegment;
+
+/**
+ * @brief A segment provider that carves its segments out of another region.
+ *
+ * Released segments are handed back to the parent with a sized deallocation,
+ * so they can be reused when the parent has free lists enabled.
+ */
+class ParentRegionSegmentProvider : public SegmentProvider
+   {
+public:
+   explicit ParentRegionSegmentProvider(TR::Region &parent);
+   virtual ~ParentRegionSegmentProvider() throw();
+
+   virtual TR::MemorySegment &request(size_t requiredSize);
+   virtual void release(TR::MemorySegment &segment) throw();
+   virtual size_t bytesAllocated() const throw();
+
+private:
+   static size_t headerSize();
+
+   TR::Region &_parent;
+   size_t _currentBytesAllocated;
+   size_t _highWaterMark;
+
+   static const size_t DEFAULT_SEGMENT_SIZE = 16384;
+   };
+
+/**
+ * @brief A region for short-lived scratch data that takes its memory from an
+ * enclosing region instead of a system segment provider.
+ *
+ * Creating a SubRegion does not touch the system allocator. When it is
+ * destroyed, its segments go back to the parent, so a pass that creates a
+ * scratch region for each unit of work keeps reusing the same memory. The
+ * parent must outlive the SubRegion, and nothing allocated from the SubRegion
+ * may be used after it is destroyed.
+ */
+class SubRegion : private ParentRegionSegmentProvider, public Region
+   {
+public:
+   explicit SubRegion(TR::Region &parent);
+   virtual ~SubRegion() throw();
+   };
+
+}
+
+#endif // TR_SUBREGION_HPP
@@ -21,10 +21,12 @@
 
 #include "env/SystemSegmentProvider.hpp"
 #include "env/MemorySegment.hpp"
+#include "env/SegmentCache.hpp"
 
-OMR::SystemSegmentProvider::SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator) :
+OMR::SystemSegmentProvider::SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator, TR::SegmentCache *cache) :
    TR::SegmentAllocator(segmentSize),
    _rawAllocator(rawAllocator),
+   _cache(cache),
    _currentBytesAllocated(0),
    _highWaterMark(0),
    _segments(std::less< TR::MemorySegment >(), SegmentSetAllocator(rawAllocator))
@@ -39,7 +41,7 @@ TR::MemorySegment &
 OMR::SystemSegmentProvider::request(size_t requiredSize)
    {
    size_t adjustedSize = ( ( requiredSize + (defaultSegmentSize() - 1) ) / defaultSegmentSize() ) * defaultSegmentSize();
-   void *newSegmentArea = _rawAllocator.allocate(adjustedSize);
+   void *newSegmentArea = allocateSegmentArea(adjustedSize);
    try
       {
       auto result = _segments.insert( TR::MemorySegment(newSegmentArea, adjustedSize) );
@@ -51,7 +53,7 @@ OMR::SystemSegmentProvider::request(size_t requiredSize)
       }
    catch (...)
       {
-      _rawAllocator.deallocate(newSegmentArea);
+      deallocateSegmentArea(newSegmentArea, adjustedSize);
       throw;
       }
    }
@@ -60,12 +62,29 @@ void
 OMR::SystemSegmentProvider::release(TR::MemorySegment &segment) throw()
    {
    auto it = _segments.find(segment);
-   _rawAllocator.deallocate(segment.base());
+   deallocateSegmentArea(segment.base(), segment.size());
    _currentBytesAllocated -= segment.size();
    TR_ASSERT(it != _segments.end(), "Segment lookup should never fail");
    _segments.erase(it);
    }
 
+void *
+OMR::SystemSegmentProvider::allocateSegmentArea(size_t size)
+   {
+   if (_cache && size == _cache->segmentSize())
+      return _cache->request();
+   return _rawAllocator.allocate(size);
+   }
+
+void
+OMR::SystemSegmentProvider::deallocateSegmentArea(void *area, size_t size) throw()
+   {
+   if (_cache && size == _cache->segmentSize())
+      _cache->release(area);
+   else
+      _rawAllocator.deallocate(area);
+   }
+
 size_t
 OMR::SystemSegmentProvider::bytesAllocated() const throw()
    {
@@ -30,6 +30,8 @@ namespace OMR { class SystemSegmentProvider; }
 namespace TR { using OMR::SystemSegmentProvider; }
 #endif
 
+namespace TR { class SegmentCache; }
+
 #include <stddef.h>
 #include <set>
 #include "env/TypedAllocator.hpp"
@@ -42,7 +44,11 @@ namespace OMR {
 class SystemSegmentProvider : public TR::SegmentAllocator
    {
 public:
-   SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator);
+   /**
+    * @param cache if given, segments of the cache's segment size are taken
+    *        from and returned to it instead of the raw allocator
+    */
+   SystemSegmentProvider(size_t segmentSize, TR::RawAllocator rawAllocator, TR::SegmentCache *cache = NULL);
    ~SystemSegmentProvider() throw();
    virtual TR::MemorySegment &request(size_t requiredSize);
    virtual void release(TR::MemorySegment &segment) throw();
@@ -53,7 +59,11 @@ public:
    void setAllocationLimit(size_t);
 
 private:
+   void *allocateSegmentArea(size_t size);
+   void deallocateSegmentArea(void *area, size_t size) throw();
+
    TR::RawAllocator _rawAllocator;
+   TR::SegmentCache * const _cache;
    size_t _currentBytesAllocated;
    size_t _highWaterMark;
    typedef TR::typed_allocator<
@@ -36,23 +36,35 @@ namespace OMR {
 #define TR_Bad TR::BadILOp
 
 static TR::ILOpCodes conversionMap[TR::NumOMRTypes][TR::NumOMRTypes] =
-//                    No      Int8     Int16    Int32    Int64    Float    Double   Addr     VectorInt8 VectorInt16 VectorInt32 VectorInt64 VectorFloat VectorDouble Aggregate
+//                       No      Int8     Int16    Int32    Int64    Float    Double   Addr     VectorInt8  VectorInt16  VectorInt32  VectorInt64  VectorFloat  VectorDouble  Vector256Int8  Vector256Int16  Vector256Int32  Vector256Int64  Vector256Float  Vector256Double  Vector512Int8  Vector512Int16  Vector512Int32  Vector512Int64  Vector512Float  Vector512Double  Aggregate
    {
-/* NoType */        { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,    TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,      TR_Bad },  // NoType
-/* Int8 */          { TR_Bad, TR_Bad,  TR::b2s, TR::b2i, TR::b2l, TR::b2f, TR::b2d, TR::b2a, TR_Bad,    TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,      TR_Bad },  // Int8
-/* Int16 */         { TR_Bad, TR::s2b, TR_Bad,  TR::s2i, TR::s2l, TR::s2f, TR::s2d, TR::s2a, TR_Bad,    TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,      TR_Bad },  // Int16
-/* Int32 */         { TR_Bad, TR::i2b, TR::i2s, TR_Bad,  TR::i2l, TR::i2f, TR::i2d, TR::i2a, TR_Bad,    TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,      TR_Bad },  // Int32
-/* Int64 */         { TR_Bad, TR::l2b, TR::l2s, TR::l2i, TR_Bad,  TR::l2f, TR::l2d, TR::l2a, TR_Bad,    TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,      TR_Bad },  // Int64
-/* Float */         { TR_Bad, TR::f2b, TR::f2s, TR::f2i, TR::f2l, TR_Bad,  TR::f2d, TR_Bad,  TR_Bad,    TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,      TR_Bad },  // Float
-/* Double */        { TR_Bad, TR::d2b, TR::d2s, TR::d2i, TR::d2l, TR::d2f, TR_Bad,  TR_Bad,  TR_Bad,    TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,      TR_Bad },  // Double
-/* Address */       { TR_Bad, TR::a2b, TR::a2s, TR::a2i, TR::a2l, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,    TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,      TR_Bad },  // Address
-/* VectorInt8 */    { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,    TR::v2v,    TR::v2v,    TR::v2v,    TR::v2v,    TR::v2v,     TR_Bad },  // VectorInt8
-/* VectorInt16 */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR::v2v,   TR_Bad,     TR::v2v,    TR::v2v,    TR::v2v,    TR::v2v,     TR_Bad },  // VectorInt16
-/* VectorInt32 */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR::v2v,   TR::v2v,    TR_Bad,     TR::v2v,    TR::v2v,    TR::v2v,     TR_Bad },  // VectorInt32
-/* VectorInt64 */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR::v2v,   TR::v2v,    TR::v2v,    TR_Bad,     TR::v2v,    TR::v2v,     TR_Bad },  // VectorInt64
-/* VectorFloat */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR::v2v,   TR::v2v,    TR::v2v,    TR::v2v,    TR_Bad,     TR::v2v,     TR_Bad },  // VectorFloat
-/* VectorDouble */  { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR::v2v,   TR::v2v,    TR::v2v,    TR::v2v,    TR::v2v,    TR_Bad,      TR_Bad },  // VectorDouble
-/* Aggregate */     { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,    TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,     TR_Bad,      TR_Bad },  // Aggregate
+/* NoType */           { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // NoType
+/* Int8 */             { TR_Bad, TR_Bad,  TR::b2s, TR::b2i, TR::b2l, TR::b2f, TR::b2d, TR::b2a, TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Int8
+/* Int16 */            { TR_Bad, TR::s2b, TR_Bad,  TR::s2i, TR::s2l, TR::s2f, TR::s2d, TR::s2a, TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Int16
+/* Int32 */            { TR_Bad, TR::i2b, TR::i2s, TR_Bad,  TR::i2l, TR::i2f, TR::i2d, TR::i2a, TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Int32
+/* Int64 */            { TR_Bad, TR::l2b, TR::l2s, TR::l2i, TR_Bad,  TR::l2f, TR::l2d, TR::l2a, TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Int64
+/* Float */            { TR_Bad, TR::f2b, TR::f2s, TR::f2i, TR::f2l, TR_Bad,  TR::f2d, TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Float
+/* Double */           { TR_Bad, TR::d2b, TR::d2s, TR::d2i, TR::d2l, TR::d2f, TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Double
+/* Address */          { TR_Bad, TR::a2b, TR::a2s, TR::a2i, TR::a2l, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Address
+/* VectorInt8 */       { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR::v2v,     TR::v2v,     TR::v2v,     TR::v2v,     TR::v2v,      TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // VectorInt8
+/* VectorInt16 */      { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR::v2v,    TR_Bad,      TR::v2v,     TR::v2v,     TR::v2v,     TR::v2v,      TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // VectorInt16
+/* VectorInt32 */      { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR::v2v,    TR::v2v,     TR_Bad,      TR::v2v,     TR::v2v,     TR::v2v,      TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // VectorInt32
+/* VectorInt64 */      { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR::v2v,    TR::v2v,     TR::v2v,     TR_Bad,      TR::v2v,     TR::v2v,      TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // VectorInt64
+/* VectorFloat */      { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR::v2v,    TR::v2v,     TR::v2v,     TR::v2v,     TR_Bad,      TR::v2v,      TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // VectorFloat
+/* VectorDouble */     { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR::v2v,    TR::v2v,     TR::v2v,     TR::v2v,     TR::v2v,     TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // VectorDouble
+/* Vector256Int8 */    { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR::v2v,        TR::v2v,        TR::v2v,        TR::v2v,        TR::v2v,         TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Vector256Int8
+/* Vector256Int16 */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR::v2v,       TR_Bad,         TR::v2v,        TR::v2v,        TR::v2v,        TR::v2v,         TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Vector256Int16
+/* Vector256Int32 */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR::v2v,       TR::v2v,        TR_Bad,         TR::v2v,        TR::v2v,        TR::v2v,         TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Vector256Int32
+/* Vector256Int64 */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR::v2v,       TR::v2v,        TR::v2v,        TR_Bad,         TR::v2v,        TR::v2v,         TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Vector256Int64
+/* Vector256Float */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR::v2v,       TR::v2v,        TR::v2v,        TR::v2v,        TR_Bad,         TR::v2v,         TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Vector256Float
+/* Vector256Double */  { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR::v2v,       TR::v2v,        TR::v2v,        TR::v2v,        TR::v2v,        TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Vector256Double
+/* Vector512Int8 */    { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR::v2v,        TR::v2v,        TR::v2v,        TR::v2v,        TR::v2v,         TR_Bad },  // Vector512Int8
+/* Vector512Int16 */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR::v2v,       TR_Bad,         TR::v2v,        TR::v2v,        TR::v2v,        TR::v2v,         TR_Bad },  // Vector512Int16
+/* Vector512Int32 */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR::v2v,       TR::v2v,        TR_Bad,         TR::v2v,        TR::v2v,        TR::v2v,         TR_Bad },  // Vector512Int32
+/* Vector512Int64 */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR::v2v,       TR::v2v,        TR::v2v,        TR_Bad,         TR::v2v,        TR::v2v,         TR_Bad },  // Vector512Int64
+/* Vector512Float */   { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR::v2v,       TR::v2v,        TR::v2v,        TR::v2v,        TR_Bad,         TR::v2v,         TR_Bad },  // Vector512Float
+/* Vector512Double */  { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR::v2v,       TR::v2v,        TR::v2v,        TR::v2v,        TR::v2v,        TR_Bad,          TR_Bad },  // Vector512Double
+/* Aggregate */        { TR_Bad, TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,  TR_Bad,     TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,      TR_Bad,       TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad,        TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,         TR_Bad,          TR_Bad },  // Aggregate
    };
 
 #undef TR_Bad
@@ -89,17 +101,25 @@ OMR::DataType::getMaxPrecisionFromType()
       }
    }
 
+static_assert(TR::Vector256Int8 == TR::VectorInt8 + TR::NumVectorElementTypes &&
+              TR::Vector512Int8 == TR::Vector256Int8 + TR::NumVectorElementTypes &&
+              TR::Aggregate == TR::Vector512Double + 1,
+              "vector data types must be laid out as one group of element types per vector length");
+
+static_assert(TR::VectorDouble - TR::VectorInt8 == TR::Double - TR::Int8,
+              "vector element types must be in the same order as their scalar types");
+
 TR::DataType
 OMR::DataType::getVectorIntegralType()
    {
-   switch(self()->getDataType())
+   switch (self()->getVectorElementType().getDataType())
       {
-      case TR::VectorInt8:
-      case TR::VectorInt16:
-      case TR::VectorInt32:
-      case TR::VectorInt64: return self()->getDataType();
-      case TR::VectorFloat: return TR::VectorInt32;
-      case TR::VectorDouble: return TR::VectorInt64;
+      case TR::Int8:
+      case TR::Int16:
+      case TR::Int32:
+      case TR::Int64: return self()->getDataType();
+      case TR::Float: return TR::DataType::createVectorType(TR::Int32, self()->getVectorLength());
+      case TR::Double: return TR::DataType::createVectorType(TR::Int64, self()->getVectorLength());
       default:
          return TR::NoType;
          break;
@@ -109,62 +129,49 @@ OMR::DataType::getVectorIntegralType()
 TR::DataType
 OMR::DataType::getVectorElementType()
    {
-   switch(self()->getDataType())
-      {
-      case TR::VectorInt8: return TR::Int8;
-      case TR::VectorInt16: return TR::Int16;
-      case TR::VectorInt32: return TR::Int32;
-      case TR::VectorInt64: return TR::Int64;
-      case TR::VectorFloat: return TR::Float;
-      case TR::VectorDouble: return TR::Double;
-      default:
-         return TR::NoType;
-         break;
-      }
+   if (!self()->isVector())
+      return TR::NoType;
+
+   return (TR::DataTypes)(TR::Int8 + (self()->getDataType() - TR::VectorInt8) % TR::NumVectorElementTypes);
+   }
+
+TR::VectorLength
+OMR::DataType::getVectorLength()
+   {
+   if (!self()->isVector())
+      return TR::NoVectorLength;
+
+   return (TR::VectorLength)(TR::VectorLength128 + (self()->getDataType() - TR::VectorInt8) / TR::NumVectorElementTypes);
+   }
+
+TR::DataType
+OMR::DataType::createVectorType(TR::DataType elementType, TR::VectorLength length)
+   {
+   if (elementType.getDataType() < TR::Int8 || elementType.getDataType() > TR::Double ||
+       length < TR::VectorLength128 || length > TR::VectorLength512)
+      return TR::NoType;
+
+   return (TR::DataTypes)(TR::VectorInt8 +
+                          (length - TR::VectorLength128) * TR::NumVectorElementTypes +
+                          (elementType.getDataType() - TR::Int8));
    }
 
 TR::DataType
 OMR::DataType::vectorToScalar()
    {
-   switch (self()->getDataType())
-      {
-      case TR::VectorInt8:
-         return TR::Int8;
-      case TR::VectorInt16:
-         return TR::Int16;
-      case TR::VectorInt32:
-         return TR::Int32;
-      case TR::VectorInt64:
-         return TR::Int64;
-      case TR::VectorFloat:
-         return TR::Float;
-      case TR::VectorDouble:
-         return TR::Double;
-      default:
-         return TR::NoType;
-      }
+   return self()->getVectorElementType();
    }
 
 TR::DataType
 OMR::DataType::scalarToVector()
    {
-   switch (self()->getDataType())
-      {
-      case TR::Int8:
-         return TR::VectorInt8;
-      case TR::Int16:
-         return TR::VectorInt16;
-      case TR::Int32:
-         return TR::VectorInt32;
-      case TR::Int64:
-         return TR::VectorInt64;
-      case TR::Float:
-         return TR::VectorFloat;
-      case TR::Double:
-         return TR::VectorDouble;
-      default:
-         return TR::NoType;
-      }
+   return self()->scalarToVector(TR::VectorLength128);
+   }
+
+TR::DataType
+OMR::DataType::scalarToVector(TR::VectorLength length)
+   {
+   return TR::DataType::createVectorType(self()->getDataType(), length);
    }
 
 TR::DataType
@@ -236,6 +243,18 @@ static int32_t OMRDataTypeSizes[] =
    16,                // TR::VectorInt64
    16,                // TR::VectorFloat
    16,                // TR::VectorDouble
+   32,                // TR::Vector256Int8
+   32,                // TR::Vector256Int16
+   32,                // TR::Vector256Int32
+   32,                // TR::Vector256Int64
+   32,                // TR::Vector256Float
+   32,                // TR::Vector256Double
+   64,                // TR::Vector512Int8
+   64,                // TR::Vector512Int16
+   64,                // TR::Vector512Int32
+   64,                // TR::Vector512Int64
+   64,                // TR::Vector512Float
+   64,                // TR::Vector512Double
    0,                 // TR::Aggregate
    };
 
@@ -272,6 +291,18 @@ static const char * OMRDataTypeNames[] =
    "VectorInt64",
    "VectorFloat",
    "VectorDouble",
+   "Vector256Int8",
+   "Vector256Int16",
+   "Vector256Int32",
+   "Vector256Int64",
+   "Vector256Float",
+   "Vector256Double",
+   "Vector512Int8",
+   "Vector512Int16",
+   "Vector512Int32",
+   "Vector512Int64",
+   "Vector512Float",
+   "Vector512Double",
    "Aggregate",
    };
 
@@ -307,6 +338,18 @@ static const char *OMRDataTypePrefixes[] =
    "VI8",   // TR::VectorInt64
    "VF",    // TR::VectorFloat
    "VD",    // TR::VectorDouble
+   "V256I1", // TR::Vector256Int8
+   "V256I2", // TR::Vector256Int16
+   "V256I4", // TR::Vector256Int32
+   "V256I8", // TR::Vector256Int64
+   "V256F", // TR::Vector256Float
+   "V256D", // TR::Vector256Double
+   "V512I1", // TR::Vector512Int8
+   "V512I2", // TR::Vector512Int16
+   "V512I4", // TR::Vector512Int32
+   "V512I8", // TR::Vector512Int64
+   "V512F", // TR::Vector512Float
+   "V512D", // TR::Vector512Double
    "AG",    // TR::Aggregate
    };
 
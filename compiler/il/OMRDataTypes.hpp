@@ -235,11 +235,38 @@ enum DataTypes
    VectorInt64,
    VectorFloat,
    VectorDouble,
+   Vector256Int8,
+   Vector256Int16,
+   Vector256Int32,
+   Vector256Int64,
+   Vector256Float,
+   Vector256Double,
+   Vector512Int8,
+   Vector512Int16,
+   Vector512Int32,
+   Vector512Int64,
+   Vector512Float,
+   Vector512Double,
    Aggregate,
    NumOMRTypes,
 #include "il/DataTypesEnum.hpp"
    NumTypes
    };
+
+/**
+ * Length of a vector data type. The vector data types are laid out in
+ * DataTypes as one group of element types per length, in this order.
+ */
+enum VectorLength
+   {
+   NoVectorLength = 0,
+   VectorLength128,
+   VectorLength256,
+   VectorLength512,
+   NumVectorLengths
+   };
+
+static const int32_t NumVectorElementTypes = TR::VectorDouble - TR::VectorInt8 + 1;
 }
 
 /**
@@ -392,6 +419,24 @@ public:
 
    TR::DataType vectorToScalar();
    TR::DataType scalarToVector();
+   TR::DataType scalarToVector(TR::VectorLength length);
+
+   /**
+    * @brief Returns the length of a vector data type, or TR::NoVectorLength
+    *        for any other type.
+    */
+   TR::VectorLength getVectorLength();
+
+   /**
+    * @brief Returns the vector data type of the given length whose elements
+    *        are of the given scalar type, or TR::NoType if there is none.
+    */
+   static TR::DataType createVectorType(TR::DataType elementType, TR::VectorLength length);
+
+   /**
+    * @brief Returns the size in bytes of a vector of the given length.
+    */
+   static int32_t getVectorSize(TR::VectorLength length) { return length == TR::NoVectorLength ? 0 : 16 << (length - TR::VectorLength128); }
 
    const char * toString() const;
 
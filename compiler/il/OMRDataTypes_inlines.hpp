@@ -80,8 +80,7 @@ OMR::DataType::isFloatingPoint()
 bool
 OMR::DataType::isVector()
    {
-   return self()->getDataType() == TR::VectorInt8 || self()->getDataType() == TR::VectorInt16 || self()->getDataType() == TR::VectorInt32 || self()->getDataType() == TR::VectorInt64 ||
-                        self()->getDataType() == TR::VectorFloat || self()->getDataType() == TR::VectorDouble;
+   return self()->getDataType() >= TR::VectorInt8 && self()->getDataType() <= TR::Vector512Double;
    }
 
 bool
@@ -41,6 +41,18 @@ TR::ILOpCodes OMR::IL::opCodesForConst[] =
    TR::vconst,   // VectorInt64
    TR::vconst,   // VectorFloat
    TR::vconst,   // VectorDouble
+   TR::vconst,   // Vector256Int8
+   TR::vconst,   // Vector256Int16
+   TR::vconst,   // Vector256Int32
+   TR::vconst,   // Vector256Int64
+   TR::vconst,   // Vector256Float
+   TR::vconst,   // Vector256Double
+   TR::vconst,   // Vector512Int8
+   TR::vconst,   // Vector512Int16
+   TR::vconst,   // Vector512Int32
+   TR::vconst,   // Vector512Int64
+   TR::vconst,   // Vector512Float
+   TR::vconst,   // Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -60,6 +72,18 @@ TR::ILOpCodes OMR::IL::opCodesForDirectLoad[] =
    TR::vload,    // VectorInt64
    TR::vload,    // VectorFloat
    TR::vload,    // VectorDouble
+   TR::vload,    // Vector256Int8
+   TR::vload,    // Vector256Int16
+   TR::vload,    // Vector256Int32
+   TR::vload,    // Vector256Int64
+   TR::vload,    // Vector256Float
+   TR::vload,    // Vector256Double
+   TR::vload,    // Vector512Int8
+   TR::vload,    // Vector512Int16
+   TR::vload,    // Vector512Int32
+   TR::vload,    // Vector512Int64
+   TR::vload,    // Vector512Float
+   TR::vload,    // Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -79,6 +103,18 @@ TR::ILOpCodes OMR::IL::opCodesForDirectReadBarrier[] =
    TR::BadILOp,  // VectorInt64
    TR::BadILOp,  // VectorFloat
    TR::BadILOp,  // VectorDouble
+   TR::BadILOp,  // Vector256Int8
+   TR::BadILOp,  // Vector256Int16
+   TR::BadILOp,  // Vector256Int32
+   TR::BadILOp,  // Vector256Int64
+   TR::BadILOp,  // Vector256Float
+   TR::BadILOp,  // Vector256Double
+   TR::BadILOp,  // Vector512Int8
+   TR::BadILOp,  // Vector512Int16
+   TR::BadILOp,  // Vector512Int32
+   TR::BadILOp,  // Vector512Int64
+   TR::BadILOp,  // Vector512Float
+   TR::BadILOp,  // Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -98,6 +134,18 @@ TR::ILOpCodes OMR::IL::opCodesForDirectStore[] =
    TR::vstore,   // VectorInt64
    TR::vstore,   // VectorFloat
    TR::vstore,   // VectorDouble
+   TR::vstore,   // Vector256Int8
+   TR::vstore,   // Vector256Int16
+   TR::vstore,   // Vector256Int32
+   TR::vstore,   // Vector256Int64
+   TR::vstore,   // Vector256Float
+   TR::vstore,   // Vector256Double
+   TR::vstore,   // Vector512Int8
+   TR::vstore,   // Vector512Int16
+   TR::vstore,   // Vector512Int32
+   TR::vstore,   // Vector512Int64
+   TR::vstore,   // Vector512Float
+   TR::vstore,   // Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -117,6 +165,18 @@ TR::ILOpCodes OMR::IL::opCodesForDirectWriteBarrier[] =
    TR::BadILOp,   // VectorInt64
    TR::BadILOp,   // VectorFloat
    TR::BadILOp,   // VectorDouble
+   TR::BadILOp,   // Vector256Int8
+   TR::BadILOp,   // Vector256Int16
+   TR::BadILOp,   // Vector256Int32
+   TR::BadILOp,   // Vector256Int64
+   TR::BadILOp,   // Vector256Float
+   TR::BadILOp,   // Vector256Double
+   TR::BadILOp,   // Vector512Int8
+   TR::BadILOp,   // Vector512Int16
+   TR::BadILOp,   // Vector512Int32
+   TR::BadILOp,   // Vector512Int64
+   TR::BadILOp,   // Vector512Float
+   TR::BadILOp,   // Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -136,6 +196,18 @@ TR::ILOpCodes OMR::IL::opCodesForIndirectLoad[] =
    TR::vloadi,   // TR::VectorInt64
    TR::vloadi,   // TR::VectorFloat
    TR::vloadi,   // TR::VectorDouble
+   TR::vloadi,   // TR::Vector256Int8
+   TR::vloadi,   // TR::Vector256Int16
+   TR::vloadi,   // TR::Vector256Int32
+   TR::vloadi,   // TR::Vector256Int64
+   TR::vloadi,   // TR::Vector256Float
+   TR::vloadi,   // TR::Vector256Double
+   TR::vloadi,   // TR::Vector512Int8
+   TR::vloadi,   // TR::Vector512Int16
+   TR::vloadi,   // TR::Vector512Int32
+   TR::vloadi,   // TR::Vector512Int64
+   TR::vloadi,   // TR::Vector512Float
+   TR::vloadi,   // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -155,6 +227,18 @@ TR::ILOpCodes OMR::IL::opCodesForIndirectReadBarrier[] =
    TR::BadILOp,  // TR::VectorInt64
    TR::BadILOp,  // TR::VectorFloat
    TR::BadILOp,  // TR::VectorDouble
+   TR::BadILOp,  // TR::Vector256Int8
+   TR::BadILOp,  // TR::Vector256Int16
+   TR::BadILOp,  // TR::Vector256Int32
+   TR::BadILOp,  // TR::Vector256Int64
+   TR::BadILOp,  // TR::Vector256Float
+   TR::BadILOp,  // TR::Vector256Double
+   TR::BadILOp,  // TR::Vector512Int8
+   TR::BadILOp,  // TR::Vector512Int16
+   TR::BadILOp,  // TR::Vector512Int32
+   TR::BadILOp,  // TR::Vector512Int64
+   TR::BadILOp,  // TR::Vector512Float
+   TR::BadILOp,  // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -174,6 +258,18 @@ TR::ILOpCodes OMR::IL::opCodesForIndirectStore[] =
    TR::vstorei,  // TR::VectorInt64
    TR::vstorei,  // TR::VectorFloat
    TR::vstorei,  // TR::VectorDouble
+   TR::vstorei,  // TR::Vector256Int8
+   TR::vstorei,  // TR::Vector256Int16
+   TR::vstorei,  // TR::Vector256Int32
+   TR::vstorei,  // TR::Vector256Int64
+   TR::vstorei,  // TR::Vector256Float
+   TR::vstorei,  // TR::Vector256Double
+   TR::vstorei,  // TR::Vector512Int8
+   TR::vstorei,  // TR::Vector512Int16
+   TR::vstorei,  // TR::Vector512Int32
+   TR::vstorei,  // TR::Vector512Int64
+   TR::vstorei,  // TR::Vector512Float
+   TR::vstorei,  // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -193,6 +289,18 @@ TR::ILOpCodes OMR::IL::opCodesForIndirectWriteBarrier[] =
    TR::BadILOp,   // VectorInt64
    TR::BadILOp,   // VectorFloat
    TR::BadILOp,   // VectorDouble
+   TR::BadILOp,   // Vector256Int8
+   TR::BadILOp,   // Vector256Int16
+   TR::BadILOp,   // Vector256Int32
+   TR::BadILOp,   // Vector256Int64
+   TR::BadILOp,   // Vector256Float
+   TR::BadILOp,   // Vector256Double
+   TR::BadILOp,   // Vector512Int8
+   TR::BadILOp,   // Vector512Int16
+   TR::BadILOp,   // Vector512Int32
+   TR::BadILOp,   // Vector512Int64
+   TR::BadILOp,   // Vector512Float
+   TR::BadILOp,   // Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -212,6 +320,18 @@ TR::ILOpCodes OMR::IL::opCodesForIndirectArrayLoad[] =
    TR::vloadi,   // TR::VectorInt64
    TR::vloadi,   // TR::VectorFloat
    TR::vloadi,   // TR::VectorDouble
+   TR::vloadi,   // TR::Vector256Int8
+   TR::vloadi,   // TR::Vector256Int16
+   TR::vloadi,   // TR::Vector256Int32
+   TR::vloadi,   // TR::Vector256Int64
+   TR::vloadi,   // TR::Vector256Float
+   TR::vloadi,   // TR::Vector256Double
+   TR::vloadi,   // TR::Vector512Int8
+   TR::vloadi,   // TR::Vector512Int16
+   TR::vloadi,   // TR::Vector512Int32
+   TR::vloadi,   // TR::Vector512Int64
+   TR::vloadi,   // TR::Vector512Float
+   TR::vloadi,   // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -231,6 +351,18 @@ TR::ILOpCodes OMR::IL::opCodesForIndirectArrayStore[] =
    TR::vstorei,  // TR::VectorInt64
    TR::vstorei,  // TR::VectorFloat
    TR::vstorei,  // TR::VectorDouble
+   TR::vstorei,  // TR::Vector256Int8
+   TR::vstorei,  // TR::Vector256Int16
+   TR::vstorei,  // TR::Vector256Int32
+   TR::vstorei,  // TR::Vector256Int64
+   TR::vstorei,  // TR::Vector256Float
+   TR::vstorei,  // TR::Vector256Double
+   TR::vstorei,  // TR::Vector512Int8
+   TR::vstorei,  // TR::Vector512Int16
+   TR::vstorei,  // TR::Vector512Int32
+   TR::vstorei,  // TR::Vector512Int64
+   TR::vstorei,  // TR::Vector512Float
+   TR::vstorei,  // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -250,6 +382,18 @@ TR::ILOpCodes OMR::IL::opCodesForRegisterLoad[] =
    TR::vlRegLoad, // TR::VectorInt64
    TR::vfRegLoad, // TR::VectorFloat
    TR::vdRegLoad, // TR::VectorDouble
+   TR::BadILOp,   // TR::Vector256Int8
+   TR::BadILOp,   // TR::Vector256Int16
+   TR::BadILOp,   // TR::Vector256Int32
+   TR::BadILOp,   // TR::Vector256Int64
+   TR::BadILOp,   // TR::Vector256Float
+   TR::BadILOp,   // TR::Vector256Double
+   TR::BadILOp,   // TR::Vector512Int8
+   TR::BadILOp,   // TR::Vector512Int16
+   TR::BadILOp,   // TR::Vector512Int32
+   TR::BadILOp,   // TR::Vector512Int64
+   TR::BadILOp,   // TR::Vector512Float
+   TR::BadILOp,   // TR::Vector512Double
    TR::BadILOp,   // TR::Aggregate
    };
 
@@ -269,6 +413,18 @@ TR::ILOpCodes OMR::IL::opCodesForRegisterStore[] =
    TR::vlRegStore, // TR::VectorInt64
    TR::vfRegStore, // TR::VectorFloat
    TR::vdRegStore, // TR::VectorDouble
+   TR::BadILOp,    // TR::Vector256Int8
+   TR::BadILOp,    // TR::Vector256Int16
+   TR::BadILOp,    // TR::Vector256Int32
+   TR::BadILOp,    // TR::Vector256Int64
+   TR::BadILOp,    // TR::Vector256Float
+   TR::BadILOp,    // TR::Vector256Double
+   TR::BadILOp,    // TR::Vector512Int8
+   TR::BadILOp,    // TR::Vector512Int16
+   TR::BadILOp,    // TR::Vector512Int32
+   TR::BadILOp,    // TR::Vector512Int64
+   TR::BadILOp,    // TR::Vector512Float
+   TR::BadILOp,    // TR::Vector512Double
    TR::BadILOp,    // TR::Aggregate
    };
 
@@ -288,6 +444,18 @@ TR::ILOpCodes OMR::IL::opCodesForCompareEquals[] =
    TR::vcmpeq,   // TR::VectorInt64
    TR::vcmpeq,   // TR::VectorFloat
    TR::vcmpeq,   // TR::VectorDouble
+   TR::vcmpeq,   // TR::Vector256Int8
+   TR::vcmpeq,   // TR::Vector256Int16
+   TR::vcmpeq,   // TR::Vector256Int32
+   TR::vcmpeq,   // TR::Vector256Int64
+   TR::vcmpeq,   // TR::Vector256Float
+   TR::vcmpeq,   // TR::Vector256Double
+   TR::vcmpeq,   // TR::Vector512Int8
+   TR::vcmpeq,   // TR::Vector512Int16
+   TR::vcmpeq,   // TR::Vector512Int32
+   TR::vcmpeq,   // TR::Vector512Int64
+   TR::vcmpeq,   // TR::Vector512Float
+   TR::vcmpeq,   // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -307,6 +475,18 @@ TR::ILOpCodes OMR::IL::opCodesForIfCompareEquals[] =
    TR::BadILOp,   // TR::VectorInt64
    TR::BadILOp,   // TR::VectorFloat
    TR::BadILOp,   // TR::VectorDouble
+   TR::BadILOp,   // TR::Vector256Int8
+   TR::BadILOp,   // TR::Vector256Int16
+   TR::BadILOp,   // TR::Vector256Int32
+   TR::BadILOp,   // TR::Vector256Int64
+   TR::BadILOp,   // TR::Vector256Float
+   TR::BadILOp,   // TR::Vector256Double
+   TR::BadILOp,   // TR::Vector512Int8
+   TR::BadILOp,   // TR::Vector512Int16
+   TR::BadILOp,   // TR::Vector512Int32
+   TR::BadILOp,   // TR::Vector512Int64
+   TR::BadILOp,   // TR::Vector512Float
+   TR::BadILOp,   // TR::Vector512Double
    TR::BadILOp,   // TR::Aggregate
    };
 
@@ -326,6 +506,18 @@ TR::ILOpCodes OMR::IL::opCodesForCompareNotEquals[] =
    TR::vcmpne,   // TR::VectorInt64
    TR::vcmpne,   // TR::VectorFloat
    TR::vcmpne,   // TR::VectorDouble
+   TR::vcmpne,   // TR::Vector256Int8
+   TR::vcmpne,   // TR::Vector256Int16
+   TR::vcmpne,   // TR::Vector256Int32
+   TR::vcmpne,   // TR::Vector256Int64
+   TR::vcmpne,   // TR::Vector256Float
+   TR::vcmpne,   // TR::Vector256Double
+   TR::vcmpne,   // TR::Vector512Int8
+   TR::vcmpne,   // TR::Vector512Int16
+   TR::vcmpne,   // TR::Vector512Int32
+   TR::vcmpne,   // TR::Vector512Int64
+   TR::vcmpne,   // TR::Vector512Float
+   TR::vcmpne,   // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -345,6 +537,18 @@ TR::ILOpCodes OMR::IL::opCodesForIfCompareNotEquals[] =
    TR::BadILOp,   // TR::VectorInt64
    TR::BadILOp,   // TR::VectorFloat
    TR::BadILOp,   // TR::VectorDouble
+   TR::BadILOp,   // TR::Vector256Int8
+   TR::BadILOp,   // TR::Vector256Int16
+   TR::BadILOp,   // TR::Vector256Int32
+   TR::BadILOp,   // TR::Vector256Int64
+   TR::BadILOp,   // TR::Vector256Float
+   TR::BadILOp,   // TR::Vector256Double
+   TR::BadILOp,   // TR::Vector512Int8
+   TR::BadILOp,   // TR::Vector512Int16
+   TR::BadILOp,   // TR::Vector512Int32
+   TR::BadILOp,   // TR::Vector512Int64
+   TR::BadILOp,   // TR::Vector512Float
+   TR::BadILOp,   // TR::Vector512Double
    TR::BadILOp,   // TR::Aggregate
    };
 
@@ -364,6 +568,18 @@ TR::ILOpCodes OMR::IL::opCodesForCompareLessThan[] =
    TR::vcmplt,   // TR::VectorInt64
    TR::vcmplt,   // TR::VectorFloat
    TR::vcmplt,   // TR::VectorDouble
+   TR::vcmplt,   // TR::Vector256Int8
+   TR::vcmplt,   // TR::Vector256Int16
+   TR::vcmplt,   // TR::Vector256Int32
+   TR::vcmplt,   // TR::Vector256Int64
+   TR::vcmplt,   // TR::Vector256Float
+   TR::vcmplt,   // TR::Vector256Double
+   TR::vcmplt,   // TR::Vector512Int8
+   TR::vcmplt,   // TR::Vector512Int16
+   TR::vcmplt,   // TR::Vector512Int32
+   TR::vcmplt,   // TR::Vector512Int64
+   TR::vcmplt,   // TR::Vector512Float
+   TR::vcmplt,   // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -383,6 +599,18 @@ TR::ILOpCodes OMR::IL::opCodesForCompareLessOrEquals[] =
    TR::vcmple,   // TR::VectorInt64
    TR::vcmple,   // TR::VectorFloat
    TR::vcmple,   // TR::VectorDouble
+   TR::vcmple,   // TR::Vector256Int8
+   TR::vcmple,   // TR::Vector256Int16
+   TR::vcmple,   // TR::Vector256Int32
+   TR::vcmple,   // TR::Vector256Int64
+   TR::vcmple,   // TR::Vector256Float
+   TR::vcmple,   // TR::Vector256Double
+   TR::vcmple,   // TR::Vector512Int8
+   TR::vcmple,   // TR::Vector512Int16
+   TR::vcmple,   // TR::Vector512Int32
+   TR::vcmple,   // TR::Vector512Int64
+   TR::vcmple,   // TR::Vector512Float
+   TR::vcmple,   // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -402,6 +630,18 @@ TR::ILOpCodes OMR::IL::opCodesForIfCompareLessThan[] =
    TR::BadILOp,   // TR::VectorInt64
    TR::BadILOp,   // TR::VectorFloat
    TR::BadILOp,   // TR::VectorDouble
+   TR::BadILOp,   // TR::Vector256Int8
+   TR::BadILOp,   // TR::Vector256Int16
+   TR::BadILOp,   // TR::Vector256Int32
+   TR::BadILOp,   // TR::Vector256Int64
+   TR::BadILOp,   // TR::Vector256Float
+   TR::BadILOp,   // TR::Vector256Double
+   TR::BadILOp,   // TR::Vector512Int8
+   TR::BadILOp,   // TR::Vector512Int16
+   TR::BadILOp,   // TR::Vector512Int32
+   TR::BadILOp,   // TR::Vector512Int64
+   TR::BadILOp,   // TR::Vector512Float
+   TR::BadILOp,   // TR::Vector512Double
    TR::BadILOp,   // TR::Aggregate
    };
 
@@ -421,6 +661,18 @@ TR::ILOpCodes OMR::IL::opCodesForIfCompareLessOrEquals[] =
    TR::BadILOp,   // TR::VectorInt64
    TR::BadILOp,   // TR::VectorFloat
    TR::BadILOp,   // TR::VectorDouble
+   TR::BadILOp,   // TR::Vector256Int8
+   TR::BadILOp,   // TR::Vector256Int16
+   TR::BadILOp,   // TR::Vector256Int32
+   TR::BadILOp,   // TR::Vector256Int64
+   TR::BadILOp,   // TR::Vector256Float
+   TR::BadILOp,   // TR::Vector256Double
+   TR::BadILOp,   // TR::Vector512Int8
+   TR::BadILOp,   // TR::Vector512Int16
+   TR::BadILOp,   // TR::Vector512Int32
+   TR::BadILOp,   // TR::Vector512Int64
+   TR::BadILOp,   // TR::Vector512Float
+   TR::BadILOp,   // TR::Vector512Double
    TR::BadILOp,   // TR::Aggregate
    };
 
@@ -440,6 +692,18 @@ TR::ILOpCodes OMR::IL::opCodesForCompareGreaterThan[] =
    TR::vcmpgt,   // TR::VectorInt64
    TR::vcmpgt,   // TR::VectorFloat
    TR::vcmpgt,   // TR::VectorDouble
+   TR::vcmpgt,   // TR::Vector256Int8
+   TR::vcmpgt,   // TR::Vector256Int16
+   TR::vcmpgt,   // TR::Vector256Int32
+   TR::vcmpgt,   // TR::Vector256Int64
+   TR::vcmpgt,   // TR::Vector256Float
+   TR::vcmpgt,   // TR::Vector256Double
+   TR::vcmpgt,   // TR::Vector512Int8
+   TR::vcmpgt,   // TR::Vector512Int16
+   TR::vcmpgt,   // TR::Vector512Int32
+   TR::vcmpgt,   // TR::Vector512Int64
+   TR::vcmpgt,   // TR::Vector512Float
+   TR::vcmpgt,   // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -459,6 +723,18 @@ TR::ILOpCodes OMR::IL::opCodesForCompareGreaterOrEquals[] =
    TR::vcmpge,   // TR::VectorInt64
    TR::vcmpge,   // TR::VectorFloat
    TR::vcmpge,   // TR::VectorDouble
+   TR::vcmpge,   // TR::Vector256Int8
+   TR::vcmpge,   // TR::Vector256Int16
+   TR::vcmpge,   // TR::Vector256Int32
+   TR::vcmpge,   // TR::Vector256Int64
+   TR::vcmpge,   // TR::Vector256Float
+   TR::vcmpge,   // TR::Vector256Double
+   TR::vcmpge,   // TR::Vector512Int8
+   TR::vcmpge,   // TR::Vector512Int16
+   TR::vcmpge,   // TR::Vector512Int32
+   TR::vcmpge,   // TR::Vector512Int64
+   TR::vcmpge,   // TR::Vector512Float
+   TR::vcmpge,   // TR::Vector512Double
    TR::BadILOp,  // TR::Aggregate
    };
 
@@ -478,6 +754,18 @@ TR::ILOpCodes OMR::IL::opCodesForIfCompareGreaterThan[] =
    TR::BadILOp,   // TR::VectorInt64
    TR::BadILOp,   // TR::VectorFloat
    TR::BadILOp,   // TR::VectorDouble
+   TR::BadILOp,   // TR::Vector256Int8
+   TR::BadILOp,   // TR::Vector256Int16
+   TR::BadILOp,   // TR::Vector256Int32
+   TR::BadILOp,   // TR::Vector256Int64
+   TR::BadILOp,   // TR::Vector256Float
+   TR::BadILOp,   // TR::Vector256Double
+   TR::BadILOp,   // TR::Vector512Int8
+   TR::BadILOp,   // TR::Vector512Int16
+   TR::BadILOp,   // TR::Vector512Int32
+   TR::BadILOp,   // TR::Vector512Int64
+   TR::BadILOp,   // TR::Vector512Float
+   TR::BadILOp,   // TR::Vector512Double
    TR::BadILOp,   // TR::Aggregate
    };
 
@@ -497,6 +785,18 @@ TR::ILOpCodes OMR::IL::opCodesForIfCompareGreaterOrEquals[] =
    TR::BadILOp,   // TR::VectorInt64
    TR::BadILOp,   // TR::VectorFloat
    TR::BadILOp,   // TR::VectorDouble
+   TR::BadILOp,   // TR::Vector256Int8
+   TR::BadILOp,   // TR::Vector256Int16
+   TR::BadILOp,   // TR::Vector256Int32
+   TR::BadILOp,   // TR::Vector256Int64
+   TR::BadILOp,   // TR::Vector256Float
+   TR::BadILOp,   // TR::Vector256Double
+   TR::BadILOp,   // TR::Vector512Int8
+   TR::BadILOp,   // TR::Vector512Int16
+   TR::BadILOp,   // TR::Vector512Int32
+   TR::BadILOp,   // TR::Vector512Int64
+   TR::BadILOp,   // TR::Vector512Float
+   TR::BadILOp,   // TR::Vector512Double
    TR::BadILOp,   // TR::Aggregate
    };
 
@@ -516,6 +816,18 @@ TR::ILOpCodes OMR::IL::opCodesForSelect [] =
    TR::BadILOp,   // TR::VectorInt64
    TR::BadILOp,   // TR::VectorFloat
    TR::BadILOp,   // TR::VectorDouble
+   TR::BadILOp,   // TR::Vector256Int8
+   TR::BadILOp,   // TR::Vector256Int16
+   TR::BadILOp,   // TR::Vector256Int32
+   TR::BadILOp,   // TR::Vector256Int64
+   TR::BadILOp,   // TR::Vector256Float
+   TR::BadILOp,   // TR::Vector256Double
+   TR::BadILOp,   // TR::Vector512Int8
+   TR::BadILOp,   // TR::Vector512Int16
+   TR::BadILOp,   // TR::Vector512Int32
+   TR::BadILOp,   // TR::Vector512Int64
+   TR::BadILOp,   // TR::Vector512Float
+   TR::BadILOp,   // TR::Vector512Double
    TR::BadILOp,   // TR::Aggregate
    };
 
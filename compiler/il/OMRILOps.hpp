@@ -689,7 +689,9 @@ public:
          case TR::VectorInt64:  return TR::vadd;
          case TR::VectorFloat:  return TR::vadd;
          case TR::VectorDouble: return TR::vadd;
-         default: TR_ASSERT(0, "no add opcode for this datatype");
+         default:
+            if (type.isVector()) return TR::vadd;
+            TR_ASSERT(0, "no add opcode for this datatype");
          }
       return TR::BadILOp;
       }
@@ -724,7 +726,9 @@ public:
          case TR::VectorInt64:  return TR::vsub;
          case TR::VectorFloat:  return TR::vsub;
          case TR::VectorDouble: return TR::vsub;
-         default: TR_ASSERT(0, "no sub opcode for this datatype");
+         default:
+            if (type.isVector()) return TR::vsub;
+            TR_ASSERT(0, "no sub opcode for this datatype");
          }
       return TR::BadILOp;
       }
@@ -745,7 +749,9 @@ public:
          case TR::VectorInt64:  return TR::vmul;
          case TR::VectorFloat:  return TR::vmul;
          case TR::VectorDouble: return TR::vmul;
-         default: TR_ASSERT(0, "no mul opcode for this datatype");
+         default:
+            if (type.isVector()) return TR::vmul;
+            TR_ASSERT(0, "no mul opcode for this datatype");
          }
       return TR::BadILOp;
       }
@@ -766,7 +772,9 @@ public:
          case TR::VectorInt64:  return TR::vdiv;
          case TR::VectorFloat:  return TR::vdiv;
          case TR::VectorDouble: return TR::vdiv;
-         default: TR_ASSERT(0, "no div opcode for this datatype");
+         default:
+            if (type.isVector()) return TR::vdiv;
+            TR_ASSERT(0, "no div opcode for this datatype");
          }
       return TR::BadILOp;
       }
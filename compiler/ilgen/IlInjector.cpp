@@ -92,6 +92,18 @@ OMR::IlInjector::initPrimitiveTypes()
    VectorInt64  = _types->PrimitiveType(TR::VectorInt64);
    VectorFloat  = _types->PrimitiveType(TR::VectorFloat);
    VectorDouble = _types->PrimitiveType(TR::VectorDouble);
+   Vector256Int8   = _types->PrimitiveType(TR::Vector256Int8);
+   Vector256Int16  = _types->PrimitiveType(TR::Vector256Int16);
+   Vector256Int32  = _types->PrimitiveType(TR::Vector256Int32);
+   Vector256Int64  = _types->PrimitiveType(TR::Vector256Int64);
+   Vector256Float  = _types->PrimitiveType(TR::Vector256Float);
+   Vector256Double = _types->PrimitiveType(TR::Vector256Double);
+   Vector512Int8   = _types->PrimitiveType(TR::Vector512Int8);
+   Vector512Int16  = _types->PrimitiveType(TR::Vector512Int16);
+   Vector512Int32  = _types->PrimitiveType(TR::Vector512Int32);
+   Vector512Int64  = _types->PrimitiveType(TR::Vector512Int64);
+   Vector512Float  = _types->PrimitiveType(TR::Vector512Float);
+   Vector512Double = _types->PrimitiveType(TR::Vector512Double);
 
    if (TR::Compiler->target.is64Bit())
       Word = Int64;
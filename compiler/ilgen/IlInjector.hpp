@@ -165,6 +165,18 @@ public:
    TR::IlType                   * VectorInt64;
    TR::IlType                   * VectorFloat;
    TR::IlType                   * VectorDouble;
+   TR::IlType                   * Vector256Int8;
+   TR::IlType                   * Vector256Int16;
+   TR::IlType                   * Vector256Int32;
+   TR::IlType                   * Vector256Int64;
+   TR::IlType                   * Vector256Float;
+   TR::IlType                   * Vector256Double;
+   TR::IlType                   * Vector512Int8;
+   TR::IlType                   * Vector512Int16;
+   TR::IlType                   * Vector512Int32;
+   TR::IlType                   * Vector512Int64;
+   TR::IlType                   * Vector512Float;
+   TR::IlType                   * Vector512Double;
    };
 
 } // namespace OMR
@@ -38,6 +38,7 @@
 #include "il/ILOps.hpp"
 #include "il/Node.hpp"
 #include "il/Node_inlines.hpp"
+#include "il/NodePool.hpp"
 #include "il/TreeTop.hpp"
 #include "il/TreeTop_inlines.hpp"
 #include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
@@ -98,7 +99,9 @@ OMR::IlBuilder::IlBuilder(TR::IlBuilder *source)
    _count(-1),
    _partOfSequence(false),
    _connectedTrees(false),
-   _comesBack(true)
+   _comesBack(true),
+   _isHandler(false),
+   _loopDepth(source->_loopDepth)
    {
    }
 
@@ -132,11 +135,15 @@ OMR::IlBuilder::injectIL()
 
    setupForBuildIL();
 
+   ncount_t nodesBefore = comp()->getNodePool().getMaxIndex();
    bool rc = buildIL();
    TraceIL("buildIL() returned %d\n", rc);
    if (!rc)
       return false;
 
+   if (isMethodBuilder())
+      asMethodBuilder()->setILSize(comp()->getNodePool().getMaxIndex() - nodesBefore);
+
    rc = connectTrees();
    if (TraceEnabled)
       comp()->dumpMethodTrees("after connectTrees");
@@ -483,6 +490,7 @@ OMR::IlBuilder::OrphanBuilder()
    TR::IlBuilder *orphan = new (comp()->trHeapMemory()) TR::IlBuilder(_methodBuilder, _types);
    orphan->initialize(_details, _methodSymbol, _fe, _symRefTab);
    orphan->setupForBuildIL();
+   orphan->_loopDepth = _loopDepth;
    return orphan;
    }
 
@@ -492,6 +500,7 @@ OMR::IlBuilder::OrphanBytecodeBuilder(int32_t bcIndex, char *name)
    TR::BytecodeBuilder *orphan = new (comp()->trHeapMemory()) TR::BytecodeBuilder(_methodBuilder, bcIndex, name);
    orphan->initialize(_details, _methodSymbol, _fe, _symRefTab);
    orphan->setupForBuildIL();
+   orphan->_loopDepth = _loopDepth;
    return orphan;
    }
 
@@ -2051,14 +2060,20 @@ OMR::IlBuilder::Call(TR::MethodBuilder *calleeMB, int32_t numArgs, TR::IlValue *
    if (vmState() != NULL)
       calleeMB->setVMState(vmState());
 
+   // code in the callee runs inside any loops enclosing this call
+   calleeMB->_loopDepth = _loopDepth;
+
    // now flow control into the callee
    AppendBuilder(calleeMB);
 
+   ncount_t nodesBefore = comp()->getNodePool().getMaxIndex();
    bool rc = calleeMB->buildIL();
    TraceIL("callee's buildIL() returned %d\n", rc);
    if (!rc)
       return NULL;
 
+   _methodBuilder->recordInlinedCall(calleeMB, comp()->getNodePool().getMaxIndex() - nodesBefore);
+
    // there shouldn't be any fall-through, but if there is it should go to the return block and we need to put it somewhere anyway
    AppendBuilder(returnBuilder);
 
@@ -2078,20 +2093,21 @@ OMR::IlBuilder::Call(TR::MethodBuilder *calleeMB, int32_t numArgs, TR::IlValue *
 TR::IlValue *
 OMR::IlBuilder::Call(const char *functionName, int32_t numArgs, ...)
    {
-   TraceIL("IlBuilder[ %p ]::Call %s\n", this, functionName);
    va_list args;
    va_start(args, numArgs);
    TR::IlValue **argValues = processCallArgs(_comp, numArgs, args);
    va_end(args);
-   TR::ResolvedMethod *resolvedMethod = _methodBuilder->lookupFunction(functionName);
-   if (resolvedMethod == NULL && _methodBuilder->RequestFunction(functionName))
-      resolvedMethod = _methodBuilder->lookupFunction(functionName);
-   TR_ASSERT_FATAL(resolvedMethod, "Could not identify function %s\n", functionName);
 
-   TR::SymbolReference *methodSymRef = symRefTab()->findOrCreateStaticMethodSymbol(JITTED_METHOD_INDEX, -1, resolvedMethod);
-   return genCall(methodSymRef, numArgs, argValues);
+   return Call(functionName, numArgs, argValues);
    }
 
+/*
+ * Calls to a function defined from a MethodBuilder (see
+ * MethodBuilder::DefineFunction) are inlined when the MethodBuilder's
+ * inlining policy (MethodBuilder::shouldInline) finds it worthwhile and
+ * RequestInlinedFunction provides a MethodBuilder for this call site.
+ * Otherwise a call to the function's entry point is generated.
+ */
 TR::IlValue *
 OMR::IlBuilder::Call(const char *functionName, int32_t numArgs, TR::IlValue ** argValues)
    {
@@ -2101,6 +2117,14 @@ OMR::IlBuilder::Call(const char *functionName, int32_t numArgs, TR::IlValue ** a
       resolvedMethod = _methodBuilder->lookupFunction(functionName);
    TR_ASSERT_FATAL(resolvedMethod, "Could not identify function %s\n", functionName);
 
+   if (_methodBuilder->shouldInline(functionName, numArgs, argValues, _loopDepth))
+      {
+      TR::MethodBuilder *calleeMB = _methodBuilder->RequestInlinedFunction(functionName);
+      if (calleeMB != NULL)
+         return Call(calleeMB, numArgs, argValues);
+      TraceIL("IlBuilder[ %p ]::Call no MethodBuilder provided to inline %s\n", this, functionName);
+      }
+
    TR::SymbolReference *methodSymRef = symRefTab()->findOrCreateStaticMethodSymbol(JITTED_METHOD_INDEX, -1, resolvedMethod);
    return genCall(methodSymRef, numArgs, argValues);
    }
@@ -2785,6 +2809,7 @@ OMR::IlBuilder::ForLoop(bool countsUp,
    methodSymbol()->setMayHaveLoops(true);
    TR_ASSERT_FATAL(loopCode != NULL, "ForLoop needs to have loopCode builder");
    *loopCode = createBuilderIfNeeded(*loopCode);
+   (*loopCode)->_loopDepth = _loopDepth + 1;
 
    TraceIL("IlBuilder[ %p ]::ForLoop ind %s initial %d end %d increment %d loopCode %p countsUp %d\n", this, indVar, initial->getID(), end->getID(), increment->getID(), *loopCode, countsUp);
 
@@ -2846,6 +2871,7 @@ OMR::IlBuilder::DoWhileLoop(const char *whileCondition, TR::IlBuilder **body, TR
       _methodBuilder->defineValue(whileCondition, Int32);
 
    *body = createBuilderIfNeeded(*body);
+   (*body)->_loopDepth = _loopDepth + 1;
    TraceIL("IlBuilder[ %p ]::DoWhileLoop do body B%d while %s\n", this, (*body)->getEntry()->getNumber(), whileCondition);
 
    AppendBuilder(*body);
@@ -2900,6 +2926,7 @@ OMR::IlBuilder::WhileDoLoop(const char *whileCondition, TR::IlBuilder **body, TR
    loopContinue->   Load(whileCondition));
 
    *body = createBuilderIfNeeded(*body);
+   (*body)->_loopDepth = _loopDepth + 1;
    AppendBuilder(*body);
 
    Goto(&loopContinue);
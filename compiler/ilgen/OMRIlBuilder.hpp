@@ -182,7 +182,8 @@ public:
       _partOfSequence(false),
       _connectedTrees(false),
       _comesBack(true),
-      _isHandler(false)
+      _isHandler(false),
+      _loopDepth(0)
       {
       }
    IlBuilder(TR::IlBuilder *source);
@@ -725,6 +726,11 @@ protected:
     */
    bool                          _isHandler;
 
+   /**
+    * @brief number of loops (built with ForLoop, DoWhileLoop or WhileDoLoop) enclosing the code in this IlBuilder object
+    */
+   int32_t                       _loopDepth;
+
    virtual bool buildIL()
       {
       if (_clientCallbackBuildIL)
@@ -53,6 +53,18 @@ OMR::IlType::signatureNameForType[TR::NumOMRTypes] =
    "V8", // VectorInt64
    "VF", // VectorFloat
    "VD", // VectorDouble
+   "V256_1", // Vector256Int8
+   "V256_2", // Vector256Int16
+   "V256_4", // Vector256Int32
+   "V256_8", // Vector256Int64
+   "V256_F", // Vector256Float
+   "V256_D", // Vector256Double
+   "V512_1", // Vector512Int8
+   "V512_2", // Vector512Int16
+   "V512_4", // Vector512Int32
+   "V512_8", // Vector512Int64
+   "V512_F", // Vector512Float
+   "V512_D", // Vector512Double
    };
 
 const uint8_t
@@ -75,7 +87,19 @@ OMR::IlType::primitiveTypeAlignment[TR::NumOMRTypes] =
    16, // VectorInt32
    16, // VectorInt64
    16, // VectorFloat
-   16  // VectorDouble
+   16, // VectorDouble
+   32, // Vector256Int8
+   32, // Vector256Int16
+   32, // Vector256Int32
+   32, // Vector256Int64
+   32, // Vector256Float
+   32, // Vector256Double
+   64, // Vector512Int8
+   64, // Vector512Int16
+   64, // Vector512Int32
+   64, // Vector512Int64
+   64, // Vector512Float
+   64  // Vector512Double
    };
 
 char *
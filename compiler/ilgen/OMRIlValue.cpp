@@ -47,6 +47,12 @@ OMR::IlValue::getDataType()
    return _nodeThatComputesValue->getDataType();
    }
 
+bool
+OMR::IlValue::isConstant()
+   {
+   return _nodeThatComputesValue->getOpCode().isLoadConst();
+   }
+
 void
 OMR::IlValue::storeToAuto()
    {
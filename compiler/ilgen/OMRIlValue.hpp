@@ -69,6 +69,11 @@ public:
     */
    TR::DataType getDataType();
 
+   /**
+    * @brief returns true if this value is computed by a constant, e.g. by ConstInt32()
+    */
+   bool isConstant();
+
    /**
     * @brief returns the TR::SymbolReference holding the value, or NULL if willBeUsedInAnotherBlock() has not yet been called
     * Caller should ensure the current block is different than the block that computes the value; if the current block is the
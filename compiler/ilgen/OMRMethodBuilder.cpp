@@ -19,13 +19,16 @@
  * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
  *******************************************************************************/
 
+#include <algorithm>
 #include <iostream>
 #include <fstream>
 
 #include <stdint.h>
+#include <string.h>
 #include "compile/Method.hpp"
 #include "env/FrontEnd.hpp"
 #include "env/Region.hpp"
+#include "env/SegmentCache.hpp"
 #include "env/SystemSegmentProvider.hpp"
 #include "env/TRMemory.hpp"
 #include "il/AutomaticSymbol.hpp"
@@ -37,6 +40,8 @@
 #include "il/StaticSymbol.hpp"
 #include "codegen/CodeGenerator.hpp"
 #include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
 #include "compile/SymbolReferenceTable.hpp"
 #include "control/CompileMethod.hpp"
 #include "control/Recompilation.hpp"
@@ -58,6 +63,13 @@
 // Size of MethodBuilder memory segments
 #define MEM_SEGMENT_SIZE 1 << 16   // i.e. 65536 bytes (~64KB)
 
+// Inlining cost model (see shouldInline), in units of IL nodes
+#define INLINE_CALL_BENEFIT       25 // call, prologue and epilogue saved by inlining
+#define INLINE_ARG_BENEFIT         5 // argument passing saved per argument
+#define INLINE_CONST_ARG_BENEFIT  15 // callee code expected to fold away per constant argument
+#define INLINE_MAX_LOOP_SCALING    3 // benefit doubles for each enclosing loop, up to this many
+#define INLINE_MAX_DEPTH           6
+
 #define TraceEnabled    (comp()->getOption(TR_TraceILGen))
 #define TraceIL(m, ...) {if (TraceEnabled) {traceMsg(comp(), m, ##__VA_ARGS__);}}
 
@@ -72,6 +84,13 @@
 // into the builder.
 //
 
+static TR::SegmentCache *
+sharedSegmentCache()
+   {
+   TR::Options *options = TR::Options::getCmdLineOptions();
+   return options && options->getOption(TR_DisableSegmentCache) ? NULL : &TR::SegmentCache::instance();
+   }
+
 // Note: _memoryRegion and the corresponding TR::SegmentProvider and TR::Memory instances are stored as pointers within MethodBuilder
 // in order to avoid increasing the number of header files needed to compile against the JitBuilder library. Because we are storing
 // them as pointers, we cannot rely on the default C++ destruction semantic to destruct and deallocate the memory region, but rather
@@ -79,7 +98,7 @@
 // the user defined destructor, we need to make sure that any members (and their contents) that are allocated in _memoryRegion are
 // explicitly destroyed and deallocated *before* _memoryRegion in the MethodBuilder::MemoryManager destructor.
 OMR::MethodBuilder::MemoryManager::MemoryManager() :
-   _segmentProvider(new(TR::Compiler->persistentAllocator()) TR::SystemSegmentProvider(MEM_SEGMENT_SIZE, TR::Compiler->rawAllocator)),
+   _segmentProvider(new(TR::Compiler->persistentAllocator()) TR::SystemSegmentProvider(MEM_SEGMENT_SIZE, TR::Compiler->rawAllocator, sharedSegmentCache())),
    _memoryRegion(new(TR::Compiler->persistentAllocator()) TR::Region(*_segmentProvider, TR::Compiler->rawAllocator)),
    _trMemory(new(TR::Compiler->persistentAllocator()) TR_Memory(*::trPersistentMemory, *_memoryRegion))
    {}
@@ -97,6 +116,7 @@ OMR::MethodBuilder::MemoryManager::~MemoryManager()
 OMR::MethodBuilder::MethodBuilder(TR::TypeDictionary *types, TR::VirtualMachineState *vmState)
    : TR::IlBuilder(asMethodBuilder(), types),
    _clientCallbackRequestFunction(0),
+   _clientCallbackRequestInlinedFunction(0),
    _methodName("NoName"),
    _returnType(NoType),
    _numParameters(0),
@@ -108,6 +128,7 @@ OMR::MethodBuilder::MethodBuilder(TR::TypeDictionary *types, TR::VirtualMachineS
    _memoryLocations(str_comparator, trMemory()->heapMemoryRegion()),
    _globals(str_comparator,trMemory()->heapMemoryRegion()),
    _functions(str_comparator, trMemory()->heapMemoryRegion()),
+   _inlinableFunctions(str_comparator, trMemory()->heapMemoryRegion()),
    _cachedParameterTypes(0),
    _definingFile(""),
    _newSymbolsAreTemps(false),
@@ -122,7 +143,10 @@ OMR::MethodBuilder::MethodBuilder(TR::TypeDictionary *types, TR::VirtualMachineS
    _inlineSiteIndex(-1),
    _nextInlineSiteIndex(0),
    _returnBuilder(NULL),
-   _returnSymbolName(NULL)
+   _returnSymbolName(NULL),
+   _ilSize(-1),
+   _inlinedILSize(0),
+   _numInlinedCalls(0)
    {
    _definingLine[0] = '\0';
    }
@@ -130,6 +154,8 @@ OMR::MethodBuilder::MethodBuilder(TR::TypeDictionary *types, TR::VirtualMachineS
 // used when inlining:
 OMR::MethodBuilder::MethodBuilder(TR::MethodBuilder *callerMB, TR::VirtualMachineState *vmState)
    : TR::IlBuilder(asMethodBuilder(), callerMB->typeDictionary()),
+   _clientCallbackRequestFunction(0),
+   _clientCallbackRequestInlinedFunction(0),
    _methodName("NoName"),
    _returnType(NoType),
    _numParameters(0),
@@ -141,6 +167,7 @@ OMR::MethodBuilder::MethodBuilder(TR::MethodBuilder *callerMB, TR::VirtualMachin
    _memoryLocations(str_comparator, trMemory()->heapMemoryRegion()),
    _globals(str_comparator,trMemory()->heapMemoryRegion()),
    _functions(str_comparator, trMemory()->heapMemoryRegion()),
+   _inlinableFunctions(str_comparator, trMemory()->heapMemoryRegion()),
    _cachedParameterTypes(0),
    _definingFile(""),
    _newSymbolsAreTemps(false),
@@ -155,7 +182,10 @@ OMR::MethodBuilder::MethodBuilder(TR::MethodBuilder *callerMB, TR::VirtualMachin
    _inlineSiteIndex(callerMB->getNextInlineSiteIndex()),
    _nextInlineSiteIndex(0),
    _returnBuilder(NULL),
-   _returnSymbolName(NULL)
+   _returnSymbolName(NULL),
+   _ilSize(-1),
+   _inlinedILSize(0),
+   _numInlinedCalls(0)
    {
    _definingLine[0] = '\0';
    initialize(callerMB->_details, callerMB->_methodSymbol, callerMB->_fe, callerMB->_symRefTab);
@@ -172,6 +202,7 @@ OMR::MethodBuilder::~MethodBuilder()
    _symbolIsArray.clear();
    _memoryLocations.clear();
    _functions.clear();
+   _inlinableFunctions.clear();
    }
 
 TR::MethodBuilder *
@@ -221,6 +252,11 @@ OMR::MethodBuilder::setupForBuildIL()
    TraceIL("\tEntry = %p\n", _entryBlock);
    TraceIL("\tExit  = %p\n", _exitBlock);
 
+   // inlining budget and loop depth start over in each compilation
+   _inlinedILSize = 0;
+   _numInlinedCalls = 0;
+   _loopDepth = 0;
+
    // initial "real" block 2 flowing from Entry
    appendBlock(NULL, false);
 
@@ -603,6 +639,96 @@ OMR::MethodBuilder::DefineFunction(const char* const name,
    _functions.insert(std::make_pair(name, method));
    }
 
+void
+OMR::MethodBuilder::DefineFunction(TR::MethodBuilder *callee, void *entryPoint)
+   {
+   DefineFunction(callee->GetMethodName(),
+                  callee->getDefiningFile(),
+                  callee->getDefiningLine(),
+                  entryPoint,
+                  callee->getReturnType(),
+                  callee->getNumParameters(),
+                  callee->getParameterTypes());
+   _inlinableFunctions.insert(std::make_pair(callee->GetMethodName(), callee));
+   }
+
+bool
+OMR::MethodBuilder::shouldInline(const char *name, int32_t numArgs, TR::IlValue **argValues, int32_t loopDepth)
+   {
+   InlinableFunctionMap::iterator it = _inlinableFunctions.find(name);
+   if (it == _inlinableFunctions.end())
+      return false;
+
+   TR::Options *options = comp()->getOptions();
+   if (options->isDisabled(OMR::inlining))
+      return false;
+
+   // the size is only known once the callee has been compiled or inlined
+   int32_t calleeSize = it->second->getILSize();
+   if (calleeSize < 0)
+      {
+      TraceIL("[ %p ] not inlining %s: size of its IL is not known yet\n", this, name);
+      return false;
+      }
+
+   // the outermost MethodBuilder keeps the budget for the whole compilation
+   TR::MethodBuilder *outermost = asMethodBuilder();
+   int32_t inlineDepth = 0;
+   while (true)
+      {
+      if (strcmp(outermost->GetMethodName(), name) == 0)
+         {
+         TraceIL("[ %p ] not inlining recursive call to %s\n", this, name);
+         return false;
+         }
+      TR::MethodBuilder *caller = outermost->callerMethodBuilder();
+      if (caller == NULL)
+         break;
+      outermost = caller;
+      inlineDepth++;
+      }
+
+   if (inlineDepth >= INLINE_MAX_DEPTH ||
+       outermost->_numInlinedCalls >= options->getMaxInlinedCalls() ||
+       outermost->_inlinedILSize + calleeSize > options->getJitBuilderInlineBudget())
+      {
+      TraceIL("[ %p ] not inlining %s (size %d): depth %d, %d calls using %d nodes already inlined\n", this, name, calleeSize, inlineDepth, outermost->_numInlinedCalls, outermost->_inlinedILSize);
+      return false;
+      }
+
+   int32_t numConstArgs = 0;
+   for (int32_t a = 0; a < numArgs; a++)
+      {
+      if (argValues[a]->isConstant())
+         numConstArgs++;
+      }
+
+   int32_t benefit = INLINE_CALL_BENEFIT + INLINE_ARG_BENEFIT * numArgs + INLINE_CONST_ARG_BENEFIT * numConstArgs;
+   benefit <<= std::min(loopDepth, INLINE_MAX_LOOP_SCALING);
+
+   bool inlineIt = calleeSize <= options->getAlwaysWorthInliningThreshold() ||
+                   (calleeSize <= options->getJitBuilderInlineMaxSize() && calleeSize <= benefit);
+
+   TraceIL("[ %p ] %s %s: size %d, benefit %d (%d constant args, loop depth %d)\n", this, inlineIt ? "inlining" : "not inlining", name, calleeSize, benefit, numConstArgs, loopDepth);
+   return inlineIt;
+   }
+
+void
+OMR::MethodBuilder::recordInlinedCall(TR::MethodBuilder *calleeMB, int32_t size)
+   {
+   // later call sites are judged on the size just measured
+   InlinableFunctionMap::iterator it = _inlinableFunctions.find(calleeMB->GetMethodName());
+   if (it != _inlinableFunctions.end())
+      it->second->setILSize(size);
+
+   TR::MethodBuilder *outermost = asMethodBuilder();
+   while (outermost->callerMethodBuilder() != NULL)
+      outermost = outermost->callerMethodBuilder();
+
+   outermost->_inlinedILSize += size;
+   outermost->_numInlinedCalls++;
+   }
+
 const char *
 OMR::MethodBuilder::getSymbolName(int32_t slot)
    {
@@ -718,12 +844,18 @@ OMR::MethodBuilder::GetNextBytecodeFromWorklist()
 
 int32_t
 OMR::MethodBuilder::Compile(void **entry)
+   {
+   return Compile(entry, warm, NULL);
+   }
+
+int32_t
+OMR::MethodBuilder::Compile(void **entry, TR_Hotness hotness, int32_t *recompilationCounter)
    {
    TR::ResolvedMethod resolvedMethod(static_cast<TR::MethodBuilder *>(this));
    TR::IlGeneratorMethodDetails details(&resolvedMethod);
 
    int32_t rc=0;
-   *entry = (void *) compileMethodFromDetails(NULL, details, warm, rc);
+   *entry = (void *) compileMethodFromDetails(NULL, details, hotness, rc, recompilationCounter);
 
    // let TypeDictionary know to clear out sym refs used in this compilation so
    // no dangling pointers
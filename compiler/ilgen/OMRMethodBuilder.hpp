@@ -25,6 +25,7 @@
 #include <map>
 #include <set>
 #include <fstream>
+#include "compile/CompilationTypes.hpp"
 #include "env/TRMemory.hpp"
 #include "ilgen/IlBuilder.hpp"
 #include "env/TypedAllocator.hpp"
@@ -44,6 +45,7 @@ namespace TR { class Region; }
 extern "C"
 {
 typedef bool (*RequestFunctionCallback)(void *client, const char *name);
+typedef void * (*RequestInlinedFunctionCallback)(void *client, const char *name);
 }
 
 namespace OMR
@@ -144,8 +146,27 @@ class MethodBuilder : public TR::IlBuilder
                        int32_t          numParms,
                        TR::IlType     ** parmTypes);
 
+
+   /**
+    * @brief Define a function whose code is generated by a MethodBuilder, so that calls to it can be inlined
+    * @param callee the MethodBuilder for the function, which supplies the function's name, signature and,
+    *        once it has been compiled, the size of its IL; it must outlive this MethodBuilder
+    * @param entryPoint the callee's compiled code, called at call sites that are not inlined
+    * Calls to the function are inlined when shouldInline() finds it worthwhile and RequestInlinedFunction()
+    * provides a MethodBuilder for the call site.
+    */
+   void DefineFunction(TR::MethodBuilder *callee, void *entryPoint);
+
    int32_t Compile(void **entry);
 
+   /**
+    * @brief Compile at the given optimization level.
+    *
+    * If `recompilationCounter` is not NULL, the body decrements it on entry
+    * and on loop back edges so the caller can tell when to recompile it.
+    */
+   int32_t Compile(void **entry, TR_Hotness hotness, int32_t *recompilationCounter);
+
    /**
     * @brief will be called if a Call is issued to a function that has not yet been defined, provides a
     *        mechanism for MethodBuilder subclasses to provide method lookup on demand rather than all up
@@ -160,6 +181,49 @@ class MethodBuilder : public TR::IlBuilder
       return false;
       }
 
+   /**
+    * @brief will be called when a call to a function defined from a MethodBuilder is going to be inlined;
+    *        MethodBuilder subclasses provide a new MethodBuilder, constructed with this one as its caller,
+    *        that generates the function's IL at this call site
+    * @returns the MethodBuilder to inline, or NULL to generate a call instead
+    */
+   virtual TR::MethodBuilder *RequestInlinedFunction(const char *name)
+      {
+      if (_clientCallbackRequestInlinedFunction)
+         {
+         void *clientCallee = _clientCallbackRequestInlinedFunction(_client, name);
+         if (clientCallee != NULL)
+            return static_cast<TR::MethodBuilder *>(_getImpl(clientCallee));
+         }
+
+      return NULL;
+      }
+
+   /**
+    * @brief the inlining policy for calls to functions defined from a MethodBuilder
+    * @param name the function being called
+    * @param numArgs the number of arguments passed at the call site
+    * @param argValues the arguments passed at the call site
+    * @param loopDepth the number of loops enclosing the call site
+    * @returns true if the call should be inlined
+    * The benefit of inlining is estimated from the call overhead, the arguments that are
+    * constants and the loop depth of the call site, and is weighed against the size of the
+    * callee's IL. Inlining stops at recursive calls and once the compilation has used its
+    * inlining budget (see the jitBuilderInlineBudget= and jitBuilderInlineMaxSize= options).
+    */
+   virtual bool shouldInline(const char *name, int32_t numArgs, TR::IlValue **argValues, int32_t loopDepth);
+
+   /**
+    * @brief returns the number of IL nodes generated the last time this MethodBuilder's IL was built, or -1
+    */
+   int32_t getILSize()                                       { return _ilSize; }
+   void setILSize(int32_t size)                              { _ilSize = size; }
+
+   /**
+    * @brief record that a call to calleeMB was inlined, generating the given number of IL nodes
+    */
+   void recordInlinedCall(TR::MethodBuilder *calleeMB, int32_t size);
+
    /**
     * @brief append the first bytecode builder object to this method
     * @param builder the bytecode builder object to add, usually for bytecode index 0
@@ -266,6 +330,14 @@ class MethodBuilder : public TR::IlBuilder
       _clientCallbackRequestFunction = (RequestFunctionCallback) callback;
       }
 
+   /**
+    * @brief Store callback function to be called on client when RequestInlinedFunction is called
+    */
+   void setClientCallback_RequestInlinedFunction(void *callback)
+      {
+      _clientCallbackRequestInlinedFunction = (RequestInlinedFunctionCallback) callback;
+      }
+
    /**
     * @brief Set the Client Allocator function
     */
@@ -317,6 +389,11 @@ class MethodBuilder : public TR::IlBuilder
     */
    RequestFunctionCallback     _clientCallbackRequestFunction;
 
+   /**
+    * @brief client callback function to call when RequestInlinedFunction is called
+    */
+   RequestInlinedFunctionCallback _clientCallbackRequestInlinedFunction;
+
    // These values are typically defined outside of a compilation
    const char                * _methodName;
    TR::IlType                * _returnType;
@@ -365,6 +442,12 @@ class MethodBuilder : public TR::IlBuilder
    typedef std::map<const char *, TR::ResolvedMethod *, StrComparator, FunctionMapAllocator> FunctionMap;
    FunctionMap                 _functions;
 
+   typedef TR::typed_allocator<std::pair<const char * const, TR::MethodBuilder *>, TR::Region &> InlinableFunctionMapAllocator;
+   typedef std::map<const char *, TR::MethodBuilder *, StrComparator, InlinableFunctionMapAllocator> InlinableFunctionMap;
+
+   // functions defined from a MethodBuilder, whose calls may be inlined
+   InlinableFunctionMap        _inlinableFunctions;
+
    TR::IlType                ** _cachedParameterTypes;
    const char                * _definingFile;
    char                        _definingLine[MAX_LINE_NUM_LEN];
@@ -388,6 +471,10 @@ class MethodBuilder : public TR::IlBuilder
    TR::IlBuilder             * _returnBuilder;
    const char                * _returnSymbolName;
 
+   int32_t                     _ilSize;
+   int32_t                     _inlinedILSize;
+   int32_t                     _numInlinedCalls;
+
 private:
    static ClientAllocator      _clientAllocator;
    static ImplGetter _getImpl;
@@ -25,10 +25,13 @@
 #include "il/SymbolReference.hpp"
 #include "compile/SymbolReferenceTable.hpp"
 #include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
 #include "env/FrontEnd.hpp"
 #include "ilgen/IlReference.hpp"
 #include "ilgen/TypeDictionary.hpp"
 #include "env/Region.hpp"
+#include "env/SegmentCache.hpp"
 #include "env/SystemSegmentProvider.hpp"
 #include "env/TRMemory.hpp"
 #include "infra/Assert.hpp"
@@ -425,6 +428,13 @@ OMR::UnionType::clearSymRefs()
    }
 
 
+static TR::SegmentCache *
+sharedSegmentCache()
+   {
+   TR::Options *options = TR::Options::getCmdLineOptions();
+   return options && options->getOption(TR_DisableSegmentCache) ? NULL : &TR::SegmentCache::instance();
+   }
+
 // Note: _memoryRegion and the corresponding TR::SegmentProvider and TR::Memory instances are stored as pointers within TypeDictionary
 // in order to avoid increasing the number of header files needed to compile against the JitBuilder library. Because we are storing
 // them as pointers, we cannot rely on the default C++ destruction semantic to destruct and deallocate the memory region, but rather
@@ -432,7 +442,7 @@ OMR::UnionType::clearSymRefs()
 // the user defined destructor, we need to make sure that any members (and their contents) that are allocated in _memoryRegion are
 // explicitly destroyed and deallocated *before* _memoryRegion in the TypeDictionary::MemoryManager destructor.
 OMR::TypeDictionary::MemoryManager::MemoryManager() :
-   _segmentProvider( new(TR::Compiler->persistentAllocator()) TR::SystemSegmentProvider(1 << 16, TR::Compiler->rawAllocator) ),
+   _segmentProvider( new(TR::Compiler->persistentAllocator()) TR::SystemSegmentProvider(1 << 16, TR::Compiler->rawAllocator, sharedSegmentCache()) ),
    _memoryRegion( new(TR::Compiler->persistentAllocator()) TR::Region(*_segmentProvider, TR::Compiler->rawAllocator) ),
    _trMemory( new(TR::Compiler->persistentAllocator()) TR_Memory(*::trPersistentMemory, *_memoryRegion) )
    {}
@@ -475,6 +485,18 @@ OMR::TypeDictionary::TypeDictionary() :
    VectorInt64  = _primitiveType[TR::VectorInt64]           = new (PERSISTENT_NEW) OMR::PrimitiveType("VectorInt64", TR::VectorInt64);
    VectorFloat  = _primitiveType[TR::VectorFloat]           = new (PERSISTENT_NEW) OMR::PrimitiveType("VectorFloat", TR::VectorFloat);
    VectorDouble = _primitiveType[TR::VectorDouble]          = new (PERSISTENT_NEW) OMR::PrimitiveType("VectorDouble", TR::VectorDouble);
+   Vector256Int8   = _primitiveType[TR::Vector256Int8] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector256Int8", TR::Vector256Int8);
+   Vector256Int16  = _primitiveType[TR::Vector256Int16] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector256Int16", TR::Vector256Int16);
+   Vector256Int32  = _primitiveType[TR::Vector256Int32] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector256Int32", TR::Vector256Int32);
+   Vector256Int64  = _primitiveType[TR::Vector256Int64] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector256Int64", TR::Vector256Int64);
+   Vector256Float  = _primitiveType[TR::Vector256Float] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector256Float", TR::Vector256Float);
+   Vector256Double = _primitiveType[TR::Vector256Double] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector256Double", TR::Vector256Double);
+   Vector512Int8   = _primitiveType[TR::Vector512Int8] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector512Int8", TR::Vector512Int8);
+   Vector512Int16  = _primitiveType[TR::Vector512Int16] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector512Int16", TR::Vector512Int16);
+   Vector512Int32  = _primitiveType[TR::Vector512Int32] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector512Int32", TR::Vector512Int32);
+   Vector512Int64  = _primitiveType[TR::Vector512Int64] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector512Int64", TR::Vector512Int64);
+   Vector512Float  = _primitiveType[TR::Vector512Float] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector512Float", TR::Vector512Float);
+   Vector512Double = _primitiveType[TR::Vector512Double] = new (PERSISTENT_NEW) OMR::PrimitiveType("Vector512Double", TR::Vector512Double);
 
    // pointer to primitive types
    pNoType       = _pointerToPrimitiveType[TR::NoType]       = new (PERSISTENT_NEW) OMR::PointerType(NoType);
@@ -491,6 +513,18 @@ OMR::TypeDictionary::TypeDictionary() :
    pVectorInt64  = _pointerToPrimitiveType[TR::VectorInt64]  = new (PERSISTENT_NEW) OMR::PointerType(VectorInt64);
    pVectorFloat  = _pointerToPrimitiveType[TR::VectorFloat]  = new (PERSISTENT_NEW) OMR::PointerType(VectorFloat);
    pVectorDouble = _pointerToPrimitiveType[TR::VectorDouble] = new (PERSISTENT_NEW) OMR::PointerType(VectorDouble);
+   pVector256Int8   = _pointerToPrimitiveType[TR::Vector256Int8] = new (PERSISTENT_NEW) OMR::PointerType(Vector256Int8);
+   pVector256Int16  = _pointerToPrimitiveType[TR::Vector256Int16] = new (PERSISTENT_NEW) OMR::PointerType(Vector256Int16);
+   pVector256Int32  = _pointerToPrimitiveType[TR::Vector256Int32] = new (PERSISTENT_NEW) OMR::PointerType(Vector256Int32);
+   pVector256Int64  = _pointerToPrimitiveType[TR::Vector256Int64] = new (PERSISTENT_NEW) OMR::PointerType(Vector256Int64);
+   pVector256Float  = _pointerToPrimitiveType[TR::Vector256Float] = new (PERSISTENT_NEW) OMR::PointerType(Vector256Float);
+   pVector256Double = _pointerToPrimitiveType[TR::Vector256Double] = new (PERSISTENT_NEW) OMR::PointerType(Vector256Double);
+   pVector512Int8   = _pointerToPrimitiveType[TR::Vector512Int8] = new (PERSISTENT_NEW) OMR::PointerType(Vector512Int8);
+   pVector512Int16  = _pointerToPrimitiveType[TR::Vector512Int16] = new (PERSISTENT_NEW) OMR::PointerType(Vector512Int16);
+   pVector512Int32  = _pointerToPrimitiveType[TR::Vector512Int32] = new (PERSISTENT_NEW) OMR::PointerType(Vector512Int32);
+   pVector512Int64  = _pointerToPrimitiveType[TR::Vector512Int64] = new (PERSISTENT_NEW) OMR::PointerType(Vector512Int64);
+   pVector512Float  = _pointerToPrimitiveType[TR::Vector512Float] = new (PERSISTENT_NEW) OMR::PointerType(Vector512Float);
+   pVector512Double = _pointerToPrimitiveType[TR::Vector512Double] = new (PERSISTENT_NEW) OMR::PointerType(Vector512Double);
 
    if (TR::Compiler->target.is64Bit())
       {
@@ -257,6 +257,18 @@ public:
    TR::IlType       * VectorInt64;
    TR::IlType       * VectorFloat;
    TR::IlType       * VectorDouble;
+   TR::IlType       * Vector256Int8;
+   TR::IlType       * Vector256Int16;
+   TR::IlType       * Vector256Int32;
+   TR::IlType       * Vector256Int64;
+   TR::IlType       * Vector256Float;
+   TR::IlType       * Vector256Double;
+   TR::IlType       * Vector512Int8;
+   TR::IlType       * Vector512Int16;
+   TR::IlType       * Vector512Int32;
+   TR::IlType       * Vector512Int64;
+   TR::IlType       * Vector512Float;
+   TR::IlType       * Vector512Double;
 
    TR::IlType       * _pointerToPrimitiveType[TR::NumOMRTypes];
    TR::IlType       * pNoType;
@@ -274,6 +286,18 @@ public:
    TR::IlType       * pVectorInt64;
    TR::IlType       * pVectorFloat;
    TR::IlType       * pVectorDouble;
+   TR::IlType       * pVector256Int8;
+   TR::IlType       * pVector256Int16;
+   TR::IlType       * pVector256Int32;
+   TR::IlType       * pVector256Int64;
+   TR::IlType       * pVector256Float;
+   TR::IlType       * pVector256Double;
+   TR::IlType       * pVector512Int8;
+   TR::IlType       * pVector512Int16;
+   TR::IlType       * pVector512Int32;
+   TR::IlType       * pVector512Int64;
+   TR::IlType       * pVector512Float;
+   TR::IlType       * pVector512Double;
    };
 
 } // namespace OMR
@@ -26,6 +26,11 @@
 #include "compile/Compilation.hpp"
 #include "ras/Debug.hpp"
 
+#if defined(TR_HOST_X86) && (defined(__GNUC__) || defined(__clang__))
+#include <immintrin.h>
+#define BITVECTOR_AVX2_KERNELS
+#endif
+
 // Number of bits set in a byte containing the index value
 //
 static int8_t bitsInByte[] =
@@ -262,3 +267,91 @@ bool TR_BitContainer::intersects(TR_BitContainer& v2)
          return v2._singleBit == _singleBit;
       }
    }
+
+#if defined(BITVECTOR_AVX2_KERNELS)
+
+// The compiler is not told the build host has AVX2, so the kernels are
+// compiled for it separately and only called once the CPU has been checked.
+//
+static bool hostSupportsAVX2()
+   {
+   static const bool supported = __builtin_cpu_supports("avx2");
+   return supported;
+   }
+
+#define CHUNKS_PER_YMM (32 / sizeof(chunk_t))
+
+__attribute__((target("avx2")))
+static int32_t orChunksAVX2(chunk_t *dst, const chunk_t *src, int32_t count)
+   {
+   int32_t i = 0;
+   for ( ; i + (int32_t)CHUNKS_PER_YMM <= count; i += CHUNKS_PER_YMM)
+      {
+      __m256i a = _mm256_loadu_si256((const __m256i *)(dst + i));
+      __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));
+      _mm256_storeu_si256((__m256i *)(dst + i), _mm256_or_si256(a, b));
+      }
+   return i;
+   }
+
+__attribute__((target("avx2")))
+static int32_t andChunksAVX2(chunk_t *dst, const chunk_t *src, int32_t count)
+   {
+   int32_t i = 0;
+   for ( ; i + (int32_t)CHUNKS_PER_YMM <= count; i += CHUNKS_PER_YMM)
+      {
+      __m256i a = _mm256_loadu_si256((const __m256i *)(dst + i));
+      __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));
+      _mm256_storeu_si256((__m256i *)(dst + i), _mm256_and_si256(a, b));
+      }
+   return i;
+   }
+
+__attribute__((target("avx2")))
+static int32_t andNotChunksAVX2(chunk_t *dst, const chunk_t *src, int32_t count)
+   {
+   int32_t i = 0;
+   for ( ; i + (int32_t)CHUNKS_PER_YMM <= count; i += CHUNKS_PER_YMM)
+      {
+      __m256i a = _mm256_loadu_si256((const __m256i *)(dst + i));
+      __m256i b = _mm256_loadu_si256((const __m256i *)(src + i));
+      // andnot computes ~first & second
+      _mm256_storeu_si256((__m256i *)(dst + i), _mm256_andnot_si256(b, a));
+      }
+   return i;
+   }
+
+#endif
+
+void TR_BitVector::orChunks(chunk_t *dst, const chunk_t *src, int32_t count)
+   {
+   int32_t i = 0;
+#if defined(BITVECTOR_AVX2_KERNELS)
+   if (hostSupportsAVX2())
+      i = orChunksAVX2(dst, src, count);
+#endif
+   for ( ; i < count; i++)
+      dst[i] |= src[i];
+   }
+
+void TR_BitVector::andChunks(chunk_t *dst, const chunk_t *src, int32_t count)
+   {
+   int32_t i = 0;
+#if defined(BITVECTOR_AVX2_KERNELS)
+   if (hostSupportsAVX2())
+      i = andChunksAVX2(dst, src, count);
+#endif
+   for ( ; i < count; i++)
+      dst[i] &= src[i];
+   }
+
+void TR_BitVector::andNotChunks(chunk_t *dst, const chunk_t *src, int32_t count)
+   {
+   int32_t i = 0;
+#if defined(BITVECTOR_AVX2_KERNELS)
+   if (hostSupportsAVX2())
+      i = andNotChunksAVX2(dst, src, count);
+#endif
+   for ( ; i < count; i++)
+      dst[i] &= ~src[i];
+   }
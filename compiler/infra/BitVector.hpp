@@ -488,8 +488,15 @@ class TR_BitVector
          setChunkSize(v2Used);
 
       // OR in all of the words from the 2nd vector
-      for (int32_t i = v2._firstChunkWithNonZero; i <= v2._lastChunkWithNonZero; i++)
-         _chunks[i] |= v2._chunks[i];
+      int32_t low = v2._firstChunkWithNonZero;
+      int32_t count = v2._lastChunkWithNonZero - low + 1;
+      if (count >= MIN_CHUNKS_FOR_KERNEL)
+         orChunks(_chunks + low, v2._chunks + low, count);
+      else
+         {
+         for (int32_t i = low; i <= v2._lastChunkWithNonZero; i++)
+            _chunks[i] |= v2._chunks[i];
+         }
       if (_firstChunkWithNonZero > v2._firstChunkWithNonZero)
          _firstChunkWithNonZero = v2._firstChunkWithNonZero;
       if (_lastChunkWithNonZero < v2._lastChunkWithNonZero)
@@ -544,8 +551,13 @@ class TR_BitVector
          }
 
       // AND in all of the words from the 2nd vector
-      for (i = low; i <= high; i++)
-         _chunks[i] &= v2._chunks[i];
+      if (high - low + 1 >= MIN_CHUNKS_FOR_KERNEL)
+         andChunks(_chunks + low, v2._chunks + low, high - low + 1);
+      else
+         {
+         for (i = low; i <= high; i++)
+            _chunks[i] &= v2._chunks[i];
+         }
 
       // Reset first and last chunks with non-zero
       resetLowAndHighChunks(low, high);
@@ -593,8 +605,13 @@ class TR_BitVector
          low = _firstChunkWithNonZero;
       if (high > _lastChunkWithNonZero)
          high = _lastChunkWithNonZero;
-      for (int32_t i = low; i<= high; i++)
-         _chunks[i] &= ~v2._chunks[i];
+      if (high - low + 1 >= MIN_CHUNKS_FOR_KERNEL)
+         andNotChunks(_chunks + low, v2._chunks + low, high - low + 1);
+      else
+         {
+         for (int32_t i = low; i<= high; i++)
+            _chunks[i] &= ~v2._chunks[i];
+         }
 
       // Reset first and last chunks with non-zero
       resetLowAndHighChunks(_firstChunkWithNonZero, _lastChunkWithNonZero);
@@ -903,8 +920,19 @@ class TR_BitVector
          }
       }
 
+   // Combine \p count chunks of \p src into \p dst. These use 256-bit vector
+   // instructions when the host supports them and are shared with the other
+   // bit set implementations.
+   //
+   static void orChunks(chunk_t *dst, const chunk_t *src, int32_t count);
+   static void andChunks(chunk_t *dst, const chunk_t *src, int32_t count);
+   static void andNotChunks(chunk_t *dst, const chunk_t *src, int32_t count);
+
    private:
 
+   // Shorter ranges of chunks are combined inline
+   static const int32_t MIN_CHUNKS_FOR_KERNEL = 8;
+
    /**
     * This data structure contains all the fields required for serializing TR_BitVector.
     */
@@ -0,0 +1,540 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "infra/HybridBitVector.hpp"
+
+#include <stdint.h>
+#include <string.h>
+#include "compile/Compilation.hpp"
+#include "env/IO.hpp"
+#include "env/TRMemory.hpp"
+#include "infra/Assert.hpp"
+#include "ras/Debug.hpp"
+
+static TR::Region *
+regionFor(TR_Memory *m, TR_AllocationKind allocKind)
+   {
+   switch (allocKind)
+      {
+      case heapAlloc:
+         return &(m->heapMemoryRegion());
+      case stackAlloc:
+         return &(m->currentStackRegion());
+      case persistentAlloc:
+         return NULL;
+      default:
+         TR_ASSERT(false, "Unhandled allocation type!");
+         return NULL;
+      }
+   }
+
+TR_HybridBitVector::TR_HybridBitVector(int64_t initBits, TR_Memory *m, TR_AllocationKind allocKind)
+   : _region(regionFor(m, allocKind)),
+     _dense(_region ? TR_BitVector(*_region) : TR_BitVector())
+   {
+   initialize(initBits);
+   }
+
+TR_HybridBitVector::TR_HybridBitVector(int64_t initBits, TR::Region &region)
+   : _region(&region),
+     _dense(region)
+   {
+   initialize(initBits);
+   }
+
+void
+TR_HybridBitVector::initialize(int64_t initBits)
+   {
+   // An element of the sparse array costs as much as a chunk's worth of
+   // bits, so the array stops paying off at one element per chunk
+   int64_t limit = initBits / BITS_IN_CHUNK;
+   _sparseLimit = limit < MIN_SPARSE_LIMIT ? MIN_SPARSE_LIMIT : (int32_t)limit;
+   _isDense = false;
+   _elements = NULL;
+   _scratch = NULL;
+   _size = 0;
+   _capacity = 0;
+   }
+
+int32_t *
+TR_HybridBitVector::allocateElements(int32_t capacity)
+   {
+   if (_region)
+      return (int32_t *)_region->allocate(capacity * sizeof(int32_t));
+   return (int32_t *)TR_Memory::jitPersistentAlloc(capacity * sizeof(int32_t), TR_Memory::BitVector);
+   }
+
+void
+TR_HybridBitVector::ensureCapacity(int32_t capacity)
+   {
+   if (capacity <= _capacity)
+      return;
+
+   int32_t newCapacity = _capacity ? _capacity * 2 : 8;
+   if (newCapacity < capacity)
+      newCapacity = capacity;
+   if (newCapacity > _sparseLimit)
+      newCapacity = _sparseLimit;
+   if (newCapacity < capacity)
+      newCapacity = capacity;
+
+   int32_t *elements = allocateElements(newCapacity);
+   int32_t *scratch = allocateElements(newCapacity);
+   if (_size)
+      memcpy(elements, _elements, _size * sizeof(int32_t));
+   if (!_region && _elements)
+      {
+      TR_Memory::jitPersistentFree(_elements);
+      TR_Memory::jitPersistentFree(_scratch);
+      }
+   _elements = elements;
+   _scratch = scratch;
+   _capacity = newCapacity;
+   }
+
+// Index of the first element not less than n
+//
+int32_t
+TR_HybridBitVector::find(int32_t n)
+   {
+   int32_t low = 0;
+   int32_t high = _size;
+   while (low < high)
+      {
+      int32_t middle = (low + high) / 2;
+      if (_elements[middle] < n)
+         low = middle + 1;
+      else
+         high = middle;
+      }
+   return low;
+   }
+
+void
+TR_HybridBitVector::makeDense()
+   {
+   if (_isDense)
+      return;
+   for (int32_t i = 0; i < _size; i++)
+      _dense.set(_elements[i]);
+   _size = 0;
+   _isDense = true;
+   }
+
+void
+TR_HybridBitVector::makeSparseIfSmall()
+   {
+   if (!_isDense)
+      return;
+
+   // Going back to sparse only once well under the limit keeps a set near
+   // it from switching back and forth
+   int32_t count = _dense.elementCount();
+   if (count > _sparseLimit / 4)
+      return;
+
+   ensureCapacity(count);
+   _size = 0;
+   TR_BitVectorIterator bvi(_dense);
+   while (bvi.hasMoreElements())
+      _elements[_size++] = bvi.getNextElement();
+   _dense.empty();
+   _isDense = false;
+   }
+
+int32_t
+TR_HybridBitVector::get(int32_t n)
+   {
+   if (_isDense)
+      return _dense.get(n);
+   int32_t i = find(n);
+   return i < _size && _elements[i] == n;
+   }
+
+void
+TR_HybridBitVector::set(int32_t n)
+   {
+   if (_isDense)
+      {
+      _dense.set(n);
+      return;
+      }
+
+   int32_t i = find(n);
+   if (i < _size && _elements[i] == n)
+      return;
+
+   if (_size >= _sparseLimit)
+      {
+      makeDense();
+      _dense.set(n);
+      return;
+      }
+
+   ensureCapacity(_size + 1);
+   memmove(_elements + i + 1, _elements + i, (_size - i) * sizeof(int32_t));
+   _elements[i] = n;
+   _size++;
+   }
+
+void
+TR_HybridBitVector::reset(int32_t n)
+   {
+   if (_isDense)
+      {
+      _dense.reset(n);
+      return;
+      }
+
+   int32_t i = find(n);
+   if (i < _size && _elements[i] == n)
+      {
+      memmove(_elements + i, _elements + i + 1, (_size - i - 1) * sizeof(int32_t));
+      _size--;
+      }
+   }
+
+void
+TR_HybridBitVector::empty()
+   {
+   if (_isDense)
+      _dense.empty();
+   _isDense = false;
+   _size = 0;
+   }
+
+void
+TR_HybridBitVector::setAll(int64_t n)
+   {
+   if (n <= 0)
+      return;
+   makeDense();
+   _dense.setAll(n);
+   }
+
+void
+TR_HybridBitVector::setAll(int64_t m, int64_t n)
+   {
+   if (n < m)
+      return;
+   makeDense();
+   _dense.setAll(m, n);
+   }
+
+void
+TR_HybridBitVector::resetAll(int64_t m, int64_t n)
+   {
+   if (_isDense)
+      {
+      _dense.resetAll(m, n);
+      makeSparseIfSmall();
+      return;
+      }
+
+   int32_t to = 0;
+   for (int32_t i = 0; i < _size; i++)
+      {
+      if (_elements[i] < m || _elements[i] > n)
+         _elements[to++] = _elements[i];
+      }
+   _size = to;
+   }
+
+bool
+TR_HybridBitVector::intersects(TR_HybridBitVector &other)
+   {
+   if (_isDense && other._isDense)
+      return _dense.intersects(other._dense);
+
+   TR_HybridBitVector &sparse = _isDense ? other : *this;
+   TR_HybridBitVector &rest = _isDense ? *this : other;
+   for (int32_t i = 0; i < sparse._size; i++)
+      {
+      if (rest.get(sparse._elements[i]))
+         return true;
+      }
+   return false;
+   }
+
+void
+TR_HybridBitVector::operator= (TR_HybridBitVector &other)
+   {
+   if (&other == this)
+      return;
+
+   if (other._isDense)
+      {
+      _size = 0;
+      _isDense = true;
+      _dense = other._dense;
+      return;
+      }
+
+   if (_isDense)
+      {
+      _dense.empty();
+      _isDense = false;
+      }
+   if (other._size > _sparseLimit)
+      {
+      // This set is smaller than the other
+      _size = 0;
+      makeDense();
+      for (int32_t i = 0; i < other._size; i++)
+         _dense.set(other._elements[i]);
+      return;
+      }
+   ensureCapacity(other._size);
+   if (other._size)
+      memcpy(_elements, other._elements, other._size * sizeof(int32_t));
+   _size = other._size;
+   }
+
+bool
+TR_HybridBitVector::operator== (TR_HybridBitVector &other)
+   {
+   if (_isDense && other._isDense)
+      return _dense == other._dense;
+
+   if (!_isDense && !other._isDense)
+      return _size == other._size && (_size == 0 || memcmp(_elements, other._elements, _size * sizeof(int32_t)) == 0);
+
+   TR_HybridBitVector &sparse = _isDense ? other : *this;
+   TR_HybridBitVector &dense = _isDense ? *this : other;
+   if (dense._dense.elementCount() != sparse._size)
+      return false;
+   for (int32_t i = 0; i < sparse._size; i++)
+      {
+      if (!dense._dense.get(sparse._elements[i]))
+         return false;
+      }
+   return true;
+   }
+
+void
+TR_HybridBitVector::operator|= (TR_HybridBitVector &other)
+   {
+   if (other._isDense)
+      {
+      makeDense();
+      _dense |= other._dense;
+      return;
+      }
+
+   if (_isDense)
+      {
+      for (int32_t i = 0; i < other._size; i++)
+         _dense.set(other._elements[i]);
+      return;
+      }
+
+   if (_size + other._size > _sparseLimit)
+      {
+      makeDense();
+      for (int32_t i = 0; i < other._size; i++)
+         _dense.set(other._elements[i]);
+      return;
+      }
+
+   // Merge the two sorted arrays into the scratch buffer
+   ensureCapacity(_size + other._size);
+   int32_t i = 0, j = 0, to = 0;
+   while (i < _size && j < other._size)
+      {
+      int32_t a = _elements[i];
+      int32_t b = other._elements[j];
+      _scratch[to++] = a <= b ? a : b;
+      i += a <= b;
+      j += b <= a;
+      }
+   while (i < _size)
+      _scratch[to++] = _elements[i++];
+   while (j < other._size)
+      _scratch[to++] = other._elements[j++];
+
+   int32_t *swap = _elements;
+   _elements = _scratch;
+   _scratch = swap;
+   _size = to;
+   }
+
+void
+TR_HybridBitVector::operator&= (TR_HybridBitVector &other)
+   {
+   if (_isDense && other._isDense)
+      {
+      _dense &= other._dense;
+      makeSparseIfSmall();
+      return;
+      }
+
+   if (_isDense)
+      {
+      // The result is no larger than the sparse operand
+      ensureCapacity(other._size);
+      _size = 0;
+      for (int32_t i = 0; i < other._size; i++)
+         {
+         if (_dense.get(other._elements[i]))
+            _elements[_size++] = other._elements[i];
+         }
+      _dense.empty();
+      _isDense = false;
+      return;
+      }
+
+   int32_t to = 0;
+   for (int32_t i = 0; i < _size; i++)
+      {
+      if (other.get(_elements[i]))
+         _elements[to++] = _elements[i];
+      }
+   _size = to;
+   }
+
+void
+TR_HybridBitVector::operator-= (TR_HybridBitVector &other)
+   {
+   if (_isDense)
+      {
+      if (other._isDense)
+         _dense -= other._dense;
+      else
+         {
+         for (int32_t i = 0; i < other._size; i++)
+            _dense.reset(other._elements[i]);
+         }
+      makeSparseIfSmall();
+      return;
+      }
+
+   int32_t to = 0;
+   for (int32_t i = 0; i < _size; i++)
+      {
+      if (!other.get(_elements[i]))
+         _elements[to++] = _elements[i];
+      }
+   _size = to;
+   }
+
+void
+TR_HybridBitVector::operator|= (TR_BitVector &other)
+   {
+   if (other.isEmpty())
+      return;
+   makeDense();
+   _dense |= other;
+   }
+
+void
+TR_HybridBitVector::operator&= (TR_BitVector &other)
+   {
+   if (_isDense)
+      {
+      _dense &= other;
+      makeSparseIfSmall();
+      return;
+      }
+
+   int32_t to = 0;
+   for (int32_t i = 0; i < _size; i++)
+      {
+      if (other.get(_elements[i]))
+         _elements[to++] = _elements[i];
+      }
+   _size = to;
+   }
+
+void
+TR_HybridBitVector::operator-= (TR_BitVector &other)
+   {
+   if (_isDense)
+      {
+      _dense -= other;
+      makeSparseIfSmall();
+      return;
+      }
+
+   int32_t to = 0;
+   for (int32_t i = 0; i < _size; i++)
+      {
+      if (!other.get(_elements[i]))
+         _elements[to++] = _elements[i];
+      }
+   _size = to;
+   }
+
+void
+TR_HybridBitVector::intersectInto(TR_BitVector &other)
+   {
+   if (_isDense)
+      {
+      other &= _dense;
+      return;
+      }
+
+   if (other.isEmpty())
+      return;
+
+   TR_BitVectorIterator bvi(other);
+   int32_t i = 0;
+   while (bvi.hasMoreElements())
+      {
+      int32_t n = bvi.getNextElement();
+      while (i < _size && _elements[i] < n)
+         i++;
+      if (i == _size || _elements[i] != n)
+         other.reset(n);
+      }
+   }
+
+void
+TR_HybridBitVector::unionInto(TR_BitVector &other)
+   {
+   if (_isDense)
+      {
+      other |= _dense;
+      return;
+      }
+
+   for (int32_t i = 0; i < _size; i++)
+      other.set(_elements[i]);
+   }
+
+void
+TR_HybridBitVector::print(TR::Compilation *comp, TR::FILE *file)
+   {
+   if (_isDense)
+      {
+      _dense.print(comp, file);
+      return;
+      }
+
+   if (comp->getDebug())
+      {
+      if (file == NULL)
+         file = comp->getOutFile();
+      trfprintf(file, "{");
+      for (int32_t i = 0; i < _size; i++)
+         trfprintf(file, i ? ", %d" : "%d", _elements[i]);
+      trfprintf(file, "}");
+      }
+   }
@@ -0,0 +1,158 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef HYBRIDBITVECTOR_INCL
+#define HYBRIDBITVECTOR_INCL
+
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "infra/BitVector.hpp"
+
+namespace TR { class Compilation; }
+
+/**
+ * A bit set that switches between a sparse and a dense representation
+ * according to how many elements it holds.
+ *
+ * While the population is small the elements are kept as a sorted array of
+ * indices, so set operations cost time in proportion to the number of
+ * elements rather than to the range of bits. Once the population outgrows
+ * the point where the array is as large as the bit vector would be, the set
+ * turns into a dense TR_BitVector, whose chunk operations use the vector
+ * kernels. An intersection or difference that leaves a dense set sparsely
+ * populated turns it back into an array.
+ *
+ * The class implements the container interface used by the data flow
+ * engine, so a TR_BasicDFSetAnalysis can be instantiated over it.
+ */
+class TR_HybridBitVector
+   {
+   public:
+   TR_ALLOC(TR_Memory::BitVector)
+
+   typedef int32_t containerCharacteristic; // used by data flow
+   static const containerCharacteristic nullContainerCharacteristic = -1;
+
+   TR_HybridBitVector(int64_t initBits, TR_Memory *m, TR_AllocationKind allocKind = heapAlloc);
+   TR_HybridBitVector(int64_t initBits, TR::Region &region);
+
+   bool isDense() { return _isDense; }
+
+   int32_t get(int32_t n);
+   void set(int32_t n);
+   void reset(int32_t n);
+
+   bool isEmpty() { return _isDense ? _dense.isEmpty() : _size == 0; }
+   void empty();
+
+   // Set bits 0 to n-1, or m to n inclusive
+   void setAll(int64_t n);
+   void setAll(int64_t m, int64_t n);
+
+   // Reset bits m to n inclusive
+   void resetAll(int64_t m, int64_t n);
+
+   int32_t elementCount() { return _isDense ? _dense.elementCount() : _size; }
+   bool hasMoreThanOneElement() { return _isDense ? _dense.hasMoreThanOneElement() : _size > 1; }
+   bool intersects(TR_HybridBitVector &other);
+
+   void operator= (TR_HybridBitVector &other);
+   bool operator== (TR_HybridBitVector &other);
+   bool operator!= (TR_HybridBitVector &other) { return !(*this == other); }
+
+   void operator|= (TR_HybridBitVector &other);
+   void operator&= (TR_HybridBitVector &other);
+   void operator-= (TR_HybridBitVector &other);
+
+   void operator|= (TR_BitVector &other);
+   void operator&= (TR_BitVector &other);
+   void operator-= (TR_BitVector &other);
+
+   // Intersect a dense vector with this set, leaving the result in \p other
+   void intersectInto(TR_BitVector &other);
+
+   // Union this set into a dense vector
+   void unionInto(TR_BitVector &other);
+
+   void print(TR::Compilation *comp, TR::FILE *file = NULL);
+
+   private:
+
+   // Smallest population a set may reach before it is made dense
+   static const int32_t MIN_SPARSE_LIMIT = 16;
+
+   TR_HybridBitVector(const TR_HybridBitVector &);   // not copyable
+
+   void initialize(int64_t initBits);
+   int32_t *allocateElements(int32_t capacity);
+   void ensureCapacity(int32_t capacity);
+   int32_t find(int32_t n);
+   void makeDense();
+   void makeSparseIfSmall();
+
+   bool _isDense;
+   int32_t _sparseLimit;      // most elements held in the sparse array
+
+   // Sparse representation: sorted element indices
+   int32_t *_elements;
+   int32_t *_scratch;         // second buffer of the same capacity, for merges
+   int32_t _size;
+   int32_t _capacity;
+
+   TR::Region *_region;       // NULL for persistent memory
+
+   // Dense representation: always empty while the set is sparse
+   TR_BitVector _dense;
+
+   friend class TR_HybridBitVectorIterator;
+   };
+
+/**
+ * Iterates over the elements of a TR_HybridBitVector in increasing order.
+ * The set must not change representation while it is being iterated.
+ */
+class TR_HybridBitVectorIterator
+   {
+   public:
+   TR_HybridBitVectorIterator(TR_HybridBitVector &bv)
+      : _bitVector(bv), _index(0)
+      {
+      if (bv._isDense)
+         _denseIterator.setBitVector(bv._dense);
+      }
+
+   bool hasMoreElements()
+      {
+      return _bitVector._isDense ? _denseIterator.hasMoreElements() != 0 : _index < _bitVector._size;
+      }
+
+   int32_t getNextElement()
+      {
+      return _bitVector._isDense ? _denseIterator.getNextElement() : _bitVector._elements[_index++];
+      }
+
+   private:
+   TR_HybridBitVector &_bitVector;
+   int32_t _index;
+   TR_BitVectorIterator _denseIterator;
+   };
+
+#endif
@@ -887,8 +887,11 @@ bool OMR::CFG::removeEdge(TR::CFGEdge *edge)
 
          blocksVisited->set(from->getNumber());
 
+         // Each edge is unlinked from the lists being walked, so restart from
+         // the first remaining edge rather than stepping past a freed element
+         //
          TR_SuccessorIterator edgesIt(from);
-         for (TR::CFGEdge * e = edgesIt.getFirst(); e; e = edgesIt.getNext())
+         for (TR::CFGEdge * e = edgesIt.getFirst(); e; e = edgesIt.getFirst())
             {
             to = e->getTo();
             _numEdges--;
@@ -1251,6 +1254,11 @@ bool OMR::CFG::consumePseudoRandomFrequencies()
 bool
 OMR::CFG::setFrequencies()
    {
+   // Measured frequencies are better than anything that can be derived here
+   //
+   if (_hasEdgeProfileFrequencies)
+      return true;
+
    if (this == comp()->getFlowGraph())
       {
       self()->resetFrequencies();
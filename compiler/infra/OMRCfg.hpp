@@ -136,6 +136,7 @@ class CFG
       _calledFrequency = 0;
       _initialBlockFrequency = -1;
       _edgeProbabilities = NULL;
+      _hasEdgeProfileFrequencies = false;
    }
 
    TR::CFG * self();
@@ -284,6 +285,11 @@ class CFG
 
    int32_t getInitialBlockFrequency() { return _initialBlockFrequency; }
 
+   /// True if block and edge frequencies were set from edge counts measured
+   /// by an instrumented earlier compile of the method.
+   bool hasEdgeProfileFrequencies() { return _hasEdgeProfileFrequencies; }
+   void setHasEdgeProfileFrequencies(bool b) { _hasEdgeProfileFrequencies = b; }
+
    void propagateFrequencyInfoFrom(TR_Structure *str);
    void processAcyclicRegion(TR_RegionStructure *region);
    void processNaturalLoop(TR_RegionStructure *region);
@@ -382,6 +388,7 @@ protected:
    int32_t                  _oldMaxEdgeFrequency;
    TR_BitVector            *_frequencySet;
    double                  *_edgeProbabilities; // temp array
+   bool                     _hasEdgeProfileFrequencies;
 
 public: //FIXME: These public members should eventually be wrtapped in an interface.
    int32_t                  _max_edge_freq;
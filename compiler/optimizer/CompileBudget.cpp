@@ -0,0 +1,159 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/CompileBudget.hpp"
+
+#include <stdint.h>
+#include <string.h>
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/IO.hpp"
+#include "env/VerboseLog.hpp"
+#include "optimizer/Optimizer.hpp"
+
+// Optimizations whose cost is checked against the budget, and the cheaper
+// optimization that replaces each one when the budget would be exceeded
+//
+static const struct
+   {
+   OMR::Optimizations _optimization;
+   OMR::Optimizations _replacement;
+   } budgetedOptimizations[] =
+   {
+   { OMR::globalValuePropagation,       OMR::localValuePropagation },
+   { OMR::partialRedundancyElimination, OMR::localCSE },
+   { OMR::loopVersioner,                OMR::endOpts },
+   };
+
+// An optimization that has not run yet is assumed to cost this many times the
+// average per node cost of the optimizations run so far
+//
+#define UNKNOWN_OPTIMIZATION_COST_FACTOR 4
+
+TR_CompileBudget::TR_CompileBudget(TR::Compilation *comp)
+   : _comp(comp),
+     _start(TR::Compiler->vm.getHighResClock(comp)),
+     _budgetTicks((uint64_t)comp->getOptions()->getCompileTimeBudget() * TR::Compiler->vm.getHighResClockResolution() / 1000),
+     _recordedTicks(0),
+     _recordedNodes(0),
+     _trace(comp->getOption(TR_TraceCompileBudget))
+   {
+   memset(_costs, 0, sizeof(_costs));
+   }
+
+uint64_t
+TR_CompileBudget::projectedTicks(OMR::Optimizations optNum)
+   {
+   if (_costs[optNum]._runs > 0)
+      return _costs[optNum]._lastTicks;
+
+   if (_recordedNodes <= 0)
+      return 0;
+
+   return (uint64_t)((double)_recordedTicks / _recordedNodes * _comp->getNodeCount() * UNKNOWN_OPTIMIZATION_COST_FACTOR);
+   }
+
+OMR::Optimizations
+TR_CompileBudget::select(OMR::Optimizations optNum)
+   {
+   if (_budgetTicks == 0)
+      return optNum;
+
+   for (int32_t i = 0; i < sizeof(budgetedOptimizations) / sizeof(budgetedOptimizations[0]); i++)
+      {
+      if (budgetedOptimizations[i]._optimization != optNum)
+         continue;
+
+      uint64_t elapsed = TR::Compiler->vm.getHighResClock(_comp) - _start;
+      uint64_t projected = projectedTicks(optNum);
+      if (elapsed + projected <= _budgetTicks)
+         return optNum;
+
+      OMR::Optimizations replacement = budgetedOptimizations[i]._replacement;
+      if (replacement == OMR::endOpts)
+         _costs[optNum]._skipped++;
+      else
+         _costs[optNum]._downgraded++;
+
+      if (_trace)
+         traceMsg(_comp, "Compile budget: %s %s, elapsed %llu projected %llu budget %llu ticks\n",
+                  OMR::Optimizer::getOptimizationName(optNum),
+                  replacement == OMR::endOpts ? "skipped" : "downgraded",
+                  (unsigned long long)elapsed, (unsigned long long)projected, (unsigned long long)_budgetTicks);
+
+      return replacement;
+      }
+
+   return optNum;
+   }
+
+void
+TR_CompileBudget::record(OMR::Optimizations optNum, uint64_t ticks, size_t bytes, int32_t numNodes)
+   {
+   Cost &cost = _costs[optNum];
+   cost._ticks += ticks;
+   cost._lastTicks = ticks;
+   cost._bytes += bytes;
+   cost._runs++;
+   _recordedTicks += ticks;
+   _recordedNodes += numNodes;
+   }
+
+void
+TR_CompileBudget::report()
+   {
+   uint64_t elapsed = TR::Compiler->vm.getHighResClock(_comp) - _start;
+   uint64_t resolution = TR::Compiler->vm.getHighResClockResolution();
+   bool verbose = TR::Options::isAnyVerboseOptionSet(TR_VerboseOptimizer);
+
+   if (_trace)
+      traceMsg(_comp, "<compileBudget method=\"%s\" usec=\"%llu\" budgetUsec=\"%llu\">\n", _comp->signature(),
+               (unsigned long long)(elapsed * 1000000 / resolution), (unsigned long long)(_budgetTicks * 1000000 / resolution));
+
+   TR_VerboseLog::CriticalSection vlogLock(verbose);
+   if (verbose)
+      TR_VerboseLog::writeLine(TR_Vlog_PERF, "Optimization costs for %s: %llu usec", _comp->signature(),
+                               (unsigned long long)(elapsed * 1000000 / resolution));
+
+   for (int32_t i = OMR::endOpts + 1; i < OMR::numOpts; i++)
+      {
+      Cost &cost = _costs[i];
+      if (cost._runs == 0 && cost._skipped == 0 && cost._downgraded == 0)
+         continue;
+
+      const char *name = OMR::Optimizer::getOptimizationName((OMR::Optimizations)i);
+      unsigned long long usec = (unsigned long long)(cost._ticks * 1000000 / resolution);
+      unsigned long long kbytes = (unsigned long long)(cost._bytes / 1024);
+
+      if (_trace)
+         traceMsg(_comp, "   <opt name=\"%s\" runs=\"%d\" usec=\"%llu\" kbytes=\"%llu\" skipped=\"%d\" downgraded=\"%d\"/>\n",
+                  name, cost._runs, usec, kbytes, cost._skipped, cost._downgraded);
+
+      if (verbose)
+         TR_VerboseLog::writeLine(TR_Vlog_PERF, "   %-40s runs=%d usec=%llu KB=%llu skipped=%d downgraded=%d",
+                                  name, cost._runs, usec, kbytes, cost._skipped, cost._downgraded);
+      }
+
+   if (_trace)
+      traceMsg(_comp, "</compileBudget>\n");
+   }
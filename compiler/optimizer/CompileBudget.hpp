@@ -0,0 +1,97 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef COMPILEBUDGET_INCL
+#define COMPILEBUDGET_INCL
+
+#include <stddef.h>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "optimizer/Optimizations.hpp"
+
+namespace TR { class Compilation; }
+
+/**
+ * Class TR_CompileBudget
+ * ======================
+ *
+ * Accounts for the time and memory used by each optimization of one
+ * optimizer run and enforces the compileTimeBudget option.
+ *
+ * Before an expensive optimization (global value propagation, partial
+ * redundancy elimination, loop versioning) runs, its cost is projected
+ * from the time it took on its previous run in this compilation or, if it
+ * has not run yet, from the average time per node of the optimizations run
+ * so far scaled by the current node count. If the time already spent
+ * optimizing plus that projection exceeds the budget, the optimization is
+ * replaced by a cheaper local one or skipped.
+ *
+ * A per-method summary of the costs is written to the JIT log with
+ * traceCompileBudget and to the verbose log with verbose={optimizer}.
+ */
+class TR_CompileBudget
+   {
+   public:
+   TR_ALLOC(TR_Memory::Optimizer)
+
+   TR_CompileBudget(TR::Compilation *comp);
+
+   /**
+    * @brief Decides how an optimization is run within the budget
+    * @return optNum itself, a cheaper replacement, or OMR::endOpts if it must be skipped
+    */
+   OMR::Optimizations select(OMR::Optimizations optNum);
+
+   /**
+    * @brief Records the cost of one run of an optimization
+    * @param ticks high resolution clock ticks spent in the optimization
+    * @param bytes heap and stack memory allocated by the optimization
+    * @param numNodes number of nodes in the method when the optimization started
+    */
+   void record(OMR::Optimizations optNum, uint64_t ticks, size_t bytes, int32_t numNodes);
+
+   /// Writes the summary of the costs to the JIT log and the verbose log
+   void report();
+
+   private:
+
+   struct Cost
+      {
+      uint64_t _ticks;
+      uint64_t _lastTicks;
+      uint64_t _bytes;
+      int32_t _runs;
+      int32_t _skipped;
+      int32_t _downgraded;
+      };
+
+   uint64_t projectedTicks(OMR::Optimizations optNum);
+
+   TR::Compilation *_comp;
+   uint64_t _start;
+   uint64_t _budgetTicks;        // 0 when there is no budget
+   uint64_t _recordedTicks;
+   int64_t _recordedNodes;       // sum of the node counts over all recorded runs
+   bool _trace;
+   Cost _costs[OMR::numOpts];
+   };
+
+#endif
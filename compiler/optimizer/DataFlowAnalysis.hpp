@@ -34,6 +34,7 @@
 #include "infra/BitVector.hpp"
 #include "infra/Flags.hpp"
 #include "infra/HashTab.hpp"
+#include "infra/HybridBitVector.hpp"
 #include "infra/Link.hpp"
 #include "infra/List.hpp"
 #include "optimizer/Structure.hpp"
@@ -477,7 +478,15 @@ class TR_UnionSingleBitContainerAnalysis : public TR_UnionDFSetAnalysis<TR_Singl
       TR_UnionDFSetAnalysis<TR_SingleBitContainer *>(comp, cfg, optimizer, trace) {}
   };
 
-class TR_ReachingDefinitions : public TR_UnionBitVectorAnalysis
+class TR_UnionHybridBitVectorAnalysis : public TR_UnionDFSetAnalysis<TR_HybridBitVector *>
+   {
+   public:
+   typedef TR_HybridBitVector ContainerType;
+   TR_UnionHybridBitVectorAnalysis(TR::Compilation *comp, TR::CFG *cfg, TR::Optimizer *optimizer, bool trace) :
+      TR_UnionDFSetAnalysis<TR_HybridBitVector *>(comp, cfg, optimizer, trace) {}
+   };
+
+class TR_ReachingDefinitions : public TR_UnionHybridBitVectorAnalysis
    {
    public:
 
@@ -0,0 +1,371 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/EdgeProfiler.hpp"
+
+#include <stdint.h>
+#include <string.h>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/PersistentInfo.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/CfgNode.hpp"
+#include "ras/Debug.hpp"
+#include "AtomicSupport.hpp"
+
+TR_EdgeProfile::TR_EdgeProfile(const char *signature, int32_t numNodes, int32_t numCounters)
+   : _numNodes(numNodes),
+     _numCounters(numCounters),
+     _next(NULL)
+   {
+   _signature = (char *)TR_Memory::jitPersistentAlloc(strlen(signature) + 1, TR_Memory::PersistentProfileInfo);
+   strcpy(_signature, signature);
+   _from = (int32_t *)TR_Memory::jitPersistentAlloc(numCounters * sizeof(int32_t), TR_Memory::PersistentProfileInfo);
+   _to = (int32_t *)TR_Memory::jitPersistentAlloc(numCounters * sizeof(int32_t), TR_Memory::PersistentProfileInfo);
+   _counts = (int64_t *)TR_Memory::jitPersistentAlloc(numCounters * sizeof(int64_t), TR_Memory::PersistentProfileInfo);
+   memset(_counts, 0, numCounters * sizeof(int64_t));
+   }
+
+bool
+TR_EdgeProfile::hasCounts()
+   {
+   for (int32_t i = 0; i < _numCounters; i++)
+      {
+      if (_counts[i] != 0)
+         return true;
+      }
+   return false;
+   }
+
+TR_EdgeProfiler::TR_EdgeProfiler(TR::Compilation *comp)
+   : _comp(comp),
+     _trace(comp->getOption(TR_TraceBFGeneration))
+   {
+   }
+
+void
+TR_EdgeProfiler::perform()
+   {
+   // Counters are addressed directly, which relocatable code cannot do
+   //
+   if (_comp->compileRelocatableCode() || !_comp->getFlowGraph())
+      return;
+
+   TR_EdgeProfile *profile = findProfile();
+   if (profile && profile->hasCounts())
+      {
+      if (applyProfile(profile))
+         return;
+
+      if (_trace)
+         traceMsg(_comp, "Edge profile of %s does not match the CFG, instrumenting again\n", _comp->signature());
+      }
+
+   instrument();
+   }
+
+TR_EdgeProfile *
+TR_EdgeProfiler::findProfile()
+   {
+   for (TR_EdgeProfile *profile = _comp->getPersistentInfo()->getEdgeProfiles(); profile; profile = profile->_next)
+      {
+      if (!strcmp(profile->_signature, _comp->signature()))
+         return profile;
+      }
+   return NULL;
+   }
+
+// Successors of a block that is left in more than one way, other than the
+// last one, need a counter of their own if they can also be entered from
+// elsewhere. The count of the last one is what remains of the block count.
+//
+static bool
+needsEdgeCounter(TR::Block *block, TR::CFGEdge *edge)
+   {
+   TR::CFGEdgeList &successors = block->getSuccessors();
+   if (successors.size() < 2)
+      return false;
+
+   TR::CFGEdge *lastAmbiguous = NULL;
+   for (auto e = successors.begin(); e != successors.end(); ++e)
+      {
+      if ((*e)->getTo()->getPredecessors().size() != 1)
+         lastAmbiguous = *e;
+      }
+
+   return edge != lastAmbiguous &&
+          edge->getTo()->getPredecessors().size() != 1 &&
+          toBlock(edge->getTo())->getEntry() != NULL;
+   }
+
+void
+TR_EdgeProfiler::addCounter(TR::Block *block, int64_t *counter)
+   {
+   TR::Node *bbStart = block->getEntry()->getNode();
+   TR::SymbolReference *symRef = _comp->getSymRefTab()->createKnownStaticDataSymbolRef(counter, TR::Int64);
+   TR::Node *load = TR::Node::createWithSymRef(bbStart, TR::lload, 0, symRef);
+   TR::Node *add = TR::Node::create(TR::ladd, 2, load, TR::Node::lconst(bbStart, 1));
+   TR::Node *store = TR::Node::createWithSymRef(TR::lstore, 1, 1, add, symRef);
+   block->prepend(TR::TreeTop::create(_comp, store));
+   }
+
+void
+TR_EdgeProfiler::instrument()
+   {
+   TR::CFG *cfg = _comp->getFlowGraph();
+   TR::StackMemoryRegion stackMemoryRegion(*_comp->trMemory());
+
+   int32_t numNodes = cfg->getNextNodeNumber();
+   int32_t numCounters = 0;
+   TR::CFGNode *node;
+   for (node = cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      if (!block->getEntry() || block->isCatchBlock())
+         continue;
+
+      numCounters++;
+      for (auto e = block->getSuccessors().begin(); e != block->getSuccessors().end(); ++e)
+         {
+         if (needsEdgeCounter(block, *e))
+            numCounters++;
+         }
+      }
+
+   if (numCounters == 0)
+      return;
+
+   TR_EdgeProfile *profile = new (PERSISTENT_NEW) TR_EdgeProfile(_comp->signature(), numNodes, numCounters);
+
+   // Decide on every counter before the CFG changes
+   //
+   TR::Block **counted = (TR::Block **)_comp->trMemory()->allocateStackMemory(numCounters * sizeof(TR::Block *));
+   TR::Block **edgeTargets = (TR::Block **)_comp->trMemory()->allocateStackMemory(numCounters * sizeof(TR::Block *));
+   int32_t index = 0;
+   for (node = cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      if (!block->getEntry() || block->isCatchBlock())
+         continue;
+
+      profile->_from[index] = block->getNumber();
+      profile->_to[index] = TR_EdgeProfile::BlockCounter;
+      counted[index] = block;
+      edgeTargets[index] = NULL;
+      index++;
+
+      for (auto e = block->getSuccessors().begin(); e != block->getSuccessors().end(); ++e)
+         {
+         if (!needsEdgeCounter(block, *e))
+            continue;
+
+         profile->_from[index] = block->getNumber();
+         profile->_to[index] = (*e)->getTo()->getNumber();
+         counted[index] = block;
+         edgeTargets[index] = toBlock((*e)->getTo());
+         index++;
+         }
+      }
+
+   for (index = 0; index < numCounters; index++)
+      {
+      TR::Block *block = counted[index];
+      if (edgeTargets[index])
+         block = block->splitEdge(block, edgeTargets[index], _comp);
+
+      addCounter(block, &profile->_counts[index]);
+
+      if (_trace)
+         {
+         if (edgeTargets[index])
+            traceMsg(_comp, "Edge profiling: counter %d for edge block_%d -> block_%d in block_%d\n", index, profile->_from[index], profile->_to[index], block->getNumber());
+         else
+            traceMsg(_comp, "Edge profiling: counter %d for block_%d\n", index, block->getNumber());
+         }
+      }
+
+   // Other compilation threads may publish profiles at the same time and
+   // findProfile walks the list without a lock, so the new profile must be
+   // complete before it becomes the head.
+   //
+   TR_EdgeProfile * volatile *head = _comp->getPersistentInfo()->getEdgeProfilesAddress();
+   TR_EdgeProfile *oldHead;
+   do
+      {
+      oldHead = *head;
+      profile->_next = oldHead;
+      }
+   while (VM_AtomicSupport::lockCompareExchange((volatile uintptr_t *)head, (uintptr_t)oldHead, (uintptr_t)profile) != (uintptr_t)oldHead);
+   }
+
+int64_t
+TR_EdgeProfiler::getEdgeCount(TR_EdgeProfile *profile, int64_t *blockCounts, TR::CFGEdge *edge)
+   {
+   TR::CFGNode *from = edge->getFrom();
+   TR::CFGNode *to = edge->getTo();
+   int64_t fromCount = blockCounts[from->getNumber()] > 0 ? blockCounts[from->getNumber()] : 0;
+
+   // The edge out of the CFG start node enters the method
+   //
+   if (!toBlock(from)->getEntry())
+      return blockCounts[to->getNumber()] > 0 ? blockCounts[to->getNumber()] : 0;
+
+   if (from->getSuccessors().size() == 1)
+      return fromCount;
+
+   int64_t known = 0;
+   int32_t numUnknown = 0;
+   int64_t count = -1;
+   for (auto e = from->getSuccessors().begin(); e != from->getSuccessors().end(); ++e)
+      {
+      TR::CFGNode *succ = (*e)->getTo();
+      int64_t succCount = -1;
+      for (int32_t i = 0; i < profile->_numCounters && succCount < 0; i++)
+         {
+         if (profile->_from[i] == from->getNumber() && profile->_to[i] == succ->getNumber())
+            succCount = profile->_counts[i];
+         }
+      if (succCount < 0 && succ->getPredecessors().size() == 1 && blockCounts[succ->getNumber()] >= 0)
+         succCount = blockCounts[succ->getNumber()];
+
+      if (*e == edge)
+         count = succCount;
+
+      if (succCount >= 0)
+         known += succCount;
+      else
+         numUnknown++;
+      }
+
+   if (count >= 0)
+      return count;
+
+   return known < fromCount ? (fromCount - known) / numUnknown : 0;
+   }
+
+static int32_t
+scaleCount(int64_t count, int64_t maxCount, int32_t low, int32_t high)
+   {
+   return low + (int32_t)(((double)count / (double)maxCount) * (high - low));
+   }
+
+bool
+TR_EdgeProfiler::applyProfile(TR_EdgeProfile *profile)
+   {
+   TR::CFG *cfg = _comp->getFlowGraph();
+   int32_t numNodes = cfg->getNextNodeNumber();
+   if (numNodes != profile->_numNodes)
+      return false;
+
+   TR::StackMemoryRegion stackMemoryRegion(*_comp->trMemory());
+
+   TR::CFGNode **nodes = (TR::CFGNode **)_comp->trMemory()->allocateStackMemory(numNodes * sizeof(TR::CFGNode *));
+   int64_t *blockCounts = (int64_t *)_comp->trMemory()->allocateStackMemory(numNodes * sizeof(int64_t));
+   memset(nodes, 0, numNodes * sizeof(TR::CFGNode *));
+   TR::CFGNode *node;
+   for (node = cfg->getFirstNode(); node; node = node->getNext())
+      nodes[node->getNumber()] = node;
+   for (int32_t n = 0; n < numNodes; n++)
+      blockCounts[n] = -1;
+
+   for (int32_t i = 0; i < profile->_numCounters; i++)
+      {
+      int32_t from = profile->_from[i];
+      int32_t to = profile->_to[i];
+      if (from < 0 || from >= numNodes || !nodes[from])
+         return false;
+
+      if (to == TR_EdgeProfile::BlockCounter)
+         blockCounts[from] = profile->_counts[i];
+      else if (to < 0 || to >= numNodes || !nodes[to] || !nodes[from]->hasSuccessor(nodes[to]))
+         return false;
+      }
+
+   int64_t maxBlockCount = 0;
+   int64_t maxEdgeCount = 0;
+   for (node = cfg->getFirstNode(); node; node = node->getNext())
+      {
+      if (blockCounts[node->getNumber()] > maxBlockCount)
+         maxBlockCount = blockCounts[node->getNumber()];
+
+      for (auto e = node->getSuccessors().begin(); e != node->getSuccessors().end(); ++e)
+         {
+         int64_t count = getEdgeCount(profile, blockCounts, *e);
+         if (count > maxEdgeCount)
+            maxEdgeCount = count;
+         }
+      }
+
+   if (maxBlockCount == 0)
+      return false;
+
+   for (node = cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      int64_t count = blockCounts[node->getNumber()];
+      if (!block->getEntry())
+         {
+         count = blockCounts[_comp->getStartBlock()->getNumber()];
+         node->setFrequency(count > 0 ? scaleCount(count, maxBlockCount, MAX_COLD_BLOCK_COUNT + 1, MAX_BLOCK_COUNT) : 0);
+         }
+      else if (count > 0)
+         {
+         node->setFrequency(scaleCount(count, maxBlockCount, MAX_COLD_BLOCK_COUNT + 1, MAX_BLOCK_COUNT));
+         }
+      else
+         {
+         node->setFrequency(count == 0 ? UNKNOWN_COLD_BLOCK_COUNT : CATCH_COLD_BLOCK_COUNT);
+         block->setIsCold();
+         }
+
+      for (auto e = node->getSuccessors().begin(); e != node->getSuccessors().end(); ++e)
+         {
+         int64_t edgeCount = getEdgeCount(profile, blockCounts, *e);
+         (*e)->setFrequency(edgeCount > 0 ? scaleCount(edgeCount, maxEdgeCount, 1, TR::CFG::MAX_PROF_EDGE_FREQ) : 0);
+         }
+
+      if (_trace)
+         traceMsg(_comp, "Edge profile: block_%d count %lld frequency %d%s\n", node->getNumber(), (long long)count, node->getFrequency(),
+            block->getEntry() && block->isCold() ? " (cold)" : "");
+      }
+
+   cfg->setMaxFrequency(MAX_BLOCK_COUNT);
+   cfg->setMaxEdgeFrequency(TR::CFG::MAX_PROF_EDGE_FREQ);
+   cfg->_max_edge_freq = TR::CFG::MAX_PROF_EDGE_FREQ;
+   cfg->setHasEdgeProfileFrequencies(true);
+
+   if (_trace)
+      _comp->dumpMethodTrees("Trees after applying edge profile");
+
+   return true;
+   }
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#ifndef EDGEPROFILER_INCL
+#define EDGEPROFILER_INCL
+
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+
+namespace TR { class Block; }
+namespace TR { class CFGEdge; }
+namespace TR { class CFGNode; }
+namespace TR { class Compilation; }
+
+/**
+ * Edge counts collected for one method by code compiled with the
+ * enableEdgeProfiling option. The profile lives in persistent memory and
+ * is found again by method signature when the method is recompiled.
+ *
+ * Every counter either counts entries into a block (_to is BlockCounter)
+ * or the number of times an edge was taken. Block numbers are those of the
+ * CFG right after IL generation, which is deterministic for a given
+ * method, so they identify the same blocks in the recompilation.
+ */
+class TR_EdgeProfile
+   {
+   public:
+   TR_PERSISTENT_ALLOC(TR_Memory::PersistentProfileInfo)
+
+   static const int32_t BlockCounter = -1;
+
+   TR_EdgeProfile(const char *signature, int32_t numNodes, int32_t numCounters);
+
+   /// True once the instrumented code has run at least once
+   bool hasCounts();
+
+   char *_signature;
+   int32_t _numNodes;         // number of CFG nodes after IL generation
+   int32_t _numCounters;
+   int32_t *_from;            // block entered, or source block of the edge
+   int32_t *_to;              // target block of the edge, or BlockCounter
+   int64_t *_counts;          // incremented by the instrumented code
+   TR_EdgeProfile *_next;
+   };
+
+/**
+ * Class TR_EdgeProfiler
+ * =====================
+ *
+ * Runs right after IL generation when enableEdgeProfiling is set. If an
+ * earlier compile of the method collected counts, they are turned into
+ * block and edge frequencies (zero count blocks become cold) and the CFG is
+ * marked as having measured frequencies, which block ordering uses to lay
+ * out hot paths contiguously. Otherwise the method is instrumented:
+ *
+ *  - every block gets a counter bumped on entry, and
+ *  - for a block with several successors, each edge to a successor with
+ *    other predecessors, except one whose count follows from the rest, is
+ *    split and the new block gets a counter.
+ *
+ * Counters are not updated atomically, so counts from racing threads are
+ * approximate, which is good enough for code layout.
+ */
+class TR_EdgeProfiler
+   {
+   public:
+   TR_ALLOC(TR_Memory::Optimizer)
+
+   TR_EdgeProfiler(TR::Compilation *comp);
+
+   void perform();
+
+   private:
+
+   TR_EdgeProfile *findProfile();
+   bool applyProfile(TR_EdgeProfile *profile);
+   void instrument();
+   void addCounter(TR::Block *block, int64_t *counter);
+   int64_t getEdgeCount(TR_EdgeProfile *profile, int64_t *blockCounts, TR::CFGEdge *edge);
+
+   TR::Compilation *_comp;
+   bool _trace;
+   };
+
+#endif
@@ -0,0 +1,502 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/IfConversion.hpp"
+
+#include <algorithm>
+#include <stddef.h>
+#include <stdint.h>
+#include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/Checklist.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/TransformUtil.hpp"
+#include "ras/DebugCounter.hpp"
+
+#define OPT_DETAILS "O^O IF CONVERSION: "
+
+// Cycles lost when a branch is mispredicted
+#define MISPREDICT_PENALTY 15
+
+// Misprediction rate, in percent, assumed for a branch without profiling information
+#define UNPROFILED_MISPREDICT_PERCENT 25
+
+// Largest number of symbols stored by the arms of a converted conditional
+#define MAX_CONDITIONAL_STORES 4
+
+// Largest number of nodes an arm may evaluate
+#define MAX_ARM_COST 8
+
+// Longest chain of blocks forming an arm
+#define MAX_ARM_BLOCKS 4
+
+TR_IfConversion::TR_IfConversion(TR::OptimizationManager *manager)
+   : TR::Optimization(manager),
+     _evaluated(NULL)
+   {}
+
+bool
+TR_IfConversion::shouldPerform()
+   {
+   return comp()->getFlowGraph() != NULL && comp()->cg()->getSupportsSelect();
+   }
+
+int32_t
+TR_IfConversion::perform()
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   if (trace())
+      {
+      traceMsg(comp(), "Starting IfConversion\n");
+      comp()->dumpMethodTrees("Trees before IfConversion");
+      }
+
+   TR::vector<TR::Block *, TR::Region&> blocks(stackMemoryRegion);
+   for (TR::Block *block = comp()->getStartBlock(); block; block = block->getNextBlock())
+      blocks.push_back(block);
+
+   // Inner conditionals usually follow the ones around them
+   int32_t numConverted = 0;
+   for (auto it = blocks.rbegin(); it != blocks.rend(); ++it)
+      {
+      TR::Block *block = *it;
+      if (block->nodeIsRemoved())
+         continue;
+      if (convert(block, stackMemoryRegion))
+         numConverted++;
+      }
+
+   if (numConverted > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      }
+
+   if (trace())
+      {
+      comp()->dumpMethodTrees("Trees after IfConversion");
+      traceMsg(comp(), "Ending IfConversion, converted %d conditionals\n", numConverted);
+      }
+
+   return numConverted;
+   }
+
+const char *
+TR_IfConversion::optDetailString() const throw()
+   {
+   return "O^O IF CONVERSION: ";
+   }
+
+static void
+markEvaluated(TR::Node *node, TR::NodeChecklist &evaluated)
+   {
+   if (evaluated.contains(node))
+      return;
+   evaluated.add(node);
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      markEvaluated(node->getChild(i), evaluated);
+   }
+
+bool
+TR_IfConversion::convert(TR::Block *block, TR::Region &region)
+   {
+   if (block->getEntry() == NULL)
+      return false;
+
+   TR::TreeTop *branchTree = block->getLastRealTreeTop();
+   TR::Node *branch = branchTree->getNode();
+   if (!branch->getOpCode().isIf()
+       || branch->getOpCode().isCompBranchOnly()
+       || branch->getNumChildren() != 2
+       || branch->getOpCode().convertIfCmpToCmp() == TR::BadILOp)
+      return false;
+
+   // Guards are patched at runtime or folded by later optimizations
+   if (branch->isTheVirtualGuardForAGuardedInlinedCall() || branch->isOSRGuard())
+      return false;
+
+   // The code generators mishandle sub-integer compares under a select
+   TR::DataType compareType = branch->getFirstChild()->getDataType();
+   if (compareType != TR::Int32 && compareType != TR::Int64 && compareType != TR::Address
+       && compareType != TR::Float && compareType != TR::Double)
+      return false;
+
+   TR::Block *fallThroughHead = block->getNextBlock();
+   TR::Block *takenHead = branch->getBranchDestination()->getNode()->getBlock();
+   if (fallThroughHead == NULL || fallThroughHead == takenHead || block->getSuccessors().size() != 2)
+      return false;
+
+   NodeVector takenStores(region);
+   NodeVector fallThroughStores(region);
+   int32_t numTakenBlocks = 0;
+   int32_t numFallThroughBlocks = 0;
+   TR::Block *join = collectArm(block, takenHead, takenStores, numTakenBlocks);
+   if (join == NULL
+       || join != collectArm(block, fallThroughHead, fallThroughStores, numFallThroughBlocks)
+       || join == block
+       || join->getEntry() == NULL
+       || join->getEntry()->getNode()->getNumChildren() > 0
+       || takenStores.size() + fallThroughStores.size() == 0)
+      return false;
+
+   // Pair the stores of the two arms by symbol, in the order of the taken arm
+   ConditionalStoreVector conditionalStores(region);
+   for (auto it = takenStores.begin(); it != takenStores.end(); ++it)
+      {
+      ConditionalStore conditionalStore = { *it, (*it)->getFirstChild(), NULL };
+      conditionalStores.push_back(conditionalStore);
+      }
+   for (auto it = fallThroughStores.begin(); it != fallThroughStores.end(); ++it)
+      {
+      int32_t index = findConditionalStore(conditionalStores, (*it)->getSymbolReference()->getSymbol());
+      if (index < 0)
+         {
+         ConditionalStore conditionalStore = { *it, NULL, (*it)->getFirstChild() };
+         conditionalStores.push_back(conditionalStore);
+         }
+      else if (conditionalStores[index]._store->getOpCodeValue() != (*it)->getOpCodeValue()
+               || conditionalStores[index]._store->getSymbolReference()->getOffset() != (*it)->getSymbolReference()->getOffset())
+         {
+         return false;
+         }
+      else
+         {
+         conditionalStores[index]._fallThroughValue = (*it)->getFirstChild();
+         }
+      }
+   if (conditionalStores.size() > MAX_CONDITIONAL_STORES)
+      return false;
+
+   TR::NodeChecklist evaluated(comp());
+   for (TR::TreeTop *tt = block->startOfExtendedBlock()->getEntry(); tt != branchTree->getNextTreeTop(); tt = tt->getNextTreeTop())
+      markEvaluated(tt->getNode(), evaluated);
+   _evaluated = &evaluated;
+
+   bool convertible = true;
+   int32_t takenCost = 0;
+   int32_t fallThroughCost = 0;
+   TR::NodeChecklist visited(comp());
+   TR::NodeChecklist takenLoads(comp());
+   TR::NodeChecklist fallThroughLoads(comp());
+   for (int32_t i = 0; convertible && i < takenStores.size(); i++)
+      {
+      TR::Node *value = takenStores[i]->getFirstChild();
+      int32_t order = findConditionalStore(conditionalStores, takenStores[i]->getSymbolReference()->getSymbol());
+      convertible = isConvertibleValue(value, takenCost, visited)
+                    && loadsSeeArmValues(value, takenStores, i, order, conditionalStores, false, takenLoads);
+      }
+   for (int32_t i = 0; convertible && i < fallThroughStores.size(); i++)
+      {
+      TR::Node *value = fallThroughStores[i]->getFirstChild();
+      int32_t order = findConditionalStore(conditionalStores, fallThroughStores[i]->getSymbolReference()->getSymbol());
+      convertible = isConvertibleValue(value, fallThroughCost, visited)
+                    && loadsSeeArmValues(value, fallThroughStores, i, order, conditionalStores, false, fallThroughLoads);
+      }
+   _evaluated = NULL;
+
+   if (!convertible || takenCost > MAX_ARM_COST || fallThroughCost > MAX_ARM_COST)
+      return false;
+
+   // Costs are in hundredths of a cycle
+   int32_t numSelects = conditionalStores.size();
+   int32_t mispredict = mispredictPercent(block, takenHead, numTakenBlocks, fallThroughHead, numFallThroughBlocks);
+   int32_t selectCost = (takenCost + fallThroughCost + numSelects) * 100;
+   int32_t branchCost = (std::max(takenCost, fallThroughCost) + 1) * 100 + mispredict * MISPREDICT_PENALTY;
+
+   const char *shape = numTakenBlocks == 0 ? "fallThroughTriangle" : (numFallThroughBlocks == 0 ? "takenTriangle" : "diamond");
+   if (trace())
+      traceMsg(comp(), "block_%d: %s joining at block_%d, arm costs %d and %d, %d selects, %d%% mispredicted: select cost %d, branch cost %d\n",
+         block->getNumber(), shape, join->getNumber(), takenCost, fallThroughCost, numSelects, mispredict, selectCost, branchCost);
+
+   if (selectCost > branchCost)
+      return false;
+
+   if (!performTransformation(comp(), "%sConverting %s at block_%d into %d selects\n", OPT_DETAILS, shape, block->getNumber(), numSelects))
+      return false;
+
+   TR::CFG *cfg = comp()->getFlowGraph();
+   cfg->invalidateStructure();
+
+   TR::Node *condition = TR::Node::create(branch, branch->getOpCode().convertIfCmpToCmp(), 2,
+      branch->getFirstChild(),
+      branch->getSecondChild());
+
+   for (auto it = conditionalStores.begin(); it != conditionalStores.end(); ++it)
+      {
+      TR::Node *store = it->_store;
+      TR::SymbolReference *symRef = store->getSymbolReference();
+      TR::DataType type = store->getDataType();
+      TR::Node *takenValue = it->_takenValue ? it->_takenValue : TR::Node::createWithSymRef(store, comp()->il.opCodeForDirectLoad(type), 0, symRef);
+      TR::Node *fallThroughValue = it->_fallThroughValue ? it->_fallThroughValue : TR::Node::createWithSymRef(store, comp()->il.opCodeForDirectLoad(type), 0, symRef);
+
+      TR::Node *select = TR::Node::create(store, comp()->il.opCodeForSelect(type), 3);
+      select->setAndIncChild(0, condition);
+      select->setAndIncChild(1, takenValue);
+      select->setAndIncChild(2, fallThroughValue);
+      TR::Node *newStore = TR::Node::createWithSymRef(store, store->getOpCodeValue(), 1, select, symRef);
+      branchTree->insertBefore(TR::TreeTop::create(comp(), newStore));
+
+      if (trace())
+         traceMsg(comp(), "   Created n%dn storing select n%dn to #%d\n", newStore->getGlobalIndex(), select->getGlobalIndex(), symRef->getReferenceNumber());
+      }
+
+   bool hasJoinEdge = false;
+   for (auto edge = block->getSuccessors().begin(); edge != block->getSuccessors().end(); ++edge)
+      {
+      if ((*edge)->getTo() == join)
+         hasJoinEdge = true;
+      }
+   if (!hasJoinEdge)
+      cfg->addEdge(block, join);
+   if (numTakenBlocks > 0)
+      cfg->removeEdge(block, takenHead);
+   if (numFallThroughBlocks > 0)
+      cfg->removeEdge(block, fallThroughHead);
+
+   TR::TransformUtil::removeTree(comp(), branchTree);
+
+   if (block->getNextBlock() != join)
+      {
+      TR::Node *gotoNode = TR::Node::create(condition, TR::Goto, 0);
+      gotoNode->setBranchDestination(join->getEntry());
+      block->append(TR::TreeTop::create(comp(), gotoNode));
+      }
+
+   TR::DebugCounter::incStaticDebugCounter(comp(), TR::DebugCounter::debugCounterName(comp(), "ifConversion/%s/(%s)", shape, comp()->signature()));
+   return true;
+   }
+
+TR::Block *
+TR_IfConversion::collectArm(TR::Block *block, TR::Block *head, NodeVector &stores, int32_t &numBlocks)
+   {
+   numBlocks = 0;
+   TR::Block *arm = head;
+   while (arm != block
+          && arm->getEntry() != NULL
+          && arm->getPredecessors().size() == 1
+          && arm->getExceptionPredecessors().empty())
+      {
+      if (++numBlocks > MAX_ARM_BLOCKS
+          || arm->getSuccessors().size() != 1
+          || !arm->getExceptionSuccessors().empty()
+          || arm->getEntry()->getNode()->getNumChildren() > 0
+          || arm->getExit()->getNode()->getNumChildren() > 0)
+         return NULL;
+
+      for (TR::TreeTop *tt = arm->getEntry()->getNextTreeTop(); tt != arm->getExit(); tt = tt->getNextTreeTop())
+         {
+         TR::Node *node = tt->getNode();
+         if (node->getOpCodeValue() == TR::Goto
+             && node->getNumChildren() == 0
+             && tt->getNextTreeTop() == arm->getExit())
+            continue;
+
+         if (!isConvertibleStore(node))
+            return NULL;
+
+         for (auto it = stores.begin(); it != stores.end(); ++it)
+            {
+            if ((*it)->getSymbolReference()->getSymbol() == node->getSymbolReference()->getSymbol())
+               return NULL;
+            }
+         stores.push_back(node);
+         }
+
+      arm = toBlock(arm->getSuccessors().front()->getTo());
+      }
+   return arm;
+   }
+
+bool
+TR_IfConversion::isConvertibleStore(TR::Node *store)
+   {
+   if (!store->getOpCode().isStoreDirect()
+       || store->getOpCode().isWrtBar()
+       || store->getNumChildren() != 1)
+      return false;
+
+   TR::Symbol *symbol = store->getSymbolReference()->getSymbol();
+   if (!symbol->isAutoOrParm()
+       || symbol->isVolatile()
+       || symbol->isInternalPointer())
+      return false;
+
+   if (!store->getDataType().isIntegral() && !store->getDataType().isAddress())
+      return false;
+
+   if (store->getOpCodeValue() == TR::astore && store->isHeapificationStore())
+      return false;
+
+   return !store->getFirstChild()->isInternalPointer();
+   }
+
+bool
+TR_IfConversion::isConvertibleValue(TR::Node *node, int32_t &cost, TR::NodeChecklist &visited)
+   {
+   if (_evaluated->contains(node) || visited.contains(node))
+      return true;
+   visited.add(node);
+
+   if (!node->getDataType().isIntegral() && !node->getDataType().isAddress())
+      return false;
+
+   TR::ILOpCode &op = node->getOpCode();
+   if (op.isLoadVarDirect())
+      {
+      TR::Symbol *symbol = node->getSymbolReference()->getSymbol();
+      if (!symbol->isAutoOrParm() || symbol->isVolatile())
+         return false;
+      }
+   else if (op.hasSymbolReference() || node->isInternalPointer())
+      {
+      return false;
+      }
+   else if (!op.isLoadConst()
+            && !(op.isArithmetic() && !op.isDiv() && !op.isRem())
+            && !op.isConversion()
+            && !op.isBooleanCompare()
+            && !op.isSelect())
+      {
+      return false;
+      }
+
+   // Constants are usually encoded as immediates
+   if (!op.isLoadConst())
+      cost++;
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!isConvertibleValue(node->getChild(i), cost, visited))
+         return false;
+      }
+   return true;
+   }
+
+bool
+TR_IfConversion::loadsSeeArmValues(TR::Node *node, NodeVector &armStores, int32_t position, int32_t order,
+                                   ConditionalStoreVector &conditionalStores, bool shared, TR::NodeChecklist &visited)
+   {
+   if (_evaluated->contains(node))
+      return true;
+
+   // A node referenced more than once is evaluated by whichever new store
+   // reaches it first, so it must not read a symbol that any of them writes
+   shared = shared || node->getReferenceCount() > 1;
+   if (visited.contains(node))
+      return true;
+   visited.add(node);
+
+   if (node->getOpCode().isLoadVarDirect())
+      {
+      TR::Symbol *symbol = node->getSymbolReference()->getSymbol();
+      int32_t stored = findConditionalStore(conditionalStores, symbol);
+      if (stored >= 0)
+         {
+         if (shared)
+            return false;
+
+         // On the arm the load sees the new value if the arm stored it
+         // before, and after the conversion if the symbol's new store comes
+         // first. The new store of a symbol holds the arm's value when the
+         // arm is selected, so the two agree when both or neither hold.
+         bool storedEarlierOnArm = false;
+         for (int32_t i = 0; i < position; i++)
+            {
+            if (armStores[i]->getSymbolReference()->getSymbol() == symbol)
+               storedEarlierOnArm = true;
+            }
+         if (storedEarlierOnArm != (stored < order))
+            return false;
+         }
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!loadsSeeArmValues(node->getChild(i), armStores, position, order, conditionalStores, shared, visited))
+         return false;
+      }
+   return true;
+   }
+
+int32_t
+TR_IfConversion::mispredictPercent(TR::Block *block, TR::Block *takenHead, int32_t numTakenBlocks,
+                                   TR::Block *fallThroughHead, int32_t numFallThroughBlocks)
+   {
+   // A cold arm is not expected to run, so the branch is predictable
+   if ((numTakenBlocks > 0 && takenHead->isCold())
+       || (numFallThroughBlocks > 0 && fallThroughHead->isCold()))
+      return 0;
+
+   if (!comp()->hasBlockFrequencyInfo())
+      return UNPROFILED_MISPREDICT_PERCENT;
+
+   int32_t takenFrequency;
+   int32_t totalFrequency;
+   if (numTakenBlocks > 0 && numFallThroughBlocks > 0)
+      {
+      if (takenHead->getFrequency() < 0 || fallThroughHead->getFrequency() < 0)
+         return UNPROFILED_MISPREDICT_PERCENT;
+      takenFrequency = takenHead->getFrequency();
+      totalFrequency = takenFrequency + fallThroughHead->getFrequency();
+      }
+   else
+      {
+      TR::Block *arm = numTakenBlocks > 0 ? takenHead : fallThroughHead;
+      if (arm->getFrequency() < 0)
+         return UNPROFILED_MISPREDICT_PERCENT;
+      totalFrequency = block->getFrequency();
+      takenFrequency = numTakenBlocks > 0 ? arm->getFrequency() : totalFrequency - arm->getFrequency();
+      }
+
+   if (totalFrequency <= 0)
+      return UNPROFILED_MISPREDICT_PERCENT;
+
+   // A well trained predictor mispredicts the less likely direction
+   int32_t takenPercent = std::min(std::max(takenFrequency * 100 / totalFrequency, 0), 100);
+   return std::min(takenPercent, 100 - takenPercent);
+   }
+
+int32_t
+TR_IfConversion::findConditionalStore(ConditionalStoreVector &conditionalStores, TR::Symbol *symbol)
+   {
+   for (int32_t i = 0; i < conditionalStores.size(); i++)
+      {
+      if (conditionalStores[i]._store->getSymbolReference()->getSymbol() == symbol)
+         return i;
+      }
+   return -1;
+   }
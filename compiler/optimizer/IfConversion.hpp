@@ -0,0 +1,137 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef IFCONVERSION_INCL
+#define IFCONVERSION_INCL
+
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+namespace TR { class Block; }
+namespace TR { class Node; }
+namespace TR { class NodeChecklist; }
+namespace TR { class Optimization; }
+namespace TR { class Symbol; }
+
+/**
+ * Class TR_IfConversion
+ * =====================
+ *
+ * If-conversion replaces small conditional regions of the CFG by selects,
+ * so that a branch the processor predicts badly costs a few conditional
+ * moves instead of a pipeline flush. A block ending in a compare and
+ * branch is converted when its two successors are arms of one of these
+ * shapes:
+ *
+ *        diamond          triangle            triangle
+ *                       (taken arm)      (fall through arm)
+ *
+ *          if               if                  if
+ *         /  \              | \                 | \
+ *       fall  taken         |  taken          fall |
+ *         \  /              | /                 | /
+ *         join             join                join
+ *
+ * An arm is a chain of blocks, each with a single predecessor, that only
+ * store integral or address values to autos and parms, and whose values
+ * neither have side effects nor can trap. Every symbol stored on either
+ * arm gets a store of
+ *
+ *    xselect (xcmpYY a b) takenValue fallThroughValue
+ *
+ * in the branching block, where a load of the symbol stands in for the
+ * value on an arm that does not store it, and the arms are removed.
+ * Blocks are visited from the last to the first, so an inner conditional
+ * is converted before the one around it and nested conditionals become
+ * trees of selects.
+ *
+ * Both arms are evaluated after the conversion, so it is only done when
+ * that is cheaper than the expected cost of the branch: the longer arm
+ * plus the misprediction penalty weighted by the probability of a
+ * misprediction. The probability comes from the block frequencies when
+ * the compilation has profiling information; without it the branch is
+ * assumed to be one the predictor has not learnt, and a cold arm always
+ * makes the branch predictable.
+ */
+class TR_IfConversion : public TR::Optimization
+   {
+   public:
+   TR_IfConversion(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_IfConversion(manager);
+      }
+
+   virtual bool    shouldPerform();
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   /**
+    * A symbol stored on either arm and the value each arm stores to it, or
+    * NULL when the arm leaves it unchanged.
+    */
+   struct ConditionalStore
+      {
+      TR::Node *_store;             // the first store of the symbol, the model of the new one
+      TR::Node *_takenValue;
+      TR::Node *_fallThroughValue;
+      };
+
+   typedef TR::vector<TR::Node *, TR::Region&> NodeVector;
+   typedef TR::vector<ConditionalStore, TR::Region&> ConditionalStoreVector;
+
+   bool convert(TR::Block *block, TR::Region &region);
+
+   /**
+    * @brief Collects the stores of the arm starting at a successor of the branching block
+    * @param head the successor
+    * @param numBlocks set to the number of blocks in the arm, 0 when the successor is the join
+    * @return the block the arm flows into, or NULL if the arm cannot be converted
+    */
+   TR::Block *collectArm(TR::Block *block, TR::Block *head, NodeVector &stores, int32_t &numBlocks);
+
+   bool isConvertibleStore(TR::Node *store);
+   bool isConvertibleValue(TR::Node *node, int32_t &cost, TR::NodeChecklist &visited);
+
+   /**
+    * @brief Checks that the loads in the value of an arm's store read, after
+    *        the conversion, what they read on the arm
+    * @param armStores the stores of the arm
+    * @param position the position of the store on the arm
+    * @param order the position of the store's symbol among the new stores
+    */
+   bool loadsSeeArmValues(TR::Node *node, NodeVector &armStores, int32_t position, int32_t order,
+                          ConditionalStoreVector &conditionalStores, bool shared, TR::NodeChecklist &visited);
+
+   int32_t mispredictPercent(TR::Block *block, TR::Block *takenHead, int32_t numTakenBlocks,
+                             TR::Block *fallThroughHead, int32_t numFallThroughBlocks);
+
+   static int32_t findConditionalStore(ConditionalStoreVector &conditionalStores, TR::Symbol *symbol);
+
+   TR::NodeChecklist *_evaluated;   // nodes evaluated before the branch of the current block
+   };
+
+#endif
@@ -1739,7 +1739,8 @@ int32_t TR_HoistBlocks::process(TR::TreeTop *startTree, TR::TreeTop *endTree)
                         cfg->addExceptionEdge(splitBlock, succBlock);
                         }
 
-                     int32_t splitFrequency = (*nextEdge)->getFrequency();
+                     // splitEdge has unlinked nextEdge from the predecessor list
+                     int32_t splitFrequency = current->getFrequency();
                      if (splitFrequency < 0)
                         splitFrequency = block->getFrequency();
                      //dumpOptDetails(comp(), "Split block_%d has freq %d\n", splitBlock->getNumber(), splitFrequency);
@@ -0,0 +1,325 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/LoopDependence.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "infra/BitVector.hpp"
+
+// Offsets, coefficients and scales are kept well inside 64 bits so that
+// the dependence tests cannot overflow
+#define MAX_AFFINE_MAGNITUDE ((int64_t)1 << 31)
+
+// Deepest index expression that is linearized
+#define MAX_AFFINE_DEPTH 12
+
+static bool
+isSmall(int64_t value)
+   {
+   return value > -MAX_AFFINE_MAGNITUDE && value < MAX_AFFINE_MAGNITUDE;
+   }
+
+TR_AffineAccess::TR_AffineAccess()
+   : _node(NULL), _base(NULL), _offset(0), _numTerms(0), _size(0)
+   {
+   for (int32_t v = 0; v < MaxInductionVariables; v++)
+      _coefficients[v] = 0;
+   }
+
+bool
+TR_AffineAccess::isStore() const
+   {
+   return _node->getOpCode().isStore();
+   }
+
+bool
+TR_AffineAccess::hasSameBase(const TR_AffineAccess &other) const
+   {
+   if (_base != other._base || _numTerms != other._numTerms)
+      return false;
+
+   for (int32_t t = 0; t < _numTerms; t++)
+      {
+      bool found = false;
+      for (int32_t u = 0; u < other._numTerms && !found; u++)
+         found = _termSymRefs[t] == other._termSymRefs[u] && _termScales[t] == other._termScales[u];
+
+      if (!found)
+         return false;
+      }
+
+   return true;
+   }
+
+TR_LoopDependence::TR_LoopDependence(TR::Compilation *comp, TR_BitVector *storedSymRefs)
+   : _comp(comp), _storedSymRefs(storedSymRefs)
+   {
+   for (int32_t v = 0; v < TR_AffineAccess::MaxInductionVariables; v++)
+      _inductionVariables[v] = NULL;
+   }
+
+bool
+TR_LoopDependence::isLoopInvariant(TR::Node *node)
+   {
+   if (node->getOpCode().isLoadConst())
+      return true;
+
+   if (node->getOpCode().isLoadVarDirect() && node->getSymbol()->isAutoOrParm())
+      return !_storedSymRefs->get(node->getSymbolReference()->getReferenceNumber());
+
+   return false;
+   }
+
+bool
+TR_LoopDependence::isInvariantExpression(TR::Node *node)
+   {
+   if (isLoopInvariant(node))
+      return true;
+
+   if (!isPureOperation(node))
+      return false;
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!isInvariantExpression(node->getChild(i)))
+         return false;
+      }
+
+   return true;
+   }
+
+bool
+TR_LoopDependence::isPureOperation(TR::Node *node)
+   {
+   TR::ILOpCode &op = node->getOpCode();
+   if (op.hasSymbolReference() || op.isCall())
+      return false;
+
+   if (!op.isArithmetic() && !op.isConversion() && !op.isBooleanCompare())
+      return false;
+
+   // Integral division traps on a zero divisor
+   if ((op.isDiv() || op.isRem()) && !node->getDataType().isFloatingPoint())
+      return false;
+
+   return true;
+   }
+
+/**
+ * The address must be a chain of `aladd`s whose innermost first child is an
+ * invariant `aload` and whose index children are sums of constants,
+ * induction variables and invariants scaled by constants.
+ */
+bool
+TR_LoopDependence::analyzeAccess(TR::Node *access, TR_AffineAccess *result)
+   {
+   TR::ILOpCode &op = access->getOpCode();
+   if (!op.isIndirect() || !(op.isLoadVar() || op.isStore()) || op.isWrtBar())
+      return false;
+
+   if (access->getSymbol()->isVolatile() || access->getDataType().isVector() || access->getDataType() == TR::Aggregate)
+      return false;
+
+   if (access->getNumChildren() != (op.isStore() ? 2 : 1))
+      return false;
+
+   *result = TR_AffineAccess();
+   result->_node = access;
+   result->_size = TR::DataType::getSize(access->getDataType());
+   if (result->_size <= 0 || !addOffset(result, access->getSymbolReference()->getOffset()))
+      return false;
+
+   TR::Node *address = access->getFirstChild();
+   while (address->getOpCodeValue() == TR::aladd)
+      {
+      if (!addLinearTerms(address->getSecondChild(), 1, result, 0))
+         return false;
+      address = address->getFirstChild();
+      }
+
+   if (address->getOpCodeValue() != TR::aload || !isLoopInvariant(address))
+      return false;
+
+   result->_base = address->getSymbolReference();
+   return true;
+   }
+
+bool
+TR_LoopDependence::addOffset(TR_AffineAccess *result, int64_t value)
+   {
+   if (!isSmall(value))
+      return false;
+
+   result->_offset += value;
+   return isSmall(result->_offset);
+   }
+
+bool
+TR_LoopDependence::addLinearTerms(TR::Node *node, int64_t scale, TR_AffineAccess *result, int32_t depth)
+   {
+   if (depth > MAX_AFFINE_DEPTH || !isSmall(scale))
+      return false;
+
+   switch (node->getOpCodeValue())
+      {
+      case TR::iconst:
+         return addOffset(result, scale * node->getInt());
+      case TR::lconst:
+         return isSmall(node->getLongInt()) && addOffset(result, scale * node->getLongInt());
+      case TR::i2l:
+         return addLinearTerms(node->getFirstChild(), scale, result, depth + 1);
+      case TR::iadd: case TR::ladd:
+         return addLinearTerms(node->getFirstChild(), scale, result, depth + 1) &&
+                addLinearTerms(node->getSecondChild(), scale, result, depth + 1);
+      case TR::isub: case TR::lsub:
+         return addLinearTerms(node->getFirstChild(), scale, result, depth + 1) &&
+                addLinearTerms(node->getSecondChild(), -scale, result, depth + 1);
+      case TR::ineg: case TR::lneg:
+         return addLinearTerms(node->getFirstChild(), -scale, result, depth + 1);
+      case TR::imul: case TR::lmul:
+         {
+         for (int32_t i = 0; i < 2; i++)
+            {
+            TR::Node *factor = node->getChild(i);
+            if (factor->getOpCodeValue() == TR::iconst || factor->getOpCodeValue() == TR::lconst)
+               {
+               int64_t value = factor->getOpCodeValue() == TR::iconst ? factor->getInt() : factor->getLongInt();
+               return isSmall(value) && addLinearTerms(node->getChild(1 - i), scale * value, result, depth + 1);
+               }
+            }
+         return false;
+         }
+      case TR::ishl: case TR::lshl:
+         {
+         TR::Node *shift = node->getSecondChild();
+         if (shift->getOpCodeValue() != TR::iconst || shift->getInt() < 0 || shift->getInt() > 30)
+            return false;
+         return addLinearTerms(node->getFirstChild(), scale * ((int64_t)1 << shift->getInt()), result, depth + 1);
+         }
+      case TR::iload: case TR::lload:
+         {
+         TR::SymbolReference *symRef = node->getSymbolReference();
+         for (int32_t v = 0; v < TR_AffineAccess::MaxInductionVariables; v++)
+            {
+            if (_inductionVariables[v] == symRef)
+               {
+               result->_coefficients[v] += scale;
+               return isSmall(result->_coefficients[v]);
+               }
+            }
+
+         if (!isLoopInvariant(node))
+            return false;
+
+         for (int32_t t = 0; t < result->_numTerms; t++)
+            {
+            if (result->_termSymRefs[t] == symRef)
+               {
+               result->_termScales[t] += scale;
+               return isSmall(result->_termScales[t]);
+               }
+            }
+
+         if (result->_numTerms == TR_AffineAccess::MaxTerms)
+            return false;
+
+         result->_termSymRefs[result->_numTerms] = symRef;
+         result->_termScales[result->_numTerms] = scale;
+         result->_numTerms++;
+         return true;
+         }
+      default:
+         return false;
+      }
+   }
+
+bool
+TR_LoopDependence::mayOverlap(int64_t distance, int64_t step, int64_t minMultiple, int64_t maxMultiple, int32_t firstSize, int32_t secondSize)
+   {
+   if (minMultiple > maxMultiple)
+      return false;
+
+   // The accesses overlap when -firstSize < distance + step * t < secondSize
+   int64_t low = -(int64_t)firstSize - distance;
+   int64_t high = (int64_t)secondSize - distance;
+   if (step == 0)
+      return low < 0 && 0 < high;
+
+   if (step < 0)
+      {
+      step = -step;
+      int64_t minimum = -maxMultiple;
+      maxMultiple = -minMultiple;
+      minMultiple = minimum;
+      }
+
+   // Smallest t with step * t > low, rounding the quotient towards minus infinity
+   int64_t quotient = low / step;
+   if (low % step != 0 && low < 0)
+      quotient--;
+   int64_t t = quotient + 1;
+   if (t < minMultiple)
+      t = minMultiple;
+
+   return t <= maxMultiple && step * t < high;
+   }
+
+TR::Node *
+TR_LoopDependence::createAddressBound(TR_AffineAccess *access, TR::Node **lowValues, TR::Node **highValues, bool upper)
+   {
+   TR::Node *node = access->_node;
+   TR::Node *bound = TR::Node::create(TR::a2l, 1, TR::Node::createLoad(node, access->_base));
+
+   int64_t offset = access->_offset + (upper ? access->_size : 0);
+   if (offset != 0)
+      bound = TR::Node::create(TR::ladd, 2, bound, TR::Node::lconst(node, offset));
+
+   for (int32_t t = 0; t < access->_numTerms; t++)
+      {
+      TR::Node *term = TR::Node::createLoad(node, access->_termSymRefs[t]);
+      if (term->getDataType() != TR::Int64)
+         term = TR::Node::create(TR::i2l, 1, term);
+      bound = TR::Node::create(TR::ladd, 2, bound,
+         TR::Node::create(TR::lmul, 2, term, TR::Node::lconst(node, access->_termScales[t])));
+      }
+
+   for (int32_t v = 0; v < TR_AffineAccess::MaxInductionVariables; v++)
+      {
+      int64_t coefficient = access->_coefficients[v];
+      if (coefficient == 0)
+         continue;
+
+      TR::Node *value = ((coefficient > 0) == upper) ? highValues[v] : lowValues[v];
+      bound = TR::Node::create(TR::ladd, 2, bound,
+         TR::Node::create(TR::lmul, 2, value->duplicateTree(), TR::Node::lconst(node, coefficient)));
+      }
+
+   return bound;
+   }
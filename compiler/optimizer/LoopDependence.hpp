@@ -0,0 +1,145 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef LOOPDEPENDENCE_INCL
+#define LOOPDEPENDENCE_INCL
+
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+
+// Bound on the multiples passed to TR_LoopDependence::mayOverlap that stands
+// for an unbounded range of iterations
+#define LOOP_DEPENDENCE_UNBOUNDED ((int64_t)1 << 32)
+
+class TR_BitVector;
+namespace TR { class Compilation; }
+namespace TR { class Node; }
+namespace TR { class SymbolReference; }
+
+/**
+ * An indirect load or store whose address is an affine function of the
+ * induction variables of a loop nest:
+ *
+ *    base + offset + sum(coefficient[v] * iv[v]) + sum(scale[t] * term[t])
+ *
+ * `base` is a loop invariant address, the coefficients, scales and offset
+ * are byte counts and each term is a loop invariant integral auto or parm.
+ * Index arithmetic is assumed not to wrap, as it does not for in-bounds
+ * array indexing.
+ */
+struct TR_AffineAccess
+   {
+   TR_ALLOC(TR_Memory::LoopTransformer)
+
+   enum
+      {
+      MaxInductionVariables = 2,
+      MaxTerms = 4
+      };
+
+   TR_AffineAccess();
+
+   bool isStore() const;
+
+   /**
+    * Both accesses address the same array: the same base and the same
+    * invariant terms, so that they differ only by their offsets and
+    * induction variable coefficients.
+    */
+   bool hasSameBase(const TR_AffineAccess &other) const;
+
+   TR::Node *_node;
+   TR::SymbolReference *_base;
+   int64_t _offset;
+   int64_t _coefficients[MaxInductionVariables];
+   int32_t _numTerms;
+   TR::SymbolReference *_termSymRefs[MaxTerms];
+   int64_t _termScales[MaxTerms];
+   int32_t _size;
+   };
+
+/**
+ * Class TR_LoopDependence
+ * =======================
+ *
+ * Recognizes affine array accesses in a loop nest and answers the
+ * dependence questions the loop transformations ask about them. A symbol
+ * is loop invariant when the bit vector passed in does not record a store
+ * to it inside the nest.
+ */
+class TR_LoopDependence
+   {
+   public:
+   TR_ALLOC(TR_Memory::LoopTransformer)
+
+   TR_LoopDependence(TR::Compilation *comp, TR_BitVector *storedSymRefs);
+
+   void setInductionVariable(int32_t index, TR::SymbolReference *symRef) { _inductionVariables[index] = symRef; }
+
+   /**
+    * Fill in \p result for an indirect load or store of a scalar, or return
+    * false when its address is not affine in the induction variables.
+    */
+   bool analyzeAccess(TR::Node *access, TR_AffineAccess *result);
+
+   /**
+    * Loads of autos and parms that are never stored in the nest, and
+    * constants
+    */
+   bool isLoopInvariant(TR::Node *node);
+
+   /**
+    * An expression over loop invariant leaves that is safe to evaluate
+    * again anywhere in the nest
+    */
+   bool isInvariantExpression(TR::Node *node);
+
+   /**
+    * Arithmetic, conversions and compares that have no side effects and
+    * cannot raise an exception
+    */
+   static bool isPureOperation(TR::Node *node);
+
+   /**
+    * Return true when some `t` in `[minMultiple, maxMultiple]` makes
+    * `distance + step * t` lie strictly between `-firstSize` and `secondSize`,
+    * that is when an access of \p firstSize bytes at address `x` overlaps an
+    * access of \p secondSize bytes at `x + distance + step * t`.
+    */
+   static bool mayOverlap(int64_t distance, int64_t step, int64_t minMultiple, int64_t maxMultiple, int32_t firstSize, int32_t secondSize);
+
+   /**
+    * Create a 64-bit expression for the lowest address an access touches,
+    * or one past the highest when \p upper, given each induction variable's
+    * lowest and highest 64-bit value.
+    */
+   TR::Node *createAddressBound(TR_AffineAccess *access, TR::Node **lowValues, TR::Node **highValues, bool upper);
+
+   private:
+   bool addLinearTerms(TR::Node *node, int64_t scale, TR_AffineAccess *result, int32_t depth);
+   bool addOffset(TR_AffineAccess *result, int64_t value);
+
+   TR::Compilation *_comp;
+   TR_BitVector *_storedSymRefs;
+   TR::SymbolReference *_inductionVariables[TR_AffineAccess::MaxInductionVariables];
+   };
+
+#endif
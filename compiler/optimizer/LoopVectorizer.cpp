@@ -0,0 +1,946 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/LoopVectorizer.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Assert.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/Checklist.hpp"
+#include "infra/List.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/Structure.hpp"
+#include "ras/Debug.hpp"
+
+#define OPT_DETAILS "O^O LOOP VECTORIZER: "
+
+// Upper bound on the runtime overlap checks emitted in front of a single loop
+#define MAX_OVERLAP_CHECKS 6
+
+TR_LoopVectorizer::TR_LoopVectorizer(TR::OptimizationManager *manager)
+   : TR_LoopTransformer(manager),
+     _loopInfos(trMemory()),
+     _storedSymRefs(NULL)
+   {}
+
+bool
+TR_LoopVectorizer::shouldPerform()
+   {
+   if (comp()->getOption(TR_DisableAutoSIMD))
+      return false;
+
+   if (!comp()->cg()->getSupportsAutoSIMD())
+      return false;
+
+   // The overlap checks and trip counts are computed on 64-bit values
+   if (!comp()->target().is64Bit())
+      return false;
+
+   return comp()->mayHaveLoops();
+   }
+
+int32_t
+TR_LoopVectorizer::perform()
+   {
+   _cfg = comp()->getFlowGraph();
+   TR_Structure *rootStructure = _cfg->getStructure();
+   if (!rootStructure)
+      return 0;
+
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   _loopInfos.deleteAll();
+   _storedSymRefs = new (trStackMemory()) TR_BitVector(comp()->getSymRefTab()->getNumSymRefs(), trMemory(), stackAlloc, growable);
+
+   if (trace())
+      {
+      traceMsg(comp(), "Starting LoopVectorizer\n");
+      comp()->dumpMethodTrees("Trees before LoopVectorizer");
+      }
+
+   collectLoops(rootStructure);
+
+   int32_t numVectorized = 0;
+   ListIterator<LoopInfo> it(&_loopInfos);
+   for (LoopInfo *li = it.getFirst(); li; li = it.getNext())
+      {
+      if (!performTransformation(comp(), "%sVectorizing loop %d by %d elements of type %s\n", OPT_DETAILS,
+            li->_header->getNumber(), li->_vectorLength, TR::DataType::getName(li->_elementType)))
+         continue;
+
+      // The analysis is done, and the new blocks are not part of the structure
+      _cfg->setStructure(NULL);
+      transformLoop(li);
+      numVectorized++;
+      }
+
+   if (numVectorized > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      }
+
+   if (trace())
+      {
+      comp()->dumpMethodTrees("Trees after LoopVectorizer");
+      traceMsg(comp(), "Ending LoopVectorizer, vectorized %d loops\n", numVectorized);
+      }
+
+   return numVectorized;
+   }
+
+const char *
+TR_LoopVectorizer::optDetailString() const throw()
+   {
+   return "O^O LOOP VECTORIZER: ";
+   }
+
+void
+TR_LoopVectorizer::collectLoops(TR_Structure *str)
+   {
+   TR_RegionStructure *region = str->asRegion();
+   if (!region)
+      return;
+
+   bool isInnermost = true;
+   TR_RegionStructure::Cursor it(*region);
+   for (TR_StructureSubGraphNode *node = it.getCurrent(); node; node = it.getNext())
+      {
+      if (node->getStructure()->asRegion())
+         {
+         isInnermost = false;
+         collectLoops(node->getStructure());
+         }
+      }
+
+   if (!isInnermost || !region->isNaturalLoop())
+      return;
+
+   LoopInfo *li = new (trStackMemory()) LoopInfo(trMemory());
+   li->_region = region;
+   li->_header = region->getEntryBlock();
+
+   if (li->_header->isCold())
+      {
+      if (trace())
+         traceMsg(comp(), "Loop %d is cold\n", li->_header->getNumber());
+      return;
+      }
+
+   if (analyzeLoop(li))
+      {
+      if (trace())
+         traceMsg(comp(), "Loop %d is a vectorization candidate\n", li->_header->getNumber());
+      _loopInfos.add(li);
+      }
+   }
+
+bool
+TR_LoopVectorizer::analyzeLoop(LoopInfo *li)
+   {
+   if (!collectLoopChain(li))
+      return false;
+
+   if (!analyzeEntryEdges(li))
+      return false;
+
+   TR_ScratchList<TR::Block> blocks(trMemory());
+   li->_region->getBlocks(&blocks);
+
+   // Find every symbol written inside the loop to decide invariance
+   _storedSymRefs->empty();
+   TR::NodeChecklist storeVisited(comp());
+   ListIterator<TR::Block> bi(&blocks);
+   for (TR::Block *block = bi.getFirst(); block; block = bi.getNext())
+      {
+      for (TR::TreeTop *tt = block->getFirstRealTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+         collectStoredSymbols(tt->getNode(), storeVisited);
+      }
+
+   TR::TreeTop *branchTree = li->_latch->getLastRealTreeTop();
+   TR::TreeTop *ivStoreTree = branchTree->getPrevTreeTop();
+   if (!analyzeLatch(li, branchTree, ivStoreTree))
+      return false;
+
+   // Everything but the latch's induction variable update and back edge must
+   // be an array store or a reduction
+   TR::NodeChecklist visited(comp());
+   ListAppender<TR::TreeTop> bodyTrees(&li->_bodyTrees);
+   for (TR::Block *block = li->_header; ; block = block->getSuccessors().front()->getTo()->asBlock())
+      {
+      for (TR::TreeTop *tt = block->getFirstRealTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+         {
+         if (tt == ivStoreTree)
+            break;
+
+         TR::Node *node = tt->getNode();
+         if (node->getOpCodeValue() == TR::Goto)
+            continue;
+
+         if (!analyzeBodyTree(li, node, visited))
+            {
+            if (trace())
+               traceMsg(comp(), "Loop %d: cannot vectorize tree n%dn (%s)\n", li->_header->getNumber(),
+                  node->getGlobalIndex(), node->getOpCode().getName());
+            return false;
+            }
+
+         bodyTrees.add(tt);
+         }
+
+      if (block == li->_latch)
+         break;
+      }
+
+   if (li->_bodyTrees.isEmpty() || li->_elementType == TR::NoType)
+      return false;
+
+   li->_vectorLength = TR::DataType::getVectorSize(li->_length) / TR::DataType::getSize(li->_elementType);
+
+   // A reduction accumulator must not be read anywhere but in its own update
+   ListIterator<TR::Node> ri(&li->_reductions);
+   for (TR::Node *store = ri.getFirst(); store; store = ri.getNext())
+      {
+      int32_t numLoads = 0;
+      TR::NodeChecklist loadVisited(comp());
+      for (TR::Block *block = bi.getFirst(); block; block = bi.getNext())
+         {
+         for (TR::TreeTop *tt = block->getFirstRealTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+            numLoads += countLoads(tt->getNode(), store->getSymbolReference(), loadVisited);
+         }
+
+      if (numLoads != 1)
+         {
+         if (trace())
+            traceMsg(comp(), "Loop %d: accumulator #%d is used outside its reduction\n", li->_header->getNumber(),
+               store->getSymbolReference()->getReferenceNumber());
+         return false;
+         }
+      }
+
+   return collectOverlapChecks(li);
+   }
+
+/**
+ * The loop must be a straight chain of blocks starting at the header and
+ * ending in the latch, without exception edges, so that the trees of the
+ * chain execute exactly once per iteration in order.
+ */
+bool
+TR_LoopVectorizer::collectLoopChain(LoopInfo *li)
+   {
+   TR_ScratchList<TR::Block> blocks(trMemory());
+   li->_region->getBlocks(&blocks);
+
+   int32_t numBlocks = 0;
+   TR::Block *block = li->_header;
+   while (true)
+      {
+      if (block->hasExceptionSuccessors() || block->hasExceptionPredecessors())
+         return false;
+
+      if (!blocks.find(block))
+         return false;
+
+      if (block != li->_header && block->getPredecessors().size() != 1)
+         return false;
+
+      if (++numBlocks > blocks.getSize())
+         return false;
+
+      if (block->hasSuccessor(li->_header))
+         break;
+
+      if (block->getSuccessors().size() != 1)
+         return false;
+
+      block = block->getSuccessors().front()->getTo()->asBlock();
+      if (!block || block == li->_header)
+         return false;
+      }
+
+   if (numBlocks != blocks.getSize())
+      return false;
+
+   li->_latch = block;
+   return true;
+   }
+
+bool
+TR_LoopVectorizer::analyzeLatch(LoopInfo *li, TR::TreeTop *branchTree, TR::TreeTop *ivStoreTree)
+   {
+   TR::Node *branch = branchTree->getNode();
+   if (branch->getOpCodeValue() != TR::ificmplt && branch->getOpCodeValue() != TR::ificmple)
+      return false;
+
+   if (branch->getNumChildren() != 2 || branch->getBranchDestination() != li->_header->getEntry())
+      return false;
+
+   TR::Node *ivStore = ivStoreTree->getNode();
+   if (ivStore->getOpCodeValue() != TR::istore || !ivStore->getSymbol()->isAutoOrParm())
+      return false;
+
+   TR::SymbolReference *ivSymRef = ivStore->getSymbolReference();
+   TR::Node *increment = ivStore->getFirstChild();
+   if (increment->getOpCodeValue() != TR::iadd ||
+       increment->getFirstChild()->getOpCodeValue() != TR::iload ||
+       increment->getFirstChild()->getSymbolReference() != ivSymRef ||
+       increment->getSecondChild()->getOpCodeValue() != TR::iconst ||
+       increment->getSecondChild()->getInt() != 1)
+      return false;
+
+   TR::Node *compared = branch->getFirstChild();
+   if (compared != increment &&
+       !(compared->getOpCodeValue() == TR::iload && compared->getSymbolReference() == ivSymRef && compared->getReferenceCount() == 1))
+      return false;
+
+   li->_ivStoreTree = ivStoreTree;
+   li->_ivSymRef = ivSymRef;
+
+   TR::Node *bound = branch->getSecondChild();
+   if (!isLoopInvariant(bound))
+      return false;
+
+   li->_bound = bound;
+   li->_inclusiveBound = branch->getOpCodeValue() == TR::ificmple;
+
+   // The loop must leave by falling through into a block the epilogue can branch to
+   TR::Block *exit = li->_latch->getNextBlock();
+   if (!exit || exit->isExtensionOfPreviousBlock() || li->_latch->getSuccessors().size() != 2 || !li->_latch->hasSuccessor(exit))
+      return false;
+
+   li->_exit = exit;
+   return true;
+   }
+
+/**
+ * Every edge into the header from outside the loop is redirected to the
+ * new trip count guard, so each of them must be a plain fall-through or
+ * a branch whose destination can be changed.
+ */
+bool
+TR_LoopVectorizer::analyzeEntryEdges(LoopInfo *li)
+   {
+   TR::Block *header = li->_header;
+   if (!header->getEntry()->getPrevTreeTop())
+      return false;
+
+   int32_t numEntries = 0;
+   for (auto edge = header->getPredecessors().begin(); edge != header->getPredecessors().end(); ++edge)
+      {
+      TR::Block *pred = (*edge)->getFrom()->asBlock();
+      if (pred == li->_latch)
+         continue;
+
+      if (!pred->getEntry())
+         return false;
+
+      TR::Node *lastNode = pred->getLastRealTreeTop()->getNode();
+      if (lastNode->getOpCode().isSwitch() || lastNode->getOpCode().isJumpWithMultipleTargets())
+         return false;
+
+      bool branchesToHeader = lastNode->getOpCode().isBranch() && lastNode->getBranchDestination() == header->getEntry();
+      bool fallsIntoHeader = pred->getExit()->getNextTreeTop() == header->getEntry();
+      if (branchesToHeader == fallsIntoHeader)
+         return false;
+
+      numEntries++;
+      }
+
+   return numEntries > 0;
+   }
+
+bool
+TR_LoopVectorizer::analyzeBodyTree(LoopInfo *li, TR::Node *node, TR::NodeChecklist &visited)
+   {
+   if (node->getOpCode().isStoreIndirect())
+      {
+      if (node->getOpCode().isWrtBar() || node->getNumChildren() != 2 || node->getSymbol()->isVolatile())
+         return false;
+
+      if (!setElementType(li, node->getDataType()))
+         return false;
+
+      if (!isUnitStrideAddress(li, node->getFirstChild()) ||
+          !isVectorizableExpression(li, node->getSecondChild(), visited))
+         return false;
+
+      li->_accesses.add(node);
+      return true;
+      }
+
+   if (node->getOpCode().isStoreDirect())
+      {
+      // Sum reductions are limited to integral types since reassociating
+      // floating point additions changes the result
+      TR::DataType dt = node->getDataType();
+      if (dt != TR::Int32 && dt != TR::Int64)
+         return false;
+
+      TR::SymbolReference *accSymRef = node->getSymbolReference();
+      if (!node->getSymbol()->isAutoOrParm() || accSymRef == li->_ivSymRef)
+         return false;
+
+      TR::Node *value = node->getFirstChild();
+      if (value->getOpCodeValue() != (dt == TR::Int32 ? TR::iadd : TR::ladd))
+         return false;
+
+      int32_t accIndex = -1;
+      for (int32_t i = 0; i < 2; i++)
+         {
+         TR::Node *child = value->getChild(i);
+         if (child->getOpCode().isLoadVarDirect() && child->getSymbolReference() == accSymRef && child->getReferenceCount() == 1)
+            accIndex = i;
+         }
+
+      if (accIndex < 0 || value->getReferenceCount() != 1)
+         return false;
+
+      if (!setElementType(li, dt) ||
+          !supportsVectorOp(li, TR::vload, dt) ||
+          !supportsVectorOp(li, TR::vstore, dt) ||
+          !supportsVectorOp(li, TR::vadd, dt) ||
+          !supportsVectorOp(li, TR::getvelem, dt))
+         return false;
+
+      if (!isVectorizableExpression(li, value->getChild(1 - accIndex), visited))
+         return false;
+
+      li->_reductions.add(node);
+      return true;
+      }
+
+   return false;
+   }
+
+bool
+TR_LoopVectorizer::setElementType(LoopInfo *li, TR::DataType dt)
+   {
+   if (li->_elementType != TR::NoType)
+      return li->_elementType == dt;
+
+   if (dt != TR::Int32 && dt != TR::Int64 && dt != TR::Float && dt != TR::Double)
+      return false;
+
+   if (!supportsVectorOp(li, TR::vloadi, dt) || !supportsVectorOp(li, TR::vstorei, dt))
+      return false;
+
+   li->_elementType = dt;
+   return true;
+   }
+
+/**
+ * Checks that the code generator supports a vector operation and narrows the
+ * loop's vector length to the widest one that supports every operation seen so far.
+ */
+bool
+TR_LoopVectorizer::supportsVectorOp(LoopInfo *li, TR::ILOpCodes op, TR::DataType dt)
+   {
+   if (!comp()->cg()->getSupportsVectorLengthForAutoSIMD(TR::VectorLength128, TR::ILOpCode(op), dt))
+      return false;
+
+   while (li->_length != TR::VectorLength128 &&
+          !comp()->cg()->getSupportsVectorLengthForAutoSIMD(li->_length, TR::ILOpCode(op), dt))
+      li->_length = (TR::VectorLength)(li->_length - 1);
+
+   return true;
+   }
+
+TR::ILOpCodes
+TR_LoopVectorizer::vectorOpFor(TR::Node *node)
+   {
+   switch (node->getOpCodeValue())
+      {
+      case TR::iadd: case TR::ladd: case TR::fadd: case TR::dadd:
+         return TR::vadd;
+      case TR::isub: case TR::lsub: case TR::fsub: case TR::dsub:
+         return TR::vsub;
+      case TR::imul: case TR::lmul: case TR::fmul: case TR::dmul:
+         return TR::vmul;
+      case TR::fdiv: case TR::ddiv:
+         return TR::vdiv;
+      case TR::iand: case TR::land:
+         return TR::vand;
+      case TR::ior: case TR::lor:
+         return TR::vor;
+      case TR::ixor: case TR::lxor:
+         return TR::vxor;
+      default:
+         return TR::BadILOp;
+      }
+   }
+
+bool
+TR_LoopVectorizer::isLoopInvariant(TR::Node *node)
+   {
+   if (node->getOpCode().isLoadConst())
+      return true;
+
+   if (node->getOpCode().isLoadVarDirect() && node->getSymbol()->isAutoOrParm())
+      return !_storedSymRefs->get(node->getSymbolReference()->getReferenceNumber());
+
+   return false;
+   }
+
+/**
+ * Recognize `aladd (aload base) (lmul (i2l (iload i)) (lconst size))`, or
+ * the equivalent lshl, where `base` is loop invariant and `size` is the
+ * element size.
+ */
+bool
+TR_LoopVectorizer::isUnitStrideAddress(LoopInfo *li, TR::Node *address)
+   {
+   if (address->getOpCodeValue() != TR::aladd)
+      return false;
+
+   TR::Node *base = address->getFirstChild();
+   if (base->getOpCodeValue() != TR::aload || !isLoopInvariant(base))
+      return false;
+
+   TR::Node *index = address->getSecondChild();
+   TR::Node *scale = index->getNumChildren() == 2 ? index->getSecondChild() : NULL;
+   int32_t size = TR::DataType::getSize(li->_elementType);
+   if (index->getOpCodeValue() == TR::lmul)
+      {
+      if (scale->getOpCodeValue() != TR::lconst || scale->getLongInt() != size)
+         return false;
+      }
+   else if (index->getOpCodeValue() == TR::lshl)
+      {
+      if (scale->getOpCodeValue() != TR::iconst || scale->getInt() < 0 || scale->getInt() > 3 || (1 << scale->getInt()) != size)
+         return false;
+      }
+   else
+      {
+      return false;
+      }
+
+   TR::Node *iv = index->getFirstChild();
+   if (iv->getOpCodeValue() != TR::i2l)
+      return false;
+
+   iv = iv->getFirstChild();
+   return iv->getOpCodeValue() == TR::iload && iv->getSymbolReference() == li->_ivSymRef;
+   }
+
+bool
+TR_LoopVectorizer::isVectorizableExpression(LoopInfo *li, TR::Node *node, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return true;
+   visited.add(node);
+
+   TR::DataType dt = li->_elementType;
+   if (node->getDataType() != dt)
+      return false;
+
+   if (node->getOpCode().isLoadIndirect())
+      {
+      if (node->getSymbol()->isVolatile() || node->getNumChildren() != 1 || !isUnitStrideAddress(li, node->getFirstChild()))
+         return false;
+
+      li->_accesses.add(node);
+      return true;
+      }
+
+   if (isLoopInvariant(node))
+      return supportsVectorOp(li, TR::vsplats, dt);
+
+   TR::ILOpCodes op = vectorOpFor(node);
+   if (op == TR::BadILOp || node->getNumChildren() != 2 || !supportsVectorOp(li, op, dt))
+      return false;
+
+   return isVectorizableExpression(li, node->getFirstChild(), visited) &&
+          isVectorizableExpression(li, node->getSecondChild(), visited);
+   }
+
+bool
+TR_LoopVectorizer::isSameArray(TR::Node *first, TR::Node *second)
+   {
+   return first->getFirstChild()->getFirstChild()->getSymbolReference() == second->getFirstChild()->getFirstChild()->getSymbolReference() &&
+          first->getSymbolReference()->getOffset() == second->getSymbolReference()->getOffset();
+   }
+
+/**
+ * Pair every stored array with every other array accessed in the loop.
+ * Accesses of the same base and offset touch the same element in each
+ * iteration and need no check.
+ */
+bool
+TR_LoopVectorizer::collectOverlapChecks(LoopInfo *li)
+   {
+   int32_t numChecks = 0;
+   ListAppender<TR::Node> overlapChecks(&li->_overlapChecks);
+   ListIterator<TR::Node> si(&li->_accesses);
+   for (TR::Node *store = si.getFirst(); store; store = si.getNext())
+      {
+      if (!store->getOpCode().isStore())
+         continue;
+
+      ListIterator<TR::Node> ai(&li->_accesses);
+      for (TR::Node *access = ai.getFirst(); access; access = ai.getNext())
+         {
+         if (isSameArray(store, access))
+            continue;
+
+         bool isChecked = false;
+         ListIterator<TR::Node> ci(&li->_overlapChecks);
+         for (TR::Node *first = ci.getFirst(); first && !isChecked; first = ci.getNext())
+            {
+            TR::Node *second = ci.getNext();
+            isChecked = (isSameArray(first, store) && isSameArray(second, access)) ||
+                        (isSameArray(first, access) && isSameArray(second, store));
+            }
+
+         if (isChecked)
+            continue;
+
+         if (++numChecks > MAX_OVERLAP_CHECKS)
+            {
+            if (trace())
+               traceMsg(comp(), "Loop %d: too many overlap checks\n", li->_header->getNumber());
+            return false;
+            }
+
+         overlapChecks.add(store);
+         overlapChecks.add(access);
+         }
+      }
+
+   return true;
+   }
+
+void
+TR_LoopVectorizer::collectStoredSymbols(TR::Node *node, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return;
+   visited.add(node);
+
+   if (node->getOpCode().isStoreDirect())
+      _storedSymRefs->set(node->getSymbolReference()->getReferenceNumber());
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      collectStoredSymbols(node->getChild(i), visited);
+   }
+
+int32_t
+TR_LoopVectorizer::countLoads(TR::Node *node, TR::SymbolReference *symRef, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return 0;
+   visited.add(node);
+
+   int32_t numLoads = (node->getOpCode().isLoadVarDirect() && node->getSymbolReference() == symRef) ? 1 : 0;
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      numLoads += countLoads(node->getChild(i), symRef, visited);
+
+   return numLoads;
+   }
+
+/**
+ * Insert the guard, overlap check, vector loop and epilogue blocks between
+ * the loop's entry edges and its header. The original loop is left as is
+ * and runs the remaining iterations.
+ */
+void
+TR_LoopVectorizer::transformLoop(LoopInfo *li)
+   {
+   TR::Block *header = li->_header;
+   TR::Node *bcNode = header->getEntry()->getNode();
+   TR::DataType dt = li->_elementType;
+   TR::SymbolReference *vectorShadow = comp()->getSymRefTab()->findOrCreateArrayShadowSymbolRef(dt.scalarToVector(li->_length), NULL);
+
+   TR_ScratchList<TR::Block> entryBlocks(trMemory());
+   int32_t entryFrequency = 0;
+   for (auto edge = header->getPredecessors().begin(); edge != header->getPredecessors().end(); ++edge)
+      {
+      TR::Block *pred = (*edge)->getFrom()->asBlock();
+      if (pred == li->_latch)
+         continue;
+
+      entryBlocks.add(pred);
+      if (pred->getFrequency() > entryFrequency)
+         entryFrequency = pred->getFrequency();
+      }
+
+   // Blocks are created in layout order in front of the header
+   TR::Block *guardBlock = createBlockBefore(header, bcNode, entryFrequency);
+   TR_ScratchList<TR::Block> checkBlocks(trMemory());
+   ListAppender<TR::Block> checkBlocksAppender(&checkBlocks);
+   for (int32_t i = li->_overlapChecks.getSize() / 2; i > 0; i--)
+      checkBlocksAppender.add(createBlockBefore(header, bcNode, entryFrequency));
+   TR::Block *vectorBlock = createBlockBefore(header, bcNode, header->getFrequency());
+   TR::Block *epilogueBlock = createBlockBefore(header, bcNode, entryFrequency);
+
+   // Trip count guard, which also zeroes the reduction accumulators
+   SymRefMap vectorTemps(std::less<TR::SymbolReference *>(), comp()->trMemory()->currentStackRegion());
+   ListIterator<TR::Node> ri(&li->_reductions);
+   for (TR::Node *store = ri.getFirst(); store; store = ri.getNext())
+      {
+      TR::SymbolReference *vectorTemp = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), dt.scalarToVector(li->_length));
+      vectorTemps[store->getSymbolReference()] = vectorTemp;
+      TR::Node *zero = TR::Node::create(TR::vsplats, 1, TR::Node::createConstZeroValue(bcNode, dt));
+      zero->setDataType(dt.scalarToVector(li->_length));
+      guardBlock->append(TR::TreeTop::create(comp(), TR::Node::createStore(vectorTemp, zero)));
+      }
+
+   guardBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::iflcmplt, createRemainingIterations(li), TR::Node::lconst(bcNode, li->_vectorLength), header->getEntry())));
+
+   // Fall back to the scalar loop when a stored array is within one vector of another array
+   ListIterator<TR::Block> cbi(&checkBlocks);
+   ListIterator<TR::Node> ci(&li->_overlapChecks);
+   TR::Node *first = ci.getFirst();
+   for (TR::Block *checkBlock = cbi.getFirst(); checkBlock; checkBlock = cbi.getNext(), first = ci.getNext())
+      {
+      TR::Node *second = ci.getNext();
+      TR::Node *distance = TR::Node::create(TR::lsub, 2, createAccessStart(first), createAccessStart(second));
+      TR::Node *check = TR::Node::create(TR::lsub, 2, TR::Node::create(TR::labs, 1, distance), TR::Node::lconst(bcNode, 1));
+      checkBlock->append(TR::TreeTop::create(comp(),
+         TR::Node::createif(TR::iflucmplt, check, TR::Node::lconst(bcNode, TR::DataType::getVectorSize(li->_length) - 1), header->getEntry())));
+      }
+
+   // Vector loop
+   NodeMap scalarMap(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+   NodeMap vectorMap(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+   ListIterator<TR::TreeTop> ti(&li->_bodyTrees);
+   for (TR::TreeTop *tt = ti.getFirst(); tt; tt = ti.getNext())
+      {
+      TR::Node *node = tt->getNode();
+      TR::Node *vectorNode = NULL;
+      if (node->getOpCode().isStoreIndirect())
+         {
+         vectorNode = TR::Node::createWithSymRef(TR::vstorei, 2, 2,
+            createVectorAddress(node, scalarMap),
+            vectorizeExpression(vectorShadow, node->getSecondChild(), scalarMap, vectorMap),
+            vectorShadow);
+         }
+      else
+         {
+         TR::SymbolReference *vectorTemp = vectorTemps[node->getSymbolReference()];
+         TR::Node *value = node->getFirstChild();
+         TR::Node *expr = value->getFirstChild();
+         if (expr->getOpCode().isLoadVarDirect() && expr->getSymbolReference() == node->getSymbolReference())
+            expr = value->getSecondChild();
+         TR::Node *sum = TR::Node::create(TR::vadd, 2,
+            TR::Node::createLoad(bcNode, vectorTemp),
+            vectorizeExpression(vectorShadow, expr, scalarMap, vectorMap));
+         vectorNode = TR::Node::createStore(vectorTemp, sum);
+         }
+
+      vectorBlock->append(TR::TreeTop::create(comp(), vectorNode));
+      }
+
+   TR::Node *increment = TR::Node::create(TR::iadd, 2,
+      TR::Node::createLoad(bcNode, li->_ivSymRef),
+      TR::Node::iconst(bcNode, li->_vectorLength));
+   vectorBlock->append(TR::TreeTop::create(comp(), TR::Node::createStore(li->_ivSymRef, increment)));
+   vectorBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::iflcmpge, createRemainingIterations(li), TR::Node::lconst(bcNode, li->_vectorLength), vectorBlock->getEntry())));
+
+   // Epilogue: fold the accumulators and leave, or run the remainder in the scalar loop
+   for (TR::Node *store = ri.getFirst(); store; store = ri.getNext())
+      {
+      TR::SymbolReference *accSymRef = store->getSymbolReference();
+      TR::Node *sum = TR::Node::create(dt == TR::Int32 ? TR::iadd : TR::ladd, 2,
+         TR::Node::createLoad(bcNode, accSymRef),
+         createHorizontalSum(li, vectorTemps[accSymRef]));
+      epilogueBlock->append(TR::TreeTop::create(comp(), TR::Node::createStore(accSymRef, sum)));
+      }
+
+   epilogueBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(li->_inclusiveBound ? TR::ificmpgt : TR::ificmpge,
+         TR::Node::createLoad(bcNode, li->_ivSymRef),
+         li->_bound->duplicateTree(),
+         li->_exit->getEntry())));
+
+   // Wire up the new blocks before moving the entry edges so the header stays reachable
+   TR::Block *next = vectorBlock;
+   if (!checkBlocks.isEmpty())
+      next = checkBlocks.getListHead()->getData();
+   _cfg->addEdge(guardBlock, next);
+   _cfg->addEdge(guardBlock, header);
+
+   for (TR::Block *checkBlock = cbi.getFirst(); checkBlock; checkBlock = cbi.getNext())
+      {
+      _cfg->addEdge(checkBlock, checkBlock->getNextBlock());
+      _cfg->addEdge(checkBlock, header);
+      }
+
+   _cfg->addEdge(vectorBlock, vectorBlock);
+   _cfg->addEdge(vectorBlock, epilogueBlock);
+   _cfg->addEdge(epilogueBlock, li->_exit);
+   _cfg->addEdge(epilogueBlock, header);
+
+   ListIterator<TR::Block> ei(&entryBlocks);
+   for (TR::Block *pred = ei.getFirst(); pred; pred = ei.getNext())
+      {
+      TR::Node *lastNode = pred->getLastRealTreeTop()->getNode();
+      if (lastNode->getOpCode().isBranch() && lastNode->getBranchDestination() == header->getEntry())
+         {
+         pred->changeBranchDestination(guardBlock->getEntry(), _cfg);
+         }
+      else
+         {
+         _cfg->addEdge(pred, guardBlock);
+         _cfg->removeEdge(pred, header);
+         }
+      }
+   }
+
+TR::Block *
+TR_LoopVectorizer::createBlockBefore(TR::Block *next, TR::Node *bcNode, int32_t frequency)
+   {
+   TR::Block *block = TR::Block::createEmptyBlock(bcNode, comp(), frequency, next);
+   _cfg->addNode(block);
+
+   TR::TreeTop *prevTree = next->getEntry()->getPrevTreeTop();
+   prevTree->join(block->getEntry());
+   block->getExit()->join(next->getEntry());
+   return block;
+   }
+
+/**
+ * Copy a scalar tree for use in the vector loop, preserving commoning
+ * between all the trees copied into the same block.
+ */
+TR::Node *
+TR_LoopVectorizer::duplicateScalar(TR::Node *node, NodeMap &map)
+   {
+   NodeMap::iterator found = map.find(node);
+   if (found != map.end())
+      return found->second;
+
+   TR::Node *copy = TR::Node::copy(node);
+   copy->setReferenceCount(0);
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      copy->setAndIncChild(i, duplicateScalar(node->getChild(i), map));
+
+   map[node] = copy;
+   return copy;
+   }
+
+TR::Node *
+TR_LoopVectorizer::vectorizeExpression(TR::SymbolReference *vectorShadow, TR::Node *node, NodeMap &scalarMap, NodeMap &vectorMap)
+   {
+   NodeMap::iterator found = vectorMap.find(node);
+   if (found != vectorMap.end())
+      return found->second;
+
+   TR::Node *result = NULL;
+   if (node->getOpCode().isLoadIndirect())
+      {
+      result = TR::Node::createWithSymRef(TR::vloadi, 1, 1, createVectorAddress(node, scalarMap), vectorShadow);
+      }
+   else if (node->getOpCode().isLoadConst() || node->getOpCode().isLoadVarDirect())
+      {
+      // Analysis only admits invariant constants and direct loads. A splat
+      // would otherwise take the 128-bit vector type of its scalar child.
+      result = TR::Node::create(TR::vsplats, 1, duplicateScalar(node, scalarMap));
+      result->setDataType(vectorShadow->getSymbol()->getDataType());
+      }
+   else
+      {
+      result = TR::Node::create(vectorOpFor(node), 2,
+         vectorizeExpression(vectorShadow, node->getFirstChild(), scalarMap, vectorMap),
+         vectorizeExpression(vectorShadow, node->getSecondChild(), scalarMap, vectorMap));
+      }
+
+   vectorMap[node] = result;
+   return result;
+   }
+
+TR::Node *
+TR_LoopVectorizer::createVectorAddress(TR::Node *access, NodeMap &scalarMap)
+   {
+   TR::Node *address = duplicateScalar(access->getFirstChild(), scalarMap);
+   int64_t offset = access->getSymbolReference()->getOffset();
+   if (offset != 0)
+      address = TR::Node::create(TR::aladd, 2, address, TR::Node::lconst(access, offset));
+   return address;
+   }
+
+/**
+ * Address of the first element touched by an access: `base + offset`
+ */
+TR::Node *
+TR_LoopVectorizer::createAccessStart(TR::Node *access)
+   {
+   TR::Node *base = access->getFirstChild()->getFirstChild();
+   TR::Node *start = TR::Node::create(TR::a2l, 1, TR::Node::createLoad(base, base->getSymbolReference()));
+   int64_t offset = access->getSymbolReference()->getOffset();
+   if (offset != 0)
+      start = TR::Node::create(TR::ladd, 2, start, TR::Node::lconst(access, offset));
+   return start;
+   }
+
+/**
+ * Number of iterations left as a 64-bit value: `bound - i`, plus one for
+ * an inclusive bound
+ */
+TR::Node *
+TR_LoopVectorizer::createRemainingIterations(LoopInfo *li)
+   {
+   TR::Node *bound = li->_bound;
+   TR::Node *remaining = TR::Node::create(TR::lsub, 2,
+      TR::Node::create(TR::i2l, 1, bound->duplicateTree()),
+      TR::Node::create(TR::i2l, 1, TR::Node::createLoad(bound, li->_ivSymRef)));
+   if (li->_inclusiveBound)
+      remaining = TR::Node::create(TR::ladd, 2, remaining, TR::Node::lconst(bound, 1));
+   return remaining;
+   }
+
+TR::Node *
+TR_LoopVectorizer::createHorizontalSum(LoopInfo *li, TR::SymbolReference *vectorTemp)
+   {
+   TR::Node *vector = TR::Node::createLoad(li->_bound, vectorTemp);
+   TR::Node *sum = NULL;
+   for (int32_t lane = 0; lane < li->_vectorLength; lane++)
+      {
+      TR::Node *element = TR::Node::create(TR::getvelem, 2, vector, TR::Node::iconst(vector, lane));
+      sum = sum ? TR::Node::create(li->_elementType == TR::Int32 ? TR::iadd : TR::ladd, 2, sum, element) : element;
+      }
+   return sum;
+   }
@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef LOOPVECTORIZER_INCL
+#define LOOPVECTORIZER_INCL
+
+#include <map>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "env/TypedAllocator.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "infra/List.hpp"
+#include "optimizer/LoopCanonicalizer.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_BitVector;
+class TR_RegionStructure;
+class TR_Structure;
+namespace TR { class Block; }
+namespace TR { class Node; }
+namespace TR { class NodeChecklist; }
+namespace TR { class Optimization; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/**
+ * Class TR_LoopVectorizer
+ * =======================
+ *
+ * The loop vectorizer turns counted innermost loops over arrays into
+ * vector IL. A loop is a candidate when its blocks form a single chain
+ * ending in a latch of the form
+ *
+ *    istore #i (iadd (iload #i) (iconst 1))
+ *    ificmplt/ificmple --> header (iload #i) (bound)
+ *
+ * where the bound is loop invariant, and every other tree is either an
+ * indirect store to `base + i * elementSize` of an element-wise expression
+ * over unit-stride loads, invariants and add/sub/mul/div/and/or/xor, or an
+ * integral sum reduction `acc = acc + expr`.
+ *
+ * The original loop is kept untouched and becomes the scalar remainder and
+ * fallback loop. In front of it the vectorizer inserts
+ *
+ *  - a trip count guard that skips to the scalar loop when fewer than one
+ *    vector's worth of iterations remain,
+ *  - runtime overlap checks between every pair of distinct array bases that
+ *    fall back to the scalar loop when two accesses are closer than one
+ *    vector (the versioned fallback),
+ *  - the vector loop itself, processing `vectorSize / elementSize` elements
+ *    per iteration, and
+ *  - a block that folds reduction accumulators back into their scalars and
+ *    either leaves the loop or falls into the scalar loop for the remainder.
+ *
+ * Only operations the code generator reports through
+ * getSupportsVectorLengthForAutoSIMD are generated, so platforms without vector
+ * support are unaffected. The vector size is the widest of 128, 256 and 512
+ * bits that the code generator supports for every operation in the loop.
+ */
+
+class TR_LoopVectorizer : public TR_LoopTransformer
+   {
+   public:
+   TR_LoopVectorizer(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_LoopVectorizer(manager);
+      }
+
+   virtual bool    shouldPerform();
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   struct LoopInfo
+      {
+      TR_ALLOC(TR_Memory::LoopTransformer)
+
+      LoopInfo(TR_Memory *m)
+         : _region(NULL), _header(NULL), _latch(NULL), _exit(NULL), _ivStoreTree(NULL), _ivSymRef(NULL),
+           _bound(NULL), _inclusiveBound(false), _elementType(TR::NoType), _length(TR::VectorLength512), _vectorLength(0),
+           _bodyTrees(m), _accesses(m), _reductions(m), _overlapChecks(m)
+         {}
+
+      TR_RegionStructure *_region;
+      TR::Block *_header;
+      TR::Block *_latch;
+      TR::Block *_exit;
+      TR::TreeTop *_ivStoreTree;
+      TR::SymbolReference *_ivSymRef;
+      TR::Node *_bound;
+      bool _inclusiveBound;
+      TR::DataType _elementType;
+      TR::VectorLength _length;     // widest vector length supported by every operation in the loop
+      int32_t _vectorLength;        // number of elements per vector
+
+      TR_ScratchList<TR::TreeTop> _bodyTrees;   // trees to vectorize, in order
+      TR_ScratchList<TR::Node> _accesses;       // array loads and stores
+      TR_ScratchList<TR::Node> _reductions;     // direct stores of reduction accumulators
+      TR_ScratchList<TR::Node> _overlapChecks;  // pairs of accesses whose arrays must not overlap
+      };
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, TR::Node *>, TR::Region &> NodeMapAllocator;
+   typedef std::map<TR::Node *, TR::Node *, std::less<TR::Node *>, NodeMapAllocator> NodeMap;
+
+   typedef TR::typed_allocator<std::pair<TR::SymbolReference * const, TR::SymbolReference *>, TR::Region &> SymRefMapAllocator;
+   typedef std::map<TR::SymbolReference *, TR::SymbolReference *, std::less<TR::SymbolReference *>, SymRefMapAllocator> SymRefMap;
+
+   /* analysis */
+   void collectLoops(TR_Structure *str);
+   bool analyzeLoop(LoopInfo *li);
+   bool collectLoopChain(LoopInfo *li);
+   bool analyzeLatch(LoopInfo *li, TR::TreeTop *branchTree, TR::TreeTop *ivStoreTree);
+   bool analyzeBodyTree(LoopInfo *li, TR::Node *node, TR::NodeChecklist &visited);
+   bool analyzeEntryEdges(LoopInfo *li);
+   bool isLoopInvariant(TR::Node *node);
+   bool isUnitStrideAddress(LoopInfo *li, TR::Node *address);
+   bool isSameArray(TR::Node *first, TR::Node *second);
+   bool collectOverlapChecks(LoopInfo *li);
+   bool isVectorizableExpression(LoopInfo *li, TR::Node *node, TR::NodeChecklist &visited);
+   bool setElementType(LoopInfo *li, TR::DataType dt);
+   bool supportsVectorOp(LoopInfo *li, TR::ILOpCodes op, TR::DataType dt);
+   TR::ILOpCodes vectorOpFor(TR::Node *node);
+   void collectStoredSymbols(TR::Node *node, TR::NodeChecklist &visited);
+   int32_t countLoads(TR::Node *node, TR::SymbolReference *symRef, TR::NodeChecklist &visited);
+
+   /* transformation */
+   void transformLoop(LoopInfo *li);
+   TR::Block *createBlockBefore(TR::Block *next, TR::Node *bcNode, int32_t frequency);
+   TR::Node *duplicateScalar(TR::Node *node, NodeMap &map);
+   TR::Node *vectorizeExpression(TR::SymbolReference *vectorShadow, TR::Node *node, NodeMap &scalarMap, NodeMap &vectorMap);
+   TR::Node *createVectorAddress(TR::Node *access, NodeMap &scalarMap);
+   TR::Node *createAccessStart(TR::Node *access);
+   TR::Node *createRemainingIterations(LoopInfo *li);
+   TR::Node *createHorizontalSum(LoopInfo *li, TR::SymbolReference *vectorTemp);
+
+   TR_ScratchList<LoopInfo> _loopInfos;
+   TR_BitVector *_storedSymRefs;
+   };
+
+#endif
@@ -93,6 +93,11 @@ OMR::OptimizationManager::OptimizationManager(TR::Optimizer *o, OptimizationFact
       case OMR::loopReduction:
          _flags.set(requiresStructure | checkStructure | dumpStructure);
          break;
+      case OMR::loopVectorizer:
+      case OMR::unrollAndJam:
+      case OMR::softwarePipelining:
+         _flags.set(requiresStructure | checkStructure | dumpStructure);
+         break;
       case OMR::loopReplicator:
          _flags.set(requiresStructure | checkStructure | dumpStructure);
          break;
@@ -86,9 +86,11 @@ using namespace std;
 #include "optimizer/CatchBlockRemover.hpp"
 #include "optimizer/CFGSimplifier.hpp"
 #include "optimizer/CompactLocals.hpp"
+#include "optimizer/CompileBudget.hpp"
 #include "optimizer/CopyPropagation.hpp"
 #include "optimizer/ExpressionsSimplification.hpp"
 #include "optimizer/GeneralLoopUnroller.hpp"
+#include "optimizer/IfConversion.hpp"
 #include "optimizer/LocalCSE.hpp"
 #include "optimizer/LocalDeadStoreElimination.hpp"
 #include "optimizer/LocalLiveRangeReducer.hpp"
@@ -97,6 +99,8 @@ using namespace std;
 #include "optimizer/LoopCanonicalizer.hpp"
 #include "optimizer/LoopReducer.hpp"
 #include "optimizer/LoopReplicator.hpp"
+#include "optimizer/LoopVectorizer.hpp"
+#include "optimizer/UnrollAndJam.hpp"
 #include "optimizer/LoopVersioner.hpp"
 #include "optimizer/OrderBlocks.hpp"
 #include "optimizer/RedundantAsyncCheckRemoval.hpp"
@@ -110,6 +114,9 @@ using namespace std;
 #include "optimizer/LocalValuePropagation.hpp"
 #include "optimizer/RegDepCopyRemoval.hpp"
 #include "optimizer/SinkStores.hpp"
+#include "optimizer/SLPVectorizer.hpp"
+#include "optimizer/SoftwarePipeliner.hpp"
+#include "optimizer/SparseConditionalConstantPropagation.hpp"
 #include "optimizer/PartialRedundancy.hpp"
 #include "optimizer/OSRDefAnalysis.hpp"
 #include "optimizer/StripMiner.hpp"
@@ -610,10 +617,16 @@ static const OptimizationStrategy omrWarmStrategyOpts[] =
         {basicBlockExtension},
         {localCSE},
         //{ localValuePropagation               },
+        {sparseConditionalConstantPropagation},
         {treeSimplification},
+        {loopVectorizer, IfLoops},
+        {unrollAndJam, IfLoops},
+        {softwarePipelining, IfLoops},
+        {ifConversion},
         {localCSE},
         {localDeadStoreElimination},
         {globalDeadStoreGroup},
+        {slpVectorizer},
         {endOpts},
 };
 
@@ -661,11 +674,15 @@ static const OptimizationStrategy omrHotStrategyOpts[] =
         {
             OMR::inductionVariableAnalysis,
         },
+        {OMR::loopVectorizer, OMR::IfLoops}, // vectorize counted array loops before unrolling
+        {OMR::unrollAndJam, OMR::IfLoops},   // jam outer iterations of counted loop nests
+        {OMR::softwarePipelining, OMR::IfLoops},
         {
             OMR::generalLoopUnroller,
         }, // unroll Loops
         {OMR::blockSplitter, OMR::MarkLastRun},
         {OMR::blockManipulationGroup},
+        {OMR::ifConversion}, // after block manipulation has cleaned up the conditionals
         {OMR::lateLocalGroup},
         {OMR::redundantAsyncCheckRemoval}, // optimize async check placement
 #ifdef J9_PROJECT_SPECIFIC
@@ -700,6 +717,7 @@ static const OptimizationStrategy omrHotStrategyOpts[] =
         {
             OMR::globalDeadStoreElimination,
         },                           // global dead store removal
+        {OMR::slpVectorizer},        // pack isomorphic stores once the trees have settled
         {OMR::deadTreesElimination}, // cleanup after dead store removal
         {OMR::compactNullChecks},    // cleanup at the end
         {OMR::finalGlobalGroup},     // done just before codegen
@@ -793,12 +811,14 @@ OMR::Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *metho
       _eliminatedCheckcastNodes(comp->trMemory()),
       _classPointerNodes(comp->trMemory()),
       _optMessageIndex(0),
+      _optGroupDepth(1),
       _seenBlocksGRA(NULL),
       _resetExitsGRA(NULL),
       _successorBitsGRA(NULL),
       _stackedOptimizer(false),
       _firstTimeStructureIsBuilt(true),
-      _disableLoopOptsThatCanCreateLoops(false)
+      _disableLoopOptsThatCanCreateLoops(false),
+      _compileBudget(NULL)
 {
    // zero opts table
    memset(_opts, 0, sizeof(_opts));
@@ -874,6 +894,18 @@ OMR::Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *metho
        new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopCanonicalizer::create, OMR::loopCanonicalization);
    _opts[OMR::loopVersioner] =
        new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopVersioner::create, OMR::loopVersioner);
+   _opts[OMR::loopVectorizer] =
+       new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopVectorizer::create, OMR::loopVectorizer);
+   _opts[OMR::slpVectorizer] =
+       new (comp->allocator()) TR::OptimizationManager(self(), TR_SLPVectorizer::create, OMR::slpVectorizer);
+   _opts[OMR::sparseConditionalConstantPropagation] =
+       new (comp->allocator()) TR::OptimizationManager(self(), TR_SparseConditionalConstantPropagation::create, OMR::sparseConditionalConstantPropagation);
+   _opts[OMR::unrollAndJam] =
+       new (comp->allocator()) TR::OptimizationManager(self(), TR_UnrollAndJam::create, OMR::unrollAndJam);
+   _opts[OMR::softwarePipelining] =
+       new (comp->allocator()) TR::OptimizationManager(self(), TR_SoftwarePipeliner::create, OMR::softwarePipelining);
+   _opts[OMR::ifConversion] =
+       new (comp->allocator()) TR::OptimizationManager(self(), TR_IfConversion::create, OMR::ifConversion);
    _opts[OMR::loopReduction] =
        new (comp->allocator()) TR::OptimizationManager(self(), TR_LoopReducer::create, OMR::loopReduction);
    _opts[OMR::loopReplicator] =
@@ -1196,6 +1228,13 @@ void OMR::Optimizer::optimize()
       self()->switchToProfiling(2, 30);
    }
 
+   if (!isIlGenOpt() &&
+       comp()->isOutermostMethod() &&
+       (comp()->getOptions()->getCompileTimeBudget() > 0 ||
+        comp()->getOption(TR_TraceCompileBudget) ||
+        TR::Options::isAnyVerboseOptionSet(TR_VerboseOptimizer)))
+      _compileBudget = new (trStackMemory()) TR_CompileBudget(comp());
+
    const OptimizationStrategy *opt = _strategy;
    while (opt->_num != endOpts)
    {
@@ -1222,6 +1261,12 @@ void OMR::Optimizer::optimize()
 
    dumpPostOptTrees();
 
+   if (_compileBudget)
+   {
+      _compileBudget->report();
+      _compileBudget = NULL;
+   }
+
    if (comp()->getOption(TR_TraceOpts))
    {
       if (comp()->isOutermostMethod())
@@ -1249,9 +1294,8 @@ void OMR::Optimizer::dumpPostOptTrees()
       comp()->dumpMethodTrees("Post Optimization Trees");
 }
 
-void dumpName(TR::Optimizer *op, TR_FrontEnd *fe, TR::Compilation *comp, OMR::Optimizations optNum)
+static void dumpName(TR::Optimizer *op, TR_FrontEnd *fe, TR::Compilation *comp, OMR::Optimizations optNum, int level = 1)
 {
-   static int level = 1;
    TR::OptimizationManager *manager = op->getOptimization(optNum);
 
    if (level > 6)
@@ -1261,18 +1305,14 @@ void dumpName(TR::Optimizer *op, TR_FrontEnd *fe, TR::Compilation *comp, OMR::Op
    {
       trfprintf(comp->getOutFile(), "%*s<%s>\n", level * 6, " ", manager->name());
 
-      level++;
-
       const OptimizationStrategy *subGroup = ((TR::OptimizationManager *)manager)->groupOfOpts();
 
       while (subGroup->_num != endOpts && subGroup->_num != endGroup)
       {
-         dumpName(op, fe, comp, subGroup->_num);
+         dumpName(op, fe, comp, subGroup->_num, level + 1);
          subGroup++;
       }
 
-      level--;
-
       trfprintf(comp->getOutFile(), "%*s</%s>", level * 6, " ", manager->name());
    }
    else if (optNum > endOpts && optNum < OMR::numOpts)
@@ -3603,7 +3643,6 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
       doThisOptimization = false;
 
    int32_t actualCost = 0;
-   static int32_t optDepth = 1;
 
    TR_FrontEnd *fe = comp()->fe();
 
@@ -3615,10 +3654,10 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
       if (comp()->getOption(TR_TraceOptDetails) || comp()->getOption(TR_TraceOpts))
       {
          if (comp()->isOutermostMethod())
-            traceMsg(comp(), "%*s<optgroup name=%s>\n", optDepth * 3, " ", manager->name());
+            traceMsg(comp(), "%*s<optgroup name=%s>\n", _optGroupDepth * 3, " ", manager->name());
       }
 
-      optDepth++;
+      _optGroupDepth++;
 
       // Find the subgroup. It is either referenced directly from this
       // optimization or picked up from the table of groups using the
@@ -3674,12 +3713,12 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
             break;
       }
 
-      optDepth--;
+      _optGroupDepth--;
 
       if (comp()->getOption(TR_TraceOptDetails) || comp()->getOption(TR_TraceOpts))
       {
          if (comp()->isOutermostMethod())
-            traceMsg(comp(), "%*s</optgroup>\n", optDepth * 3, " ");
+            traceMsg(comp(), "%*s</optgroup>\n", _optGroupDepth * 3, " ");
       }
 
       return actualCost;
@@ -3720,6 +3759,19 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
       if (regex && TR::SimpleRegex::match(regex, manager->name()))
          return 0;
 
+      if (_compileBudget)
+      {
+         OMR::Optimizations budgetedOptNum = _compileBudget->select(optNum);
+         if (budgetedOptNum == endOpts)
+            return 0;
+
+         if (budgetedOptNum != optNum)
+         {
+            OptimizationStrategy replacement = { budgetedOptNum, optimization->_options };
+            return performOptimization(&replacement, firstOptIndex, lastOptIndex, doTiming);
+         }
+      }
+
       // actually doing optimization
       regex = comp()->getOptions()->getBreakOnOpts();
       if (regex && TR::SimpleRegex::match(regex, optIndex))
@@ -3743,7 +3795,7 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
       if (comp()->getOption(TR_TraceOpts))
       {
          if (comp()->isOutermostMethod())
-            traceMsg(comp(), "%*s%s\n", optDepth * 3, " ", manager->name());
+            traceMsg(comp(), "%*s%s\n", _optGroupDepth * 3, " ", manager->name());
       }
 
       if (!_aliasSetsAreValid && !manager->getDoesNotRequireAliasSets())
@@ -4020,6 +4072,10 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
       LexicalTimer t(manager->name(), comp()->phaseTimer());
       TR::LexicalMemProfiler mp(manager->name(), comp()->phaseMemProfiler());
 
+      uint64_t optStartTicks = _compileBudget ? TR::Compiler->vm.getHighResClock(comp()) : 0;
+      size_t optStartHeapBytes = comp()->trMemory()->heapMemoryRegion().bytesAllocated();
+      size_t optStackBytes = 0;
+
       int32_t origSymRefCount = comp()->getSymRefCount();
       int32_t origNodeCount = comp()->getNodeCount();
       int32_t origCfgNodeCount = comp()->getFlowGraph()->getNextNodeNumber();
@@ -4090,6 +4146,7 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
             opt->prePerform();
             actualCost += opt->perform();
             opt->postPerform();
+            optStackBytes = stackMemoryRegion.bytesAllocated();
          }
 
          comp()->reportAnalysisPhase(AFTER_OPTIMIZATION);
@@ -4113,9 +4170,16 @@ int32_t OMR::Optimizer::performOptimization(const OptimizationStrategy *optimiza
             }
          }
          opt->postPerformOnBlocks();
+         optStackBytes = stackMemoryRegion.bytesAllocated();
       }
 
       delete opt;
+
+      if (_compileBudget)
+         _compileBudget->record(optNum,
+                                TR::Compiler->vm.getHighResClock(comp()) - optStartTicks,
+                                comp()->trMemory()->heapMemoryRegion().bytesAllocated() - optStartHeapBytes + optStackBytes,
+                                origNodeCount);
       // we cannot easily invalidate during IL gen since we could be peeking and we cannot destroy our
       // caller's alias sets
       if (!isIlGenOpt())
@@ -4523,6 +4587,11 @@ bool OMR::Optimizer::areNodesEquivalent(TR::Node *node1, TR::Node *node2, TR::Co
             break;
          default:
          {
+            if (node1->getDataType().isVector())
+            {
+               if (node1->getLiteralPoolOffset() != node2->getLiteralPoolOffset())
+                  return false;
+            }
 #ifdef J9_PROJECT_SPECIFIC
             if (node1->getDataType().isBCD())
             {
@@ -56,6 +56,7 @@ namespace TR { class Optimizer; }
 namespace TR { class ResolvedMethodSymbol; }
 struct OptimizationStrategy;
 class OMR_InlinerPolicy;
+class TR_CompileBudget;
 class OMR_InlinerUtil;
 
 
@@ -386,6 +387,7 @@ class Optimizer
    int32_t                       _firstDumpOptPhaseTrees;
    int32_t                       _lastDumpOptPhaseTrees;
    int32_t                       _optMessageIndex;
+   int32_t                       _optGroupDepth;     // nesting of optimization groups, for trace indentation
 
    bool                          _aliasSetsAreValid;
    bool                          _cantBuildGlobalsUseDefInfo;
@@ -407,6 +409,8 @@ class Optimizer
    TR_BitVector *                _seenBlocksGRA; // used during the GRA as a global
    TR_BitVector *                _resetExitsGRA; // used during the GRA as a global
    TR_BitVector *                _successorBitsGRA; // used during the GRA as a global
+
+   TR_CompileBudget *            _compileBudget;
    };
 
 }
@@ -517,7 +517,7 @@ void TR_OSRDefInfo::buildOSRDefs(TR::Node *node, void *vanalysisInfo, TR_OSRPoin
          {
          uint32_t osrIndex = osrPoint->getOSRIndex();
          aux._defsForOSR[osrIndex] = new (aux._region) TR_BitVector(aux._region);
-         *aux._defsForOSR[osrIndex] |= *analysisInfo;
+         analysisInfo->unionInto(*aux._defsForOSR[osrIndex]);
          if (trace())
             {
             traceMsg(comp(), "_defsForOSR[%d] at node %p \n", osrIndex, node);
@@ -529,7 +529,7 @@ void TR_OSRDefInfo::buildOSRDefs(TR::Node *node, void *vanalysisInfo, TR_OSRPoin
          {
          uint32_t osrIndex = osrPoint2->getOSRIndex();
          aux._defsForOSR[osrIndex] = new (aux._region) TR_BitVector(aux._region);
-         *aux._defsForOSR[osrIndex] |= *analysisInfo;
+         analysisInfo->unionInto(*aux._defsForOSR[osrIndex]);
          if (trace())
             {
             traceMsg(comp(), "_defsForOSR[%d] after node %p \n", osrIndex, node);
@@ -48,6 +48,7 @@
 #include "infra/List.hpp"
 #include "infra/CfgEdge.hpp"
 #include "infra/CfgNode.hpp"
+#include "infra/vector.hpp"
 #include "optimizer/Optimization_inlines.hpp"
 #include "optimizer/OptimizationManager.hpp"
 #include "optimizer/Optimizations.hpp"
@@ -2036,6 +2037,342 @@ bool TR_OrderBlocks::doBlockExtension()
    }
 
 
+// Ext-TSP block layout
+//
+// Used instead of the greedy fall-through selection when the CFG carries measured
+// edge frequencies. Following Newell and Pupyrev, "Improved Basic Block Reordering",
+// a layout is scored by rewarding every profiled edge that becomes a fall-through with
+// its full weight and every short forward or backward jump with a tenth of its weight,
+// decreasing linearly with the jump distance. Blocks start out as single block chains
+// which are greedily merged, concatenated either way or with one chain inserted into a
+// split of the other, as long as the score improves.
+//
+// Blocks that extend their predecessor are kept together with it as a single unit and
+// the size of a unit is measured in trees.
+//
+#define EXTTSP_MAX_UNITS          256
+#define EXTTSP_MAX_SPLIT_UNITS    16
+#define EXTTSP_FORWARD_DISTANCE   256.0
+#define EXTTSP_BACKWARD_DISTANCE  160.0
+#define EXTTSP_JUMP_WEIGHT        0.1
+
+namespace
+{
+
+typedef TR::vector<int32_t, TR::Region&> ExtTSPChain;
+
+struct ExtTSPEdge
+   {
+   int32_t _to;         // target unit
+   int32_t _offset;     // end of the source block from the start of its unit
+   double _weight;
+   };
+
+struct ExtTSPSegment
+   {
+   ExtTSPChain *_chain;
+   int32_t _begin;
+   int32_t _end;
+   };
+
+class ExtTSPLayout
+   {
+   public:
+
+   ExtTSPLayout(TR::Region &region, int32_t numUnits)
+      : _numUnits(numUnits),
+        _edges(region),
+        _firstEdge(numUnits + 1, 0, region),
+        _size(numUnits, 0, region),
+        _position(numUnits, 0, region),
+        _mark(numUnits, 0, region),
+        _stamp(0)
+      {}
+
+   double score(ExtTSPSegment *segments, int32_t numSegments)
+      {
+      _stamp++;
+      int32_t position = 0;
+      for (int32_t s = 0; s < numSegments; s++)
+         {
+         for (int32_t i = segments[s]._begin; i < segments[s]._end; i++)
+            {
+            int32_t unit = (*segments[s]._chain)[i];
+            _position[unit] = position;
+            _mark[unit] = _stamp;
+            position += _size[unit];
+            }
+         }
+
+      double score = 0;
+      for (int32_t s = 0; s < numSegments; s++)
+         {
+         for (int32_t i = segments[s]._begin; i < segments[s]._end; i++)
+            {
+            int32_t unit = (*segments[s]._chain)[i];
+            for (int32_t e = _firstEdge[unit]; e < _firstEdge[unit + 1]; e++)
+               {
+               ExtTSPEdge &edge = _edges[e];
+               if (_mark[edge._to] != _stamp)
+                  continue;
+
+               int32_t source = _position[unit] + edge._offset;
+               int32_t target = _position[edge._to];
+               if (target == source)
+                  score += edge._weight;
+               else if (target > source && target - source < EXTTSP_FORWARD_DISTANCE)
+                  score += EXTTSP_JUMP_WEIGHT * edge._weight * (1.0 - (target - source) / EXTTSP_FORWARD_DISTANCE);
+               else if (target < source && source - target < EXTTSP_BACKWARD_DISTANCE)
+                  score += EXTTSP_JUMP_WEIGHT * edge._weight * (1.0 - (source - target) / EXTTSP_BACKWARD_DISTANCE);
+               }
+            }
+         }
+      return score;
+      }
+
+   int32_t _numUnits;
+   TR::vector<ExtTSPEdge, TR::Region&> _edges;     // grouped by source unit
+   TR::vector<int32_t, TR::Region&> _firstEdge;
+   TR::vector<int32_t, TR::Region&> _size;
+
+   private:
+   TR::vector<int32_t, TR::Region&> _position;
+   TR::vector<int32_t, TR::Region&> _mark;
+   int32_t _stamp;
+   };
+
+struct DenserChain
+   {
+   DenserChain(TR::vector<double, TR::Region&> &density, TR::vector<int32_t, TR::Region&> &cold, TR::vector<int32_t, TR::Region&> &first)
+      : _density(density), _cold(cold), _first(first) {}
+
+   bool operator()(int32_t a, int32_t b) const
+      {
+      if (_cold[a] != _cold[b])
+         return !_cold[a];
+      if (_density[a] != _density[b])
+         return _density[a] > _density[b];
+      return _first[a] < _first[b];
+      }
+
+   TR::vector<double, TR::Region&> &_density;
+   TR::vector<int32_t, TR::Region&> &_cold;
+   TR::vector<int32_t, TR::Region&> &_first;
+   };
+
+}
+
+void TR_OrderBlocks::generateExtTSPOrder(TR_BlockList & newBlockOrder)
+   {
+   TR::CFG *cfg = comp()->getFlowGraph();
+   TR::Region &region = comp()->trMemory()->currentStackRegion();
+
+   int32_t numUnits = 0;
+   for (TR::Block *block = comp()->getStartBlock(); block; block = block->getNextBlock())
+      {
+      if (!block->isExtensionOfPreviousBlock())
+         numUnits++;
+      }
+
+   if (numUnits > EXTTSP_MAX_UNITS ||
+       !performTransformation(comp(), "%s Ext-TSP layout of %d units from edge profile\n", OPT_DETAILS, numUnits))
+      {
+      generateNewOrder(newBlockOrder);
+      return;
+      }
+
+   ExtTSPLayout layout(region, numUnits);
+   TR::vector<TR::Block *, TR::Region&> head(numUnits, static_cast<TR::Block *>(NULL), region);
+   TR::vector<int32_t, TR::Region&> unitOf(cfg->getNextNodeNumber(), -1, region);
+   TR::vector<double, TR::Region&> weight(numUnits, 0.0, region);
+
+   int32_t unit = -1;
+   for (TR::Block *block = comp()->getStartBlock(); block; block = block->getNextBlock())
+      {
+      if (!block->isExtensionOfPreviousBlock())
+         head[++unit] = block;
+      unitOf[block->getNumber()] = unit;
+      int32_t size = block->getNumberOfRealTreeTops() + 1;
+      layout._size[unit] += size;
+      weight[unit] += (double)block->getFrequency() * size;
+      }
+
+   for (unit = 0; unit < numUnits; unit++)
+      {
+      layout._firstEdge[unit] = static_cast<int32_t>(layout._edges.size());
+      int32_t offset = 0;
+      for (TR::Block *block = head[unit]; block && unitOf[block->getNumber()] == unit; block = block->getNextBlock())
+         {
+         offset += block->getNumberOfRealTreeTops() + 1;
+         for (auto e = block->getSuccessors().begin(); e != block->getSuccessors().end(); ++e)
+            {
+            TR::Block *succ = toBlock((*e)->getTo());
+            if (!succ->getEntry() || unitOf[succ->getNumber()] < 0 || unitOf[succ->getNumber()] == unit || (*e)->getFrequency() <= 0)
+               continue;
+
+            ExtTSPEdge edge = { unitOf[succ->getNumber()], offset, (double)(*e)->getFrequency() };
+            layout._edges.push_back(edge);
+            }
+         }
+      }
+   layout._firstEdge[numUnits] = static_cast<int32_t>(layout._edges.size());
+
+   TR::vector<ExtTSPChain *, TR::Region&> chains(numUnits, static_cast<ExtTSPChain *>(NULL), region);
+   TR::vector<int32_t, TR::Region&> chainOf(numUnits, 0, region);
+   TR::vector<double, TR::Region&> chainScore(numUnits, 0.0, region);
+   TR::vector<int32_t, TR::Region&> considered(numUnits, -1, region);
+   for (unit = 0; unit < numUnits; unit++)
+      {
+      chains[unit] = new (region) ExtTSPChain(1, unit, region);
+      chainOf[unit] = unit;
+      }
+
+   // Unit 0 holds the first block of the method, whose chain must stay at the front
+   //
+   while (true)
+      {
+      double bestGain = 0.0;
+      int32_t bestX = -1, bestY = -1, bestSplit = -1;
+      bool bestYFirst = false;
+
+      for (int32_t x = 0; x < numUnits; x++)
+         {
+         ExtTSPChain *chainX = chains[x];
+         if (!chainX)
+            continue;
+
+         for (size_t i = 0; i < chainX->size(); i++)
+            {
+            int32_t u = (*chainX)[i];
+            for (int32_t e = layout._firstEdge[u]; e < layout._firstEdge[u + 1]; e++)
+               {
+               int32_t y = chainOf[layout._edges[e]._to];
+               if (y == x || considered[y] == x)
+                  continue;
+               considered[y] = x;
+
+               ExtTSPChain *chainY = chains[y];
+               double base = chainScore[x] + chainScore[y];
+               int32_t sizeX = static_cast<int32_t>(chainX->size());
+               int32_t sizeY = static_cast<int32_t>(chainY->size());
+
+               // X Y and Y X
+               for (int32_t yFirst = 0; yFirst < 2; yFirst++)
+                  {
+                  if ((yFirst ? x : y) == chainOf[0])
+                     continue;
+                  ExtTSPSegment segments[2] = { { chainX, 0, sizeX }, { chainY, 0, sizeY } };
+                  if (yFirst)
+                     std::swap(segments[0], segments[1]);
+                  double gain = layout.score(segments, 2) - base;
+                  if (gain > bestGain)
+                     {
+                     bestGain = gain;
+                     bestX = x; bestY = y; bestSplit = -1; bestYFirst = yFirst != 0;
+                     }
+                  }
+
+               // X1 Y X2
+               if (sizeX <= EXTTSP_MAX_SPLIT_UNITS && y != chainOf[0])
+                  {
+                  for (int32_t split = 1; split < sizeX; split++)
+                     {
+                     ExtTSPSegment segments[3] = { { chainX, 0, split }, { chainY, 0, sizeY }, { chainX, split, sizeX } };
+                     double gain = layout.score(segments, 3) - base;
+                     if (gain > bestGain)
+                        {
+                        bestGain = gain;
+                        bestX = x; bestY = y; bestSplit = split; bestYFirst = false;
+                        }
+                     }
+                  }
+               }
+            }
+         }
+
+      if (bestX < 0)
+         break;
+
+      ExtTSPChain *chainX = chains[bestX];
+      ExtTSPChain *chainY = chains[bestY];
+      ExtTSPChain *merged = new (region) ExtTSPChain(region);
+      if (bestSplit >= 0)
+         {
+         merged->insert(merged->end(), chainX->begin(), chainX->begin() + bestSplit);
+         merged->insert(merged->end(), chainY->begin(), chainY->end());
+         merged->insert(merged->end(), chainX->begin() + bestSplit, chainX->end());
+         }
+      else if (bestYFirst)
+         {
+         merged->insert(merged->end(), chainY->begin(), chainY->end());
+         merged->insert(merged->end(), chainX->begin(), chainX->end());
+         }
+      else
+         {
+         merged->insert(merged->end(), chainX->begin(), chainX->end());
+         merged->insert(merged->end(), chainY->begin(), chainY->end());
+         }
+
+      if (trace())
+         traceMsg(comp(), "\tExt-TSP: merging chain of block_%d into chain of block_%d, gain %f\n", head[(*chainY)[0]]->getNumber(), head[(*chainX)[0]]->getNumber(), bestGain);
+
+      chains[bestX] = merged;
+      chains[bestY] = NULL;
+      chainScore[bestX] += chainScore[bestY] + bestGain;
+      for (size_t i = 0; i < merged->size(); i++)
+         chainOf[(*merged)[i]] = bestX;
+      for (int32_t c = 0; c < numUnits; c++)
+         considered[c] = -1;
+      }
+
+   // The entry chain goes first, followed by the remaining chains in order of
+   // decreasing execution density with cold chains last
+   //
+   TR::vector<int32_t, TR::Region&> order(region);
+   TR::vector<double, TR::Region&> density(numUnits, 0.0, region);
+   TR::vector<int32_t, TR::Region&> cold(numUnits, 0, region);
+   TR::vector<int32_t, TR::Region&> first(numUnits, 0, region);
+   for (int32_t c = 0; c < numUnits; c++)
+      {
+      if (!chains[c] || c == chainOf[0])
+         continue;
+
+      double chainWeight = 0;
+      int32_t chainSize = 0;
+      bool allCold = true;
+      first[c] = numUnits;
+      for (size_t i = 0; i < chains[c]->size(); i++)
+         {
+         int32_t u = (*chains[c])[i];
+         chainWeight += weight[u];
+         chainSize += layout._size[u];
+         allCold = allCold && head[u]->isCold();
+         first[c] = std::min(first[c], u);
+         }
+      density[c] = chainWeight / chainSize;
+      cold[c] = allCold;
+      order.push_back(c);
+      }
+   std::sort(order.begin(), order.end(), DenserChain(density, cold, first));
+   order.insert(order.begin(), chainOf[0]);
+
+   ListElement<TR::CFGNode> *lastElementInOrder = newBlockOrder.addAfter(cfg->getStart(), NULL);
+   for (size_t c = 0; c < order.size(); c++)
+      {
+      ExtTSPChain *chain = chains[order[c]];
+      for (size_t i = 0; i < chain->size(); i++)
+         {
+         int32_t u = (*chain)[i];
+         for (TR::Block *block = head[u]; block && unitOf[block->getNumber()] == u; block = block->getNextBlock())
+            {
+            if (trace())
+               traceMsg(comp(), "\tExt-TSP: adding block_%d to order\n", block->getNumber());
+            lastElementInOrder = newBlockOrder.addAfter(block, lastElementInOrder);
+            }
+         }
+      }
+   }
+
 void TR_OrderBlocks::doReordering()
    {
    //if (!performTransformation(comp(), "%s ORDER BLOCK: Reordering blocks to optimize fall-through paths\n", OPT_DETAILS))
@@ -2053,7 +2390,10 @@ void TR_OrderBlocks::doReordering()
    _visitCount = comp()->incVisitCount();
 
    TR_BlockList newBlockOrder(trMemory());
-   generateNewOrder(newBlockOrder);
+   if (comp()->getFlowGraph()->hasEdgeProfileFrequencies() && !_superColdBlockOnly)
+      generateExtTSPOrder(newBlockOrder);
+   else
+      generateNewOrder(newBlockOrder);
 
    //if (performTransformation(comp(), "%s Reordering blocks to optimize fall-through paths\n", OPT_DETAILS))
       connectTreesAccordingToOrder(newBlockOrder);
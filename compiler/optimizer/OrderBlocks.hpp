@@ -132,6 +132,7 @@ class TR_OrderBlocks : public TR_BlockOrderingOptimization
 
    void            initialize();
    void            generateNewOrder(TR_BlockList & newBlockOrder);
+   void            generateExtTSPOrder(TR_BlockList & newBlockOrder);
    bool            doBlockExtension();
 
    // instance variables
@@ -0,0 +1,136 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/RecompilationCounters.hpp"
+
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/CfgNode.hpp"
+#include "infra/vector.hpp"
+#include "ras/Debug.hpp"
+
+TR_RecompilationCounters::TR_RecompilationCounters(TR::Compilation *comp, int32_t *counter)
+   : _comp(comp),
+     _counter(counter),
+     _trace(comp->getOption(TR_TraceBFGeneration))
+   {
+   }
+
+void
+TR_RecompilationCounters::perform()
+   {
+   // The counter is addressed directly, which relocatable code cannot do
+   //
+   if (_comp->compileRelocatableCode() || !_comp->getFlowGraph() || !_comp->getStartTree())
+      return;
+
+   TR::CFG *cfg = _comp->getFlowGraph();
+   TR::StackMemoryRegion stackMemoryRegion(*_comp->trMemory());
+
+   TR_BitVector counted(cfg->getNextNodeNumber(), _comp->trMemory(), stackAlloc, growable);
+   if (!_comp->getOption(TR_DisableTieredBackedgeCounters))
+      findLoopHeaders(counted);
+
+   if (!_comp->getOption(TR_DisableTieredInvocationCounters))
+      counted.set(_comp->getStartTree()->getNode()->getBlock()->getNumber());
+
+   for (TR::CFGNode *node = cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      if (!block->getEntry() || !counted.isSet(block->getNumber()))
+         continue;
+
+      addDecrement(block);
+      if (_trace)
+         traceMsg(_comp, "Recompilation counter decremented in block_%d\n", block->getNumber());
+      }
+   }
+
+// A depth first walk from the entry; an edge to a block that is still on
+// the walk's stack is a back edge and its target a loop header.
+//
+void
+TR_RecompilationCounters::findLoopHeaders(TR_BitVector &headers)
+   {
+   TR::CFG *cfg = _comp->getFlowGraph();
+   int32_t numNodes = cfg->getNextNodeNumber();
+   TR_BitVector visited(numNodes, _comp->trMemory(), stackAlloc, growable);
+   TR_BitVector onStack(numNodes, _comp->trMemory(), stackAlloc, growable);
+
+   typedef std::pair<TR::CFGNode *, TR::CFGEdgeList::iterator> WalkEntry;
+   TR::vector<WalkEntry, TR::Region&> stack(_comp->trMemory()->currentStackRegion());
+
+   TR::CFGNode *start = cfg->getStart();
+   visited.set(start->getNumber());
+   onStack.set(start->getNumber());
+   stack.push_back(WalkEntry(start, start->getSuccessors().begin()));
+
+   while (!stack.empty())
+      {
+      TR::CFGNode *node = stack.back().first;
+      if (stack.back().second == node->getSuccessors().end())
+         {
+         onStack.reset(node->getNumber());
+         stack.pop_back();
+         continue;
+         }
+
+      TR::CFGNode *to = (*stack.back().second)->getTo();
+      ++stack.back().second;
+
+      if (onStack.isSet(to->getNumber()))
+         {
+         headers.set(to->getNumber());
+         }
+      else if (!visited.isSet(to->getNumber()))
+         {
+         visited.set(to->getNumber());
+         onStack.set(to->getNumber());
+         stack.push_back(WalkEntry(to, to->getSuccessors().begin()));
+         }
+      }
+   }
+
+void
+TR_RecompilationCounters::addDecrement(TR::Block *block)
+   {
+   TR::Node *bbStart = block->getEntry()->getNode();
+   TR::SymbolReference *symRef = _comp->getSymRefTab()->createKnownStaticDataSymbolRef(_counter, TR::Int32);
+   TR::Node *load = TR::Node::createWithSymRef(bbStart, TR::iload, 0, symRef);
+   TR::Node *sub = TR::Node::create(TR::isub, 2, load, TR::Node::iconst(bbStart, 1));
+   TR::Node *store = TR::Node::createWithSymRef(TR::istore, 1, 1, sub, symRef);
+   block->prepend(TR::TreeTop::create(_comp, store));
+   }
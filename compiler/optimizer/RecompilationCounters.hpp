@@ -0,0 +1,68 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef RECOMPILATIONCOUNTERS_INCL
+#define RECOMPILATIONCOUNTERS_INCL
+
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+
+class TR_BitVector;
+namespace TR { class Block; }
+namespace TR { class Compilation; }
+
+/**
+ * Class TR_RecompilationCounters
+ * ==============================
+ *
+ * Instruments the first tier body of a tiered compilation. Runs right after
+ * IL generation, when the compilation has been given a recompilation
+ * counter, and makes the body decrement that counter
+ *
+ *  - once per invocation, at the start of the first block, unless
+ *    disableTieredInvocationCounters is set, and
+ *  - once per loop iteration, at the start of every block that is the
+ *    target of a back edge, unless disableTieredBackedgeCounters is set.
+ *
+ * The runtime that owns the counter recompiles the method once it is no
+ * longer positive. Decrements are not atomic, so racing threads may lose a
+ * few of them, which only delays the recompilation slightly.
+ */
+class TR_RecompilationCounters
+   {
+   public:
+   TR_ALLOC(TR_Memory::Optimizer)
+
+   TR_RecompilationCounters(TR::Compilation *comp, int32_t *counter);
+
+   void perform();
+
+   private:
+
+   void findLoopHeaders(TR_BitVector &headers);
+   void addDecrement(TR::Block *block);
+
+   TR::Compilation *_comp;
+   int32_t *_counter;
+   bool _trace;
+   };
+
+#endif
@@ -2552,6 +2552,13 @@ TR_RegisterCandidates::assign(TR::Block ** cfgBlocks, int32_t numberOfBlocks, in
          continue;
          }
 
+      if (dt.isVector() && dt.getVectorLength() != TR::VectorLength128)
+         {
+         if (trace)
+            traceMsg(comp(),"Leaving candidate because global registers are only provided for 128-bit vectors\n");
+         continue;
+         }
+
       // don't put this auto into a global register if it can be accessed from a catch clause
       //
       temp = rc->getBlocksLiveOnEntry();
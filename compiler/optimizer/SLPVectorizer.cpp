@@ -0,0 +1,936 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/SLPVectorizer.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Assert.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Checklist.hpp"
+#include "infra/List.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "ras/Debug.hpp"
+
+#define OPT_DETAILS "O^O SLP VECTORIZER: "
+
+// Upper bound on the number of trees a group of stores may span
+#define MAX_GROUP_SPAN 64
+
+// Upper bound on the depth of the expressions packed below a store
+#define MAX_PACK_DEPTH 8
+
+// Upper bound on the stores to one base considered together
+#define MAX_RUN_LENGTH 64
+
+TR_SLPVectorizer::TR_SLPVectorizer(TR::OptimizationManager *manager)
+   : TR::Optimization(manager),
+     _block(NULL),
+     _blockEnd(NULL),
+     _storedSymRefs(NULL)
+   {}
+
+bool
+TR_SLPVectorizer::shouldPerform()
+   {
+   if (comp()->getOption(TR_DisableAutoSIMD))
+      return false;
+
+   if (!comp()->cg()->getSupportsAutoSIMD())
+      return false;
+
+   // Lane offsets are folded into 64-bit address arithmetic
+   return comp()->target().is64Bit();
+   }
+
+int32_t
+TR_SLPVectorizer::perform()
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   _storedSymRefs = new (trStackMemory()) TR_BitVector(comp()->getSymRefTab()->getNumSymRefs(), trMemory(), stackAlloc, growable);
+
+   if (trace())
+      {
+      traceMsg(comp(), "Starting SLPVectorizer\n");
+      comp()->dumpMethodTrees("Trees before SLPVectorizer");
+      }
+
+   int32_t numGroups = 0;
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      TR::Block *block = tt->getNode()->getBlock();
+      numGroups += vectorizeBlock(block);
+      tt = block->getExit();
+      }
+
+   if (numGroups > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      optimizer()->setAliasSetsAreValid(false);
+      requestOpt(OMR::deadTreesElimination);
+      }
+
+   if (trace())
+      {
+      comp()->dumpMethodTrees("Trees after SLPVectorizer");
+      traceMsg(comp(), "Ending SLPVectorizer, packed %d groups of stores\n", numGroups);
+      }
+
+   return numGroups;
+   }
+
+const char *
+TR_SLPVectorizer::optDetailString() const throw()
+   {
+   return "O^O SLP VECTORIZER: ";
+   }
+
+/**
+ * Collect the candidate stores of \p block, split them into runs of
+ * adjacent stores to the same base and try to pack every run, widest
+ * vector first.
+ */
+int32_t
+TR_SLPVectorizer::vectorizeBlock(TR::Block *block)
+   {
+   if (block->isCold())
+      return 0;
+
+   _block = block;
+   _blockEnd = block->getExit();
+   for (TR::Block *next = block->getNextBlock(); next && next->isExtensionOfPreviousBlock(); next = next->getNextBlock())
+      _blockEnd = next->getExit();
+
+   _storedSymRefs->empty();
+   TR_ScratchList<Lane> candidates(trMemory());
+   ListAppender<Lane> candidatesAppender(&candidates);
+   int32_t position = 0;
+   for (TR::TreeTop *tt = block->getFirstRealTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop(), position++)
+      {
+      TR::Node *store = tt->getNode()->getStoreNode();
+      if (store && store->getOpCode().isStoreDirect())
+         _storedSymRefs->set(store->getSymbolReference()->getReferenceNumber());
+
+      TR::Node *node = tt->getNode();
+      if (!isCandidateStore(node))
+         continue;
+
+      Lane *lane = new (trStackMemory()) Lane();
+      lane->_tree = tt;
+      lane->_position = position;
+      lane->_considered = false;
+      if (!decomposeAddress(node, lane->_base, lane->_offset))
+         continue;
+
+      candidatesAppender.add(lane);
+      }
+
+   int32_t numGroups = 0;
+   Lane *run[MAX_RUN_LENGTH];
+   ListIterator<Lane> it(&candidates);
+   for (Lane *lane = it.getFirst(); lane; lane = it.getNext())
+      {
+      if (lane->_considered)
+         continue;
+
+      // Every unconsidered store of the same type to the same base, sorted by offset
+      TR::DataType dt = lane->_tree->getNode()->getDataType();
+      int32_t runLength = 0;
+      ListIterator<Lane> ri(&candidates);
+      for (Lane *other = ri.getFirst(); other && runLength < MAX_RUN_LENGTH; other = ri.getNext())
+         {
+         if (other->_considered ||
+             other->_tree->getNode()->getDataType() != dt ||
+             !isSameBase(lane->_base, other->_base))
+            continue;
+
+         other->_considered = true;
+         int32_t i = runLength++;
+         for (; i > 0 && run[i - 1]->_offset > other->_offset; i--)
+            run[i] = run[i - 1];
+         run[i] = other;
+         }
+
+      int32_t elementSize = TR::DataType::getSize(dt);
+      for (int32_t start = 0; start < runLength; )
+         {
+         bool packed = false;
+         for (int32_t length = TR::VectorLength512; length >= TR::VectorLength128 && !packed; length--)
+            {
+            int32_t numLanes = TR::DataType::getVectorSize((TR::VectorLength)length) / elementSize;
+            if (numLanes > MAX_LANES || start + numLanes > runLength)
+               continue;
+
+            bool isAdjacent = true;
+            for (int32_t i = 1; i < numLanes && isAdjacent; i++)
+               isAdjacent = run[start + i]->_offset == run[start]->_offset + i * elementSize;
+            if (!isAdjacent)
+               continue;
+
+            Group group(trMemory());
+            group._elementType = dt;
+            group._length = (TR::VectorLength)length;
+            group._numLanes = numLanes;
+            for (int32_t i = 0; i < numLanes; i++)
+               group._lanes[i] = run[start + i];
+
+            packed = vectorizeGroup(group);
+            if (packed)
+               {
+               start += numLanes;
+               numGroups++;
+               }
+            }
+
+         if (!packed)
+            start++;
+         }
+      }
+
+   return numGroups;
+   }
+
+/**
+ * Analyze one group of adjacent stores and transform it if it is safe and
+ * profitable.
+ */
+bool
+TR_SLPVectorizer::vectorizeGroup(Group &group)
+   {
+   if (!supportsVectorOp(group, TR::vstorei))
+      return false;
+
+   Lane *first = group._lanes[0];
+   Lane *last = group._lanes[0];
+   for (int32_t i = 1; i < group._numLanes; i++)
+      {
+      if (group._lanes[i]->_position < first->_position)
+         first = group._lanes[i];
+      if (group._lanes[i]->_position > last->_position)
+         last = group._lanes[i];
+      }
+
+   if (last->_position - first->_position > MAX_GROUP_SPAN)
+      return false;
+
+   group._first = first;
+   group._last = last;
+
+   // Removing the scalar stores saves all but one store
+   group._benefit = group._numLanes - 1;
+   group._cost = 0;
+
+   TR::Node *values[MAX_LANES];
+   for (int32_t i = 0; i < group._numLanes; i++)
+      values[i] = group._lanes[i]->_tree->getNode()->getSecondChild();
+
+   group._root = analyzePack(group, values, 0);
+   if (!group._root)
+      return false;
+
+   if (!isSafeToMove(group))
+      {
+      if (trace())
+         traceMsg(comp(), "Group of %d stores at n%dn is not safe to move to n%dn\n", group._numLanes,
+            group._lanes[0]->_tree->getNode()->getGlobalIndex(), group._last->_tree->getNode()->getGlobalIndex());
+      return false;
+      }
+
+   RefCountMap unpacked(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+   if (!checkExternalReferences(group, unpacked))
+      {
+      if (trace())
+         traceMsg(comp(), "Group of %d stores at n%dn uses scalars that cannot be unpacked\n", group._numLanes,
+            group._lanes[0]->_tree->getNode()->getGlobalIndex());
+      return false;
+      }
+
+   if (group._benefit <= group._cost)
+      {
+      if (trace())
+         traceMsg(comp(), "Group of %d stores at n%dn is not profitable: saves %d, costs %d\n", group._numLanes,
+            group._lanes[0]->_tree->getNode()->getGlobalIndex(), group._benefit, group._cost);
+      return false;
+      }
+
+   if (!performTransformation(comp(), "%sPacking %d stores of type %s starting at n%dn in block_%d\n", OPT_DETAILS,
+         group._numLanes, TR::DataType::getName(group._elementType), group._lanes[0]->_tree->getNode()->getGlobalIndex(), _block->getNumber()))
+      return false;
+
+   transformGroup(group, unpacked);
+   return true;
+   }
+
+bool
+TR_SLPVectorizer::isCandidateStore(TR::Node *node)
+   {
+   if (!node->getOpCode().isStoreIndirect() || node->getOpCode().isWrtBar() || node->getNumChildren() != 2)
+      return false;
+
+   TR::DataType dt = node->getDataType();
+   if (dt != TR::Int32 && dt != TR::Int64 && dt != TR::Float && dt != TR::Double)
+      return false;
+
+   return !node->getSymbol()->isVolatile() && !node->getSymbolReference()->isUnresolved();
+   }
+
+/**
+ * Split the address of an indirect access into a base node and a constant
+ * byte offset, folding a constant `aladd`/`aiadd` into the offset.
+ */
+bool
+TR_SLPVectorizer::decomposeAddress(TR::Node *access, TR::Node *&base, int64_t &offset)
+   {
+   TR::Node *address = access->getFirstChild();
+   offset = access->getSymbolReference()->getOffset();
+   base = address;
+
+   if ((address->getOpCodeValue() == TR::aladd || address->getOpCodeValue() == TR::aiadd) &&
+       address->getSecondChild()->getOpCode().isLoadConst())
+      {
+      base = address->getFirstChild();
+      TR::Node *constant = address->getSecondChild();
+      offset += constant->getOpCodeValue() == TR::lconst ? constant->getLongInt() : constant->getInt();
+      }
+
+   return base->getDataType() == TR::Address;
+   }
+
+/**
+ * Whether two base nodes are known to hold the same address: the same
+ * node, the address of the same local, or loads of a local that is not
+ * stored in the block.
+ */
+bool
+TR_SLPVectorizer::isSameBase(TR::Node *first, TR::Node *second)
+   {
+   if (first == second)
+      return true;
+
+   if (first->getOpCodeValue() != second->getOpCodeValue() ||
+       !first->getOpCode().hasSymbolReference() ||
+       first->getSymbolReference() != second->getSymbolReference())
+      return false;
+
+   if (first->getOpCodeValue() == TR::loadaddr)
+      return true;
+
+   return first->getOpCodeValue() == TR::aload &&
+          first->getSymbol()->isAutoOrParm() &&
+          !_storedSymRefs->get(first->getSymbolReference()->getReferenceNumber());
+   }
+
+bool
+TR_SLPVectorizer::supportsVectorOp(Group &group, TR::ILOpCodes op)
+   {
+   return comp()->cg()->getSupportsVectorLengthForAutoSIMD(group._length, TR::ILOpCode(op), group._elementType);
+   }
+
+TR::ILOpCodes
+TR_SLPVectorizer::vectorOpFor(TR::Node *node)
+   {
+   switch (node->getOpCodeValue())
+      {
+      case TR::iadd: case TR::ladd: case TR::fadd: case TR::dadd:
+         return TR::vadd;
+      case TR::isub: case TR::lsub: case TR::fsub: case TR::dsub:
+         return TR::vsub;
+      case TR::imul: case TR::lmul: case TR::fmul: case TR::dmul:
+         return TR::vmul;
+      case TR::fdiv: case TR::ddiv:
+         return TR::vdiv;
+      case TR::iand: case TR::land:
+         return TR::vand;
+      case TR::ior: case TR::lor:
+         return TR::vor;
+      case TR::ixor: case TR::lxor:
+         return TR::vxor;
+      default:
+         return TR::BadILOp;
+      }
+   }
+
+/**
+ * Whether \p lanes are non-volatile indirect loads of consecutive elements
+ * off one base, in lane order.
+ */
+bool
+TR_SLPVectorizer::isAdjacentLoads(Group &group, TR::Node **lanes)
+   {
+   TR::Node *firstBase = NULL;
+   int64_t firstOffset = 0;
+   int32_t elementSize = TR::DataType::getSize(group._elementType);
+   for (int32_t i = 0; i < group._numLanes; i++)
+      {
+      TR::Node *load = lanes[i];
+      if (!load->getOpCode().isLoadIndirect() ||
+          load->getNumChildren() != 1 ||
+          load->getSymbol()->isVolatile() ||
+          load->getSymbolReference()->isUnresolved())
+         return false;
+
+      TR::Node *base;
+      int64_t offset;
+      if (!decomposeAddress(load, base, offset))
+         return false;
+
+      if (i == 0)
+         {
+         firstBase = base;
+         firstOffset = offset;
+         }
+      else if (!isSameBase(firstBase, base) || offset != firstOffset + i * elementSize)
+         {
+         return false;
+         }
+      }
+
+   return true;
+   }
+
+TR_SLPVectorizer::Pack *
+TR_SLPVectorizer::findPack(Group &group, TR::Node **lanes)
+   {
+   ListIterator<Pack> it(&group._packs);
+   for (Pack *pack = it.getFirst(); pack; pack = it.getNext())
+      {
+      bool isSame = true;
+      for (int32_t i = 0; i < group._numLanes && isSame; i++)
+         isSame = pack->_lanes[i] == lanes[i];
+      if (isSame)
+         return pack;
+      }
+   return NULL;
+   }
+
+/**
+ * Decide how the scalar values in \p lanes become one vector, recursing
+ * into the operands of isomorphic operations, and account for the scalar
+ * operations saved and the packing operations added.
+ */
+TR_SLPVectorizer::Pack *
+TR_SLPVectorizer::analyzePack(Group &group, TR::Node **lanes, int32_t depth)
+   {
+   Pack *pack = findPack(group, lanes);
+   if (pack)
+      return pack;
+
+   bool isSplat = true;
+   bool isIsomorphic = true;
+   for (int32_t i = 0; i < group._numLanes; i++)
+      {
+      if (lanes[i]->getDataType() != group._elementType)
+         return NULL;
+
+      isSplat = isSplat && lanes[i] == lanes[0];
+      isIsomorphic = isIsomorphic && lanes[i]->getOpCodeValue() == lanes[0]->getOpCodeValue();
+      }
+
+   pack = new (trStackMemory()) Pack();
+   for (int32_t i = 0; i < group._numLanes; i++)
+      pack->_lanes[i] = lanes[i];
+   pack->_children[0] = NULL;
+   pack->_children[1] = NULL;
+   pack->_vector = NULL;
+
+   TR::ILOpCodes op = vectorOpFor(lanes[0]);
+   if (isSplat && supportsVectorOp(group, TR::vsplats))
+      {
+      pack->_kind = SplatPack;
+      group._cost += 1;
+      }
+   else if (isAdjacentLoads(group, lanes) && supportsVectorOp(group, TR::vloadi))
+      {
+      pack->_kind = LoadPack;
+      group._benefit += group._numLanes - 1;
+      }
+   else if (isIsomorphic && op != TR::BadILOp && depth < MAX_PACK_DEPTH && supportsVectorOp(group, op))
+      {
+      pack->_kind = OpPack;
+      group._benefit += group._numLanes - 1;
+      for (int32_t c = 0; c < 2; c++)
+         {
+         TR::Node *operands[MAX_LANES];
+         for (int32_t i = 0; i < group._numLanes; i++)
+            operands[i] = lanes[i]->getChild(c);
+
+         pack->_children[c] = analyzePack(group, operands, depth + 1);
+         if (!pack->_children[c])
+            return NULL;
+         }
+      }
+   else if (supportsVectorOp(group, TR::vload))
+      {
+      pack->_kind = GatherPack;
+      group._cost += group._numLanes + 1;
+      }
+   else
+      {
+      return NULL;
+      }
+
+   group._packs.add(pack);
+   return pack;
+   }
+
+bool
+TR_SLPVectorizer::isLaneTree(Group &group, TR::TreeTop *tt)
+   {
+   for (int32_t i = 0; i < group._numLanes; i++)
+      {
+      if (group._lanes[i]->_tree == tt)
+         return true;
+      }
+   return false;
+   }
+
+/**
+ * The vector store is placed at the last store of the group, so every
+ * scalar store moves down to it and every packed value is evaluated there.
+ * Check that nothing between the first and the last store makes that
+ * observable: no calls, checks or exception points may intervene, no
+ * intervening tree may write memory a lane reads or touch memory a lane
+ * writes, and no lane may read memory an earlier lane writes.
+ */
+bool
+TR_SLPVectorizer::isSafeToMove(Group &group)
+   {
+   TR::TreeTop *firstTree = group._first->_tree;
+   TR::TreeTop *lastTree = group._last->_tree;
+
+   for (TR::TreeTop *tt = firstTree; tt != lastTree->getNextTreeTop(); tt = tt->getNextTreeTop())
+      {
+      TR::NodeChecklist visited(comp());
+      if (hasSideEffects(tt->getNode(), visited))
+         return false;
+      }
+
+   for (int32_t i = 0; i < group._numLanes; i++)
+      {
+      TR::TreeTop *laneTree = group._lanes[i]->_tree;
+      TR::Node *laneStore = laneTree->getNode();
+
+      TR_ScratchList<TR::Node> laneReads(trMemory());
+      TR_ScratchList<TR::Node> laneWrites(trMemory());
+      TR::NodeChecklist laneVisited(comp());
+      collectMemoryReferences(laneStore->getFirstChild(), laneReads, laneWrites, laneVisited);
+      collectMemoryReferences(laneStore->getSecondChild(), laneReads, laneWrites, laneVisited);
+
+      for (TR::TreeTop *tt = laneTree->getNextTreeTop(); tt != lastTree->getNextTreeTop(); tt = tt->getNextTreeTop())
+         {
+         TR_ScratchList<TR::Node> reads(trMemory());
+         TR_ScratchList<TR::Node> writes(trMemory());
+         TR::NodeChecklist visited(comp());
+         if (isLaneTree(group, tt))
+            {
+            // A later lane must not read what this lane stores
+            collectMemoryReferences(tt->getNode()->getFirstChild(), reads, writes, visited);
+            collectMemoryReferences(tt->getNode()->getSecondChild(), reads, writes, visited);
+            ListIterator<TR::Node> ri(&reads);
+            for (TR::Node *read = ri.getFirst(); read; read = ri.getNext())
+               {
+               if (mayConflict(laneStore, read))
+                  return false;
+               }
+            continue;
+            }
+
+         collectMemoryReferences(tt->getNode(), reads, writes, visited);
+
+         // The intervening tree must not write what this lane reads...
+         ListIterator<TR::Node> wi(&writes);
+         for (TR::Node *write = wi.getFirst(); write; write = wi.getNext())
+            {
+            ListIterator<TR::Node> li(&laneReads);
+            for (TR::Node *read = li.getFirst(); read; read = li.getNext())
+               {
+               if (mayConflict(write, read))
+                  return false;
+               }
+
+            if (mayConflict(laneStore, write))
+               return false;
+            }
+
+         // ...or read what this lane stores
+         ListIterator<TR::Node> ri(&reads);
+         for (TR::Node *read = ri.getFirst(); read; read = ri.getNext())
+            {
+            if (mayConflict(laneStore, read))
+               return false;
+            }
+         }
+      }
+
+   return true;
+   }
+
+bool
+TR_SLPVectorizer::hasSideEffects(TR::Node *node, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return false;
+   visited.add(node);
+
+   TR::ILOpCode &op = node->getOpCode();
+   if (op.isCall() || op.isCheck() || op.isBranch() || op.isReturn() || op.isJumpWithMultipleTargets() || op.canRaiseException())
+      return true;
+
+   if (op.hasSymbolReference() && node->getSymbolReference() && node->getSymbol()->isVolatile())
+      return true;
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (hasSideEffects(node->getChild(i), visited))
+         return true;
+      }
+
+   return false;
+   }
+
+void
+TR_SLPVectorizer::collectMemoryReferences(TR::Node *node, TR_ScratchList<TR::Node> &reads, TR_ScratchList<TR::Node> &writes, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return;
+   visited.add(node);
+
+   if (node->getOpCode().isStore() || node->getOpCode().isStoreReg())
+      writes.add(node);
+   else if (node->getOpCode().isLoadVar() || node->getOpCode().isLoadReg())
+      reads.add(node);
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      collectMemoryReferences(node->getChild(i), reads, writes, visited);
+   }
+
+/**
+ * Whether \p write may overwrite what \p access reads or writes. Accesses
+ * off the same base compare their byte ranges, everything else is left to
+ * the alias sets.
+ */
+bool
+TR_SLPVectorizer::mayConflict(TR::Node *write, TR::Node *access)
+   {
+   bool writeIsReg = write->getOpCode().isStoreReg();
+   bool accessIsReg = access->getOpCode().isLoadReg() || access->getOpCode().isStoreReg();
+   if (writeIsReg || accessIsReg)
+      {
+      return writeIsReg && accessIsReg &&
+             (write->getLowGlobalRegisterNumber() == access->getLowGlobalRegisterNumber() ||
+              write->getHighGlobalRegisterNumber() == access->getLowGlobalRegisterNumber() ||
+              (access->getHighGlobalRegisterNumber() != (TR_GlobalRegisterNumber)-1 &&
+               (write->getLowGlobalRegisterNumber() == access->getHighGlobalRegisterNumber() ||
+                write->getHighGlobalRegisterNumber() == access->getHighGlobalRegisterNumber())));
+      }
+
+   if (write->getOpCode().isIndirect() && access->getOpCode().isIndirect())
+      {
+      TR::Node *writeBase, *accessBase;
+      int64_t writeOffset, accessOffset;
+      if (decomposeAddress(write, writeBase, writeOffset) &&
+          decomposeAddress(access, accessBase, accessOffset) &&
+          isSameBase(writeBase, accessBase))
+         return writeOffset < accessOffset + access->getSize() && accessOffset < writeOffset + write->getSize();
+      }
+
+   if (write->getSymbolReference() == access->getSymbolReference())
+      return true;
+
+   return write->mayKill().contains(access->getSymbolReference(), comp());
+   }
+
+/**
+ * Count the references to every node below \p node from parents that have
+ * not been visited yet.
+ */
+void
+TR_SLPVectorizer::countReferences(TR::Node *node, RefCountMap &counts, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return;
+   visited.add(node);
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      TR::Node *child = node->getChild(i);
+      counts[child]++;
+      countReferences(child, counts, visited);
+      }
+   }
+
+/**
+ * Removing the scalar stores changes where the nodes below them are first
+ * evaluated. Address nodes other than the base the vector accesses reuse
+ * must not be used outside the group. Packed loads and operations that
+ * are used outside the group are unpacked with getvelem, which is only
+ * possible when all those uses follow the vector store. They are returned
+ * in \p unpacked with their number of outside references.
+ */
+bool
+TR_SLPVectorizer::checkExternalReferences(Group &group, RefCountMap &unpacked)
+   {
+   RefCountMap internal(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+   TR::NodeChecklist visited(comp());
+   for (int32_t i = 0; i < group._numLanes; i++)
+      countReferences(group._lanes[i]->_tree->getNode(), internal, visited);
+
+   TR::Node *storeBase = group._lanes[0]->_base;
+   for (int32_t i = 0; i < group._numLanes; i++)
+      {
+      if (isUsedOutside(group._lanes[i]->_tree->getNode()->getFirstChild(), storeBase, internal))
+         return false;
+      }
+
+   ListIterator<Pack> it(&group._packs);
+   for (Pack *pack = it.getFirst(); pack; pack = it.getNext())
+      {
+      if (pack->_kind != LoadPack && pack->_kind != OpPack)
+         continue;
+
+      TR::Node *loadBase = NULL;
+      int64_t loadOffset;
+      if (pack->_kind == LoadPack)
+         decomposeAddress(pack->_lanes[0], loadBase, loadOffset);
+
+      for (int32_t i = 0; i < group._numLanes; i++)
+         {
+         TR::Node *lane = pack->_lanes[i];
+         if (pack->_kind == LoadPack && isUsedOutside(lane->getFirstChild(), loadBase, internal))
+            return false;
+
+         int32_t outside = lane->getReferenceCount() - internal[lane];
+         if (outside > 0)
+            unpacked[lane] = outside;
+         }
+      }
+
+   if (unpacked.empty())
+      return true;
+
+   if (!supportsVectorOp(group, TR::getvelem))
+      return false;
+
+   RefCountMap after(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+   TR::NodeChecklist afterVisited(comp());
+   for (TR::TreeTop *tt = group._last->_tree->getNextTreeTop(); tt != _blockEnd; tt = tt->getNextTreeTop())
+      countReferences(tt->getNode(), after, afterVisited);
+
+   for (RefCountMap::iterator u = unpacked.begin(); u != unpacked.end(); ++u)
+      {
+      if (after[u->first] != u->second)
+         return false;
+      }
+
+   group._cost += (int32_t)unpacked.size();
+   return true;
+   }
+
+/**
+ * Whether the address \p address of a lane, or the base below it, is used
+ * outside the group. The base \p keptBase stays referenced by the vector
+ * access and may be shared.
+ */
+bool
+TR_SLPVectorizer::isUsedOutside(TR::Node *address, TR::Node *keptBase, RefCountMap &internal)
+   {
+   if (address == keptBase)
+      return false;
+
+   if (address->getReferenceCount() > internal[address])
+      return true;
+
+   if ((address->getOpCodeValue() == TR::aladd || address->getOpCodeValue() == TR::aiadd) &&
+       address->getSecondChild()->getOpCode().isLoadConst())
+      {
+      TR::Node *base = address->getFirstChild();
+      return base != keptBase && base->getReferenceCount() > internal[base];
+      }
+
+   return false;
+   }
+
+/**
+ * Build the vector trees for \p group after its last store, unpack the
+ * lanes used later on and remove the scalar stores.
+ */
+void
+TR_SLPVectorizer::transformGroup(Group &group, RefCountMap &unpacked)
+   {
+   Lane *firstLane = group._lanes[0];
+   TR::Node *firstStore = firstLane->_tree->getNode();
+   TR::SymbolReference *vectorShadow = comp()->getSymRefTab()->findOrCreateArrayShadowSymbolRef(
+      group._elementType.scalarToVector(group._length), NULL);
+
+   TR::TreeTop *insertionPoint = group._last->_tree;
+   TR::Node *value = buildPack(group, group._root, insertionPoint);
+   TR::Node *vectorStore = TR::Node::createWithSymRef(TR::vstorei, 2, 2,
+      createAddress(firstStore, firstLane->_base, firstLane->_offset),
+      value,
+      vectorShadow);
+   insertionPoint = TR::TreeTop::create(comp(), insertionPoint, vectorStore);
+
+   if (!unpacked.empty())
+      unpackLanes(group, unpacked, insertionPoint->getNextTreeTop());
+
+   for (int32_t i = 0; i < group._numLanes; i++)
+      group._lanes[i]->_tree->unlink(true);
+   }
+
+TR::Node *
+TR_SLPVectorizer::buildPack(Group &group, Pack *pack, TR::TreeTop *&insertionPoint)
+   {
+   if (pack->_vector)
+      return pack->_vector;
+
+   TR::DataType vectorType = group._elementType.scalarToVector(group._length);
+   TR::Node *lane = pack->_lanes[0];
+   switch (pack->_kind)
+      {
+      case LoadPack:
+         {
+         TR::Node *base;
+         int64_t offset;
+         decomposeAddress(lane, base, offset);
+         pack->_vector = TR::Node::createWithSymRef(TR::vloadi, 1, 1,
+            createAddress(lane, base, offset),
+            comp()->getSymRefTab()->findOrCreateArrayShadowSymbolRef(vectorType, NULL));
+         break;
+         }
+      case OpPack:
+         {
+         TR::Node *first = buildPack(group, pack->_children[0], insertionPoint);
+         TR::Node *second = buildPack(group, pack->_children[1], insertionPoint);
+         pack->_vector = TR::Node::create(vectorOpFor(lane), 2, first, second);
+         break;
+         }
+      case SplatPack:
+         {
+         pack->_vector = TR::Node::create(TR::vsplats, 1, lane);
+         pack->_vector->setDataType(vectorType);
+         break;
+         }
+      case GatherPack:
+         {
+         // No vector opcode inserts a scalar into a lane, so gather through a vector temporary
+         TR::SymbolReference *temp = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), vectorType);
+         TR::SymbolReference *elementShadow = comp()->getSymRefTab()->findOrCreateArrayShadowSymbolRef(group._elementType, NULL);
+         int32_t elementSize = TR::DataType::getSize(group._elementType);
+         for (int32_t i = 0; i < group._numLanes; i++)
+            {
+            TR::Node *address = createAddress(lane, TR::Node::createWithSymRef(lane, TR::loadaddr, 0, temp), i * elementSize);
+            TR::Node *store = TR::Node::createWithSymRef(comp()->il.opCodeForIndirectStore(group._elementType), 2, 2,
+               address, pack->_lanes[i], elementShadow);
+            insertionPoint = TR::TreeTop::create(comp(), insertionPoint, store);
+            }
+         pack->_vector = TR::Node::createLoad(lane, temp);
+         break;
+         }
+      }
+
+   return pack->_vector;
+   }
+
+TR::Node *
+TR_SLPVectorizer::createAddress(TR::Node *originatingNode, TR::Node *base, int64_t offset)
+   {
+   if (offset == 0)
+      return base;
+   return TR::Node::create(TR::aladd, 2, base, TR::Node::lconst(originatingNode, offset));
+   }
+
+/**
+ * Replace the references to unpacked lanes in the trees from \p start to
+ * the end of the extended block with getvelem of their vector.
+ */
+void
+TR_SLPVectorizer::unpackLanes(Group &group, RefCountMap &unpacked, TR::TreeTop *start)
+   {
+   NodeMap elements(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+   ListIterator<Pack> it(&group._packs);
+   for (Pack *pack = it.getFirst(); pack; pack = it.getNext())
+      {
+      if ((pack->_kind != LoadPack && pack->_kind != OpPack) || !pack->_vector)
+         continue;
+
+      for (int32_t i = 0; i < group._numLanes; i++)
+         {
+         TR::Node *lane = pack->_lanes[i];
+         if (unpacked.find(lane) == unpacked.end() || elements.find(lane) != elements.end())
+            continue;
+
+         // getvelem numbers the elements from the most significant end, so
+         // the lane at the lowest address is the last element
+         elements[lane] = TR::Node::create(TR::getvelem, 2, pack->_vector, TR::Node::iconst(lane, group._numLanes - 1 - i));
+         if (trace())
+            traceMsg(comp(), "Unpacking n%dn from lane %d of n%dn\n", lane->getGlobalIndex(), i, pack->_vector->getGlobalIndex());
+         }
+      }
+
+   TR::NodeChecklist visited(comp());
+   for (TR::TreeTop *tt = start; tt != _blockEnd; tt = tt->getNextTreeTop())
+      replaceUnpackedLanes(tt->getNode(), elements, visited);
+   }
+
+void
+TR_SLPVectorizer::replaceUnpackedLanes(TR::Node *node, NodeMap &elements, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return;
+   visited.add(node);
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      TR::Node *child = node->getChild(i);
+      NodeMap::iterator element = elements.find(child);
+      if (element != elements.end())
+         {
+         node->setAndIncChild(i, element->second);
+         child->decReferenceCount();
+         }
+      else
+         {
+         replaceUnpackedLanes(child, elements, visited);
+         }
+      }
+   }
@@ -0,0 +1,186 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef SLPVECTORIZER_INCL
+#define SLPVECTORIZER_INCL
+
+#include <map>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "env/TypedAllocator.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "infra/List.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_BitVector;
+namespace TR { class Block; }
+namespace TR { class Node; }
+namespace TR { class NodeChecklist; }
+namespace TR { class Optimization; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/**
+ * Class TR_SLPVectorizer
+ * ======================
+ *
+ * The superword-level parallelism vectorizer packs isomorphic scalar
+ * operations of straight-line code into vector IL. Within each block it
+ * looks for indirect stores of the same type to adjacent addresses off the
+ * same base, such as
+ *
+ *    istorei <offset 0> (base) (iadd (iloadi <offset 0> (src)) (x))
+ *    istorei <offset 4> (base) (iadd (iloadi <offset 4> (src)) (y))
+ *    istorei <offset 8> (base) ...
+ *
+ * and replaces one vector's worth of them with a single vstorei. The stored
+ * values are packed lane by lane, from the stores down:
+ *
+ *  - lanes that are indirect loads of adjacent addresses off one base
+ *    become a vloadi,
+ *  - lanes with the same add/sub/mul/div/and/or/xor opcode become the
+ *    vector opcode over packs of their children,
+ *  - lanes that are all the same node become a vsplats, and
+ *  - anything else is gathered by storing the lanes to a vector temporary
+ *    and loading it back.
+ *
+ * Packed scalars that are still used after the group are unpacked from
+ * the vector with getvelem. A group is only transformed when the scalar
+ * operations it removes outnumber the splats, gathers and unpacks it adds.
+ *
+ * The vector store is placed at the last store of the group, so every
+ * scalar load in the group is checked against the stores it moves past
+ * using the node alias sets, and adjacent accesses off the same base are
+ * compared by offset. Calls, checks and branches end a group.
+ *
+ * Only operations the code generator reports through
+ * getSupportsVectorLengthForAutoSIMD are generated. The vector store symbol
+ * references do not alias the scalar shadows they replace, so the pass runs
+ * late, after the optimizations that rely on those aliases.
+ */
+
+class TR_SLPVectorizer : public TR::Optimization
+   {
+   public:
+   TR_SLPVectorizer(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_SLPVectorizer(manager);
+      }
+
+   virtual bool    shouldPerform();
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   // Most lanes in one vector: 512 bits of 32-bit elements
+   static const int32_t MAX_LANES = 16;
+
+   enum PackKind
+      {
+      LoadPack,     // indirect loads of adjacent elements: vloadi
+      OpPack,       // the same operation in every lane: vector operation over packed operands
+      SplatPack,    // the same node in every lane: vsplats
+      GatherPack    // anything else: stored to a vector temporary and loaded back
+      };
+
+   struct Pack
+      {
+      TR_ALLOC(TR_Memory::LocalOpts)
+
+      PackKind _kind;
+      TR::Node *_lanes[MAX_LANES];
+      Pack *_children[2];
+      TR::Node *_vector;      // vector node built for the pack
+      };
+
+   struct Lane
+      {
+      TR_ALLOC(TR_Memory::LocalOpts)
+
+      TR::TreeTop *_tree;     // the scalar store
+      TR::Node *_base;
+      int64_t _offset;
+      int32_t _position;      // index of the tree in its block
+      bool _considered;       // already tried as part of a run
+      };
+
+   struct Group
+      {
+      Group(TR_Memory *m)
+         : _elementType(TR::NoType), _length(TR::VectorLength128), _numLanes(0), _first(NULL), _last(NULL),
+           _root(NULL), _packs(m), _benefit(0), _cost(0)
+         {}
+
+      TR::DataType _elementType;
+      TR::VectorLength _length;
+      int32_t _numLanes;
+      Lane *_lanes[MAX_LANES];      // in offset order
+      Lane *_first;                 // earliest store in the block
+      Lane *_last;                  // latest store, where the vector store goes
+      Pack *_root;                  // pack of the stored values
+      TR_ScratchList<Pack> _packs;
+      int32_t _benefit;             // scalar operations removed
+      int32_t _cost;                // packing and unpacking operations added
+      };
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, int32_t>, TR::Region &> RefCountMapAllocator;
+   typedef std::map<TR::Node *, int32_t, std::less<TR::Node *>, RefCountMapAllocator> RefCountMap;
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, TR::Node *>, TR::Region &> NodeMapAllocator;
+   typedef std::map<TR::Node *, TR::Node *, std::less<TR::Node *>, NodeMapAllocator> NodeMap;
+
+   /* analysis */
+   int32_t vectorizeBlock(TR::Block *block);
+   bool vectorizeGroup(Group &group);
+   bool isCandidateStore(TR::Node *node);
+   bool decomposeAddress(TR::Node *access, TR::Node *&base, int64_t &offset);
+   bool isSameBase(TR::Node *first, TR::Node *second);
+   bool supportsVectorOp(Group &group, TR::ILOpCodes op);
+   TR::ILOpCodes vectorOpFor(TR::Node *node);
+   bool isAdjacentLoads(Group &group, TR::Node **lanes);
+   Pack *findPack(Group &group, TR::Node **lanes);
+   Pack *analyzePack(Group &group, TR::Node **lanes, int32_t depth);
+   bool isLaneTree(Group &group, TR::TreeTop *tt);
+   bool isSafeToMove(Group &group);
+   bool hasSideEffects(TR::Node *node, TR::NodeChecklist &visited);
+   void collectMemoryReferences(TR::Node *node, TR_ScratchList<TR::Node> &reads, TR_ScratchList<TR::Node> &writes, TR::NodeChecklist &visited);
+   bool mayConflict(TR::Node *write, TR::Node *access);
+   void countReferences(TR::Node *node, RefCountMap &counts, TR::NodeChecklist &visited);
+   bool checkExternalReferences(Group &group, RefCountMap &unpacked);
+   bool isUsedOutside(TR::Node *address, TR::Node *keptBase, RefCountMap &internal);
+
+   /* transformation */
+   void transformGroup(Group &group, RefCountMap &unpacked);
+   TR::Node *buildPack(Group &group, Pack *pack, TR::TreeTop *&insertionPoint);
+   TR::Node *createAddress(TR::Node *originatingNode, TR::Node *base, int64_t offset);
+   void unpackLanes(Group &group, RefCountMap &unpacked, TR::TreeTop *start);
+   void replaceUnpackedLanes(TR::Node *node, NodeMap &elements, TR::NodeChecklist &visited);
+
+   TR::Block *_block;
+   TR::TreeTop *_blockEnd;            // exit of the extended block the current block belongs to
+   TR_BitVector *_storedSymRefs;      // symbols stored directly in the current block
+   };
+
+#endif
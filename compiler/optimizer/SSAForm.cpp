@@ -0,0 +1,517 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/SSAForm.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Assert.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/CfgNode.hpp"
+#include "infra/Checklist.hpp"
+#include "optimizer/Dominators.hpp"
+#include "ras/Debug.hpp"
+
+// Upper bound on the number of values, beyond which the method is not put in SSA form
+#define MAX_SSA_VALUES 50000
+
+TR_SSAForm::TR_SSAForm(TR::Compilation *comp, TR::Region &region, bool trace)
+   : _comp(comp),
+     _region(region),
+     _trace(trace),
+     _cfg(comp->getFlowGraph()),
+     _numBlocks(comp->getFlowGraph()->getNextNodeNumber()),
+     _blocks(region),
+     _variables(region),
+     _variableForSymRef(std::less<int32_t>(), region),
+     _values(region),
+     _nodeValues(std::less<TR::Node *>(), region),
+     _phis(region),
+     _frontiers(region),
+     _storeBlocks(region)
+   {
+   }
+
+bool
+TR_SSAForm::build()
+   {
+   if (!allBlocksReachable())
+      {
+      if (trace())
+         traceMsg(comp(), "SSA: some blocks are unreachable\n");
+      return false;
+      }
+
+   if (!collectVariables())
+      {
+      if (trace())
+         traceMsg(comp(), "SSA: method has register loads or stores\n");
+      return false;
+      }
+
+   _blocks.resize(_numBlocks, NULL);
+   for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+      _blocks[node->getNumber()] = toBlock(node);
+
+   _phis.resize(_numBlocks, NULL);
+   _frontiers.resize(_numBlocks, NULL);
+   for (int32_t i = 0; i < _numBlocks; i++)
+      {
+      _phis[i] = new (_region) ValueList(_region);
+      _frontiers[i] = new (_region) TR_BitVector(_numBlocks, _region);
+      }
+
+   TR_Dominators dominators(comp());
+   computeDominanceFrontiers(dominators);
+
+   if (!placePhis())
+      {
+      if (trace())
+         traceMsg(comp(), "SSA: too many phis for %d variables and %d blocks\n", getNumVariables(), _numBlocks);
+      return false;
+      }
+
+   rename(dominators);
+
+   if (trace())
+      print();
+
+   return true;
+   }
+
+bool
+TR_SSAForm::allBlocksReachable()
+   {
+   TR_BitVector reached(_numBlocks, _region);
+   TR::vector<TR::CFGNode *, TR::Region&> stack(_region);
+   stack.push_back(_cfg->getStart());
+   reached.set(_cfg->getStart()->getNumber());
+
+   while (!stack.empty())
+      {
+      TR::CFGNode *node = stack.back();
+      stack.pop_back();
+      for (auto e = node->getSuccessors().begin(); e != node->getSuccessors().end(); ++e)
+         {
+         TR::CFGNode *to = (*e)->getTo();
+         if (!reached.isSet(to->getNumber()))
+            {
+            reached.set(to->getNumber());
+            stack.push_back(to);
+            }
+         }
+      for (auto e = node->getExceptionSuccessors().begin(); e != node->getExceptionSuccessors().end(); ++e)
+         {
+         TR::CFGNode *to = (*e)->getTo();
+         if (!reached.isSet(to->getNumber()))
+            {
+            reached.set(to->getNumber());
+            stack.push_back(to);
+            }
+         }
+      }
+
+   // The exit block is not reachable from a method that never returns
+   for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+      {
+      if (node != _cfg->getEnd() && !reached.isSet(node->getNumber()))
+         return false;
+      }
+   return true;
+   }
+
+bool
+TR_SSAForm::collectVariables()
+   {
+   SymbolMap symRefForSymbol(std::less<TR::Symbol *>(), _region);
+   TR::NodeChecklist visited(comp());
+
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      if (!collectVariables(tt->getNode(), symRefForSymbol, visited))
+         return false;
+      }
+
+   for (auto it = symRefForSymbol.begin(); it != symRefForSymbol.end(); ++it)
+      {
+      if (it->second < 0)
+         continue;
+      _variableForSymRef[it->second] = (int32_t)_variables.size();
+      _variables.push_back(comp()->getSymRefTab()->getSymRef(it->second));
+      }
+
+   _storeBlocks.resize(_variables.size(), NULL);
+   for (size_t v = 0; v < _variables.size(); v++)
+      _storeBlocks[v] = new (_region) TR_BitVector(_numBlocks, _region);
+
+   return true;
+   }
+
+bool
+TR_SSAForm::collectVariables(TR::Node *node, SymbolMap &symRefForSymbol, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return true;
+   visited.add(node);
+
+   TR::ILOpCode &op = node->getOpCode();
+   if (op.isLoadReg() || op.isStoreReg())
+      return false;
+
+   if (op.hasSymbolReference() && node->getSymbol()->isAutoOrParm())
+      {
+      TR::Symbol *symbol = node->getSymbol();
+      int32_t refNum = node->getSymbolReference()->getReferenceNumber();
+      auto it = symRefForSymbol.find(symbol);
+
+      if (!op.isLoadVarDirect() && !op.isStoreDirect())
+         symRefForSymbol[symbol] = -1;                  // address taken
+      else if (it == symRefForSymbol.end())
+         symRefForSymbol[symbol] = refNum;
+      else if (it->second != refNum)
+         it->second = -1;                               // aliased by another symbol reference
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!collectVariables(node->getChild(i), symRefForSymbol, visited))
+         return false;
+      }
+   return true;
+   }
+
+int32_t
+TR_SSAForm::variableOf(TR::Node *node)
+   {
+   TR::ILOpCode &op = node->getOpCode();
+   if (!op.isLoadVarDirect() && !op.isStoreDirect())
+      return -1;
+   if (!node->getSymbol()->isAutoOrParm())
+      return -1;
+   auto it = _variableForSymRef.find(node->getSymbolReference()->getReferenceNumber());
+   return it == _variableForSymRef.end() ? -1 : it->second;
+   }
+
+/**
+ * Dominance frontiers as in Cooper, Harvey and Kennedy: walk up the dominator
+ * tree from each predecessor of a merge point until reaching its idom.
+ */
+void
+TR_SSAForm::computeDominanceFrontiers(TR_Dominators &dominators)
+   {
+   for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      TR::Block *idom = dominators.getDominator(block);
+
+      for (int32_t pass = 0; pass < 2; pass++)
+         {
+         TR::CFGEdgeList &preds = pass == 0 ? block->getPredecessors() : block->getExceptionPredecessors();
+         for (auto e = preds.begin(); e != preds.end(); ++e)
+            {
+            TR::Block *runner = toBlock((*e)->getFrom());
+            while (runner && runner != idom)
+               {
+               _frontiers[runner->getNumber()]->set(block->getNumber());
+               runner = dominators.getDominator(runner);
+               }
+            }
+         }
+      }
+   }
+
+TR_SSAForm::Value *
+TR_SSAForm::createValue(Value::Kind kind, int32_t variable, TR::Block *block, TR::Node *store)
+   {
+   Value *value = new (_region) Value(_region, kind, (int32_t)_values.size(), variable, block, store);
+   _values.push_back(value);
+   return value;
+   }
+
+bool
+TR_SSAForm::placePhis()
+   {
+   // Find the blocks storing each variable
+   for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      if (!block->getEntry())
+         continue;
+      for (TR::TreeTop *tt = block->getEntry(); tt != block->getExit(); tt = tt->getNextTreeTop())
+         {
+         int32_t variable = variableOf(tt->getNode());
+         if (variable >= 0 && tt->getNode()->getOpCode().isStoreDirect())
+            _storeBlocks[variable]->set(block->getNumber());
+         }
+      }
+
+   TR_BitVector hasPhi(_numBlocks, _region);
+   TR::vector<int32_t, TR::Region&> worklist(_region);
+
+   for (int32_t variable = 0; variable < getNumVariables(); variable++)
+      {
+      hasPhi.empty();
+      worklist.clear();
+
+      // A handler can be entered from anywhere in the protected blocks, so
+      // every variable is merged at blocks with exception predecessors
+      for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+         {
+         TR::Block *block = toBlock(node);
+         if (block->hasExceptionPredecessors())
+            {
+            Value *phi = createValue(Value::Phi, variable, block, NULL);
+            phi->_isExceptionMerge = true;
+            _phis[block->getNumber()]->push_back(phi);
+            hasPhi.set(block->getNumber());
+            worklist.push_back(block->getNumber());
+            }
+         }
+
+      TR_BitVectorIterator stores(*_storeBlocks[variable]);
+      while (stores.hasMoreElements())
+         worklist.push_back(stores.getNextElement());
+
+      while (!worklist.empty())
+         {
+         int32_t b = worklist.back();
+         worklist.pop_back();
+         TR_BitVectorIterator frontier(*_frontiers[b]);
+         while (frontier.hasMoreElements())
+            {
+            int32_t f = frontier.getNextElement();
+            if (hasPhi.isSet(f) || _blocks[f] == _cfg->getEnd())
+               continue;
+
+            hasPhi.set(f);
+            _phis[f]->push_back(createValue(Value::Phi, variable, _blocks[f], NULL));
+            worklist.push_back(f);
+            }
+         }
+
+      if (getNumValues() > MAX_SSA_VALUES)
+         return false;
+      }
+
+   return true;
+   }
+
+void
+TR_SSAForm::addUse(Value *value, TR::Block *block)
+   {
+   BlockList &uses = value->_uses;
+   if (uses.empty() || uses.back() != block)
+      uses.push_back(block);
+   }
+
+void
+TR_SSAForm::addPhiOperands(TR::Block *block, ValueList &current)
+   {
+   for (auto e = block->getSuccessors().begin(); e != block->getSuccessors().end(); ++e)
+      {
+      TR::Block *succ = toBlock((*e)->getTo());
+      ValueList &phis = *_phis[succ->getNumber()];
+      for (auto p = phis.begin(); p != phis.end(); ++p)
+         {
+         Value *phi = *p;
+         if (phi->isExceptionMerge())
+            continue;
+         Value *operand = current[phi->getVariable()];
+         phi->_operandEdges.push_back(*e);
+         phi->_operands.push_back(operand);
+         addUse(operand, succ);
+         }
+      }
+   }
+
+void
+TR_SSAForm::renameNode(TR::Node *node, TR::Block *block, ValueList &current, ValueList &undo, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return;
+   visited.add(node);
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      renameNode(node->getChild(i), block, current, undo, visited);
+
+   int32_t variable = variableOf(node);
+   if (variable < 0)
+      return;
+
+   if (node->getOpCode().isStoreDirect())
+      {
+      Value *value = createValue(Value::Store, variable, block, node);
+      _nodeValues[node] = value;
+      undo.push_back(current[variable]);
+      current[variable] = value;
+      }
+   else
+      {
+      Value *value = current[variable];
+      _nodeValues[node] = value;
+      addUse(value, block);
+      }
+   }
+
+/**
+ * Rename values by a preorder walk of the dominator tree. The values
+ * replaced while processing a block are pushed on an undo stack and
+ * restored once all the blocks it dominates have been processed.
+ */
+void
+TR_SSAForm::rename(TR_Dominators &dominators)
+   {
+   TR::vector<BlockList *, TR::Region&> children(_numBlocks, static_cast<BlockList *>(NULL), _region);
+   for (TR::CFGNode *node = _cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      TR::Block *idom = dominators.getDominator(block);
+      if (!idom)
+         continue;
+      if (!children[idom->getNumber()])
+         children[idom->getNumber()] = new (_region) BlockList(_region);
+      children[idom->getNumber()]->push_back(block);
+      }
+
+   TR::Block *start = toBlock(_cfg->getStart());
+   ValueList current(_region);
+   for (int32_t variable = 0; variable < getNumVariables(); variable++)
+      current.push_back(createValue(Value::Entry, variable, start, NULL));
+
+   struct WalkItem
+      {
+      TR::Block *block;    // NULL once the subtree has been processed
+      size_t undoMark;
+      };
+   TR::vector<WalkItem, TR::Region&> stack(_region);
+   ValueList undo(_region);
+   TR::NodeChecklist visited(comp());
+
+   WalkItem root = { start, 0 };
+   stack.push_back(root);
+
+   while (!stack.empty())
+      {
+      WalkItem item = stack.back();
+      stack.pop_back();
+
+      if (!item.block)
+         {
+         while (undo.size() > item.undoMark)
+            {
+            Value *previous = undo.back();
+            undo.pop_back();
+            current[previous->getVariable()] = previous;
+            }
+         continue;
+         }
+
+      TR::Block *block = item.block;
+      WalkItem done = { NULL, undo.size() };
+      stack.push_back(done);
+
+      ValueList &phis = *_phis[block->getNumber()];
+      for (auto p = phis.begin(); p != phis.end(); ++p)
+         {
+         undo.push_back(current[(*p)->getVariable()]);
+         current[(*p)->getVariable()] = *p;
+         }
+
+      if (block->getEntry())
+         {
+         for (TR::TreeTop *tt = block->getEntry(); tt != block->getExit(); tt = tt->getNextTreeTop())
+            renameNode(tt->getNode(), block, current, undo, visited);
+         }
+
+      addPhiOperands(block, current);
+
+      BlockList *dominated = children[block->getNumber()];
+      if (dominated)
+         {
+         for (auto c = dominated->begin(); c != dominated->end(); ++c)
+            {
+            WalkItem child = { *c, 0 };
+            stack.push_back(child);
+            }
+         }
+      }
+   }
+
+TR_SSAForm::Value *
+TR_SSAForm::getValue(TR::Node *node)
+   {
+   auto it = _nodeValues.find(node);
+   return it == _nodeValues.end() ? NULL : it->second;
+   }
+
+TR_SSAForm::ValueList &
+TR_SSAForm::getPhis(TR::Block *block)
+   {
+   return *_phis[block->getNumber()];
+   }
+
+void
+TR_SSAForm::print()
+   {
+   traceMsg(comp(), "SSA form: %d variables, %d values\n", getNumVariables(), getNumValues());
+   for (int32_t i = 0; i < getNumVariables(); i++)
+      traceMsg(comp(), "   variable %d is #%d\n", i, _variables[i]->getReferenceNumber());
+
+   for (auto it = _values.begin(); it != _values.end(); ++it)
+      {
+      Value *value = *it;
+      traceMsg(comp(), "   v%d: variable %d in block_%d ", value->getIndex(), value->getVariable(), value->getBlock()->getNumber());
+      switch (value->getKind())
+         {
+         case Value::Entry:
+            traceMsg(comp(), "entry");
+            break;
+         case Value::Store:
+            traceMsg(comp(), "store n%dn", value->getStore()->getGlobalIndex());
+            break;
+         case Value::Phi:
+            if (value->isExceptionMerge())
+               traceMsg(comp(), "exception merge");
+            else
+               {
+               traceMsg(comp(), "phi(");
+               for (int32_t i = 0; i < value->getNumOperands(); i++)
+                  traceMsg(comp(), "%sv%d from block_%d", i ? ", " : "", value->getOperand(i)->getIndex(),
+                     value->getOperandEdge(i)->getFrom()->getNumber());
+               traceMsg(comp(), ")");
+               }
+            break;
+         }
+      traceMsg(comp(), ", used in %d blocks\n", (int32_t)value->getUses().size());
+      }
+   }
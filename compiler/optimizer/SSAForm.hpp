@@ -0,0 +1,192 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef SSAFORM_INCL
+#define SSAFORM_INCL
+
+#include <map>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "env/TypedAllocator.hpp"
+#include "infra/vector.hpp"
+
+class TR_BitVector;
+class TR_Dominators;
+namespace TR { class Block; }
+namespace TR { class CFG; }
+namespace TR { class CFGEdge; }
+namespace TR { class CFGNode; }
+namespace TR { class Compilation; }
+namespace TR { class Node; }
+namespace TR { class NodeChecklist; }
+namespace TR { class Symbol; }
+namespace TR { class SymbolReference; }
+
+/**
+ * Class TR_SSAForm
+ * ================
+ *
+ * Static single assignment form for the auto and parm symbols of a method,
+ * built on top of TR::CFG and TR_Dominators. The tree IL is left unchanged:
+ * every direct store of a tracked symbol defines a new SSA value, every
+ * direct load is mapped to the value that reaches it, and phi values live
+ * in a side table indexed by block.
+ *
+ * A symbol is tracked when it is an auto or parm that is only accessed
+ * through direct loads and stores of a single symbol reference. Symbols
+ * whose address is taken or that have been assigned to a global register
+ * are not tracked.
+ *
+ * Phis are placed on the iterated dominance frontiers of the stores
+ * (Cytron et al.) and values are renamed by a walk of the dominator tree.
+ * Exception edges can leave a block between any two trees, so every
+ * tracked symbol gets a phi at a block with exception predecessors. Those
+ * phis have no operands and are reported by isExceptionMerge().
+ *
+ * Each value also records the blocks that read it, either through a load or
+ * as a phi operand, which lets clients such as sparse conditional constant
+ * propagation revisit only the blocks affected by a change.
+ *
+ * All the data lives in the region passed to the constructor.
+ */
+class TR_SSAForm
+   {
+   public:
+   TR_ALLOC(TR_Memory::UseDefInfo)
+
+   typedef TR::vector<TR::Block *, TR::Region&> BlockList;
+
+   class Value
+      {
+      public:
+      TR_ALLOC(TR_Memory::UseDefInfo)
+
+      enum Kind
+         {
+         Entry,   // value on entry to the method
+         Store,   // value stored by a direct store
+         Phi      // merge of the values flowing into a block
+         };
+
+      Value(TR::Region &region, Kind kind, int32_t index, int32_t variable, TR::Block *block, TR::Node *store)
+         : _kind(kind), _index(index), _variable(variable), _block(block), _store(store),
+           _operandEdges(region), _operands(region), _uses(region), _isExceptionMerge(false)
+         {}
+
+      Kind getKind()                        { return _kind; }
+      int32_t getIndex()                    { return _index; }
+      int32_t getVariable()                 { return _variable; }
+      TR::Block *getBlock()                 { return _block; }
+      TR::Node *getStore()                  { return _store; }
+
+      /// Phi operands, one per predecessor edge of the phi's block
+      int32_t getNumOperands()              { return (int32_t)_operands.size(); }
+      TR::CFGEdge *getOperandEdge(int32_t i) { return _operandEdges[i]; }
+      Value *getOperand(int32_t i)          { return _operands[i]; }
+
+      /// A phi at the target of exception edges, whose value is unknown
+      bool isExceptionMerge()               { return _isExceptionMerge; }
+
+      /// Blocks that read this value through a load or a phi operand
+      BlockList &getUses()                  { return _uses; }
+
+      private:
+      friend class TR_SSAForm;
+
+      Kind _kind;
+      int32_t _index;
+      int32_t _variable;
+      TR::Block *_block;
+      TR::Node *_store;
+      TR::vector<TR::CFGEdge *, TR::Region&> _operandEdges;
+      TR::vector<Value *, TR::Region&> _operands;
+      BlockList _uses;
+      bool _isExceptionMerge;
+      };
+
+   typedef TR::vector<Value *, TR::Region&> ValueList;
+
+   TR_SSAForm(TR::Compilation *comp, TR::Region &region, bool trace);
+
+   /**
+    * Build the SSA form of the current method. Returns false when the
+    * method cannot be put in SSA form, for instance when some blocks are
+    * unreachable or it would need too many phis.
+    */
+   bool build();
+
+   int32_t getNumVariables()                { return (int32_t)_variables.size(); }
+   TR::SymbolReference *getVariable(int32_t variable) { return _variables[variable]; }
+
+   int32_t getNumValues()                   { return (int32_t)_values.size(); }
+   Value *getValue(int32_t index)           { return _values[index]; }
+
+   /// The value defined by a store, or read by a load, of a tracked symbol; NULL for any other node
+   Value *getValue(TR::Node *node);
+
+   /// The phis at the entry of \p block
+   ValueList &getPhis(TR::Block *block);
+
+   void print();
+
+   private:
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, Value *>, TR::Region &> NodeValueMapAllocator;
+   typedef std::map<TR::Node *, Value *, std::less<TR::Node *>, NodeValueMapAllocator> NodeValueMap;
+
+   typedef TR::typed_allocator<std::pair<const int32_t, int32_t>, TR::Region &> VariableMapAllocator;
+   typedef std::map<int32_t, int32_t, std::less<int32_t>, VariableMapAllocator> VariableMap;
+
+   typedef TR::typed_allocator<std::pair<TR::Symbol * const, int32_t>, TR::Region &> SymbolMapAllocator;
+   typedef std::map<TR::Symbol *, int32_t, std::less<TR::Symbol *>, SymbolMapAllocator> SymbolMap;
+
+   TR::Compilation *comp() { return _comp; }
+   bool trace()            { return _trace; }
+
+   bool collectVariables();
+   bool collectVariables(TR::Node *node, SymbolMap &symRefForSymbol, TR::NodeChecklist &visited);
+   bool allBlocksReachable();
+   void computeDominanceFrontiers(TR_Dominators &dominators);
+   bool placePhis();
+   Value *createValue(Value::Kind kind, int32_t variable, TR::Block *block, TR::Node *store);
+   void rename(TR_Dominators &dominators);
+   void addPhiOperands(TR::Block *block, ValueList &current);
+   void renameNode(TR::Node *node, TR::Block *block, ValueList &current, ValueList &undo, TR::NodeChecklist &visited);
+   void addUse(Value *value, TR::Block *block);
+   int32_t variableOf(TR::Node *node);
+
+   TR::Compilation *_comp;
+   TR::Region &_region;
+   bool _trace;
+   TR::CFG *_cfg;
+   int32_t _numBlocks;
+
+   TR::vector<TR::Block *, TR::Region&> _blocks;           // by block number
+   TR::vector<TR::SymbolReference *, TR::Region&> _variables;
+   VariableMap _variableForSymRef;         // symbol reference number -> variable
+   ValueList _values;
+   NodeValueMap _nodeValues;
+   TR::vector<ValueList *, TR::Region&> _phis;             // by block number
+   TR::vector<TR_BitVector *, TR::Region&> _frontiers;     // dominance frontier by block number
+   TR::vector<TR_BitVector *, TR::Region&> _storeBlocks;   // blocks storing each variable
+   };
+
+#endif
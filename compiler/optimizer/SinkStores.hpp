@@ -333,6 +333,9 @@ class TR_SinkStores : public TR::Optimization
    int32_t                         _firstSinkOptTransformationIndex;
    int32_t                         _lastSinkOptTransformationIndex;
 
+   // true while treeIsSinkableStore is walking below a commoned node
+   bool                            _underCommonedNode;
+
    enum
       {
       UsesDataFlowAnalysis                     = 0x0001,
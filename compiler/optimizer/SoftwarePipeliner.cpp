@@ -0,0 +1,686 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/SoftwarePipeliner.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/Checklist.hpp"
+#include "infra/List.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/Structure.hpp"
+#include "ras/Debug.hpp"
+
+#define OPT_DETAILS "O^O SOFTWARE PIPELINER: "
+
+// Upper bound on the runtime overlap checks emitted in front of a single loop
+#define MAX_OVERLAP_CHECKS 4
+
+// Largest loop body that is pipelined
+#define MAX_PIPELINED_NODES 256
+
+TR_SoftwarePipeliner::TR_SoftwarePipeliner(TR::OptimizationManager *manager)
+   : TR_LoopTransformer(manager),
+     _loopInfos(trMemory()),
+     _storedSymRefs(NULL),
+     _dependence(NULL)
+   {}
+
+bool
+TR_SoftwarePipeliner::shouldPerform()
+   {
+   // The overlap checks are computed on 64-bit addresses
+   if (!comp()->target().is64Bit())
+      return false;
+
+   return comp()->mayHaveLoops();
+   }
+
+int32_t
+TR_SoftwarePipeliner::perform()
+   {
+   _cfg = comp()->getFlowGraph();
+   TR_Structure *rootStructure = _cfg->getStructure();
+   if (!rootStructure)
+      return 0;
+
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   _loopInfos.deleteAll();
+   _storedSymRefs = new (trStackMemory()) TR_BitVector(comp()->getSymRefTab()->getNumSymRefs(), trMemory(), stackAlloc, growable);
+   _dependence = new (trStackMemory()) TR_LoopDependence(comp(), _storedSymRefs);
+
+   if (trace())
+      {
+      traceMsg(comp(), "Starting SoftwarePipeliner\n");
+      comp()->dumpMethodTrees("Trees before SoftwarePipeliner");
+      }
+
+   collectLoops(rootStructure);
+
+   int32_t numPipelined = 0;
+   ListIterator<LoopInfo> it(&_loopInfos);
+   for (LoopInfo *li = it.getFirst(); li; li = it.getNext())
+      {
+      if (!performTransformation(comp(), "%sPipelining %d loads of loop %d\n", OPT_DETAILS,
+            li->_loads.getSize(), li->_header->getNumber()))
+         continue;
+
+      // The analysis is done, and the new blocks are not part of the structure
+      _cfg->setStructure(NULL);
+      transformLoop(li);
+      numPipelined++;
+      }
+
+   if (numPipelined > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      }
+
+   if (trace())
+      {
+      comp()->dumpMethodTrees("Trees after SoftwarePipeliner");
+      traceMsg(comp(), "Ending SoftwarePipeliner, pipelined %d loops\n", numPipelined);
+      }
+
+   return numPipelined;
+   }
+
+const char *
+TR_SoftwarePipeliner::optDetailString() const throw()
+   {
+   return "O^O SOFTWARE PIPELINER: ";
+   }
+
+void
+TR_SoftwarePipeliner::collectLoops(TR_Structure *str)
+   {
+   TR_RegionStructure *region = str->asRegion();
+   if (!region)
+      return;
+
+   bool isInnermost = true;
+   TR_RegionStructure::Cursor it(*region);
+   for (TR_StructureSubGraphNode *node = it.getCurrent(); node; node = it.getNext())
+      {
+      if (node->getStructure()->asRegion())
+         {
+         isInnermost = false;
+         collectLoops(node->getStructure());
+         }
+      }
+
+   if (!isInnermost || !region->isNaturalLoop())
+      return;
+
+   LoopInfo *li = new (trStackMemory()) LoopInfo(trMemory());
+   li->_region = region;
+   li->_header = region->getEntryBlock();
+
+   if (li->_header->isCold())
+      {
+      if (trace())
+         traceMsg(comp(), "Loop %d is cold\n", li->_header->getNumber());
+      return;
+      }
+
+   if (analyzeLoop(li))
+      {
+      if (trace())
+         traceMsg(comp(), "Loop %d is a pipelining candidate\n", li->_header->getNumber());
+      _loopInfos.add(li);
+      }
+   }
+
+bool
+TR_SoftwarePipeliner::analyzeLoop(LoopInfo *li)
+   {
+   if (!collectLoopChain(li))
+      return false;
+
+   if (!analyzeEntryEdges(li))
+      return false;
+
+   TR_ScratchList<TR::Block> blocks(trMemory());
+   li->_region->getBlocks(&blocks);
+
+   // Find every symbol written inside the loop to decide invariance
+   _storedSymRefs->empty();
+   TR::NodeChecklist storeVisited(comp());
+   ListIterator<TR::Block> bi(&blocks);
+   for (TR::Block *block = bi.getFirst(); block; block = bi.getNext())
+      {
+      for (TR::TreeTop *tt = block->getFirstRealTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+         collectStoredSymbols(tt->getNode(), storeVisited);
+      }
+
+   if (!analyzeLatch(li, li->_latch->getLastRealTreeTop()))
+      return false;
+
+   _dependence->setInductionVariable(0, li->_ivSymRef);
+
+   OrderMap order(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+   TR::NodeChecklist visited(comp());
+   ListAppender<TR::TreeTop> bodyTrees(&li->_bodyTrees);
+   int32_t treeIndex = 0;
+   for (TR::Block *block = li->_header; ; block = block->getSuccessors().front()->getTo()->asBlock())
+      {
+      for (TR::TreeTop *tt = block->getFirstRealTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+         {
+         if (tt == li->_ivStoreTree)
+            break;
+
+         TR::Node *node = tt->getNode();
+         if (node->getOpCodeValue() == TR::Goto)
+            continue;
+
+         if (!analyzeTree(li, node, treeIndex++, order, visited))
+            {
+            if (trace())
+               traceMsg(comp(), "Loop %d: cannot pipeline tree n%dn (%s)\n", li->_header->getNumber(),
+                  node->getGlobalIndex(), node->getOpCode().getName());
+            return false;
+            }
+
+         bodyTrees.add(tt);
+         }
+
+      if (block == li->_latch)
+         break;
+      }
+
+   if (li->_loads.isEmpty() || li->_numNodes > MAX_PIPELINED_NODES)
+      return false;
+
+   return analyzeDependences(li, order);
+   }
+
+/**
+ * The loop must be a straight chain of blocks starting at the header and
+ * ending in the latch, without exception edges, so that the trees of the
+ * chain execute exactly once per iteration in order.
+ */
+bool
+TR_SoftwarePipeliner::collectLoopChain(LoopInfo *li)
+   {
+   TR_ScratchList<TR::Block> blocks(trMemory());
+   li->_region->getBlocks(&blocks);
+
+   int32_t numBlocks = 0;
+   TR::Block *block = li->_header;
+   while (true)
+      {
+      if (block->hasExceptionSuccessors() || block->hasExceptionPredecessors())
+         return false;
+
+      if (!blocks.find(block))
+         return false;
+
+      if (block != li->_header && block->getPredecessors().size() != 1)
+         return false;
+
+      if (++numBlocks > blocks.getSize())
+         return false;
+
+      if (block->hasSuccessor(li->_header))
+         break;
+
+      if (block->getSuccessors().size() != 1)
+         return false;
+
+      block = block->getSuccessors().front()->getTo()->asBlock();
+      if (!block || block == li->_header)
+         return false;
+      }
+
+   if (numBlocks != blocks.getSize())
+      return false;
+
+   li->_latch = block;
+   return true;
+   }
+
+bool
+TR_SoftwarePipeliner::analyzeLatch(LoopInfo *li, TR::TreeTop *branchTree)
+   {
+   TR::Node *branch = branchTree->getNode();
+   if (branch->getOpCodeValue() != TR::ificmplt && branch->getOpCodeValue() != TR::ificmple)
+      return false;
+
+   if (branch->getNumChildren() != 2 || branch->getBranchDestination() != li->_header->getEntry())
+      return false;
+
+   TR::TreeTop *ivStoreTree = branchTree->getPrevTreeTop();
+   TR::Node *ivStore = ivStoreTree->getNode();
+   if (ivStore->getOpCodeValue() != TR::istore || !ivStore->getSymbol()->isAutoOrParm())
+      return false;
+
+   TR::SymbolReference *ivSymRef = ivStore->getSymbolReference();
+   TR::Node *increment = ivStore->getFirstChild();
+   if (increment->getOpCodeValue() != TR::iadd ||
+       increment->getFirstChild()->getOpCodeValue() != TR::iload ||
+       increment->getFirstChild()->getSymbolReference() != ivSymRef ||
+       increment->getSecondChild()->getOpCodeValue() != TR::iconst ||
+       increment->getSecondChild()->getInt() != 1)
+      return false;
+
+   TR::Node *compared = branch->getFirstChild();
+   if (compared != increment &&
+       !(compared->getOpCodeValue() == TR::iload && compared->getSymbolReference() == ivSymRef && compared->getReferenceCount() == 1))
+      return false;
+
+   TR::Node *bound = branch->getSecondChild();
+   if (!_dependence->isInvariantExpression(bound))
+      return false;
+
+   li->_ivStoreTree = ivStoreTree;
+   li->_ivSymRef = ivSymRef;
+   li->_bound = bound;
+   li->_inclusiveBound = branch->getOpCodeValue() == TR::ificmple;
+   return true;
+   }
+
+/**
+ * Every edge into the header from outside the loop is redirected to the
+ * new trip count guard, so each of them must be a plain fall-through or
+ * a branch whose destination can be changed.
+ */
+bool
+TR_SoftwarePipeliner::analyzeEntryEdges(LoopInfo *li)
+   {
+   TR::Block *header = li->_header;
+   if (!header->getEntry()->getPrevTreeTop())
+      return false;
+
+   int32_t numEntries = 0;
+   for (auto edge = header->getPredecessors().begin(); edge != header->getPredecessors().end(); ++edge)
+      {
+      TR::Block *pred = (*edge)->getFrom()->asBlock();
+      if (pred == li->_latch)
+         continue;
+
+      if (!pred->getEntry())
+         return false;
+
+      TR::Node *lastNode = pred->getLastRealTreeTop()->getNode();
+      if (lastNode->getOpCode().isSwitch() || lastNode->getOpCode().isJumpWithMultipleTargets())
+         return false;
+
+      bool branchesToHeader = lastNode->getOpCode().isBranch() && lastNode->getBranchDestination() == header->getEntry();
+      bool fallsIntoHeader = pred->getExit()->getNextTreeTop() == header->getEntry();
+      if (branchesToHeader == fallsIntoHeader)
+         return false;
+
+      numEntries++;
+      }
+
+   return numEntries > 0;
+   }
+
+/**
+ * Every tree must be free of side effects but for stores to affine array
+ * elements and autos. Loads whose address moves with the induction
+ * variable are the ones issued ahead; \p order records the index of the
+ * tree each access is first evaluated in.
+ */
+bool
+TR_SoftwarePipeliner::analyzeTree(LoopInfo *li, TR::Node *node, int32_t treeIndex, OrderMap &order, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return true;
+   visited.add(node);
+   li->_numNodes++;
+
+   TR::ILOpCode &op = node->getOpCode();
+   if (op.isStoreIndirect() || op.isLoadIndirect())
+      {
+      TR_AffineAccess *access = new (trStackMemory()) TR_AffineAccess();
+      if (!_dependence->analyzeAccess(node, access))
+         return false;
+
+      order[node] = treeIndex;
+      if (op.isStore())
+         li->_stores.add(access);
+      else if (access->_coefficients[0] != 0)
+         li->_loads.add(access);
+      }
+   else if (op.isStoreDirect() || op.isLoadVarDirect())
+      {
+      TR::Symbol *symbol = node->getSymbol();
+      if (!symbol->isAutoOrParm() || symbol->isVolatile())
+         return false;
+
+      if (op.isStoreDirect() && node->getSymbolReference() == li->_ivSymRef)
+         return false;
+      }
+   else if (node->getOpCodeValue() != TR::treetop && !op.isLoadConst() && !TR_LoopDependence::isPureOperation(node))
+      {
+      return false;
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!analyzeTree(li, node->getChild(i), treeIndex, order, visited))
+         return false;
+      }
+
+   return true;
+   }
+
+/**
+ * A load of iteration `i + 1` moves ahead of every store of iteration `i`
+ * and of the stores that precede it in iteration `i + 1`.
+ */
+bool
+TR_SoftwarePipeliner::analyzeDependences(LoopInfo *li, OrderMap &order)
+   {
+   ListIterator<TR_AffineAccess> loadIt(&li->_loads);
+   for (TR_AffineAccess *load = loadIt.getFirst(); load; load = loadIt.getNext())
+      {
+      ListIterator<TR_AffineAccess> si(&li->_stores);
+      for (TR_AffineAccess *store = si.getFirst(); store; store = si.getNext())
+         {
+         if (!store->hasSameBase(*load))
+            {
+            if (li->_overlapChecks.getSize() == 2 * MAX_OVERLAP_CHECKS)
+               {
+               if (trace())
+                  traceMsg(comp(), "Loop %d: too many overlap checks\n", li->_header->getNumber());
+               return false;
+               }
+
+            li->_overlapChecks.add(load);
+            li->_overlapChecks.add(store);
+            continue;
+            }
+
+         int64_t coefficient = store->_coefficients[0];
+         bool dependent = load->_coefficients[0] != coefficient;
+         if (!dependent)
+            {
+            int64_t distance = load->_offset - store->_offset;
+            dependent = TR_LoopDependence::mayOverlap(distance + coefficient, 0, 0, 0, store->_size, load->_size) ||
+                        (order[store->_node] < order[load->_node] &&
+                         TR_LoopDependence::mayOverlap(distance, 0, 0, 0, store->_size, load->_size));
+            }
+
+         if (dependent)
+            {
+            if (trace())
+               traceMsg(comp(), "Loop %d: load n%dn may read the element stored by n%dn\n", li->_header->getNumber(),
+                  load->_node->getGlobalIndex(), store->_node->getGlobalIndex());
+            return false;
+            }
+         }
+      }
+
+   return true;
+   }
+
+void
+TR_SoftwarePipeliner::collectStoredSymbols(TR::Node *node, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return;
+   visited.add(node);
+
+   if (node->getOpCode().isStoreDirect())
+      _storedSymRefs->set(node->getSymbolReference()->getReferenceNumber());
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      collectStoredSymbols(node->getChild(i), visited);
+   }
+
+/**
+ * Insert the guard, overlap checks, prologue and pipelined kernel between
+ * the loop's entry edges and its header. The kernel falls into the original
+ * loop, which runs the last iteration.
+ */
+void
+TR_SoftwarePipeliner::transformLoop(LoopInfo *li)
+   {
+   TR::Block *header = li->_header;
+   TR::Node *bcNode = header->getEntry()->getNode();
+
+   TR_ScratchList<TR::Block> entryBlocks(trMemory());
+   int32_t entryFrequency = 0;
+   for (auto edge = header->getPredecessors().begin(); edge != header->getPredecessors().end(); ++edge)
+      {
+      TR::Block *pred = (*edge)->getFrom()->asBlock();
+      if (pred == li->_latch)
+         continue;
+
+      entryBlocks.add(pred);
+      if (pred->getFrequency() > entryFrequency)
+         entryFrequency = pred->getFrequency();
+      }
+
+   // Blocks are created in layout order in front of the header
+   TR::Block *guardBlock = createBlockBefore(header, bcNode, entryFrequency);
+   TR_ScratchList<TR::Block> checkBlocks(trMemory());
+   ListAppender<TR::Block> checkBlocksAppender(&checkBlocks);
+   for (int32_t i = li->_overlapChecks.getSize(); i > 0; i--)
+      checkBlocksAppender.add(createBlockBefore(header, bcNode, entryFrequency));
+   TR::Block *prologueBlock = createBlockBefore(header, bcNode, entryFrequency);
+   TR::Block *kernelBlock = createBlockBefore(header, bcNode, header->getFrequency());
+
+   // Trip count guard: the kernel needs the current and the next iteration
+   guardBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::iflcmplt, createRemainingIterations(li), TR::Node::lconst(bcNode, 2), header->getEntry())));
+
+   // Fall back to the original loop when the address ranges of a load and a
+   // store overlap: each check is a pair of blocks testing `lo1 < hi2 && lo2 < hi1`
+   TR::Node *lowValues[TR_AffineAccess::MaxInductionVariables] = { NULL };
+   TR::Node *highValues[TR_AffineAccess::MaxInductionVariables] = { NULL };
+   lowValues[0] = TR::Node::create(TR::i2l, 1, TR::Node::createLoad(bcNode, li->_ivSymRef));
+   highValues[0] = createLastValue(li);
+
+   ListIterator<TR::Block> cbi(&checkBlocks);
+   ListIterator<TR_AffineAccess> ci(&li->_overlapChecks);
+   TR_AffineAccess *first = ci.getFirst();
+   for (TR::Block *checkBlock = cbi.getFirst(); checkBlock; checkBlock = cbi.getNext(), first = ci.getNext())
+      {
+      TR_AffineAccess *second = ci.getNext();
+      TR::Block *overlapBlock = cbi.getNext();
+      checkBlock->append(TR::TreeTop::create(comp(),
+         TR::Node::createif(TR::iflucmpge,
+            _dependence->createAddressBound(first, lowValues, highValues, false),
+            _dependence->createAddressBound(second, lowValues, highValues, true),
+            overlapBlock->getNextBlock()->getEntry())));
+      overlapBlock->append(TR::TreeTop::create(comp(),
+         TR::Node::createif(TR::iflucmplt,
+            _dependence->createAddressBound(second, lowValues, highValues, false),
+            _dependence->createAddressBound(first, lowValues, highValues, true),
+            header->getEntry())));
+      }
+
+   // Prologue: load the first iteration's elements
+   int32_t numLoads = li->_loads.getSize();
+   TR::SymbolReference **currentTemps = (TR::SymbolReference **)trMemory()->allocateStackMemory(numLoads * sizeof(TR::SymbolReference *));
+   TR::SymbolReference **nextTemps = (TR::SymbolReference **)trMemory()->allocateStackMemory(numLoads * sizeof(TR::SymbolReference *));
+   NodeMap prologueMap(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+   ListIterator<TR_AffineAccess> ai(&li->_loads);
+   int32_t l = 0;
+   for (TR_AffineAccess *load = ai.getFirst(); load; load = ai.getNext(), l++)
+      {
+      TR::DataType dt = load->_node->getDataType();
+      currentTemps[l] = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), dt);
+      nextTemps[l] = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), dt);
+      prologueBlock->append(TR::TreeTop::create(comp(),
+         TR::Node::createStore(currentTemps[l], duplicateShifted(li, load->_node, 0, prologueMap))));
+      }
+
+   // Kernel: load the next iteration's elements, compute the current
+   // iteration from the temporaries and rotate them
+   NodeMap nextMap(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+   NodeMap bodyMap(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+   l = 0;
+   for (TR_AffineAccess *load = ai.getFirst(); load; load = ai.getNext(), l++)
+      {
+      kernelBlock->append(TR::TreeTop::create(comp(),
+         TR::Node::createStore(nextTemps[l], duplicateShifted(li, load->_node, 1, nextMap))));
+      bodyMap[load->_node] = TR::Node::createLoad(load->_node, currentTemps[l]);
+      }
+
+   ListIterator<TR::TreeTop> ti(&li->_bodyTrees);
+   for (TR::TreeTop *tt = ti.getFirst(); tt; tt = ti.getNext())
+      kernelBlock->append(TR::TreeTop::create(comp(), duplicateShifted(li, tt->getNode(), 0, bodyMap)));
+
+   for (l = 0; l < numLoads; l++)
+      {
+      kernelBlock->append(TR::TreeTop::create(comp(),
+         TR::Node::createStore(currentTemps[l], TR::Node::createLoad(bcNode, nextTemps[l]))));
+      }
+
+   TR::Node *increment = TR::Node::create(TR::iadd, 2,
+      TR::Node::createLoad(bcNode, li->_ivSymRef),
+      TR::Node::iconst(bcNode, 1));
+   kernelBlock->append(TR::TreeTop::create(comp(), TR::Node::createStore(li->_ivSymRef, increment)));
+   kernelBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::iflcmpge, createRemainingIterations(li), TR::Node::lconst(bcNode, 2), kernelBlock->getEntry())));
+
+   // Wire up the new blocks before moving the entry edges so the header stays reachable
+   _cfg->addEdge(guardBlock, guardBlock->getNextBlock());
+   _cfg->addEdge(guardBlock, header);
+
+   for (TR::Block *checkBlock = cbi.getFirst(); checkBlock; checkBlock = cbi.getNext())
+      {
+      TR::Block *overlapBlock = cbi.getNext();
+      _cfg->addEdge(checkBlock, overlapBlock);
+      _cfg->addEdge(checkBlock, overlapBlock->getNextBlock());
+      _cfg->addEdge(overlapBlock, overlapBlock->getNextBlock());
+      _cfg->addEdge(overlapBlock, header);
+      }
+
+   _cfg->addEdge(prologueBlock, kernelBlock);
+   _cfg->addEdge(kernelBlock, kernelBlock);
+   _cfg->addEdge(kernelBlock, header);
+
+   ListIterator<TR::Block> ei(&entryBlocks);
+   for (TR::Block *pred = ei.getFirst(); pred; pred = ei.getNext())
+      {
+      TR::Node *lastNode = pred->getLastRealTreeTop()->getNode();
+      if (lastNode->getOpCode().isBranch() && lastNode->getBranchDestination() == header->getEntry())
+         {
+         pred->changeBranchDestination(guardBlock->getEntry(), _cfg);
+         }
+      else
+         {
+         _cfg->addEdge(pred, guardBlock);
+         _cfg->removeEdge(pred, header);
+         }
+      }
+   }
+
+TR::Block *
+TR_SoftwarePipeliner::createBlockBefore(TR::Block *next, TR::Node *bcNode, int32_t frequency)
+   {
+   TR::Block *block = TR::Block::createEmptyBlock(bcNode, comp(), frequency, next);
+   _cfg->addNode(block);
+
+   TR::TreeTop *prevTree = next->getEntry()->getPrevTreeTop();
+   prevTree->join(block->getEntry());
+   block->getExit()->join(next->getEntry());
+   return block;
+   }
+
+/**
+ * Copy a tree for iteration `i + shift`, preserving commoning between all
+ * the trees copied with the same map.
+ */
+TR::Node *
+TR_SoftwarePipeliner::duplicateShifted(LoopInfo *li, TR::Node *node, int32_t shift, NodeMap &map)
+   {
+   NodeMap::iterator found = map.find(node);
+   if (found != map.end())
+      return found->second;
+
+   TR::Node *result = NULL;
+   if (shift != 0 && node->getOpCodeValue() == TR::iload && node->getSymbolReference() == li->_ivSymRef)
+      {
+      result = TR::Node::create(TR::iadd, 2,
+         TR::Node::createLoad(node, li->_ivSymRef),
+         TR::Node::iconst(node, shift));
+      }
+   else
+      {
+      result = TR::Node::copy(node);
+      result->setReferenceCount(0);
+      for (int32_t i = 0; i < node->getNumChildren(); i++)
+         result->setAndIncChild(i, duplicateShifted(li, node->getChild(i), shift, map));
+      }
+
+   map[node] = result;
+   return result;
+   }
+
+/**
+ * Number of iterations left as a 64-bit value: `bound - i`, plus one for
+ * an inclusive bound
+ */
+TR::Node *
+TR_SoftwarePipeliner::createRemainingIterations(LoopInfo *li)
+   {
+   TR::Node *bound = li->_bound;
+   TR::Node *remaining = TR::Node::create(TR::lsub, 2,
+      TR::Node::create(TR::i2l, 1, bound->duplicateTree()),
+      TR::Node::create(TR::i2l, 1, TR::Node::createLoad(bound, li->_ivSymRef)));
+   if (li->_inclusiveBound)
+      remaining = TR::Node::create(TR::ladd, 2, remaining, TR::Node::lconst(bound, 1));
+   return remaining;
+   }
+
+/**
+ * Last value of the induction variable as a 64-bit value: `bound - 1`, or
+ * `bound` for an inclusive bound
+ */
+TR::Node *
+TR_SoftwarePipeliner::createLastValue(LoopInfo *li)
+   {
+   TR::Node *bound = li->_bound;
+   TR::Node *last = TR::Node::create(TR::i2l, 1, bound->duplicateTree());
+   if (!li->_inclusiveBound)
+      last = TR::Node::create(TR::lsub, 2, last, TR::Node::lconst(bound, 1));
+   return last;
+   }
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef SOFTWAREPIPELINER_INCL
+#define SOFTWAREPIPELINER_INCL
+
+#include <map>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "env/TypedAllocator.hpp"
+#include "infra/List.hpp"
+#include "optimizer/LoopCanonicalizer.hpp"
+#include "optimizer/LoopDependence.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_BitVector;
+class TR_RegionStructure;
+class TR_Structure;
+namespace TR { class Block; }
+namespace TR { class Node; }
+namespace TR { class NodeChecklist; }
+namespace TR { class Optimization; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/**
+ * Class TR_SoftwarePipeliner
+ * ==========================
+ *
+ * Software pipelining overlaps consecutive iterations of a counted innermost
+ * loop. This pass builds a two stage schedule: the array loads of iteration
+ * `i + 1` are issued at the top of iteration `i`, into temporaries the next
+ * iteration computes with, so that their latency is hidden behind the
+ * computation of the current iteration.
+ *
+ * Loops are recognized as by the loop vectorizer: a single chain of blocks
+ * ending in
+ *
+ *    istore #i (iadd (iload #i) (iconst 1))
+ *    ificmplt/ificmple --> header (iload #i) (bound)
+ *
+ * whose other trees are side effect free stores of affine array elements
+ * or autos. Loading ahead is legal when no store of iteration `i`, and no
+ * store that precedes the load in iteration `i + 1`, may write the loaded
+ * element: stores to the same array are checked from their dependence
+ * distances and stores to other arrays by runtime overlap checks.
+ *
+ * In front of the original loop the pass inserts a guard that requires two
+ * iterations, the overlap checks, a prologue that loads the first
+ * iteration's elements and the pipelined kernel. The kernel runs while a
+ * next iteration exists, so no load is speculative, and the original loop
+ * runs the last iteration.
+ *
+ * The pass is disabled by default since out-of-order processors already
+ * overlap independent iterations; enable it with enableSoftwarePipelining.
+ */
+
+class TR_SoftwarePipeliner : public TR_LoopTransformer
+   {
+   public:
+   TR_SoftwarePipeliner(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_SoftwarePipeliner(manager);
+      }
+
+   virtual bool    shouldPerform();
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   struct LoopInfo
+      {
+      TR_ALLOC(TR_Memory::LoopTransformer)
+
+      LoopInfo(TR_Memory *m)
+         : _region(NULL), _header(NULL), _latch(NULL), _ivStoreTree(NULL), _ivSymRef(NULL),
+           _bound(NULL), _inclusiveBound(false), _numNodes(0),
+           _bodyTrees(m), _loads(m), _stores(m), _overlapChecks(m)
+         {}
+
+      TR_RegionStructure *_region;
+      TR::Block *_header;
+      TR::Block *_latch;
+      TR::TreeTop *_ivStoreTree;
+      TR::SymbolReference *_ivSymRef;
+      TR::Node *_bound;
+      bool _inclusiveBound;
+      int32_t _numNodes;
+
+      TR_ScratchList<TR::TreeTop> _bodyTrees;          // trees but the latch update, in order
+      TR_ScratchList<TR_AffineAccess> _loads;          // loads issued one iteration ahead
+      TR_ScratchList<TR_AffineAccess> _stores;
+      TR_ScratchList<TR_AffineAccess> _overlapChecks;  // pairs of accesses whose ranges must not overlap
+      };
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, TR::Node *>, TR::Region &> NodeMapAllocator;
+   typedef std::map<TR::Node *, TR::Node *, std::less<TR::Node *>, NodeMapAllocator> NodeMap;
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, int32_t>, TR::Region &> OrderMapAllocator;
+   typedef std::map<TR::Node *, int32_t, std::less<TR::Node *>, OrderMapAllocator> OrderMap;
+
+   /* analysis */
+   void collectLoops(TR_Structure *str);
+   bool analyzeLoop(LoopInfo *li);
+   bool collectLoopChain(LoopInfo *li);
+   bool analyzeLatch(LoopInfo *li, TR::TreeTop *branchTree);
+   bool analyzeEntryEdges(LoopInfo *li);
+   bool analyzeTree(LoopInfo *li, TR::Node *node, int32_t treeIndex, OrderMap &order, TR::NodeChecklist &visited);
+   bool analyzeDependences(LoopInfo *li, OrderMap &order);
+   void collectStoredSymbols(TR::Node *node, TR::NodeChecklist &visited);
+
+   /* transformation */
+   void transformLoop(LoopInfo *li);
+   TR::Block *createBlockBefore(TR::Block *next, TR::Node *bcNode, int32_t frequency);
+   TR::Node *duplicateShifted(LoopInfo *li, TR::Node *node, int32_t shift, NodeMap &map);
+   TR::Node *createRemainingIterations(LoopInfo *li);
+   TR::Node *createLastValue(LoopInfo *li);
+
+   TR_ScratchList<LoopInfo> _loopInfos;
+   TR_BitVector *_storedSymRefs;
+   TR_LoopDependence *_dependence;
+   };
+
+#endif
@@ -0,0 +1,604 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/SparseConditionalConstantPropagation.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/IO.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Assert.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/CfgNode.hpp"
+#include "optimizer/TransformUtil.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/SSAForm.hpp"
+#include "ras/Debug.hpp"
+
+#define OPT_DETAILS "O^O SPARSE CONDITIONAL CONSTANT PROPAGATION: "
+
+TR_SparseConditionalConstantPropagation::TR_SparseConditionalConstantPropagation(TR::OptimizationManager *manager)
+   : TR::Optimization(manager),
+     _ssa(NULL),
+     _values(NULL),
+     _worklist(NULL),
+     _onWorklist(NULL),
+     _executableBlocks(NULL),
+     _executableEdges(NULL),
+     _nodeValues(NULL),
+     _visitCount(0)
+   {}
+
+bool
+TR_SparseConditionalConstantPropagation::shouldPerform()
+   {
+   return comp()->getFlowGraph() != NULL;
+   }
+
+int32_t
+TR_SparseConditionalConstantPropagation::perform()
+   {
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   if (trace())
+      {
+      traceMsg(comp(), "Starting SparseConditionalConstantPropagation\n");
+      comp()->dumpMethodTrees("Trees before SparseConditionalConstantPropagation");
+      }
+
+   // SSA form is only built for a CFG where every block is reachable
+   TR::CFG *cfg = comp()->getFlowGraph();
+   cfg->removeUnreachableBlocks();
+
+   TR_SSAForm ssa(comp(), stackMemoryRegion, trace());
+   if (!ssa.build())
+      return 0;
+
+   int32_t numBlocks = cfg->getNextNodeNumber();
+   _ssa = &ssa;
+   _values = new (stackMemoryRegion) TR::vector<Lattice, TR::Region&>(ssa.getNumValues(), top(), stackMemoryRegion);
+   _worklist = new (stackMemoryRegion) TR::vector<TR::Block *, TR::Region&>(stackMemoryRegion);
+   _onWorklist = new (stackMemoryRegion) TR_BitVector(numBlocks, stackMemoryRegion);
+   _executableBlocks = new (stackMemoryRegion) TR_BitVector(numBlocks, stackMemoryRegion);
+   _executableEdges = new (stackMemoryRegion) EdgeSet(std::less<TR::CFGEdge *>(), stackMemoryRegion);
+   _nodeValues = new (stackMemoryRegion) NodeLatticeMap(std::less<TR::Node *>(), stackMemoryRegion);
+
+   // Nothing is known about parms and uninitialized autos on entry
+   for (int32_t i = 0; i < ssa.getNumValues(); i++)
+      {
+      if (ssa.getValue(i)->getKind() == TR_SSAForm::Value::Entry)
+         (*_values)[i] = bottom();
+      }
+
+   propagate();
+
+   int32_t cost = transform(stackMemoryRegion);
+
+   if (trace())
+      {
+      comp()->dumpMethodTrees("Trees after SparseConditionalConstantPropagation");
+      traceMsg(comp(), "Ending SparseConditionalConstantPropagation\n");
+      }
+
+   _ssa = NULL;
+   return cost;
+   }
+
+const char *
+TR_SparseConditionalConstantPropagation::optDetailString() const throw()
+   {
+   return "O^O SPARSE CONDITIONAL CONSTANT PROPAGATION: ";
+   }
+
+TR_SparseConditionalConstantPropagation::Lattice
+TR_SparseConditionalConstantPropagation::meet(const Lattice &a, const Lattice &b)
+   {
+   if (a._state == Lattice::Top)
+      return b;
+   if (b._state == Lattice::Top)
+      return a;
+   if (a._state == Lattice::Bottom || b._state == Lattice::Bottom || a._value != b._value)
+      return bottom();
+   return a;
+   }
+
+bool
+TR_SparseConditionalConstantPropagation::isTrackedType(TR::DataType type)
+   {
+   return type == TR::Int8 || type == TR::Int16 || type == TR::Int32 || type == TR::Int64;
+   }
+
+int64_t
+TR_SparseConditionalConstantPropagation::truncate(int64_t value, TR::DataType type)
+   {
+   switch (type)
+      {
+      case TR::Int8:  return (int8_t)value;
+      case TR::Int16: return (int16_t)value;
+      case TR::Int32: return (int32_t)value;
+      default:        return value;
+      }
+   }
+
+void
+TR_SparseConditionalConstantPropagation::enqueue(TR::Block *block)
+   {
+   if (_onWorklist->isSet(block->getNumber()))
+      return;
+   _onWorklist->set(block->getNumber());
+   _worklist->push_back(block);
+   }
+
+void
+TR_SparseConditionalConstantPropagation::markEdge(TR::CFGEdge *edge)
+   {
+   if (!_executableEdges->insert(edge).second)
+      return;
+
+   // A block reached again must meet its phis with the new edge
+   TR::Block *to = toBlock(edge->getTo());
+   _executableBlocks->set(to->getNumber());
+   enqueue(to);
+   }
+
+void
+TR_SparseConditionalConstantPropagation::setValue(int32_t index, Lattice value)
+   {
+   Lattice &current = (*_values)[index];
+   Lattice lowered = meet(current, value);
+   if (lowered == current)
+      return;
+
+   current = lowered;
+   TR_SSAForm::BlockList &uses = _ssa->getValue(index)->getUses();
+   for (auto it = uses.begin(); it != uses.end(); ++it)
+      {
+      if (_executableBlocks->isSet((*it)->getNumber()))
+         enqueue(*it);
+      }
+   }
+
+void
+TR_SparseConditionalConstantPropagation::propagate()
+   {
+   TR::Block *start = toBlock(comp()->getFlowGraph()->getStart());
+   _executableBlocks->set(start->getNumber());
+   enqueue(start);
+
+   int32_t numEvaluations = 0;
+   while (!_worklist->empty())
+      {
+      TR::Block *block = _worklist->back();
+      _worklist->pop_back();
+      _onWorklist->reset(block->getNumber());
+      evaluateBlock(block);
+      numEvaluations++;
+      }
+
+   if (trace())
+      {
+      traceMsg(comp(), "Lattice stable after %d block evaluations\n", numEvaluations);
+      for (int32_t i = 0; i < _ssa->getNumValues(); i++)
+         {
+         Lattice &value = (*_values)[i];
+         if (value._state == Lattice::Constant)
+            traceMsg(comp(), "   v%d is constant " INT64_PRINTF_FORMAT "\n", i, value._value);
+         else
+            traceMsg(comp(), "   v%d is %s\n", i, value._state == Lattice::Top ? "top" : "bottom");
+         }
+      }
+   }
+
+void
+TR_SparseConditionalConstantPropagation::evaluateBlock(TR::Block *block)
+   {
+   TR_SSAForm::ValueList &phis = _ssa->getPhis(block);
+   for (auto p = phis.begin(); p != phis.end(); ++p)
+      {
+      TR_SSAForm::Value *phi = *p;
+      if (phi->isExceptionMerge())
+         {
+         setValue(phi->getIndex(), bottom());
+         continue;
+         }
+
+      Lattice merged = top();
+      for (int32_t i = 0; i < phi->getNumOperands(); i++)
+         {
+         if (_executableEdges->find(phi->getOperandEdge(i)) != _executableEdges->end())
+            merged = meet(merged, (*_values)[phi->getOperand(i)->getIndex()]);
+         }
+      setValue(phi->getIndex(), merged);
+      }
+
+   TR::Node *lastNode = NULL;
+   if (block->getEntry())
+      {
+      _visitCount = comp()->incVisitCount();
+      _nodeValues->clear();
+      for (TR::TreeTop *tt = block->getEntry(); tt != block->getExit(); tt = tt->getNextTreeTop())
+         {
+         lastNode = tt->getNode();
+         evaluate(lastNode);
+         }
+      }
+
+   markSuccessors(block, lastNode);
+
+   // Trees commoned into an extension of this block were evaluated with it.
+   // The CFG entry and exit blocks have no trees and no next block.
+   TR::Block *next = block->getEntry() ? block->getNextBlock() : NULL;
+   if (next && next->isExtensionOfPreviousBlock() && _executableBlocks->isSet(next->getNumber()))
+      enqueue(next);
+   }
+
+void
+TR_SparseConditionalConstantPropagation::markSuccessors(TR::Block *block, TR::Node *lastNode)
+   {
+   for (auto e = block->getExceptionSuccessors().begin(); e != block->getExceptionSuccessors().end(); ++e)
+      markEdge(*e);
+
+   TR::CFGEdgeList &successors = block->getSuccessors();
+   if (lastNode && lastNode->getOpCode().isIf())
+      {
+      Lattice condition = evaluate(lastNode);
+      if (condition._state == Lattice::Top)
+         return;
+
+      if (condition._state == Lattice::Constant)
+         {
+         TR::Block *destination = lastNode->getBranchDestination()->getNode()->getBlock();
+         bool taken = condition._value != 0;
+         bool marked = false;
+         for (auto e = successors.begin(); e != successors.end(); ++e)
+            {
+            if (((*e)->getTo() == destination) == taken)
+               {
+               markEdge(*e);
+               marked = true;
+               }
+            }
+         if (marked)
+            return;
+         }
+      }
+
+   for (auto e = successors.begin(); e != successors.end(); ++e)
+      markEdge(*e);
+   }
+
+TR_SparseConditionalConstantPropagation::Lattice
+TR_SparseConditionalConstantPropagation::evaluate(TR::Node *node)
+   {
+   if (node->getVisitCount() == _visitCount)
+      {
+      auto it = _nodeValues->find(node);
+      if (it != _nodeValues->end())
+         return it->second;
+      }
+   node->setVisitCount(_visitCount);
+
+   Lattice result;
+   TR::ILOpCode &op = node->getOpCode();
+   TR_SSAForm::Value *value = _ssa->getValue(node);
+
+   if (value && op.isStoreDirect())
+      {
+      Lattice stored = evaluate(node->getFirstChild());
+      setValue(value->getIndex(), isTrackedType(node->getDataType()) ? stored : bottom());
+      result = bottom();
+      }
+   else if (value)
+      {
+      result = isTrackedType(node->getDataType()) ? (*_values)[value->getIndex()] : bottom();
+      }
+   else if (op.isLoadConst())
+      {
+      result = isTrackedType(node->getDataType()) ? constant(truncate(node->get64bitIntegralValue(), node->getDataType())) : bottom();
+      }
+   else if (op.isBooleanCompare() && node->getNumChildren() >= 2)
+      {
+      result = evaluateCompare(node);
+      }
+   else
+      {
+      result = evaluateOperation(node);
+      }
+
+   (*_nodeValues)[node] = result;
+   return result;
+   }
+
+TR_SparseConditionalConstantPropagation::Lattice
+TR_SparseConditionalConstantPropagation::evaluateCompare(TR::Node *node)
+   {
+   Lattice left = evaluate(node->getFirstChild());
+   Lattice right = evaluate(node->getSecondChild());
+   for (int32_t i = 2; i < node->getNumChildren(); i++)
+      evaluate(node->getChild(i));
+
+   TR::DataType type = node->getFirstChild()->getDataType();
+   if (!isTrackedType(type) || type != node->getSecondChild()->getDataType())
+      return bottom();
+   if (left._state == Lattice::Top || right._state == Lattice::Top)
+      return top();
+   if (left._state == Lattice::Bottom || right._state == Lattice::Bottom)
+      return bottom();
+
+   TR::ILOpCode &op = node->getOpCode();
+   bool less, greater;
+   if (op.isUnsignedCompare())
+      {
+      uint64_t mask = type == TR::Int64 ? ~(uint64_t)0 : (((uint64_t)1 << (TR::DataType::getSize(type) * 8)) - 1);
+      uint64_t l = (uint64_t)left._value & mask;
+      uint64_t r = (uint64_t)right._value & mask;
+      less = l < r;
+      greater = l > r;
+      }
+   else
+      {
+      less = left._value < right._value;
+      greater = left._value > right._value;
+      }
+
+   bool result;
+   if (less)
+      result = op.isCompareTrueIfLess();
+   else if (greater)
+      result = op.isCompareTrueIfGreater();
+   else
+      result = op.isCompareTrueIfEqual();
+   return constant(result ? 1 : 0);
+   }
+
+TR_SparseConditionalConstantPropagation::Lattice
+TR_SparseConditionalConstantPropagation::evaluateOperation(TR::Node *node)
+   {
+   Lattice operands[2] = { top(), top() };
+   bool anyTop = false;
+   bool anyBottom = false;
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      Lattice child = evaluate(node->getChild(i));
+      if (i < 2)
+         operands[i] = child;
+      if (!isTrackedType(node->getChild(i)->getDataType()) || child._state == Lattice::Bottom)
+         anyBottom = true;
+      else if (child._state == Lattice::Top)
+         anyTop = true;
+      }
+
+   TR::ILOpCode &op = node->getOpCode();
+   TR::DataType type = node->getDataType();
+   if (!isTrackedType(type) || node->getNumChildren() == 0 || node->getNumChildren() > 2)
+      return bottom();
+
+   uint64_t a = (uint64_t)operands[0]._value;
+   uint64_t b = (uint64_t)operands[1]._value;
+   uint64_t result;
+
+   switch (op.getOpCodeValue())
+      {
+      case TR::badd: case TR::sadd: case TR::iadd: case TR::ladd:
+         result = a + b;
+         break;
+      case TR::bsub: case TR::ssub: case TR::isub: case TR::lsub:
+         result = a - b;
+         break;
+      case TR::bmul: case TR::smul: case TR::imul: case TR::lmul:
+         result = a * b;
+         break;
+      case TR::band: case TR::sand: case TR::iand: case TR::land:
+         result = a & b;
+         break;
+      case TR::bor: case TR::sor: case TR::ior: case TR::lor:
+         result = a | b;
+         break;
+      case TR::bxor: case TR::sxor: case TR::ixor: case TR::lxor:
+         result = a ^ b;
+         break;
+      case TR::bneg: case TR::sneg: case TR::ineg: case TR::lneg:
+         result = 0 - a;
+         break;
+      case TR::ishl:
+         result = a << (b & 31);
+         break;
+      case TR::lshl:
+         result = a << (b & 63);
+         break;
+      case TR::ishr:
+         result = (uint64_t)(operands[0]._value >> (b & 31));
+         break;
+      case TR::lshr:
+         result = (uint64_t)(operands[0]._value >> (b & 63));
+         break;
+      case TR::iushr:
+         result = (a & 0xffffffff) >> (b & 31);
+         break;
+      case TR::lushr:
+         result = a >> (b & 63);
+         break;
+      default:
+         {
+         if (!op.isConversion() || node->getNumChildren() != 1)
+            return bottom();
+
+         // Values are kept sign extended, so only zero extension needs work
+         TR::DataType source = node->getFirstChild()->getDataType();
+         result = a;
+         if (op.isZeroExtension() && source != TR::Int64)
+            result &= ((uint64_t)1 << (TR::DataType::getSize(source) * 8)) - 1;
+         break;
+         }
+      }
+
+   if (anyBottom)
+      return bottom();
+   if (anyTop)
+      return top();
+   return constant(truncate((int64_t)result, type));
+   }
+
+/**
+ * Replace the loads of constant values and fold the branches that always go
+ * the same way. Returns the number of changes.
+ */
+int32_t
+TR_SparseConditionalConstantPropagation::transform(TR::Region &region)
+   {
+   TR::CFG *cfg = comp()->getFlowGraph();
+   TR::vector<TR::TreeTop *, TR::Region&> decidedBranches(region);
+   TR::vector<TR::Block *, TR::Region&> decidedBlocks(region);
+   TR::vector<int32_t, TR::Region&> branchDirections(region);
+   int32_t numChanges = 0;
+
+   // Decide the branches before any loads below them turn into constants
+   for (TR::CFGNode *node = cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      if (!block->getEntry() || !_executableBlocks->isSet(block->getNumber()))
+         continue;
+
+      TR::TreeTop *last = block->getLastRealTreeTop();
+      TR::Node *lastNode = last->getNode();
+      if (!lastNode->getOpCode().isIf() || !lastNode->getOpCode().isBooleanCompare())
+         continue;
+
+      _visitCount = comp()->incVisitCount();
+      _nodeValues->clear();
+      Lattice condition = evaluateCompare(lastNode);
+      if (condition._state == Lattice::Constant)
+         {
+         decidedBranches.push_back(last);
+         decidedBlocks.push_back(block);
+         branchDirections.push_back(condition._value != 0 ? 1 : 0);
+         }
+      }
+
+   _visitCount = comp()->incVisitCount();
+   for (TR::CFGNode *node = cfg->getFirstNode(); node; node = node->getNext())
+      {
+      TR::Block *block = toBlock(node);
+      if (!block->getEntry() || !_executableBlocks->isSet(block->getNumber()))
+         continue;
+      for (TR::TreeTop *tt = block->getEntry(); tt != block->getExit(); tt = tt->getNextTreeTop())
+         numChanges += replaceLoads(tt->getNode());
+      }
+
+   for (size_t i = 0; i < decidedBranches.size(); i++)
+      {
+      TR::TreeTop *tt = decidedBranches[i];
+      TR::Block *block = decidedBlocks[i];
+      if (block->nodeIsRemoved())
+         continue;
+      TR::Node *branch = tt->getNode();
+      changeConditionalToUnconditional(branch, block, branchDirections[i], tt, OPT_DETAILS);
+
+      // A branch that is never taken is left without children for the caller to remove
+      if (!branch)
+         {
+         TR::TransformUtil::removeTree(comp(), tt);
+         numChanges++;
+         }
+      else if (branch->getOpCodeValue() == TR::Goto)
+         {
+         numChanges++;
+         }
+      }
+
+   if (numChanges > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      optimizer()->setAliasSetsAreValid(false);
+      cfg->invalidateStructure();
+      requestOpt(OMR::treeSimplification);
+      requestOpt(OMR::deadTreesElimination);
+      }
+
+   return numChanges;
+   }
+
+int32_t
+TR_SparseConditionalConstantPropagation::replaceLoads(TR::Node *node)
+   {
+   if (node->getVisitCount() == _visitCount)
+      return 0;
+   node->setVisitCount(_visitCount);
+
+   int32_t numChanges = 0;
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      numChanges += replaceLoads(node->getChild(i));
+
+   if (!node->getOpCode().isLoadVarDirect())
+      return numChanges;
+
+   TR_SSAForm::Value *value = _ssa->getValue(node);
+   TR::DataType type = node->getDataType();
+   if (!value || !isTrackedType(type))
+      return numChanges;
+
+   Lattice &lattice = (*_values)[value->getIndex()];
+   if (lattice._state != Lattice::Constant)
+      return numChanges;
+
+   if (!performTransformation(comp(), "%sReplacing load n%dn of #%d by constant " INT64_PRINTF_FORMAT "\n", OPT_DETAILS,
+         node->getGlobalIndex(), node->getSymbolReference()->getReferenceNumber(), lattice._value))
+      return numChanges;
+
+   node->setUseDefIndex(0);
+   switch (type)
+      {
+      case TR::Int8:
+         TR::Node::recreate(node, TR::bconst);
+         node->setByte((int8_t)lattice._value);
+         break;
+      case TR::Int16:
+         TR::Node::recreate(node, TR::sconst);
+         node->setShortInt((int16_t)lattice._value);
+         break;
+      case TR::Int32:
+         TR::Node::recreate(node, TR::iconst);
+         node->setInt((int32_t)lattice._value);
+         break;
+      default:
+         TR::Node::recreate(node, TR::lconst);
+         node->setLongInt(lattice._value);
+         break;
+      }
+
+   return numChanges + 1;
+   }
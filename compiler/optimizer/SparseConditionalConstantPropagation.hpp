@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef SCCP_INCL
+#define SCCP_INCL
+
+#include <map>
+#include <set>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "env/TypedAllocator.hpp"
+#include "env/jittypes.h"
+#include "il/DataTypes.hpp"
+#include "infra/vector.hpp"
+#include "optimizer/Optimization.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_BitVector;
+class TR_SSAForm;
+namespace TR { class Block; }
+namespace TR { class CFGEdge; }
+namespace TR { class Node; }
+namespace TR { class Optimization; }
+namespace TR { class TreeTop; }
+
+/**
+ * Class TR_SparseConditionalConstantPropagation
+ * =============================================
+ *
+ * Sparse conditional constant propagation (Wegman and Zadeck) over the SSA
+ * form built by TR_SSAForm. Every SSA value of an integral auto or parm
+ * starts at Top (no evidence yet), may be lowered to a single constant,
+ * and ends at Bottom (overdefined) once two different constants, or a
+ * value that cannot be computed, reach it.
+ *
+ * Only blocks reached through executable CFG edges are evaluated. A phi
+ * meets the values coming in on its executable edges, and a conditional
+ * branch whose operands are constant only makes the edge it takes
+ * executable, so constants flowing around a branch that is never taken are
+ * still found. When a value is lowered, just the blocks that read it are
+ * evaluated again.
+ *
+ * Once the lattice is stable, loads of constant values are replaced by the
+ * constants and branches that always go the same way are changed into
+ * gotos or removed, which leaves the blocks that were never executable
+ * unreachable for the CFG to remove.
+ *
+ * Values merged at the start of an exception handler are always Bottom.
+ */
+class TR_SparseConditionalConstantPropagation : public TR::Optimization
+   {
+   public:
+   TR_SparseConditionalConstantPropagation(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_SparseConditionalConstantPropagation(manager);
+      }
+
+   virtual bool    shouldPerform();
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   struct Lattice
+      {
+      enum State
+         {
+         Top,
+         Constant,
+         Bottom
+         };
+
+      State _state;
+      int64_t _value;      // sign extended from the width of the type
+
+      bool operator==(const Lattice &other) const
+         {
+         return _state == other._state && (_state != Constant || _value == other._value);
+         }
+      bool operator!=(const Lattice &other) const { return !(*this == other); }
+      };
+
+   static Lattice top()                   { Lattice l = { Lattice::Top, 0 }; return l; }
+   static Lattice bottom()                { Lattice l = { Lattice::Bottom, 0 }; return l; }
+   static Lattice constant(int64_t value) { Lattice l = { Lattice::Constant, value }; return l; }
+   static Lattice meet(const Lattice &a, const Lattice &b);
+
+   static bool isTrackedType(TR::DataType type);
+   static int64_t truncate(int64_t value, TR::DataType type);
+
+   void propagate();
+   void evaluateBlock(TR::Block *block);
+   void markSuccessors(TR::Block *block, TR::Node *lastNode);
+   void markEdge(TR::CFGEdge *edge);
+   void setValue(int32_t index, Lattice value);
+   void enqueue(TR::Block *block);
+
+   Lattice evaluate(TR::Node *node);
+   Lattice evaluateOperation(TR::Node *node);
+   Lattice evaluateCompare(TR::Node *node);
+
+   typedef TR::typed_allocator<TR::CFGEdge *, TR::Region &> EdgeSetAllocator;
+   typedef std::set<TR::CFGEdge *, std::less<TR::CFGEdge *>, EdgeSetAllocator> EdgeSet;
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, Lattice>, TR::Region &> NodeLatticeMapAllocator;
+   typedef std::map<TR::Node *, Lattice, std::less<TR::Node *>, NodeLatticeMapAllocator> NodeLatticeMap;
+
+   int32_t transform(TR::Region &region);
+   int32_t replaceLoads(TR::Node *node);
+
+   TR_SSAForm *_ssa;
+   TR::vector<Lattice, TR::Region&> *_values;          // by SSA value index
+   TR::vector<TR::Block *, TR::Region&> *_worklist;
+   TR_BitVector *_onWorklist;
+   TR_BitVector *_executableBlocks;
+   EdgeSet *_executableEdges;
+   NodeLatticeMap *_nodeValues;     // nodes evaluated in the current block, by visit count
+   vcount_t _visitCount;
+   };
+
+#endif
@@ -24,6 +24,7 @@
 
 #include <stdint.h>
 #include <string.h>
+#include "codegen/CodeGenerator.hpp"
 #include "env/FrontEnd.hpp"
 #include "compile/Compilation.hpp"
 #include "env/IO.hpp"
@@ -43,18 +44,22 @@
 #define MIN_CASES_FOR_OPT 4
 #define SWITCH_TO_IFS_THRESHOLD 3
 #define LOOKUP_SWITCH_GEN_IN_IL_OVERRIDE 15
+#define MAX_BIT_TEST_TARGETS 3
 
 #define OPT_DETAILS "O^O SWITCH ANALYZER: "
 
 TR::SwitchAnalyzer::SwitchAnalyzer(TR::OptimizationManager *manager)
    : TR::Optimization(manager)
    {
-   // default values //FIXME
-   _costMem    = 1;
+   TR::CodeGenerator *cg = comp()->cg();
+   _costMem    = cg->getSwitchJumpTableEntryCost();
 
-   _costUnique = 3 + 6; // cost_cl + cost_bc
-   _costRange  = 3 + 3 + 6; // cost_s + cost_cl + cost_bc
-   _costDense  = _costRange + 10; // _costRange + cost_lba
+   _costUnique = cg->getSwitchCompareAndBranchCost(); // cost_cl + cost_bc
+   _costRange  = cg->getSwitchRangeTestCost(); // cost_s + cost_cl + cost_bc
+   _costDense  = cg->getSwitchJumpTableCost(); // _costRange + cost_lba
+
+   _costBitTest  = cg->getSwitchBitTestCost();
+   _bitTestWidth = cg->getSwitchBitTestWidth();
 
    _minDensity = .01f;
    _binarySearchBound = 4;
@@ -211,6 +216,10 @@ void TR::SwitchAnalyzer::analyze(TR::Node *node, TR::Block *block)
       change=mergeDenseSets(chain);
       }
 
+   // Dispatch neighbouring nodes that reach only a few targets with bit tests
+   //
+   findBitTestSets(chain);
+
    // Gather lonely uniq's and small dense nodes out of the main switch
    //
    TR_LinkHead<SwitchInfo> *bound = gather(chain);
@@ -350,6 +359,129 @@ bool TR::SwitchAnalyzer::mergeDenseSets(TR_LinkHead<SwitchInfo> *chain)
    return change;
    }
 
+void TR::SwitchAnalyzer::findBitTestSets(TR_LinkHead<SwitchInfo> *chain)
+   {
+   if (_bitTestWidth <= 0)
+      return;
+
+   // Replace the longest run of nodes that spans no more than _bitTestWidth
+   // values and reaches at most MAX_BIT_TEST_TARGETS targets by a bit test
+   // node, if testing one mask per target is cheaper than searching the run
+   //
+   for (SwitchInfo *prev = 0, *cur = chain->getFirst();
+        cur;
+        prev = cur, cur = cur->getNext())
+      {
+      TR::TreeTop *targets[MAX_BIT_TEST_TARGETS];
+      int32_t numTargets = 0;
+      int32_t endTargets = 0;
+      int32_t numNodes   = 0;
+      int32_t origCost   = 0;
+      SwitchInfo *end = 0;
+
+      for (SwitchInfo *next = cur; next; next = next->getNext())
+         {
+         if ((int64_t)next->_max - (int64_t)cur->_min >= _bitTestWidth ||
+             !collectTargets(next, targets, numTargets))
+            break;
+
+         end = next;
+         endTargets = numTargets;
+         origCost += next->_cost + (numNodes > 0 ? _costRange : 0);
+         numNodes++;
+         }
+
+      if (!end || (numNodes == 1 && cur->_kind != Dense))
+         continue;
+
+      int32_t newCost = _costRange + _costBitTest * endTargets;
+      if (newCost >= origCost)
+         continue;
+
+      dumpOptDetails(comp(), "%sforming bit test set %p\n", optDetailString(), cur);
+
+      SwitchInfo *bitTest = new (trStackMemory()) SwitchInfo(trMemory());
+      bitTest->_kind = BitTest;
+
+      SwitchInfo *tail = end->getNext();
+      for (SwitchInfo *t = cur; t != tail;)
+         {
+         SwitchInfo *next = t->getNext();
+         bitTestInsert(bitTest, t);
+         t = next;
+         }
+      bitTest->_cost = newCost;
+
+      if (prev)
+         prev->setNext(bitTest);
+      else
+         chain->setFirst(bitTest);
+
+      bitTest->setNext(tail);
+      cur = bitTest;
+      }
+
+   if (trace())
+      {
+      traceMsg(comp(), "After finding bit test sets\n");
+      printInfo(comp()->fe(), comp()->getOutFile(), chain);
+      }
+   }
+
+// Adds the targets of info that are not in targets yet. Returns false, leaving
+// targets in an unspecified state, if there would be more than MAX_BIT_TEST_TARGETS.
+//
+bool TR::SwitchAnalyzer::collectTargets(SwitchInfo *info, TR::TreeTop **targets, int32_t &numTargets)
+   {
+   if (info->_kind == Dense || info->_kind == BitTest)
+      {
+      for (SwitchInfo *cur = info->_chain->getFirst(); cur; cur = cur->getNext())
+         if (!collectTargets(cur, targets, numTargets))
+            return false;
+      return true;
+      }
+
+   for (int32_t i = 0; i < numTargets; ++i)
+      if (targets[i] == info->_target)
+         return true;
+
+   if (numTargets == MAX_BIT_TEST_TARGETS)
+      return false;
+
+   targets[numTargets++] = info->_target;
+   return true;
+   }
+
+void TR::SwitchAnalyzer::bitTestInsert(SwitchInfo *bitTest, SwitchInfo *info)
+   {
+   TR_ASSERT(bitTest->_kind == BitTest, "expecting bit test node");
+
+   if (info->_kind == Dense || info->_kind == BitTest)
+      {
+      SwitchInfo *cur = info->_chain->getFirst();
+      while (cur)
+         {
+         SwitchInfo *next = cur->getNext();
+         bitTestInsert(bitTest, cur);
+         cur = next;
+         }
+      return;
+      }
+
+   // Uniques and ranges are kept as they are, the masks are built when the
+   // node is emitted
+   //
+   chainInsert(bitTest->_chain, info);
+
+   if (info->_min < bitTest->_min)
+      bitTest->_min = info->_min;
+   if (info->_max > bitTest->_max)
+      bitTest->_max = info->_max;
+
+   bitTest->_freq += info->_freq;
+   bitTest->_count+= info->_count;
+   }
+
 TR_LinkHead<TR::SwitchAnalyzer::SwitchInfo> *TR::SwitchAnalyzer::gather(TR_LinkHead<SwitchInfo> *chain)
    {
    SwitchInfo *prev = 0;
@@ -365,9 +497,10 @@ TR_LinkHead<TR::SwitchAnalyzer::SwitchInfo> *TR::SwitchAnalyzer::gather(TR_LinkH
       next = cur->getNext();
       dumpOptDetails(comp(), "%sgathering set %p\n", optDetailString(), cur);
 
-      // ignore range nodes and dense nodes that are large
+      // ignore range nodes, bit test nodes and dense nodes that are large
       //
       if ((cur->_kind == Range) ||
+          (cur->_kind == BitTest) ||
           (cur->_kind == Dense  &&  cur->_count >= _smallDense))
          {
          prev = cur;
@@ -545,6 +678,11 @@ void TR::SwitchAnalyzer::SwitchInfo::print(TR_FrontEnd *fe, TR::FILE *pOutFile,
          for (SwitchInfo *info = _chain->getFirst(); info; info = info->getNext())
             info->print(fe, pOutFile, indent+40);
          break;
+      case BitTest:
+         trfprintf(pOutFile, " [////] BitTest\n");
+         for (SwitchInfo *info = _chain->getFirst(); info; info = info->getNext())
+            info->print(fe, pOutFile, indent+40);
+         break;
       }
 
    }
@@ -998,6 +1136,11 @@ TR::Block *TR::SwitchAnalyzer::binSearch(SwitchInfo *startNode, SwitchInfo *endN
          cmpOp = _isInt64 ? (_signed ? TR::iflcmpgt : TR::iflucmpgt) : (_signed ? TR::ificmpgt : TR::ifiucmpgt);
          return addIfBlock  (cmpOp, endNode->_max, _defaultDest);
          }
+      else if (endNode->_kind == BitTest)
+         {
+         addGotoBlock(_defaultDest);
+         return addBitTestBlocks(endNode, !(rangeRight == endNode->_max && rangeLeft == endNode->_min));
+         }
       else
          {
          TR::Block *tableBlock = addTableBlock(endNode);
@@ -1180,6 +1323,10 @@ TR::Block *TR::SwitchAnalyzer::linearSearch(SwitchInfo *start)
          cmpOp = _isInt64 ? (_signed ? TR::iflcmplt : TR::iflucmplt) : (_signed ? TR::ificmplt : TR::ifiucmplt);
          newBlock = addIfBlock(cmpOp, cursor->_min, _defaultDest);
          }
+      else if (cursor->_kind == BitTest)
+         {
+         newBlock = addBitTestBlocks(cursor, true);
+         }
       else
          {
          newBlock = addTableBlock(cursor);
@@ -1225,6 +1372,12 @@ TR::Block *TR::SwitchAnalyzer::addIfBlock(TR::ILOpCodes opCode, CASECONST_TYPE v
                                      constNode);
 
    node->setBranchDestination(dest);
+   return addIfBlock(node);
+   }
+
+TR::Block *TR::SwitchAnalyzer::addIfBlock(TR::Node *node)
+   {
+   TR::TreeTop *dest = node->getBranchDestination();
    TR::Block *newBlock = TR::Block::createEmptyBlock(node, comp(), _block->getFrequency(), _block);
 
    newBlock->append(TR::TreeTop::create(comp(), node));
@@ -1302,6 +1455,116 @@ TR::Block *TR::SwitchAnalyzer::addTableBlock(SwitchInfo *dense)
    return newBlock;
    }
 
+// The selector minus base, as an Int32 if isInt64 is false
+//
+TR::Node *TR::SwitchAnalyzer::createSelectorOffset(CASECONST_TYPE base, bool isInt64)
+   {
+   TR::Node *load = TR::Node::createLoad(_switch, _temp);
+   if (_isInt64)
+      {
+      TR::Node *offset = TR::Node::create(_switch, TR::lsub, 2, load, TR::Node::lconst(_switch, base));
+      return isInt64 ? offset : TR::Node::create(_switch, TR::l2i, 1, offset);
+      }
+
+   return TR::Node::create(_switch, TR::isub, 2, load, TR::Node::iconst(_switch, base));
+   }
+
+// Emits
+//
+//    if ((unsigned)(selector - min) > max - min) goto default      (if needsRangeTest)
+//    if ((1 << (selector - min)) & mask1) goto target1
+//    ...
+//    if ((1 << (selector - min)) & maskN) goto targetN
+//
+// falling through into _nextBlock when no bit is set
+//
+TR::Block *TR::SwitchAnalyzer::addBitTestBlocks(SwitchInfo *info, bool needsRangeTest)
+   {
+   TR_ASSERT(info->_kind == BitTest, "expecting bit test node");
+
+   TR::TreeTop *targets[MAX_BIT_TEST_TARGETS];
+   uint64_t     masks[MAX_BIT_TEST_TARGETS];
+   int32_t      counts[MAX_BIT_TEST_TARGETS];
+   int32_t      numTargets = 0;
+
+   for (SwitchInfo *cur = info->_chain->getFirst(); cur; cur = cur->getNext())
+      {
+      int32_t t = 0;
+      while (t < numTargets && targets[t] != cur->_target)
+         t++;
+
+      if (t == numTargets)
+         {
+         TR_ASSERT(numTargets < MAX_BIT_TEST_TARGETS, "too many targets for a bit test node");
+         targets[t] = cur->_target;
+         masks[t]   = 0;
+         counts[t]  = 0;
+         numTargets++;
+         }
+
+      for (int64_t value = cur->_min; value <= cur->_max; ++value)
+         masks[t] |= ((uint64_t)1) << (value - info->_min);
+      counts[t] += cur->_count;
+      }
+
+   // The blocks are prepended, so add the target reached by the fewest values
+   // first for the most likely target to be tested first
+   //
+   for (int32_t i = 1; i < numTargets; ++i)
+      {
+      for (int32_t j = i; j > 0 && counts[j - 1] > counts[j]; --j)
+         {
+         TR::TreeTop *target = targets[j]; targets[j] = targets[j - 1]; targets[j - 1] = target;
+         uint64_t     mask   = masks[j];   masks[j]   = masks[j - 1];   masks[j - 1]   = mask;
+         int32_t      count  = counts[j];  counts[j]  = counts[j - 1];  counts[j - 1]  = count;
+         }
+      }
+
+   bool isWide = (int64_t)info->_max - (int64_t)info->_min >= 32;
+   TR_ASSERT(!isWide || comp()->target().is64Bit(), "bit test wider than 32 bits on a 32-bit target");
+
+   TR::Block *newBlock = 0;
+   for (int32_t t = 0; t < numTargets; ++t)
+      {
+      TR::Node *test;
+      if (isWide)
+         {
+         TR::Node *bit = TR::Node::create(_switch, TR::lshl, 2, TR::Node::lconst(_switch, 1), createSelectorOffset(info->_min, false));
+         test = TR::Node::createif(TR::iflcmpne,
+                                   TR::Node::create(_switch, TR::land, 2, bit, TR::Node::lconst(_switch, (int64_t)masks[t])),
+                                   TR::Node::lconst(_switch, 0),
+                                   targets[t]);
+         }
+      else
+         {
+         TR::Node *bit = TR::Node::create(_switch, TR::ishl, 2, TR::Node::iconst(_switch, 1), createSelectorOffset(info->_min, false));
+         test = TR::Node::createif(TR::ificmpne,
+                                   TR::Node::create(_switch, TR::iand, 2, bit, TR::Node::iconst(_switch, (int32_t)masks[t])),
+                                   TR::Node::iconst(_switch, 0),
+                                   targets[t]);
+         }
+      newBlock = addIfBlock(test);
+      }
+
+   if (needsRangeTest)
+      {
+      TR::Node *test;
+      if (_isInt64)
+         test = TR::Node::createif(TR::iflucmpgt,
+                                   createSelectorOffset(info->_min, true),
+                                   TR::Node::lconst(_switch, (int64_t)info->_max - (int64_t)info->_min),
+                                   _defaultDest);
+      else
+         test = TR::Node::createif(TR::ifiucmpgt,
+                                   createSelectorOffset(info->_min, false),
+                                   TR::Node::iconst(_switch, info->_max - info->_min),
+                                   _defaultDest);
+      newBlock = addIfBlock(test);
+      }
+
+   return newBlock;
+   }
+
 
 int32_t *TR::SwitchAnalyzer::setupFrequencies(TR::Node *node)
    {
@@ -57,7 +57,7 @@ class SwitchAnalyzer : public TR::Optimization
 
    void analyze(TR::Node *node, TR::Block *block);
 
-   enum NodeKind { Unique, Range, Dense };
+   enum NodeKind { Unique, Range, Dense, BitTest };
 
    class SwitchInfo : public TR_Link<SwitchInfo>
       {
@@ -83,7 +83,7 @@ class SwitchAnalyzer : public TR::Optimization
       union
 	 {
 	 TR::TreeTop              *_target; // range and unique
-	 TR_LinkHead<SwitchInfo> *_chain;  // dense
+	 TR_LinkHead<SwitchInfo> *_chain;  // dense and bit test
 	 };
       };
 
@@ -96,6 +96,9 @@ class SwitchAnalyzer : public TR::Optimization
 
    void findDenseSets(TR_LinkHead<SwitchInfo> *chain);
    bool mergeDenseSets(TR_LinkHead<SwitchInfo> *chain);
+   void findBitTestSets(TR_LinkHead<SwitchInfo> *chain);
+   bool collectTargets(SwitchInfo *info, TR::TreeTop **targets, int32_t &numTargets);
+   void bitTestInsert(SwitchInfo *bitTest, SwitchInfo *info);
    TR_LinkHead<SwitchInfo> *gather(TR_LinkHead<SwitchInfo> *chain);
 
    int32_t countMajorsInChain(TR_LinkHead<SwitchInfo> *chain);
@@ -106,12 +109,15 @@ class SwitchAnalyzer : public TR::Optimization
    TR::Block *binSearch(SwitchInfo *startNode, SwitchInfo *endNode, int32_t numMajors,
 		       CASECONST_TYPE rangeLeft, CASECONST_TYPE rangeRight);
    TR::Block *addIfBlock(TR::ILOpCodes opCode, CASECONST_TYPE val, TR::TreeTop *dest);
+   TR::Block *addIfBlock(TR::Node *ifNode);
    TR::Block *linearSearch(SwitchInfo *start);
    SwitchInfo *sortedListByFrequency(SwitchInfo *start);
 
    TR::Block *addGotoBlock(TR::TreeTop *dest);
 
    TR::Block *addTableBlock(SwitchInfo *info);
+   TR::Block *addBitTestBlocks(SwitchInfo *info, bool needsRangeTest);
+   TR::Node *createSelectorOffset(CASECONST_TYPE base, bool isInt64);
 
    int32_t *setupFrequencies(TR::Node *node);
    TR::Block *checkIfDefaultIsDominant(SwitchInfo *start);
@@ -148,6 +154,8 @@ class SwitchAnalyzer : public TR::Optimization
    int32_t _costRange;
    int32_t _costUnique;
    int32_t _costDense;
+   int32_t _costBitTest;
+   int32_t _bitTestWidth;
 
    bool    _haveProfilingInfo;
    };
@@ -0,0 +1,1162 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "optimizer/UnrollAndJam.hpp"
+
+#include <stddef.h>
+#include <stdint.h>
+#include "compile/Compilation.hpp"
+#include "compile/SymbolReferenceTable.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "env/TRMemory.hpp"
+#include "il/Block.hpp"
+#include "il/DataTypes.hpp"
+#include "il/ILOpCodes.hpp"
+#include "il/ILOps.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/Symbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Assert.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/Cfg.hpp"
+#include "infra/CfgEdge.hpp"
+#include "infra/Checklist.hpp"
+#include "infra/List.hpp"
+#include "optimizer/Optimization_inlines.hpp"
+#include "optimizer/Optimizer.hpp"
+#include "optimizer/Structure.hpp"
+#include "ras/Debug.hpp"
+
+#define OPT_DETAILS "O^O UNROLL AND JAM: "
+
+// Upper bound on the runtime overlap checks emitted in front of a single nest
+#define MAX_OVERLAP_CHECKS 8
+
+// Nests up to this many nodes are unrolled four times, and up to twice as
+// many two times
+#define MAX_NODES_FOR_FOUR_COPIES 256
+
+TR_UnrollAndJam::TR_UnrollAndJam(TR::OptimizationManager *manager)
+   : TR_LoopTransformer(manager),
+     _nestInfos(trMemory()),
+     _storedSymRefs(NULL),
+     _dependence(NULL)
+   {}
+
+bool
+TR_UnrollAndJam::shouldPerform()
+   {
+   // The overlap checks are computed on 64-bit addresses
+   if (!comp()->target().is64Bit())
+      return false;
+
+   return comp()->mayHaveLoops();
+   }
+
+int32_t
+TR_UnrollAndJam::perform()
+   {
+   _cfg = comp()->getFlowGraph();
+   TR_Structure *rootStructure = _cfg->getStructure();
+   if (!rootStructure)
+      return 0;
+
+   TR::StackMemoryRegion stackMemoryRegion(*trMemory());
+
+   _nestInfos.deleteAll();
+   _storedSymRefs = new (trStackMemory()) TR_BitVector(comp()->getSymRefTab()->getNumSymRefs(), trMemory(), stackAlloc, growable);
+   _dependence = new (trStackMemory()) TR_LoopDependence(comp(), _storedSymRefs);
+
+   if (trace())
+      {
+      traceMsg(comp(), "Starting UnrollAndJam\n");
+      comp()->dumpMethodTrees("Trees before UnrollAndJam");
+      }
+
+   collectNests(rootStructure);
+
+   int32_t numTransformed = 0;
+   ListIterator<NestInfo> it(&_nestInfos);
+   for (NestInfo *ni = it.getFirst(); ni; ni = it.getNext())
+      {
+      if (!performTransformation(comp(), "%sUnrolling loop %d by %d and jamming inner loop %d\n", OPT_DETAILS,
+            ni->_outer._header->getNumber(), ni->_unrollFactor, ni->_inner._header->getNumber()))
+         continue;
+
+      // The analysis is done, and the new blocks are not part of the structure
+      _cfg->setStructure(NULL);
+      transformNest(ni);
+      numTransformed++;
+      }
+
+   if (numTransformed > 0)
+      {
+      optimizer()->setUseDefInfo(NULL);
+      optimizer()->setValueNumberInfo(NULL);
+      }
+
+   if (trace())
+      {
+      comp()->dumpMethodTrees("Trees after UnrollAndJam");
+      traceMsg(comp(), "Ending UnrollAndJam, transformed %d nests\n", numTransformed);
+      }
+
+   return numTransformed;
+   }
+
+const char *
+TR_UnrollAndJam::optDetailString() const throw()
+   {
+   return "O^O UNROLL AND JAM: ";
+   }
+
+/**
+ * A candidate is a natural loop whose only subregion is an innermost
+ * natural loop.
+ */
+void
+TR_UnrollAndJam::collectNests(TR_Structure *str)
+   {
+   TR_RegionStructure *region = str->asRegion();
+   if (!region)
+      return;
+
+   int32_t numSubRegions = 0;
+   TR_RegionStructure *innerRegion = NULL;
+   TR_RegionStructure::Cursor it(*region);
+   for (TR_StructureSubGraphNode *node = it.getCurrent(); node; node = it.getNext())
+      {
+      if (node->getStructure()->asRegion())
+         {
+         numSubRegions++;
+         innerRegion = node->getStructure()->asRegion();
+         collectNests(innerRegion);
+         }
+      }
+
+   if (!region->isNaturalLoop() || numSubRegions != 1 || !innerRegion->isNaturalLoop())
+      return;
+
+   TR_RegionStructure::Cursor innerIt(*innerRegion);
+   for (TR_StructureSubGraphNode *node = innerIt.getCurrent(); node; node = innerIt.getNext())
+      {
+      if (node->getStructure()->asRegion())
+         return;
+      }
+
+   NestInfo *ni = new (trStackMemory()) NestInfo(trMemory());
+   ni->_region = region;
+   ni->_outer._header = region->getEntryBlock();
+
+   if (ni->_outer._header->isCold())
+      {
+      if (trace())
+         traceMsg(comp(), "Loop %d is cold\n", ni->_outer._header->getNumber());
+      return;
+      }
+
+   if (analyzeNest(ni, innerRegion))
+      {
+      if (trace())
+         traceMsg(comp(), "Loop %d is an unroll-and-jam candidate\n", ni->_outer._header->getNumber());
+      _nestInfos.add(ni);
+      }
+   }
+
+bool
+TR_UnrollAndJam::analyzeNest(NestInfo *ni, TR_RegionStructure *innerRegion)
+   {
+   if (!collectNestChain(ni, innerRegion))
+      return false;
+
+   if (!analyzeEntryEdges(ni))
+      return false;
+
+   // Find every symbol written inside the nest to decide invariance
+   TR_ScratchList<TR::Block> blocks(trMemory());
+   ni->_region->getBlocks(&blocks);
+
+   _storedSymRefs->empty();
+   TR::NodeChecklist storeVisited(comp());
+   ListIterator<TR::Block> bi(&blocks);
+   for (TR::Block *block = bi.getFirst(); block; block = bi.getNext())
+      {
+      for (TR::TreeTop *tt = block->getFirstRealTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+         collectStoredSymbols(tt->getNode(), storeVisited);
+      }
+
+   if (!analyzeLatch(ni, &ni->_outer, ni->_outer._latch->getLastRealTreeTop()) ||
+       !analyzeLatch(ni, &ni->_inner, ni->_inner._latch->getLastRealTreeTop()) ||
+       ni->_outer._ivSymRef == ni->_inner._ivSymRef)
+      return false;
+
+   // The nest must leave by falling through into a block the epilogue can branch to
+   TR::Block *outerLatch = ni->_outer._latch;
+   TR::Block *exit = outerLatch->getNextBlock();
+   if (!exit || exit->isExtensionOfPreviousBlock() || outerLatch->getSuccessors().size() != 2 || !outerLatch->hasSuccessor(exit))
+      return false;
+
+   ni->_exit = exit;
+
+   _dependence->setInductionVariable(0, ni->_outer._ivSymRef);
+   _dependence->setInductionVariable(1, ni->_inner._ivSymRef);
+   if (!collectSections(ni) || !analyzeScalars(ni))
+      return false;
+
+   int32_t numNodes = 0;
+   TR::NodeChecklist countVisited(comp());
+   for (int32_t s = PreSection; s < NumSections; s++)
+      {
+      ListIterator<TR::TreeTop> ti(ni->trees((Section)s));
+      for (TR::TreeTop *tt = ti.getFirst(); tt; tt = ti.getNext())
+         numNodes += countNodes(tt->getNode(), countVisited);
+      }
+
+   if (numNodes <= MAX_NODES_FOR_FOUR_COPIES)
+      ni->_unrollFactor = 4;
+   else if (numNodes <= 2 * MAX_NODES_FOR_FOUR_COPIES)
+      ni->_unrollFactor = 2;
+   else
+      {
+      if (trace())
+         traceMsg(comp(), "Loop %d: nest of %d nodes is too large\n", ni->_outer._header->getNumber(), numNodes);
+      return false;
+      }
+
+   if (!analyzeDependences(ni))
+      return false;
+
+   if (!hasReuse(ni))
+      {
+      if (trace())
+         traceMsg(comp(), "Loop %d: no reuse between outer iterations\n", ni->_outer._header->getNumber());
+      return false;
+      }
+
+   return true;
+   }
+
+/**
+ * The outer loop must be a straight chain of blocks from its header into
+ * the inner loop's header, through the inner loop, which is itself a
+ * straight chain, and on to the outer latch, without exception edges.
+ */
+bool
+TR_UnrollAndJam::collectNestChain(NestInfo *ni, TR_RegionStructure *innerRegion)
+   {
+   TR_ScratchList<TR::Block> blocks(trMemory());
+   ni->_region->getBlocks(&blocks);
+   TR_ScratchList<TR::Block> innerBlocks(trMemory());
+   innerRegion->getBlocks(&innerBlocks);
+
+   TR::Block *outerHeader = ni->_outer._header;
+   TR::Block *innerHeader = innerRegion->getEntryBlock();
+   bool seenInner = false;
+   int32_t numBlocks = 0;
+   TR::Block *block = outerHeader;
+   while (true)
+      {
+      if (block->hasExceptionSuccessors() || block->hasExceptionPredecessors())
+         return false;
+
+      if (!blocks.find(block))
+         return false;
+
+      if (++numBlocks > blocks.getSize())
+         return false;
+
+      if (block == innerHeader)
+         {
+         if (seenInner || block->getPredecessors().size() != 2)
+            return false;
+
+         seenInner = true;
+         int32_t numInnerBlocks = 1;
+         while (!block->hasSuccessor(innerHeader))
+            {
+            if (block->getSuccessors().size() != 1)
+               return false;
+
+            block = block->getSuccessors().front()->getTo()->asBlock();
+            if (!block || block == innerHeader || !innerBlocks.find(block) || block->getPredecessors().size() != 1)
+               return false;
+
+            if (block->hasExceptionSuccessors() || block->hasExceptionPredecessors())
+               return false;
+
+            numInnerBlocks++;
+            }
+
+         if (numInnerBlocks != innerBlocks.getSize())
+            return false;
+
+         numBlocks += numInnerBlocks - 1;
+         ni->_inner._header = innerHeader;
+         ni->_inner._latch = block;
+
+         // The inner loop must fall through into the rest of the outer loop
+         TR::Block *next = block->getNextBlock();
+         if (!next || next == outerHeader || block->getSuccessors().size() != 2 || !block->hasSuccessor(next))
+            return false;
+
+         block = next;
+         continue;
+         }
+
+      if (block != outerHeader && block->getPredecessors().size() != 1)
+         return false;
+
+      if (block->hasSuccessor(outerHeader))
+         break;
+
+      if (block->getSuccessors().size() != 1)
+         return false;
+
+      block = block->getSuccessors().front()->getTo()->asBlock();
+      if (!block || block == outerHeader)
+         return false;
+      }
+
+   if (!seenInner || numBlocks != blocks.getSize())
+      return false;
+
+   ni->_outer._latch = block;
+   return true;
+   }
+
+bool
+TR_UnrollAndJam::analyzeLatch(NestInfo *ni, CountedLoop *loop, TR::TreeTop *branchTree)
+   {
+   TR::Node *branch = branchTree->getNode();
+   if (branch->getOpCodeValue() != TR::ificmplt && branch->getOpCodeValue() != TR::ificmple)
+      return false;
+
+   if (branch->getNumChildren() != 2 || branch->getBranchDestination() != loop->_header->getEntry())
+      return false;
+
+   TR::TreeTop *ivStoreTree = branchTree->getPrevTreeTop();
+   TR::Node *ivStore = ivStoreTree->getNode();
+   if (ivStore->getOpCodeValue() != TR::istore || !ivStore->getSymbol()->isAutoOrParm())
+      return false;
+
+   TR::SymbolReference *ivSymRef = ivStore->getSymbolReference();
+   TR::Node *increment = ivStore->getFirstChild();
+   if (increment->getOpCodeValue() != TR::iadd ||
+       increment->getFirstChild()->getOpCodeValue() != TR::iload ||
+       increment->getFirstChild()->getSymbolReference() != ivSymRef ||
+       increment->getSecondChild()->getOpCodeValue() != TR::iconst ||
+       increment->getSecondChild()->getInt() != 1)
+      return false;
+
+   TR::Node *compared = branch->getFirstChild();
+   if (compared != increment &&
+       !(compared->getOpCodeValue() == TR::iload && compared->getSymbolReference() == ivSymRef && compared->getReferenceCount() == 1))
+      return false;
+
+   // Both bounds are evaluated again in front of the nest
+   TR::Node *bound = branch->getSecondChild();
+   if (!_dependence->isInvariantExpression(bound))
+      return false;
+
+   loop->_ivStoreTree = ivStoreTree;
+   loop->_ivSymRef = ivSymRef;
+   loop->_bound = bound;
+   loop->_inclusiveBound = branch->getOpCodeValue() == TR::ificmple;
+   return true;
+   }
+
+/**
+ * Every edge into the outer header from outside the nest is redirected to
+ * the new trip count guard, so each of them must be a plain fall-through
+ * or a branch whose destination can be changed.
+ */
+bool
+TR_UnrollAndJam::analyzeEntryEdges(NestInfo *ni)
+   {
+   TR::Block *header = ni->_outer._header;
+   if (!header->getEntry()->getPrevTreeTop())
+      return false;
+
+   int32_t numEntries = 0;
+   for (auto edge = header->getPredecessors().begin(); edge != header->getPredecessors().end(); ++edge)
+      {
+      TR::Block *pred = (*edge)->getFrom()->asBlock();
+      if (pred == ni->_outer._latch)
+         continue;
+
+      if (!pred->getEntry())
+         return false;
+
+      TR::Node *lastNode = pred->getLastRealTreeTop()->getNode();
+      if (lastNode->getOpCode().isSwitch() || lastNode->getOpCode().isJumpWithMultipleTargets())
+         return false;
+
+      bool branchesToHeader = lastNode->getOpCode().isBranch() && lastNode->getBranchDestination() == header->getEntry();
+      bool fallsIntoHeader = pred->getExit()->getNextTreeTop() == header->getEntry();
+      if (branchesToHeader == fallsIntoHeader)
+         return false;
+
+      numEntries++;
+      }
+
+   return numEntries > 0;
+   }
+
+/**
+ * Sort the nest's trees into the pre, inner and post sections and check
+ * that each of them can be copied. A node commoned from an earlier section
+ * is evaluated again in each copy, so it must be loop invariant.
+ */
+bool
+TR_UnrollAndJam::collectSections(NestInfo *ni)
+   {
+   TR::SymbolReference *innerIv = ni->_inner._ivSymRef;
+   TR::NodeChecklist earlierNodes(comp());
+   TR::NodeChecklist preNodes(comp());
+   TR::NodeChecklist innerNodes(comp());
+   TR::NodeChecklist postNodes(comp());
+   ListAppender<TR::TreeTop> preTrees(&ni->_preTrees);
+   ListAppender<TR::TreeTop> innerTrees(&ni->_innerTrees);
+   ListAppender<TR::TreeTop> postTrees(&ni->_postTrees);
+
+   Section section = PreSection;
+   TR::NodeChecklist *sectionNodes = &preNodes;
+   ListAppender<TR::TreeTop> *sectionTrees = &preTrees;
+   TR::Block *block = ni->_outer._header;
+   while (true)
+      {
+      if (block == ni->_inner._header)
+         {
+         earlierNodes.add(preNodes);
+         section = InnerSection;
+         sectionNodes = &innerNodes;
+         sectionTrees = &innerTrees;
+         }
+
+      for (TR::TreeTop *tt = block->getFirstRealTreeTop(); tt != block->getExit(); tt = tt->getNextTreeTop())
+         {
+         if (tt == ni->_inner._ivStoreTree || tt == ni->_outer._ivStoreTree)
+            break;
+
+         TR::Node *node = tt->getNode();
+         if (node->getOpCodeValue() == TR::Goto)
+            continue;
+
+         if (section == PreSection && node->getOpCodeValue() == TR::istore && node->getSymbolReference() == innerIv)
+            {
+            // The inner loop must be rectangular, starting from the same value in every outer iteration
+            if (ni->_innerInitTree || !_dependence->isInvariantExpression(node->getFirstChild()))
+               return false;
+
+            ni->_innerInitTree = tt;
+            continue;
+            }
+
+         if (!analyzeTree(ni, section, node, *sectionNodes, earlierNodes))
+            {
+            if (trace())
+               traceMsg(comp(), "Loop %d: cannot copy tree n%dn (%s)\n", ni->_outer._header->getNumber(),
+                  node->getGlobalIndex(), node->getOpCode().getName());
+            return false;
+            }
+
+         sectionTrees->add(tt);
+         }
+
+      if (block == ni->_outer._latch)
+         break;
+
+      if (block == ni->_inner._latch)
+         {
+         earlierNodes.add(innerNodes);
+         section = PostSection;
+         sectionNodes = &postNodes;
+         sectionTrees = &postTrees;
+         block = block->getNextBlock();
+         }
+      else
+         {
+         block = block->getSuccessors().front()->getTo()->asBlock();
+         }
+      }
+
+   return ni->_innerInitTree != NULL && !ni->_innerTrees.isEmpty();
+   }
+
+bool
+TR_UnrollAndJam::analyzeTree(NestInfo *ni, Section section, TR::Node *node, TR::NodeChecklist &sectionNodes, TR::NodeChecklist &earlierNodes)
+   {
+   if (sectionNodes.contains(node))
+      return true;
+
+   if (earlierNodes.contains(node))
+      return _dependence->isInvariantExpression(node);
+
+   sectionNodes.add(node);
+
+   TR::ILOpCode &op = node->getOpCode();
+   if (op.isStoreIndirect() || op.isLoadIndirect())
+      {
+      TR_AffineAccess *access = new (trStackMemory()) TR_AffineAccess();
+      if (!_dependence->analyzeAccess(node, access))
+         return false;
+
+      ni->accesses(section)->add(access);
+      }
+   else if (op.isStoreDirect() || op.isLoadVarDirect())
+      {
+      TR::Symbol *symbol = node->getSymbol();
+      if (!symbol->isAutoOrParm() || symbol->isVolatile())
+         return false;
+
+      TR::SymbolReference *symRef = node->getSymbolReference();
+      if (op.isStoreDirect() && (symRef == ni->_outer._ivSymRef || symRef == ni->_inner._ivSymRef))
+         return false;
+
+      // The inner induction variable has no single value outside the inner loop
+      if (symRef == ni->_inner._ivSymRef && section != InnerSection)
+         return false;
+      }
+   else if (node->getOpCodeValue() != TR::treetop && !op.isLoadConst() && !TR_LoopDependence::isPureOperation(node))
+      {
+      return false;
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!analyzeTree(ni, section, node->getChild(i), sectionNodes, earlierNodes))
+         return false;
+      }
+
+   return true;
+   }
+
+/**
+ * Autos written in the nest get a temporary per copy, which is only
+ * correct when each outer iteration writes them before reading them and
+ * nothing reads them after the nest.
+ */
+bool
+TR_UnrollAndJam::analyzeScalars(NestInfo *ni)
+   {
+   TR_BitVector *written = new (trStackMemory()) TR_BitVector(comp()->getSymRefTab()->getNumSymRefs(), trMemory(), stackAlloc, growable);
+   TR::NodeChecklist visited(comp());
+   for (int32_t s = PreSection; s < NumSections; s++)
+      {
+      ListIterator<TR::TreeTop> ti(ni->trees((Section)s));
+      for (TR::TreeTop *tt = ti.getFirst(); tt; tt = ti.getNext())
+         {
+         if (!checkScalarOrder(ni, tt->getNode(), written, visited))
+            {
+            if (trace())
+               traceMsg(comp(), "Loop %d: a scalar is carried between outer iterations\n", ni->_outer._header->getNumber());
+            return false;
+            }
+         }
+      }
+
+   if (written->isEmpty())
+      return true;
+
+   if (isReadOutsideNest(ni, written))
+      {
+      if (trace())
+         traceMsg(comp(), "Loop %d: a scalar written in the nest is live after it\n", ni->_outer._header->getNumber());
+      return false;
+      }
+
+   TR_BitVectorIterator bvi(*written);
+   while (bvi.hasMoreElements())
+      ni->_renamedSymRefs.add(comp()->getSymRefTab()->getSymRef(bvi.getNextElement()));
+
+   return true;
+   }
+
+bool
+TR_UnrollAndJam::checkScalarOrder(NestInfo *ni, TR::Node *node, TR_BitVector *written, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return true;
+   visited.add(node);
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (!checkScalarOrder(ni, node->getChild(i), written, visited))
+         return false;
+      }
+
+   if (!node->getOpCode().isLoadVarDirect() && !node->getOpCode().isStoreDirect())
+      return true;
+
+   TR::SymbolReference *symRef = node->getSymbolReference();
+   if (symRef == ni->_outer._ivSymRef || symRef == ni->_inner._ivSymRef)
+      return true;
+
+   int32_t refNum = symRef->getReferenceNumber();
+   if (node->getOpCode().isStoreDirect())
+      written->set(refNum);
+   else if (_storedSymRefs->get(refNum) && !written->get(refNum))
+      return false;
+
+   return true;
+   }
+
+bool
+TR_UnrollAndJam::isReadOutsideNest(NestInfo *ni, TR_BitVector *symRefs)
+   {
+   TR_ScratchList<TR::Block> blocks(trMemory());
+   ni->_region->getBlocks(&blocks);
+   TR::BlockChecklist nestBlocks(comp());
+   ListIterator<TR::Block> bi(&blocks);
+   for (TR::Block *block = bi.getFirst(); block; block = bi.getNext())
+      nestBlocks.add(block);
+
+   TR::NodeChecklist visited(comp());
+   bool inNest = false;
+   for (TR::TreeTop *tt = comp()->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      TR::Node *node = tt->getNode();
+      if (node->getOpCodeValue() == TR::BBStart)
+         {
+         inNest = nestBlocks.contains(node->getBlock());
+         continue;
+         }
+
+      if (!inNest && containsLoad(node, symRefs, visited))
+         return true;
+      }
+
+   return false;
+   }
+
+bool
+TR_UnrollAndJam::containsLoad(TR::Node *node, TR_BitVector *symRefs, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return false;
+   visited.add(node);
+
+   if (node->getOpCode().isLoadVarDirect() && symRefs->get(node->getSymbolReference()->getReferenceNumber()))
+      return true;
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      {
+      if (containsLoad(node->getChild(i), symRefs, visited))
+         return true;
+      }
+
+   return false;
+   }
+
+/**
+ * In the jammed nest the pre sections of all copies run before any inner
+ * loop, the inner iterations of all copies are interleaved, and the post
+ * sections run after every inner loop. An access of a later copy therefore
+ * moves ahead of an access of an earlier copy when it is in the pre section
+ * and the earlier one is not, or when both are in the inner loop and the
+ * later one is at an earlier inner iteration, or when the earlier one is in
+ * the post section and the later one is not.
+ */
+bool
+TR_UnrollAndJam::analyzeDependences(NestInfo *ni)
+   {
+   for (int32_t firstSection = PreSection; firstSection < NumSections; firstSection++)
+      {
+      for (int32_t secondSection = PreSection; secondSection < NumSections; secondSection++)
+         {
+         bool movesAhead = secondSection == PreSection ? firstSection != PreSection :
+                           (secondSection == InnerSection ? firstSection != PreSection : false);
+         if (!movesAhead)
+            continue;
+
+         ListIterator<TR_AffineAccess> fi(ni->accesses((Section)firstSection));
+         for (TR_AffineAccess *first = fi.getFirst(); first; first = fi.getNext())
+            {
+            ListIterator<TR_AffineAccess> si(ni->accesses((Section)secondSection));
+            for (TR_AffineAccess *second = si.getFirst(); second; second = si.getNext())
+               {
+               if (!first->isStore() && !second->isStore())
+                  continue;
+
+               if (!first->hasSameBase(*second))
+                  {
+                  if (!addOverlapCheck(ni, first, second))
+                     {
+                     if (trace())
+                        traceMsg(comp(), "Loop %d: too many overlap checks\n", ni->_outer._header->getNumber());
+                     return false;
+                     }
+                  continue;
+                  }
+
+               if (!mayReorder(ni, (Section)firstSection, first, (Section)secondSection, second))
+                  {
+                  if (trace())
+                     traceMsg(comp(), "Loop %d: n%dn depends on n%dn of an earlier outer iteration\n", ni->_outer._header->getNumber(),
+                        second->_node->getGlobalIndex(), first->_node->getGlobalIndex());
+                  return false;
+                  }
+               }
+            }
+         }
+      }
+
+   return true;
+   }
+
+/**
+ * \p first is at outer iteration `j` and \p second at `j + d` for every
+ * copy distance `0 < d < unrollFactor`; return true when \p second may move
+ * ahead of \p first.
+ */
+bool
+TR_UnrollAndJam::mayReorder(NestInfo *ni, Section firstSection, TR_AffineAccess *first, Section secondSection, TR_AffineAccess *second)
+   {
+   int64_t outerCoefficient = first->_coefficients[0];
+   if (second->_coefficients[0] != outerCoefficient)
+      return false;
+
+   // The inner induction variable's range, when it is known at compile time
+   int64_t innerFirst = -LOOP_DEPENDENCE_UNBOUNDED;
+   int64_t innerLast = LOOP_DEPENDENCE_UNBOUNDED;
+   TR::Node *innerInit = ni->_innerInitTree->getNode()->getFirstChild();
+   TR::Node *innerBound = ni->_inner._bound;
+   if (innerInit->getOpCodeValue() == TR::iconst && innerBound->getOpCodeValue() == TR::iconst)
+      {
+      innerFirst = innerInit->getInt();
+      innerLast = (int64_t)innerBound->getInt() - (ni->_inner._inclusiveBound ? 0 : 1);
+      if (innerLast < innerFirst)
+         innerLast = innerFirst;
+      }
+
+   int64_t step = 0;
+   int64_t minMultiple = innerFirst;
+   int64_t maxMultiple = innerLast;
+   if (firstSection == InnerSection && secondSection == InnerSection)
+      {
+      // The distance is `innerCoefficient * (k2 - k1)`, and the later copy only
+      // moves ahead at earlier inner iterations `k2 < k1`
+      if (first->_coefficients[1] != second->_coefficients[1])
+         return false;
+
+      step = first->_coefficients[1];
+      minMultiple = innerLast == LOOP_DEPENDENCE_UNBOUNDED ? -LOOP_DEPENDENCE_UNBOUNDED : innerFirst - innerLast;
+      maxMultiple = -1;
+      }
+   else
+      {
+      // At most one of the accesses is in the inner loop, at any inner iteration
+      step = second->_coefficients[1] - first->_coefficients[1];
+      }
+
+   for (int32_t d = 1; d < ni->_unrollFactor; d++)
+      {
+      int64_t distance = second->_offset - first->_offset + outerCoefficient * d;
+      if (TR_LoopDependence::mayOverlap(distance, step, minMultiple, maxMultiple, first->_size, second->_size))
+         return false;
+      }
+
+   return true;
+   }
+
+bool
+TR_UnrollAndJam::addOverlapCheck(NestInfo *ni, TR_AffineAccess *first, TR_AffineAccess *second)
+   {
+   int32_t numChecks = 0;
+   ListIterator<TR_AffineAccess> ci(&ni->_overlapChecks);
+   for (TR_AffineAccess *checkFirst = ci.getFirst(); checkFirst; checkFirst = ci.getNext())
+      {
+      TR_AffineAccess *checkSecond = ci.getNext();
+      if ((checkFirst == first && checkSecond == second) || (checkFirst == second && checkSecond == first))
+         return true;
+      numChecks++;
+      }
+
+   if (numChecks == MAX_OVERLAP_CHECKS)
+      return false;
+
+   ni->_overlapChecks.add(second);
+   ni->_overlapChecks.add(first);
+   return true;
+   }
+
+/**
+ * Jamming pays off when the copies share loads in the inner loop, either of
+ * elements that do not depend on the outer induction variable or of
+ * elements that a nearby outer iteration also loads, or when the inner
+ * loop carries a scalar recurrence that the copies turn into independent
+ * chains.
+ */
+bool
+TR_UnrollAndJam::hasReuse(NestInfo *ni)
+   {
+   ListIterator<TR_AffineAccess> ai(&ni->_innerAccesses);
+   for (TR_AffineAccess *access = ai.getFirst(); access; access = ai.getNext())
+      {
+      if (access->isStore())
+         continue;
+
+      int64_t outerCoefficient = access->_coefficients[0];
+      if (outerCoefficient == 0 && access->_coefficients[1] != 0)
+         return true;
+
+      if (outerCoefficient == 0)
+         continue;
+
+      ListIterator<TR_AffineAccess> oi(&ni->_innerAccesses);
+      for (TR_AffineAccess *other = oi.getFirst(); other; other = oi.getNext())
+         {
+         if (other == access || other->isStore() || !other->hasSameBase(*access) ||
+             other->_coefficients[0] != outerCoefficient || other->_coefficients[1] != access->_coefficients[1])
+            continue;
+
+         int64_t difference = other->_offset - access->_offset;
+         if (difference != 0 && difference % outerCoefficient == 0 &&
+             difference / outerCoefficient > -ni->_unrollFactor && difference / outerCoefficient < ni->_unrollFactor)
+            return true;
+         }
+      }
+
+   if (ni->_renamedSymRefs.isEmpty())
+      return false;
+
+   TR_BitVector *renamed = new (trStackMemory()) TR_BitVector(comp()->getSymRefTab()->getNumSymRefs(), trMemory(), stackAlloc, growable);
+   ListIterator<TR::SymbolReference> ri(&ni->_renamedSymRefs);
+   for (TR::SymbolReference *symRef = ri.getFirst(); symRef; symRef = ri.getNext())
+      renamed->set(symRef->getReferenceNumber());
+
+   ListIterator<TR::TreeTop> ti(&ni->_innerTrees);
+   for (TR::TreeTop *tt = ti.getFirst(); tt; tt = ti.getNext())
+      {
+      TR::Node *node = tt->getNode();
+      TR::NodeChecklist visited(comp());
+      if (node->getOpCode().isStoreDirect() && renamed->get(node->getSymbolReference()->getReferenceNumber()) &&
+          containsLoad(node->getFirstChild(), renamed, visited))
+         return true;
+      }
+
+   return false;
+   }
+
+void
+TR_UnrollAndJam::collectStoredSymbols(TR::Node *node, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return;
+   visited.add(node);
+
+   if (node->getOpCode().isStoreDirect())
+      _storedSymRefs->set(node->getSymbolReference()->getReferenceNumber());
+
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      collectStoredSymbols(node->getChild(i), visited);
+   }
+
+int32_t
+TR_UnrollAndJam::countNodes(TR::Node *node, TR::NodeChecklist &visited)
+   {
+   if (visited.contains(node))
+      return 0;
+   visited.add(node);
+
+   int32_t numNodes = 1;
+   for (int32_t i = 0; i < node->getNumChildren(); i++)
+      numNodes += countNodes(node->getChild(i), visited);
+
+   return numNodes;
+   }
+
+/**
+ * Insert the guards, overlap checks, jammed nest and epilogue between the
+ * nest's entry edges and its outer header. The original nest is left as is
+ * and runs the remaining outer iterations.
+ */
+void
+TR_UnrollAndJam::transformNest(NestInfo *ni)
+   {
+   TR::Block *header = ni->_outer._header;
+   TR::Node *bcNode = header->getEntry()->getNode();
+   int32_t unrollFactor = ni->_unrollFactor;
+
+   TR_ScratchList<TR::Block> entryBlocks(trMemory());
+   int32_t entryFrequency = 0;
+   for (auto edge = header->getPredecessors().begin(); edge != header->getPredecessors().end(); ++edge)
+      {
+      TR::Block *pred = (*edge)->getFrom()->asBlock();
+      if (pred == ni->_outer._latch)
+         continue;
+
+      entryBlocks.add(pred);
+      if (pred->getFrequency() > entryFrequency)
+         entryFrequency = pred->getFrequency();
+      }
+
+   // Blocks are created in layout order in front of the header
+   TR::Block *guardBlock = createBlockBefore(header, bcNode, entryFrequency);
+   TR::Block *innerGuardBlock = NULL;
+   TR_ScratchList<TR::Block> checkBlocks(trMemory());
+   if (!ni->_overlapChecks.isEmpty())
+      {
+      innerGuardBlock = createBlockBefore(header, bcNode, entryFrequency);
+      ListAppender<TR::Block> checkBlocksAppender(&checkBlocks);
+      for (int32_t i = ni->_overlapChecks.getSize(); i > 0; i--)
+         checkBlocksAppender.add(createBlockBefore(header, bcNode, entryFrequency));
+      }
+   TR::Block *preBlock = createBlockBefore(header, bcNode, header->getFrequency());
+   TR::Block *innerBlock = createBlockBefore(header, bcNode, ni->_inner._header->getFrequency());
+   TR::Block *postBlock = createBlockBefore(header, bcNode, header->getFrequency());
+   TR::Block *epilogueBlock = createBlockBefore(header, bcNode, entryFrequency);
+
+   // Outer trip count guard
+   guardBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::iflcmplt, createRemainingIterations(&ni->_outer), TR::Node::lconst(bcNode, unrollFactor), header->getEntry())));
+
+   // The overlap checks take the inner induction variable's range from its
+   // first and last values, so the inner loop must run at least once
+   TR::Node *innerInit = ni->_innerInitTree->getNode()->getFirstChild();
+   if (innerGuardBlock)
+      {
+      innerGuardBlock->append(TR::TreeTop::create(comp(),
+         TR::Node::createif(TR::iflcmplt, createLastValue(&ni->_inner),
+            TR::Node::create(TR::i2l, 1, innerInit->duplicateTree()), header->getEntry())));
+      }
+
+   // Fall back to the original nest when the address ranges of two accesses
+   // overlap: each check is a pair of blocks testing `lo1 < hi2 && lo2 < hi1`
+   TR::Node *lowValues[TR_AffineAccess::MaxInductionVariables];
+   TR::Node *highValues[TR_AffineAccess::MaxInductionVariables];
+   lowValues[0] = TR::Node::create(TR::i2l, 1, TR::Node::createLoad(bcNode, ni->_outer._ivSymRef));
+   highValues[0] = createLastValue(&ni->_outer);
+   lowValues[1] = TR::Node::create(TR::i2l, 1, innerInit->duplicateTree());
+   highValues[1] = createLastValue(&ni->_inner);
+
+   ListIterator<TR::Block> cbi(&checkBlocks);
+   ListIterator<TR_AffineAccess> ci(&ni->_overlapChecks);
+   TR_AffineAccess *first = ci.getFirst();
+   for (TR::Block *checkBlock = cbi.getFirst(); checkBlock; checkBlock = cbi.getNext(), first = ci.getNext())
+      {
+      TR_AffineAccess *second = ci.getNext();
+      TR::Block *overlapBlock = cbi.getNext();
+      checkBlock->append(TR::TreeTop::create(comp(),
+         TR::Node::createif(TR::iflucmpge,
+            _dependence->createAddressBound(first, lowValues, highValues, false),
+            _dependence->createAddressBound(second, lowValues, highValues, true),
+            overlapBlock->getNextBlock()->getEntry())));
+      overlapBlock->append(TR::TreeTop::create(comp(),
+         TR::Node::createif(TR::iflucmplt,
+            _dependence->createAddressBound(second, lowValues, highValues, false),
+            _dependence->createAddressBound(first, lowValues, highValues, true),
+            header->getEntry())));
+      }
+
+   // Jammed nest: the pre sections of every copy, the inner loop running the
+   // inner sections of every copy, and the post sections of every copy
+   int32_t numRenamed = ni->_renamedSymRefs.getSize();
+   TR::SymbolReference **temps = (TR::SymbolReference **)trMemory()->allocateStackMemory(numRenamed * unrollFactor * sizeof(TR::SymbolReference *));
+   ListIterator<TR::SymbolReference> ri(&ni->_renamedSymRefs);
+   int32_t r = 0;
+   for (TR::SymbolReference *symRef = ri.getFirst(); symRef; symRef = ri.getNext(), r++)
+      {
+      temps[r * unrollFactor] = symRef;
+      for (int32_t c = 1; c < unrollFactor; c++)
+         temps[r * unrollFactor + c] = comp()->getSymRefTab()->createTemporary(comp()->getMethodSymbol(), symRef->getSymbol()->getDataType());
+      }
+
+   appendCopies(ni, PreSection, preBlock, temps);
+   preBlock->append(TR::TreeTop::create(comp(), ni->_innerInitTree->getNode()->duplicateTree()));
+
+   appendCopies(ni, InnerSection, innerBlock, temps);
+   TR::SymbolReference *innerIv = ni->_inner._ivSymRef;
+   innerBlock->append(TR::TreeTop::create(comp(), TR::Node::createStore(innerIv,
+      TR::Node::create(TR::iadd, 2, TR::Node::createLoad(bcNode, innerIv), TR::Node::iconst(bcNode, 1)))));
+   innerBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(ni->_inner._inclusiveBound ? TR::ificmple : TR::ificmplt,
+         TR::Node::createLoad(bcNode, innerIv),
+         ni->_inner._bound->duplicateTree(),
+         innerBlock->getEntry())));
+
+   appendCopies(ni, PostSection, postBlock, temps);
+   TR::SymbolReference *outerIv = ni->_outer._ivSymRef;
+   postBlock->append(TR::TreeTop::create(comp(), TR::Node::createStore(outerIv,
+      TR::Node::create(TR::iadd, 2, TR::Node::createLoad(bcNode, outerIv), TR::Node::iconst(bcNode, unrollFactor)))));
+   postBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(TR::iflcmpge, createRemainingIterations(&ni->_outer), TR::Node::lconst(bcNode, unrollFactor), preBlock->getEntry())));
+
+   // Epilogue: leave, or run the remaining outer iterations in the original nest
+   epilogueBlock->append(TR::TreeTop::create(comp(),
+      TR::Node::createif(ni->_outer._inclusiveBound ? TR::ificmpgt : TR::ificmpge,
+         TR::Node::createLoad(bcNode, outerIv),
+         ni->_outer._bound->duplicateTree(),
+         ni->_exit->getEntry())));
+
+   // Wire up the new blocks before moving the entry edges so the header stays reachable
+   TR::Block *next = innerGuardBlock ? innerGuardBlock : preBlock;
+   _cfg->addEdge(guardBlock, next);
+   _cfg->addEdge(guardBlock, header);
+
+   if (innerGuardBlock)
+      {
+      _cfg->addEdge(innerGuardBlock, innerGuardBlock->getNextBlock());
+      _cfg->addEdge(innerGuardBlock, header);
+      }
+
+   for (TR::Block *checkBlock = cbi.getFirst(); checkBlock; checkBlock = cbi.getNext())
+      {
+      TR::Block *overlapBlock = cbi.getNext();
+      _cfg->addEdge(checkBlock, overlapBlock);
+      _cfg->addEdge(checkBlock, overlapBlock->getNextBlock());
+      _cfg->addEdge(overlapBlock, overlapBlock->getNextBlock());
+      _cfg->addEdge(overlapBlock, header);
+      }
+
+   _cfg->addEdge(preBlock, innerBlock);
+   _cfg->addEdge(innerBlock, innerBlock);
+   _cfg->addEdge(innerBlock, postBlock);
+   _cfg->addEdge(postBlock, preBlock);
+   _cfg->addEdge(postBlock, epilogueBlock);
+   _cfg->addEdge(epilogueBlock, ni->_exit);
+   _cfg->addEdge(epilogueBlock, header);
+
+   ListIterator<TR::Block> ei(&entryBlocks);
+   for (TR::Block *pred = ei.getFirst(); pred; pred = ei.getNext())
+      {
+      TR::Node *lastNode = pred->getLastRealTreeTop()->getNode();
+      if (lastNode->getOpCode().isBranch() && lastNode->getBranchDestination() == header->getEntry())
+         {
+         pred->changeBranchDestination(guardBlock->getEntry(), _cfg);
+         }
+      else
+         {
+         _cfg->addEdge(pred, guardBlock);
+         _cfg->removeEdge(pred, header);
+         }
+      }
+   }
+
+TR::Block *
+TR_UnrollAndJam::createBlockBefore(TR::Block *next, TR::Node *bcNode, int32_t frequency)
+   {
+   TR::Block *block = TR::Block::createEmptyBlock(bcNode, comp(), frequency, next);
+   _cfg->addNode(block);
+
+   TR::TreeTop *prevTree = next->getEntry()->getPrevTreeTop();
+   prevTree->join(block->getEntry());
+   block->getExit()->join(next->getEntry());
+   return block;
+   }
+
+/**
+ * Append a copy of a section's trees to \p block for each outer iteration
+ * the jammed nest covers, preserving commoning within each copy.
+ */
+void
+TR_UnrollAndJam::appendCopies(NestInfo *ni, Section section, TR::Block *block, TR::SymbolReference **temps)
+   {
+   for (int32_t c = 0; c < ni->_unrollFactor; c++)
+      {
+      NodeMap map(std::less<TR::Node *>(), comp()->trMemory()->currentStackRegion());
+      ListIterator<TR::TreeTop> ti(ni->trees(section));
+      for (TR::TreeTop *tt = ti.getFirst(); tt; tt = ti.getNext())
+         block->append(TR::TreeTop::create(comp(), duplicateForCopy(ni, tt->getNode(), c, temps, map)));
+      }
+   }
+
+/**
+ * Copy a tree for outer iteration `j + copy`: loads of the outer induction
+ * variable become `j + copy` and the autos written in the nest are replaced
+ * by the copy's temporaries.
+ */
+TR::Node *
+TR_UnrollAndJam::duplicateForCopy(NestInfo *ni, TR::Node *node, int32_t copy, TR::SymbolReference **temps, NodeMap &map)
+   {
+   NodeMap::iterator found = map.find(node);
+   if (found != map.end())
+      return found->second;
+
+   TR::Node *result = NULL;
+   if (copy > 0 && node->getOpCodeValue() == TR::iload && node->getSymbolReference() == ni->_outer._ivSymRef)
+      {
+      result = TR::Node::create(TR::iadd, 2,
+         TR::Node::createLoad(node, ni->_outer._ivSymRef),
+         TR::Node::iconst(node, copy));
+      }
+   else
+      {
+      result = TR::Node::copy(node);
+      result->setReferenceCount(0);
+      for (int32_t i = 0; i < node->getNumChildren(); i++)
+         result->setAndIncChild(i, duplicateForCopy(ni, node->getChild(i), copy, temps, map));
+
+      if (copy > 0 && (node->getOpCode().isLoadVarDirect() || node->getOpCode().isStoreDirect()))
+         {
+         ListIterator<TR::SymbolReference> ri(&ni->_renamedSymRefs);
+         int32_t r = 0;
+         for (TR::SymbolReference *symRef = ri.getFirst(); symRef; symRef = ri.getNext(), r++)
+            {
+            if (symRef == node->getSymbolReference())
+               {
+               result->setSymbolReference(temps[r * ni->_unrollFactor + copy]);
+               break;
+               }
+            }
+         }
+      }
+
+   map[node] = result;
+   return result;
+   }
+
+/**
+ * Number of iterations left as a 64-bit value: `bound - i`, plus one for
+ * an inclusive bound
+ */
+TR::Node *
+TR_UnrollAndJam::createRemainingIterations(CountedLoop *loop)
+   {
+   TR::Node *bound = loop->_bound;
+   TR::Node *remaining = TR::Node::create(TR::lsub, 2,
+      TR::Node::create(TR::i2l, 1, bound->duplicateTree()),
+      TR::Node::create(TR::i2l, 1, TR::Node::createLoad(bound, loop->_ivSymRef)));
+   if (loop->_inclusiveBound)
+      remaining = TR::Node::create(TR::ladd, 2, remaining, TR::Node::lconst(bound, 1));
+   return remaining;
+   }
+
+/**
+ * Last value of the induction variable as a 64-bit value: `bound - 1`, or
+ * `bound` for an inclusive bound
+ */
+TR::Node *
+TR_UnrollAndJam::createLastValue(CountedLoop *loop)
+   {
+   TR::Node *bound = loop->_bound;
+   TR::Node *last = TR::Node::create(TR::i2l, 1, bound->duplicateTree());
+   if (!loop->_inclusiveBound)
+      last = TR::Node::create(TR::lsub, 2, last, TR::Node::lconst(bound, 1));
+   return last;
+   }
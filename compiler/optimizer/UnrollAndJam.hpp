@@ -0,0 +1,190 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef UNROLLANDJAM_INCL
+#define UNROLLANDJAM_INCL
+
+#include <map>
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "env/TypedAllocator.hpp"
+#include "infra/List.hpp"
+#include "optimizer/LoopCanonicalizer.hpp"
+#include "optimizer/LoopDependence.hpp"
+#include "optimizer/OptimizationManager.hpp"
+
+class TR_BitVector;
+class TR_RegionStructure;
+class TR_Structure;
+namespace TR { class Block; }
+namespace TR { class Node; }
+namespace TR { class NodeChecklist; }
+namespace TR { class Optimization; }
+namespace TR { class SymbolReference; }
+namespace TR { class TreeTop; }
+
+/**
+ * Class TR_UnrollAndJam
+ * =====================
+ *
+ * Unroll-and-jam unrolls the outer loop of a perfectly nested pair of
+ * counted loops and fuses the copies of the inner loop into one, so that
+ * each inner iteration works on several outer iterations at once. Values
+ * that do not depend on the outer induction variable are loaded once for
+ * all the copies, and independent accumulators break the dependence chain
+ * of the inner loop, which is what speeds up kernels such as matrix
+ * multiplication and stencils.
+ *
+ * A nest is a candidate when the outer loop's blocks form a chain
+ *
+ *    outer header ... (pre)
+ *       inner header ... inner latch
+ *    ... outer latch (post)
+ *
+ * where both latches have the form
+ *
+ *    istore #i (iadd (iload #i) (iconst 1))
+ *    ificmplt/ificmple --> header (iload #i) (bound)
+ *
+ * with loop invariant bounds, the pre blocks set the inner induction
+ * variable to a loop invariant value, and every other tree is a side effect
+ * free store of an affine array element or of an auto. Autos written in the
+ * nest must be written before they are read in each outer iteration and
+ * must not be read after the nest; each copy gets its own temporaries.
+ *
+ * Reordering is legal when no access of an outer iteration `j + d` that
+ * moves ahead of an access of iteration `j` touches the same memory.
+ * Accesses of the same array are checked statically from their dependence
+ * distances; accesses of different arrays are checked at run time against
+ * the address ranges the whole nest touches, falling back to the original
+ * nest when they overlap.
+ *
+ * The original nest is kept and runs the remaining outer iterations, and
+ * all of them when the outer trip count is too small or a check fails.
+ */
+
+class TR_UnrollAndJam : public TR_LoopTransformer
+   {
+   public:
+   TR_UnrollAndJam(TR::OptimizationManager *manager);
+   static TR::Optimization *create(TR::OptimizationManager *manager)
+      {
+      return new (manager->allocator()) TR_UnrollAndJam(manager);
+      }
+
+   virtual bool    shouldPerform();
+   virtual int32_t perform();
+   virtual const char * optDetailString() const throw();
+
+   private:
+
+   enum Section
+      {
+      PreSection,
+      InnerSection,
+      PostSection,
+      NumSections
+      };
+
+   struct CountedLoop
+      {
+      TR::Block *_header;
+      TR::Block *_latch;
+      TR::TreeTop *_ivStoreTree;
+      TR::SymbolReference *_ivSymRef;
+      TR::Node *_bound;
+      bool _inclusiveBound;
+      };
+
+   struct NestInfo
+      {
+      TR_ALLOC(TR_Memory::LoopTransformer)
+
+      NestInfo(TR_Memory *m)
+         : _region(NULL), _exit(NULL), _innerInitTree(NULL), _unrollFactor(0),
+           _preTrees(m), _innerTrees(m), _postTrees(m),
+           _preAccesses(m), _innerAccesses(m), _postAccesses(m),
+           _renamedSymRefs(m), _overlapChecks(m)
+         {}
+
+      TR_ScratchList<TR::TreeTop> *trees(Section s)
+         {
+         return s == PreSection ? &_preTrees : (s == InnerSection ? &_innerTrees : &_postTrees);
+         }
+
+      TR_ScratchList<TR_AffineAccess> *accesses(Section s)
+         {
+         return s == PreSection ? &_preAccesses : (s == InnerSection ? &_innerAccesses : &_postAccesses);
+         }
+
+      TR_RegionStructure *_region;
+      CountedLoop _outer;
+      CountedLoop _inner;
+      TR::Block *_exit;
+      TR::TreeTop *_innerInitTree;    // store of the inner induction variable's initial value
+      int32_t _unrollFactor;
+
+      TR_ScratchList<TR::TreeTop> _preTrees;     // trees before the inner loop
+      TR_ScratchList<TR::TreeTop> _innerTrees;   // inner loop trees but its latch update
+      TR_ScratchList<TR::TreeTop> _postTrees;    // trees after the inner loop but the outer latch update
+      TR_ScratchList<TR_AffineAccess> _preAccesses;
+      TR_ScratchList<TR_AffineAccess> _innerAccesses;
+      TR_ScratchList<TR_AffineAccess> _postAccesses;
+      TR_ScratchList<TR::SymbolReference> _renamedSymRefs;  // autos that get a temporary per copy
+      TR_ScratchList<TR_AffineAccess> _overlapChecks;       // pairs of accesses whose ranges must not overlap
+      };
+
+   typedef TR::typed_allocator<std::pair<TR::Node * const, TR::Node *>, TR::Region &> NodeMapAllocator;
+   typedef std::map<TR::Node *, TR::Node *, std::less<TR::Node *>, NodeMapAllocator> NodeMap;
+
+   /* analysis */
+   void collectNests(TR_Structure *str);
+   bool analyzeNest(NestInfo *ni, TR_RegionStructure *innerRegion);
+   bool collectNestChain(NestInfo *ni, TR_RegionStructure *innerRegion);
+   bool analyzeLatch(NestInfo *ni, CountedLoop *loop, TR::TreeTop *branchTree);
+   bool analyzeEntryEdges(NestInfo *ni);
+   bool collectSections(NestInfo *ni);
+   bool analyzeTree(NestInfo *ni, Section section, TR::Node *node, TR::NodeChecklist &sectionNodes, TR::NodeChecklist &earlierNodes);
+   bool analyzeScalars(NestInfo *ni);
+   bool checkScalarOrder(NestInfo *ni, TR::Node *node, TR_BitVector *written, TR::NodeChecklist &visited);
+   bool isReadOutsideNest(NestInfo *ni, TR_BitVector *symRefs);
+   bool containsLoad(TR::Node *node, TR_BitVector *symRefs, TR::NodeChecklist &visited);
+   bool analyzeDependences(NestInfo *ni);
+   bool mayReorder(NestInfo *ni, Section firstSection, TR_AffineAccess *first, Section secondSection, TR_AffineAccess *second);
+   bool addOverlapCheck(NestInfo *ni, TR_AffineAccess *first, TR_AffineAccess *second);
+   bool hasReuse(NestInfo *ni);
+   void collectStoredSymbols(TR::Node *node, TR::NodeChecklist &visited);
+   int32_t countNodes(TR::Node *node, TR::NodeChecklist &visited);
+
+   /* transformation */
+   void transformNest(NestInfo *ni);
+   TR::Block *createBlockBefore(TR::Block *next, TR::Node *bcNode, int32_t frequency);
+   void appendCopies(NestInfo *ni, Section section, TR::Block *block, TR::SymbolReference **temps);
+   TR::Node *duplicateForCopy(NestInfo *ni, TR::Node *node, int32_t copy, TR::SymbolReference **temps, NodeMap &map);
+   TR::Node *createRemainingIterations(CountedLoop *loop);
+   TR::Node *createLastValue(CountedLoop *loop);
+
+   TR_ScratchList<NestInfo> _nestInfos;
+   TR_BitVector *_storedSymRefs;
+   TR_LoopDependence *_dependence;
+   };
+
+#endif
@@ -1896,7 +1896,7 @@ void TR_UseDefInfo::buildUseDefs(void *vblockInfo, AuxiliaryData &aux)
 
       int32_t i, ii;
       TR::Method *method = comp()->getMethodSymbol()->getMethod();
-      TR_BitVectorIterator bvi(*analysisInfo);
+      TR_HybridBitVectorIterator bvi(*analysisInfo);
       while (bvi.hasMoreElements())
          {
          // Convert from expanded index to normal index
@@ -2436,7 +2436,7 @@ void TR_UseDefInfo::buildUseDefs(TR::Node *node, void *vanalysisInfo, TR_BitVect
             }
 
          if (analysisInfo)
-            *defs &= *analysisInfo;
+            analysisInfo->intersectInto(*defs);
 
          bool ignoreDefsOnEntry = false;
          if (memSymIndex != -1 && !defs->get(memSymIndex))
@@ -0,0 +1,763 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/AOTCodeCache.hpp"
+
+#include <new>
+#include <string.h>
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "codegen/StaticRelocation.hpp"
+#include "compile/Compilation.hpp"
+#include "compile/ResolvedMethod.hpp"
+#include "env/CompilerEnv.hpp"
+#include "il/Block.hpp"
+#include "il/Node.hpp"
+#include "il/Node_inlines.hpp"
+#include "il/ResolvedMethodSymbol.hpp"
+#include "il/SymbolReference.hpp"
+#include "il/TreeTop.hpp"
+#include "il/TreeTop_inlines.hpp"
+#include "infra/Checklist.hpp"
+#include "infra/CriticalSection.hpp"
+#include "infra/Monitor.hpp"
+#include "omrformatconsts.h"
+#include "runtime/Runtime.hpp"
+
+#if defined(TR_TARGET_X86) && defined(TR_TARGET_64BIT)
+#include "codegen/MemoryReference.hpp"
+#include "codegen/X86Instruction.hpp"
+#endif
+
+TR_AOTCodeCache *TR_AOTCodeCache::_instance = NULL;
+
+struct TR_AOTCodeCache::Entry
+   {
+   const uint8_t *_record;
+   Entry *_next;
+   };
+
+namespace {
+
+const uint32_t CacheMagic = 0x41524d4f; // "OMRA"
+const uint32_t CacheVersion = 2;
+
+struct FileHeader
+   {
+   uint32_t _magic;
+   uint32_t _version;
+   uint32_t _pointerSize;
+   uint32_t _reserved;
+   };
+
+/*
+ * A saved body is this header followed by the code and then the relocations.
+ * Records are padded to a multiple of RecordAlignment.
+ */
+struct RecordHeader
+   {
+   uint64_t _key;
+   uint64_t _cpuKey;
+   uint64_t _checksum;        // of everything after the header
+   uint32_t _size;            // of the whole record
+   uint32_t _codeSize;
+   uint32_t _entryOffset;     // of the entry point from the start of the code
+   uint32_t _alignmentOffset; // of the start of the code from a CodeAlignment boundary
+   uint32_t _numRelocations;
+   uint32_t _reserved;
+   };
+
+struct RelocationRecord
+   {
+   uint32_t _offset;          // from the start of the code
+   uint8_t _size;             // TR::StaticRelocationSize
+   uint8_t _type;             // TR::StaticRelocationType
+   uint16_t _symbolLength;    // of the symbol name that follows, without a terminator
+   };
+
+const uint32_t RecordAlignment = 8;
+const uint32_t RelocationAlignment = 4;
+
+// Code is placed at the same offset from a boundary of this many bytes as
+// when it was generated, so aligned loops and literals stay aligned.
+const uint32_t CodeAlignment = 64;
+
+const uint64_t FNVOffsetBasis = 0xcbf29ce484222325ULL;
+const uint64_t FNVPrime = 0x100000001b3ULL;
+
+uint32_t
+alignUp(uint32_t size, uint32_t alignment)
+   {
+   return (size + alignment - 1) & ~(alignment - 1);
+   }
+
+uint64_t
+hashBytes(uint64_t hash, const void *data, size_t length)
+   {
+   const uint8_t *bytes = static_cast<const uint8_t *>(data);
+   for (size_t i = 0; i < length; ++i)
+      hash = (hash ^ bytes[i]) * FNVPrime;
+   return hash;
+   }
+
+uint64_t
+hashValue(uint64_t hash, uint64_t value)
+   {
+   return hashBytes(hash, &value, sizeof(value));
+   }
+
+uint64_t
+recordChecksum(const uint8_t *record)
+   {
+   const RecordHeader *header = reinterpret_cast<const RecordHeader *>(record);
+   return hashBytes(FNVOffsetBasis, record + sizeof(RecordHeader), header->_size - sizeof(RecordHeader));
+   }
+
+const RelocationRecord *
+firstRelocation(const uint8_t *record)
+   {
+   const RecordHeader *header = reinterpret_cast<const RecordHeader *>(record);
+   return reinterpret_cast<const RelocationRecord *>(record + sizeof(RecordHeader) + alignUp(header->_codeSize, RelocationAlignment));
+   }
+
+const RelocationRecord *
+nextRelocation(const RelocationRecord *relocation)
+   {
+   const uint8_t *cursor = reinterpret_cast<const uint8_t *>(relocation);
+   return reinterpret_cast<const RelocationRecord *>(cursor + alignUp(sizeof(RelocationRecord) + relocation->_symbolLength, RelocationAlignment));
+   }
+
+uint32_t
+relocationBytes(uint8_t size)
+   {
+   switch (size)
+      {
+      case TR::StaticRelocationSize::word32: return 4;
+      case TR::StaticRelocationSize::word64: return 8;
+      default: return 0;
+      }
+   }
+
+/*
+ * Check that a record read from the file is complete and that its
+ * relocations patch absolute addresses inside its code.
+ */
+bool
+isWellFormed(const uint8_t *record, uint64_t available)
+   {
+   const RecordHeader *header = reinterpret_cast<const RecordHeader *>(record);
+   if (available < sizeof(RecordHeader) ||
+       header->_size < sizeof(RecordHeader) ||
+       header->_size > available ||
+       header->_size % RecordAlignment != 0 ||
+       sizeof(RecordHeader) + static_cast<uint64_t>(alignUp(header->_codeSize, RelocationAlignment)) > header->_size ||
+       header->_entryOffset >= header->_codeSize ||
+       header->_alignmentOffset >= CodeAlignment ||
+       header->_checksum != recordChecksum(record))
+      return false;
+
+   const uint8_t *end = record + header->_size;
+   const RelocationRecord *relocation = firstRelocation(record);
+   for (uint32_t i = 0; i < header->_numRelocations; ++i)
+      {
+      const uint8_t *cursor = reinterpret_cast<const uint8_t *>(relocation);
+      if (cursor + sizeof(RelocationRecord) > end ||
+          cursor + sizeof(RelocationRecord) + relocation->_symbolLength > end)
+         return false;
+
+      uint32_t bytes = relocationBytes(relocation->_size);
+      if (bytes == 0 ||
+          relocation->_type != TR::StaticRelocationType::Absolute ||
+          static_cast<uint64_t>(relocation->_offset) + bytes > header->_codeSize)
+         return false;
+
+      relocation = nextRelocation(relocation);
+      }
+
+   return true;
+   }
+
+/*
+ * The function called by a direct call node if the call is bound to a
+ * known address, else NULL.
+ */
+TR::ResolvedMethodSymbol *
+calledFunction(TR::Node *node)
+   {
+   if (!node->getOpCode().isCallDirect())
+      return NULL;
+
+   TR::ResolvedMethodSymbol *function = node->getSymbol()->getResolvedMethodSymbol();
+   if (function == NULL || function->getMethodAddress() == NULL)
+      return NULL;
+
+   return function;
+   }
+
+/*
+ * Fold a node and its children into hash. A commoned node is hashed by its
+ * global index when it is seen again, which is stable because IL generation
+ * is deterministic.
+ *
+ * Returns false if the node makes the body impossible to move.
+ */
+bool
+hashNode(TR::Compilation *comp, TR::Node *node, TR::NodeChecklist &visited, uint64_t &hash)
+   {
+   if (visited.contains(node))
+      {
+      hash = hashValue(hash, node->getGlobalIndex());
+      return true;
+      }
+   visited.add(node);
+
+   TR::ILOpCode &op = node->getOpCode();
+   hash = hashValue(hash, op.getOpCodeValue());
+   hash = hashValue(hash, node->getDataType().getDataType());
+   hash = hashValue(hash, node->getNumChildren());
+
+   // Branch tables are allocated apart from the body and hold absolute addresses
+   if (op.getOpCodeValue() == TR::table)
+      return false;
+
+   if (op.isLoadConst())
+      {
+      switch (node->getDataType())
+         {
+         case TR::Address:
+            if (node->getAddress() != 0)
+               return false;
+            break;
+         case TR::Float:
+            hash = hashValue(hash, node->getFloatBits());
+            break;
+         case TR::Double:
+            hash = hashValue(hash, node->getDoubleBits());
+            break;
+         case TR::Int8:
+         case TR::Int16:
+         case TR::Int32:
+         case TR::Int64:
+            hash = hashValue(hash, node->get64bitIntegralValue());
+            break;
+         default:
+            return false;
+         }
+      }
+
+   if (op.hasSymbolReference())
+      {
+      TR::SymbolReference *symRef = node->getSymbolReference();
+      TR::Symbol *symbol = symRef->getSymbol();
+      if (symbol->isStatic() || symbol->isMethodMetaData())
+         return false;
+
+      hash = hashValue(hash, symRef->getReferenceNumber());
+      hash = hashValue(hash, symRef->getOffset());
+      hash = hashValue(hash, symbol->getDataType().getDataType());
+      hash = hashValue(hash, symbol->getSize());
+
+      TR::ResolvedMethodSymbol *function = calledFunction(node);
+      if (function != NULL)
+         {
+         const char *name = function->getResolvedMethod()->externalName(comp->trMemory());
+         hash = hashBytes(hash, name, strlen(name));
+         }
+      }
+
+   if (op.isBranch() || node->getOpCodeValue() == TR::Case)
+      hash = hashValue(hash, node->getBranchDestination()->getNode()->getBlock()->getNumber());
+
+   if (node->getOpCodeValue() == TR::Case)
+      hash = hashValue(hash, node->getCaseConstant());
+
+   if (node->getOpCodeValue() == TR::BBStart)
+      hash = hashValue(hash, node->getBlock()->getNumber());
+
+   for (int32_t i = 0; i < node->getNumChildren(); ++i)
+      {
+      if (!hashNode(comp, node->getChild(i), visited, hash))
+         return false;
+      }
+
+   return true;
+   }
+
+/*
+ * Any option can change the code generated for the same IL, so every flag
+ * and the set of disabled optimizations are part of the key.
+ */
+uint64_t
+hashOptions(uint64_t hash, TR::Options *options)
+   {
+   for (uint32_t word = 0; word <= TR_OWM; word++)
+      {
+      uint32_t bits = 0;
+      for (uint32_t bit = TR_OWM + 1; bit != 0; bit <<= 1)
+         {
+         if (options->getAnyOption(bit | word))
+            bits |= bit;
+         }
+      hash = hashValue(hash, bits);
+      }
+
+   for (int32_t opt = 0; opt < OMR::numOpts; opt++)
+      hash = hashValue(hash, options->isDisabled(static_cast<OMR::Optimizations>(opt)));
+
+   return hashValue(hash, options->getOptLevel());
+   }
+
+/*
+ * The address of the function called under name from node or its children,
+ * or 0 if there is no such call.
+ */
+uintptr_t
+findFunctionAddress(TR::Compilation *comp, TR::Node *node, TR::NodeChecklist &visited, const char *name, uint16_t length)
+   {
+   if (visited.contains(node))
+      return 0;
+   visited.add(node);
+
+   TR::ResolvedMethodSymbol *function = calledFunction(node);
+   if (function != NULL)
+      {
+      const char *functionName = function->getResolvedMethod()->externalName(comp->trMemory());
+      if (strlen(functionName) == length && strncmp(functionName, name, length) == 0)
+         return reinterpret_cast<uintptr_t>(function->getMethodAddress());
+      }
+
+   for (int32_t i = 0; i < node->getNumChildren(); ++i)
+      {
+      uintptr_t address = findFunctionAddress(comp, node->getChild(i), visited, name, length);
+      if (address != 0)
+         return address;
+      }
+
+   return 0;
+   }
+
+}
+
+TR_AOTCodeCache::TR_AOTCodeCache(OMRPortLibrary *portLib, intptr_t file) :
+   _portLib(portLib),
+   _file(file),
+   _mapping(NULL),
+   _monitor(NULL)
+   {
+   for (int32_t i = 0; i < NumBuckets; ++i)
+      _buckets[i] = NULL;
+   }
+
+bool
+TR_AOTCodeCache::initialize(OMRPortLibrary *portLib, const char *fileName)
+   {
+   TR_ASSERT_FATAL(_instance == NULL, "AOT code cache initialized twice");
+   OMRPORT_ACCESS_FROM_OMRPORT(portLib);
+
+   intptr_t file = omrfile_open(fileName, EsOpenRead | EsOpenWrite | EsOpenCreate, 0666);
+   if (file == -1)
+      return false;
+
+   void *storage = TR::Compiler->persistentAllocator().allocate(sizeof(TR_AOTCodeCache), std::nothrow);
+   if (storage == NULL)
+      {
+      omrfile_close(file);
+      return false;
+      }
+
+   TR_AOTCodeCache *cache = new (storage) TR_AOTCodeCache(portLib, file);
+   cache->_monitor = TR::Monitor::create("JIT-AOTCodeCacheMonitor");
+   if (cache->_monitor == NULL)
+      {
+      TR::Compiler->persistentAllocator().deallocate(storage);
+      omrfile_close(file);
+      return false;
+      }
+
+   // Another process appending to the file holds the lock on its header
+   if (omrfile_lock_bytes(file, OMRPORT_FILE_WRITE_LOCK | OMRPORT_FILE_WAIT_FOR_LOCK, 0, sizeof(FileHeader)) == 0)
+      {
+      cache->mapEntries();
+      omrfile_unlock_bytes(file, 0, sizeof(FileHeader));
+      }
+
+   _instance = cache;
+   return true;
+   }
+
+void
+TR_AOTCodeCache::shutdown()
+   {
+   TR_AOTCodeCache *cache = _instance;
+   if (cache == NULL)
+      return;
+
+   _instance = NULL;
+   OMRPORT_ACCESS_FROM_OMRPORT(cache->_portLib);
+
+   for (int32_t i = 0; i < NumBuckets; ++i)
+      {
+      Entry *entry = cache->_buckets[i];
+      while (entry != NULL)
+         {
+         Entry *next = entry->_next;
+         const uint8_t *record = entry->_record;
+         bool isMapped = cache->_mapping != NULL &&
+                         record >= static_cast<uint8_t *>(cache->_mapping->pointer) &&
+                         record < static_cast<uint8_t *>(cache->_mapping->pointer) + cache->_mapping->size;
+         if (!isMapped)
+            TR::Compiler->persistentAllocator().deallocate(const_cast<uint8_t *>(record));
+         TR::Compiler->persistentAllocator().deallocate(entry);
+         entry = next;
+         }
+      }
+
+   if (cache->_mapping != NULL)
+      omrmmap_unmap_file(cache->_mapping);
+   omrfile_close(cache->_file);
+   TR::Monitor::destroy(cache->_monitor);
+   TR::Compiler->persistentAllocator().deallocate(cache);
+   }
+
+/*
+ * Index the records already in the file. A file written by a different
+ * version or for a different pointer size is emptied, and a record that is
+ * incomplete or corrupt is cut off together with everything after it.
+ */
+void
+TR_AOTCodeCache::mapEntries()
+   {
+   OMRPORT_ACCESS_FROM_OMRPORT(_portLib);
+
+   FileHeader expected;
+   expected._magic = CacheMagic;
+   expected._version = CacheVersion;
+   expected._pointerSize = sizeof(void *);
+   expected._reserved = 0;
+
+   FileHeader header;
+   int64_t length = omrfile_flength(_file);
+   bool isValid = length >= static_cast<int64_t>(sizeof(FileHeader)) &&
+                  omrfile_seek(_file, 0, EsSeekSet) == 0 &&
+                  omrfile_read(_file, &header, sizeof(header)) == sizeof(header) &&
+                  memcmp(&header, &expected, sizeof(header)) == 0;
+   if (!isValid)
+      {
+      omrfile_set_length(_file, 0);
+      omrfile_seek(_file, 0, EsSeekSet);
+      omrfile_write(_file, &expected, sizeof(expected));
+      return;
+      }
+
+   if (length == sizeof(FileHeader))
+      return;
+
+   _mapping = omrmmap_map_file(_file, 0, static_cast<uintptr_t>(length), "JIT AOT code cache", OMRPORT_MMAP_FLAG_READ, OMRMEM_CATEGORY_JIT);
+   if (_mapping == NULL)
+      return;
+
+   const uint8_t *base = static_cast<const uint8_t *>(_mapping->pointer);
+   uint64_t offset = sizeof(FileHeader);
+   while (offset < static_cast<uint64_t>(length) && isWellFormed(base + offset, length - offset))
+      {
+      addEntry(base + offset);
+      offset += reinterpret_cast<const RecordHeader *>(base + offset)->_size;
+      }
+
+   if (offset != static_cast<uint64_t>(length))
+      omrfile_set_length(_file, offset);
+   }
+
+const uint8_t *
+TR_AOTCodeCache::find(uint64_t key, uint64_t cpuKey)
+   {
+   for (Entry *entry = _buckets[key % NumBuckets]; entry != NULL; entry = entry->_next)
+      {
+      const RecordHeader *header = reinterpret_cast<const RecordHeader *>(entry->_record);
+      if (header->_key == key && header->_cpuKey == cpuKey)
+         return entry->_record;
+      }
+   return NULL;
+   }
+
+void
+TR_AOTCodeCache::addEntry(const uint8_t *record)
+   {
+   Entry *entry = static_cast<Entry *>(TR::Compiler->persistentAllocator().allocate(sizeof(Entry), std::nothrow));
+   if (entry == NULL)
+      return;
+
+   uint64_t key = reinterpret_cast<const RecordHeader *>(record)->_key;
+   entry->_record = record;
+   entry->_next = _buckets[key % NumBuckets];
+   _buckets[key % NumBuckets] = entry;
+   }
+
+uint64_t
+TR_AOTCodeCache::computeKey(TR::Compilation *comp)
+   {
+   if (!comp->target().cpu.isX86() || !comp->target().is64Bit() || comp->compileRelocatableCode())
+      return 0;
+
+   uint64_t hash = FNVOffsetBasis;
+   const char *signature = comp->signature();
+   hash = hashBytes(hash, signature, strlen(signature));
+   hash = hashValue(hash, comp->getMethodHotness());
+   hash = hashOptions(hash, comp->getOptions());
+   hash = hashValue(hash, computeCPUKey(comp));
+
+   TR::NodeChecklist visited(comp);
+   for (TR::TreeTop *tt = comp->getStartTree(); tt; tt = tt->getNextTreeTop())
+      {
+      if (!hashNode(comp, tt->getNode(), visited, hash))
+         return 0;
+      }
+
+   // 0 means the body is not saved
+   return hash != 0 ? hash : 1;
+   }
+
+uint64_t
+TR_AOTCodeCache::computeCPUKey(TR::Compilation *comp)
+   {
+   OMRProcessorDesc description = comp->target().cpu.getProcessorDescription();
+   uint64_t hash = hashValue(FNVOffsetBasis, description.processor);
+   hash = hashBytes(hash, description.features, sizeof(description.features));
+#if defined(TR_TARGET_X86)
+   hash = hashValue(hash, comp->target().cpu.getX86ProcessorFeatureFlags());
+   hash = hashValue(hash, comp->target().cpu.getX86ProcessorFeatureFlags2());
+   hash = hashValue(hash, comp->target().cpu.getX86ProcessorFeatureFlags8());
+#endif
+   return hash;
+   }
+
+/*
+ * Whether the generated code can run at another address once the recorded
+ * relocations are applied.
+ */
+bool
+TR_AOTCodeCache::isMovable(TR::Compilation *comp)
+   {
+#if defined(TR_TARGET_X86) && defined(TR_TARGET_64BIT)
+   for (TR::Instruction *instr = comp->cg()->getFirstInstruction(); instr; instr = instr->getNext())
+      {
+      switch (instr->getKind())
+         {
+         case TR::Instruction::IsImmSym:
+         case TR::Instruction::IsImm64Sym:
+         case TR::Instruction::IsRegImmSym:
+         case TR::Instruction::IsMemImmSym:
+         case TR::Instruction::IsMemTable:
+            // Helper calls and references to symbols outside the body
+            return false;
+         case TR::Instruction::IsRegImm64Sym:
+            if (static_cast<TR::AMD64RegImm64SymInstruction *>(instr)->getReloKind() != TR_NativeMethodAbsolute)
+               return false;
+            break;
+         default:
+            break;
+         }
+
+      TR::MemoryReference *memRef = instr->getMemoryReference();
+      if (memRef != NULL &&
+          memRef->getDataSnippet() == NULL &&
+          memRef->getSymbolReference().getSymbol() != NULL &&
+          memRef->getSymbolReference().getSymbol()->isStatic())
+         return false;
+      }
+
+   return true;
+#else
+   return false;
+#endif
+   }
+
+bool
+TR_AOTCodeCache::load(TR::Compilation *comp)
+   {
+   uint64_t key = computeKey(comp);
+   if (key == 0)
+      {
+      if (comp->getOption(TR_TraceCG))
+         traceMsg(comp, "AOT code cache: %s cannot be saved\n", comp->signature());
+      return false;
+      }
+
+   const uint8_t *record = NULL;
+      {
+      OMR::CriticalSection lookup(_monitor);
+      record = find(key, computeCPUKey(comp));
+      }
+
+   if (record == NULL)
+      {
+      if (comp->getOption(TR_TraceCG))
+         traceMsg(comp, "AOT code cache: no body for %s under key %016" OMR_PRIx64 "\n", comp->signature(), key);
+      comp->setAOTCodeCacheKey(key);
+      return false;
+      }
+
+   const RecordHeader *header = reinterpret_cast<const RecordHeader *>(record);
+
+   // Bind every relocation before committing to the saved body
+   uintptr_t *targets = NULL;
+   if (header->_numRelocations > 0)
+      targets = static_cast<uintptr_t *>(comp->trMemory()->allocateHeapMemory(header->_numRelocations * sizeof(uintptr_t)));
+
+   const RelocationRecord *relocation = firstRelocation(record);
+   for (uint32_t i = 0; i < header->_numRelocations; ++i)
+      {
+      const char *name = reinterpret_cast<const char *>(relocation + 1);
+      TR::NodeChecklist visited(comp);
+      targets[i] = 0;
+      for (TR::TreeTop *tt = comp->getStartTree(); tt && targets[i] == 0; tt = tt->getNextTreeTop())
+         targets[i] = findFunctionAddress(comp, tt->getNode(), visited, name, relocation->_symbolLength);
+      if (targets[i] == 0 ||
+          (relocation->_size == TR::StaticRelocationSize::word32 && targets[i] > 0xffffffff))
+         {
+         if (comp->getOption(TR_TraceCG))
+            traceMsg(comp, "AOT code cache: cannot bind %.*s for %s\n", relocation->_symbolLength, name, comp->signature());
+         return false;
+         }
+      relocation = nextRelocation(relocation);
+      }
+
+   TR::CodeGenerator *cg = comp->cg();
+   cg->reserveCodeCache();
+   uint8_t *buffer = cg->allocateCodeMemory(header->_codeSize + CodeAlignment, false);
+   uint8_t *code = buffer + ((header->_alignmentOffset - reinterpret_cast<uintptr_t>(buffer)) & (CodeAlignment - 1));
+   memcpy(code, record + sizeof(RecordHeader), header->_codeSize);
+
+   relocation = firstRelocation(record);
+   for (uint32_t i = 0; i < header->_numRelocations; ++i)
+      {
+      uint8_t *location = code + relocation->_offset;
+      if (relocation->_size == TR::StaticRelocationSize::word64)
+         {
+         uint64_t value = targets[i];
+         memcpy(location, &value, sizeof(value));
+         }
+      else
+         {
+         uint32_t value = static_cast<uint32_t>(targets[i]);
+         memcpy(location, &value, sizeof(value));
+         }
+      relocation = nextRelocation(relocation);
+      }
+
+   cg->setBinaryBufferStart(code);
+   cg->setBinaryBufferCursor(code + header->_codeSize);
+   cg->setPrePrologueSize(header->_entryOffset - cg->getJitMethodEntryPaddingSize());
+   cg->syncCode(code, header->_codeSize);
+   comp->getMethodSymbol()->setMethodAddress(cg->getCodeStart());
+
+   if (comp->getOption(TR_TraceCG))
+      traceMsg(comp, "AOT code cache: loaded %s from key %016" OMR_PRIx64 " at %p\n", comp->signature(), key, cg->getCodeStart());
+
+   return true;
+   }
+
+void
+TR_AOTCodeCache::store(TR::Compilation *comp)
+   {
+   TR::CodeGenerator *cg = comp->cg();
+   if (!isMovable(comp))
+      {
+      if (comp->getOption(TR_TraceCG))
+         traceMsg(comp, "AOT code cache: generated code for %s cannot be moved\n", comp->signature());
+      return;
+      }
+
+   uint8_t *codeStart = cg->getBinaryBufferStart();
+   uint32_t codeSize = static_cast<uint32_t>(cg->getCodeEnd() - codeStart);
+
+   TR::list<TR::StaticRelocation> &relocations = cg->getStaticRelocations();
+   uint32_t size = sizeof(RecordHeader) + alignUp(codeSize, RelocationAlignment);
+   uint32_t numRelocations = 0;
+   for (auto it = relocations.begin(); it != relocations.end(); ++it)
+      {
+      size_t symbolLength = strlen(it->symbol());
+      if (it->type() != TR::StaticRelocationType::Absolute ||
+          relocationBytes(it->size()) == 0 ||
+          it->location() < codeStart ||
+          it->location() + relocationBytes(it->size()) > codeStart + codeSize ||
+          symbolLength > 0xffff)
+         return;
+
+      size += alignUp(static_cast<uint32_t>(sizeof(RelocationRecord) + symbolLength), RelocationAlignment);
+      numRelocations++;
+      }
+   size = alignUp(size, RecordAlignment);
+
+   uint8_t *record = static_cast<uint8_t *>(TR::Compiler->persistentAllocator().allocate(size, std::nothrow));
+   if (record == NULL)
+      return;
+   memset(record, 0, size);
+
+   RecordHeader *header = reinterpret_cast<RecordHeader *>(record);
+   header->_key = comp->getAOTCodeCacheKey();
+   header->_cpuKey = computeCPUKey(comp);
+   header->_size = size;
+   header->_codeSize = codeSize;
+   header->_entryOffset = static_cast<uint32_t>(cg->getCodeStart() - codeStart);
+   header->_alignmentOffset = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(codeStart) & (CodeAlignment - 1));
+   header->_numRelocations = numRelocations;
+   memcpy(record + sizeof(RecordHeader), codeStart, codeSize);
+
+   RelocationRecord *relocation = const_cast<RelocationRecord *>(firstRelocation(record));
+   for (auto it = relocations.begin(); it != relocations.end(); ++it)
+      {
+      relocation->_offset = static_cast<uint32_t>(it->location() - codeStart);
+      relocation->_size = static_cast<uint8_t>(it->size());
+      relocation->_type = static_cast<uint8_t>(it->type());
+      relocation->_symbolLength = static_cast<uint16_t>(strlen(it->symbol()));
+      memcpy(relocation + 1, it->symbol(), relocation->_symbolLength);
+      relocation = const_cast<RelocationRecord *>(nextRelocation(relocation));
+      }
+   header->_checksum = recordChecksum(record);
+
+   OMRPORT_ACCESS_FROM_OMRPORT(_portLib);
+   OMR::CriticalSection appending(_monitor);
+
+   // Another compilation of the same method may have saved it meanwhile
+   if (find(header->_key, header->_cpuKey) != NULL)
+      {
+      TR::Compiler->persistentAllocator().deallocate(record);
+      return;
+      }
+
+   if (omrfile_lock_bytes(_file, OMRPORT_FILE_WRITE_LOCK | OMRPORT_FILE_WAIT_FOR_LOCK, 0, sizeof(FileHeader)) == 0)
+      {
+      int64_t end = omrfile_seek(_file, 0, EsSeekEnd);
+      if (end >= 0 && omrfile_write(_file, record, size) != static_cast<intptr_t>(size))
+         {
+         // Do not leave a partial record behind
+         omrfile_set_length(_file, end);
+         }
+      omrfile_unlock_bytes(_file, 0, sizeof(FileHeader));
+      }
+
+   // The body serves later compiles in this process even if it was not written out
+   addEntry(record);
+
+   if (comp->getOption(TR_TraceCG))
+      traceMsg(comp, "AOT code cache: saved %s under key %016" OMR_PRIx64 "\n", comp->signature(), header->_key);
+   }
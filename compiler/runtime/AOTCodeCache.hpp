@@ -0,0 +1,119 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef AOTCODECACHE_INCL
+#define AOTCODECACHE_INCL
+
+#include <stdint.h>
+#include "omrport.h"
+
+namespace TR { class Compilation; }
+namespace TR { class Monitor; }
+
+/**
+ * Class TR_AOTCodeCache
+ * =====================
+ *
+ * A file backed cache of compiled bodies that survives the process, so that
+ * a later run can install a body instead of optimizing and generating code
+ * for the same method again. It is opened by the aotCodeCache=<file> option.
+ *
+ * A body is found by a key that hashes its IL right after IL generation
+ * (opcodes, types, constants, symbol references, control flow and the
+ * names of called functions) together with the method signature and the
+ * optimization level. The target processor and its features are recorded
+ * separately and must match exactly for the body to be used.
+ *
+ * Only bodies that can be moved are saved. The code is copied as a whole
+ * and the only absolute addresses it may contain are those of called
+ * native functions, which are recorded as symbolic relocations and bound
+ * again from the IL of the compile that loads the body. Bodies that refer
+ * to static data, address constants, runtime helpers or branch tables are
+ * compiled as usual and not saved. Only AMD64 records the relocations, so
+ * other targets never use the cache.
+ *
+ * The file is a header followed by entries appended as methods are
+ * compiled. Existing entries are mapped read-only when the cache is opened
+ * and a truncated or corrupt tail is cut off.
+ */
+class TR_AOTCodeCache
+   {
+   public:
+
+   /**
+    * \brief
+    *    Open, or create, the cache backed by fileName.
+    *
+    * \return
+    *    true when the cache is ready for use.
+    */
+   static bool initialize(OMRPortLibrary *portLib, const char *fileName);
+
+   /// Unmap and close the cache file
+   static void shutdown();
+
+   /// The open cache, or NULL when none was opened
+   static TR_AOTCodeCache *instance() { return _instance; }
+
+   /**
+    * \brief
+    *    Called after IL generation. Install a saved body for the method
+    *    being compiled if there is one, else remember the key of the method
+    *    in the compilation so that store() can save its body.
+    *
+    * \return
+    *    true when the body was installed and code generation can be skipped.
+    */
+   bool load(TR::Compilation *comp);
+
+   /**
+    * \brief
+    *    Called after code generation to save the body under the key load()
+    *    computed, unless the generated code cannot be moved.
+    */
+   void store(TR::Compilation *comp);
+
+   private:
+
+   struct Entry;
+
+   TR_AOTCodeCache(OMRPortLibrary *portLib, intptr_t file);
+
+   void mapEntries();
+   const uint8_t *find(uint64_t key, uint64_t cpuKey);
+   void addEntry(const uint8_t *record);
+   bool isMovable(TR::Compilation *comp);
+
+   static uint64_t computeKey(TR::Compilation *comp);
+   static uint64_t computeCPUKey(TR::Compilation *comp);
+
+   static TR_AOTCodeCache *_instance;
+
+   static const int32_t NumBuckets = 256;
+
+   OMRPortLibrary *_portLib;
+   intptr_t _file;
+   J9MmapHandle *_mapping;
+   TR::Monitor *_monitor;
+   Entry *_buckets[NumBuckets];
+   };
+
+#endif
@@ -160,10 +160,40 @@ CodeCacheMethodHeader *getCodeCacheMethodHeader(char *p, int searchLimit, Method
 struct CodeCacheFreeCacheBlock
    {
    size_t _size;
-   CodeCacheFreeCacheBlock *_next;
+   CodeCacheFreeCacheBlock *_next;        // next free block in address order
+   CodeCacheFreeCacheBlock *_left;        // children in the address-ordered tree of free blocks
+   CodeCacheFreeCacheBlock *_right;
+   CodeCacheFreeCacheBlock *_nextInClass; // other free blocks of the same size class
+   CodeCacheFreeCacheBlock *_prevInClass;
    };
 #define MIN_SIZE_BLOCK (sizeof(CodeCacheFreeCacheBlock) > 96 ? sizeof(CodeCacheFreeCacheBlock) : 96)
 
+// Gaps smaller than this between a freed range and a neighbouring free block
+// are left over from alignment and are absorbed when the two are merged
+#define FREE_BLOCK_MERGE_GAP (sizeof(size_t) + sizeof(void *))
+
+// Free blocks are indexed in four size classes per power of two from 16 bytes
+// up; blocks of 4GB and more share the last class
+#define FREE_BLOCK_SIZE_CLASSES 112
+
+
+// A constant shared by the methods of a code cache
+struct CodeCacheLiteral
+   {
+   CodeCacheLiteral *_next;   // next literal in the same hash bucket
+   uint8_t *_address;
+   size_t _size;
+   };
+
+#define LITERAL_POOL_BUCKETS 256
+
+// Literals are carved from chunks of the cold area, so that constant data
+// does not share instruction cache lines with warm code
+#define LITERAL_POOL_CHUNK_SIZE 2048
+
+// Literals are aligned to their size up to this, enough for aligned vector loads
+#define LITERAL_POOL_MAX_ALIGNMENT 64
+
 
 struct FaintCacheBlock
    {
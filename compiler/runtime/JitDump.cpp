@@ -0,0 +1,665 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "runtime/JitDump.hpp"
+
+TR::JitDump *TR::JitDump::_instance = NULL;
+
+#if defined(LINUX)
+
+#include <elf.h>
+#include <new>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include "codegen/ELFGenerator.hpp"
+#include "env/CompilerEnv.hpp"
+#include "runtime/CodeCacheManager.hpp"
+
+/*
+ * GDB JIT interface.  GDB sets a breakpoint in __jit_debug_register_code and
+ * reads the entry named by __jit_debug_descriptor whenever it is hit.  The
+ * symbols are weak so that a process embedding another JIT that defines them
+ * links, and both JITs then share the one descriptor.
+ */
+extern "C"
+{
+
+enum jit_actions_t
+   {
+   JIT_NOACTION = 0,
+   JIT_REGISTER_FN,
+   JIT_UNREGISTER_FN
+   };
+
+struct jit_code_entry
+   {
+   struct jit_code_entry *next_entry;
+   struct jit_code_entry *prev_entry;
+   const char *symfile_addr;
+   uint64_t symfile_size;
+   };
+
+struct jit_descriptor
+   {
+   uint32_t version;
+   uint32_t action_flag;
+   struct jit_code_entry *relevant_entry;
+   struct jit_code_entry *first_entry;
+   };
+
+void __attribute__((weak, noinline)) __jit_debug_register_code()
+   {
+   __asm__ __volatile__("");
+   }
+
+struct jit_descriptor __attribute__((weak)) __jit_debug_descriptor = { 1, JIT_NOACTION, NULL, NULL };
+
+}
+
+namespace
+{
+
+// perf's jitdump format, as described in tools/perf/Documentation/jitdump-specification.txt
+//
+const uint32_t JITDUMP_MAGIC = 0x4A695444;
+const uint32_t JITDUMP_VERSION = 1;
+
+enum JitDumpRecordType
+   {
+   JIT_CODE_LOAD = 0,
+   JIT_CODE_MOVE = 1,
+   JIT_CODE_DEBUG_INFO = 2,
+   JIT_CODE_CLOSE = 3
+   };
+
+struct JitDumpFileHeader
+   {
+   uint32_t _magic;
+   uint32_t _version;
+   uint32_t _totalSize;
+   uint32_t _elfMachine;
+   uint32_t _pad;
+   uint32_t _pid;
+   uint64_t _timestamp;
+   uint64_t _flags;
+   };
+
+struct JitDumpRecordHeader
+   {
+   uint32_t _id;
+   uint32_t _totalSize;
+   uint64_t _timestamp;
+   };
+
+struct JitDumpCodeLoad
+   {
+   JitDumpRecordHeader _header;
+   uint32_t _pid;
+   uint32_t _tid;
+   uint64_t _vma;
+   uint64_t _codeAddress;
+   uint64_t _codeSize;
+   uint64_t _codeIndex;
+   };
+
+struct JitDumpDebugInfo
+   {
+   JitDumpRecordHeader _header;
+   uint64_t _codeAddress;
+   uint64_t _numEntries;
+   };
+
+struct JitDumpDebugEntry
+   {
+   uint64_t _address;
+   int32_t _line;
+   int32_t _discriminator;
+   };
+
+const size_t JITDUMP_BUFFER_SIZE = 256 * 1024;
+
+uint64_t
+monotonicTimestamp()
+   {
+   struct timespec now;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   return static_cast<uint64_t>(now.tv_sec) * 1000000000 + now.tv_nsec;
+   }
+
+uint32_t
+elfMachine()
+   {
+   if (TR::Compiler->target.cpu.isX86())
+      return TR::Compiler->target.is64Bit() ? EM_X86_64 : EM_386;
+   if (TR::Compiler->target.cpu.isPower())
+      return TR::Compiler->target.is64Bit() ? EM_PPC64 : EM_PPC;
+   if (TR::Compiler->target.cpu.isZ())
+      return EM_S390;
+   return EM_NONE;
+   }
+
+size_t
+alignUp(size_t size)
+   {
+   return (size + sizeof(uint64_t) - 1) & ~(sizeof(uint64_t) - 1);
+   }
+
+}
+
+/*
+ * A queued event and everything it refers to live in a single allocation, so
+ * nothing the compiler owns is touched once the event has been queued.
+ */
+struct TR::JitDump::Event
+   {
+   enum Kind
+      {
+      CodeLoad,
+      CodeUnload
+      };
+
+   Event *_next;
+   Kind _kind;
+   uint64_t _timestamp;
+   uint32_t _threadID;
+   const uint8_t *_start;
+   const uint8_t *_end;
+   const char *_name;
+   const char *_fileName;
+   const LineEntry *_lines;
+   uint32_t _numLines;
+   const uint8_t *_code;
+   };
+
+struct TR::JitDump::GDBEntry
+   {
+   jit_code_entry _entry;
+   const uint8_t *_start;
+   GDBEntry *_next;
+   };
+
+
+TR::JitDump::JitDump() :
+   _rawAllocator(),
+   _writerStarted(false),
+   _stopping(false),
+   _queueHead(NULL),
+   _queueTail(NULL),
+   _eventsQueued(0),
+   _eventsWritten(0),
+   _file(NULL),
+   _marker(NULL),
+   _markerSize(0),
+   _codeIndex(0),
+   _registerWithGDB(false),
+   _gdbEntries(NULL)
+   {
+   pthread_mutex_init(&_lock, NULL);
+   pthread_cond_init(&_queueChanged, NULL);
+   }
+
+
+bool
+TR::JitDump::initialize(bool writeJitDump, bool registerWithGDB)
+   {
+   if (_instance)
+      return true;
+   if (!writeJitDump && !registerWithGDB)
+      return false;
+
+   void *storage = TR::RawAllocator().allocate(sizeof(JitDump), std::nothrow);
+   if (!storage)
+      return false;
+
+   JitDump *jitDump = new (storage) JitDump();
+   jitDump->_registerWithGDB = registerWithGDB;
+
+   if ((writeJitDump && !jitDump->openJitDumpFile()) || !jitDump->startWriter())
+      {
+      jitDump->closeJitDumpFile();
+      jitDump->~JitDump();
+      TR::RawAllocator().deallocate(storage);
+      return false;
+      }
+
+   _instance = jitDump;
+   return true;
+   }
+
+
+void
+TR::JitDump::shutdown()
+   {
+   JitDump *jitDump = _instance;
+   if (!jitDump)
+      return;
+
+   _instance = NULL;
+   jitDump->stopWriter();
+   jitDump->unregisterFromGDB(NULL, reinterpret_cast<const uint8_t *>(~static_cast<uintptr_t>(0)));
+   jitDump->closeJitDumpFile();
+
+   pthread_cond_destroy(&jitDump->_queueChanged);
+   pthread_mutex_destroy(&jitDump->_lock);
+   jitDump->~JitDump();
+   TR::RawAllocator().deallocate(jitDump);
+   }
+
+
+bool
+TR::JitDump::openJitDumpFile()
+   {
+   static const int maxFilenameSize = 20 + sizeof(pid_t) * 3; // "/tmp/jit-%d.dump"
+   char filename[maxFilenameSize];
+   int written = snprintf(filename, maxFilenameSize, "/tmp/jit-%d.dump", static_cast<int>(getpid()));
+   if (written <= 0 || written >= maxFilenameSize)
+      return false;
+
+   _file = fopen(filename, "w+");
+   if (!_file)
+      return false;
+
+   setvbuf(_file, NULL, _IOFBF, JITDUMP_BUFFER_SIZE);
+
+   // perf only finds the file through an executable mapping of it in the
+   // process, which shows up as an mmap event in the recording.
+   //
+   _markerSize = sysconf(_SC_PAGESIZE);
+   _marker = mmap(NULL, _markerSize, PROT_READ | PROT_EXEC, MAP_PRIVATE, fileno(_file), 0);
+   if (_marker == MAP_FAILED)
+      {
+      _marker = NULL;
+      fclose(_file);
+      _file = NULL;
+      return false;
+      }
+
+   JitDumpFileHeader header;
+   memset(&header, 0, sizeof(header));
+   header._magic = JITDUMP_MAGIC;
+   header._version = JITDUMP_VERSION;
+   header._totalSize = sizeof(header);
+   header._elfMachine = elfMachine();
+   header._pid = static_cast<uint32_t>(getpid());
+   header._timestamp = monotonicTimestamp();
+   fwrite(&header, sizeof(header), 1, _file);
+   fflush(_file);
+   return true;
+   }
+
+
+void
+TR::JitDump::closeJitDumpFile()
+   {
+   if (!_file)
+      return;
+
+   JitDumpRecordHeader close;
+   close._id = JIT_CODE_CLOSE;
+   close._totalSize = sizeof(close);
+   close._timestamp = monotonicTimestamp();
+   fwrite(&close, sizeof(close), 1, _file);
+
+   if (_marker)
+      munmap(_marker, _markerSize);
+   fclose(_file);
+   _marker = NULL;
+   _file = NULL;
+   }
+
+
+bool
+TR::JitDump::startWriter()
+   {
+   _writerStarted = (pthread_create(&_writer, NULL, writerThread, this) == 0);
+   return _writerStarted;
+   }
+
+
+void
+TR::JitDump::stopWriter()
+   {
+   if (!_writerStarted)
+      return;
+
+   pthread_mutex_lock(&_lock);
+   _stopping = true;
+   pthread_cond_broadcast(&_queueChanged);
+   pthread_mutex_unlock(&_lock);
+
+   pthread_join(_writer, NULL);
+   _writerStarted = false;
+   }
+
+
+void
+TR::JitDump::codeLoaded(const char *name, const uint8_t *start, uint32_t size,
+                        const char *fileName, const LineEntry *lines, uint32_t numLines)
+   {
+   if (!fileName || !lines)
+      numLines = 0;
+
+   size_t nameLength = strlen(name) + 1;
+   size_t fileNameLength = numLines ? strlen(fileName) + 1 : 0;
+   size_t codeSize = _file ? size : 0;
+
+   size_t linesOffset = alignUp(sizeof(Event));
+   size_t nameOffset = linesOffset + numLines * sizeof(LineEntry);
+   size_t fileNameOffset = nameOffset + nameLength;
+   size_t codeOffset = fileNameOffset + fileNameLength;
+
+   uint8_t *storage = static_cast<uint8_t *>(_rawAllocator.allocate(codeOffset + codeSize, std::nothrow));
+   if (!storage)
+      return;
+
+   Event *event = reinterpret_cast<Event *>(storage);
+   event->_kind = Event::CodeLoad;
+   event->_timestamp = monotonicTimestamp();
+   event->_threadID = static_cast<uint32_t>(syscall(SYS_gettid));
+   event->_start = start;
+   event->_end = start + size;
+
+   memcpy(storage + linesOffset, lines, numLines * sizeof(LineEntry));
+   event->_lines = reinterpret_cast<const LineEntry *>(storage + linesOffset);
+   event->_numLines = numLines;
+
+   memcpy(storage + nameOffset, name, nameLength);
+   event->_name = reinterpret_cast<const char *>(storage + nameOffset);
+
+   memcpy(storage + fileNameOffset, fileName, fileNameLength);
+   event->_fileName = numLines ? reinterpret_cast<const char *>(storage + fileNameOffset) : NULL;
+
+   // The code is copied now: by the time the writer gets to it the memory
+   // may already hold something else.
+   //
+   memcpy(storage + codeOffset, start, codeSize);
+   event->_code = codeSize ? storage + codeOffset : NULL;
+
+   enqueue(event);
+   }
+
+
+void
+TR::JitDump::codeUnloaded(const uint8_t *start, const uint8_t *end)
+   {
+   if (!_registerWithGDB)
+      return;
+
+   Event *event = static_cast<Event *>(_rawAllocator.allocate(sizeof(Event), std::nothrow));
+   if (!event)
+      return;
+
+   memset(event, 0, sizeof(Event));
+   event->_kind = Event::CodeUnload;
+   event->_start = start;
+   event->_end = end;
+   enqueue(event);
+   }
+
+
+void
+TR::JitDump::flush()
+   {
+   pthread_mutex_lock(&_lock);
+   uint64_t target = _eventsQueued;
+   while (_eventsWritten < target && _writerStarted)
+      pthread_cond_wait(&_queueChanged, &_lock);
+   pthread_mutex_unlock(&_lock);
+   }
+
+
+void
+TR::JitDump::enqueue(Event *event)
+   {
+   event->_next = NULL;
+
+   pthread_mutex_lock(&_lock);
+   if (_queueTail)
+      _queueTail->_next = event;
+   else
+      _queueHead = event;
+   _queueTail = event;
+   _eventsQueued++;
+   pthread_cond_broadcast(&_queueChanged);
+   pthread_mutex_unlock(&_lock);
+   }
+
+
+void *
+TR::JitDump::writerThread(void *arg)
+   {
+   JitDump *jitDump = static_cast<JitDump *>(arg);
+
+   pthread_mutex_lock(&jitDump->_lock);
+   for (;;)
+      {
+      while (!jitDump->_queueHead && !jitDump->_stopping)
+         pthread_cond_wait(&jitDump->_queueChanged, &jitDump->_lock);
+
+      Event *events = jitDump->_queueHead;
+      if (!events)
+         break;
+
+      jitDump->_queueHead = NULL;
+      jitDump->_queueTail = NULL;
+      pthread_mutex_unlock(&jitDump->_lock);
+
+      // Write the whole batch before flushing so that a burst of compiles
+      // costs one write system call rather than one per method.
+      //
+      uint64_t written = 0;
+      while (events)
+         {
+         Event *next = events->_next;
+         jitDump->processEvent(events);
+         events = next;
+         written++;
+         }
+      if (jitDump->_file)
+         fflush(jitDump->_file);
+
+      pthread_mutex_lock(&jitDump->_lock);
+      jitDump->_eventsWritten += written;
+      pthread_cond_broadcast(&jitDump->_queueChanged);
+      }
+   pthread_mutex_unlock(&jitDump->_lock);
+
+   return NULL;
+   }
+
+
+void
+TR::JitDump::processEvent(Event *event)
+   {
+   if (event->_kind == Event::CodeLoad)
+      {
+      if (_file)
+         writeCodeLoad(event);
+      if (_registerWithGDB)
+         registerWithGDB(event);
+      }
+   else
+      {
+      unregisterFromGDB(event->_start, event->_end);
+      }
+
+   _rawAllocator.deallocate(event);
+   }
+
+
+void
+TR::JitDump::writeCodeLoad(Event *event)
+   {
+   uint64_t codeAddress = reinterpret_cast<uintptr_t>(event->_start);
+   uint64_t codeSize = event->_end - event->_start;
+
+   // perf requires the line table to precede the code it describes
+   //
+   if (event->_numLines > 0)
+      {
+      size_t fileNameLength = strlen(event->_fileName) + 1;
+
+      JitDumpDebugInfo debugInfo;
+      debugInfo._header._id = JIT_CODE_DEBUG_INFO;
+      debugInfo._header._totalSize = static_cast<uint32_t>(sizeof(debugInfo) + event->_numLines * (sizeof(JitDumpDebugEntry) + fileNameLength));
+      debugInfo._header._timestamp = event->_timestamp;
+      debugInfo._codeAddress = codeAddress;
+      debugInfo._numEntries = event->_numLines;
+      fwrite(&debugInfo, sizeof(debugInfo), 1, _file);
+
+      for (uint32_t i = 0; i < event->_numLines; i++)
+         {
+         JitDumpDebugEntry entry;
+         entry._address = reinterpret_cast<uintptr_t>(event->_lines[i]._address);
+         entry._line = event->_lines[i]._line;
+         entry._discriminator = 0;
+         fwrite(&entry, sizeof(entry), 1, _file);
+         fwrite(event->_fileName, fileNameLength, 1, _file);
+         }
+      }
+
+   size_t nameLength = strlen(event->_name) + 1;
+
+   JitDumpCodeLoad load;
+   load._header._id = JIT_CODE_LOAD;
+   load._header._totalSize = static_cast<uint32_t>(sizeof(load) + nameLength + codeSize);
+   load._header._timestamp = event->_timestamp;
+   load._pid = static_cast<uint32_t>(getpid());
+   load._tid = event->_threadID;
+   load._vma = codeAddress;
+   load._codeAddress = codeAddress;
+   load._codeSize = codeSize;
+   load._codeIndex = _codeIndex++;
+   fwrite(&load, sizeof(load), 1, _file);
+   fwrite(event->_name, nameLength, 1, _file);
+   fwrite(event->_code, codeSize, 1, _file);
+   }
+
+
+void
+TR::JitDump::registerWithGDB(Event *event)
+   {
+   TR::CodeCacheSymbol symbol;
+   symbol._name = event->_name;
+   symbol._nameLength = static_cast<uint32_t>(strlen(event->_name) + 1);
+   symbol._start = const_cast<uint8_t *>(event->_start);
+   symbol._size = static_cast<uint32_t>(event->_end - event->_start);
+   symbol._next = NULL;
+
+   uint8_t *image = NULL;
+   size_t imageSize = 0;
+   bool built;
+      {
+      TR::ELFExecutableGenerator generator(_rawAllocator, event->_start, symbol._size);
+      built = generator.emitELFToMemory(&image, &imageSize, &symbol, 1, symbol._nameLength + /* UNDEF */ 1);
+      }
+   if (!built)
+      return;
+
+   GDBEntry *entry = static_cast<GDBEntry *>(_rawAllocator.allocate(sizeof(GDBEntry), std::nothrow));
+   if (!entry)
+      {
+      free(image);
+      return;
+      }
+
+   entry->_entry.symfile_addr = reinterpret_cast<const char *>(image);
+   entry->_entry.symfile_size = imageSize;
+   entry->_entry.prev_entry = NULL;
+   entry->_entry.next_entry = __jit_debug_descriptor.first_entry;
+   if (entry->_entry.next_entry)
+      entry->_entry.next_entry->prev_entry = &entry->_entry;
+   __jit_debug_descriptor.first_entry = &entry->_entry;
+   __jit_debug_descriptor.relevant_entry = &entry->_entry;
+   __jit_debug_descriptor.action_flag = JIT_REGISTER_FN;
+   __jit_debug_register_code();
+
+   entry->_start = event->_start;
+   entry->_next = _gdbEntries;
+   _gdbEntries = entry;
+   }
+
+
+void
+TR::JitDump::unregisterFromGDB(const uint8_t *start, const uint8_t *end)
+   {
+   GDBEntry **link = &_gdbEntries;
+   while (*link)
+      {
+      GDBEntry *entry = *link;
+      if (entry->_start < start || entry->_start >= end)
+         {
+         link = &entry->_next;
+         continue;
+         }
+
+      *link = entry->_next;
+
+      jit_code_entry *code = &entry->_entry;
+      if (code->prev_entry)
+         code->prev_entry->next_entry = code->next_entry;
+      else
+         __jit_debug_descriptor.first_entry = code->next_entry;
+      if (code->next_entry)
+         code->next_entry->prev_entry = code->prev_entry;
+      __jit_debug_descriptor.relevant_entry = code;
+      __jit_debug_descriptor.action_flag = JIT_UNREGISTER_FN;
+      __jit_debug_register_code();
+
+      free(const_cast<char *>(code->symfile_addr));
+      _rawAllocator.deallocate(entry);
+      }
+   }
+
+#else
+
+bool
+TR::JitDump::initialize(bool writeJitDump, bool registerWithGDB)
+   {
+   return false;
+   }
+
+void
+TR::JitDump::shutdown()
+   {
+   }
+
+void
+TR::JitDump::codeLoaded(const char *name, const uint8_t *start, uint32_t size,
+                        const char *fileName, const LineEntry *lines, uint32_t numLines)
+   {
+   }
+
+void
+TR::JitDump::codeUnloaded(const uint8_t *start, const uint8_t *end)
+   {
+   }
+
+void
+TR::JitDump::flush()
+   {
+   }
+
+#endif /* defined(LINUX) */
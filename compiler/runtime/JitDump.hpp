@@ -0,0 +1,161 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef TR_JITDUMP_INCL
+#define TR_JITDUMP_INCL
+
+#include <stdint.h>
+#include <stddef.h>
+
+#if defined(LINUX)
+#include <pthread.h>
+#include <stdio.h>
+#include "env/RawAllocator.hpp"
+#endif
+
+namespace TR
+{
+
+/**
+ * Publishes compiled code to external profilers and debuggers.
+ *
+ * Two consumers are supported, each enabled independently:
+ *
+ *  - A perf jitdump file, /tmp/jit-<pid>.dump, holding a copy of the code
+ *    bytes and an optional line table for every method as it is loaded.
+ *    `perf inject --jit` turns it into per-method ELF images, so samples in
+ *    code that has since been unloaded or overwritten still resolve.  The
+ *    timestamps use CLOCK_MONOTONIC; record with `perf record -k mono`.
+ *
+ *  - GDB's JIT interface: an in-memory ELF image per method, built with
+ *    TR::ELFExecutableGenerator, is registered through
+ *    __jit_debug_register_code and unregistered again when its code is freed.
+ *
+ * The compiling thread only copies the event into a queue.  Files are written
+ * and ELF images are built on a background thread, so compile latency does not
+ * depend on the disk or on a debugger being attached.
+ *
+ * Only Linux is supported; elsewhere initialize() fails and every other
+ * entry point does nothing.
+ */
+class JitDump
+   {
+   public:
+
+   /**
+    * A code address and the source line it was generated for.  Frontends
+    * without source positions report the bytecode index of the outermost
+    * caller instead.
+    */
+   struct LineEntry
+      {
+      const uint8_t *_address;
+      int32_t _line;
+      };
+
+   /**
+    * @brief Creates the singleton and starts its writer thread.
+    * @param[in] writeJitDump open /tmp/jit-<pid>.dump for perf
+    * @param[in] registerWithGDB register code through the GDB JIT interface
+    * @return true if the requested consumers are active
+    */
+   static bool initialize(bool writeJitDump, bool registerWithGDB);
+
+   /**
+    * @brief Drains the queue, closes the jitdump file, unregisters every
+    * method from GDB and destroys the singleton.  Must run before the code
+    * caches are released.
+    */
+   static void shutdown();
+
+   static JitDump *instance() { return _instance; }
+
+   /**
+    * @brief Records that a method's code is ready to run.
+    * @param[in] name the symbol name to publish; copied
+    * @param[in] start the first byte of the code
+    * @param[in] size the size of the code in bytes; the bytes are copied
+    * @param[in] fileName the file the lines refer to, or NULL; copied
+    * @param[in] lines the line table sorted by address, or NULL; copied
+    * @param[in] numLines the number of entries in lines
+    */
+   void codeLoaded(const char *name, const uint8_t *start, uint32_t size,
+                   const char *fileName, const LineEntry *lines, uint32_t numLines);
+
+   /**
+    * @brief Records that the code in [start, end) has been freed.  Every
+    * method registered with GDB that starts in the range is unregistered.
+    */
+   void codeUnloaded(const uint8_t *start, const uint8_t *end);
+
+   /**
+    * @brief Blocks until every event queued so far has been written.
+    */
+   void flush();
+
+#if defined(LINUX)
+   private:
+
+   struct Event;
+   struct GDBEntry;
+
+   JitDump();
+
+   bool openJitDumpFile();
+   void closeJitDumpFile();
+   bool startWriter();
+   void stopWriter();
+
+   void enqueue(Event *event);
+   void processEvent(Event *event);
+   void writeCodeLoad(Event *event);
+   void registerWithGDB(Event *event);
+   void unregisterFromGDB(const uint8_t *start, const uint8_t *end);
+
+   static void *writerThread(void *arg);
+
+   TR::RawAllocator _rawAllocator;
+
+   pthread_mutex_t _lock;
+   pthread_cond_t _queueChanged;
+   pthread_t _writer;
+   bool _writerStarted;
+   bool _stopping;
+   Event *_queueHead;
+   Event *_queueTail;
+   uint64_t _eventsQueued;
+   uint64_t _eventsWritten;
+
+   ::FILE *_file;
+   void *_marker;
+   size_t _markerSize;
+   uint64_t _codeIndex;
+
+   bool _registerWithGDB;
+   GDBEntry *_gdbEntries;
+#endif
+
+   static JitDump *_instance;
+   };
+
+}
+
+#endif
@@ -36,6 +36,7 @@
 #include "env/VerboseLog.hpp"
 #include "il/DataTypes.hpp"
 #include "infra/Assert.hpp"
+#include "infra/Bit.hpp"
 #include "infra/CriticalSection.hpp"
 #include "infra/Monitor.hpp"
 #include "omrformatconsts.h"
@@ -43,6 +44,7 @@
 #include "runtime/CodeCacheManager.hpp"
 #include "runtime/CodeCacheMemorySegment.hpp"
 #include "runtime/CodeCacheConfig.hpp"
+#include "runtime/JitDump.hpp"
 #include "runtime/Runtime.hpp"
 
 #ifdef LINUX
@@ -142,6 +144,20 @@ OMR::CodeCache::destroy(TR::CodeCacheManager *manager)
          manager->freeMemory(_unresolvedMethodHT);
          }
       }
+
+   if (_literalBuckets)
+      {
+      for (uint32_t bucket = 0; bucket < LITERAL_POOL_BUCKETS; bucket++)
+         {
+         while (_literalBuckets[bucket])
+            {
+            CodeCacheLiteral *literal = _literalBuckets[bucket];
+            _literalBuckets[bucket] = literal->_next;
+            manager->freeMemory(literal);
+            }
+         }
+      manager->freeMemory(_literalBuckets);
+      }
    }
 
 
@@ -274,6 +290,33 @@ OMR::CodeCache::trimCodeMemoryAllocation(void *codeMemoryStart, size_t actualSiz
    }
 
 
+void
+OMR::CodeCache::freeCodeMemory(uint8_t *warmCode, uint8_t *coldCode)
+   {
+   TR::CodeCacheConfig & config = _manager->codeCacheConfig();
+
+   // Acquire mutex because we are changing the list of free blocks
+   CacheCriticalSection freeingCode(self());
+
+   uint8_t *code[] = { warmCode, coldCode };
+   const char *eyeCatcher[] = { config.warmEyeCatcher(), config.coldEyeCatcher() };
+   for (int32_t i = 0; i < 2; i++)
+      {
+      if (!code[i])
+         continue;
+
+      CodeCacheMethodHeader *header = (CodeCacheMethodHeader *)(code[i] - sizeof(CodeCacheMethodHeader));
+      bool hasEyeCatcher = memcmp(header->_eyeCatcher, eyeCatcher[i], sizeof(header->_eyeCatcher)) == 0;
+      TR_ASSERT(hasEyeCatcher, "Missing eyecatcher during freeCodeMemory");
+      if (!hasEyeCatcher)
+         continue;
+
+      uint8_t *start = (uint8_t *)header;
+      self()->addFreeBlock2(start, start + header->_size);
+      }
+   }
+
+
 // Initialize a code cache
 //
 bool
@@ -312,6 +355,8 @@ OMR::CodeCache::initialize(TR::CodeCacheManager *manager,
 
    _hashEntryFreeList = NULL;
    _freeBlockList     = NULL;
+   _freeBlockTree     = NULL;
+   memset(_freeBlockClasses, 0, sizeof(_freeBlockClasses));
    _flags = 0;
    _CCPreLoadedCodeInitialized = false;
    self()->unreserve();
@@ -319,6 +364,11 @@ OMR::CodeCache::initialize(TR::CodeCacheManager *manager,
    _sizeOfLargestFreeColdBlock = 0;
    _sizeOfLargestFreeWarmBlock = 0;
    _lastAllocatedBlock = NULL; // MP
+   _literalBuckets = NULL;
+   _literalAlloc = NULL;
+   _literalTop = NULL;
+   _numLiterals = 0;
+   _literalPoolSize = 0;
 
 #if defined(OSX) && defined(AARCH64)
    pthread_jit_write_protect_np(0);
@@ -993,6 +1043,9 @@ OMR::CodeCache::addFreeBlock2WithCallSite(uint8_t *start,
 
    uint64_t size = end - start; // Size of space to be freed
 
+   if (TR::JitDump *jitDump = TR::JitDump::instance())
+      jitDump->codeUnloaded(start, end);
+
    // Destroy the eyeCatcher; note that there might not be an eyecatcher at all
    //
    if (size >= sizeof(CodeCacheMethodHeader))
@@ -1003,12 +1056,12 @@ OMR::CodeCache::addFreeBlock2WithCallSite(uint8_t *start,
    CodeCacheFreeCacheBlock *link = NULL;
    if (_freeBlockList)
       {
-      CodeCacheFreeCacheBlock *curr;
-      // find the insertion point
-      for (curr = _freeBlockList; curr->_next && (uint8_t *)(curr->_next) < start; curr = curr->_next)
-         {}
+      // find the insertion point: the last free block below start, if any, or else the first block
+      CodeCacheFreeCacheBlock *curr = self()->freeBlockBefore(start);
+      if (!curr)
+         curr = _freeBlockList;
 
-      if (start < (uint8_t *)curr && (uint8_t *)curr - end < sizeof(CodeCacheFreeCacheBlock))
+      if (start < (uint8_t *)curr && (uint8_t *)curr - end < FREE_BLOCK_MERGE_GAP)
          {
          // merge with the curr block ahead, which is also the first block
          TR_ASSERT(end <= (uint8_t *)curr, "assertion failure"); // check for no overlap of blocks
@@ -1016,6 +1069,7 @@ OMR::CodeCache::addFreeBlock2WithCallSite(uint8_t *start,
          if (!(start < _warmCodeAlloc && (uint8_t *)curr >= _coldCodeAlloc))
             {
             // which is also the first block
+            self()->unindexFreeBlock(curr);
             link = (CodeCacheFreeCacheBlock *) start;
             mergedBlock = curr;
             //fprintf(stderr, "--ccr-- merging new free block of the size %d with a block of the size %d at %p\n", size, curr->size, link);
@@ -1025,14 +1079,16 @@ OMR::CodeCache::addFreeBlock2WithCallSite(uint8_t *start,
             //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", link->size);
             }
          }
-      else if (curr->_next && ((uint8_t *)curr->_next - end < sizeof(CodeCacheFreeCacheBlock)) &&
+      else if (curr->_next && ((uint8_t *)curr->_next - end < FREE_BLOCK_MERGE_GAP) &&
          !(start < _warmCodeAlloc && (uint8_t *)curr->_next >= _coldCodeAlloc))
          {
          // merge with the next block, but don't merge warm blocks with cold blocks
-         if ((start - ((uint8_t *)curr + curr->_size) < sizeof(CodeCacheFreeCacheBlock)) &&
+         self()->unindexFreeBlock(curr->_next);
+         if ((start - ((uint8_t *)curr + curr->_size) < FREE_BLOCK_MERGE_GAP) &&
              !((uint8_t *)curr < _warmCodeAlloc && start >= _coldCodeAlloc))
             {
             // merge with the previous and the next blocks
+            self()->unindexFreeBlock(curr);
             mergedBlock = curr;
             //fprintf(stderr, "--ccr-- merging new free block of the size %d with blocks of the size %d and %d at %p\n", size, curr->_size, curr->_next->_size, curr);
             curr->_size = (uint8_t *)curr->_next + curr->_next->_size - (uint8_t *)curr;
@@ -1054,11 +1110,12 @@ OMR::CodeCache::addFreeBlock2WithCallSite(uint8_t *start,
             //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", link->_size);
             }
          }
-      else if ((uint8_t *)curr < start && start - ((uint8_t *)curr + curr->_size) < sizeof(CodeCacheFreeCacheBlock))
+      else if ((uint8_t *)curr < start && start - ((uint8_t *)curr + curr->_size) < FREE_BLOCK_MERGE_GAP)
          {
          // merge with the previous block
          if (!((uint8_t *)curr < _warmCodeAlloc && start >= _coldCodeAlloc))
             {
+            self()->unindexFreeBlock(curr);
             mergedBlock = curr;
             curr->_size = start + size - (uint8_t *)curr;
             //fprintf(stderr, "--ccr-- new merged free block's size is %d\n", curr->_size);
@@ -1093,6 +1150,7 @@ OMR::CodeCache::addFreeBlock2WithCallSite(uint8_t *start,
       link = _freeBlockList;
       }
 
+   self()->indexFreeBlock(link);
    self()->updateMaxSizeOfFreeBlocks(link, link->_size);
 
    _manager->decreaseCurrTotalUsedInBytes(size);
@@ -1147,105 +1205,40 @@ OMR::CodeCache::updateMaxSizeOfFreeBlocks(CodeCacheFreeCacheBlock *blockPtr, siz
 uint8_t *
 OMR::CodeCache::findFreeBlock(size_t size, bool isCold, bool isMethodHeaderNeeded)
    {
-   CodeCacheFreeCacheBlock *currLink;
-   CodeCacheFreeCacheBlock *prevLink;
-   CodeCacheFreeCacheBlock *bestFitLink = NULL, *bestFitLinkPrev = NULL;
-   CodeCacheFreeCacheBlock *biggestLink = NULL;
-   CodeCacheFreeCacheBlock *secondBiggestLink = NULL;
-
    TR_ASSERT(_freeBlockList, "Because we first checked that a freeBlockExists, freeBlockList cannot be null");
 
    // Find the smallest free link to fit the requested blockSize
-   for (currLink = _freeBlockList, prevLink = NULL; currLink; prevLink = currLink, currLink = currLink->_next)
-      {
-      if (isCold)
-         {
-         if ((void*)currLink < (void*)_coldCodeAlloc)
-            continue;
-         }
-      else
-         {
-         if ((void*)currLink >= (void*)_warmCodeAlloc)
-            continue;
-         // curLink is warm code
-         }
-
-      //fprintf(stderr, "cache %p findFreeBlock bs=%u\n", this, currLink->size);
-      if (!biggestLink)
-         {
-         biggestLink = currLink;
-         }
-      else
-         {
-         if (currLink->_size >= biggestLink->_size) // >= is important; do not use > only as secondBiggestLink may be wrong
-            {
-            secondBiggestLink = biggestLink;
-            biggestLink = currLink;
-            }
-         else
-            {
-            if (secondBiggestLink)
-               {
-               if (currLink->_size >= secondBiggestLink->_size)
-                  secondBiggestLink = currLink;
-               }
-            else
-               {
-               secondBiggestLink = currLink;
-               }
-            }
-         }
-
-      if (currLink->_size >= size)
-         {
-         if (!bestFitLink)
-            {
-            bestFitLink = currLink;
-            bestFitLinkPrev = prevLink;
-            }
-         else if (bestFitLink->_size > currLink->_size)
-            {
-            bestFitLink = currLink;
-            bestFitLinkPrev = prevLink;
-            }
-         }
-      } // end for
+   CodeCacheFreeCacheBlock *bestFitLink = self()->bestFitFreeBlock(size, isCold);
 
    // safety net
-   TR_ASSERT(biggestLink, "There must be a biggestLink");
    TR_ASSERT(bestFitLink, "There must be a bestFitLink");
 
    TR::CodeCacheConfig & config = _manager->codeCacheConfig();
    if (!isCold)
       {
       TR_ASSERT(!config.codeCacheFreeBlockRecylingEnabled() ||
-              _sizeOfLargestFreeWarmBlock == biggestLink->_size, "_sizeOfLargestFreeWarmBlock=%d  biggestLink->_size=%d",
-           _sizeOfLargestFreeWarmBlock, (int32_t)biggestLink->_size);
+              _sizeOfLargestFreeWarmBlock == self()->largestFreeBlockSize(false), "_sizeOfLargestFreeWarmBlock=%d  largestFreeBlockSize=%d",
+           _sizeOfLargestFreeWarmBlock, (int32_t)self()->largestFreeBlockSize(false));
       }
    else
       {
       TR_ASSERT(!config.codeCacheFreeBlockRecylingEnabled() ||
-         _sizeOfLargestFreeColdBlock == biggestLink->_size, "assertion failure");
+         _sizeOfLargestFreeColdBlock == self()->largestFreeBlockSize(true), "assertion failure");
       }
 
    if (bestFitLink)
       {
+      size_t bestFitSize = bestFitLink->_size;
+
       // Fix the linked list by removing the allocated block AND if there is any unused
       // space left in the currLink chunk, reclaim it and put back on the freeList
-      CodeCacheFreeCacheBlock *leftBlock = self()->removeFreeBlock(size, bestFitLinkPrev, bestFitLink);
+      CodeCacheFreeCacheBlock *leftBlock = self()->removeFreeBlock(size, self()->freeBlockBefore((uint8_t *)bestFitLink), bestFitLink);
+
+      if (!isCold && bestFitSize == _sizeOfLargestFreeWarmBlock)  // Size of biggest might have changed
+         _sizeOfLargestFreeWarmBlock = self()->largestFreeBlockSize(false);
+      else if (isCold && bestFitSize == _sizeOfLargestFreeColdBlock)
+         _sizeOfLargestFreeColdBlock = self()->largestFreeBlockSize(true);
 
-      if (bestFitLink == biggestLink)  // Size of biggest might have changed
-         {
-         uint64_t leftBlockSize     = leftBlock ? leftBlock->_size : 0;
-         uint64_t secondBiggestSize = secondBiggestLink ? secondBiggestLink->_size : 0;
-         uint64_t biggestSize       = leftBlockSize > secondBiggestSize ? leftBlockSize : secondBiggestSize;
-         if (!isCold)
-            {
-            _sizeOfLargestFreeWarmBlock = (size_t)biggestSize;
-            }
-         else
-            _sizeOfLargestFreeColdBlock = (size_t)biggestSize;
-         }
      //fprintf(stderr, "--ccr-- reallocate free'd block of size %d\n", size);
      if (config.verboseReclamation())
          {
@@ -1289,11 +1282,13 @@ OMR::CodeCache::removeFreeBlock(size_t blockSize,
       pthread_jit_write_protect_np(0);
 #endif
 
+      self()->unindexFreeBlock(curr);
       size_t splitSize = curr->_size - blockSize; // remaining portion
       curr->_size = blockSize;
       curr = (CodeCacheFreeCacheBlock *) ((uint8_t *) curr + blockSize);
       curr->_size = splitSize;
       curr->_next = next;
+      self()->indexFreeBlock(curr);
 
       if (prev)
          prev->_next = curr;
@@ -1312,6 +1307,7 @@ OMR::CodeCache::removeFreeBlock(size_t blockSize,
       pthread_jit_write_protect_np(0);
 #endif
 
+      self()->unindexFreeBlock(curr);
       if (prev)
          prev->_next = next;
       else
@@ -1326,6 +1322,220 @@ OMR::CodeCache::removeFreeBlock(size_t blockSize,
    }
 
 
+// The free block index
+//
+// Free blocks are kept in a treap ordered by address, with priorities derived
+// from the block addresses, so that the neighbours of a freed range can be
+// found without walking the free list. They are also kept in doubly linked
+// lists by size class, separately for warm and cold blocks, so that a best fit
+// only has to look at blocks that are close to the requested size.
+//
+static uintptr_t
+freeBlockPriority(OMR::CodeCacheFreeCacheBlock *block)
+   {
+   uintptr_t hash = (reinterpret_cast<uintptr_t>(block) >> 4) * static_cast<uintptr_t>(0x9E3779B97F4A7C15ULL);
+   return hash ^ (hash >> 29);
+   }
+
+static OMR::CodeCacheFreeCacheBlock *
+insertFreeBlockInTree(OMR::CodeCacheFreeCacheBlock *root, OMR::CodeCacheFreeCacheBlock *block)
+   {
+   if (!root)
+      return block;
+
+   if (block < root)
+      {
+      root->_left = insertFreeBlockInTree(root->_left, block);
+      if (freeBlockPriority(root->_left) > freeBlockPriority(root))
+         {
+         OMR::CodeCacheFreeCacheBlock *left = root->_left;
+         root->_left = left->_right;
+         left->_right = root;
+         return left;
+         }
+      }
+   else
+      {
+      root->_right = insertFreeBlockInTree(root->_right, block);
+      if (freeBlockPriority(root->_right) > freeBlockPriority(root))
+         {
+         OMR::CodeCacheFreeCacheBlock *right = root->_right;
+         root->_right = right->_left;
+         right->_left = root;
+         return right;
+         }
+      }
+   return root;
+   }
+
+// Every block in left is below every block in right
+static OMR::CodeCacheFreeCacheBlock *
+joinFreeBlockTrees(OMR::CodeCacheFreeCacheBlock *left, OMR::CodeCacheFreeCacheBlock *right)
+   {
+   if (!left)
+      return right;
+   if (!right)
+      return left;
+
+   if (freeBlockPriority(left) > freeBlockPriority(right))
+      {
+      left->_right = joinFreeBlockTrees(left->_right, right);
+      return left;
+      }
+   right->_left = joinFreeBlockTrees(left, right->_left);
+   return right;
+   }
+
+static OMR::CodeCacheFreeCacheBlock *
+removeFreeBlockFromTree(OMR::CodeCacheFreeCacheBlock *root, OMR::CodeCacheFreeCacheBlock *block)
+   {
+   TR_ASSERT(root, "Free block %p is not in the free block tree", block);
+   if (root == block)
+      return joinFreeBlockTrees(block->_left, block->_right);
+
+   if (block < root)
+      root->_left = removeFreeBlockFromTree(root->_left, block);
+   else
+      root->_right = removeFreeBlockFromTree(root->_right, block);
+   return root;
+   }
+
+// Four classes per power of two, so that blocks in one class differ in size by
+// less than a quarter
+static uint32_t
+freeBlockSizeClass(size_t size)
+   {
+   uint64_t bytes = size;
+   int32_t log2 = 63 - leadingZeroes(bytes);
+   if (log2 < 4)
+      return 0;
+   if (log2 > 31)
+      return FREE_BLOCK_SIZE_CLASSES - 1;
+   return static_cast<uint32_t>((log2 - 4) * 4) + static_cast<uint32_t>((bytes >> (log2 - 2)) & 3);
+   }
+
+// Must be called with write access to the code cache on platforms that protect it
+void
+OMR::CodeCache::indexFreeBlock(CodeCacheFreeCacheBlock *block)
+   {
+   bool isCold = (uint8_t *)block >= _warmCodeAlloc;
+   CodeCacheFreeCacheBlock **head = &_freeBlockClasses[isCold][freeBlockSizeClass(block->_size)];
+   block->_prevInClass = NULL;
+   block->_nextInClass = *head;
+   if (*head)
+      (*head)->_prevInClass = block;
+   *head = block;
+
+   block->_left = NULL;
+   block->_right = NULL;
+   _freeBlockTree = insertFreeBlockInTree(_freeBlockTree, block);
+   }
+
+// Must be called before the block's size changes
+void
+OMR::CodeCache::unindexFreeBlock(CodeCacheFreeCacheBlock *block)
+   {
+   bool isCold = (uint8_t *)block >= _warmCodeAlloc;
+   if (block->_prevInClass)
+      {
+      block->_prevInClass->_nextInClass = block->_nextInClass;
+      }
+   else
+      {
+      TR_ASSERT(_freeBlockClasses[isCold][freeBlockSizeClass(block->_size)] == block, "Free block %p is not in its size class", block);
+      _freeBlockClasses[isCold][freeBlockSizeClass(block->_size)] = block->_nextInClass;
+      }
+   if (block->_nextInClass)
+      block->_nextInClass->_prevInClass = block->_prevInClass;
+
+   _freeBlockTree = removeFreeBlockFromTree(_freeBlockTree, block);
+   }
+
+void
+OMR::CodeCache::rebuildFreeBlockIndex()
+   {
+#if defined(OSX) && defined(AARCH64)
+   pthread_jit_write_protect_np(0);
+#endif
+
+   _freeBlockTree = NULL;
+   memset(_freeBlockClasses, 0, sizeof(_freeBlockClasses));
+   for (CodeCacheFreeCacheBlock *block = _freeBlockList; block; block = block->_next)
+      self()->indexFreeBlock(block);
+
+#if defined(OSX) && defined(AARCH64)
+   pthread_jit_write_protect_np(1);
+#endif
+   }
+
+void
+OMR::CodeCache::setFreeBlockList(CodeCacheFreeCacheBlock *fcb)
+   {
+   _freeBlockList = fcb;
+   self()->rebuildFreeBlockIndex();
+   }
+
+// The last free block that starts below address, or NULL if there is none
+OMR::CodeCacheFreeCacheBlock *
+OMR::CodeCache::freeBlockBefore(uint8_t *address)
+   {
+   CodeCacheFreeCacheBlock *before = NULL;
+   CodeCacheFreeCacheBlock *node = _freeBlockTree;
+   while (node)
+      {
+      if ((uint8_t *)node < address)
+         {
+         before = node;
+         node = node->_right;
+         }
+      else
+         {
+         node = node->_left;
+         }
+      }
+   return before;
+   }
+
+// The smallest warm or cold free block of at least size bytes, preferring the
+// lowest address among blocks of the same size
+OMR::CodeCacheFreeCacheBlock *
+OMR::CodeCache::bestFitFreeBlock(size_t size, bool isCold)
+   {
+   CodeCacheFreeCacheBlock *bestFit = NULL;
+   for (uint32_t sizeClass = freeBlockSizeClass(size); sizeClass < FREE_BLOCK_SIZE_CLASSES; sizeClass++)
+      {
+      for (CodeCacheFreeCacheBlock *block = _freeBlockClasses[isCold][sizeClass]; block; block = block->_nextInClass)
+         {
+         if (block->_size >= size &&
+             (!bestFit || block->_size < bestFit->_size || (block->_size == bestFit->_size && block < bestFit)))
+            bestFit = block;
+         }
+
+      // Every block in a higher class is bigger than any block in this one
+      if (bestFit)
+         break;
+      }
+   return bestFit;
+   }
+
+size_t
+OMR::CodeCache::largestFreeBlockSize(bool isCold)
+   {
+   for (uint32_t sizeClass = FREE_BLOCK_SIZE_CLASSES; sizeClass > 0; sizeClass--)
+      {
+      size_t largest = 0;
+      for (CodeCacheFreeCacheBlock *block = _freeBlockClasses[isCold][sizeClass - 1]; block; block = block->_nextInClass)
+         {
+         if (block->_size > largest)
+            largest = block->_size;
+         }
+      if (largest)
+         return largest;
+      }
+   return 0;
+   }
+
+
 void
 OMR::CodeCache::dumpCodeCache()
    {
@@ -1350,6 +1560,10 @@ OMR::CodeCache::printOccupancyStats()
       fprintf(stderr, "   sizeOfLargestFreeColdBlock = %8" OMR_PRIuSIZE " bytes\n", _sizeOfLargestFreeColdBlock);
       fprintf(stderr, "   sizeOfLargestFreeWarmBlock = %8" OMR_PRIuSIZE " bytes\n", _sizeOfLargestFreeWarmBlock);
       fprintf(stderr, "   reclaimed sizes:");
+      size_t numFree[2] = { 0, 0 };
+      size_t bytesFree[2] = { 0, 0 };
+      size_t largestFree[2] = { 0, 0 };
+      uint32_t classesInUse = 0;
       // scope for critical section
          {
          CacheCriticalSection resolveAndCreateTrampoline(self());
@@ -1357,9 +1571,33 @@ OMR::CodeCache::printOccupancyStats()
             {
             fprintf(stderr, " %" OMR_PRIuSIZE, currLink->_size);
             totalReclaimed += currLink->_size;
+
+            int32_t isCold = (uint8_t *)currLink >= _warmCodeAlloc;
+            numFree[isCold]++;
+            bytesFree[isCold] += currLink->_size;
+            if (currLink->_size > largestFree[isCold])
+               largestFree[isCold] = currLink->_size;
+            }
+         for (uint32_t sizeClass = 0; sizeClass < FREE_BLOCK_SIZE_CLASSES; sizeClass++)
+            {
+            if (_freeBlockClasses[0][sizeClass] || _freeBlockClasses[1][sizeClass])
+               classesInUse++;
             }
          }
       fprintf(stderr, "\n");
+
+      // Fragmentation is the share of the free bytes that the largest free block could not satisfy
+      static const char *regionNames[2] = { "warm", "cold" };
+      for (int32_t isCold = 0; isCold < 2; isCold++)
+         {
+         fprintf(stderr, "   %s free blocks = %6" OMR_PRIuSIZE ", %8" OMR_PRIuSIZE " bytes, average %8" OMR_PRIuSIZE " bytes, fragmentation %3d%%\n",
+            regionNames[isCold],
+            numFree[isCold],
+            bytesFree[isCold],
+            numFree[isCold] ? bytesFree[isCold] / numFree[isCold] : 0,
+            bytesFree[isCold] ? (int32_t)(100 - (largestFree[isCold] * 100) / bytesFree[isCold]) : 0);
+         }
+      fprintf(stderr, "   free block size classes in use = %u of %u\n", classesInUse, FREE_BLOCK_SIZE_CLASSES);
       }
 
    TR::CodeCacheConfig &config = _manager->codeCacheConfig();
@@ -1370,6 +1608,11 @@ OMR::CodeCache::printOccupancyStats()
          (int32_t)(_tempTrampolineNext - _tempTrampolineBase));
       }
 
+   if (_numLiterals)
+      {
+      fprintf(stderr, "   literal pool = %" OMR_PRIuSIZE " literals in %" OMR_PRIuSIZE " bytes\n", _numLiterals, _literalPoolSize);
+      }
+
    size_t totalConfigSizeInBytes = config.codeCacheKB() * 1024;
    size_t totalFreeSizeInBytes = self()->getFreeContiguousSpace() + totalReclaimed;
    fprintf(stderr, "   config size     = %8" OMR_PRIuSIZE " bytes\n", totalConfigSizeInBytes);
@@ -1405,6 +1648,7 @@ OMR::CodeCache::checkForErrors()
       {
       bool doCrash = false;
       size_t maxFreeWarmSize = 0, maxFreeColdSize = 0;
+      size_t numListed = 0;
       // scope for cache walk
          {
          CacheCriticalSection walkFreeList(self());
@@ -1463,6 +1707,13 @@ OMR::CodeCache::checkForErrors()
                      }
                   }
                }
+            // Is the block indexed where allocation will look for it?
+            if (self()->freeBlockBefore((uint8_t *)currLink + 1) != currLink)
+               {
+               fprintf(stderr, "checkForErrors cache %p: Error: free block %p is missing from the free block tree\n", this, currLink);
+               doCrash = true;
+               }
+            numListed++;
             if ((uint8_t*)currLink < _warmCodeAlloc) // warm block
                {
                if (currLink->_size > maxFreeWarmSize)
@@ -1474,6 +1725,27 @@ OMR::CodeCache::checkForErrors()
                   maxFreeColdSize = currLink->_size;
                }
             } // end for
+         size_t numIndexed = 0;
+         for (int32_t isCold = 0; isCold < 2; isCold++)
+            {
+            for (uint32_t sizeClass = 0; sizeClass < FREE_BLOCK_SIZE_CLASSES; sizeClass++)
+               {
+               for (CodeCacheFreeCacheBlock *block = _freeBlockClasses[isCold][sizeClass]; block; block = block->_nextInClass)
+                  {
+                  if (freeBlockSizeClass(block->_size) != sizeClass)
+                     {
+                     fprintf(stderr, "checkForErrors cache %p: Error: free block %p of size %" OMR_PRIuSIZE " is in size class %u\n", this, block, block->_size, sizeClass);
+                     doCrash = true;
+                     }
+                  numIndexed++;
+                  }
+               }
+            }
+         if (numIndexed != numListed)
+            {
+            fprintf(stderr, "checkForErrors cache %p: Error: %" OMR_PRIuSIZE " free blocks are listed but %" OMR_PRIuSIZE " are indexed by size\n", this, numListed, numIndexed);
+            doCrash = true;
+            }
          if (_sizeOfLargestFreeWarmBlock != maxFreeWarmSize)
             {
             fprintf(stderr, "checkForErrors cache %p: Error: _sizeOfLargestFreeWarmBlock(%" OMR_PRIuSIZE ") != maxFreeWarmSize(%" OMR_PRIuSIZE ")\n", this, _sizeOfLargestFreeWarmBlock, maxFreeWarmSize);
@@ -1550,6 +1822,87 @@ OMR::CodeCache::findResolvedMethod(TR_OpaqueMethodBlock *method)
    }
 
 
+/*****************************************************************************
+ *  Literal Pool
+ */
+
+uint8_t *
+OMR::CodeCache::findOrAddLiteral(const void *data, size_t size)
+   {
+   // FNV-1a over the bytes of the constant
+   uint32_t hash = 2166136261u;
+   for (size_t i = 0; i < size; i++)
+      hash = (hash ^ static_cast<const uint8_t *>(data)[i]) * 16777619u;
+   uint32_t bucket = hash % LITERAL_POOL_BUCKETS;
+
+   size_t alignment = 1;
+   while (alignment < size && alignment < LITERAL_POOL_MAX_ALIGNMENT)
+      alignment <<= 1;
+
+   CacheCriticalSection updatingLiteralPool(self());
+
+   if (!_literalBuckets)
+      {
+      _literalBuckets = static_cast<CodeCacheLiteral **>(_manager->getMemory(sizeof(CodeCacheLiteral *) * LITERAL_POOL_BUCKETS));
+      if (!_literalBuckets)
+         return NULL;
+      memset(_literalBuckets, 0, sizeof(CodeCacheLiteral *) * LITERAL_POOL_BUCKETS);
+      }
+
+   for (CodeCacheLiteral *literal = _literalBuckets[bucket]; literal; literal = literal->_next)
+      {
+      if (literal->_size == size && !memcmp(literal->_address, data, size))
+         return literal->_address;
+      }
+
+   CodeCacheLiteral *literal = static_cast<CodeCacheLiteral *>(_manager->getMemory(sizeof(CodeCacheLiteral)));
+   if (!literal)
+      return NULL;
+
+   uint8_t *address = _literalAlloc ? reinterpret_cast<uint8_t *>(align(reinterpret_cast<size_t>(_literalAlloc), alignment)) : NULL;
+   if (!address || address + size > _literalTop)
+      {
+      // Start a new chunk below the cold code. It gets a method header so that
+      // walks over the cold area step over it like over a method body.
+      TR::CodeCacheConfig &config = _manager->codeCacheConfig();
+      size_t round = config.codeCacheAlignment() - 1;
+      size_t chunkSize = sizeof(CodeCacheMethodHeader) + LITERAL_POOL_MAX_ALIGNMENT + (size > LITERAL_POOL_CHUNK_SIZE ? size : LITERAL_POOL_CHUNK_SIZE);
+      if (self()->getFreeContiguousSpace() < chunkSize + round)
+         {
+         _manager->freeMemory(literal);
+         return NULL;
+         }
+      uint8_t *chunk = reinterpret_cast<uint8_t *>(reinterpret_cast<size_t>(_coldCodeAlloc - chunkSize) & ~round);
+
+      _manager->increaseCurrTotalUsedInBytes(_coldCodeAlloc - chunk);
+      _literalPoolSize += _coldCodeAlloc - chunk;
+      self()->writeMethodHeader(chunk, _coldCodeAlloc - chunk, true);
+      _literalTop = _coldCodeAlloc;
+      _literalAlloc = chunk + sizeof(CodeCacheMethodHeader);
+      _coldCodeAlloc = chunk;
+
+      address = reinterpret_cast<uint8_t *>(align(reinterpret_cast<size_t>(_literalAlloc), alignment));
+      }
+
+#if defined(OSX) && defined(AARCH64)
+   pthread_jit_write_protect_np(0);
+#endif
+   memcpy(address, data, size);
+#if defined(OSX) && defined(AARCH64)
+   pthread_jit_write_protect_np(1);
+#endif
+   _literalAlloc = address + size;
+
+   literal->_address = address;
+   literal->_size = size;
+   literal->_next = _literalBuckets[bucket];
+   _literalBuckets[bucket] = literal;
+   _numLiterals++;
+
+   return address;
+   }
+
+
 void
 OMR::CodeCache::findOrAddResolvedMethod(TR_OpaqueMethodBlock *method)
    {
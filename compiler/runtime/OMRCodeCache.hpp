@@ -109,6 +109,18 @@ public:
     */
    bool trimCodeMemoryAllocation(void *codeMemoryStart, size_t actualSizeInBytes);
 
+   /**
+    * @brief Returns the code memory of a method to this CodeCache.  The warm
+    *        and cold parts were allocated separately, each with a method
+    *        header, and both are freed.
+    *
+    * @param[in] warmCode : uint8_t* start of the warm code memory, as returned
+    *               by allocateCodeMemory
+    * @param[in] coldCode : uint8_t* start of the cold code memory, or NULL if
+    *               no cold code was allocated
+    */
+   void freeCodeMemory(uint8_t *warmCode, uint8_t *coldCode);
+
    CodeCacheMethodHeader *addFreeBlock(void *metaData);
 
    uint8_t *findFreeBlock(size_t size, bool isCold, bool isMethodHeaderNeeded);
@@ -193,6 +205,23 @@ public:
 
    CodeCacheHashEntry *       findResolvedMethod(TR_OpaqueMethodBlock *method);
 
+   /**
+    * @brief Finds a constant in the literal pool of this code cache, adding it
+    *        if it is not there yet
+    *
+    * @details
+    *    The literal pool is shared by every method in the code cache and holds
+    *    one copy of each value. A literal is aligned to its size rounded up to a
+    *    power of two, at most LITERAL_POOL_MAX_ALIGNMENT bytes, and is never
+    *    freed.
+    *
+    * @param[in] data : the bytes of the constant
+    * @param[in] size : the size of the constant in bytes
+    *
+    * @return the address of the literal; NULL if there is no room for it in this code cache
+    */
+   uint8_t *                  findOrAddLiteral(const void *data, size_t size);
+
    void                       findOrAddResolvedMethod(TR_OpaqueMethodBlock *method);
 
    TR::CodeCache *            next() { return _next; }
@@ -226,6 +255,16 @@ private:
                                               CodeCacheFreeCacheBlock *prev,
                                               CodeCacheFreeCacheBlock *curr);
 
+   // The free blocks are also indexed by address, for coalescing, and by
+   // size class, for best-fit allocation; these keep the index in step with
+   // the list
+   void                       indexFreeBlock(CodeCacheFreeCacheBlock *block);
+   void                       unindexFreeBlock(CodeCacheFreeCacheBlock *block);
+   void                       rebuildFreeBlockIndex();
+   CodeCacheFreeCacheBlock *  freeBlockBefore(uint8_t *address);
+   CodeCacheFreeCacheBlock *  bestFitFreeBlock(size_t size, bool isCold);
+   size_t                     largestFreeBlockSize(bool isCold);
+
 public:
    bool                       addFreeBlock2WithCallSite(uint8_t *start,
                                                         uint8_t *end,
@@ -296,11 +335,11 @@ public:
    CodeCacheFreeCacheBlock *freeBlockList() { return _freeBlockList; }
 
    /**
-    * @brief Setter for freeBlockList
+    * @brief Setter for freeBlockList; the free block index is rebuilt from the new list
     *
     * @param[in] : The new head of the CodeCacheFreeCacheBlock list
     */
-   void setFreeBlockList(CodeCacheFreeCacheBlock *fcb) { _freeBlockList = fcb; }
+   void setFreeBlockList(CodeCacheFreeCacheBlock *fcb);
 
    /**
     * @brief Getter for the base address of temporary trampolines
@@ -415,6 +454,8 @@ public:
    TR::CodeCacheMemorySegment *_segment;
 
    CodeCacheFreeCacheBlock *_freeBlockList;
+   CodeCacheFreeCacheBlock *_freeBlockTree;
+   CodeCacheFreeCacheBlock *_freeBlockClasses[2][FREE_BLOCK_SIZE_CLASSES]; // indexed by [isCold][size class]
 
    // This is used in an attempt to enforce mutually exclusive ownership.
    // flag accessed under mutex <== This is deceiving! There are two different monitors we may hold (not at the same time!) when we write to this.
@@ -443,6 +484,12 @@ public:
    CodeCacheHashTable * _resolvedMethodHT;
    CodeCacheHashTable * _unresolvedMethodHT;
 
+   CodeCacheLiteral ** _literalBuckets;   // allocated with the first literal
+   uint8_t * _literalAlloc;               // free space in the current literal chunk
+   uint8_t * _literalTop;
+   size_t    _numLiterals;
+   size_t    _literalPoolSize;            // bytes of all the literal chunks
+
    bool      _CCPreLoadedCodeInitialized;
    uint8_t * _CCPreLoadedCodeBase;
    uint8_t * _CCPreLoadedCodeTop;
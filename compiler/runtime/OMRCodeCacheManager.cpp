@@ -43,6 +43,7 @@
 #include "runtime/CodeCacheManager.hpp"
 #include "runtime/CodeCacheMemorySegment.hpp"
 #include "runtime/CodeCacheConfig.hpp"
+#include "runtime/JitDump.hpp"
 #include "runtime/Runtime.hpp"
 
 #if (HOST_OS == OMR_LINUX)
@@ -86,6 +87,11 @@ OMR::CodeCacheManager::UsageMonitorCriticalSection::UsageMonitorCriticalSection(
    {
    }
 
+OMR::CodeCacheManager::SymbolMonitorCriticalSection::SymbolMonitorCriticalSection(TR::CodeCacheManager *mgr)
+   : CriticalSection(mgr->_symbolMonitor)
+   {
+   }
+
 TR::CodeCache *
 OMR::CodeCacheManager::initialize(
       bool allocateMonolithicCodeCache,
@@ -151,6 +157,9 @@ OMR::CodeCacheManager::initialize(
    if (!(_usageMonitor = TR::Monitor::create("CodeCacheUsageMonitor")))
       return NULL;
 
+   if (!(_symbolMonitor = TR::Monitor::create("CodeCacheSymbolMonitor")))
+      return NULL;
+
 #if defined(TR_HOST_POWER)
    #define REACHEABLE_RANGE_KB (32*1024)
 #elif defined(TR_HOST_ARM64)
@@ -193,6 +202,10 @@ OMR::CodeCacheManager::initialize(
 void
 OMR::CodeCacheManager::destroy()
    {
+   // GDB must drop its symbol files before the code they describe goes away
+   //
+   TR::JitDump::shutdown();
+
 #if (HOST_OS == OMR_LINUX)
    // if code cache should be written out as shared object, do that now before destroying anything
 
@@ -890,6 +903,7 @@ void
 OMR::CodeCacheManager::registerCompiledMethod(const char *sig, uint8_t *startPC, uint32_t codeSize)
    {
 #if (HOST_OS == OMR_LINUX)
+   SymbolMonitorCriticalSection registerSymbol(self());
 
    TR::CodeCacheSymbol *newSymbol = static_cast<TR::CodeCacheSymbol *> (self()->getMemory(sizeof(TR::CodeCacheSymbol)));
    uint32_t nameLength = strlen(sig) + 1;
@@ -931,6 +945,8 @@ void
 OMR::CodeCacheManager::registerStaticRelocation(const TR::StaticRelocation &relocation)
    {
 #if (HOST_OS == OMR_LINUX)
+   SymbolMonitorCriticalSection registerRelocation(self());
+
    if (_elfRelocatableGenerator)
       {
       const char * const symbolName(relocation.symbol());
@@ -133,6 +133,12 @@ public:
       UsageMonitorCriticalSection(TR::CodeCacheManager *mgr);
       };
 
+   class SymbolMonitorCriticalSection : public CriticalSection
+      {
+      public:
+      SymbolMonitorCriticalSection(TR::CodeCacheManager *mgr);
+      };
+
    TR::CodeCacheConfig & codeCacheConfig() { return _config; }
 
    /**
@@ -344,6 +350,8 @@ protected:
    TR::Monitor                   *_usageMonitor;
    size_t                         _currTotalUsedInBytes;
    size_t                         _maxUsedInBytes;
+
+   TR::Monitor                   *_symbolMonitor;                     /*!< serializes symbol registration by concurrent compilations */
 #if (HOST_OS == OMR_LINUX)
    public:
    /**
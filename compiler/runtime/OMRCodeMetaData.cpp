@@ -41,6 +41,9 @@ OMR::CodeMetaData::CodeMetaData(TR::Compilation *comp)
    _compiledEntryPC = _interpreterEntryPC;
    _compiledEndPC = comp->cg()->getCodeEnd();
 
+   _coldStartPC = (uintptr_t)comp->cg()->getColdCodeStart();
+   _coldEndPC = (uintptr_t)comp->cg()->getColdCodeEnd();
+
    _hotness = comp->cg()->getMethodHotness();
    }
 
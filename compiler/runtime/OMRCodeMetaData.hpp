@@ -95,6 +95,17 @@ class OMR_EXTENSIBLE CodeMetaData
     */
    uintptr_t compiledEndPC() { return _compiledEndPC; }
 
+   /**
+    * @brief Returns the start address of the cold code split off from a
+    * method, or 0 if all of its code lies between its entry and end PCs.
+    */
+   uintptr_t coldStartPC() { return _coldStartPC; }
+
+   /**
+    * @brief Returns the end address of the cold code split off from a method.
+    */
+   uintptr_t coldEndPC() { return _coldEndPC; }
+
    /**
     * @brief Returns the compilation hotness level of a compiled method.
     */
@@ -109,6 +120,9 @@ class OMR_EXTENSIBLE CodeMetaData
    uintptr_t _compiledEntryPC;
    uintptr_t _compiledEndPC;
 
+   uintptr_t _coldStartPC;
+   uintptr_t _coldEndPC;
+
    TR_Hotness _hotness;
    };
 
@@ -37,6 +37,52 @@
 #include "AtomicSupport.hpp"
 #endif
 
+namespace
+{
+
+// The published code ranges need atomics even where AtomicSupport.hpp is
+// unavailable, so fall back to the compiler builtins there.
+//
+inline uintptr_t
+compareAndSwap(volatile uintptr_t *address, uintptr_t oldValue, uintptr_t newValue)
+   {
+#if !defined(TR_TARGET_POWER) || !defined(__clang__)
+   return VM_AtomicSupport::lockCompareExchange(address, oldValue, newValue);
+#else
+   return __sync_val_compare_and_swap(address, oldValue, newValue);
+#endif
+   }
+
+inline void
+storeBarrier()
+   {
+#if !defined(TR_TARGET_POWER) || !defined(__clang__)
+   VM_AtomicSupport::writeBarrier();
+#else
+   __sync_synchronize();
+#endif
+   }
+
+inline void
+loadBarrier()
+   {
+#if !defined(TR_TARGET_POWER) || !defined(__clang__)
+   VM_AtomicSupport::readBarrier();
+#else
+   __sync_synchronize();
+#endif
+   }
+
+inline void
+yieldProcessor()
+   {
+#if !defined(TR_TARGET_POWER) || !defined(__clang__)
+   VM_AtomicSupport::yieldCPU();
+#endif
+   }
+
+}
+
 namespace OMR
 {
 
@@ -44,10 +90,16 @@ TR::CodeMetaDataManager *CodeMetaDataManager::_codeMetaDataManager = NULL;
 
 
 CodeMetaDataManager::CodeMetaDataManager() :
+   _codeRanges(NULL),
+   _retiredCodeRanges(NULL),
+   _codeRangeEpoch(1),
+   _overflowReaders(0),
+   _writerLock(0),
    _cachedPC(0),
    _cachedHashTable(NULL),
    _retrievedMetaDataCache(NULL)
    {
+   memset(_readerSlots, 0, sizeof(_readerSlots));
    _metaDataAVL = self()->allocateMetaDataAVL();
    }
 
@@ -100,6 +152,14 @@ CodeMetaDataManager::allocateMetaDataAVL()
    return metaDataAVLTree;
    }
 
+
+static bool
+hasColdRange(const TR::MethodMetaDataPOD *metaData)
+   {
+   return metaData->startColdPC < metaData->endColdPC;
+   }
+
+
 /**
  * Insert metadata into the MetaDataManager.
  *
@@ -111,9 +171,38 @@ bool
 CodeMetaDataManager::insertMetaData(TR::MethodMetaDataPOD *metaData)
    {
    TR_ASSERT(metaData, "metaData must not be null");
-   //OMR::CriticalSection insertingMetaData(_monitor);
+   self()->acquireWriterLock();
+
+   bool insertSuccess = self()->insertRange(metaData, metaData->startPC, metaData->endPC);
+   if (insertSuccess && !self()->publishInsertedRange(metaData, metaData->startPC, metaData->endPC))
+      {
+      // Keep the hash and the published ranges in step
+      //
+      self()->removeRange(metaData, metaData->startPC, metaData->endPC);
+      insertSuccess = false;
+      }
+
+   if (insertSuccess && hasColdRange(metaData))
+      {
+      bool coldInserted = self()->insertRange(metaData, metaData->startColdPC, metaData->endColdPC);
+      if (coldInserted && !self()->publishInsertedRange(metaData, metaData->startColdPC, metaData->endColdPC))
+         {
+         self()->removeRange(metaData, metaData->startColdPC, metaData->endColdPC);
+         coldInserted = false;
+         }
 
-   return self()->insertRange(metaData, metaData->startPC, metaData->endPC);
+      if (!coldInserted)
+         {
+         // A method is registered for all of its code or none of it
+         //
+         self()->removeRange(metaData, metaData->startPC, metaData->endPC);
+         self()->publishRemovedRange(metaData, metaData->startPC);
+         insertSuccess = false;
+         }
+      }
+
+   self()->releaseWriterLock();
+   return insertSuccess;
    }
 
 
@@ -129,16 +218,23 @@ bool
 CodeMetaDataManager::removeMetaData(const TR::MethodMetaDataPOD *metaData)
    {
    TR_ASSERT(metaData, "metaData must not be null");
-   //OMR::CriticalSection removingMetaData(_monitor);
+   self()->acquireWriterLock();
 
    bool removeSuccess = false;
    if (self()->containsMetaData(metaData))
       {
       removeSuccess = self()->removeRange(metaData, metaData->startPC, metaData->endPC);
+      if (removeSuccess)
+         self()->publishRemovedRange(metaData, metaData->startPC);
+
+      if (removeSuccess && hasColdRange(metaData) &&
+          self()->removeRange(metaData, metaData->startColdPC, metaData->endColdPC))
+         self()->publishRemovedRange(metaData, metaData->startColdPC);
       }
 
    _retrievedMetaDataCache = NULL;
 
+   self()->releaseWriterLock();
    return removeSuccess;
    }
 
@@ -147,16 +243,283 @@ const TR::MethodMetaDataPOD *
 CodeMetaDataManager::findMetaDataForPC(uintptr_t pc)
    {
    TR_ASSERT(pc != 0, "attempting to query existing MetaData for a NULL PC");
-   self()->updateCache(pc);
-   if (!_retrievedMetaDataCache)
+
+   volatile uintptr_t *slot = self()->enterCodeRangeReader();
+   const CodeRange *range = findCodeRange(_codeRanges, pc);
+   TR::MethodMetaDataPOD *metaData = range ? range->_metaData : NULL;
+   self()->exitCodeRangeReader(slot);
+
+   return metaData;
+   }
+
+
+// protected
+const CodeMetaDataManager::CodeRange *
+CodeMetaDataManager::findCodeRange(const CodeRangeSnapshot *snapshot, uintptr_t pc)
+   {
+   if (!snapshot)
+      return NULL;
+
+   // Find the last range starting at or below pc
+   //
+   uintptr_t low = 0;
+   uintptr_t high = snapshot->_numRanges;
+   while (low < high)
       {
-      if (_cachedHashTable)
+      uintptr_t middle = low + (high - low) / 2;
+      if (snapshot->_ranges[middle]._startPC <= pc)
+         low = middle + 1;
+      else
+         high = middle;
+      }
+
+   if (low == 0)
+      return NULL;
+
+   const CodeRange *range = &snapshot->_ranges[low - 1];
+   if (pc >= range->_endPC || !range->_metaData)
+      return NULL;
+
+   return range;
+   }
+
+
+// protected
+CodeMetaDataManager::CodeRangeSnapshot *
+CodeMetaDataManager::allocateCodeRangeSnapshot(uintptr_t numRanges)
+   {
+   uintptr_t size = sizeof(CodeRangeSnapshot) + (numRanges > 0 ? numRanges - 1 : 0) * sizeof(CodeRange);
+   CodeRangeSnapshot *snapshot = (CodeRangeSnapshot *) TR_Memory::jitPersistentAlloc(size, TR_Memory::CodeMetaDataAVL);
+   if (snapshot)
+      {
+      snapshot->_numRanges = 0;
+      snapshot->_retireEpoch = 0;
+      snapshot->_nextRetired = NULL;
+      }
+
+   return snapshot;
+   }
+
+
+// protected
+bool
+CodeMetaDataManager::publishInsertedRange(TR::MethodMetaDataPOD *metaData, uintptr_t startPC, uintptr_t endPC)
+   {
+   CodeRangeSnapshot *current = _codeRanges;
+   uintptr_t numRanges = current ? current->_numRanges : 0;
+
+   CodeRangeSnapshot *next = self()->allocateCodeRangeSnapshot(numRanges + 1);
+   if (!next)
+      return false;
+
+   // Copy the live ranges, dropping any left behind by a removal that could
+   // not allocate, and slot the new range in by startPC
+   //
+   bool inserted = false;
+   uintptr_t count = 0;
+   for (uintptr_t i = 0; i < numRanges; ++i)
+      {
+      const CodeRange &range = current->_ranges[i];
+      if (!range._metaData)
+         continue;
+
+      if (!inserted && startPC < range._startPC)
          {
-         _retrievedMetaDataCache = self()->findMetaDataInHash(_cachedHashTable, pc);
+         next->_ranges[count]._startPC = startPC;
+         next->_ranges[count]._endPC = endPC;
+         next->_ranges[count]._metaData = metaData;
+         ++count;
+         inserted = true;
          }
+
+      next->_ranges[count]._startPC = range._startPC;
+      next->_ranges[count]._endPC = range._endPC;
+      next->_ranges[count]._metaData = range._metaData;
+      ++count;
+      }
+
+   if (!inserted)
+      {
+      next->_ranges[count]._startPC = startPC;
+      next->_ranges[count]._endPC = endPC;
+      next->_ranges[count]._metaData = metaData;
+      ++count;
       }
 
-   return _retrievedMetaDataCache;
+   next->_numRanges = count;
+   self()->publishCodeRanges(next);
+   return true;
+   }
+
+
+// protected
+void
+CodeMetaDataManager::publishRemovedRange(const TR::MethodMetaDataPOD *metaData, uintptr_t startPC)
+   {
+   CodeRangeSnapshot *current = _codeRanges;
+   CodeRange *removed = const_cast<CodeRange *>(findCodeRange(current, startPC));
+   if (!removed || removed->_metaData != metaData)
+      return;
+
+   CodeRangeSnapshot *next = self()->allocateCodeRangeSnapshot(current->_numRanges - 1);
+   if (!next)
+      {
+      // Readers treat a range without metadata as absent; the next
+      // successful publication compacts it away.
+      //
+      removed->_metaData = NULL;
+      return;
+      }
+
+   uintptr_t count = 0;
+   for (uintptr_t i = 0; i < current->_numRanges; ++i)
+      {
+      const CodeRange &range = current->_ranges[i];
+      if (&range == removed || !range._metaData)
+         continue;
+
+      next->_ranges[count]._startPC = range._startPC;
+      next->_ranges[count]._endPC = range._endPC;
+      next->_ranges[count]._metaData = range._metaData;
+      ++count;
+      }
+
+   next->_numRanges = count;
+   self()->publishCodeRanges(next);
+   }
+
+
+// protected
+void
+CodeMetaDataManager::publishCodeRanges(CodeRangeSnapshot *snapshot)
+   {
+   // The snapshot must be fully written before readers can find it
+   //
+   storeBarrier();
+   CodeRangeSnapshot *previous = _codeRanges;
+   _codeRanges = snapshot;
+
+   if (previous)
+      {
+      previous->_retireEpoch = _codeRangeEpoch;
+      previous->_nextRetired = _retiredCodeRanges;
+      _retiredCodeRanges = previous;
+      }
+
+   // Readers that announce the new epoch are guaranteed to see the new
+   // snapshot.  The atomic update also orders the publication before the
+   // scan of the reader slots in reclaimCodeRangeSnapshots.
+   //
+   uintptr_t epoch = _codeRangeEpoch;
+   while (compareAndSwap(&_codeRangeEpoch, epoch, epoch + 1) != epoch)
+      epoch = _codeRangeEpoch;
+
+   self()->reclaimCodeRangeSnapshots();
+   }
+
+
+// protected
+void
+CodeMetaDataManager::reclaimCodeRangeSnapshots()
+   {
+   // A reader that could not claim a slot has no recorded epoch; keep
+   // everything until it has gone.
+   //
+   if (_overflowReaders != 0)
+      return;
+
+   uintptr_t oldestReader = (uintptr_t) -1;
+   for (uintptr_t i = 0; i < CODE_RANGE_READER_SLOTS; ++i)
+      {
+      uintptr_t epoch = _readerSlots[i]._epoch;
+      if (epoch != 0 && epoch < oldestReader)
+         oldestReader = epoch;
+      }
+
+   // A reader in epoch E may hold any snapshot retired in epoch E or later
+   //
+   CodeRangeSnapshot **link = &_retiredCodeRanges;
+   while (*link)
+      {
+      CodeRangeSnapshot *snapshot = *link;
+      if (snapshot->_retireEpoch < oldestReader)
+         {
+         *link = snapshot->_nextRetired;
+         TR_Memory::jitPersistentFree(snapshot);
+         }
+      else
+         {
+         link = &snapshot->_nextRetired;
+         }
+      }
+   }
+
+
+// protected
+volatile uintptr_t *
+CodeMetaDataManager::enterCodeRangeReader()
+   {
+   uintptr_t epoch = _codeRangeEpoch;
+
+   // Threads run on distinct stacks, so the address of a local spreads
+   // concurrent readers over the slots without any thread-local state.
+   //
+   uintptr_t hint = (((uintptr_t) &epoch) >> 12) * (uintptr_t) 0x9E3779B1;
+   for (uintptr_t i = 0; i < CODE_RANGE_READER_SLOTS; ++i)
+      {
+      volatile uintptr_t *slot = &_readerSlots[(hint + i) % CODE_RANGE_READER_SLOTS]._epoch;
+
+      // The atomic claim is a full barrier, so the snapshot is loaded only
+      // after the epoch is visible to writers.
+      //
+      if (*slot == 0 && compareAndSwap(slot, 0, epoch) == 0)
+         return slot;
+      }
+
+   uintptr_t readers = _overflowReaders;
+   while (compareAndSwap(&_overflowReaders, readers, readers + 1) != readers)
+      readers = _overflowReaders;
+
+   return NULL;
+   }
+
+
+// protected
+void
+CodeMetaDataManager::exitCodeRangeReader(volatile uintptr_t *slot)
+   {
+   if (slot)
+      {
+      // Finish reading the snapshot before releasing it to writers
+      //
+      loadBarrier();
+      storeBarrier();
+      *slot = 0;
+      }
+   else
+      {
+      uintptr_t readers = _overflowReaders;
+      while (compareAndSwap(&_overflowReaders, readers, readers - 1) != readers)
+         readers = _overflowReaders;
+      }
+   }
+
+
+// protected
+void
+CodeMetaDataManager::acquireWriterLock()
+   {
+   while (_writerLock != 0 || compareAndSwap(&_writerLock, 0, 1) != 0)
+      yieldProcessor();
+   }
+
+
+// protected
+void
+CodeMetaDataManager::releaseWriterLock()
+   {
+   storeBarrier();
+   _writerLock = 0;
    }
 
 
@@ -60,6 +60,11 @@ namespace OMR
  *
  * The CodeMetaDataManager only manages pointers; It takes no ownership of the
  * POD pointers provided to it.
+ *
+ * Insertions and removals are serialized by a writer lock.  PC lookups take
+ * no lock: every change republishes an immutable sorted array of code ranges
+ * (read-copy-update), and replaced arrays are freed only once every reader
+ * that could have seen them has finished.
  */
 class OMR_EXTENSIBLE CodeMetaDataManager
    {
@@ -85,6 +90,9 @@ class OMR_EXTENSIBLE CodeMetaDataManager
     * co-exist on top of each other, which is inherently incorrect.  If the
     * possiblity occurs that two metadata may legitimately have range values that
     * overlap, checks will need to be added.
+    *
+    * A method whose cold code was split off is registered for both its
+    * [startPC, endPC) and [startColdPC, endColdPC) ranges.
 
     * @param metaData The MetaDataPOD to insert into the metadata.
     * @return Returns true if successful, and false otherwise.
@@ -121,10 +129,11 @@ class OMR_EXTENSIBLE CodeMetaDataManager
 
    /**
     * @brief Attempts to find a registered metadata for a given metadata's startPC.
-    * 
-    * Note: findMetaDataForPC does not locally acquire the JIT metadata monitor.
-    * Users must first manually acquire the monitor or go through another function
-    * that does.
+    *
+    * findMetaDataForPC never blocks and may be called by any number of threads
+    * concurrently with insertMetaData and removeMetaData.  It binary searches
+    * the most recently published snapshot of code ranges; a metadata being
+    * inserted or removed at the same time is either seen in full or not at all.
     *
     * @param pc The PC for which we require the JIT metadata .
     * @return If an metadata for a given startPC is successfully found, returns
@@ -232,12 +241,79 @@ class OMR_EXTENSIBLE CodeMetaDataManager
 
    J9AVLTree *allocateMetaDataAVL();
 
+   /**
+    * A code range published to lock-free readers.  A NULL _metaData marks a
+    * range that has been removed but not yet compacted out of its snapshot.
+    */
+   struct CodeRange
+      {
+      uintptr_t _startPC;
+      uintptr_t _endPC;
+      TR::MethodMetaDataPOD * volatile _metaData;
+      };
+
+   /**
+    * An array of code ranges sorted by startPC.  Once published a snapshot is
+    * never resized: writers build a modified copy, publish it, and retire the
+    * old snapshot until no reader can still be searching it.
+    */
+   struct CodeRangeSnapshot
+      {
+      uintptr_t _numRanges;
+      uintptr_t _retireEpoch;
+      CodeRangeSnapshot *_nextRetired;
+      CodeRange _ranges[1];
+      };
+
+   enum
+      {
+      CODE_RANGE_READER_SLOTS = 64,
+      CODE_RANGE_SLOT_BYTES = 64
+      };
+
+   /**
+    * A reader announces the epoch it started in by claiming a slot.  Slots
+    * are padded to a cache line so concurrent readers do not share one.
+    */
+   struct CodeRangeReaderSlot
+      {
+      volatile uintptr_t _epoch;
+      uint8_t _padding[CODE_RANGE_SLOT_BYTES - sizeof(uintptr_t)];
+      };
+
+   static const CodeRange *findCodeRange(const CodeRangeSnapshot *snapshot, uintptr_t pc);
+
+   CodeRangeSnapshot *allocateCodeRangeSnapshot(uintptr_t numRanges);
+
+   bool publishInsertedRange(TR::MethodMetaDataPOD *metaData, uintptr_t startPC, uintptr_t endPC);
+
+   void publishRemovedRange(const TR::MethodMetaDataPOD *metaData, uintptr_t startPC);
+
+   void publishCodeRanges(CodeRangeSnapshot *snapshot);
+
+   void reclaimCodeRangeSnapshots();
+
+   volatile uintptr_t *enterCodeRangeReader();
+
+   void exitCodeRangeReader(volatile uintptr_t *slot);
+
+   void acquireWriterLock();
+
+   void releaseWriterLock();
+
    // Singleton: Protected to allow manipulation of singleton pointer 
    // in test cases. 
    static TR::CodeMetaDataManager *_codeMetaDataManager;
 
    J9AVLTree *_metaDataAVL;
 
+   CodeRangeSnapshot * volatile _codeRanges;
+   CodeRangeSnapshot *_retiredCodeRanges;
+   volatile uintptr_t _codeRangeEpoch;
+   volatile uintptr_t _overflowReaders;
+   volatile uintptr_t _writerLock;
+   CodeRangeReaderSlot _readerSlots[CODE_RANGE_READER_SLOTS];
+
    private:
 
    mutable uintptr_t _cachedPC;
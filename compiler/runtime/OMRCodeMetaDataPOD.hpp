@@ -49,6 +49,8 @@ struct OMR_EXTENSIBLE MethodMetaDataPOD
    {
    uintptr_t startPC;
    uintptr_t endPC;
+   uintptr_t startColdPC; // cold code split off from the method, or 0 if none
+   uintptr_t endColdPC;
    };
 
 }
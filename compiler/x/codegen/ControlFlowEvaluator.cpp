@@ -1358,6 +1358,59 @@ TR::Register *OMR::X86::TreeEvaluator::iselectEvaluator(TR::Node *node, TR::Code
    return trueReg;
    }
 
+// Matches the bit tests the switch analyzer emits for clusters of case values
+//
+//    if[i|l]cmp[eq|ne]
+//       [i|l]and
+//          [i|l]shl
+//             [i|l]const 1
+//             index
+//          mask
+//       [i|l]const 0
+//
+// and generates BT mask, index instead of materializing the shifted bit. The
+// tested bit is left in the carry flag.
+//
+static bool generateBitTestForCompareToZero(TR::Node *node, TR::CodeGenerator *cg)
+   {
+   TR::Node *andNode = node->getFirstChild();
+   TR::Node *zeroNode = node->getSecondChild();
+
+   if ((andNode->getOpCodeValue() != TR::iand && andNode->getOpCodeValue() != TR::land) ||
+       andNode->getRegister() != NULL ||
+       andNode->getReferenceCount() != 1 ||
+       !zeroNode->getOpCode().isLoadConst() ||
+       zeroNode->getRegister() != NULL ||
+       zeroNode->get64bitIntegralValue() != 0 ||
+       node->isTheVirtualGuardForAGuardedInlinedCall())
+      return false;
+
+   TR::Node *shiftNode = andNode->getFirstChild();
+   TR::Node *maskNode = andNode->getSecondChild();
+
+   if (!shiftNode->getOpCode().isLeftShift() ||
+       shiftNode->getRegister() != NULL ||
+       shiftNode->getReferenceCount() != 1 ||
+       !shiftNode->getFirstChild()->getOpCode().isLoadConst() ||
+       shiftNode->getFirstChild()->get64bitIntegralValue() != 1)
+      return false;
+
+   bool is64Bit = TR::TreeEvaluator::getNodeIs64Bit(andNode, cg);
+   if (is64Bit && !cg->comp()->target().is64Bit())
+      return false;
+
+   if (!performTransformation(cg->comp(), "O^O BIT TEST: generating BT for bit test node %p\n", node))
+      return false;
+
+   TR::Register *maskReg = cg->evaluate(maskNode);
+   TR::Register *indexReg = cg->evaluate(shiftNode->getSecondChild());
+   generateRegRegInstruction(TR::InstOpCode::BTRegReg(is64Bit), node, maskReg, indexReg, cg);
+
+   cg->recursivelyDecReferenceCount(andNode);
+   cg->recursivelyDecReferenceCount(zeroNode);
+   return true;
+   }
+
 TR::Register *OMR::X86::TreeEvaluator::integerIfCmpeqEvaluator(TR::Node *node, TR::CodeGenerator *cg)
    {
 #ifdef J9_PROJECT_SPECIFIC
@@ -1396,6 +1449,13 @@ TR::Register *OMR::X86::TreeEvaluator::integerIfCmpeqEvaluator(TR::Node *node, T
       cg->evaluate(firstChild);
       }
 
+   if (generateBitTestForCompareToZero(node, cg))
+      {
+      // bit clear
+      generateConditionalJumpInstruction(TR::InstOpCode::JAE4, node, cg, true);
+      return NULL;
+      }
+
    TR::TreeEvaluator::compareIntegersForEquality(node, cg);
 
    generateConditionalJumpInstruction(TR::InstOpCode::JE4, node, cg, true);
@@ -1470,6 +1530,13 @@ TR::Register *OMR::X86::TreeEvaluator::integerIfCmpneEvaluator(TR::Node *node, T
          cg->evaluate(firstChild);
          }
 
+      if (generateBitTestForCompareToZero(node, cg))
+         {
+         // bit set
+         generateConditionalJumpInstruction(TR::InstOpCode::JB4, node, cg, true);
+         return NULL;
+         }
+
      if ( node->getFirstChild()->getOpCodeValue() == TR::ishr &&
             node->getFirstChild()->getRegister() == NULL &&
             node->getFirstChild()->getReferenceCount() == 1 &&
@@ -42,6 +42,7 @@ class X86DataSnippet : public TR::Snippet
    virtual size_t                 getDataSize() const                      { return _data.size(); }
    virtual uint32_t               getLength(int32_t estimatedSnippetStart) { return static_cast<uint32_t>(getDataSize()); }
    virtual bool                   setClassAddress(bool isClassAddress)     { return _isClassAddress = isClassAddress;}
+   bool                           isClassAddress()                         { return _isClassAddress; }
    template <typename T> inline T getData()                                { return *((T*)getRawData()); }
 
    virtual uint8_t*               emitSnippetBody();
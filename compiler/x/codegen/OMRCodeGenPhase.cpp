@@ -0,0 +1,75 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "codegen/CodeGenPhase.hpp"
+
+#include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/IO.hpp"
+#include "ras/Debug.hpp"
+#include "x/codegen/X86InstructionScheduler.hpp"
+
+void
+OMR::X86::CodeGenPhase::performInstructionSchedulingPhase(TR::CodeGenerator * cg, TR::CodeGenPhase * phase)
+   {
+   TR::Compilation* comp = cg->comp();
+
+   if (comp->getOption(TR_DisableInstructionScheduling) || comp->getOptLevel() < warm)
+      return;
+
+   phase->reportPhase(InstructionSchedulingPhase);
+
+   TR::LexicalMemProfiler mp(phase->getName(), comp->phaseMemProfiler());
+   LexicalTimer pt(phase->getName(), comp->phaseTimer());
+
+   TR_X86InstructionScheduler scheduler(cg);
+   bool performed = scheduler.perform();
+
+   if (performed && comp->getOption(TR_TraceCG))
+      comp->getDebug()->dumpMethodInstrs(comp->getOutFile(), "Post Instruction Scheduling Instructions", false);
+   }
+
+int
+OMR::X86::CodeGenPhase::getNumPhases()
+   {
+   return static_cast<int>(TR::CodeGenPhase::LastOMRX86Phase);
+   }
+
+const char *
+OMR::X86::CodeGenPhase::getName()
+   {
+   return TR::CodeGenPhase::getName(_currentPhase);
+   }
+
+const char *
+OMR::X86::CodeGenPhase::getName(PhaseValue phase)
+   {
+   switch (phase)
+      {
+      case InstructionSchedulingPhase:
+         return "InstructionSchedulingPhase";
+      default:
+         // call parent class for common phases
+         return OMR::CodeGenPhase::getName(phase);
+      }
+   }
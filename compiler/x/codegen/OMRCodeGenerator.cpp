@@ -92,10 +92,12 @@
 #include "optimizer/RegisterCandidate.hpp"
 #include "ras/Debug.hpp"
 #include "ras/DebugCounter.hpp"
+#include "runtime/CodeCache.hpp"
 #include "runtime/CodeCacheManager.hpp"
 #include "x/codegen/DataSnippet.hpp"
 #include "x/codegen/OutlinedInstructions.hpp"
 #include "x/codegen/FPTreeEvaluator.hpp"
+#include "x/codegen/X86RegisterPreferences.hpp"
 #include "x/codegen/X86Instruction.hpp"
 #include "codegen/InstOpCode.hpp"
 
@@ -1041,13 +1043,14 @@ OMR::X86::CodeGenerator::getSupportsOpCodeForAutoSIMD(TR::ILOpCode opcode, TR::D
        * GRA does not work with vector registers on 64 bit either.
        * getvelem is now being disabled on 64 bit for the same reasons as 32 bit.
        * This code will be reenabled as part of Issue 2280
+       *
+       * While vector registers are not globally allocated at all the bug cannot be hit, so getvelem
+       * is allowed in that configuration to let the loop vectorizer fold its reduction accumulators.
        */
       case TR::getvelem:
-#if 0
-         if (self()->comp()->target().is64Bit() && (dt == TR::Int32 || dt == TR::Int64 || dt == TR::Float || dt == TR::Double))
+         if (!self()->hasGlobalVRF() && self()->comp()->target().is64Bit() && (dt == TR::Int32 || dt == TR::Int64 || dt == TR::Float || dt == TR::Double))
             return true;
          else
-#endif //closes the if 0
             return false;
       default:
          return false;
@@ -1056,6 +1059,31 @@ OMR::X86::CodeGenerator::getSupportsOpCodeForAutoSIMD(TR::ILOpCode opcode, TR::D
    return false;
    }
 
+bool
+OMR::X86::CodeGenerator::getSupportsVectorLengthForAutoSIMD(TR::VectorLength length, TR::ILOpCode opcode, TR::DataType elementType)
+   {
+   if (!self()->getSupportsOpCodeForAutoSIMD(opcode, elementType))
+      return false;
+
+   /*
+    * 256-bit vectors are encoded with VEX and need AVX2 for the integer operations,
+    * 512-bit vectors are encoded with EVEX and need AVX-512BW for byte and word elements.
+    */
+   switch (length)
+      {
+      case TR::VectorLength128:
+         return true;
+      case TR::VectorLength256:
+         return self()->comp()->target().cpu.supportsAVX2();
+      case TR::VectorLength512:
+         if (elementType == TR::Int8 || elementType == TR::Int16)
+            return self()->comp()->target().cpu.supportsAVX512BW();
+         return self()->comp()->target().cpu.supportsAVX512F();
+      default:
+         return false;
+      }
+   }
+
 
 bool
 OMR::X86::CodeGenerator::getSupportsEncodeUtf16LittleWithSurrogateTest()
@@ -1079,6 +1107,12 @@ OMR::X86::CodeGenerator::getSupportsBitPermute()
    return true;
    }
 
+int32_t
+OMR::X86::CodeGenerator::getSwitchBitTestWidth()
+   {
+   return self()->comp()->target().is64Bit() ? 64 : 32;
+   }
+
 bool
 OMR::X86::CodeGenerator::supportsNonHelper(TR::SymbolReferenceTable::CommonNonhelperSymbol symbol)
    {
@@ -1599,10 +1633,18 @@ void OMR::X86::CodeGenerator::doRegisterAssignment(TR_RegisterKinds kindsToAssig
       diagnostic("\n\nGP Register Assignment (backward pass):\n");
 #endif
 
+   // Choose preferred registers for whole live ranges before the local assigner runs
+   //
+   kindsToAssign = TR_RegisterKinds(kindsToAssign & (TR_GPR_Mask | TR_FPR_Mask | TR_VRF_Mask));
+   if (kindsToAssign && self()->comp()->getOption(TR_EnableRegisterPreferences) && self()->comp()->target().is64Bit())
+      {
+      TR_X86RegisterPreferences preferences(self());
+      preferences.perform(kindsToAssign);
+      }
+
    LexicalTimer pt2("GP register assignment", self()->comp()->phaseTimer());
    // Assign GPRs and XMMRs in a backward pass
    //
-   kindsToAssign = TR_RegisterKinds(kindsToAssign & (TR_GPR_Mask | TR_FPR_Mask | TR_VRF_Mask));
    if (kindsToAssign)
       {
       self()->getVMThreadRegister()->setFutureUseCount(self()->getVMThreadRegister()->getTotalUseCount());
@@ -1642,10 +1684,89 @@ struct DescendingSortX86DataSnippetByDataSize
       return a->getDataSize() > b->getDataSize();
       }
    };
+// Distance between the warm and cold instructions during length estimation, large
+// enough that every branch between the two is estimated at its long form
+//
+#define COLD_CODE_ESTIMATE_GAP (1 << 20)
+
+static bool
+blockNeedsGCMap(TR::Block *block)
+   {
+   TR::Instruction *last = block->getLastInstruction();
+   for (TR::Instruction *instr = block->getFirstInstruction(); instr; instr = instr->getNext())
+      {
+      if (instr->needsGCMap())
+         return true;
+      if (instr == last)
+         break;
+      }
+   return false;
+   }
+
+// Returns the first instruction of the trailing run of cold blocks that can be
+// placed in the cold area of the code cache, or NULL if there is none. The run
+// must begin after a block that does not fall through into it, and it excludes
+// blocks with exception successors, catch blocks and blocks with GC maps since
+// the stack maps and exception tables only describe the warm area.
+//
+static TR::Instruction *
+findColdCodeBoundary(TR::CodeGenerator *cg)
+   {
+   TR::Compilation *comp = cg->comp();
+   if (comp->compileRelocatableCode() ||
+       comp->getOption(TR_EmitExecutableELFFile) ||
+       comp->recordsStaticRelocations())
+      return NULL;
+
+   TR::Block *firstCold = NULL;
+   TR::Block *block = comp->getMethodSymbol()->getLastTreeTop()->getNode()->getBlock();
+   while (block &&
+          block != comp->getStartBlock() &&
+          block->isCold() &&
+          !block->isCatchBlock() &&
+          block->getExceptionSuccessors().empty() &&
+          !blockNeedsGCMap(block))
+      {
+      firstCold = block;
+      block = block->getPrevBlock();
+      }
+
+   while (firstCold &&
+          (firstCold->isExtensionOfPreviousBlock() || firstCold->getPrevBlock()->canFallThroughToNextBlock()))
+      firstCold = firstCold->getNextBlock();
+
+   return firstCold ? firstCold->getFirstInstruction() : NULL;
+   }
+
+// Legacy SSE code runs slowly while the upper halves of the YMM/ZMM registers
+// are dirty, so a method that uses 256 or 512-bit vectors clears them before
+// every call and return. Code generated here is VEX encoded when AVX is
+// available, so these are the only transitions. No vector is live across a
+// call or returned, so VZEROUPPER loses nothing.
+//
+void OMR::X86::CodeGenerator::insertVZeroUpperInstructions()
+   {
+   TR::Instruction *instr = self()->getFirstInstruction();
+   while (instr && !instr->getOpCode().isWideVectorOp())
+      instr = instr->getNext();
+
+   if (!instr)
+      return;
+
+   for (instr = self()->getFirstInstruction(); instr; instr = instr->getNext())
+      {
+      if ((instr->getOpCode().isCallOp() || self()->isReturnInstruction(instr)) &&
+          instr->getPrev()->getOpCodeValue() != TR::InstOpCode::VZEROUPPER)
+         generateInstruction(instr->getPrev(), TR::InstOpCode::VZEROUPPER, self());
+      }
+   }
+
 void OMR::X86::CodeGenerator::doBinaryEncoding()
    {
    LexicalTimer pt1("code generation", self()->comp()->phaseTimer());
 
+   self()->insertVZeroUpperInstructions();
+
    // Generate fixup code for the interpreter entry point right before TR::InstOpCode::proc
    //
    TR::Instruction * procEntryInstruction = self()->getFirstInstruction();
@@ -1712,6 +1833,14 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
    TR::Instruction * estimateCursor = self()->getFirstInstruction();
    int32_t estimate = 0;
 
+   // Trailing cold blocks are estimated as if they were far beyond the warm code
+   // and are encoded into the cold area of the code cache
+   //
+   TR::Instruction * coldBoundary = NULL;
+   if (self()->comp()->getOption(TR_EnableColdCodeSplitting))
+      coldBoundary = findColdCodeBoundary(self());
+   int32_t warmEstimate = -1;
+
    // Estimate the binary length up to TR::InstOpCode::proc
    //
    while (estimateCursor && estimateCursor->getOpCodeValue() != TR::InstOpCode::proc)
@@ -1769,6 +1898,12 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
    int32_t estimatedPrologueStartOffset = estimate;
    while (estimateCursor)
       {
+      if (estimateCursor == coldBoundary)
+         {
+         warmEstimate = estimate;
+         estimate = warmEstimate + COLD_CODE_ESTIMATE_GAP;
+         }
+
       // Update the info bits on the register mask.
       //
       if (estimateCursor->needsGCMap())
@@ -1860,6 +1995,17 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
    if (self()->comp()->getOption(TR_TraceCG))
       traceMsg(self()->comp(), "\n</instructions>\n");
 
+   int32_t coldEstimate = 0;
+   if (warmEstimate >= 0)
+      {
+      coldEstimate = estimate - (warmEstimate + COLD_CODE_ESTIMATE_GAP);
+      estimate = warmEstimate;
+      }
+   else
+      {
+      coldBoundary = NULL;
+      }
+
    estimate = self()->setEstimatedLocationsForSnippetLabels(estimate);
    // When using copyBinaryToBuffer() to copy the encoding of an instruction we
    // indiscriminatelly copy a whole integer, even if the size of the encoding
@@ -1887,9 +2033,31 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
       }
 
    uint8_t * coldCode = NULL;
-   uint8_t * temp = self()->allocateCodeMemory(self()->getEstimatedCodeLength(), 0, &coldCode);
+   uint8_t * temp = self()->allocateCodeMemory(self()->getEstimatedCodeLength(), coldBoundary ? coldEstimate + OVER_ESTIMATION : 0, &coldCode);
    TR_ASSERT(temp, "Failed to allocate primary code area.");
 
+   if (coldBoundary)
+      {
+      // Record the cold area now so that it is freed with the warm code if
+      // the compilation fails before the encoding is done
+      //
+      self()->setColdCodeRange(coldCode, coldCode);
+
+      // Forward branches compute their distance from the estimated location of the
+      // label relative to the buffer start, so move the estimates of the cold labels
+      // to where the cold code actually goes.
+      //
+      int32_t shift = static_cast<int32_t>(coldCode - temp - 4) - (warmEstimate + COLD_CODE_ESTIMATE_GAP);
+      for (TR::Instruction *instr = coldBoundary; instr; instr = instr->getNext())
+         {
+         if (instr->getOpCodeValue() == TR::InstOpCode::label)
+            instr->getLabelSymbol()->setEstimatedCodeLocation(instr->getLabelSymbol()->getEstimatedCodeLocation() + shift);
+         }
+
+      if (self()->comp()->getOption(TR_TraceCG))
+         traceMsg(self()->comp(), "Encoding %d estimated bytes of cold code at %p\n", coldEstimate, coldCode);
+      }
+
    if (self()->comp()->target().is64Bit() && self()->hasCodeCacheSwitched() && self()->getPicSlotCount() != 0)
       {
       int32_t numTrampolinesToReserve = self()->getPicSlotCount() - self()->getNumReservedIPICTrampolines();
@@ -1920,8 +2088,18 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
 
    // Generate binary for the rest of the instructions
    //
+   uint8_t * warmCursor = NULL;
+   int32_t warmLengthError = 0;
    while (cursorInstruction)
       {
+      if (cursorInstruction == coldBoundary)
+         {
+         warmCursor = self()->getBinaryBufferCursor();
+         warmLengthError = self()->getAccumulatedInstructionLengthError();
+         self()->setBinaryBufferCursor(coldCode);
+         self()->setAccumulatedInstructionLengthError(0);
+         }
+
       uint8_t * const instructionStart = self()->getBinaryBufferCursor();
       self()->setBinaryBufferCursor(cursorInstruction->generateBinaryEncoding());
       TR_ASSERT(cursorInstruction->getEstimatedBinaryLength() >= self()->getBinaryBufferCursor() - instructionStart,
@@ -1945,6 +2123,15 @@ void OMR::X86::CodeGenerator::doBinaryEncoding()
       cursorInstruction = cursorInstruction->getNext();
       }
 
+   // Snippets follow the warm code
+   //
+   if (coldBoundary)
+      {
+      self()->setColdCodeRange(coldCode, self()->getBinaryBufferCursor());
+      self()->setBinaryBufferCursor(warmCursor);
+      self()->setAccumulatedInstructionLengthError(warmLengthError);
+      }
+
    // Create exception table entries for outlined instructions.
    //
    for(auto oiIterator = self()->getOutlinedInstructionsList().begin(); oiIterator != self()->getOutlinedInstructionsList().end(); ++oiIterator)
@@ -2169,11 +2356,45 @@ int32_t OMR::X86::CodeGenerator::setEstimatedLocationsForDataSnippetLabels(int32
    return estimatedSnippetStart;
    }
 
+// Constants can be shared through the literal pool of the code cache when the
+// code is not relocated and every instruction can reach the pool RIP-relatively
+//
+static bool
+canUseCodeCacheLiteralPool(TR::CodeGenerator *cg)
+   {
+   TR::Compilation *comp = cg->comp();
+   if (!comp->target().is64Bit() ||
+       comp->getOption(TR_DisableCodeCacheLiteralPool) ||
+       comp->compileRelocatableCode() ||
+       comp->getOption(TR_EmitExecutableELFFile) ||
+       comp->recordsStaticRelocations())
+      return false;
+
+   TR::CodeCache *codeCache = cg->getCodeCache();
+   return codeCache && codeCache->getCodeTop() - codeCache->getCodeBase() <= INT_MAX;
+   }
+
 void OMR::X86::CodeGenerator::emitDataSnippets()
    {
+   bool useLiteralPool = canUseCodeCacheLiteralPool(self());
    for (auto iterator = _dataSnippetList.begin(); iterator != _dataSnippetList.end(); ++iterator)
       {
-      self()->setBinaryBufferCursor((*iterator)->emitSnippetBody());
+      TR::X86DataSnippet *snippet = *iterator;
+      if (useLiteralPool &&
+          snippet->getKind() == TR::Snippet::IsConstantData &&
+          !snippet->isClassAddress())
+         {
+         uint8_t *literal = self()->getCodeCache()->findOrAddLiteral(snippet->getRawData(), snippet->getDataSize());
+         if (literal)
+            {
+            snippet->getSnippetLabel()->setCodeLocation(literal);
+            if (self()->comp()->getOption(TR_TraceCG))
+               traceMsg(self()->comp(), "%s is in the code cache literal pool at %p\n", self()->getDebug()->getName(snippet), literal);
+            continue;
+            }
+         }
+
+      self()->setBinaryBufferCursor(snippet->emitSnippetBody());
       }
    }
 
@@ -161,6 +161,10 @@ struct TR_X86ProcessorInfo
    bool supportsSSE4_2()                   {return testFeatureFlags2(TR_SSE4_2);}
    bool supportsAVX()                      {return testFeatureFlags2(TR_AVX) && enabledXSAVE();}
    bool supportsAVX2()                     {return testFeatureFlags8(TR_AVX2) && enabledXSAVE();}
+   bool supportsAVX512F()                  {return testFeatureFlags8(TR_AVX512F) && enabledXSAVE();}
+   bool supportsAVX512DQ()                 {return testFeatureFlags8(TR_AVX512DQ) && enabledXSAVE();}
+   bool supportsAVX512BW()                 {return testFeatureFlags8(TR_AVX512BW) && enabledXSAVE();}
+   bool supportsAVX512VL()                 {return testFeatureFlags8(TR_AVX512VL) && enabledXSAVE();}
    bool supportsBMI1()                     {return testFeatureFlags8(TR_BMI1) && enabledXSAVE();}
    bool supportsBMI2()                     {return testFeatureFlags8(TR_BMI2) && enabledXSAVE();}
    bool supportsFMA()                      {return testFeatureFlags2(TR_FMA) && enabledXSAVE();}
@@ -354,12 +358,22 @@ class OMR_EXTENSIBLE CodeGenerator : public OMR::CodeGenerator
    void doRegisterAssignment(TR_RegisterKinds kindsToAssign);
    void doBinaryEncoding();
 
+   void insertVZeroUpperInstructions();
+
    void doBackwardsRegisterAssignment(TR_RegisterKinds kindsToAssign, TR::Instruction *startInstruction, TR::Instruction *appendInstruction = NULL);
 
    bool hasComplexAddressingMode() { return true; }
    bool getSupportsBitOpCodes() { return true; }
 
+   // A BT against a mask held in a register is as cheap as a compare, while
+   // the indirect jump through a table is the hardest branch to predict.
+   //
+   int32_t getSwitchJumpTableCost() { return 3 + 3 + 6 + 14; }
+   int32_t getSwitchBitTestCost() { return 1 + 6; }
+   int32_t getSwitchBitTestWidth();
+
    bool getSupportsOpCodeForAutoSIMD(TR::ILOpCode, TR::DataType);
+   bool getSupportsVectorLengthForAutoSIMD(TR::VectorLength length, TR::ILOpCode opcode, TR::DataType elementType);
    bool getSupportsEncodeUtf16LittleWithSurrogateTest();
    bool getSupportsEncodeUtf16BigWithSurrogateTest();
 
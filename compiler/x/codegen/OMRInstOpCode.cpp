@@ -90,7 +90,17 @@ template <typename TBuffer> typename TBuffer::cursor_t OMR::X86::InstOpCode::OpC
    TR::Compilation *comp = TR::comp();
    TR_ASSERT_FATAL(comp->compileRelocatableCode() || comp->isOutOfProcessCompilation() || comp->compilePortableCode() || comp->target().cpu.supportsAVX() == TR::CodeGenerator::getX86ProcessorInfo().supportsAVX(), "supportsAVX() failed\n");
 
-   if (supportsAVX() && comp->target().cpu.supportsAVX())
+   if (isEVEX())
+      {
+      TR_ASSERT_FATAL(comp->compileRelocatableCode() || comp->isOutOfProcessCompilation() || comp->compilePortableCode() || comp->target().cpu.supportsAVX512F(), "EVEX encoded instruction requires AVX-512\n");
+      TR::Instruction::EVEX evex(rex, modrm_opcode);
+      evex.m = escape;
+      evex.L = vex_l;
+      evex.p = prefixes;
+      evex.opcode = opcode;
+      buffer.append(evex);
+      }
+   else if (supportsAVX() && comp->target().cpu.supportsAVX())
       {
       TR::Instruction::VEX<3> vex(rex, modrm_opcode);
       vex.m = escape;
@@ -99,10 +109,22 @@ template <typename TBuffer> typename TBuffer::cursor_t OMR::X86::InstOpCode::OpC
       vex.opcode = opcode;
       if(vex.CanBeShortened())
          {
-         buffer.append(TR::Instruction::VEX<2>(vex));
+         TR::Instruction::VEX<2> vex2(vex);
+         if (modrm_form)
+            {
+            buffer.append(vex2);
+            }
+         else
+            {
+            // Instructions without operands, such as VZEROUPPER, end at the opcode
+            buffer.append(vex2.escape);
+            buffer.append((uint8_t)((vex2.R << 7) | (vex2.v << 3) | (vex2.L << 2) | vex2.p));
+            buffer.append(vex2.opcode);
+            }
          }
       else
          {
+         TR_ASSERT_FATAL(modrm_form, "3-byte VEX encoding without ModRM is not supported");
          buffer.append(vex);
          }
       }
@@ -182,6 +204,15 @@ void OMR::X86::InstOpCode::OpCode_t::finalize(uint8_t* cursor) const
             }
          }
          break;
+      case 0x62:
+         {
+         auto pEVEX = (TR::Instruction::EVEX*)cursor;
+         if (isEVEX() && vex_v == VEX_vReg_)
+            {
+            pEVEX->v = ~(modrm_form == ModRM_EXT_ ? pEVEX->RM() : pEVEX->Reg());
+            }
+         }
+         break;
       default:
          break;
       }
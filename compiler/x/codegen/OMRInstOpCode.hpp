@@ -231,6 +231,11 @@ class InstOpCode: public OMR::InstOpCode
          {
          return vex_l != VEX_L___;
          }
+      // check if the instruction requires EVEX encoding
+      inline bool isEVEX() const
+         {
+         return vex_l == VEX_L512;
+         }
       // check if the instruction is X87
       inline bool isX87() const
          {
@@ -248,7 +253,7 @@ class InstOpCode: public OMR::InstOpCode
          }
       // TBuffer should only be one of the two: Estimator when calculating length, and Writer when generating binaries.
       template <class TBuffer> typename TBuffer::cursor_t encode(typename TBuffer::cursor_t cursor, uint8_t rexbits) const;
-      // finalize instruction prefix information, currently only in-use for AVX instructions for VEX.vvvv field
+      // finalize instruction prefix information, currently only in-use for AVX instructions for VEX.vvvv and EVEX.vvvv fields
       void finalize(uint8_t* cursor) const;
       };
    template <typename TCursor>
@@ -384,6 +389,8 @@ class InstOpCode: public OMR::InstOpCode
    inline uint32_t targetRegIsImplicit()           const { return _properties1[_mnemonic] & IA32OpProp1_TargetRegIsImplicit;}
    inline uint32_t sourceRegIsImplicit()           const { return _properties1[_mnemonic] & IA32OpProp1_SourceRegIsImplicit;}
    inline uint32_t isFusableCompare()              const { return _properties1[_mnemonic] & IA32OpProp1_FusableCompare; }
+   // 256 and 512-bit instructions leave the upper halves of the YMM/ZMM registers dirty
+   inline bool     isWideVectorOp()                const { return info().vex_l == VEX_L256 || info().vex_l == VEX_L512; }
 
    inline bool isSetRegInstruction() const
       {
@@ -554,6 +561,7 @@ class InstOpCode: public OMR::InstOpCode
       TARGET_PARAMETERIZED_OPCODE(ANDRegImm4     , AND8RegImm4     , AND4RegImm4     )
       TARGET_PARAMETERIZED_OPCODE(ANDRegReg      , AND8RegReg      , AND4RegReg      )
       TARGET_PARAMETERIZED_OPCODE(ANDRegImms     , AND8RegImms     , AND4RegImms     )
+      TARGET_PARAMETERIZED_OPCODE(ANDRegMem      , AND8RegMem      , AND4RegMem      )
       TARGET_PARAMETERIZED_OPCODE(ORRegReg       , OR8RegReg       , OR4RegReg       )
       TARGET_PARAMETERIZED_OPCODE(MOVRegImm4     , MOV8RegImm4     , MOV4RegImm4     )
       TARGET_PARAMETERIZED_OPCODE(IMULAccReg     , IMUL8AccReg     , IMUL4AccReg     )
@@ -589,6 +597,12 @@ class InstOpCode: public OMR::InstOpCode
       TARGET_PARAMETERIZED_OPCODE(CMPXCHGMemReg  , CMPXCHG8MemReg  , CMPXCHG4MemReg  )
       TARGET_PARAMETERIZED_OPCODE(LCMPXCHGMemReg , LCMPXCHG8MemReg , LCMPXCHG4MemReg )
       TARGET_PARAMETERIZED_OPCODE(REPSTOS        , REPSTOSQ        , REPSTOSD        )
+      // BMI
+      TARGET_PARAMETERIZED_OPCODE(ANDNRegRegReg  , ANDN8RegRegReg  , ANDN4RegRegReg  )
+      TARGET_PARAMETERIZED_OPCODE(ANDNRegRegMem  , ANDN8RegRegMem  , ANDN4RegRegMem  )
+      TARGET_PARAMETERIZED_OPCODE(SARXRegRegReg  , SARX8RegRegReg  , SARX4RegRegReg  )
+      TARGET_PARAMETERIZED_OPCODE(SHLXRegRegReg  , SHLX8RegRegReg  , SHLX4RegRegReg  )
+      TARGET_PARAMETERIZED_OPCODE(SHRXRegRegReg  , SHRX8RegRegReg  , SHRX4RegRegReg  )
       // Floating-point
       TARGET_PARAMETERIZED_OPCODE(MOVSMemReg     , MOVSDMemReg     , MOVSSMemReg     )
       TARGET_PARAMETERIZED_OPCODE(MOVSRegMem     , MOVSDRegMem     , MOVSSRegMem     )
@@ -658,6 +672,26 @@ class InstOpCode: public OMR::InstOpCode
       SIZE_PARAMETERIZED_OPCODE(IMulRegMemImms , IMUL8RegMemImms , IMUL4RegMemImms , IMUL2RegMemImms , bad         )
       SIZE_PARAMETERIZED_OPCODE(IMulRegMemImm4 , IMUL8RegMemImm4 , IMUL4RegMemImm4 , IMUL2RegMemImm2 , bad         )
 
+#define VECTOR_SIZE_PARAMETERIZED_OPCODE(name, op512, op256, op128)          \
+      static inline OMR::InstOpCode::Mnemonic name(int32_t size = 16)       \
+         {                                                                  \
+         switch (size)                                                      \
+            {                                                               \
+            case 64: return op512;                                          \
+            case 32: return op256;                                          \
+            case 16: return op128;                                          \
+            default:                                                        \
+               TR_ASSERT_FATAL(false, "Unsupported vector size %d", size);  \
+               return OMR::InstOpCode::bad;                                 \
+            }                                                               \
+         }
+
+      // Vector size based opcodes
+      VECTOR_SIZE_PARAMETERIZED_OPCODE(MovVectorRegReg , VMOVDQU64512RegReg , VMOVDQURegReg , MOVDQURegReg )
+      VECTOR_SIZE_PARAMETERIZED_OPCODE(MovVectorRegMem , VMOVDQU64512RegMem , VMOVDQURegMem , MOVDQURegMem )
+      VECTOR_SIZE_PARAMETERIZED_OPCODE(MovVectorMemReg , VMOVDQU64512MemReg , VMOVDQUMemReg , MOVDQUMemReg )
+      VECTOR_SIZE_PARAMETERIZED_OPCODE(XorVectorRegReg , VPXORQ512RegReg    , VPXORRegReg   , XORPDRegReg  )
+
    };
 }
 }
@@ -284,6 +284,7 @@ class OMR_EXTENSIBLE Instruction : public OMR::Instruction
       {
       VEX() {TR_ASSERT(false, "INVALID VEX PREFIX");}
       };
+   struct EVEX;
    };
 
    template<>
@@ -363,6 +364,60 @@ class OMR_EXTENSIBLE Instruction : public OMR::Instruction
          return modrm.RM();
          }
       };
+   // Only xmm0-xmm15 are allocated, so R', V' and the opmask register are never used
+   struct Instruction::EVEX
+      {
+      // Byte 0: 62
+      uint8_t escape;
+      // Byte 1: P0
+      uint8_t m : 2;
+      uint8_t _zero : 2;
+      uint8_t R2 : 1;
+      uint8_t B : 1;
+      uint8_t X : 1;
+      uint8_t R : 1;
+      // Byte 2: P1
+      uint8_t p : 2;
+      uint8_t _one : 1;
+      uint8_t v : 4;
+      uint8_t W : 1;
+      // Byte 3: P2
+      uint8_t a : 3;
+      uint8_t V2 : 1;
+      uint8_t b : 1;
+      uint8_t L : 2;
+      uint8_t z : 1;
+      // Byte 4: opcode
+      uint8_t opcode;
+      // Byte 5: ModRM
+      ModRM   modrm;
+
+      inline EVEX() {}
+      inline EVEX(const REX& rex, uint8_t ModRMOpCode) : modrm(ModRMOpCode)
+         {
+         escape = '\x62';
+         _zero = 0;
+         R2 = 1;
+         R = ~rex.R;
+         X = ~rex.X;
+         B = ~rex.B;
+         _one = 1;
+         v = 0xf; //0b1111
+         W = rex.W;
+         a = 0;
+         V2 = 1;
+         b = 0;
+         z = 0;
+         }
+      inline uint8_t Reg() const
+         {
+         return modrm.Reg(~R);
+         }
+      inline uint8_t RM() const
+         {
+         return modrm.RM(~B);
+         }
+      };
 }
 
 }
@@ -58,9 +58,11 @@
 #include "infra/Assert.hpp"
 #include "infra/List.hpp"
 #include "ras/Debug.hpp"
+#include "ras/DebugCounter.hpp"
 #include "x/codegen/OutlinedInstructions.hpp"
 #include "codegen/X86Instruction.hpp"
 #include "codegen/InstOpCode.hpp"
+#include "x/codegen/X86RegisterPreferences.hpp"
 #include "x/codegen/X86Register.hpp"
 
 extern bool existsNextInstructionToTestFlags(TR::Instruction *startInstr,
@@ -264,6 +266,22 @@ OMR::X86::Machine::findBestFreeGPRegister(TR::Instruction   *currentInstruction,
          }
       }
 
+   // Use the register preferred for this point of the live range if it is free
+   //
+   if (virtReg->getLiveInterval())
+      {
+      TR::RealRegister::RegNum preferred = TR_X86RegisterPreferences::getPreferredRegister(virtReg, currentInstruction);
+      if (preferred != TR::RealRegister::NoReg &&
+          (requestedRegSize != TR_ByteReg || preferred <= TR::RealRegister::Last8BitGPR) &&
+          _registerFile[preferred]->getState() != TR::RealRegister::Locked &&
+          ((_registerFile[preferred]->getAssignedRegister() == NULL && _registerFile[preferred]->getState() != TR::RealRegister::Blocked) ||
+           (considerUnlatched && _registerFile[preferred]->getState() == TR::RealRegister::Unlatched)))
+         {
+         self()->cg()->setRegisterAssignmentFlag(TR_ByColouring);
+         return _registerFile[preferred];
+         }
+      }
+
    switch (requestedRegSize)
       {
       case TR_ByteReg:
@@ -859,7 +877,7 @@ TR::RealRegister *OMR::X86::Machine::freeBestGPRegister(TR::Instruction
             }
          else
             {
-            location = self()->cg()->allocateSpill(16, false, &offset);
+            location = self()->cg()->allocateSpill(TR::DataType::getVectorSize(bestRegister->getVectorLength()), false, &offset);
             }
          }
       else
@@ -928,7 +946,7 @@ TR::RealRegister *OMR::X86::Machine::freeBestGPRegister(TR::Instruction
          }
       else if (bestRegister->getKind() == TR_VRF)
          {
-         op = TR::InstOpCode::MOVDQURegMem;
+         op = TR::InstOpCode::MovVectorRegMem(TR::DataType::getVectorSize(bestRegister->getVectorLength()));
          }
       else
          {
@@ -936,6 +954,10 @@ TR::RealRegister *OMR::X86::Machine::freeBestGPRegister(TR::Instruction
          }
       instr = new (self()->cg()->trHeapMemory()) TR::X86RegMemInstruction(currentInstruction, op, best, tempMR, self()->cg());
 
+      if (self()->cg()->comp()->getOptions()->enableDebugCounters())
+         TR::DebugCounter::incStaticDebugCounter(self()->cg()->comp(),
+            self()->cg()->comp()->getOption(TR_EnableRegisterPreferences) ? "registerAssignment/spills/withPreferences" : "registerAssignment/spills/local");
+
       self()->cg()->traceRegFreed(bestRegister, best);
       self()->cg()->traceRAInstruction(instr);
       }
@@ -1043,7 +1065,7 @@ TR::RealRegister *OMR::X86::Machine::reverseGPRSpillState(TR::Instruction     *c
       instr = new (self()->cg()->trHeapMemory())
          TR::X86MemRegInstruction(
             currentInstruction,
-            TR::InstOpCode::MOVDQUMemReg,
+            TR::InstOpCode::MovVectorMemReg(TR::DataType::getVectorSize(spilledRegister->getVectorLength())),
             tempMR,
             targetRegister, self()->cg());
 
@@ -1051,7 +1073,7 @@ TR::RealRegister *OMR::X86::Machine::reverseGPRSpillState(TR::Instruction     *c
       // This is to enforce re-use of the same spill slot for a virtual register
       // while assigning non-linear control flow regions.
       //
-      self()->cg()->freeSpill(location, 16, 0);
+      self()->cg()->freeSpill(location, TR::DataType::getVectorSize(spilledRegister->getVectorLength()), 0);
       if (!self()->cg()->isFreeSpillListLocked())
          {
          spilledRegister->setBackingStorage(NULL);
@@ -1216,7 +1238,7 @@ void OMR::X86::Machine::coerceXMMRegisterAssignment(TR::Instruction          *cu
          if (virtualRegister->getKind() == TR_VRF)
             {
             instr = new (self()->cg()->trHeapMemory()) TR::X86RegRegInstruction(currentInstruction,
-                                                TR::InstOpCode::MOVDQURegReg,
+                                                TR::InstOpCode::MovVectorRegReg(TR::DataType::getVectorSize(virtualRegister->getVectorLength())),
                                                 currentAssignedRegister,
                                                 targetRegister, self()->cg());
             }
@@ -1257,6 +1279,13 @@ void OMR::X86::Machine::coerceXMMRegisterAssignment(TR::Instruction          *cu
             {
             xchgOp = TR::InstOpCode::XORPSRegReg;
             }
+         else if (virtualRegister->getKind() == TR_VRF &&
+                  std::max(virtualRegister->getVectorLength(), currentTargetVirtual->getVectorLength()) != TR::VectorLength128)
+            {
+            // Swap the full width of the wider of the two vectors
+            //
+            xchgOp = TR::InstOpCode::XorVectorRegReg(TR::DataType::getVectorSize(std::max(virtualRegister->getVectorLength(), currentTargetVirtual->getVectorLength())));
+            }
          else //virtualRegister->getKind() == TR_VRF || (virtualRegister->getKind() == TR_FPR && !virtualRegister->isSinglePrecision())
             {
             xchgOp = TR::InstOpCode::XORPDRegReg;
@@ -1294,7 +1323,7 @@ void OMR::X86::Machine::coerceXMMRegisterAssignment(TR::Instruction          *cu
             {
             if (virtualRegister->getKind() == TR_VRF)
                {
-               instr = new (self()->cg()->trHeapMemory()) TR::X86RegRegInstruction(currentInstruction, TR::InstOpCode::MOVDQURegReg, targetRegister, candidate, self()->cg());
+               instr = new (self()->cg()->trHeapMemory()) TR::X86RegRegInstruction(currentInstruction, TR::InstOpCode::MovVectorRegReg(TR::DataType::getVectorSize(currentTargetVirtual->getVectorLength())), targetRegister, candidate, self()->cg());
                }
             else if (currentTargetVirtual->isSinglePrecision())
                {
@@ -1335,6 +1364,13 @@ void OMR::X86::Machine::coerceXMMRegisterAssignment(TR::Instruction          *cu
             {
             xchgOp = TR::InstOpCode::XORPSRegReg;
             }
+         else if (virtualRegister->getKind() == TR_VRF &&
+                  std::max(virtualRegister->getVectorLength(), currentTargetVirtual->getVectorLength()) != TR::VectorLength128)
+            {
+            // Swap the full width of the wider of the two vectors
+            //
+            xchgOp = TR::InstOpCode::XorVectorRegReg(TR::DataType::getVectorSize(std::max(virtualRegister->getVectorLength(), currentTargetVirtual->getVectorLength())));
+            }
          else //virtualRegister->getKind() == TR_VRF || (virtualRegister->getKind() == TR_FPR && !virtualRegister->isSinglePrecision())
             {
             xchgOp = TR::InstOpCode::XORPDRegReg;
@@ -1371,7 +1407,7 @@ void OMR::X86::Machine::coerceXMMRegisterAssignment(TR::Instruction          *cu
             {
             if (virtualRegister->getKind() == TR_VRF)
                {
-               instr = new (self()->cg()->trHeapMemory()) TR::X86RegRegInstruction(currentInstruction, TR::InstOpCode::MOVDQURegReg, targetRegister, candidate, self()->cg());
+               instr = new (self()->cg()->trHeapMemory()) TR::X86RegRegInstruction(currentInstruction, TR::InstOpCode::MovVectorRegReg(TR::DataType::getVectorSize(currentTargetVirtual->getVectorLength())), targetRegister, candidate, self()->cg());
                }
             else if (currentTargetVirtual->isSinglePrecision())
                {
@@ -2208,7 +2244,7 @@ void OMR::X86::Machine::disassociateUnspilledBackingStorage()
                }
             else if (virtReg->getKind() == TR_VRF)
                {
-               size = 16;
+               size = TR::DataType::getVectorSize(virtReg->getVectorLength());
                }
             else
                {
@@ -473,6 +473,13 @@ OMR::X86::MemoryReference::useRegisters(
       {
       instr->useRegister(_indexRegister);
       }
+
+   // EVEX scales 8-bit displacements by the memory operand size
+   //
+   if (instr->getOpCode().info().isEVEX())
+      {
+      self()->setForceWideDisplacement();
+      }
    }
 
 
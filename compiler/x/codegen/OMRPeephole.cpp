@@ -0,0 +1,684 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "codegen/Peephole.hpp"
+
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/CodeGenerator_inlines.hpp"
+#include "codegen/Instruction.hpp"
+#include "codegen/MemoryReference.hpp"
+#include "codegen/RealRegister.hpp"
+#include "codegen/X86Instruction.hpp"
+#include "env/jittypes.h"
+#include "il/LabelSymbol.hpp"
+#include "il/Symbol.hpp"
+
+/// The number of instructions searched when proving that the flags set by an instruction are not consumed
+static const int32_t FLAGS_LIVENESS_WINDOW = 32;
+
+static bool
+hasGCMap(TR::Instruction *instr)
+   {
+   return instr->needsGCMap() || instr->getGCMap() != NULL;
+   }
+
+static bool
+isRemovable(TR::Instruction *instr)
+   {
+   return instr->getDependencyConditions() == NULL && !hasGCMap(instr);
+   }
+
+/**
+ * \brief
+ *    Determines whether a memory reference is a plain \c [base+index*stride+displacement] form whose displacement
+ *    can be adjusted through its symbol reference offset without affecting relocations or snippets.
+ */
+static bool
+isSimpleMemoryReference(TR::MemoryReference *mr)
+   {
+   if (mr->getLabel() != NULL ||
+       mr->getDataSnippet() != NULL ||
+       mr->getUnresolvedDataSnippet() != NULL ||
+       mr->getFlags() ||
+       mr->getReloKind() != TR_NoRelocation)
+      return false;
+
+   TR::SymbolReference &symRef = mr->getSymbolReference();
+   TR::Symbol *symbol = symRef.getSymbol();
+   return symbol == NULL || (!symRef.isUnresolved() && (symbol->isShadow() || symbol->isRegisterMappedSymbol()));
+   }
+
+/**
+ * \brief
+ *    Determines whether any of the given flags may be consumed by an instruction reachable from \p start before
+ *    they are overwritten. Control flow is followed through labelled branches and the search is conservative, so
+ *    anything that cannot be proven within the window is considered live.
+ */
+static bool
+mayFlagsBeLiveFrom(TR::Instruction *start, uint8_t flags, int32_t &window)
+   {
+   TR::Instruction *current = start;
+
+   while (current != NULL)
+      {
+      if (--window < 0)
+         return true;
+
+      if (current->getOpCode().getTestedEFlags() & flags)
+         return true;
+
+      TR::InstOpCode::Mnemonic op = current->getOpCodeValue();
+      if (current->getOpCode().isCallOp() ||
+          op == TR::InstOpCode::RET ||
+          op == TR::InstOpCode::RETImm2 ||
+          op == TR::InstOpCode::retn)
+         return false;
+
+      TR::LabelSymbol *label = current->isLabel() ? NULL : current->getLabelSymbol();
+      if (label != NULL)
+         {
+         TR::Instruction *target = label->getInstruction();
+         if (target == NULL)
+            return true;
+
+         if (op == TR::InstOpCode::JMP1 || op == TR::InstOpCode::JMP4)
+            {
+            current = target;
+            continue;
+            }
+
+         if (mayFlagsBeLiveFrom(target, flags, window))
+            return true;
+         }
+      else if (current->getOpCode().isBranchOp())
+         {
+         return true;
+         }
+
+      // A shift or rotate by a variable amount leaves the flags untouched when the amount is zero
+      if (!current->getOpCode().isShiftOp() && !current->getOpCode().isRotateOp())
+         flags &= ~current->getOpCode().getModifiedEFlags();
+
+      if (flags == 0)
+         return false;
+
+      current = current->getNext();
+      }
+
+   return true;
+   }
+
+static bool
+mayFlagsBeLiveAfter(TR::Instruction *instr, uint8_t flags)
+   {
+   int32_t window = FLAGS_LIVENESS_WINDOW;
+   return mayFlagsBeLiveFrom(instr->getNext(), flags, window);
+   }
+
+static bool
+isArithmeticSettingResultFlags(TR::InstOpCode::Mnemonic op)
+   {
+   switch (op)
+      {
+      case TR::InstOpCode::ADD4RegReg:
+      case TR::InstOpCode::ADD8RegReg:
+      case TR::InstOpCode::ADD4RegImm4:
+      case TR::InstOpCode::ADD8RegImm4:
+      case TR::InstOpCode::ADD4RegImms:
+      case TR::InstOpCode::ADD8RegImms:
+      case TR::InstOpCode::ADD4RegMem:
+      case TR::InstOpCode::ADD8RegMem:
+      case TR::InstOpCode::SUB4RegReg:
+      case TR::InstOpCode::SUB8RegReg:
+      case TR::InstOpCode::SUB4RegImm4:
+      case TR::InstOpCode::SUB8RegImm4:
+      case TR::InstOpCode::SUB4RegImms:
+      case TR::InstOpCode::SUB8RegImms:
+      case TR::InstOpCode::SUB4RegMem:
+      case TR::InstOpCode::SUB8RegMem:
+      case TR::InstOpCode::AND4RegReg:
+      case TR::InstOpCode::AND8RegReg:
+      case TR::InstOpCode::AND4RegImm4:
+      case TR::InstOpCode::AND8RegImm4:
+      case TR::InstOpCode::AND4RegImms:
+      case TR::InstOpCode::AND8RegImms:
+      case TR::InstOpCode::AND4RegMem:
+      case TR::InstOpCode::AND8RegMem:
+      case TR::InstOpCode::OR4RegReg:
+      case TR::InstOpCode::OR8RegReg:
+      case TR::InstOpCode::OR4RegImm4:
+      case TR::InstOpCode::OR8RegImm4:
+      case TR::InstOpCode::OR4RegImms:
+      case TR::InstOpCode::OR8RegImms:
+      case TR::InstOpCode::OR4RegMem:
+      case TR::InstOpCode::OR8RegMem:
+      case TR::InstOpCode::XOR4RegReg:
+      case TR::InstOpCode::XOR8RegReg:
+      case TR::InstOpCode::XOR4RegImm4:
+      case TR::InstOpCode::XOR8RegImm4:
+      case TR::InstOpCode::XOR4RegImms:
+      case TR::InstOpCode::XOR8RegImms:
+      case TR::InstOpCode::XOR4RegMem:
+      case TR::InstOpCode::XOR8RegMem:
+      case TR::InstOpCode::INC4Reg:
+      case TR::InstOpCode::INC8Reg:
+      case TR::InstOpCode::DEC4Reg:
+      case TR::InstOpCode::DEC8Reg:
+      case TR::InstOpCode::NEG4Reg:
+      case TR::InstOpCode::NEG8Reg:
+         return true;
+      default:
+         return false;
+      }
+   }
+
+OMR::X86::Peephole::Peephole(TR::Compilation* comp) :
+   OMR::Peephole(comp)
+   {}
+
+bool
+OMR::X86::Peephole::performOnInstruction(TR::Instruction* cursor)
+   {
+   bool performed = false;
+
+   if (self()->comp()->getOptLevel() == noOpt)
+      return performed;
+
+   // Cache the cursor for use in the peephole functions
+   self()->cursor = cursor;
+
+   switch (cursor->getOpCodeValue())
+      {
+      case TR::InstOpCode::LEA4RegMem:
+      case TR::InstOpCode::LEA8RegMem:
+         {
+         performed |= self()->tryToFoldLEAChain();
+         break;
+         }
+      case TR::InstOpCode::MOV4RegReg:
+      case TR::InstOpCode::MOV8RegReg:
+         {
+         if (self()->tryToReduceNotAndToANDN() || self()->tryToReduceShiftToShiftX())
+            performed = true;
+         else
+            performed |= self()->tryToRemoveRedundantMoveRegister();
+         break;
+         }
+      case TR::InstOpCode::NOT4Reg:
+      case TR::InstOpCode::NOT8Reg:
+         {
+         performed |= self()->tryToReduceNotAndToANDN();
+         break;
+         }
+      case TR::InstOpCode::SHL4RegCL:
+      case TR::InstOpCode::SHL8RegCL:
+      case TR::InstOpCode::SAR4RegCL:
+      case TR::InstOpCode::SAR8RegCL:
+      case TR::InstOpCode::SHR4RegCL:
+      case TR::InstOpCode::SHR8RegCL:
+         {
+         performed |= self()->tryToReduceShiftToShiftX();
+         break;
+         }
+      case TR::InstOpCode::S1MemImm1:
+      case TR::InstOpCode::S2MemImm2:
+      case TR::InstOpCode::S4MemImm4:
+         {
+         performed |= self()->tryToMergeAdjacentStores();
+         break;
+         }
+      default:
+         {
+         if (isArithmeticSettingResultFlags(cursor->getOpCodeValue()))
+            performed |= self()->tryToRemoveRedundantTest();
+         break;
+         }
+      }
+
+   return performed;
+   }
+
+bool
+OMR::X86::Peephole::tryToFoldLEAChain()
+   {
+   static bool disableLEAPeephole = feGetEnv("TR_DisableLEAPeephole") != NULL;
+   if (disableLEAPeephole)
+      return false;
+
+   TR::Instruction *leaInstruction = cursor;
+   TR::Register *targetReg = leaInstruction->getTargetRegister();
+   TR::MemoryReference *leaMR = leaInstruction->getMemoryReference();
+   bool is64Bit = leaInstruction->getOpCodeValue() == TR::InstOpCode::LEA8RegMem;
+
+   if (!isSimpleMemoryReference(leaMR))
+      return false;
+
+   bool performed = false;
+
+   while (true)
+      {
+      TR::Instruction *nextInstruction = leaInstruction->getNext();
+      if (nextInstruction == NULL || !isRemovable(nextInstruction) || nextInstruction->getTargetRegister() != targetReg)
+         break;
+
+      TR::InstOpCode::Mnemonic nextOp = nextInstruction->getOpCodeValue();
+      int64_t delta = 0;
+
+      if (nextOp == leaInstruction->getOpCodeValue())
+         {
+         // lea rX,[rX+d]
+         TR::MemoryReference *nextMR = nextInstruction->getMemoryReference();
+         if (nextMR->getBaseRegister() != targetReg ||
+             nextMR->getIndexRegister() != NULL ||
+             nextMR->getSymbolReference().getSymbol() != NULL ||
+             !isSimpleMemoryReference(nextMR))
+            break;
+
+         delta = nextMR->getDisplacement();
+         }
+      else if (nextInstruction->getKind() == OMR::Instruction::IsRegImm &&
+               (nextOp == TR::InstOpCode::ADDRegImms(is64Bit) || nextOp == TR::InstOpCode::ADDRegImm4(is64Bit) ||
+                nextOp == TR::InstOpCode::SUBRegImms(is64Bit) || nextOp == TR::InstOpCode::SUBRegImm4(is64Bit)))
+         {
+         // add rX,imm or sub rX,imm, whose flags must not be consumed since lea does not set them
+         TR::X86RegImmInstruction *immInstruction = static_cast<TR::X86RegImmInstruction *>(nextInstruction);
+         if (immInstruction->getReloKind() != TR_NoRelocation ||
+             mayFlagsBeLiveAfter(nextInstruction, nextInstruction->getOpCode().getModifiedEFlags()))
+            break;
+
+         delta = immInstruction->getSourceImmediate();
+         if (nextOp == TR::InstOpCode::SUBRegImms(is64Bit) || nextOp == TR::InstOpCode::SUBRegImm4(is64Bit))
+            delta = -delta;
+         }
+      else
+         {
+         break;
+         }
+
+      int64_t displacement = static_cast<int64_t>(leaMR->getDisplacement()) + delta;
+      if (!IS_32BIT_SIGNED(displacement))
+         break;
+
+      if (!performTransformation(self()->comp(), "O^O X86 PEEPHOLE: Fold [%p] into lea [%p].\n", nextInstruction, leaInstruction))
+         break;
+
+      leaMR->getSymbolReference().addToOffset(delta);
+      nextInstruction->remove();
+      performed = true;
+      }
+
+   return performed;
+   }
+
+bool
+OMR::X86::Peephole::tryToMergeAdjacentStores()
+   {
+   static bool disableStoreMergePeephole = feGetEnv("TR_DisableStoreMergePeephole") != NULL;
+   if (disableStoreMergePeephole)
+      return false;
+
+   TR::Instruction *storeInstruction = cursor;
+   bool performed = false;
+
+   while (storeInstruction->getKind() == OMR::Instruction::IsMemImm)
+      {
+      TR::InstOpCode::Mnemonic op = storeInstruction->getOpCodeValue();
+      TR::InstOpCode::Mnemonic mergedOp;
+      int32_t size;
+
+      switch (op)
+         {
+         case TR::InstOpCode::S1MemImm1:
+            mergedOp = TR::InstOpCode::S2MemImm2;
+            size = 1;
+            break;
+         case TR::InstOpCode::S2MemImm2:
+            mergedOp = TR::InstOpCode::S4MemImm4;
+            size = 2;
+            break;
+         case TR::InstOpCode::S4MemImm4:
+            if (!self()->comp()->target().is64Bit())
+               return performed;
+            mergedOp = TR::InstOpCode::S8MemImm4;
+            size = 4;
+            break;
+         default:
+            return performed;
+         }
+
+      TR::Instruction *nextInstruction = storeInstruction->getNext();
+      if (nextInstruction == NULL ||
+          nextInstruction->getOpCodeValue() != op ||
+          nextInstruction->getKind() != OMR::Instruction::IsMemImm ||
+          !isRemovable(nextInstruction))
+         break;
+
+      TR::X86MemImmInstruction *first = static_cast<TR::X86MemImmInstruction *>(storeInstruction);
+      TR::X86MemImmInstruction *second = static_cast<TR::X86MemImmInstruction *>(nextInstruction);
+      TR::MemoryReference *firstMR = first->getMemoryReference();
+      TR::MemoryReference *secondMR = second->getMemoryReference();
+
+      if (first->getReloKind() != TR_NoRelocation ||
+          second->getReloKind() != TR_NoRelocation ||
+          !isSimpleMemoryReference(firstMR) ||
+          !isSimpleMemoryReference(secondMR) ||
+          firstMR->getBaseRegister() != secondMR->getBaseRegister() ||
+          firstMR->getIndexRegister() != secondMR->getIndexRegister() ||
+          firstMR->getStride() != secondMR->getStride())
+         break;
+
+      // Volatile accesses must remain individually ordered
+      TR::Symbol *firstSymbol = firstMR->getSymbolReference().getSymbol();
+      TR::Symbol *secondSymbol = secondMR->getSymbolReference().getSymbol();
+      if ((firstSymbol != NULL && firstSymbol->isVolatile()) ||
+          (secondSymbol != NULL && secondSymbol->isVolatile()))
+         break;
+
+      // Stores are little endian, so the store at the lower address supplies the low order bits
+      intptr_t firstDisplacement = firstMR->getDisplacement();
+      intptr_t secondDisplacement = secondMR->getDisplacement();
+      int64_t low;
+      int64_t high;
+
+      if (secondDisplacement == firstDisplacement + size)
+         {
+         low = first->getSourceImmediate();
+         high = second->getSourceImmediate();
+         }
+      else if (firstDisplacement == secondDisplacement + size)
+         {
+         low = second->getSourceImmediate();
+         high = first->getSourceImmediate();
+         }
+      else
+         {
+         break;
+         }
+
+      const int32_t bits = size * 8;
+      uint64_t mask = (static_cast<uint64_t>(1) << bits) - 1;
+      int64_t merged = static_cast<int64_t>((static_cast<uint64_t>(low) & mask) | ((static_cast<uint64_t>(high) & mask) << bits));
+
+      // S8MemImm4 sign extends its immediate
+      if (mergedOp == TR::InstOpCode::S8MemImm4 && !IS_32BIT_SIGNED(merged))
+         break;
+
+      if (!performTransformation(self()->comp(), "O^O X86 PEEPHOLE: Merge store [%p] into store [%p].\n", nextInstruction, storeInstruction))
+         break;
+
+      if (firstDisplacement > secondDisplacement)
+         firstMR->getSymbolReference().addToOffset(-size);
+
+      first->setOpCodeValue(mergedOp);
+      first->setSourceImmediate(static_cast<int32_t>(merged));
+      nextInstruction->remove();
+      performed = true;
+      }
+
+   return performed;
+   }
+
+bool
+OMR::X86::Peephole::tryToReduceNotAndToANDN()
+   {
+   static bool disableANDNPeephole = feGetEnv("TR_DisableANDNPeephole") != NULL;
+   if (disableANDNPeephole)
+      return false;
+
+   if (!self()->comp()->target().cpu.supportsFeature(OMR_FEATURE_X86_BMI1) || !self()->comp()->target().cpu.supportsAVX())
+      return false;
+
+   TR::Instruction *movInstruction = NULL;
+   TR::Instruction *notInstruction = cursor;
+
+   if (cursor->getOpCodeValue() == TR::InstOpCode::MOV4RegReg || cursor->getOpCodeValue() == TR::InstOpCode::MOV8RegReg)
+      {
+      movInstruction = cursor;
+      notInstruction = cursor->getNext();
+      }
+
+   if (notInstruction == NULL)
+      return false;
+
+   bool is64Bit = notInstruction->getOpCodeValue() == TR::InstOpCode::NOT8Reg;
+   TR::Register *targetReg = notInstruction->getTargetRegister();
+   TR::Register *invertedReg = targetReg;
+
+   if (notInstruction->getOpCodeValue() != TR::InstOpCode::NOTReg(is64Bit) || !isRemovable(notInstruction))
+      return false;
+
+   if (movInstruction != NULL)
+      {
+      if (movInstruction->getOpCodeValue() != TR::InstOpCode::MOVRegReg(is64Bit) ||
+          movInstruction->getTargetRegister() != targetReg ||
+          !isRemovable(movInstruction))
+         return false;
+
+      invertedReg = movInstruction->getSourceRegister();
+      }
+
+   TR::Instruction *andInstruction = notInstruction->getNext();
+   if (andInstruction == NULL ||
+       andInstruction->getTargetRegister() != targetReg ||
+       !isRemovable(andInstruction))
+      return false;
+
+   // andn reads its second source after the first has been inverted, so that source must not depend on the
+   // register being inverted
+   TR::Register *maskReg = NULL;
+   TR::MemoryReference *maskMR = NULL;
+
+   if (andInstruction->getOpCodeValue() == TR::InstOpCode::ANDRegReg(is64Bit))
+      {
+      maskReg = andInstruction->getSourceRegister();
+      if (maskReg == targetReg)
+         return false;
+      }
+   else if (andInstruction->getOpCodeValue() == TR::InstOpCode::ANDRegMem(is64Bit))
+      {
+      maskMR = andInstruction->getMemoryReference();
+      if (maskMR->getBaseRegister() == targetReg ||
+          maskMR->getIndexRegister() == targetReg ||
+          maskMR->getUnresolvedDataSnippet() != NULL)
+         return false;
+      }
+   else
+      {
+      return false;
+      }
+
+   // andn leaves the parity flag undefined
+   if (mayFlagsBeLiveAfter(andInstruction, IA32EFlags_PF))
+      return false;
+
+   if (!performTransformation(self()->comp(), "O^O X86 PEEPHOLE: Reduce not [%p] and [%p] to andn.\n", notInstruction, andInstruction))
+      return false;
+
+   TR::Instruction *andnInstruction = maskMR != NULL ?
+      static_cast<TR::Instruction *>(generateRegRegMemInstruction(andInstruction, TR::InstOpCode::ANDNRegRegMem(is64Bit), targetReg, invertedReg, maskMR, self()->cg())) :
+      static_cast<TR::Instruction *>(generateRegRegRegInstruction(andInstruction, TR::InstOpCode::ANDNRegRegReg(is64Bit), targetReg, invertedReg, maskReg, self()->cg()));
+   andnInstruction->setNode(andInstruction->getNode());
+
+   if (movInstruction != NULL)
+      movInstruction->remove();
+   notInstruction->remove();
+   andInstruction->remove();
+
+   return true;
+   }
+
+bool
+OMR::X86::Peephole::tryToReduceShiftToShiftX()
+   {
+   static bool disableShiftXPeephole = feGetEnv("TR_DisableShiftXPeephole") != NULL;
+   if (disableShiftXPeephole)
+      return false;
+
+   if (!self()->comp()->target().cpu.supportsFeature(OMR_FEATURE_X86_BMI2) || !self()->comp()->target().cpu.supportsAVX())
+      return false;
+
+   TR::Instruction *movInstruction = NULL;
+   TR::Instruction *shiftInstruction = cursor;
+
+   if (cursor->getOpCodeValue() == TR::InstOpCode::MOV4RegReg || cursor->getOpCodeValue() == TR::InstOpCode::MOV8RegReg)
+      {
+      movInstruction = cursor;
+      shiftInstruction = cursor->getNext();
+      }
+
+   if (shiftInstruction == NULL || hasGCMap(shiftInstruction))
+      return false;
+
+   TR::InstOpCode::Mnemonic shiftXOp;
+   bool is64Bit;
+
+   switch (shiftInstruction->getOpCodeValue())
+      {
+      case TR::InstOpCode::SHL4RegCL: shiftXOp = TR::InstOpCode::SHLX4RegRegReg; is64Bit = false; break;
+      case TR::InstOpCode::SHL8RegCL: shiftXOp = TR::InstOpCode::SHLX8RegRegReg; is64Bit = true;  break;
+      case TR::InstOpCode::SAR4RegCL: shiftXOp = TR::InstOpCode::SARX4RegRegReg; is64Bit = false; break;
+      case TR::InstOpCode::SAR8RegCL: shiftXOp = TR::InstOpCode::SARX8RegRegReg; is64Bit = true;  break;
+      case TR::InstOpCode::SHR4RegCL: shiftXOp = TR::InstOpCode::SHRX4RegRegReg; is64Bit = false; break;
+      case TR::InstOpCode::SHR8RegCL: shiftXOp = TR::InstOpCode::SHRX8RegRegReg; is64Bit = true;  break;
+      default:
+         return false;
+      }
+
+   TR::Register *targetReg = shiftInstruction->getTargetRegister();
+   TR::Register *countReg = shiftInstruction->getSourceRegister();
+   TR::Register *sourceReg = targetReg;
+
+   if (countReg == NULL || toRealRegister(countReg)->getRegisterNumber() != TR::RealRegister::ecx)
+      return false;
+
+   if (movInstruction != NULL)
+      {
+      // Once the move is gone the count must still hold its original value
+      if (movInstruction->getOpCodeValue() != TR::InstOpCode::MOVRegReg(is64Bit) ||
+          movInstruction->getTargetRegister() != targetReg ||
+          targetReg == countReg ||
+          !isRemovable(movInstruction))
+         return false;
+
+      sourceReg = movInstruction->getSourceRegister();
+      }
+
+   // The BMI2 forms do not set any flags
+   if (mayFlagsBeLiveAfter(shiftInstruction, IA32EFlags_OF | IA32EFlags_SF | IA32EFlags_ZF | IA32EFlags_PF | IA32EFlags_CF))
+      return false;
+
+   if (!performTransformation(self()->comp(), "O^O X86 PEEPHOLE: Reduce shift [%p] to its BMI2 form.\n", shiftInstruction))
+      return false;
+
+   TR::Instruction *shiftXInstruction = generateRegRegRegInstruction(shiftInstruction, shiftXOp, targetReg, countReg, sourceReg, self()->cg());
+   shiftXInstruction->setNode(shiftInstruction->getNode());
+
+   if (movInstruction != NULL)
+      movInstruction->remove();
+   shiftInstruction->remove();
+
+   return true;
+   }
+
+bool
+OMR::X86::Peephole::tryToRemoveRedundantMoveRegister()
+   {
+   static bool disableMovPeephole = feGetEnv("TR_DisableMovPeephole") != NULL;
+   if (disableMovPeephole)
+      return false;
+
+   TR::Instruction *movInstruction = cursor;
+   TR::Instruction *nextInstruction = movInstruction->getNext();
+
+   if (nextInstruction == NULL ||
+       nextInstruction->getOpCodeValue() != movInstruction->getOpCodeValue() ||
+       !isRemovable(nextInstruction))
+      return false;
+
+   TR::Register *targetReg = movInstruction->getTargetRegister();
+   TR::Register *sourceReg = movInstruction->getSourceRegister();
+
+   bool isDuplicate = nextInstruction->getTargetRegister() == targetReg && nextInstruction->getSourceRegister() == sourceReg;
+
+   // On 64-bit targets a 4-byte copy back clears the upper half of the original register
+   bool isCopyBack = nextInstruction->getTargetRegister() == sourceReg && nextInstruction->getSourceRegister() == targetReg &&
+      (movInstruction->getOpCodeValue() == TR::InstOpCode::MOV8RegReg || self()->comp()->target().is32Bit());
+
+   if (!isDuplicate && !isCopyBack)
+      return false;
+
+   if (!performTransformation(self()->comp(), "O^O X86 PEEPHOLE: Remove redundant mov [%p].\n", nextInstruction))
+      return false;
+
+   nextInstruction->remove();
+   return true;
+   }
+
+bool
+OMR::X86::Peephole::tryToRemoveRedundantTest()
+   {
+   static bool disableTestPeephole = feGetEnv("TR_DisableTestPeephole") != NULL;
+   if (disableTestPeephole)
+      return false;
+
+   TR::Instruction *arithmeticInstruction = cursor;
+   TR::Instruction *testInstruction = arithmeticInstruction->getNext();
+
+   if (testInstruction == NULL || !isRemovable(testInstruction))
+      return false;
+
+   TR::Register *resultReg = arithmeticInstruction->getTargetRegister();
+   bool is64Bit = arithmeticInstruction->getOpCode().hasLongTarget();
+   TR::InstOpCode::Mnemonic testOp = testInstruction->getOpCodeValue();
+
+   if (testInstruction->getTargetRegister() != resultReg)
+      return false;
+
+   if (testOp == TR::InstOpCode::TESTRegReg(is64Bit))
+      {
+      // test rX,rX
+      if (testInstruction->getSourceRegister() != resultReg)
+         return false;
+      }
+   else if ((testOp == TR::InstOpCode::CMPRegImms(is64Bit) || testOp == TR::InstOpCode::CMPRegImm4(is64Bit)) &&
+            testInstruction->getKind() == OMR::Instruction::IsRegImm)
+      {
+      // cmp rX,0
+      TR::X86RegImmInstruction *cmpInstruction = static_cast<TR::X86RegImmInstruction *>(testInstruction);
+      if (cmpInstruction->getSourceImmediate() != 0 || cmpInstruction->getReloKind() != TR_NoRelocation)
+         return false;
+      }
+   else
+      {
+      return false;
+      }
+
+   // The zero, sign and parity flags agree; the carry and overflow flags the test clears may not
+   if (mayFlagsBeLiveAfter(testInstruction, IA32EFlags_CF | IA32EFlags_OF))
+      return false;
+
+   if (!performTransformation(self()->comp(), "O^O X86 PEEPHOLE: Remove redundant test [%p].\n", testInstruction))
+      return false;
+
+   testInstruction->remove();
+   return true;
+   }
@@ -0,0 +1,198 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#ifndef OMR_X86_PEEPHOLE_INCL
+#define OMR_X86_PEEPHOLE_INCL
+
+/*
+ * The following #define and typedef must appear before any #includes in this file
+ */
+#ifndef OMR_PEEPHOLE_CONNECTOR
+#define OMR_PEEPHOLE_CONNECTOR
+namespace OMR { namespace X86 { class Peephole; } }
+namespace OMR { typedef OMR::X86::Peephole PeepholeConnector; }
+#else
+#error OMR::X86::Peephole expected to be a primary connector, but an OMR connector is already defined
+#endif
+
+#include "compiler/codegen/OMRPeephole.hpp"
+
+namespace TR { class Compilation; }
+namespace TR { class Instruction; }
+
+namespace OMR
+{
+
+namespace X86
+{
+
+class OMR_EXTENSIBLE Peephole : public OMR::Peephole
+   {
+   public:
+
+   Peephole(TR::Compilation* comp);
+
+   virtual bool performOnInstruction(TR::Instruction* cursor);
+
+   private:
+
+   /** \brief
+    *     Tries to fold a chain of address computations into the leading \c lea. For example:
+    *
+    *     <code>
+    *     lea rX,[rY+rZ*4+8]
+    *     lea rX,[rX+16]
+    *     add rX,4
+    *     </code>
+    *
+    *     can be reduced to:
+    *
+    *     <code>
+    *     lea rX,[rY+rZ*4+28]
+    *     </code>
+    *
+    *     An \c add or \c sub is only folded if none of the flags it sets are consumed.
+    *
+    *  \return
+    *     true if the reduction was successful; false otherwise.
+    */
+   bool tryToFoldLEAChain();
+
+   /** \brief
+    *     Tries to merge stores of immediates to adjacent memory into a single wider store. For example:
+    *
+    *     <code>
+    *     mov dword ptr [rX+8],1
+    *     mov dword ptr [rX+12],0
+    *     </code>
+    *
+    *     can be reduced on 64-bit targets to:
+    *
+    *     <code>
+    *     mov qword ptr [rX+8],1
+    *     </code>
+    *
+    *  \return
+    *     true if the reduction was successful; false otherwise.
+    */
+   bool tryToMergeAdjacentStores();
+
+   /** \brief
+    *     Tries to reduce a bitwise and with an inverted operand to the BMI1 \c andn instruction. For example:
+    *
+    *     <code>
+    *     mov rX,rY
+    *     not rX
+    *     and rX,rZ
+    *     </code>
+    *
+    *     can be reduced to:
+    *
+    *     <code>
+    *     andn rX,rY,rZ
+    *     </code>
+    *
+    *     The second operand of the \c and may also be a memory operand that is not addressed through \c rX.
+    *
+    *  \return
+    *     true if the reduction was successful; false otherwise.
+    */
+   bool tryToReduceNotAndToANDN();
+
+   /** \brief
+    *     Tries to reduce a shift by \c cl to the BMI2 flagless three operand form. For example:
+    *
+    *     <code>
+    *     mov rX,rY
+    *     shl rX,cl
+    *     </code>
+    *
+    *     can be reduced to:
+    *
+    *     <code>
+    *     shlx rX,rY,rcx
+    *     </code>
+    *
+    *     The same applies to \c sar and \c shr, which become \c sarx and \c shrx respectively.
+    *
+    *  \return
+    *     true if the reduction was successful; false otherwise.
+    */
+   bool tryToReduceShiftToShiftX();
+
+   /** \brief
+    *     Tries to remove redundant move register instructions. For example:
+    *
+    *     <code>
+    *     mov rY,rX
+    *     mov rX,rY
+    *     </code>
+    *
+    *     or:
+    *
+    *     <code>
+    *     mov rY,rX
+    *     mov rY,rX
+    *     </code>
+    *
+    *     The latter \c mov can be removed in both cases.
+    *
+    *  \return
+    *     true if the reduction was successful; false otherwise.
+    */
+   bool tryToRemoveRedundantMoveRegister();
+
+   /** \brief
+    *     Tries to remove a compare against zero of the result of the previous arithmetic instruction. For example:
+    *
+    *     <code>
+    *     sub rX,rY
+    *     test rX,rX
+    *     je Label
+    *     </code>
+    *
+    *     can be reduced to:
+    *
+    *     <code>
+    *     sub rX,rY
+    *     je Label
+    *     </code>
+    *
+    *     The arithmetic instruction sets the zero, sign and parity flags the same way the \c test does, so the \c test
+    *     is only removed if the carry and overflow flags it clears are not consumed.
+    *
+    *  \return
+    *     true if the reduction was successful; false otherwise.
+    */
+   bool tryToRemoveRedundantTest();
+
+   private:
+
+   /// The instruction cursor currently being processed by the peephole optimization
+   TR::Instruction* cursor;
+   };
+
+}
+
+}
+
+#endif
@@ -35,11 +35,13 @@ namespace OMR { typedef OMR::X86::Register RegisterConnector; }
 
 #include "compiler/codegen/OMRRegister.hpp"
 
+#include "il/DataTypes.hpp"
 #include "infra/Assert.hpp"
 #include "infra/Flags.hpp"
 
 class TR_LiveRegisterInfo;
 class TR_RematerializationInfo;
+class TR_X86LiveInterval;
 namespace TR { class MemoryReference; }
 
 namespace OMR
@@ -52,9 +54,9 @@ class OMR_EXTENSIBLE Register: public OMR::Register
    {
    protected:
 
-   Register(uint32_t f=0): OMR::Register(f), _memRef(NULL),_rematerializationInfo(NULL) {_liveRegisterInfo._liveRegister = NULL;}
-   Register(TR_RegisterKinds rk): OMR::Register(rk), _memRef(NULL), _rematerializationInfo(NULL) {_liveRegisterInfo._liveRegister = NULL;}
-   Register(TR_RegisterKinds rk, uint16_t ar): OMR::Register(rk, ar), _memRef(NULL), _rematerializationInfo(NULL) {_liveRegisterInfo._liveRegister = NULL;}
+   Register(uint32_t f=0): OMR::Register(f), _memRef(NULL),_rematerializationInfo(NULL), _liveInterval(NULL) {_liveRegisterInfo._liveRegister = NULL;}
+   Register(TR_RegisterKinds rk): OMR::Register(rk), _memRef(NULL), _rematerializationInfo(NULL), _liveInterval(NULL) {_liveRegisterInfo._liveRegister = NULL;}
+   Register(TR_RegisterKinds rk, uint16_t ar): OMR::Register(rk, ar), _memRef(NULL), _rematerializationInfo(NULL), _liveInterval(NULL) {_liveRegisterInfo._liveRegister = NULL;}
 
 
    public:
@@ -74,6 +76,9 @@ class OMR_EXTENSIBLE Register: public OMR::Register
    uint32_t getInterference()           {return _liveRegisterInfo._interference;}
    uint32_t setInterference(uint32_t i) {return (_liveRegisterInfo._interference = i);}
 
+   TR_X86LiveInterval *getLiveInterval()                  {return _liveInterval;}
+   void setLiveInterval(TR_X86LiveInterval *interval)     {_liveInterval = interval;}
+
 
    /*
     * Method for manipulating flags
@@ -105,6 +110,17 @@ class OMR_EXTENSIBLE Register: public OMR::Register
    bool isSpilledToSecondHalf()                 {return _flags.testAny(SpilledToSecondHalf);}
    void setIsSpilledToSecondHalf(bool b = true) {_flags.set(SpilledToSecondHalf, b);}
 
+   /**
+    * @brief Length of the vector held in a TR_VRF register. Registers whose
+    *        length was never set hold 128-bit vectors.
+    */
+   TR::VectorLength getVectorLength()
+      {
+      TR::VectorLength length = (TR::VectorLength)((_flags.getValue() & VectorLengthMask) >> VectorLengthShift);
+      return length == TR::NoVectorLength ? TR::VectorLength128 : length;
+      }
+   void setVectorLength(TR::VectorLength length) {_flags.setValue(VectorLengthMask, (uint32_t)length << VectorLengthShift);}
+
 
    private:
 
@@ -124,6 +140,8 @@ class OMR_EXTENSIBLE Register: public OMR::Register
       SpilledToSecondHalf           = 0x4000, // Spilled at an offset starting at the middle of the spill slot
       IsDiscardable                 = 0x0020, // Register is currently discardable
       ByteRegisterAssigned          = 0x0200,
+      VectorLengthMask              = 0x30000, // TR::VectorLength of the vector in a TR_VRF register
+      VectorLengthShift             = 16,
       };
 
    //Both x and z have this field, but power has own specialization, may move to base
@@ -139,6 +157,9 @@ class OMR_EXTENSIBLE Register: public OMR::Register
    // Both x and z have this, but power doesn't, so duplicating in both x and z
    TR::MemoryReference *_memRef;
 
+   // Preferred registers over the live range, if TR_X86RegisterPreferences ran
+   TR_X86LiveInterval *_liveInterval;
+
    };
 
 }
@@ -236,7 +236,8 @@ OMR::X86::RegisterDependencyConditions::RegisterDependencyConditions(
             {
             generateRegcopyDebugCounter(cg, "vrf");
             copyReg = cg->allocateRegister(TR_VRF);
-            generateRegRegInstruction(TR::InstOpCode::MOVDQURegReg, node, copyReg, child->getRegister(), cg);
+            copyReg->setVectorLength(child->getRegister()->getVectorLength());
+            generateRegRegInstruction(TR::InstOpCode::MovVectorRegReg(TR::DataType::getVectorSize(copyReg->getVectorLength())), node, copyReg, child->getRegister(), cg);
             }
 
          globalReg = copyReg;
@@ -778,7 +779,7 @@ void OMR::X86::RegisterDependencyGroup::assignRegisters(TR::Instruction   *curre
                   }
                else if (assignedReg->getKind() == TR_VRF)
                   {
-                  op = TR::InstOpCode::MOVDQURegMem;
+                  op = TR::InstOpCode::MovVectorRegMem(TR::DataType::getVectorSize(virtReg->getVectorLength()));
                   }
                else
                   {
@@ -4075,6 +4075,18 @@ static const TR::InstOpCode::Mnemonic BinaryArithmeticOpCodesForReg[TR::NumOMRTy
    { TR::InstOpCode::bad, TR::InstOpCode::PADDQRegReg, TR::InstOpCode::PSUBQRegReg, TR::InstOpCode::bad,    TR::InstOpCode::bad,   TR::InstOpCode::PANDRegReg, TR::InstOpCode::PORRegReg, TR::InstOpCode::PXORRegReg }, // VectorInt64
    { TR::InstOpCode::bad, TR::InstOpCode::ADDPSRegReg, TR::InstOpCode::SUBPSRegReg, TR::InstOpCode::MULPSRegReg,  TR::InstOpCode::DIVPSRegReg, TR::InstOpCode::bad,  TR::InstOpCode::bad, TR::InstOpCode::bad  }, // VectorFloat
    { TR::InstOpCode::bad, TR::InstOpCode::ADDPDRegReg, TR::InstOpCode::SUBPDRegReg, TR::InstOpCode::MULPDRegReg,  TR::InstOpCode::DIVPDRegReg, TR::InstOpCode::bad,  TR::InstOpCode::bad, TR::InstOpCode::bad  }, // VectorDouble
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDBRegReg, TR::InstOpCode::VPSUBBRegReg, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector256Int8
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDWRegReg, TR::InstOpCode::VPSUBWRegReg, TR::InstOpCode::VPMULLWRegReg, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector256Int16
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDDRegReg, TR::InstOpCode::VPSUBDRegReg, TR::InstOpCode::VPMULLDRegReg, TR::InstOpCode::bad, TR::InstOpCode::VPANDRegReg, TR::InstOpCode::VPORRegReg, TR::InstOpCode::VPXORRegReg }, // Vector256Int32
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDQRegReg, TR::InstOpCode::VPSUBQRegReg, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::VPANDRegReg, TR::InstOpCode::VPORRegReg, TR::InstOpCode::VPXORRegReg }, // Vector256Int64
+   { TR::InstOpCode::bad, TR::InstOpCode::VADDPSRegReg, TR::InstOpCode::VSUBPSRegReg, TR::InstOpCode::VMULPSRegReg, TR::InstOpCode::VDIVPSRegReg, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector256Float
+   { TR::InstOpCode::bad, TR::InstOpCode::VADDPDRegReg, TR::InstOpCode::VSUBPDRegReg, TR::InstOpCode::VMULPDRegReg, TR::InstOpCode::VDIVPDRegReg, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector256Double
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDB512RegReg, TR::InstOpCode::VPSUBB512RegReg, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector512Int8
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDW512RegReg, TR::InstOpCode::VPSUBW512RegReg, TR::InstOpCode::VPMULLW512RegReg, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector512Int16
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDD512RegReg, TR::InstOpCode::VPSUBD512RegReg, TR::InstOpCode::VPMULLD512RegReg, TR::InstOpCode::bad, TR::InstOpCode::VPANDQ512RegReg, TR::InstOpCode::VPORQ512RegReg, TR::InstOpCode::VPXORQ512RegReg }, // Vector512Int32
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDQ512RegReg, TR::InstOpCode::VPSUBQ512RegReg, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::VPANDQ512RegReg, TR::InstOpCode::VPORQ512RegReg, TR::InstOpCode::VPXORQ512RegReg }, // Vector512Int64
+   { TR::InstOpCode::bad, TR::InstOpCode::VADDPS512RegReg, TR::InstOpCode::VSUBPS512RegReg, TR::InstOpCode::VMULPS512RegReg, TR::InstOpCode::VDIVPS512RegReg, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector512Float
+   { TR::InstOpCode::bad, TR::InstOpCode::VADDPD512RegReg, TR::InstOpCode::VSUBPD512RegReg, TR::InstOpCode::VMULPD512RegReg, TR::InstOpCode::VDIVPD512RegReg, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector512Double
    { TR::InstOpCode::bad, TR::InstOpCode::bad,   TR::InstOpCode::bad,   TR::InstOpCode::bad,    TR::InstOpCode::bad,   TR::InstOpCode::bad,  TR::InstOpCode::bad, TR::InstOpCode::bad  }, // Aggregate
    };
 
@@ -4095,6 +4107,18 @@ static const TR::InstOpCode::Mnemonic BinaryArithmeticOpCodesForMem[TR::NumOMRTy
    { TR::InstOpCode::bad, TR::InstOpCode::PADDQRegMem, TR::InstOpCode::PSUBQRegMem, TR::InstOpCode::bad,    TR::InstOpCode::bad,   TR::InstOpCode::PANDRegMem, TR::InstOpCode::PORRegMem, TR::InstOpCode::PXORRegMem }, // VectorInt64
    { TR::InstOpCode::bad, TR::InstOpCode::ADDPSRegMem, TR::InstOpCode::SUBPSRegMem, TR::InstOpCode::MULPSRegMem,  TR::InstOpCode::DIVPSRegMem, TR::InstOpCode::bad,  TR::InstOpCode::bad, TR::InstOpCode::bad  }, // VectorFloat
    { TR::InstOpCode::bad, TR::InstOpCode::ADDPDRegMem, TR::InstOpCode::SUBPDRegMem, TR::InstOpCode::MULPDRegMem,  TR::InstOpCode::DIVPDRegMem, TR::InstOpCode::bad,  TR::InstOpCode::bad, TR::InstOpCode::bad  }, // VectorDouble
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDBRegMem, TR::InstOpCode::VPSUBBRegMem, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector256Int8
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDWRegMem, TR::InstOpCode::VPSUBWRegMem, TR::InstOpCode::VPMULLWRegMem, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector256Int16
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDDRegMem, TR::InstOpCode::VPSUBDRegMem, TR::InstOpCode::VPMULLDRegMem, TR::InstOpCode::bad, TR::InstOpCode::VPANDRegMem, TR::InstOpCode::VPORRegMem, TR::InstOpCode::VPXORRegMem }, // Vector256Int32
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDQRegMem, TR::InstOpCode::VPSUBQRegMem, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::VPANDRegMem, TR::InstOpCode::VPORRegMem, TR::InstOpCode::VPXORRegMem }, // Vector256Int64
+   { TR::InstOpCode::bad, TR::InstOpCode::VADDPSRegMem, TR::InstOpCode::VSUBPSRegMem, TR::InstOpCode::VMULPSRegMem, TR::InstOpCode::VDIVPSRegMem, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector256Float
+   { TR::InstOpCode::bad, TR::InstOpCode::VADDPDRegMem, TR::InstOpCode::VSUBPDRegMem, TR::InstOpCode::VMULPDRegMem, TR::InstOpCode::VDIVPDRegMem, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector256Double
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDB512RegMem, TR::InstOpCode::VPSUBB512RegMem, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector512Int8
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDW512RegMem, TR::InstOpCode::VPSUBW512RegMem, TR::InstOpCode::VPMULLW512RegMem, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector512Int16
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDD512RegMem, TR::InstOpCode::VPSUBD512RegMem, TR::InstOpCode::VPMULLD512RegMem, TR::InstOpCode::bad, TR::InstOpCode::VPANDQ512RegMem, TR::InstOpCode::VPORQ512RegMem, TR::InstOpCode::VPXORQ512RegMem }, // Vector512Int32
+   { TR::InstOpCode::bad, TR::InstOpCode::VPADDQ512RegMem, TR::InstOpCode::VPSUBQ512RegMem, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::VPANDQ512RegMem, TR::InstOpCode::VPORQ512RegMem, TR::InstOpCode::VPXORQ512RegMem }, // Vector512Int64
+   { TR::InstOpCode::bad, TR::InstOpCode::VADDPS512RegMem, TR::InstOpCode::VSUBPS512RegMem, TR::InstOpCode::VMULPS512RegMem, TR::InstOpCode::VDIVPS512RegMem, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector512Float
+   { TR::InstOpCode::bad, TR::InstOpCode::VADDPD512RegMem, TR::InstOpCode::VSUBPD512RegMem, TR::InstOpCode::VMULPD512RegMem, TR::InstOpCode::VDIVPD512RegMem, TR::InstOpCode::bad, TR::InstOpCode::bad, TR::InstOpCode::bad }, // Vector512Double
    { TR::InstOpCode::bad, TR::InstOpCode::bad,   TR::InstOpCode::bad,   TR::InstOpCode::bad,    TR::InstOpCode::bad,   TR::InstOpCode::bad,  TR::InstOpCode::bad, TR::InstOpCode::bad  }, // Aggregate
    };
 
@@ -4114,6 +4138,18 @@ static const TR::ILOpCodes MemoryLoadOpCodes[TR::NumOMRTypes] =
    TR::vload  , // VectorInt64
    TR::vload  , // VectorFloat
    TR::vload  , // VectorDouble
+   TR::vload  , // Vector256Int8
+   TR::vload  , // Vector256Int16
+   TR::vload  , // Vector256Int32
+   TR::vload  , // Vector256Int64
+   TR::vload  , // Vector256Float
+   TR::vload  , // Vector256Double
+   TR::vload  , // Vector512Int8
+   TR::vload  , // Vector512Int16
+   TR::vload  , // Vector512Int32
+   TR::vload  , // Vector512Int64
+   TR::vload  , // Vector512Float
+   TR::vload  , // Vector512Double
    TR::BadILOp, // Aggregate
    };
 
@@ -4180,6 +4216,8 @@ TR::Register* OMR::X86::TreeEvaluator::FloatingPointAndVectorBinaryArithmeticEva
    TR::Register* operandReg1 = useRegMemForm ? NULL : cg->evaluate(operandNode1);
    TR::Register* resultReg = cg->allocateRegister(operandReg0->getKind());
    resultReg->setIsSinglePrecision(operandReg0->isSinglePrecision());
+   if (type.isVector())
+      resultReg->setVectorLength(type.getVectorLength());
 
    TR::InstOpCode::Mnemonic opCode = useRegMemForm ? BinaryArithmeticOpCodesForMem[type][arithmetic] : BinaryArithmeticOpCodesForReg[type][arithmetic];
    TR_ASSERT(opCode != TR::InstOpCode::bad, "FloatingPointAndVectorBinaryArithmeticEvaluator: unsupported data type or arithmetic.");
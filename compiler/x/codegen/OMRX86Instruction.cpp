@@ -2399,6 +2399,17 @@ TR::X86RegRegMemInstruction::X86RegRegMemInstruction(TR::InstOpCode::Mnemonic
    useRegister(srreg);
    }
 
+TR::X86RegRegMemInstruction::X86RegRegMemInstruction(TR::Instruction     *precedingInstruction,
+                                                     TR::InstOpCode::Mnemonic        op,
+                                                     TR::Register        *slreg,
+                                                     TR::Register        *srreg,
+                                                     TR::MemoryReference *mr,
+                                                     TR::CodeGenerator   *cg)
+   : TR::X86RegMemInstruction(precedingInstruction, op, slreg, mr, cg), _source2ndRegister(srreg)
+   {
+   useRegister(srreg);
+   }
+
 TR::X86RegRegMemInstruction::X86RegRegMemInstruction(TR::InstOpCode::Mnemonic                      op,
                                                      TR::Node                          *node,
                                                      TR::Register                      *slreg,
@@ -4409,6 +4420,16 @@ generateRegRegInstruction(TR::Instruction *instr,
    return new (cg->trHeapMemory()) TR::X86RegRegInstruction(instr, op, treg, sreg, cg);
    }
 
+TR::X86RegRegRegInstruction  *
+generateRegRegRegInstruction(TR::Instruction *instr,
+                             TR::InstOpCode::Mnemonic  op,
+                             TR::Register    *reg1,
+                             TR::Register    *reg2,
+                             TR::Register    *reg3, TR::CodeGenerator *cg)
+   {
+   return new (cg->trHeapMemory()) TR::X86RegRegRegInstruction(instr, op, reg1, reg2, reg3, cg);
+   }
+
 TR::X86RegRegRegInstruction  *
 generateRegRegRegInstruction(TR::InstOpCode::Mnemonic op, TR::Node * node, TR::Register * reg1, TR::Register * reg2, TR::Register * reg3, TR::CodeGenerator *cg)
    {
@@ -4433,6 +4454,12 @@ generateRegRegMemInstruction(TR::InstOpCode::Mnemonic op, TR::Node * node, TR::R
    return new (cg->trHeapMemory()) TR::X86RegRegMemInstruction(op, node, reg1, reg2, mr, cg);
    }
 
+TR::X86RegRegMemInstruction  *
+generateRegRegMemInstruction(TR::Instruction *instr, TR::InstOpCode::Mnemonic op, TR::Register * reg1, TR::Register * reg2, TR::MemoryReference  * mr, TR::CodeGenerator *cg)
+   {
+   return new (cg->trHeapMemory()) TR::X86RegRegMemInstruction(instr, op, reg1, reg2, mr, cg);
+   }
+
 TR::X86RegRegMemInstruction  *
 generateRegRegMemInstruction(TR::InstOpCode::Mnemonic                     op,
                              TR::Node                         *node,
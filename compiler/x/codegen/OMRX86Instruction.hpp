@@ -1626,6 +1626,8 @@ class X86MemImmInstruction : public TR::X86MemInstruction
    uint32_t getSourceImmediateAsAddress()  {return (uint32_t)_sourceImmediate;}
    int32_t setSourceImmediate(int32_t si) {return (_sourceImmediate = si);}
 
+   int32_t getReloKind()                   {return _reloKind;}
+
    virtual uint8_t* generateOperand(uint8_t* cursor);
    virtual int32_t  estimateBinaryLength(int32_t currentEstimate);
    virtual uint8_t  getBinaryLengthLowerBound();
@@ -1984,6 +1986,12 @@ class X86RegRegMemInstruction : public TR::X86RegMemInstruction
                            TR::Register        *srreg,
                            TR::MemoryReference *mr,
                            TR::CodeGenerator   *cg);
+   X86RegRegMemInstruction(TR::Instruction     *precedingInstruction,
+                           TR::InstOpCode::Mnemonic        op,
+                           TR::Register        *slreg,
+                           TR::Register        *srreg,
+                           TR::MemoryReference *mr,
+                           TR::CodeGenerator   *cg);
    X86RegRegMemInstruction(TR::InstOpCode::Mnemonic                     op,
                            TR::Node                         *node,
                            TR::Register                     *slreg,
@@ -2936,6 +2944,7 @@ TR::X86MemTableInstruction * generateMemTableInstruction(TR::InstOpCode::Mnemoni
 TR::X86RegImmInstruction  * generateRegImmInstruction(TR::Instruction *, TR::InstOpCode::Mnemonic op, TR::Register * reg1, int32_t imm, TR::CodeGenerator *cg, int32_t reloKind=TR_NoRelocation);
 TR::X86RegMemInstruction  * generateRegMemInstruction(TR::Instruction *, TR::InstOpCode::Mnemonic op, TR::Register * reg1, TR::MemoryReference  * mr, TR::CodeGenerator *cg);
 TR::X86RegRegInstruction  * generateRegRegInstruction(TR::Instruction *, TR::InstOpCode::Mnemonic op, TR::Register * reg1, TR::Register * reg2, TR::CodeGenerator *cg);
+TR::X86RegRegRegInstruction  * generateRegRegRegInstruction(TR::Instruction *, TR::InstOpCode::Mnemonic op, TR::Register * reg1, TR::Register * reg2, TR::Register * reg3, TR::CodeGenerator *cg);
 
 /** \brief
  *   Insert instructions to check DF flag is in the right state (zero) and trap if not
@@ -3023,6 +3032,7 @@ TR::X86RegRegRegInstruction  * generateRegRegRegInstruction(TR::InstOpCode::Mnem
 TR::X86RegRegRegInstruction  * generateRegRegRegInstruction(TR::InstOpCode::Mnemonic op, TR::Node *, TR::Register * reg1, TR::Register * reg2, TR::Register * reg3, TR::CodeGenerator *cg);
 TR::X86RegRegMemInstruction  * generateRegRegMemInstruction(TR::InstOpCode::Mnemonic op, TR::Node *, TR::Register * reg1, TR::Register * reg2, TR::MemoryReference  * mr, TR::RegisterDependencyConditions  *deps, TR::CodeGenerator *cg);
 TR::X86RegRegMemInstruction  * generateRegRegMemInstruction(TR::InstOpCode::Mnemonic op, TR::Node *, TR::Register * reg1, TR::Register * reg2, TR::MemoryReference  * mr, TR::CodeGenerator *cg);
+TR::X86RegRegMemInstruction  * generateRegRegMemInstruction(TR::Instruction *, TR::InstOpCode::Mnemonic op, TR::Register * reg1, TR::Register * reg2, TR::MemoryReference  * mr, TR::CodeGenerator *cg);
 
 TR::X86ImmSnippetInstruction  * generateImmSnippetInstruction(TR::InstOpCode::Mnemonic op, TR::Node *, int32_t imm, TR::UnresolvedDataSnippet *, TR::CodeGenerator *cg);
 
@@ -142,9 +142,11 @@ void TR_OutlinedInstructions::generateOutlinedInstructionsDispatch()
                mov = TR::InstOpCode::MOVRegReg();
                break;
             case TR_FPR:
-            case TR_VRF:
                mov = TR::InstOpCode::MOVDQURegReg;
                break;
+            case TR_VRF:
+               mov = TR::InstOpCode::MovVectorRegReg(TR::DataType::getVectorSize(resultReg->getVectorLength()));
+               break;
             default:
                TR_ASSERT(false, "OutlinedInstructions: unsupported result register kind.");
                break;
@@ -74,12 +74,15 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDloadEvaluator(TR::Node* node, TR::Cod
    TR::MemoryReference* tempMR = generateX86MemoryReference(node, cg);
    tempMR = ConvertToPatchableMemoryReference(tempMR, node, cg);
    TR::Register* resultReg = cg->allocateRegister(TR_VRF);
+   resultReg->setVectorLength(node->getDataType().getVectorLength());
 
    TR::InstOpCode::Mnemonic opCode = TR::InstOpCode::bad;
    switch (node->getSize())
       {
       case 16:
-         opCode = TR::InstOpCode::MOVDQURegMem;
+      case 32:
+      case 64:
+         opCode = TR::InstOpCode::MovVectorRegMem(node->getSize());
          break;
       default:
          if (cg->comp()->getOption(TR_TraceCG))
@@ -107,7 +110,9 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDstoreEvaluator(TR::Node* node, TR::Co
    switch (node->getSize())
       {
       case 16:
-         opCode = TR::InstOpCode::MOVDQUMemReg;
+      case 32:
+      case 64:
+         opCode = TR::InstOpCode::MovVectorMemReg(node->getSize());
          break;
       default:
          if (cg->comp()->getOption(TR_TraceCG))
@@ -131,6 +136,70 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDsplatsEvaluator(TR::Node* node, TR::C
    TR::Register* childReg = cg->evaluate(childNode);
 
    TR::Register* resultReg = cg->allocateRegister(TR_VRF);
+   TR::VectorLength length = node->getDataType().getVectorLength();
+   if (length != TR::VectorLength128)
+      {
+      // Move the scalar into the lowest element and broadcast it to all
+      // elements of the 256 or 512-bit vector
+      //
+      bool is512 = (length == TR::VectorLength512);
+      TR::DataType elementType = node->getDataType().getVectorElementType();
+      TR::Register* srcReg = childReg;
+      TR::InstOpCode::Mnemonic broadcastOp = TR::InstOpCode::bad;
+      switch (elementType)
+         {
+         case TR::Int8:
+            broadcastOp = is512 ? TR::InstOpCode::VPBROADCASTB512RegReg : TR::InstOpCode::VPBROADCASTBRegReg;
+            break;
+         case TR::Int16:
+            broadcastOp = is512 ? TR::InstOpCode::VPBROADCASTW512RegReg : TR::InstOpCode::VPBROADCASTWRegReg;
+            break;
+         case TR::Int32:
+            broadcastOp = is512 ? TR::InstOpCode::VPBROADCASTD512RegReg : TR::InstOpCode::VPBROADCASTDRegReg;
+            break;
+         case TR::Int64:
+            broadcastOp = is512 ? TR::InstOpCode::VPBROADCASTQ512RegReg : TR::InstOpCode::VPBROADCASTQRegReg;
+            break;
+         case TR::Float:
+            broadcastOp = is512 ? TR::InstOpCode::VBROADCASTSS512RegReg : TR::InstOpCode::VBROADCASTSSRegReg;
+            break;
+         case TR::Double:
+            broadcastOp = is512 ? TR::InstOpCode::VBROADCASTSD512RegReg : TR::InstOpCode::VBROADCASTSDRegReg;
+            break;
+         default:
+            TR_ASSERT(false, "Unsupported data type, Node = %p", node);
+            break;
+         }
+
+      if (elementType == TR::Int64 && cg->comp()->target().is32Bit())
+         {
+         TR::Register* tempVectorReg = cg->allocateRegister(TR_VRF);
+         generateRegRegInstruction(TR::InstOpCode::MOVDRegReg4, node, tempVectorReg, childReg->getHighOrder(), cg);
+         generateRegImmInstruction(TR::InstOpCode::PSLLQRegImm1, node, tempVectorReg, 0x20, cg);
+         generateRegRegInstruction(TR::InstOpCode::MOVDRegReg4, node, resultReg, childReg->getLowOrder(), cg);
+         generateRegRegInstruction(TR::InstOpCode::PORRegReg, node, resultReg, tempVectorReg, cg);
+         cg->stopUsingRegister(tempVectorReg);
+         srcReg = resultReg;
+         }
+      else if (elementType == TR::Int64)
+         {
+         generateRegRegInstruction(TR::InstOpCode::MOVQRegReg8, node, resultReg, childReg, cg);
+         srcReg = resultReg;
+         }
+      else if (elementType.isIntegral())
+         {
+         generateRegRegInstruction(TR::InstOpCode::MOVDRegReg4, node, resultReg, childReg, cg);
+         srcReg = resultReg;
+         }
+
+      resultReg->setVectorLength(length);
+      generateRegRegInstruction(broadcastOp, node, resultReg, srcReg, cg);
+
+      node->setRegister(resultReg);
+      cg->decReferenceCount(childNode);
+      return resultReg;
+      }
+
    switch (node->getDataType())
       {
       case TR::VectorInt32:
@@ -181,12 +250,36 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDgetvelemEvaluator(TR::Node* node, TR:
    TR::Register* lowResReg = 0;
    TR::Register* highResReg = 0;
 
+   /*
+    * For 256 and 512-bit vectors the 128-bit lane holding the element is extracted first
+    * and the element is then read from the lane the same way as from a 128-bit vector.
+    */
+   TR::DataType vectorType = firstChild->getDataType();
+   TR::Register* laneReg = 0;
+   int32_t elem = secondChild->getOpCode().isLoadConst() ? secondChild->getInt() : -1;
+   if (vectorType.getVectorLength() != TR::VectorLength128 && secondChild->getOpCode().isLoadConst())
+      {
+      int32_t elementsPerLane = 16 / TR::DataType::getSize(vectorType.getVectorElementType());
+      int32_t numElements = TR::DataType::getVectorSize(vectorType.getVectorLength()) / TR::DataType::getSize(vectorType.getVectorElementType());
+
+      TR_ASSERT(elem >= 0 && elem < numElements, "Element can only be 0 to %u\n", numElements - 1);
+
+      // Elements are numbered from the most significant end of the register
+      int32_t physicalElem = numElements - 1 - elem;
+      laneReg = cg->allocateRegister(TR_VRF);
+      generateRegRegImmInstruction(vectorType.getVectorLength() == TR::VectorLength512 ? TR::InstOpCode::VEXTRACTI32X4512RegRegImm1 : TR::InstOpCode::VEXTRACTI128RegRegImm1,
+                                   node, laneReg, srcVectorReg, physicalElem / elementsPerLane, cg);
+      elem = elementsPerLane - 1 - (physicalElem % elementsPerLane);
+      srcVectorReg = laneReg;
+      vectorType = vectorType.getVectorElementType().scalarToVector(TR::VectorLength128);
+      }
+
    int32_t elementCount = -1;
-   switch (firstChild->getDataType())
+   switch (vectorType)
       {
       case TR::VectorInt8:
       case TR::VectorInt16:
-         TR_ASSERT(false, "unsupported vector type %s in SIMDgetvelemEvaluator.\n", firstChild->getDataType().toString());
+         TR_ASSERT(false, "unsupported vector type %s in SIMDgetvelemEvaluator.\n", vectorType.toString());
          break;
       case TR::VectorInt32:
          elementCount = 4;
@@ -214,13 +307,11 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDgetvelemEvaluator(TR::Node* node, TR:
          resReg = cg->allocateRegister(TR_FPR);
          break;
       default:
-         TR_ASSERT(false, "unrecognized vector type %s in SIMDgetvelemEvaluator.\n", firstChild->getDataType().toString());
+         TR_ASSERT(false, "unrecognized vector type %s in SIMDgetvelemEvaluator.\n", vectorType.toString());
       }
 
    if (secondChild->getOpCode().isLoadConst())
       {
-      int32_t elem = secondChild->getInt();
-
       TR_ASSERT(elem >= 0 && elem < elementCount, "Element can only be 0 to %u\n", elementCount - 1);
 
       uint8_t shufconst = 0x00;
@@ -241,11 +332,11 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDgetvelemEvaluator(TR::Node* node, TR:
           * for float, dstReg and resReg are the same because PSHUFD can work directly with TR_FPR registers
           * for Int32, the result needs to be moved from the dstReg to a TR_GPR resReg.
           */
-         if (TR::VectorInt32 == firstChild->getDataType())
+         if (TR::VectorInt32 == vectorType)
             {
             dstReg = cg->allocateRegister(TR_VRF);
             }
-         else //TR::VectorFloat == firstChild->getDataType()
+         else //TR::VectorFloat == vectorType
             {
             dstReg = resReg;
             }
@@ -263,7 +354,7 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDgetvelemEvaluator(TR::Node* node, TR:
             generateRegRegImmInstruction(TR::InstOpCode::PSHUFDRegRegImm1, node, dstReg, srcVectorReg, shufconst, cg);
             }
 
-         if (TR::VectorInt32 == firstChild->getDataType())
+         if (TR::VectorInt32 == vectorType)
             {
             generateRegRegInstruction(TR::InstOpCode::MOVDReg4Reg, node, resReg, dstReg, cg);
             cg->stopUsingRegister(dstReg);
@@ -275,11 +366,11 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDgetvelemEvaluator(TR::Node* node, TR:
           * for double, dstReg and resReg are the same because PSHUFD can work directly with TR_FPR registers
           * for Int64, the result needs to be moved from the dstReg to a TR_GPR resReg.
           */
-         if (TR::VectorInt64 == firstChild->getDataType())
+         if (TR::VectorInt64 == vectorType)
             {
             dstReg = cg->allocateRegister(TR_VRF);
             }
-         else //TR::VectorDouble == firstChild->getDataType()
+         else //TR::VectorDouble == vectorType
             {
             dstReg = resReg;
             }
@@ -300,7 +391,7 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDgetvelemEvaluator(TR::Node* node, TR:
             generateRegRegImmInstruction(TR::InstOpCode::PSHUFDRegRegImm1, node, dstReg, srcVectorReg, 0x0e, cg);
             }
 
-         if (TR::VectorInt64 == firstChild->getDataType())
+         if (TR::VectorInt64 == vectorType)
             {
             if (cg->comp()->target().is32Bit())
                {
@@ -322,6 +413,9 @@ TR::Register* OMR::X86::TreeEvaluator::SIMDgetvelemEvaluator(TR::Node* node, TR:
       TR_ASSERT(false, "non-const second child not currently supported in SIMDgetvelemEvaluator.\n");
       }
 
+   if (laneReg)
+      cg->stopUsingRegister(laneReg);
+
    node->setRegister(resReg);
    cg->decReferenceCount(firstChild);
    cg->decReferenceCount(secondChild);
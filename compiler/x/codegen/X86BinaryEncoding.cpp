@@ -1469,7 +1469,7 @@ uint8_t* TR::X86RegRegRegInstruction::generateOperand(uint8_t* cursor)
       {
       applySourceRegisterToModRMByte(modRM);
       }
-   applySource2ndRegisterToVEX(modRM - 2);
+   applySource2ndRegisterToVEX(modRM - (getOpCode().info().isEVEX() ? 3 : 2));
    return cursor;
    }
 
@@ -2424,7 +2424,7 @@ uint8_t* TR::X86RegRegMemInstruction::generateOperand(uint8_t* cursor)
       {
       applyTargetRegisterToModRMByte(modRM);
       }
-   applySource2ndRegisterToVEX(modRM - 2);
+   applySource2ndRegisterToVEX(modRM - (getOpCode().info().isEVEX() ? 3 : 2));
    cursor = getMemoryReference()->generateBinaryEncoding(modRM, this, cg());
    return cursor;
    }
@@ -2887,7 +2887,7 @@ TR::AMD64RegImm64SymInstruction::addMetaDataForCodeAddress(uint8_t *cursor)
             }
          case TR_NativeMethodAbsolute:
             {
-            if (cg()->comp()->getOption(TR_EmitRelocatableELFFile))
+            if (cg()->comp()->recordsStaticRelocations())
                {
                TR_ResolvedMethod *target = getSymbolReference()->getSymbol()->castToResolvedMethodSymbol()->getResolvedMethod();
                cg()->addStaticRelocation(TR::StaticRelocation(cursor, target->externalName(cg()->trMemory()), TR::StaticRelocationSize::word64, TR::StaticRelocationType::Absolute));
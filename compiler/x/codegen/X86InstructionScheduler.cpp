@@ -0,0 +1,1327 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "x/codegen/X86InstructionScheduler.hpp"
+
+#include <stdint.h>
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "codegen/MemoryReference.hpp"
+#include "codegen/RealRegister.hpp"
+#include "codegen/Register.hpp"
+#include "codegen/X86Instruction.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/IO.hpp"
+#include "env/StackMemoryRegion.hpp"
+#include "il/SymbolReference.hpp"
+#include "infra/Assert.hpp"
+#include "ras/Debug.hpp"
+#include "ras/DebugCounter.hpp"
+
+/// The largest number of instructions scheduled together; longer sequences are split
+static const int32_t MAX_REGION_SIZE = 64;
+
+/// The access size assumed when the size of a memory operand is not known
+static const int32_t MAX_ACCESS_SIZE = 64;
+
+#define ALL_EFLAGS (IA32EFlags_OF | IA32EFlags_SF | IA32EFlags_ZF | IA32EFlags_PF | IA32EFlags_CF)
+
+// Skylake execution ports
+#define SKL_P0 0x0001
+#define SKL_P1 0x0002
+#define SKL_P2 0x0004
+#define SKL_P3 0x0008
+#define SKL_P4 0x0010
+#define SKL_P5 0x0020
+#define SKL_P6 0x0040
+
+const TR_X86SchedulingModel TR_X86SchedulingModel::Skylake =
+   {
+   "Skylake", 4, 8,
+      {
+      {  0, 0, 0 },                                       // TR_X86Unschedulable
+      {  1, 1, SKL_P0 | SKL_P1 | SKL_P5 | SKL_P6 },       // TR_X86IntALU
+      {  1, 1, SKL_P0 | SKL_P1 | SKL_P5 | SKL_P6 },       // TR_X86IntMove
+      {  1, 1, SKL_P0 | SKL_P6 },                         // TR_X86IntShift
+      {  3, 1, SKL_P1 },                                  // TR_X86IntMultiply
+      {  1, 1, SKL_P1 | SKL_P5 },                         // TR_X86LoadEffectiveAddress
+      {  5, 1, SKL_P2 | SKL_P3 },                         // TR_X86Load
+      {  1, 1, SKL_P4 },                                  // TR_X86Store
+      {  1, 1, SKL_P0 | SKL_P1 | SKL_P5 },                // TR_X86FPMove
+      {  4, 1, SKL_P0 | SKL_P1 },                         // TR_X86FPAdd
+      {  4, 1, SKL_P0 | SKL_P1 },                         // TR_X86FPMultiply
+      {  4, 1, SKL_P0 | SKL_P1 },                         // TR_X86FPFusedMultiplyAdd
+      { 14, 4, SKL_P0 },                                  // TR_X86FPDivide
+      { 18, 6, SKL_P0 },                                  // TR_X86FPSqrt
+      {  5, 1, SKL_P0 | SKL_P1 },                         // TR_X86FPConvert
+      {  1, 1, SKL_P0 | SKL_P1 | SKL_P5 },                // TR_X86VectorALU
+      { 10, 1, SKL_P0 | SKL_P1 },                         // TR_X86VectorMultiply
+      {  1, 1, SKL_P5 },                                  // TR_X86VectorShuffle
+      }
+   };
+
+// Zen execution ports
+#define ZEN_ALU0 0x0001
+#define ZEN_ALU1 0x0002
+#define ZEN_ALU2 0x0004
+#define ZEN_ALU3 0x0008
+#define ZEN_AGU0 0x0010
+#define ZEN_AGU1 0x0020
+#define ZEN_AGU2 0x0040
+#define ZEN_FP0  0x0080
+#define ZEN_FP1  0x0100
+#define ZEN_FP2  0x0200
+#define ZEN_FP3  0x0400
+
+const TR_X86SchedulingModel TR_X86SchedulingModel::Zen =
+   {
+   "Zen", 5, 11,
+      {
+      {  0, 0, 0 },                                          // TR_X86Unschedulable
+      {  1, 1, ZEN_ALU0 | ZEN_ALU1 | ZEN_ALU2 | ZEN_ALU3 },   // TR_X86IntALU
+      {  1, 1, ZEN_ALU0 | ZEN_ALU1 | ZEN_ALU2 | ZEN_ALU3 },   // TR_X86IntMove
+      {  1, 1, ZEN_ALU1 | ZEN_ALU2 },                        // TR_X86IntShift
+      {  3, 1, ZEN_ALU1 },                                   // TR_X86IntMultiply
+      {  1, 1, ZEN_ALU0 | ZEN_ALU1 | ZEN_ALU2 | ZEN_ALU3 },   // TR_X86LoadEffectiveAddress
+      {  4, 1, ZEN_AGU0 | ZEN_AGU1 },                        // TR_X86Load
+      {  1, 1, ZEN_AGU2 },                                   // TR_X86Store
+      {  1, 1, ZEN_FP0 | ZEN_FP1 | ZEN_FP2 | ZEN_FP3 },       // TR_X86FPMove
+      {  3, 1, ZEN_FP2 | ZEN_FP3 },                          // TR_X86FPAdd
+      {  3, 1, ZEN_FP0 | ZEN_FP1 },                          // TR_X86FPMultiply
+      {  5, 1, ZEN_FP0 | ZEN_FP1 },                          // TR_X86FPFusedMultiplyAdd
+      { 13, 4, ZEN_FP3 },                                    // TR_X86FPDivide
+      { 20, 9, ZEN_FP3 },                                    // TR_X86FPSqrt
+      {  4, 1, ZEN_FP2 | ZEN_FP3 },                          // TR_X86FPConvert
+      {  1, 1, ZEN_FP0 | ZEN_FP1 | ZEN_FP3 },                // TR_X86VectorALU
+      {  4, 1, ZEN_FP0 },                                    // TR_X86VectorMultiply
+      {  1, 1, ZEN_FP1 | ZEN_FP2 },                          // TR_X86VectorShuffle
+      }
+   };
+
+// Properties of an operation that are not reliably described by the opcode properties
+enum
+   {
+   ReadsTargetOnly = 0x01,    // compares and tests, which leave their target unchanged
+   ModifiesFlags   = 0x02,
+   TestsFlags      = 0x04
+   };
+
+static TR_X86OperationClass
+classify(TR::InstOpCode::Mnemonic op, uint32_t &properties)
+   {
+   properties = 0;
+
+   switch (op)
+      {
+      case TR::InstOpCode::ADD1RegImm1:
+      case TR::InstOpCode::ADD2RegImm2:
+      case TR::InstOpCode::ADD2RegImms:
+      case TR::InstOpCode::ADD4RegImm4:
+      case TR::InstOpCode::ADD8RegImm4:
+      case TR::InstOpCode::ADD4RegImms:
+      case TR::InstOpCode::ADD8RegImms:
+      case TR::InstOpCode::ADD1MemImm1:
+      case TR::InstOpCode::ADD2MemImm2:
+      case TR::InstOpCode::ADD2MemImms:
+      case TR::InstOpCode::ADD4MemImm4:
+      case TR::InstOpCode::ADD8MemImm4:
+      case TR::InstOpCode::ADD4MemImms:
+      case TR::InstOpCode::ADD8MemImms:
+      case TR::InstOpCode::ADD1RegReg:
+      case TR::InstOpCode::ADD2RegReg:
+      case TR::InstOpCode::ADD4RegReg:
+      case TR::InstOpCode::ADD8RegReg:
+      case TR::InstOpCode::ADD1RegMem:
+      case TR::InstOpCode::ADD2RegMem:
+      case TR::InstOpCode::ADD4RegMem:
+      case TR::InstOpCode::ADD8RegMem:
+      case TR::InstOpCode::ADD1MemReg:
+      case TR::InstOpCode::ADD2MemReg:
+      case TR::InstOpCode::ADD4MemReg:
+      case TR::InstOpCode::ADD8MemReg:
+      case TR::InstOpCode::SUB1RegImm1:
+      case TR::InstOpCode::SUB2RegImm2:
+      case TR::InstOpCode::SUB2RegImms:
+      case TR::InstOpCode::SUB4RegImm4:
+      case TR::InstOpCode::SUB8RegImm4:
+      case TR::InstOpCode::SUB4RegImms:
+      case TR::InstOpCode::SUB8RegImms:
+      case TR::InstOpCode::SUB1MemImm1:
+      case TR::InstOpCode::SUB2MemImm2:
+      case TR::InstOpCode::SUB2MemImms:
+      case TR::InstOpCode::SUB4MemImm4:
+      case TR::InstOpCode::SUB8MemImm4:
+      case TR::InstOpCode::SUB4MemImms:
+      case TR::InstOpCode::SUB8MemImms:
+      case TR::InstOpCode::SUB1RegReg:
+      case TR::InstOpCode::SUB2RegReg:
+      case TR::InstOpCode::SUB4RegReg:
+      case TR::InstOpCode::SUB8RegReg:
+      case TR::InstOpCode::SUB1RegMem:
+      case TR::InstOpCode::SUB2RegMem:
+      case TR::InstOpCode::SUB4RegMem:
+      case TR::InstOpCode::SUB8RegMem:
+      case TR::InstOpCode::SUB1MemReg:
+      case TR::InstOpCode::SUB2MemReg:
+      case TR::InstOpCode::SUB4MemReg:
+      case TR::InstOpCode::SUB8MemReg:
+      case TR::InstOpCode::AND1RegImm1:
+      case TR::InstOpCode::AND2RegImm2:
+      case TR::InstOpCode::AND2RegImms:
+      case TR::InstOpCode::AND4RegImm4:
+      case TR::InstOpCode::AND8RegImm4:
+      case TR::InstOpCode::AND4RegImms:
+      case TR::InstOpCode::AND8RegImms:
+      case TR::InstOpCode::AND1MemImm1:
+      case TR::InstOpCode::AND2MemImm2:
+      case TR::InstOpCode::AND2MemImms:
+      case TR::InstOpCode::AND4MemImm4:
+      case TR::InstOpCode::AND8MemImm4:
+      case TR::InstOpCode::AND4MemImms:
+      case TR::InstOpCode::AND8MemImms:
+      case TR::InstOpCode::AND1RegReg:
+      case TR::InstOpCode::AND2RegReg:
+      case TR::InstOpCode::AND4RegReg:
+      case TR::InstOpCode::AND8RegReg:
+      case TR::InstOpCode::AND1RegMem:
+      case TR::InstOpCode::AND2RegMem:
+      case TR::InstOpCode::AND4RegMem:
+      case TR::InstOpCode::AND8RegMem:
+      case TR::InstOpCode::AND1MemReg:
+      case TR::InstOpCode::AND2MemReg:
+      case TR::InstOpCode::AND4MemReg:
+      case TR::InstOpCode::AND8MemReg:
+      case TR::InstOpCode::OR1RegImm1:
+      case TR::InstOpCode::OR2RegImm2:
+      case TR::InstOpCode::OR2RegImms:
+      case TR::InstOpCode::OR4RegImm4:
+      case TR::InstOpCode::OR8RegImm4:
+      case TR::InstOpCode::OR4RegImms:
+      case TR::InstOpCode::OR8RegImms:
+      case TR::InstOpCode::OR1MemImm1:
+      case TR::InstOpCode::OR2MemImm2:
+      case TR::InstOpCode::OR2MemImms:
+      case TR::InstOpCode::OR4MemImm4:
+      case TR::InstOpCode::OR8MemImm4:
+      case TR::InstOpCode::OR4MemImms:
+      case TR::InstOpCode::OR8MemImms:
+      case TR::InstOpCode::OR1RegReg:
+      case TR::InstOpCode::OR2RegReg:
+      case TR::InstOpCode::OR4RegReg:
+      case TR::InstOpCode::OR8RegReg:
+      case TR::InstOpCode::OR1RegMem:
+      case TR::InstOpCode::OR2RegMem:
+      case TR::InstOpCode::OR4RegMem:
+      case TR::InstOpCode::OR8RegMem:
+      case TR::InstOpCode::OR1MemReg:
+      case TR::InstOpCode::OR2MemReg:
+      case TR::InstOpCode::OR4MemReg:
+      case TR::InstOpCode::OR8MemReg:
+      case TR::InstOpCode::XOR1RegImm1:
+      case TR::InstOpCode::XOR2RegImm2:
+      case TR::InstOpCode::XOR2RegImms:
+      case TR::InstOpCode::XOR4RegImm4:
+      case TR::InstOpCode::XOR8RegImm4:
+      case TR::InstOpCode::XOR4RegImms:
+      case TR::InstOpCode::XOR8RegImms:
+      case TR::InstOpCode::XOR1MemImm1:
+      case TR::InstOpCode::XOR2MemImm2:
+      case TR::InstOpCode::XOR2MemImms:
+      case TR::InstOpCode::XOR4MemImm4:
+      case TR::InstOpCode::XOR8MemImm4:
+      case TR::InstOpCode::XOR4MemImms:
+      case TR::InstOpCode::XOR8MemImms:
+      case TR::InstOpCode::XOR1RegReg:
+      case TR::InstOpCode::XOR2RegReg:
+      case TR::InstOpCode::XOR4RegReg:
+      case TR::InstOpCode::XOR8RegReg:
+      case TR::InstOpCode::XOR1RegMem:
+      case TR::InstOpCode::XOR2RegMem:
+      case TR::InstOpCode::XOR4RegMem:
+      case TR::InstOpCode::XOR8RegMem:
+      case TR::InstOpCode::XOR1MemReg:
+      case TR::InstOpCode::XOR2MemReg:
+      case TR::InstOpCode::XOR4MemReg:
+      case TR::InstOpCode::XOR8MemReg:
+      case TR::InstOpCode::INC1Reg:
+      case TR::InstOpCode::INC2Reg:
+      case TR::InstOpCode::INC4Reg:
+      case TR::InstOpCode::INC8Reg:
+      case TR::InstOpCode::DEC1Reg:
+      case TR::InstOpCode::DEC2Reg:
+      case TR::InstOpCode::DEC4Reg:
+      case TR::InstOpCode::DEC8Reg:
+      case TR::InstOpCode::NEG1Reg:
+      case TR::InstOpCode::NEG2Reg:
+      case TR::InstOpCode::NEG4Reg:
+      case TR::InstOpCode::NEG8Reg:
+      case TR::InstOpCode::ANDN4RegRegReg:
+      case TR::InstOpCode::ANDN8RegRegReg:
+      case TR::InstOpCode::ANDN4RegRegMem:
+      case TR::InstOpCode::ANDN8RegRegMem:
+         properties = ModifiesFlags;
+         return TR_X86IntALU;
+
+      case TR::InstOpCode::ADC4RegImm4:
+      case TR::InstOpCode::ADC8RegImm4:
+      case TR::InstOpCode::ADC4RegImms:
+      case TR::InstOpCode::ADC8RegImms:
+      case TR::InstOpCode::ADC4RegReg:
+      case TR::InstOpCode::ADC8RegReg:
+      case TR::InstOpCode::ADC4RegMem:
+      case TR::InstOpCode::ADC8RegMem:
+      case TR::InstOpCode::SBB4RegImm4:
+      case TR::InstOpCode::SBB8RegImm4:
+      case TR::InstOpCode::SBB4RegImms:
+      case TR::InstOpCode::SBB8RegImms:
+      case TR::InstOpCode::SBB4RegReg:
+      case TR::InstOpCode::SBB8RegReg:
+      case TR::InstOpCode::SBB4RegMem:
+      case TR::InstOpCode::SBB8RegMem:
+         properties = ModifiesFlags | TestsFlags;
+         return TR_X86IntALU;
+
+      case TR::InstOpCode::CMP1RegImm1:
+      case TR::InstOpCode::CMP2RegImm2:
+      case TR::InstOpCode::CMP2RegImms:
+      case TR::InstOpCode::CMP4RegImm4:
+      case TR::InstOpCode::CMP8RegImm4:
+      case TR::InstOpCode::CMP4RegImms:
+      case TR::InstOpCode::CMP8RegImms:
+      case TR::InstOpCode::CMP1MemImm1:
+      case TR::InstOpCode::CMP2MemImm2:
+      case TR::InstOpCode::CMP2MemImms:
+      case TR::InstOpCode::CMP4MemImm4:
+      case TR::InstOpCode::CMP8MemImm4:
+      case TR::InstOpCode::CMP4MemImms:
+      case TR::InstOpCode::CMP8MemImms:
+      case TR::InstOpCode::CMP1RegReg:
+      case TR::InstOpCode::CMP2RegReg:
+      case TR::InstOpCode::CMP4RegReg:
+      case TR::InstOpCode::CMP8RegReg:
+      case TR::InstOpCode::CMP1RegMem:
+      case TR::InstOpCode::CMP2RegMem:
+      case TR::InstOpCode::CMP4RegMem:
+      case TR::InstOpCode::CMP8RegMem:
+      case TR::InstOpCode::CMP1MemReg:
+      case TR::InstOpCode::CMP2MemReg:
+      case TR::InstOpCode::CMP4MemReg:
+      case TR::InstOpCode::CMP8MemReg:
+      case TR::InstOpCode::TEST1RegImm1:
+      case TR::InstOpCode::TEST2RegImm2:
+      case TR::InstOpCode::TEST4RegImm4:
+      case TR::InstOpCode::TEST8RegImm4:
+      case TR::InstOpCode::TEST1MemImm1:
+      case TR::InstOpCode::TEST2MemImm2:
+      case TR::InstOpCode::TEST4MemImm4:
+      case TR::InstOpCode::TEST8MemImm4:
+      case TR::InstOpCode::TEST1RegReg:
+      case TR::InstOpCode::TEST2RegReg:
+      case TR::InstOpCode::TEST4RegReg:
+      case TR::InstOpCode::TEST8RegReg:
+      case TR::InstOpCode::TEST1MemReg:
+      case TR::InstOpCode::TEST2MemReg:
+      case TR::InstOpCode::TEST4MemReg:
+      case TR::InstOpCode::TEST8MemReg:
+         properties = ReadsTargetOnly | ModifiesFlags;
+         return TR_X86IntALU;
+
+      case TR::InstOpCode::CMOVB4RegReg:
+      case TR::InstOpCode::CMOVB8RegReg:
+      case TR::InstOpCode::CMOVG4RegReg:
+      case TR::InstOpCode::CMOVG8RegReg:
+      case TR::InstOpCode::CMOVGE4RegReg:
+      case TR::InstOpCode::CMOVGE8RegReg:
+      case TR::InstOpCode::CMOVL4RegReg:
+      case TR::InstOpCode::CMOVL8RegReg:
+      case TR::InstOpCode::CMOVLE4RegReg:
+      case TR::InstOpCode::CMOVLE8RegReg:
+      case TR::InstOpCode::CMOVE4RegReg:
+      case TR::InstOpCode::CMOVE8RegReg:
+      case TR::InstOpCode::CMOVNE4RegReg:
+      case TR::InstOpCode::CMOVNE8RegReg:
+      case TR::InstOpCode::CMOVS4RegReg:
+      case TR::InstOpCode::CMOVS8RegReg:
+      case TR::InstOpCode::CMOVA4RegMem:
+      case TR::InstOpCode::CMOVA8RegMem:
+      case TR::InstOpCode::CMOVB4RegMem:
+      case TR::InstOpCode::CMOVE4RegMem:
+      case TR::InstOpCode::CMOVE8RegMem:
+      case TR::InstOpCode::CMOVG4RegMem:
+      case TR::InstOpCode::CMOVGE4RegMem:
+      case TR::InstOpCode::CMOVGE8RegMem:
+      case TR::InstOpCode::CMOVL4RegMem:
+      case TR::InstOpCode::CMOVNE4RegMem:
+      case TR::InstOpCode::CMOVNE8RegMem:
+      case TR::InstOpCode::CMOVNO4RegMem:
+      case TR::InstOpCode::CMOVNS4RegMem:
+      case TR::InstOpCode::CMOVO4RegMem:
+      case TR::InstOpCode::CMOVP4RegMem:
+      case TR::InstOpCode::CMOVP8RegMem:
+      case TR::InstOpCode::CMOVS4RegMem:
+      case TR::InstOpCode::SETA1Reg:
+      case TR::InstOpCode::SETAE1Reg:
+      case TR::InstOpCode::SETB1Reg:
+      case TR::InstOpCode::SETBE1Reg:
+      case TR::InstOpCode::SETE1Reg:
+      case TR::InstOpCode::SETNE1Reg:
+      case TR::InstOpCode::SETG1Reg:
+      case TR::InstOpCode::SETGE1Reg:
+      case TR::InstOpCode::SETL1Reg:
+      case TR::InstOpCode::SETLE1Reg:
+      case TR::InstOpCode::SETS1Reg:
+      case TR::InstOpCode::SETNS1Reg:
+      case TR::InstOpCode::SETPO1Reg:
+      case TR::InstOpCode::SETPE1Reg:
+         properties = TestsFlags;
+         return TR_X86IntALU;
+
+      case TR::InstOpCode::NOT1Reg:
+      case TR::InstOpCode::NOT2Reg:
+      case TR::InstOpCode::NOT4Reg:
+      case TR::InstOpCode::NOT8Reg:
+      case TR::InstOpCode::BSWAP4Reg:
+      case TR::InstOpCode::BSWAP8Reg:
+         return TR_X86IntALU;
+
+      case TR::InstOpCode::MOV1RegReg:
+      case TR::InstOpCode::MOV2RegReg:
+      case TR::InstOpCode::MOV4RegReg:
+      case TR::InstOpCode::MOV8RegReg:
+      case TR::InstOpCode::MOV1RegImm1:
+      case TR::InstOpCode::MOV2RegImm2:
+      case TR::InstOpCode::MOV4RegImm4:
+      case TR::InstOpCode::MOV8RegImm4:
+      case TR::InstOpCode::MOV8RegImm64:
+      case TR::InstOpCode::MOVSXReg2Reg1:
+      case TR::InstOpCode::MOVSXReg4Reg1:
+      case TR::InstOpCode::MOVSXReg8Reg1:
+      case TR::InstOpCode::MOVSXReg4Reg2:
+      case TR::InstOpCode::MOVSXReg8Reg2:
+      case TR::InstOpCode::MOVSXReg8Reg4:
+      case TR::InstOpCode::MOVZXReg2Reg1:
+      case TR::InstOpCode::MOVZXReg4Reg1:
+      case TR::InstOpCode::MOVZXReg8Reg1:
+      case TR::InstOpCode::MOVZXReg4Reg2:
+      case TR::InstOpCode::MOVZXReg8Reg2:
+      case TR::InstOpCode::MOVZXReg8Reg4:
+      case TR::InstOpCode::L1RegMem:
+      case TR::InstOpCode::L2RegMem:
+      case TR::InstOpCode::L4RegMem:
+      case TR::InstOpCode::L8RegMem:
+      case TR::InstOpCode::MOVSXReg2Mem1:
+      case TR::InstOpCode::MOVSXReg4Mem1:
+      case TR::InstOpCode::MOVSXReg8Mem1:
+      case TR::InstOpCode::MOVSXReg4Mem2:
+      case TR::InstOpCode::MOVSXReg8Mem2:
+      case TR::InstOpCode::MOVSXReg8Mem4:
+      case TR::InstOpCode::MOVZXReg2Mem1:
+      case TR::InstOpCode::MOVZXReg4Mem1:
+      case TR::InstOpCode::MOVZXReg8Mem1:
+      case TR::InstOpCode::MOVZXReg4Mem2:
+      case TR::InstOpCode::MOVZXReg8Mem2:
+      case TR::InstOpCode::S1MemReg:
+      case TR::InstOpCode::S2MemReg:
+      case TR::InstOpCode::S4MemReg:
+      case TR::InstOpCode::S8MemReg:
+      case TR::InstOpCode::S1MemImm1:
+      case TR::InstOpCode::S2MemImm2:
+      case TR::InstOpCode::S4MemImm4:
+      case TR::InstOpCode::S8MemImm4:
+         return TR_X86IntMove;
+
+      case TR::InstOpCode::SHL1RegImm1:
+      case TR::InstOpCode::SHL2RegImm1:
+      case TR::InstOpCode::SHL4RegImm1:
+      case TR::InstOpCode::SHL8RegImm1:
+      case TR::InstOpCode::SHR1RegImm1:
+      case TR::InstOpCode::SHR2RegImm1:
+      case TR::InstOpCode::SHR4RegImm1:
+      case TR::InstOpCode::SHR8RegImm1:
+      case TR::InstOpCode::SAR1RegImm1:
+      case TR::InstOpCode::SAR2RegImm1:
+      case TR::InstOpCode::SAR4RegImm1:
+      case TR::InstOpCode::SAR8RegImm1:
+      case TR::InstOpCode::ROL1RegImm1:
+      case TR::InstOpCode::ROL2RegImm1:
+      case TR::InstOpCode::ROL4RegImm1:
+      case TR::InstOpCode::ROL8RegImm1:
+      case TR::InstOpCode::ROR1RegImm1:
+      case TR::InstOpCode::ROR2RegImm1:
+      case TR::InstOpCode::ROR4RegImm1:
+      case TR::InstOpCode::ROR8RegImm1:
+         properties = ModifiesFlags;
+         return TR_X86IntShift;
+
+      case TR::InstOpCode::SARX4RegRegReg:
+      case TR::InstOpCode::SARX8RegRegReg:
+      case TR::InstOpCode::SHLX4RegRegReg:
+      case TR::InstOpCode::SHLX8RegRegReg:
+      case TR::InstOpCode::SHRX4RegRegReg:
+      case TR::InstOpCode::SHRX8RegRegReg:
+         return TR_X86IntShift;
+
+      case TR::InstOpCode::IMUL2RegReg:
+      case TR::InstOpCode::IMUL4RegReg:
+      case TR::InstOpCode::IMUL8RegReg:
+      case TR::InstOpCode::IMUL2RegMem:
+      case TR::InstOpCode::IMUL4RegMem:
+      case TR::InstOpCode::IMUL8RegMem:
+      case TR::InstOpCode::IMUL2RegRegImm2:
+      case TR::InstOpCode::IMUL2RegRegImms:
+      case TR::InstOpCode::IMUL4RegRegImm4:
+      case TR::InstOpCode::IMUL8RegRegImm4:
+      case TR::InstOpCode::IMUL4RegRegImms:
+      case TR::InstOpCode::IMUL8RegRegImms:
+      case TR::InstOpCode::IMUL2RegMemImm2:
+      case TR::InstOpCode::IMUL2RegMemImms:
+      case TR::InstOpCode::IMUL4RegMemImm4:
+      case TR::InstOpCode::IMUL8RegMemImm4:
+      case TR::InstOpCode::IMUL4RegMemImms:
+      case TR::InstOpCode::IMUL8RegMemImms:
+         properties = ModifiesFlags;
+         return TR_X86IntMultiply;
+
+      case TR::InstOpCode::LEA2RegMem:
+      case TR::InstOpCode::LEA4RegMem:
+      case TR::InstOpCode::LEA8RegMem:
+         return TR_X86LoadEffectiveAddress;
+
+      case TR::InstOpCode::MOVAPSRegReg:
+      case TR::InstOpCode::MOVAPSRegMem:
+      case TR::InstOpCode::MOVAPSMemReg:
+      case TR::InstOpCode::MOVAPDRegReg:
+      case TR::InstOpCode::MOVAPDRegMem:
+      case TR::InstOpCode::MOVAPDMemReg:
+      case TR::InstOpCode::MOVUPSRegReg:
+      case TR::InstOpCode::MOVUPSRegMem:
+      case TR::InstOpCode::MOVUPSMemReg:
+      case TR::InstOpCode::MOVUPDRegReg:
+      case TR::InstOpCode::MOVUPDRegMem:
+      case TR::InstOpCode::MOVUPDMemReg:
+      case TR::InstOpCode::MOVSSRegReg:
+      case TR::InstOpCode::MOVSSRegMem:
+      case TR::InstOpCode::MOVSSMemReg:
+      case TR::InstOpCode::MOVSDRegReg:
+      case TR::InstOpCode::MOVSDRegMem:
+      case TR::InstOpCode::MOVSDMemReg:
+      case TR::InstOpCode::MOVDQURegReg:
+      case TR::InstOpCode::MOVDQURegMem:
+      case TR::InstOpCode::MOVDQUMemReg:
+      case TR::InstOpCode::MOVDRegReg4:
+      case TR::InstOpCode::MOVQRegReg8:
+      case TR::InstOpCode::MOVDReg4Reg:
+      case TR::InstOpCode::MOVQReg8Reg:
+      case TR::InstOpCode::MOVDRegMem:
+      case TR::InstOpCode::MOVDMemReg:
+      case TR::InstOpCode::MOVQRegMem:
+      case TR::InstOpCode::MOVQMemReg:
+         return TR_X86FPMove;
+
+      case TR::InstOpCode::ADDSSRegReg:
+      case TR::InstOpCode::ADDSSRegMem:
+      case TR::InstOpCode::ADDPSRegReg:
+      case TR::InstOpCode::ADDPSRegMem:
+      case TR::InstOpCode::ADDSDRegReg:
+      case TR::InstOpCode::ADDSDRegMem:
+      case TR::InstOpCode::ADDPDRegReg:
+      case TR::InstOpCode::ADDPDRegMem:
+      case TR::InstOpCode::SUBSSRegReg:
+      case TR::InstOpCode::SUBSSRegMem:
+      case TR::InstOpCode::SUBPSRegReg:
+      case TR::InstOpCode::SUBPSRegMem:
+      case TR::InstOpCode::SUBSDRegReg:
+      case TR::InstOpCode::SUBSDRegMem:
+      case TR::InstOpCode::SUBPDRegReg:
+      case TR::InstOpCode::SUBPDRegMem:
+         return TR_X86FPAdd;
+
+      case TR::InstOpCode::UCOMISSRegReg:
+      case TR::InstOpCode::UCOMISSRegMem:
+      case TR::InstOpCode::UCOMISDRegReg:
+      case TR::InstOpCode::UCOMISDRegMem:
+         properties = ReadsTargetOnly | ModifiesFlags;
+         return TR_X86FPAdd;
+
+      case TR::InstOpCode::MULSSRegReg:
+      case TR::InstOpCode::MULSSRegMem:
+      case TR::InstOpCode::MULPSRegReg:
+      case TR::InstOpCode::MULPSRegMem:
+      case TR::InstOpCode::MULSDRegReg:
+      case TR::InstOpCode::MULSDRegMem:
+      case TR::InstOpCode::MULPDRegReg:
+      case TR::InstOpCode::MULPDRegMem:
+         return TR_X86FPMultiply;
+
+      case TR::InstOpCode::VFMADD132SSRegRegReg:
+      case TR::InstOpCode::VFMADD132SSRegRegMem:
+      case TR::InstOpCode::VFMADD213SSRegRegReg:
+      case TR::InstOpCode::VFMADD213SSRegRegMem:
+      case TR::InstOpCode::VFMADD231SSRegRegReg:
+      case TR::InstOpCode::VFMADD231SSRegRegMem:
+      case TR::InstOpCode::VFMADD132SDRegRegReg:
+      case TR::InstOpCode::VFMADD132SDRegRegMem:
+      case TR::InstOpCode::VFMADD213SDRegRegReg:
+      case TR::InstOpCode::VFMADD213SDRegRegMem:
+      case TR::InstOpCode::VFMADD231SDRegRegReg:
+      case TR::InstOpCode::VFMADD231SDRegRegMem:
+      case TR::InstOpCode::VFMSUB132SSRegRegReg:
+      case TR::InstOpCode::VFMSUB132SSRegRegMem:
+      case TR::InstOpCode::VFMSUB213SSRegRegReg:
+      case TR::InstOpCode::VFMSUB213SSRegRegMem:
+      case TR::InstOpCode::VFMSUB231SSRegRegReg:
+      case TR::InstOpCode::VFMSUB231SSRegRegMem:
+      case TR::InstOpCode::VFMSUB132SDRegRegReg:
+      case TR::InstOpCode::VFMSUB132SDRegRegMem:
+      case TR::InstOpCode::VFMSUB213SDRegRegReg:
+      case TR::InstOpCode::VFMSUB213SDRegRegMem:
+      case TR::InstOpCode::VFMSUB231SDRegRegReg:
+      case TR::InstOpCode::VFMSUB231SDRegRegMem:
+      case TR::InstOpCode::VFNMADD132SSRegRegReg:
+      case TR::InstOpCode::VFNMADD132SSRegRegMem:
+      case TR::InstOpCode::VFNMADD213SSRegRegReg:
+      case TR::InstOpCode::VFNMADD213SSRegRegMem:
+      case TR::InstOpCode::VFNMADD231SSRegRegReg:
+      case TR::InstOpCode::VFNMADD231SSRegRegMem:
+      case TR::InstOpCode::VFNMADD132SDRegRegReg:
+      case TR::InstOpCode::VFNMADD132SDRegRegMem:
+      case TR::InstOpCode::VFNMADD213SDRegRegReg:
+      case TR::InstOpCode::VFNMADD213SDRegRegMem:
+      case TR::InstOpCode::VFNMADD231SDRegRegReg:
+      case TR::InstOpCode::VFNMADD231SDRegRegMem:
+      case TR::InstOpCode::VFNMSUB132SSRegRegReg:
+      case TR::InstOpCode::VFNMSUB132SSRegRegMem:
+      case TR::InstOpCode::VFNMSUB213SSRegRegReg:
+      case TR::InstOpCode::VFNMSUB213SSRegRegMem:
+      case TR::InstOpCode::VFNMSUB231SSRegRegReg:
+      case TR::InstOpCode::VFNMSUB231SSRegRegMem:
+      case TR::InstOpCode::VFNMSUB132SDRegRegReg:
+      case TR::InstOpCode::VFNMSUB132SDRegRegMem:
+      case TR::InstOpCode::VFNMSUB213SDRegRegReg:
+      case TR::InstOpCode::VFNMSUB213SDRegRegMem:
+      case TR::InstOpCode::VFNMSUB231SDRegRegReg:
+      case TR::InstOpCode::VFNMSUB231SDRegRegMem:
+         return TR_X86FPFusedMultiplyAdd;
+
+      case TR::InstOpCode::DIVSSRegReg:
+      case TR::InstOpCode::DIVSSRegMem:
+      case TR::InstOpCode::DIVPSRegReg:
+      case TR::InstOpCode::DIVPSRegMem:
+      case TR::InstOpCode::DIVSDRegReg:
+      case TR::InstOpCode::DIVSDRegMem:
+      case TR::InstOpCode::DIVPDRegReg:
+      case TR::InstOpCode::DIVPDRegMem:
+         return TR_X86FPDivide;
+
+      case TR::InstOpCode::SQRTSSRegReg:
+      case TR::InstOpCode::SQRTSDRegReg:
+         return TR_X86FPSqrt;
+
+      case TR::InstOpCode::CVTSI2SSRegReg4:
+      case TR::InstOpCode::CVTSI2SSRegReg8:
+      case TR::InstOpCode::CVTSI2SSRegMem:
+      case TR::InstOpCode::CVTSI2SSRegMem8:
+      case TR::InstOpCode::CVTSI2SDRegReg4:
+      case TR::InstOpCode::CVTSI2SDRegReg8:
+      case TR::InstOpCode::CVTSI2SDRegMem:
+      case TR::InstOpCode::CVTSI2SDRegMem8:
+      case TR::InstOpCode::CVTTSS2SIReg4Reg:
+      case TR::InstOpCode::CVTTSS2SIReg8Reg:
+      case TR::InstOpCode::CVTTSS2SIReg4Mem:
+      case TR::InstOpCode::CVTTSS2SIReg8Mem:
+      case TR::InstOpCode::CVTTSD2SIReg4Reg:
+      case TR::InstOpCode::CVTTSD2SIReg8Reg:
+      case TR::InstOpCode::CVTTSD2SIReg4Mem:
+      case TR::InstOpCode::CVTTSD2SIReg8Mem:
+      case TR::InstOpCode::CVTSS2SDRegReg:
+      case TR::InstOpCode::CVTSS2SDRegMem:
+      case TR::InstOpCode::CVTSD2SSRegReg:
+      case TR::InstOpCode::CVTSD2SSRegMem:
+         return TR_X86FPConvert;
+
+      case TR::InstOpCode::PADDBRegReg:
+      case TR::InstOpCode::PADDBRegMem:
+      case TR::InstOpCode::PADDWRegReg:
+      case TR::InstOpCode::PADDWRegMem:
+      case TR::InstOpCode::PADDDRegReg:
+      case TR::InstOpCode::PADDDRegMem:
+      case TR::InstOpCode::PADDQRegReg:
+      case TR::InstOpCode::PADDQRegMem:
+      case TR::InstOpCode::PSUBBRegReg:
+      case TR::InstOpCode::PSUBBRegMem:
+      case TR::InstOpCode::PSUBWRegReg:
+      case TR::InstOpCode::PSUBWRegMem:
+      case TR::InstOpCode::PSUBDRegReg:
+      case TR::InstOpCode::PSUBDRegMem:
+      case TR::InstOpCode::PSUBQRegReg:
+      case TR::InstOpCode::PSUBQRegMem:
+      case TR::InstOpCode::PANDRegReg:
+      case TR::InstOpCode::PANDRegMem:
+      case TR::InstOpCode::PORRegReg:
+      case TR::InstOpCode::PORRegMem:
+      case TR::InstOpCode::PXORRegReg:
+      case TR::InstOpCode::PXORRegMem:
+      case TR::InstOpCode::PANDNRegReg:
+      case TR::InstOpCode::PCMPEQBRegReg:
+      case TR::InstOpCode::PCMPEQWRegReg:
+      case TR::InstOpCode::PCMPGTBRegReg:
+      case TR::InstOpCode::PCMPGTWRegReg:
+      case TR::InstOpCode::XORPSRegReg:
+      case TR::InstOpCode::XORPSRegMem:
+      case TR::InstOpCode::XORPDRegReg:
+      case TR::InstOpCode::ANDNPSRegReg:
+      case TR::InstOpCode::ANDNPDRegReg:
+         return TR_X86VectorALU;
+
+      case TR::InstOpCode::PMULLWRegReg:
+      case TR::InstOpCode::PMULLWRegMem:
+      case TR::InstOpCode::PMULLDRegReg:
+      case TR::InstOpCode::PMULLDRegMem:
+         return TR_X86VectorMultiply;
+
+      case TR::InstOpCode::PSHUFBRegReg:
+      case TR::InstOpCode::PSHUFBRegMem:
+      case TR::InstOpCode::PSHUFDRegRegImm1:
+      case TR::InstOpCode::PSHUFDRegMemImm1:
+      case TR::InstOpCode::PUNPCKHBWRegReg:
+      case TR::InstOpCode::PUNPCKLBWRegReg:
+      case TR::InstOpCode::PACKUSWBRegReg:
+         return TR_X86VectorShuffle;
+
+      default:
+         return TR_X86Unschedulable;
+      }
+   }
+
+namespace
+{
+/// The register number of a real register the scheduler can track, or NoReg
+int32_t
+trackedRegisterNumber(TR::Register *reg)
+   {
+   TR::RealRegister *realReg = reg->getRealRegister();
+   if (realReg == NULL)
+      return TR::RealRegister::NoReg;
+
+   TR::RealRegister::RegNum regNum = realReg->getRegisterNumber();
+   if ((regNum >= TR::RealRegister::FirstGPR && regNum <= TR::RealRegister::LastGPR) ||
+       (regNum >= TR::RealRegister::FirstXMMR && regNum <= TR::RealRegister::LastXMMR) ||
+       regNum == TR::RealRegister::vfp)
+      return regNum;
+
+   return TR::RealRegister::NoReg;
+   }
+
+struct ScheduleNode
+   {
+   TR::Instruction *_instr;
+   TR_X86OperationClass _class;
+   bool _hasOperation;           // false for a plain load or store
+   bool _loads;
+   bool _stores;
+   TR::MemoryReference *_memRef; // the memory accessed, if any
+   int32_t _accessSize;
+   int32_t _baseVersion;         // number of earlier definitions of the base register in the region
+   int32_t _indexVersion;
+   int32_t _def;                 // register written, or NoReg
+   int32_t _uses[5];
+   int32_t _numUses;
+   uint8_t _testedFlags;
+   uint8_t _modifiedFlags;
+   bool _fullFlagsModifier;      // overwrites all of the flags
+   bool _flagsLive;              // the flags set are consumed or may be live out of the region
+   int32_t _latency;
+   int32_t _priority;            // longest latency path to the end of the region
+   int32_t _earliestCycle;
+   int32_t _numPredecessors;     // not yet scheduled
+   bool _scheduled;
+   };
+
+struct ScheduleEdge
+   {
+   int32_t _from;
+   int32_t _to;
+   int32_t _latency;
+   };
+
+bool
+readsRegister(ScheduleNode &node, int32_t regNum)
+   {
+   for (int32_t i = 0; i < node._numUses; i++)
+      if (node._uses[i] == regNum)
+         return true;
+   return false;
+   }
+
+/**
+ * Determines whether the memory accessed by two nodes provably does not
+ * overlap: both are addressed from the same values of the same registers, at
+ * displacements far enough apart for the sizes accessed.
+ */
+bool
+areDisjoint(ScheduleNode &a, ScheduleNode &b)
+   {
+   TR::MemoryReference *mrA = a._memRef;
+   TR::MemoryReference *mrB = b._memRef;
+
+   if (mrA->getDataSnippet() != NULL || mrA->getLabel() != NULL ||
+       mrB->getDataSnippet() != NULL || mrB->getLabel() != NULL)
+      return false;
+
+   TR::Register *baseA = mrA->getBaseRegister();
+   TR::Register *baseB = mrB->getBaseRegister();
+   if ((baseA == NULL) != (baseB == NULL))
+      return false;
+   if (baseA != NULL && (baseA->getRealRegister() != baseB->getRealRegister() || a._baseVersion != b._baseVersion))
+      return false;
+
+   TR::Register *indexA = mrA->getIndexRegister();
+   TR::Register *indexB = mrB->getIndexRegister();
+   if ((indexA == NULL) != (indexB == NULL))
+      return false;
+   if (indexA != NULL &&
+       (indexA->getRealRegister() != indexB->getRealRegister() ||
+        a._indexVersion != b._indexVersion ||
+        mrA->getStride() != mrB->getStride()))
+      return false;
+
+   intptr_t displacementA = mrA->getDisplacement();
+   intptr_t displacementB = mrB->getDisplacement();
+   return displacementA + a._accessSize <= displacementB || displacementB + b._accessSize <= displacementA;
+   }
+
+/// The size of the memory operand of an integer instruction, from its opcode properties
+int32_t
+integerAccessSize(TR::InstOpCode &opCode, bool memoryIsSource)
+   {
+   if (memoryIsSource)
+      {
+      if (opCode.hasByteSource()) return 1;
+      if (opCode.hasShortSource()) return 2;
+      if (opCode.hasIntSource()) return 4;
+      if (opCode.hasLongSource()) return 8;
+      }
+   else
+      {
+      if (opCode.hasByteTarget()) return 1;
+      if (opCode.hasShortTarget()) return 2;
+      if (opCode.hasIntTarget()) return 4;
+      if (opCode.hasLongTarget()) return 8;
+      }
+   return MAX_ACCESS_SIZE;
+   }
+}
+
+TR_X86InstructionScheduler::TR_X86InstructionScheduler(TR::CodeGenerator *cg, const TR_X86SchedulingModel *model)
+   : _cg(cg),
+     _model(model),
+     _trace(cg->comp()->getOption(TR_TraceCG)),
+     _numRegions(0),
+     _numMoved(0)
+   {
+   if (_model == NULL)
+      _model = cg->comp()->target().cpu.isAuthenticAMD() ? &TR_X86SchedulingModel::Zen : &TR_X86SchedulingModel::Skylake;
+   }
+
+TR_X86OperationClass
+TR_X86InstructionScheduler::getOperationClass(TR::Instruction *instr)
+   {
+   uint32_t properties;
+   TR_X86OperationClass opClass = classify(instr->getOpCodeValue(), properties);
+   if (opClass == TR_X86Unschedulable)
+      return TR_X86Unschedulable;
+
+   // Only instructions whose operands are all returned by the accessors below are modelled
+   //
+   switch (instr->getKind())
+      {
+      case TR::Instruction::IsReg:
+      case TR::Instruction::IsRegReg:
+      case TR::Instruction::IsRegImm:
+      case TR::Instruction::IsRegImm64:
+      case TR::Instruction::IsRegRegImm:
+      case TR::Instruction::IsRegRegReg:
+      case TR::Instruction::IsRegMem:
+      case TR::Instruction::IsRegMemImm:
+      case TR::Instruction::IsRegRegMem:
+      case TR::Instruction::IsMemReg:
+      case TR::Instruction::IsMemImm:
+         break;
+      default:
+         return TR_X86Unschedulable;
+      }
+
+   if (instr->getDependencyConditions() != NULL || instr->needsGCMap() || instr->getGCMap() != NULL)
+      return TR_X86Unschedulable;
+
+   TR::Register *target = instr->getTargetRegister();
+   if (target != NULL)
+      {
+      int32_t regNum = trackedRegisterNumber(target);
+      // The stack pointer is tracked by binary encoding to address the frame
+      if (regNum == TR::RealRegister::NoReg || regNum == TR::RealRegister::esp || regNum == TR::RealRegister::vfp)
+         return TR_X86Unschedulable;
+      }
+
+   if ((instr->getSourceRegister() != NULL && trackedRegisterNumber(instr->getSourceRegister()) == TR::RealRegister::NoReg) ||
+       (instr->getSource2ndRegister() != NULL && trackedRegisterNumber(instr->getSource2ndRegister()) == TR::RealRegister::NoReg))
+      return TR_X86Unschedulable;
+
+   TR::MemoryReference *mr = instr->getMemoryReference();
+   if (mr != NULL)
+      {
+      if (mr->getUnresolvedDataSnippet() != NULL || mr->getSymbolReference().isUnresolved())
+         return TR_X86Unschedulable;
+
+      if ((mr->getBaseRegister() != NULL && trackedRegisterNumber(mr->getBaseRegister()) == TR::RealRegister::NoReg) ||
+          (mr->getIndexRegister() != NULL && trackedRegisterNumber(mr->getIndexRegister()) == TR::RealRegister::NoReg))
+         return TR_X86Unschedulable;
+      }
+
+   return opClass;
+   }
+
+bool
+TR_X86InstructionScheduler::perform()
+   {
+   TR::Compilation *comp = _cg->comp();
+   TR::StackMemoryRegion stackMemoryRegion(*comp->trMemory());
+
+   if (_trace)
+      traceMsg(comp, "\nInstruction scheduling for %s\n", _model->_name);
+
+   InstructionVector region(stackMemoryRegion);
+   region.reserve(MAX_REGION_SIZE);
+
+   bool changed = false;
+   TR::Instruction *instr = _cg->getFirstInstruction();
+   while (instr != NULL)
+      {
+      region.clear();
+      while (instr != NULL && region.size() < MAX_REGION_SIZE && getOperationClass(instr) != TR_X86Unschedulable)
+         {
+         region.push_back(instr);
+         instr = instr->getNext();
+         }
+
+      // The instruction following a region is never moved, so the walk can continue from it
+      if (region.size() > 1)
+         changed |= scheduleRegion(region);
+      else if (region.empty())
+         instr = instr->getNext();
+      }
+
+   if (_trace)
+      traceMsg(comp, "Instruction scheduling: %d regions, %d instructions moved\n", _numRegions, _numMoved);
+
+   if (comp->getOptions()->enableDebugCounters())
+      TR::DebugCounter::incStaticDebugCounter(comp, "instructionScheduling/moved", _numMoved);
+
+   return changed;
+   }
+
+bool
+TR_X86InstructionScheduler::scheduleRegion(InstructionVector &region)
+   {
+   TR::Compilation *comp = _cg->comp();
+   int32_t numNodes = static_cast<int32_t>(region.size());
+   const TR_X86OperationCost *costs = _model->_costs;
+
+   _numRegions++;
+
+   TR::vector<ScheduleNode, TR::Region&> nodes(numNodes, comp->trMemory()->currentStackRegion());
+   int32_t registerVersions[TR::RealRegister::NumRegisters] = { 0 };
+
+   // Describe the registers, memory and flags accessed by each instruction
+   //
+   for (int32_t i = 0; i < numNodes; i++)
+      {
+      ScheduleNode &node = nodes[i];
+      TR::Instruction *instr = region[i];
+      TR::InstOpCode &opCode = instr->getOpCode();
+      uint32_t properties;
+
+      node._instr = instr;
+      node._class = classify(instr->getOpCodeValue(), properties);
+      node._numUses = 0;
+      node._def = TR::RealRegister::NoReg;
+      node._scheduled = false;
+      node._numPredecessors = 0;
+      node._earliestCycle = 0;
+
+      TR::Instruction::Kind kind = instr->getKind();
+      bool memoryIsTarget = kind == TR::Instruction::IsMemReg || kind == TR::Instruction::IsMemImm;
+      bool isMove = node._class == TR_X86IntMove || node._class == TR_X86FPMove;
+
+      node._memRef = node._class == TR_X86LoadEffectiveAddress ? NULL : instr->getMemoryReference();
+      node._loads = node._memRef != NULL && (!memoryIsTarget || !isMove);
+      node._stores = node._memRef != NULL && memoryIsTarget && !(properties & ReadsTargetOnly);
+      node._hasOperation = node._memRef == NULL || !isMove;
+
+      if (node._memRef != NULL)
+         {
+         bool isInteger = node._class == TR_X86IntALU || node._class == TR_X86IntMove ||
+                          node._class == TR_X86IntShift || node._class == TR_X86IntMultiply;
+         node._accessSize = isInteger ? integerAccessSize(opCode, !memoryIsTarget) : MAX_ACCESS_SIZE;
+         }
+
+      // Everything an instruction may read is a use. The target is conservatively considered read as well as
+      // written, since some instructions only write part of it.
+      //
+      TR::MemoryReference *mr = instr->getMemoryReference();
+      if (mr != NULL)
+         {
+         if (mr->getBaseRegister() != NULL)
+            {
+            int32_t regNum = trackedRegisterNumber(mr->getBaseRegister());
+            node._uses[node._numUses++] = regNum;
+            node._baseVersion = registerVersions[regNum];
+            }
+         if (mr->getIndexRegister() != NULL)
+            {
+            int32_t regNum = trackedRegisterNumber(mr->getIndexRegister());
+            node._uses[node._numUses++] = regNum;
+            node._indexVersion = registerVersions[regNum];
+            }
+         }
+
+      if (instr->getSourceRegister() != NULL)
+         node._uses[node._numUses++] = trackedRegisterNumber(instr->getSourceRegister());
+      if (instr->getSource2ndRegister() != NULL)
+         node._uses[node._numUses++] = trackedRegisterNumber(instr->getSource2ndRegister());
+      if (instr->getTargetRegister() != NULL)
+         {
+         int32_t regNum = trackedRegisterNumber(instr->getTargetRegister());
+         node._uses[node._numUses++] = regNum;
+         if (!(properties & ReadsTargetOnly))
+            {
+            node._def = regNum;
+            registerVersions[regNum]++;
+            }
+         }
+
+      // Flags modified or tested without being described by the opcode are assumed to be all of them
+      //
+      node._testedFlags = 0;
+      if (properties & TestsFlags)
+         {
+         node._testedFlags = opCode.getTestedEFlags();
+         if (node._testedFlags == 0)
+            node._testedFlags = ALL_EFLAGS;
+         }
+
+      node._modifiedFlags = 0;
+      node._fullFlagsModifier = false;
+      if (properties & ModifiesFlags)
+         {
+         node._modifiedFlags = opCode.getModifiedEFlags();
+         node._fullFlagsModifier = node._modifiedFlags == ALL_EFLAGS;
+         if (node._modifiedFlags == 0)
+            node._modifiedFlags = ALL_EFLAGS;
+         }
+
+      node._latency = 0;
+      if (node._loads)
+         node._latency += costs[TR_X86Load]._latency;
+      if (node._hasOperation)
+         node._latency += costs[node._class]._latency;
+      if (node._latency == 0)
+         node._latency = costs[TR_X86Store]._latency;
+      }
+
+   // The flags set by an instruction are dead if they are overwritten before being tested. The flags set last
+   // in the region are assumed to be live out of it.
+   //
+   for (int32_t i = 0; i < numNodes; i++)
+      {
+      nodes[i]._flagsLive = true;
+      if (nodes[i]._modifiedFlags == 0)
+         continue;
+
+      for (int32_t j = i + 1; j < numNodes; j++)
+         {
+         if (nodes[j]._testedFlags != 0)
+            break;
+         if (nodes[j]._fullFlagsModifier)
+            {
+            nodes[i]._flagsLive = false;
+            break;
+            }
+         }
+      }
+
+   // Build the dependence graph
+   //
+   TR::vector<ScheduleEdge, TR::Region&> edges(comp->trMemory()->currentStackRegion());
+
+   for (int32_t j = 1; j < numNodes; j++)
+      {
+      ScheduleNode &to = nodes[j];
+      for (int32_t i = 0; i < j; i++)
+         {
+         ScheduleNode &from = nodes[i];
+         int32_t latency = -1;
+
+         if (from._def != TR::RealRegister::NoReg && readsRegister(to, from._def))
+            latency = from._latency;
+         else if (to._def != TR::RealRegister::NoReg && (to._def == from._def || readsRegister(from, to._def)))
+            latency = 0;
+         else if ((from._stores && (to._loads || to._stores)) || (from._loads && to._stores))
+            {
+            if (!areDisjoint(from, to))
+               latency = from._stores && to._loads ? costs[TR_X86Store]._latency : 0;
+            }
+
+         if (latency >= 0)
+            {
+            ScheduleEdge edge = { i, j, latency };
+            edges.push_back(edge);
+            }
+         }
+      }
+
+   // Order the flags: a tested flag must come from the same instruction, and a live flag must not be
+   // overwritten before its last test
+   //
+   int32_t lastLiveModifier = -1;
+   TR::vector<int32_t, TR::Region&> testers(comp->trMemory()->currentStackRegion());
+   TR::vector<int32_t, TR::Region&> deadModifiers(comp->trMemory()->currentStackRegion());
+
+   for (int32_t i = 0; i < numNodes; i++)
+      {
+      ScheduleNode &node = nodes[i];
+      if (node._testedFlags != 0)
+         {
+         if (lastLiveModifier >= 0)
+            {
+            ScheduleEdge edge = { lastLiveModifier, i, nodes[lastLiveModifier]._latency };
+            edges.push_back(edge);
+            }
+         testers.push_back(i);
+         }
+
+      if (node._modifiedFlags != 0)
+         {
+         if (lastLiveModifier >= 0)
+            {
+            ScheduleEdge edge = { lastLiveModifier, i, 0 };
+            edges.push_back(edge);
+            }
+         for (size_t k = 0; k < testers.size(); k++)
+            {
+            if (testers[k] != i)
+               {
+               ScheduleEdge edge = { testers[k], i, 0 };
+               edges.push_back(edge);
+               }
+            }
+
+         if (node._flagsLive)
+            {
+            for (size_t k = 0; k < deadModifiers.size(); k++)
+               {
+               ScheduleEdge edge = { deadModifiers[k], i, 0 };
+               edges.push_back(edge);
+               }
+            lastLiveModifier = i;
+            testers.clear();
+            deadModifiers.clear();
+            }
+         else
+            {
+            deadModifiers.push_back(i);
+            }
+         }
+      }
+
+   // Group the edges by their source
+   //
+   TR::vector<int32_t, TR::Region&> firstSuccessor(numNodes + 1, 0, comp->trMemory()->currentStackRegion());
+   TR::vector<ScheduleEdge, TR::Region&> successors(edges.size(), comp->trMemory()->currentStackRegion());
+
+   for (size_t e = 0; e < edges.size(); e++)
+      {
+      firstSuccessor[edges[e]._from + 1]++;
+      nodes[edges[e]._to]._numPredecessors++;
+      }
+   for (int32_t i = 0; i < numNodes; i++)
+      firstSuccessor[i + 1] += firstSuccessor[i];
+   for (size_t e = 0; e < edges.size(); e++)
+      successors[firstSuccessor[edges[e]._from]++] = edges[e];
+
+   // Filling in the edges advanced each start to the start of the next source
+   //
+   for (int32_t i = numNodes; i > 0; i--)
+      firstSuccessor[i] = firstSuccessor[i - 1];
+   firstSuccessor[0] = 0;
+
+   // Every edge goes forwards in the original order, so priorities can be computed in reverse
+   //
+   for (int32_t i = numNodes - 1; i >= 0; i--)
+      {
+      ScheduleNode &node = nodes[i];
+      node._priority = node._latency;
+      for (int32_t e = firstSuccessor[i]; e < firstSuccessor[i + 1]; e++)
+         {
+         int32_t pathLength = successors[e]._latency + nodes[successors[e]._to]._priority;
+         if (pathLength > node._priority)
+            node._priority = pathLength;
+         }
+      }
+
+   // List schedule cycle by cycle
+   //
+   TR::vector<int32_t, TR::Region&> order(comp->trMemory()->currentStackRegion());
+   TR::vector<int32_t, TR::Region&> portBusyUntil(_model->_numPorts, 0, comp->trMemory()->currentStackRegion());
+   order.reserve(numNodes);
+
+   int32_t cycleLimit = 0;
+   for (int32_t i = 0; i < numNodes; i++)
+      cycleLimit += nodes[i]._priority + 3 * costs[nodes[i]._class]._occupancy + 1;
+
+   for (int32_t cycle = 0; static_cast<int32_t>(order.size()) < numNodes; cycle++)
+      {
+      if (cycle > cycleLimit)
+         {
+         TR_ASSERT(false, "Instruction scheduling did not converge");
+         return false;
+         }
+
+      for (int32_t issued = 0; issued < _model->_issueWidth; issued++)
+         {
+         int32_t best = -1;
+         uint32_t bestPorts = 0;
+
+         for (int32_t i = 0; i < numNodes; i++)
+            {
+            ScheduleNode &node = nodes[i];
+            if (node._scheduled || node._numPredecessors > 0 || node._earliestCycle > cycle)
+               continue;
+            if (best >= 0 && node._priority <= nodes[best]._priority)
+               continue;
+
+            // Find a free port for each of the operations of the instruction
+            //
+            uint32_t usedPorts = 0;
+            TR_X86OperationClass operations[3];
+            int32_t numOperations = 0;
+            if (node._loads)
+               operations[numOperations++] = TR_X86Load;
+            if (node._hasOperation)
+               operations[numOperations++] = node._class;
+            if (node._stores)
+               operations[numOperations++] = TR_X86Store;
+
+            bool fits = true;
+            for (int32_t o = 0; o < numOperations && fits; o++)
+               {
+               uint32_t candidates = costs[operations[o]]._ports & ~usedPorts;
+               uint32_t port = 0;
+               for (int32_t p = 0; p < _model->_numPorts; p++)
+                  {
+                  if ((candidates & (1 << p)) && portBusyUntil[p] <= cycle)
+                     {
+                     port = 1 << p;
+                     break;
+                     }
+                  }
+               if (port == 0)
+                  fits = false;
+               usedPorts |= port;
+               }
+
+            if (fits)
+               {
+               best = i;
+               bestPorts = usedPorts;
+               }
+            }
+
+         if (best < 0)
+            break;
+
+         ScheduleNode &node = nodes[best];
+         node._scheduled = true;
+         order.push_back(best);
+
+         for (int32_t p = 0; p < _model->_numPorts; p++)
+            {
+            if (bestPorts & (1 << p))
+               {
+               // Only the operation of the instruction can occupy its port for more than a cycle
+               bool isOperationPort = node._hasOperation && (costs[node._class]._ports & (1 << p));
+               portBusyUntil[p] = cycle + (isOperationPort ? costs[node._class]._occupancy : 1);
+               }
+            }
+
+         for (int32_t e = firstSuccessor[best]; e < firstSuccessor[best + 1]; e++)
+            {
+            ScheduleNode &successor = nodes[successors[e]._to];
+            successor._numPredecessors--;
+            if (cycle + successors[e]._latency > successor._earliestCycle)
+               successor._earliestCycle = cycle + successors[e]._latency;
+            }
+         }
+      }
+
+   int32_t numMoved = 0;
+   for (int32_t i = 0; i < numNodes; i++)
+      if (order[i] != i)
+         numMoved++;
+
+   if (numMoved == 0)
+      return false;
+
+   if (_trace)
+      {
+      traceMsg(comp, "Scheduled region of %d instructions starting at %s, %d moved:", numNodes,
+         comp->getDebug() ? comp->getDebug()->getName(region[0]) : "", numMoved);
+      for (int32_t i = 0; i < numNodes; i++)
+         traceMsg(comp, " %d", order[i]);
+      traceMsg(comp, "\n");
+      }
+
+   // Relink the instructions in their new order
+   //
+   TR::Instruction *prev = region[0]->getPrev();
+   TR::Instruction *next = region[numNodes - 1]->getNext();
+   for (int32_t i = 0; i < numNodes; i++)
+      {
+      TR::Instruction *instr = region[order[i]];
+      instr->setPrev(prev);
+      if (prev != NULL)
+         prev->setNext(instr);
+      else
+         _cg->setFirstInstruction(instr);
+      prev = instr;
+      }
+   prev->setNext(next);
+   if (next != NULL)
+      next->setPrev(prev);
+   else
+      _cg->setAppendInstruction(prev);
+
+   _numMoved += numMoved;
+   return true;
+   }
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef X86INSTRUCTIONSCHEDULER_INCL
+#define X86INSTRUCTIONSCHEDULER_INCL
+
+#include <stdint.h>
+#include "env/TRMemory.hpp"
+#include "infra/vector.hpp"
+
+namespace TR { class CodeGenerator; }
+namespace TR { class Instruction; }
+
+/**
+ * The classes of operation distinguished by the scheduling models. An
+ * instruction with a memory operand is modelled as its operation plus a load
+ * and/or a store.
+ */
+enum TR_X86OperationClass
+   {
+   TR_X86Unschedulable = 0,            // not modelled; ends a scheduling region
+   TR_X86IntALU,
+   TR_X86IntMove,
+   TR_X86IntShift,
+   TR_X86IntMultiply,
+   TR_X86LoadEffectiveAddress,
+   TR_X86Load,
+   TR_X86Store,
+   TR_X86FPMove,
+   TR_X86FPAdd,
+   TR_X86FPMultiply,
+   TR_X86FPFusedMultiplyAdd,
+   TR_X86FPDivide,
+   TR_X86FPSqrt,
+   TR_X86FPConvert,
+   TR_X86VectorALU,
+   TR_X86VectorMultiply,
+   TR_X86VectorShuffle,
+   TR_X86NumOperationClasses
+   };
+
+/**
+ * The cost of a class of operation on a microarchitecture.
+ */
+struct TR_X86OperationCost
+   {
+   uint8_t _latency;                   // cycles until the result can be consumed
+   uint8_t _occupancy;                 // cycles the execution port stays busy; 1 when fully pipelined
+   uint16_t _ports;                    // mask of the execution ports that can execute the operation
+   };
+
+/**
+ * A latency and execution port model of an x86 microarchitecture.
+ */
+struct TR_X86SchedulingModel
+   {
+   const char *_name;
+   uint8_t _issueWidth;                // instructions issued per cycle
+   uint8_t _numPorts;
+   TR_X86OperationCost _costs[TR_X86NumOperationClasses];
+
+   static const TR_X86SchedulingModel Skylake;
+   static const TR_X86SchedulingModel Zen;
+   };
+
+/**
+ * Class TR_X86InstructionScheduler
+ * ================================
+ *
+ * List scheduling of the final x86 instruction stream, run after register
+ * assignment and peephole optimization.
+ *
+ * The stream is split into regions of straight line code that only contain
+ * instructions whose operands and costs are known to the scheduler. Labels,
+ * branches, calls, pseudo instructions, instructions with register
+ * dependencies or GC maps, and anything that changes the stack pointer end a
+ * region. Within a region a dependence graph is built over the real
+ * registers, memory and the flags, and the instructions are reordered
+ * cycle by cycle, each time issuing the ready instruction with the longest
+ * latency path to the end of the region for which an execution port is
+ * free.
+ *
+ * Memory accesses are only reordered when they are both loads or when they
+ * use the same base and index registers at disjoint displacements. A
+ * modification of the flags is only moved if its flags are not consumed.
+ *
+ * The latencies and ports come from a model of the target: Zen for AMD
+ * processors and Skylake otherwise.
+ */
+class TR_X86InstructionScheduler
+   {
+   public:
+   TR_ALLOC(TR_Memory::CodeGenerator)
+
+   /**
+    * @param cg the code generator
+    * @param model the model to schedule for, or NULL for the model of the target processor
+    */
+   TR_X86InstructionScheduler(TR::CodeGenerator *cg, const TR_X86SchedulingModel *model = NULL);
+
+   /**
+    * @brief Schedules every region of the instruction stream
+    * @return true if any instruction was moved
+    */
+   bool perform();
+
+   const TR_X86SchedulingModel &getModel() { return *_model; }
+
+   /**
+    * @brief Returns the class of operation performed by an instruction
+    * @return the class, or TR_X86Unschedulable if the instruction must not be moved
+    */
+   static TR_X86OperationClass getOperationClass(TR::Instruction *instr);
+
+   private:
+
+   typedef TR::vector<TR::Instruction *, TR::Region&> InstructionVector;
+
+   bool scheduleRegion(InstructionVector &region);
+
+   TR::CodeGenerator *_cg;
+   const TR_X86SchedulingModel *_model;
+   bool _trace;
+   int32_t _numRegions;
+   int32_t _numMoved;
+   };
+
+#endif
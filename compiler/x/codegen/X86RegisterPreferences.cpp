@@ -0,0 +1,267 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "x/codegen/X86RegisterPreferences.hpp"
+
+#include <algorithm>
+#include <stdint.h>
+#include "codegen/CodeGenerator.hpp"
+#include "codegen/Instruction.hpp"
+#include "codegen/Machine.hpp"
+#include "codegen/RealRegister.hpp"
+#include "codegen/Register.hpp"
+#include "compile/Compilation.hpp"
+#include "control/Options.hpp"
+#include "control/Options_inlines.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/IO.hpp"
+#include "infra/Array.hpp"
+#include "ras/DebugCounter.hpp"
+
+// Bit of a register's interference mask that requests a byte addressable register
+#define BYTE_REGISTER_INTERFERENCE 0x80000000
+
+namespace
+{
+struct StartsLater
+   {
+   bool operator()(TR_X86LiveInterval *a, TR_X86LiveInterval *b) const
+      {
+      return a->_start > b->_start;
+      }
+   };
+}
+
+TR_X86RegisterPreferences::TR_X86RegisterPreferences(TR::CodeGenerator *cg)
+   : _cg(cg),
+     _trace(cg->comp()->getOption(TR_TraceRA)),
+     _numSplits(0),
+     _numWithoutPreference(0)
+   {
+   }
+
+void
+TR_X86RegisterPreferences::perform(TR_RegisterKinds kindsToAssign)
+   {
+   TR::Compilation *comp = _cg->comp();
+   LexicalTimer t("register preferences", comp->phaseTimer());
+
+   IntervalVector gprIntervals(IntervalAllocator(comp->allocator()));
+   IntervalVector xmmIntervals(IntervalAllocator(comp->allocator()));
+
+   // Build one interval per virtual register from the range of instructions it is used in
+   //
+   TR_Array<TR::Register *> &registers = _cg->getRegisterArray();
+   for (int32_t i = 0; i < registers.size(); i++)
+      {
+      TR::Register *virtReg = registers[i];
+      if (!virtReg ||
+          virtReg->getRealRegister() ||
+          virtReg->getRegisterPair() ||
+          virtReg->isPlaceholderReg() ||
+          virtReg->getAssignedRegister() ||
+          !virtReg->getStartOfRange() ||
+          !virtReg->getEndOfRange() ||
+          !(kindsToAssign & TO_KIND_MASK(virtReg->getKind())))
+         continue;
+
+      bool isGPR = virtReg->getKind() == TR_GPR;
+      if (!isGPR && virtReg->getKind() != TR_FPR && virtReg->getKind() != TR_VRF)
+         continue;
+
+      uint32_t start = virtReg->getStartOfRange()->getIndex();
+      uint32_t end = virtReg->getEndOfRange()->getIndex();
+      if (end < start)
+         continue;
+
+      TR_X86LiveInterval *interval = new (_cg->trHeapMemory()) TR_X86LiveInterval(virtReg, start, end);
+      virtReg->setLiveInterval(interval);
+
+      if (isGPR)
+         gprIntervals.push_back(interval);
+      else
+         xmmIntervals.push_back(interval);
+      }
+
+   if (_trace)
+      traceMsg(comp, "\nRegister preferences: %d GPR and %d XMM intervals\n", (int32_t)gprIntervals.size(), (int32_t)xmmIntervals.size());
+
+   choosePreferences(gprIntervals, TR::RealRegister::FirstGPR, TR::RealRegister::LastAssignableGPR);
+   choosePreferences(xmmIntervals, TR::RealRegister::FirstXMMR, TR::RealRegister::LastXMMR);
+
+   if (_trace)
+      traceMsg(comp, "Register preferences: %d splits, %d intervals without a preference\n", _numSplits, _numWithoutPreference);
+
+   if (comp->getOptions()->enableDebugCounters())
+      {
+      TR::DebugCounter::incStaticDebugCounter(comp, "registerPreferences/splits", _numSplits);
+      TR::DebugCounter::incStaticDebugCounter(comp, "registerPreferences/none", _numWithoutPreference);
+      }
+   }
+
+bool
+TR_X86RegisterPreferences::canUse(TR_X86LiveInterval *interval, int32_t reg, int32_t firstReg)
+   {
+   uint32_t interference = interval->_virtual->getInterference();
+   if (interference & (1 << (reg - firstReg)))
+      return false;
+
+   if ((interference & BYTE_REGISTER_INTERFERENCE) && interval->_virtual->getKind() == TR_GPR && reg > TR::RealRegister::Last8BitGPR)
+      return false;
+
+   return true;
+   }
+
+TR_X86LiveInterval *
+TR_X86RegisterPreferences::split(TR_X86LiveInterval *interval, uint32_t position)
+   {
+   if (position <= interval->_start || position >= interval->_end)
+      return NULL;
+
+   TR_X86LiveInterval *rest = new (_cg->trHeapMemory()) TR_X86LiveInterval(interval->_virtual, position, interval->_end);
+   rest->_next = interval->_next;
+   interval->_next = rest;
+   interval->_end = position;
+   _numSplits++;
+
+   if (_trace)
+      traceMsg(_cg->comp(), "   split %s at %u\n", _cg->getDebug() ? _cg->getDebug()->getName(interval->_virtual) : "", position);
+
+   return rest;
+   }
+
+void
+TR_X86RegisterPreferences::choosePreferences(IntervalVector &unhandled, int32_t firstReg, int32_t lastReg)
+   {
+   TR_ASSERT(lastReg - firstReg < 32, "Too many registers for an interference mask");
+
+   TR_X86LiveInterval *active[32];
+   bool available[32];
+   int32_t numRegs = lastReg - firstReg + 1;
+   for (int32_t r = 0; r < numRegs; r++)
+      {
+      active[r] = NULL;
+      available[r] = _cg->machine()->getRealRegister((TR::RealRegister::RegNum)(firstReg + r))->getState() != TR::RealRegister::Locked;
+      }
+
+   std::make_heap(unhandled.begin(), unhandled.end(), StartsLater());
+   while (!unhandled.empty())
+      {
+      std::pop_heap(unhandled.begin(), unhandled.end(), StartsLater());
+      TR_X86LiveInterval *current = unhandled.back();
+      unhandled.pop_back();
+
+      uint32_t position = current->_start;
+
+      // Release the registers of intervals that have ended
+      //
+      for (int32_t r = 0; r < numRegs; r++)
+         {
+         if (active[r] && active[r]->_end <= position)
+            active[r] = NULL;
+         }
+
+      // Prefer the register of the previous segment of a split interval to avoid a move
+      //
+      int32_t chosen = -1;
+      TR_X86LiveInterval *previous = current->_virtual->getLiveInterval();
+      while (previous && previous->_next != current)
+         previous = previous->_next;
+      if (previous && previous->_preferred != TR::RealRegister::NoReg)
+         {
+         int32_t r = previous->_preferred - firstReg;
+         if (!active[r] && canUse(current, previous->_preferred, firstReg))
+            chosen = r;
+         }
+
+      for (int32_t r = 0; chosen < 0 && r < numRegs; r++)
+         {
+         if (available[r] && !active[r] && canUse(current, firstReg + r, firstReg))
+            chosen = r;
+         }
+
+      if (chosen >= 0)
+         {
+         current->_preferred = (TR::RealRegister::RegNum)(firstReg + chosen);
+         active[chosen] = current;
+         continue;
+         }
+
+      // No register is left to prefer. Take the register of the usable active interval that
+      // ends last if it lives longer than the current one, otherwise leave the current interval
+      // without a preference until the first usable register becomes free.
+      //
+      int32_t latest = -1;
+      int32_t earliest = -1;
+      for (int32_t r = 0; r < numRegs; r++)
+         {
+         if (!active[r] || !canUse(current, firstReg + r, firstReg))
+            continue;
+         if (latest < 0 || active[r]->_end > active[latest]->_end)
+            latest = r;
+         if (earliest < 0 || active[r]->_end < active[earliest]->_end)
+            earliest = r;
+         }
+
+      if (latest >= 0 && active[latest]->_end > current->_end)
+         {
+         TR_X86LiveInterval *evicted = active[latest];
+         TR_X86LiveInterval *rest = split(evicted, position);
+         if (rest)
+            {
+            unhandled.push_back(rest);
+            std::push_heap(unhandled.begin(), unhandled.end(), StartsLater());
+            }
+         else
+            {
+            evicted->_preferred = TR::RealRegister::NoReg;
+            _numWithoutPreference++;
+            }
+
+         current->_preferred = (TR::RealRegister::RegNum)(firstReg + latest);
+         active[latest] = current;
+         }
+      else
+         {
+         _numWithoutPreference++;
+         TR_X86LiveInterval *rest = earliest >= 0 ? split(current, active[earliest]->_end) : NULL;
+         if (rest)
+            {
+            unhandled.push_back(rest);
+            std::push_heap(unhandled.begin(), unhandled.end(), StartsLater());
+            }
+         }
+      }
+   }
+
+TR::RealRegister::RegNum
+TR_X86RegisterPreferences::getPreferredRegister(TR::Register *virtReg, TR::Instruction *instr)
+   {
+   TR_X86LiveInterval *interval = virtReg->getLiveInterval();
+   if (!interval || !instr)
+      return TR::RealRegister::NoReg;
+
+   uint32_t index = instr->getIndex();
+   while (interval->_next && interval->_next->_start <= index)
+      interval = interval->_next;
+
+   return interval->_preferred;
+   }
@@ -0,0 +1,117 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef X86REGISTERPREFERENCES_INCL
+#define X86REGISTERPREFERENCES_INCL
+
+#include <stdint.h>
+#include <vector>
+#include "codegen/RealRegister.hpp"
+#include "codegen/RegisterConstants.hpp"
+#include "env/TRMemory.hpp"
+#include "env/TypedAllocator.hpp"
+
+namespace TR { class CodeGenerator; }
+namespace TR { class Instruction; }
+namespace TR { class Register; }
+
+/**
+ * A segment of the approximate live range of a virtual register. A virtual
+ * register starts out with a single interval covering its whole range, which
+ * is split into a chain of intervals when no register is left to prefer.
+ */
+class TR_X86LiveInterval
+   {
+   public:
+   TR_ALLOC(TR_Memory::Register)
+
+   TR_X86LiveInterval(TR::Register *virtReg, uint32_t start, uint32_t end)
+      : _virtual(virtReg), _start(start), _end(end), _preferred(TR::RealRegister::NoReg), _next(NULL)
+      {}
+
+   TR::Register *_virtual;
+   uint32_t _start;                      // instruction index of the first use
+   uint32_t _end;                        // instruction index of the last use
+   TR::RealRegister::RegNum _preferred;  // register preferred for this segment, or NoReg
+   TR_X86LiveInterval *_next;            // later segment of the same virtual register
+   };
+
+/**
+ * Class TR_X86RegisterPreferences
+ * ===============================
+ *
+ * Whole-method register preferences for x86-64, selected with the
+ * enableRegisterPreferences option (which can be limited to some
+ * optimization levels with an option set such as
+ * `{*}{hot|scorching}(enableRegisterPreferences)`).
+ *
+ * This is a heuristic that steers the backwards local register assigner, not
+ * a register allocator. The local assigner still decides every assignment,
+ * spill, coercion and dependency, and is free to ignore a preference.
+ *
+ * The range of a GPR or XMM virtual register is approximated by the indices
+ * of the first and last instructions that use it, so it ignores control flow
+ * and any holes in the range. The real registers it must avoid come from
+ * the interference computed by TR_LiveRegisters. Ranges are visited in order
+ * of their start, linear scan style, and each is given a register not
+ * preferred by an overlapping range. When none is left, either the new range
+ * or the overlapping range that ends last is split where the conflict
+ * begins, and the remainder is considered again later.
+ *
+ * When the local assigner needs a real register for a virtual register, it
+ * takes the one preferred at the current instruction if that register is
+ * free, before falling back to its usual choice.
+ */
+class TR_X86RegisterPreferences
+   {
+   public:
+   TR_ALLOC(TR_Memory::Register)
+
+   TR_X86RegisterPreferences(TR::CodeGenerator *cg);
+
+   /**
+    * @brief Chooses preferred registers for the virtual registers of the given kinds
+    * @param kindsToAssign mask of the register kinds to consider
+    */
+   void perform(TR_RegisterKinds kindsToAssign);
+
+   /**
+    * @brief Returns the real register preferred for a virtual register at an instruction
+    * @return the preferred register, or NoReg if there is none
+    */
+   static TR::RealRegister::RegNum getPreferredRegister(TR::Register *virtReg, TR::Instruction *instr);
+
+   private:
+
+   typedef TR::typed_allocator<TR_X86LiveInterval *, TR::Allocator> IntervalAllocator;
+   typedef std::vector<TR_X86LiveInterval *, IntervalAllocator> IntervalVector;
+
+   void choosePreferences(IntervalVector &unhandled, int32_t firstReg, int32_t lastReg);
+   TR_X86LiveInterval *split(TR_X86LiveInterval *interval, uint32_t position);
+   bool canUse(TR_X86LiveInterval *interval, int32_t reg, int32_t firstReg);
+
+   TR::CodeGenerator *_cg;
+   bool _trace;
+   int32_t _numSplits;
+   int32_t _numWithoutPreference;
+   };
+
+#endif
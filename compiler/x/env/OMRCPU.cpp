@@ -40,7 +40,10 @@ OMR::X86::CPU::detect(OMRPortLibrary * const omrPortLib)
                                         OMR_FEATURE_X86_MMX, OMR_FEATURE_X86_SSE, OMR_FEATURE_X86_SSE2,
                                         OMR_FEATURE_X86_SSSE3, OMR_FEATURE_X86_SSE4_1, OMR_FEATURE_X86_POPCNT,
                                         OMR_FEATURE_X86_AESNI, OMR_FEATURE_X86_OSXSAVE, OMR_FEATURE_X86_AVX,
-                                        OMR_FEATURE_X86_FMA, OMR_FEATURE_X86_HLE, OMR_FEATURE_X86_RTM};
+                                        OMR_FEATURE_X86_FMA, OMR_FEATURE_X86_HLE, OMR_FEATURE_X86_RTM,
+                                        OMR_FEATURE_X86_AVX2, OMR_FEATURE_X86_AVX512F, OMR_FEATURE_X86_AVX512DQ,
+                                        OMR_FEATURE_X86_AVX512BW, OMR_FEATURE_X86_AVX512VL, OMR_FEATURE_X86_BMI1,
+                                        OMR_FEATURE_X86_BMI2};
 
    OMRPORT_ACCESS_FROM_OMRPORT(omrPortLib);
    OMRProcessorDesc featureMasks;
@@ -59,11 +62,20 @@ OMR::X86::CPU::detect(OMRPortLibrary * const omrPortLib)
 
    if (TRUE == omrsysinfo_processor_has_feature(&processorDescription, OMR_FEATURE_X86_OSXSAVE))
       {
-      if (((6 & _xgetbv(0)) != 6) || feGetEnv("TR_DisableAVX")) // '6' = mask for XCR0[2:1]='11b' (XMM state and YMM state are enabled)
+      unsigned long long xcr0 = _xgetbv(0);
+      if (((6 & xcr0) != 6) || feGetEnv("TR_DisableAVX")) // '6' = mask for XCR0[2:1]='11b' (XMM state and YMM state are enabled)
          {
          // Unset OSXSAVE if not enabled via CR0
          omrsysinfo_processor_set_feature(&processorDescription, OMR_FEATURE_X86_OSXSAVE, FALSE);
          }
+      if (((0xE6 & xcr0) != 0xE6) || feGetEnv("TR_DisableAVX512")) // '0xE6' = mask for XCR0[7:5,2:1] (opmask, ZMM_Hi256 and Hi16_ZMM state are also enabled)
+         {
+         // The OS does not preserve the AVX-512 register state
+         omrsysinfo_processor_set_feature(&processorDescription, OMR_FEATURE_X86_AVX512F, FALSE);
+         omrsysinfo_processor_set_feature(&processorDescription, OMR_FEATURE_X86_AVX512DQ, FALSE);
+         omrsysinfo_processor_set_feature(&processorDescription, OMR_FEATURE_X86_AVX512BW, FALSE);
+         omrsysinfo_processor_set_feature(&processorDescription, OMR_FEATURE_X86_AVX512VL, FALSE);
+         }
       }
 
    return TR::CPU(processorDescription);
@@ -228,6 +240,51 @@ OMR::X86::CPU::supportsAVX()
    return self()->supportsFeature(OMR_FEATURE_X86_AVX) && self()->supportsFeature(OMR_FEATURE_X86_OSXSAVE);
    }
 
+bool
+OMR::X86::CPU::supportsAVX2()
+   {
+   if (TR::Compiler->omrPortLib == NULL)
+      return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX2();
+
+   return self()->supportsFeature(OMR_FEATURE_X86_AVX2) && self()->supportsFeature(OMR_FEATURE_X86_OSXSAVE);
+   }
+
+bool
+OMR::X86::CPU::supportsAVX512F()
+   {
+   if (TR::Compiler->omrPortLib == NULL)
+      return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512F();
+
+   return self()->supportsFeature(OMR_FEATURE_X86_AVX512F) && self()->supportsFeature(OMR_FEATURE_X86_OSXSAVE);
+   }
+
+bool
+OMR::X86::CPU::supportsAVX512BW()
+   {
+   if (TR::Compiler->omrPortLib == NULL)
+      return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512BW();
+
+   return self()->supportsAVX512F() && self()->supportsFeature(OMR_FEATURE_X86_AVX512BW);
+   }
+
+bool
+OMR::X86::CPU::supportsAVX512DQ()
+   {
+   if (TR::Compiler->omrPortLib == NULL)
+      return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512DQ();
+
+   return self()->supportsAVX512F() && self()->supportsFeature(OMR_FEATURE_X86_AVX512DQ);
+   }
+
+bool
+OMR::X86::CPU::supportsAVX512VL()
+   {
+   if (TR::Compiler->omrPortLib == NULL)
+      return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512VL();
+
+   return self()->supportsAVX512F() && self()->supportsFeature(OMR_FEATURE_X86_AVX512VL);
+   }
+
 bool
 OMR::X86::CPU::is(OMRProcessorArchitecture p)
    {
@@ -382,6 +439,20 @@ OMR::X86::CPU::supports_feature_test(uint32_t feature)
          return TR::CodeGenerator::getX86ProcessorInfo().hasThermalMonitor() == ans;
       case OMR_FEATURE_X86_AVX:
          return true;
+      case OMR_FEATURE_X86_AVX2:
+         return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX2() == (ans && TR::CodeGenerator::getX86ProcessorInfo().enabledXSAVE());
+      case OMR_FEATURE_X86_AVX512F:
+         return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512F() == (ans && TR::CodeGenerator::getX86ProcessorInfo().enabledXSAVE());
+      case OMR_FEATURE_X86_AVX512DQ:
+         return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512DQ() == (ans && TR::CodeGenerator::getX86ProcessorInfo().enabledXSAVE());
+      case OMR_FEATURE_X86_AVX512BW:
+         return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512BW() == (ans && TR::CodeGenerator::getX86ProcessorInfo().enabledXSAVE());
+      case OMR_FEATURE_X86_AVX512VL:
+         return TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512VL() == (ans && TR::CodeGenerator::getX86ProcessorInfo().enabledXSAVE());
+      case OMR_FEATURE_X86_BMI1:
+         return TR::CodeGenerator::getX86ProcessorInfo().supportsBMI1() == (ans && TR::CodeGenerator::getX86ProcessorInfo().enabledXSAVE());
+      case OMR_FEATURE_X86_BMI2:
+         return TR::CodeGenerator::getX86ProcessorInfo().supportsBMI2() == (ans && TR::CodeGenerator::getX86ProcessorInfo().enabledXSAVE());
       default:
          return false;
       }
@@ -566,6 +637,27 @@ OMR::X86::CPU::supports_feature_old_api(uint32_t feature)
       case OMR_FEATURE_X86_TM:
          supported = TR::CodeGenerator::getX86ProcessorInfo().hasThermalMonitor();
          break;
+      case OMR_FEATURE_X86_AVX2:
+         supported = TR::CodeGenerator::getX86ProcessorInfo().supportsAVX2();
+         break;
+      case OMR_FEATURE_X86_AVX512F:
+         supported = TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512F();
+         break;
+      case OMR_FEATURE_X86_AVX512DQ:
+         supported = TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512DQ();
+         break;
+      case OMR_FEATURE_X86_AVX512BW:
+         supported = TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512BW();
+         break;
+      case OMR_FEATURE_X86_AVX512VL:
+         supported = TR::CodeGenerator::getX86ProcessorInfo().supportsAVX512VL();
+         break;
+      case OMR_FEATURE_X86_BMI1:
+         supported = TR::CodeGenerator::getX86ProcessorInfo().supportsBMI1();
+         break;
+      case OMR_FEATURE_X86_BMI2:
+         supported = TR::CodeGenerator::getX86ProcessorInfo().supportsBMI2();
+         break;
       default:
          TR_ASSERT_FATAL(false, "Unknown feature %d", feature);
          break;
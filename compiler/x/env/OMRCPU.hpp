@@ -101,6 +101,11 @@ public:
    bool supportsSFence();
    bool prefersMultiByteNOP();
    bool supportsAVX();
+   bool supportsAVX2();
+   bool supportsAVX512F();
+   bool supportsAVX512BW();
+   bool supportsAVX512DQ();
+   bool supportsAVX512VL();
 
    /**
     * It is generally safe to assume that all modern operating systems
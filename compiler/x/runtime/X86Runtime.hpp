@@ -89,11 +89,17 @@ inline bool jitGetCPUID(TR_X86CPUIDBuffer* pBuffer)
       // Check for XSAVE
       if(pBuffer->_featureFlags2 & TR_OSXSAVE)
          {
-         if(((6 & _xgetbv(0)) != 6) || feGetEnv("TR_DisableAVX")) // '6' = mask for XCR0[2:1]='11b' (XMM state and YMM state are enabled)
+         unsigned long long xcr0 = _xgetbv(0);
+         if(((6 & xcr0) != 6) || feGetEnv("TR_DisableAVX")) // '6' = mask for XCR0[2:1]='11b' (XMM state and YMM state are enabled)
             {
             // Unset OSXSAVE if not enabled via CR0
             pBuffer->_featureFlags2 &= ~TR_OSXSAVE;
             }
+         if(((0xE6 & xcr0) != 0xE6) || feGetEnv("TR_DisableAVX512")) // '0xE6' = mask for XCR0[7:5,2:1] (opmask, ZMM_Hi256 and Hi16_ZMM state are also enabled)
+            {
+            // The OS does not preserve the AVX-512 register state
+            pBuffer->_featureFlags8 &= ~(TR_AVX512F | TR_AVX512DQ | TR_AVX512BW | TR_AVX512VL);
+            }
          }
 
       /* Mask out the bits the compiler does not care about.
@@ -31,6 +31,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/env/FrontEnd.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/Assert.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/BitVector.cpp \
+    $(JIT_OMR_DIRTY_DIR)/infra/HybridBitVector.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/Checklist.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/HashTab.cpp \
     $(JIT_OMR_DIRTY_DIR)/infra/STLUtils.cpp \
@@ -75,12 +76,14 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/env/OMRDebugEnv.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRVMEnv.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRVMMethodEnv.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/SegmentCache.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SegmentAllocator.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/SystemSegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/DebugSegmentProvider.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/Region.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/StackMemoryRegion.cpp \
+    $(JIT_OMR_DIRTY_DIR)/env/SubRegion.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/OMRPersistentInfo.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/TRMemory.cpp \
     $(JIT_OMR_DIRTY_DIR)/env/TRPersistentMemory.cpp \
@@ -105,6 +108,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/optimizer/CatchBlockRemover.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/OMRCFGSimplifier.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/CompactLocals.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/CompileBudget.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/CopyPropagation.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/DataFlowAnalysis.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/DeadStoreElimination.cpp \
@@ -115,11 +119,13 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/optimizer/DominatorVerifier.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/DominatorsChk.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/Earliestness.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/EdgeProfiler.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/ExpressionsSimplification.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/FieldPrivatizer.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/GeneralLoopUnroller.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/GlobalAnticipatability.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/GlobalRegisterAllocator.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/IfConversion.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/Inliner.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/RematTools.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/InductionVariable.cpp \
@@ -139,6 +145,8 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/optimizer/LoopCanonicalizer.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/LoopReducer.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/LoopReplicator.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/LoopVectorizer.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/LoopDependence.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/LoopVersioner.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/OMRLocalCSE.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/LocalDeadStoreElimination.cpp \
@@ -153,6 +161,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/optimizer/PreExistence.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/Reachability.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/ReachingDefinitions.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/RecompilationCounters.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/OMRRecognizedCallTransformer.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/RedundantAsyncCheckRemoval.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/RegisterCandidate.cpp \
@@ -162,6 +171,7 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/optimizer/StructuralAnalysis.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/Structure.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/SwitchAnalyzer.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/UnrollAndJam.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/TranslateTable.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/UnionBitVectorAnalysis.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/UseDefInfo.cpp \
@@ -171,6 +181,10 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/optimizer/RegDepCopyRemoval.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/ReorderIndexExpr.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/SinkStores.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/SLPVectorizer.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/SoftwarePipeliner.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/SparseConditionalConstantPropagation.cpp \
+    $(JIT_OMR_DIRTY_DIR)/optimizer/SSAForm.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/StripMiner.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/VPConstraint.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/VPHandlers.cpp \
@@ -245,6 +259,7 @@ JIT_PRODUCT_SOURCE_FILES+=\
     $(JIT_OMR_DIRTY_DIR)/env/JitConfig.cpp \
     $(JIT_OMR_DIRTY_DIR)/control/CompilationController.cpp \
     $(JIT_OMR_DIRTY_DIR)/optimizer/FEInliner.cpp \
+    $(JIT_OMR_DIRTY_DIR)/runtime/AOTCodeCache.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/Runtime.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/Trampoline.cpp \
     $(JIT_OMR_DIRTY_DIR)/control/CompileMethod.cpp \
@@ -275,6 +290,7 @@ JIT_PRODUCT_SOURCE_FILES+=\
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheManager.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheMemorySegment.cpp \
     $(JIT_OMR_DIRTY_DIR)/runtime/OMRCodeCacheConfig.cpp \
+    $(JIT_OMR_DIRTY_DIR)/runtime/JitDump.cpp \
     $(JIT_PRODUCT_DIR)/compile/ResolvedMethod.cpp \
     $(JIT_PRODUCT_DIR)/control/TestJit.cpp \
     $(JIT_PRODUCT_DIR)/env/FrontEnd.cpp \
@@ -43,17 +43,21 @@ JIT_PRODUCT_BACKEND_SOURCES+=\
     $(JIT_OMR_DIRTY_DIR)/x/codegen/X86BinaryEncoding.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/X86Debug.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/X86FPConversionSnippet.cpp \
+    $(JIT_OMR_DIRTY_DIR)/x/codegen/X86InstructionScheduler.cpp \
+    $(JIT_OMR_DIRTY_DIR)/x/codegen/X86RegisterPreferences.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRInstruction.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRInstructionDelegate.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRX86Instruction.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRMachine.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRLinkage.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRRegister.cpp \
+    $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRPeephole.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRRealRegister.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRRegisterDependency.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRSnippet.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/X86SystemLinkage.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/XMMBinaryArithmeticAnalyser.cpp \
+    $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRCodeGenPhase.cpp \
     $(JIT_OMR_DIRTY_DIR)/x/codegen/OMRCodeGenerator.cpp
 
 JIT_PRODUCT_SOURCE_FILES+=\
@@ -0,0 +1,196 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+#include "omrthread.h"
+
+#include <atomic>
+#include <string>
+
+/**
+ * Stress test for compiling many methods on several threads at once.
+ *
+ * Every method is parsed on the main thread. A fixed number of omrthreads then
+ * pull methods off a shared index, compile them with their own
+ * TR::Compilation and run the compiled bodies against an oracle. The results
+ * are checked on the main thread once all the workers have been joined.
+ */
+class ConcurrentCompileTest : public TRTest::JitTest {};
+
+static const int32_t numCompilingThreads = 8;
+static const int32_t methodsPerShape = 100;
+
+// The omrthread default stack is far too small for a compilation
+static const uintptr_t compilingThreadStackSize = 1024 * 1024;
+
+enum MethodShape
+   {
+   Arithmetic,
+   Loop,
+   Branch,
+   NumShapes
+   };
+
+struct ConcurrentMethod
+   {
+   MethodShape shape;
+   int32_t a;
+   int32_t b;
+   std::string source;
+   ASTNode *trees;
+   int32_t rc;
+   int32_t mismatches;
+   };
+
+/*
+ * Arithmetic: int32_t f(int32_t x) { return x * a + b; }
+ * Loop:       int32_t f(int32_t n) { int32_t s = 0; for (int32_t i = 0; i < n; i++) s += i * a + b; return s; }
+ * Branch:     int32_t f(int32_t x) { return x < a ? x + b : x - b; }
+ */
+static std::string
+methodSource(MethodShape shape, int32_t a, int32_t b)
+   {
+   std::string as = std::to_string(a);
+   std::string bs = std::to_string(b);
+   switch (shape)
+      {
+      case Arithmetic:
+         return "(method return=Int32 args=[Int32] (block (ireturn "
+                "(iadd (imul (iload parm=0) (iconst " + as + ")) (iconst " + bs + ")))))";
+      case Loop:
+         return "(method return=Int32 args=[Int32]"
+                "  (block"
+                "    (istore temp=\"sum\" (iconst 0))"
+                "    (istore temp=\"i\" (iconst 0))"
+                "    (ificmple target=done (iload parm=0) (iconst 0)))"
+                "  (block name=loop"
+                "    (istore temp=\"sum\" (iadd (iload temp=\"sum\")"
+                "                               (iadd (imul (iload temp=\"i\") (iconst " + as + ")) (iconst " + bs + "))))"
+                "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))"
+                "    (ificmplt target=loop (iload temp=\"i\") (iload parm=0)))"
+                "  (block name=done"
+                "    (ireturn (iload temp=\"sum\"))))";
+      default:
+         return "(method return=Int32 args=[Int32]"
+                "  (block"
+                "    (ificmpge target=high (iload parm=0) (iconst " + as + ")))"
+                "  (block"
+                "    (ireturn (iadd (iload parm=0) (iconst " + bs + "))))"
+                "  (block name=high"
+                "    (ireturn (isub (iload parm=0) (iconst " + bs + ")))))";
+      }
+   }
+
+static int32_t
+oracle(MethodShape shape, int32_t a, int32_t b, int32_t x)
+   {
+   switch (shape)
+      {
+      case Arithmetic:
+         return x * a + b;
+      case Loop:
+         {
+         int32_t sum = 0;
+         for (int32_t i = 0; i < x; i++)
+            sum += i * a + b;
+         return sum;
+         }
+      default:
+         return x < a ? x + b : x - b;
+      }
+   }
+
+struct ConcurrentCompileWork
+   {
+   std::vector<ConcurrentMethod> *methods;
+   std::atomic<int32_t> next;
+   };
+
+static int J9THREAD_PROC
+compileMethods(void *arg)
+   {
+   ConcurrentCompileWork *work = static_cast<ConcurrentCompileWork *>(arg);
+   std::vector<ConcurrentMethod> &methods = *work->methods;
+
+   for (int32_t index = work->next++; index < static_cast<int32_t>(methods.size()); index = work->next++)
+      {
+      ConcurrentMethod &method = methods[index];
+      Tril::DefaultCompiler compiler(method.trees);
+      method.rc = compiler.compile();
+      if (method.rc != 0)
+         continue;
+
+      auto entry = compiler.getEntryPoint<int32_t (*)(int32_t)>();
+      for (int32_t x = -20; x <= 20; x++)
+         {
+         if (entry(x) != oracle(method.shape, method.a, method.b, x))
+            method.mismatches++;
+         }
+      }
+
+   return 0;
+   }
+
+TEST_F(ConcurrentCompileTest, CompileManyMethodsOnManyThreads)
+   {
+   std::vector<ConcurrentMethod> methods;
+   for (int32_t i = 0; i < methodsPerShape; i++)
+      {
+      for (int32_t shape = 0; shape < NumShapes; shape++)
+         {
+         ConcurrentMethod method;
+         method.shape = static_cast<MethodShape>(shape);
+         method.a = i % 17 - 8;
+         method.b = i * 7 - 300;
+         method.source = methodSource(method.shape, method.a, method.b);
+         method.trees = parseString(method.source.c_str());
+         method.rc = -1;
+         method.mismatches = 0;
+         ASSERT_NOTNULL(method.trees) << "Failed to parse " << method.source;
+         methods.push_back(method);
+         }
+      }
+
+   ConcurrentCompileWork work;
+   work.methods = &methods;
+   work.next = 0;
+
+   omrthread_t threads[numCompilingThreads];
+   for (int32_t t = 0; t < numCompilingThreads; t++)
+      {
+      omrthread_attr_t attr = NULL;
+      ASSERT_EQ(J9THREAD_SUCCESS, omrthread_attr_init(&attr));
+      ASSERT_EQ(J9THREAD_SUCCESS, omrthread_attr_set_detachstate(&attr, J9THREAD_CREATE_JOINABLE));
+      ASSERT_EQ(J9THREAD_SUCCESS, omrthread_attr_set_stacksize(&attr, compilingThreadStackSize));
+      ASSERT_EQ(J9THREAD_SUCCESS, omrthread_create_ex(&threads[t], &attr, 0, compileMethods, &work)) << "Failed to start compiling thread " << t;
+      omrthread_attr_destroy(&attr);
+      }
+
+   for (int32_t t = 0; t < numCompilingThreads; t++)
+      ASSERT_EQ(J9THREAD_SUCCESS, omrthread_join(threads[t]));
+
+   for (auto it = methods.begin(); it != methods.end(); ++it)
+      {
+      EXPECT_EQ(0, it->rc) << "Compilation failed unexpectedly\n" << "Input trees: " << it->source;
+      EXPECT_EQ(0, it->mismatches) << "Compiled body returned wrong results\n" << "Input trees: " << it->source;
+      }
+   }
@@ -0,0 +1,149 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+
+/**
+ * Test fixture that compiles with edge profiling and cold code splitting.
+ *
+ * Each test compiles its method once to collect edge counts, runs it on
+ * inputs that never take the rare path, then compiles the same trees again
+ * so that the counts lay out the blocks and the rare path ends up in the
+ * cold area of the code cache. Both compiled bodies must compute the same
+ * results on all inputs.
+ */
+class EdgeProfilingTest : public TRTest::TestWithPortLib
+   {
+   public:
+
+   EdgeProfilingTest()
+      {
+      auto initSuccess = initializeJitWithOptions((char*)"-Xjit:acceptHugeMethods,omitFramePointer,useILValidator,paranoidoptcheck,"
+         "enableEdgeProfiling,enableColdCodeSplitting");
+      if (!initSuccess)
+         throw std::runtime_error("Failed to initialize jit");
+      }
+
+   ~EdgeProfilingTest()
+      {
+      shutdownJit();
+      }
+   };
+
+static int32_t rarePathOracle(int32_t x)
+   {
+   return x < 0 ? x * 3 - 7 : x + 1;
+   }
+
+/*
+ * int32_t f(int32_t x)
+ *    if (x < 0) return x * 3 - 7;
+ *    return x + 1;
+ */
+static const char *rarePathTrees =
+   "(method return=Int32 args=[Int32]                        "
+   "  (block                                                 "
+   "    (ificmplt target=rare (iload parm=0) (iconst 0)))    "
+   "  (block                                                 "
+   "    (ireturn (iadd (iload parm=0) (iconst 1))))          "
+   "  (block name=rare                                       "
+   "    (ireturn (isub (imul (iload parm=0) (iconst 3)) (iconst 7)))))";
+
+TEST_F(EdgeProfilingTest, RarePath)
+   {
+   auto trees = parseString(rarePathTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler profilingCompiler(trees);
+   ASSERT_EQ(0, profilingCompiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << rarePathTrees;
+   auto profiled = profilingCompiler.getEntryPoint<int32_t (*)(int32_t)>();
+
+   for (int32_t x = 0; x < 1000; x++)
+      EXPECT_EQ(rarePathOracle(x), profiled(x)) << "x = " << x;
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Recompilation failed unexpectedly\n" << "Input trees: " << rarePathTrees;
+   auto optimized = compiler.getEntryPoint<int32_t (*)(int32_t)>();
+
+   for (int32_t x = -100; x < 100; x++)
+      EXPECT_EQ(rarePathOracle(x), optimized(x)) << "x = " << x;
+   }
+
+static int32_t loopOracle(int32_t n)
+   {
+   int32_t sum = 0;
+   for (int32_t i = 0; i < n; i++)
+      {
+      if (i == 1000)
+         sum -= 5;
+      else
+         sum += i;
+      }
+   return sum;
+   }
+
+/*
+ * int32_t f(int32_t n)
+ *    int32_t sum = 0;
+ *    for (int32_t i = 0; i < n; i++)
+ *       sum += i == 1000 ? -5 : i;
+ *    return sum;
+ */
+static const char *loopTrees =
+   "(method return=Int32 args=[Int32]                                      "
+   "  (block                                                               "
+   "    (istore temp=\"sum\" (iconst 0))                                  "
+   "    (istore temp=\"i\" (iconst 0))                                    "
+   "    (ificmple target=done (iload parm=0) (iconst 0)))                  "
+   "  (block name=loop                                                     "
+   "    (ificmpeq target=rare (iload temp=\"i\") (iconst 1000)))          "
+   "  (block                                                               "
+   "    (istore temp=\"sum\" (iadd (iload temp=\"sum\") (iload temp=\"i\")))"
+   "    (goto target=next))                                                "
+   "  (block name=rare                                                     "
+   "    (istore temp=\"sum\" (isub (iload temp=\"sum\") (iconst 5))))     "
+   "  (block name=next                                                     "
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))          "
+   "    (ificmplt target=loop (iload temp=\"i\") (iload parm=0)))          "
+   "  (block name=done                                                     "
+   "    (ireturn (iload temp=\"sum\"))))                                   ";
+
+TEST_F(EdgeProfilingTest, LoopWithRarePath)
+   {
+   auto trees = parseString(loopTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler profilingCompiler(trees);
+   ASSERT_EQ(0, profilingCompiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << loopTrees;
+   auto profiled = profilingCompiler.getEntryPoint<int32_t (*)(int32_t)>();
+
+   for (int32_t n = 0; n < 100; n++)
+      EXPECT_EQ(loopOracle(n), profiled(n)) << "n = " << n;
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Recompilation failed unexpectedly\n" << "Input trees: " << loopTrees;
+   auto optimized = compiler.getEntryPoint<int32_t (*)(int32_t)>();
+
+   for (int32_t n = 0; n < 100; n++)
+      EXPECT_EQ(loopOracle(n), optimized(n)) << "n = " << n;
+   EXPECT_EQ(loopOracle(2000), optimized(2000));
+   }
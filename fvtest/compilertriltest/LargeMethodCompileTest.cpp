@@ -0,0 +1,140 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+/**
+ * Compile-time checks on methods with many blocks and many definitions.
+ *
+ * Each method is a chain of diamonds that update a small set of temps. The
+ * optimizations used here build use-def information, so most of the compile
+ * time goes to the reaching definitions analysis over the whole method.
+ * Every compiled body is checked against an oracle, and the compile time of
+ * each size is recorded as a test property. Timings are informational only.
+ */
+class LargeMethodCompileTest : public TRTest::JitTest {};
+
+static const int32_t numTemps = 16;
+
+static int32_t
+tempWritten(int32_t segment)
+   {
+   return segment % numTemps;
+   }
+
+static int32_t
+tempRead(int32_t segment)
+   {
+   return (segment * 7 + 3) % numTemps;
+   }
+
+/*
+ * int32_t f(int32_t x)
+ *    {
+ *    int32_t t[numTemps] = { 0 }, acc = 0;
+ *    for each segment i:
+ *       t[tempWritten(i)] = t[tempRead(i)] + i;
+ *       if (x >= i)
+ *          acc += t[tempWritten(i)];
+ *    return acc;
+ *    }
+ */
+static std::string
+largeMethodTrees(int32_t numSegments)
+   {
+   std::string trees = "(method return=Int32 args=[Int32] (block";
+   for (int32_t t = 0; t < numTemps; t++)
+      trees += " (istore temp=\"t" + std::to_string(t) + "\" (iconst 0))";
+   trees += " (istore temp=\"acc\" (iconst 0)))";
+
+   for (int32_t i = 0; i < numSegments; i++)
+      {
+      std::string written = "temp=\"t" + std::to_string(tempWritten(i)) + "\"";
+      std::string read = "temp=\"t" + std::to_string(tempRead(i)) + "\"";
+      std::string index = std::to_string(i);
+
+      trees += " (block" + (i > 0 ? " name=s" + std::to_string(i - 1) : std::string(""));
+      trees += " (istore " + written + " (iadd (iload " + read + ") (iconst " + index + ")))";
+      trees += " (ificmplt target=s" + index + " (iload parm=0) (iconst " + index + ")))";
+      trees += " (block (istore temp=\"acc\" (iadd (iload temp=\"acc\") (iload " + written + "))))";
+      }
+
+   trees += " (block name=s" + std::to_string(numSegments - 1) + " (ireturn (iload temp=\"acc\"))))";
+   return trees;
+   }
+
+static int32_t
+largeMethodOracle(int32_t numSegments, int32_t x)
+   {
+   uint32_t t[numTemps] = { 0 };
+   uint32_t acc = 0;
+   for (int32_t i = 0; i < numSegments; i++)
+      {
+      t[tempWritten(i)] = t[tempRead(i)] + i;
+      if (x >= i)
+         acc += t[tempWritten(i)];
+      }
+   return static_cast<int32_t>(acc);
+   }
+
+TEST_F(LargeMethodCompileTest, ManyBlocksWithUseDefInfo)
+   {
+   static const OptimizationStrategy useDefOpts[] =
+      {
+      { OMR::globalCopyPropagation, OMR::MustBeDone },
+      { OMR::globalValuePropagation, OMR::MustBeDone },
+      { OMR::endOpts }
+      };
+   const int32_t sizes[] = { 50, 200, 800 };
+
+   TR::Optimizer::setMockStrategy(useDefOpts);
+
+   for (int32_t s = 0; s < sizeof(sizes) / sizeof(*sizes); s++)
+      {
+      std::string trees = largeMethodTrees(sizes[s]);
+      auto method = parseString(trees.c_str());
+      ASSERT_NOTNULL(method) << "Failed to parse the method with " << sizes[s] << " segments";
+
+      Tril::DefaultCompiler compiler(method);
+      auto start = std::chrono::steady_clock::now();
+      int32_t rc = compiler.compile();
+      double compileMillis = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      ASSERT_EQ(0, rc) << "Compilation failed unexpectedly for the method with " << sizes[s] << " segments";
+
+      auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t)>();
+      const int32_t inputs[] = { -1, 0, 1, sizes[s] / 2, sizes[s] - 1, sizes[s] + 10 };
+      for (int32_t i = 0; i < sizeof(inputs) / sizeof(*inputs); i++)
+         EXPECT_EQ(largeMethodOracle(sizes[s], inputs[i]), entry_point(inputs[i])) << sizes[s] << " segments, x = " << inputs[i];
+
+      char name[64];
+      char buffer[64];
+      std::snprintf(name, sizeof(name), "compileMillis%d", sizes[s]);
+      std::snprintf(buffer, sizeof(buffer), "%.3f", compileMillis);
+      RecordProperty(name, buffer);
+      }
+
+   TR::Optimizer::setMockStrategy(NULL);
+   }
@@ -0,0 +1,410 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+#include "env/CompilerEnv.hpp"
+#include "il/Node.hpp"
+#include "infra/ILWalk.hpp"
+#include "ras/IlVerifier.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Verifier that fails the compilation unless the optimized trees contain
+ * vector IL, so a test cannot pass on the scalar loop alone.
+ */
+class VectorizedLoopIlVerifier : public TR::IlVerifier
+   {
+   public:
+   int32_t verify(TR::ResolvedMethodSymbol *sym)
+      {
+      for (TR::PreorderNodeIterator iter(sym->getFirstTreeTop(), sym->comp()); iter.currentTree(); ++iter)
+         {
+         if (iter.currentNode()->getDataType().isVector())
+            return 0;
+         }
+      return 1;
+      }
+   };
+
+/**
+ * Test fixture that runs only the loop vectorizer.
+ *
+ * Each test compiles its method twice, once with the vectorizer and once
+ * with no optimizations, checks both against a C++ oracle for trip counts
+ * around the vector length, and records the time taken by each version as
+ * a test property. Timings are informational only.
+ */
+class LoopVectorizerTest : public TRTest::JitOptTest
+   {
+   public:
+   LoopVectorizerTest()
+      {
+      addOptimization(OMR::loopVectorizer);
+      }
+
+   /**
+    * Compile \p compiler with the vectorizer and check that the loop was
+    * vectorized. The vectorizer only handles 64-bit targets, so elsewhere
+    * only the results are checked.
+    */
+   int32_t compileVectorized(Tril::DefaultCompiler &compiler)
+      {
+      VectorizedLoopIlVerifier verifier;
+      return TR::Compiler->target.is64Bit() ? compiler.compileWithVerifier(&verifier) : compiler.compile();
+      }
+
+   /**
+    * Compile \p trees with no optimizations at all, giving the scalar
+    * baseline the vectorized loop is compared against.
+    */
+   int32_t compileScalar(Tril::DefaultCompiler &compiler)
+      {
+      static const OptimizationStrategy noOpts[] = { { OMR::endOpts } };
+      TR::Optimizer::setMockStrategy(noOpts);
+      int32_t rc = compiler.compile();
+      TR::Optimizer::setMockStrategy(NULL);
+      return rc;
+      }
+
+   template <typename F>
+   static double timeCalls(F call, int32_t repetitions)
+      {
+      auto start = std::chrono::steady_clock::now();
+      for (int32_t i = 0; i < repetitions; i++)
+         call();
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      }
+
+   void recordSpeedup(double scalarTime, double vectorTime)
+      {
+      char buffer[64];
+      std::snprintf(buffer, sizeof(buffer), "%.2f", vectorTime > 0 ? scalarTime / vectorTime : 0.0);
+      RecordProperty("speedup", buffer);
+      std::snprintf(buffer, sizeof(buffer), "%.3f", scalarTime);
+      RecordProperty("scalarMillis", buffer);
+      std::snprintf(buffer, sizeof(buffer), "%.3f", vectorTime);
+      RecordProperty("vectorMillis", buffer);
+      }
+   };
+
+static const int32_t tripCounts[] = { 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 17, 100, 1001 };
+static const int32_t benchmarkLength = 4096;
+static const int32_t benchmarkRepetitions = 2000;
+
+/*
+ * void map(int32_t *a, int32_t *b, int32_t *c, int32_t n)
+ *    for (int32_t i = 0; i < n; i++) c[i] = a[i] + b[i];
+ */
+static const char *int32MapTrees =
+   "(method return=NoType args=[Address, Address, Address, Int32] mayHaveLoops=1           "
+   "  (block                                                                               "
+   "    (istore temp=\"i\" (iconst 0))                                                    "
+   "    (ificmple target=done (iload parm=3) (iconst 0)))                                  "
+   "  (block name=loop                                                                     "
+   "    (istorei offset=0                                                                  "
+   "      (aladd (aload parm=2) (lmul (i2l (iload temp=\"i\")) (lconst 4)))               "
+   "      (iadd                                                                            "
+   "        (iloadi offset=0 (aladd (aload parm=0) (lmul (i2l (iload temp=\"i\")) (lconst 4))))  "
+   "        (iloadi offset=0 (aladd (aload parm=1) (lmul (i2l (iload temp=\"i\")) (lconst 4))))))"
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))                          "
+   "    (ificmplt target=loop (iload temp=\"i\") (iload parm=3)))                          "
+   "  (block name=done                                                                     "
+   "    (return)))                                                                         ";
+
+TEST_F(LoopVectorizerTest, Int32Map)
+   {
+   auto trees = parseString(int32MapTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compileVectorized(compiler)) << "Compilation failed or the loop was not vectorized\n" << "Input trees: " << int32MapTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(int32_t *, int32_t *, int32_t *, int32_t)>();
+
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t n = tripCounts[t];
+      std::vector<int32_t> a(n), b(n), c(n, 0);
+      for (int32_t i = 0; i < n; i++)
+         {
+         a[i] = i * 7 - 3;
+         b[i] = 1000 - i * i;
+         }
+
+      entry_point(a.data(), b.data(), c.data(), n);
+      for (int32_t i = 0; i < n; i++)
+         EXPECT_EQ(a[i] + b[i], c[i]) << "n = " << n << ", i = " << i;
+      }
+   }
+
+TEST_F(LoopVectorizerTest, Int32MapOverlapping)
+   {
+   auto trees = parseString(int32MapTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compileVectorized(compiler)) << "Compilation failed or the loop was not vectorized\n" << "Input trees: " << int32MapTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(int32_t *, int32_t *, int32_t *, int32_t)>();
+
+   // c overlaps a one element ahead, which carries a dependence between iterations
+   // and must take the scalar fallback
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t n = tripCounts[t];
+      std::vector<int32_t> data(n + 1), expected(n + 1), b(n);
+      for (int32_t i = 0; i <= n; i++)
+         data[i] = expected[i] = i + 1;
+      for (int32_t i = 0; i < n; i++)
+         b[i] = 2 * i;
+
+      for (int32_t i = 0; i < n; i++)
+         expected[i + 1] = expected[i] + b[i];
+
+      entry_point(data.data(), b.data(), data.data() + 1, n);
+      for (int32_t i = 0; i <= n; i++)
+         EXPECT_EQ(expected[i], data[i]) << "n = " << n << ", i = " << i;
+      }
+   }
+
+TEST_F(LoopVectorizerTest, Int32MapSpeedup)
+   {
+   auto trees = parseString(int32MapTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler vectorCompiler(trees);
+   ASSERT_EQ(0, compileVectorized(vectorCompiler)) << "Compilation failed or the loop was not vectorized\n" << "Input trees: " << int32MapTrees;
+   Tril::DefaultCompiler scalarCompiler(trees);
+   ASSERT_EQ(0, compileScalar(scalarCompiler)) << "Compilation failed unexpectedly\n" << "Input trees: " << int32MapTrees;
+
+   auto vector_entry = vectorCompiler.getEntryPoint<void (*)(int32_t *, int32_t *, int32_t *, int32_t)>();
+   auto scalar_entry = scalarCompiler.getEntryPoint<void (*)(int32_t *, int32_t *, int32_t *, int32_t)>();
+
+   std::vector<int32_t> a(benchmarkLength), b(benchmarkLength), c(benchmarkLength), d(benchmarkLength);
+   for (int32_t i = 0; i < benchmarkLength; i++)
+      {
+      a[i] = i;
+      b[i] = benchmarkLength - i;
+      }
+
+   double scalarTime = timeCalls([&]() { scalar_entry(a.data(), b.data(), d.data(), benchmarkLength); }, benchmarkRepetitions);
+   double vectorTime = timeCalls([&]() { vector_entry(a.data(), b.data(), c.data(), benchmarkLength); }, benchmarkRepetitions);
+   recordSpeedup(scalarTime, vectorTime);
+
+   for (int32_t i = 0; i < benchmarkLength; i++)
+      ASSERT_EQ(d[i], c[i]) << "i = " << i;
+   }
+
+/*
+ * void saxpy(float a, float *x, float *y, int32_t n)
+ *    for (int32_t i = 0; i < n; i++) y[i] = a * x[i] + y[i];
+ */
+static const char *saxpyTrees =
+   "(method return=NoType args=[Float, Address, Address, Int32] mayHaveLoops=1             "
+   "  (block                                                                               "
+   "    (istore temp=\"i\" (iconst 0))                                                    "
+   "    (ificmple target=done (iload parm=3) (iconst 0)))                                  "
+   "  (block name=loop                                                                     "
+   "    (fstorei offset=0                                                                  "
+   "      (aladd (aload parm=2) (lmul (i2l (iload temp=\"i\")) (lconst 4)))               "
+   "      (fadd                                                                            "
+   "        (fmul                                                                          "
+   "          (fload parm=0)                                                               "
+   "          (floadi offset=0 (aladd (aload parm=1) (lmul (i2l (iload temp=\"i\")) (lconst 4)))))"
+   "        (floadi offset=0 (aladd (aload parm=2) (lmul (i2l (iload temp=\"i\")) (lconst 4))))))"
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))                          "
+   "    (ificmplt target=loop (iload temp=\"i\") (iload parm=3)))                          "
+   "  (block name=done                                                                     "
+   "    (return)))                                                                         ";
+
+TEST_F(LoopVectorizerTest, Saxpy)
+   {
+   auto trees = parseString(saxpyTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compileVectorized(compiler)) << "Compilation failed or the loop was not vectorized\n" << "Input trees: " << saxpyTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(float, float *, float *, int32_t)>();
+
+   const float scale = 2.5f;
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t n = tripCounts[t];
+      std::vector<float> x(n), y(n), expected(n);
+      for (int32_t i = 0; i < n; i++)
+         {
+         x[i] = 0.5f * i;
+         y[i] = expected[i] = 100.0f - i;
+         }
+
+      for (int32_t i = 0; i < n; i++)
+         expected[i] = scale * x[i] + expected[i];
+
+      entry_point(scale, x.data(), y.data(), n);
+      for (int32_t i = 0; i < n; i++)
+         EXPECT_FLOAT_EQ(expected[i], y[i]) << "n = " << n << ", i = " << i;
+      }
+   }
+
+TEST_F(LoopVectorizerTest, SaxpySpeedup)
+   {
+   auto trees = parseString(saxpyTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler vectorCompiler(trees);
+   ASSERT_EQ(0, compileVectorized(vectorCompiler)) << "Compilation failed or the loop was not vectorized\n" << "Input trees: " << saxpyTrees;
+   Tril::DefaultCompiler scalarCompiler(trees);
+   ASSERT_EQ(0, compileScalar(scalarCompiler)) << "Compilation failed unexpectedly\n" << "Input trees: " << saxpyTrees;
+
+   auto vector_entry = vectorCompiler.getEntryPoint<void (*)(float, float *, float *, int32_t)>();
+   auto scalar_entry = scalarCompiler.getEntryPoint<void (*)(float, float *, float *, int32_t)>();
+
+   std::vector<float> x(benchmarkLength), y(benchmarkLength, 0.0f), z(benchmarkLength, 0.0f);
+   for (int32_t i = 0; i < benchmarkLength; i++)
+      x[i] = 1.0f / (i + 1);
+
+   double scalarTime = timeCalls([&]() { scalar_entry(0.5f, x.data(), z.data(), benchmarkLength); }, benchmarkRepetitions);
+   double vectorTime = timeCalls([&]() { vector_entry(0.5f, x.data(), y.data(), benchmarkLength); }, benchmarkRepetitions);
+   recordSpeedup(scalarTime, vectorTime);
+
+   for (int32_t i = 0; i < benchmarkLength; i++)
+      ASSERT_FLOAT_EQ(z[i], y[i]) << "i = " << i;
+   }
+
+/*
+ * int32_t sum(int32_t *a, int32_t n)
+ *    int32_t s = 0;
+ *    for (int32_t i = 0; i < n; i++) s += a[i];
+ *    return s;
+ */
+static const char *int32SumTrees =
+   "(method return=Int32 args=[Address, Int32] mayHaveLoops=1                              "
+   "  (block                                                                               "
+   "    (istore temp=\"s\" (iconst 0))                                                    "
+   "    (istore temp=\"i\" (iconst 0))                                                    "
+   "    (ificmple target=done (iload parm=1) (iconst 0)))                                  "
+   "  (block name=loop                                                                     "
+   "    (istore temp=\"s\"                                                                "
+   "      (iadd                                                                            "
+   "        (iload temp=\"s\")                                                            "
+   "        (iloadi offset=0 (aladd (aload parm=0) (lmul (i2l (iload temp=\"i\")) (lconst 4))))))"
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))                          "
+   "    (ificmplt target=loop (iload temp=\"i\") (iload parm=1)))                          "
+   "  (block name=done                                                                     "
+   "    (ireturn (iload temp=\"s\"))))                                                    ";
+
+TEST_F(LoopVectorizerTest, Int32SumReduction)
+   {
+   auto trees = parseString(int32SumTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compileVectorized(compiler)) << "Compilation failed or the loop was not vectorized\n" << "Input trees: " << int32SumTrees;
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t *, int32_t)>();
+
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t n = tripCounts[t];
+      std::vector<int32_t> a(n);
+      int32_t expected = 0;
+      for (int32_t i = 0; i < n; i++)
+         {
+         a[i] = (i % 2) ? i * 3 : -i;
+         expected += a[i];
+         }
+
+      EXPECT_EQ(expected, entry_point(a.data(), n)) << "n = " << n;
+      }
+   }
+
+TEST_F(LoopVectorizerTest, Int32SumReductionSpeedup)
+   {
+   auto trees = parseString(int32SumTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler vectorCompiler(trees);
+   ASSERT_EQ(0, compileVectorized(vectorCompiler)) << "Compilation failed or the loop was not vectorized\n" << "Input trees: " << int32SumTrees;
+   Tril::DefaultCompiler scalarCompiler(trees);
+   ASSERT_EQ(0, compileScalar(scalarCompiler)) << "Compilation failed unexpectedly\n" << "Input trees: " << int32SumTrees;
+
+   auto vector_entry = vectorCompiler.getEntryPoint<int32_t (*)(int32_t *, int32_t)>();
+   auto scalar_entry = scalarCompiler.getEntryPoint<int32_t (*)(int32_t *, int32_t)>();
+
+   std::vector<int32_t> a(benchmarkLength);
+   for (int32_t i = 0; i < benchmarkLength; i++)
+      a[i] = i ^ 0x55;
+
+   volatile int32_t scalarSum = 0;
+   volatile int32_t vectorSum = 0;
+   double scalarTime = timeCalls([&]() { scalarSum = scalar_entry(a.data(), benchmarkLength); }, benchmarkRepetitions);
+   double vectorTime = timeCalls([&]() { vectorSum = vector_entry(a.data(), benchmarkLength); }, benchmarkRepetitions);
+   recordSpeedup(scalarTime, vectorTime);
+
+   ASSERT_EQ(scalarSum, vectorSum);
+   }
+
+/*
+ * int64_t sum(int64_t *a, int32_t n)
+ *    int64_t s = 0;
+ *    for (int32_t i = 0; i < n; i++) s += a[i];
+ *    return s;
+ */
+static const char *int64SumTrees =
+   "(method return=Int64 args=[Address, Int32] mayHaveLoops=1                              "
+   "  (block                                                                               "
+   "    (lstore temp=\"s\" (lconst 0))                                                    "
+   "    (istore temp=\"i\" (iconst 0))                                                    "
+   "    (ificmple target=done (iload parm=1) (iconst 0)))                                  "
+   "  (block name=loop                                                                     "
+   "    (lstore temp=\"s\"                                                                "
+   "      (ladd                                                                            "
+   "        (lload temp=\"s\")                                                            "
+   "        (lloadi offset=0 (aladd (aload parm=0) (lmul (i2l (iload temp=\"i\")) (lconst 8))))))"
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))                          "
+   "    (ificmplt target=loop (iload temp=\"i\") (iload parm=1)))                          "
+   "  (block name=done                                                                     "
+   "    (lreturn (lload temp=\"s\"))))                                                    ";
+
+TEST_F(LoopVectorizerTest, Int64SumReduction)
+   {
+   auto trees = parseString(int64SumTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compileVectorized(compiler)) << "Compilation failed or the loop was not vectorized\n" << "Input trees: " << int64SumTrees;
+   auto entry_point = compiler.getEntryPoint<int64_t (*)(int64_t *, int32_t)>();
+
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t n = tripCounts[t];
+      std::vector<int64_t> a(n);
+      int64_t expected = 0;
+      for (int32_t i = 0; i < n; i++)
+         {
+         a[i] = (int64_t)i * 0x100000001LL - 17;
+         expected += a[i];
+         }
+
+      EXPECT_EQ(expected, entry_point(a.data(), n)) << "n = " << n;
+      }
+   }
@@ -0,0 +1,90 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <string>
+#include <unistd.h>
+#include "JitTest.hpp"
+#include "control/Options.hpp"
+
+/**
+ * An option and a check that processing it changed the command line options.
+ */
+struct OptionLookup
+   {
+   const char *name;
+   bool (*isSet)(TR::Options *options);
+   };
+
+static std::ostream &operator<<(std::ostream &os, const OptionLookup &lookup)
+   {
+   return os << lookup.name;
+   }
+
+/**
+ * Options are found by a binary search over the option table, so an entry out
+ * of order hides itself and its neighbours. Each test initializes the JIT with
+ * a single option, which fails for an option that is not found.
+ */
+class OptionLookupTest : public TRTest::TestWithPortLib, public ::testing::WithParamInterface<OptionLookup>
+   {
+   public:
+
+   OptionLookupTest() : _initialized(false) { }
+
+   ~OptionLookupTest()
+      {
+      if (_initialized)
+         shutdownJit();
+
+      // enableJitDump opens the dump file of this process
+      char jitDumpFile[64];
+      snprintf(jitDumpFile, sizeof(jitDumpFile), "/tmp/jit-%d.dump", static_cast<int>(getpid()));
+      remove(jitDumpFile);
+      }
+
+   protected:
+
+   bool _initialized;
+   };
+
+TEST_P(OptionLookupTest, IsFound)
+   {
+   // Trace options are only accepted with a log file
+   std::string options = std::string("-Xjit:log=/dev/null,") + GetParam().name;
+   _initialized = initializeJitWithOptions(const_cast<char *>(options.c_str()));
+   ASSERT_TRUE(_initialized) << "Failed to initialize the JIT with " << options;
+
+   EXPECT_TRUE(GetParam().isSet(TR::Options::getCmdLineOptions())) << options << " was not applied";
+   }
+
+INSTANTIATE_TEST_CASE_P(CompileBudgetOptions, OptionLookupTest, ::testing::Values(
+   OptionLookup { "traceCompactNullChecks", [](TR::Options *o) { return o->trace(OMR::compactNullChecks); } },
+   OptionLookup { "traceCompileBudget",     [](TR::Options *o) { return o->getOption(TR_TraceCompileBudget); } }));
+
+INSTANTIATE_TEST_CASE_P(TieredCompilationOptions, OptionLookupTest, ::testing::Values(
+   OptionLookup { "disableTieredBackedgeCounters",   [](TR::Options *o) { return o->getOption(TR_DisableTieredBackedgeCounters); } },
+   OptionLookup { "disableTieredInvocationCounters", [](TR::Options *o) { return o->getOption(TR_DisableTieredInvocationCounters); } },
+   OptionLookup { "disableTraceRegDeps",             [](TR::Options *o) { return o->getOption(TR_DisableTraceRegDeps); } }));
+
+INSTANTIATE_TEST_CASE_P(JitDumpOptions, OptionLookupTest, ::testing::Values(
+   OptionLookup { "enableJitDump",                           [](TR::Options *o) { return o->getOption(TR_EnableJitDump); } },
+   OptionLookup { "enableJProfilingInProfilingCompilations", [](TR::Options *o) { return !o->getOption(TR_DisableJProfilingInProfilingCompilations); } }));
@@ -0,0 +1,224 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+ * The x86 peephole pass runs over the final instruction stream, so these tests
+ * compile shapes that give rise to its patterns and check the results of the
+ * rewritten code. Which instructions are removed or rewritten is checked by
+ * the code generator unit tests.
+ */
+class PeepholeTest : public TRTest::JitTest {};
+
+static const int32_t int32Values[] = { 0, 1, -1, 2, 5, 31, 32, 33, 0x7fffffff, (int32_t)0x80000000, 0x12345678 };
+static const int64_t int64Values[] = { 0, 1, -1, 5, 63, 64, 65, 0x7fffffffffffffffll, (int64_t)0x8000000000000000ull, 0x123456789abcdefll };
+
+#define ARRAY_LENGTH(a) (sizeof(a) / sizeof((a)[0]))
+
+TEST_F(PeepholeTest, Int32AndNot)
+   {
+   auto inputTrees =
+      "(method return=Int32 args=[Int32, Int32]                     "
+      "  (block                                                     "
+      "    (ireturn (iand (ixor (iload parm=0) (iconst -1)) (iload parm=1)))))";
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t)>();
+
+   for (int32_t i = 0; i < ARRAY_LENGTH(int32Values); i++)
+      for (int32_t j = 0; j < ARRAY_LENGTH(int32Values); j++)
+         EXPECT_EQ(~int32Values[i] & int32Values[j], entry_point(int32Values[i], int32Values[j]));
+   }
+
+TEST_F(PeepholeTest, Int64AndNot)
+   {
+   auto inputTrees =
+      "(method return=Int64 args=[Int64, Int64]                     "
+      "  (block                                                     "
+      "    (lreturn (land (lload parm=1) (lxor (lload parm=0) (lconst -1))))))";
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+   auto entry_point = compiler.getEntryPoint<int64_t (*)(int64_t, int64_t)>();
+
+   for (int32_t i = 0; i < ARRAY_LENGTH(int64Values); i++)
+      for (int32_t j = 0; j < ARRAY_LENGTH(int64Values); j++)
+         EXPECT_EQ(~int64Values[i] & int64Values[j], entry_point(int64Values[i], int64Values[j]));
+   }
+
+/*
+ * Shifts by a variable amount, whose result is used both directly and after
+ * the shifted operand, so the operand has to be copied before the shift.
+ */
+TEST_F(PeepholeTest, Int32VariableShifts)
+   {
+   auto inputTrees =
+      "(method return=Int32 args=[Int32, Int32]                     "
+      "  (block                                                     "
+      "    (ireturn                                                 "
+      "      (ixor                                                  "
+      "        (ixor (ishl (iload parm=0) (iload parm=1)) (ishr (iload parm=0) (iload parm=1)))"
+      "        (iadd (iushr (iload parm=0) (iload parm=1)) (iload parm=0))))))";
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t)>();
+
+   for (int32_t i = 0; i < ARRAY_LENGTH(int32Values); i++)
+      for (int32_t j = 0; j < ARRAY_LENGTH(int32Values); j++)
+         {
+         int32_t x = int32Values[i];
+         int32_t s = int32Values[j] & 31;
+         int32_t expected = ((int32_t)((uint32_t)x << s) ^ (x >> s)) ^ (int32_t)(((uint32_t)x >> s) + (uint32_t)x);
+         EXPECT_EQ(expected, entry_point(x, int32Values[j])) << "x = " << x << ", s = " << int32Values[j];
+         }
+   }
+
+TEST_F(PeepholeTest, Int64VariableShifts)
+   {
+   auto inputTrees =
+      "(method return=Int64 args=[Int64, Int32]                     "
+      "  (block                                                     "
+      "    (lreturn                                                 "
+      "      (lxor                                                  "
+      "        (lxor (lshl (lload parm=0) (iload parm=1)) (lshr (lload parm=0) (iload parm=1)))"
+      "        (ladd (lushr (lload parm=0) (iload parm=1)) (lload parm=0))))))";
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+   auto entry_point = compiler.getEntryPoint<int64_t (*)(int64_t, int32_t)>();
+
+   for (int32_t i = 0; i < ARRAY_LENGTH(int64Values); i++)
+      for (int32_t j = 0; j < ARRAY_LENGTH(int32Values); j++)
+         {
+         int64_t x = int64Values[i];
+         int32_t s = int32Values[j] & 63;
+         int64_t expected = ((int64_t)((uint64_t)x << s) ^ (x >> s)) ^ (int64_t)(((uint64_t)x >> s) + (uint64_t)x);
+         EXPECT_EQ(expected, entry_point(x, int32Values[j])) << "x = " << x << ", s = " << int32Values[j];
+         }
+   }
+
+/*
+ * The difference is compared against zero, so the compare can reuse the
+ * flags of the subtraction only for the equality and sign tests.
+ */
+TEST_F(PeepholeTest, Int32CompareDifferenceWithZero)
+   {
+   static const char *conditions[] = { "ificmpeq", "ificmpne", "ificmplt", "ificmpge", "ificmpgt", "ificmple" };
+
+   for (int32_t c = 0; c < ARRAY_LENGTH(conditions); c++)
+      {
+      char inputTrees[1024];
+      snprintf(inputTrees, sizeof(inputTrees),
+         "(method return=Int32 args=[Int32, Int32]                  "
+         "  (block                                                  "
+         "    (istore temp=\"d\" (isub (iload parm=0) (iload parm=1)))"
+         "    (%s target=taken (iload temp=\"d\") (iconst 0)))      "
+         "  (block                                                  "
+         "    (ireturn (iload temp=\"d\")))                          "
+         "  (block name=taken                                       "
+         "    (ireturn (iconst 12345))))                            ",
+         conditions[c]);
+      auto trees = parseString(inputTrees);
+      ASSERT_NOTNULL(trees);
+
+      Tril::DefaultCompiler compiler(trees);
+      ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+      auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t)>();
+
+      for (int32_t i = 0; i < ARRAY_LENGTH(int32Values); i++)
+         for (int32_t j = 0; j < ARRAY_LENGTH(int32Values); j++)
+            {
+            int32_t d = (int32_t)((uint32_t)int32Values[i] - (uint32_t)int32Values[j]);
+            bool taken;
+            switch (c)
+               {
+               case 0: taken = d == 0; break;
+               case 1: taken = d != 0; break;
+               case 2: taken = d < 0; break;
+               case 3: taken = d >= 0; break;
+               case 4: taken = d > 0; break;
+               default: taken = d <= 0; break;
+               }
+            EXPECT_EQ(taken ? 12345 : d, entry_point(int32Values[i], int32Values[j])) << conditions[c] << " " << int32Values[i] << " - " << int32Values[j];
+            }
+      }
+   }
+
+/*
+ * Stores of constants to adjacent fields, which may be merged into wider stores.
+ */
+TEST_F(PeepholeTest, AdjacentConstantStores)
+   {
+   auto inputTrees =
+      "(method return=NoType args=[Address]                         "
+      "  (block                                                     "
+      "    (bstorei offset=0 (aload parm=0) (bconst 0x12))          "
+      "    (bstorei offset=1 (aload parm=0) (bconst -2))            "
+      "    (sstorei offset=2 (aload parm=0) (sconst 0x3456))        "
+      "    (istorei offset=8 (aload parm=0) (iconst -7))            "
+      "    (istorei offset=12 (aload parm=0) (iconst -1))           "
+      "    (istorei offset=20 (aload parm=0) (iconst 1))            "
+      "    (istorei offset=16 (aload parm=0) (iconst 0))            "
+      "    (return)))                                               ";
+   auto trees = parseString(inputTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(uint8_t *)>();
+
+   uint8_t actual[32];
+   uint8_t expected[32];
+   memset(actual, 0xa5, sizeof(actual));
+   memset(expected, 0xa5, sizeof(expected));
+
+   int8_t b0 = 0x12, b1 = -2;
+   int16_t s2 = 0x3456;
+   int32_t i8 = -7, i12 = -1, i16 = 0, i20 = 1;
+   memcpy(expected + 0, &b0, sizeof(b0));
+   memcpy(expected + 1, &b1, sizeof(b1));
+   memcpy(expected + 2, &s2, sizeof(s2));
+   memcpy(expected + 8, &i8, sizeof(i8));
+   memcpy(expected + 12, &i12, sizeof(i12));
+   memcpy(expected + 16, &i16, sizeof(i16));
+   memcpy(expected + 20, &i20, sizeof(i20));
+
+   entry_point(actual);
+   for (int32_t i = 0; i < sizeof(actual); i++)
+      EXPECT_EQ(expected[i], actual[i]) << "byte " << i;
+   }
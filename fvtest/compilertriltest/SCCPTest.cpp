@@ -0,0 +1,293 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+/**
+ * Test fixture that runs sparse conditional constant propagation followed
+ * by tree simplification, which folds the constants it leaves behind.
+ *
+ * Each test checks the compiled body against a C++ oracle. The corpus test
+ * at the end also compiles every method with local and global value
+ * propagation instead, and records the compile time of each strategy as a
+ * test property. Timings are informational only.
+ */
+class SCCPTest : public TRTest::JitOptTest
+   {
+   public:
+   SCCPTest()
+      {
+      addOptimization(OMR::sparseConditionalConstantPropagation);
+      addOptimization(OMR::treeSimplification);
+      }
+   };
+
+/*
+ * int32_t f(int32_t x) { int32_t a; if (x < 0) a = 5; else a = 5; return a * 2 + x; }
+ */
+static const char *constantThroughPhiTrees =
+   "(method return=Int32 args=[Int32]                                    "
+   "  (block                                                             "
+   "    (ificmpge target=positive (iload parm=0) (iconst 0)))            "
+   "  (block                                                             "
+   "    (istore temp=\"a\" (iconst 5))                                   "
+   "    (goto target=join))                                              "
+   "  (block name=positive                                               "
+   "    (istore temp=\"a\" (iconst 5)))                                  "
+   "  (block name=join                                                   "
+   "    (ireturn (iadd (imul (iload temp=\"a\") (iconst 2)) (iload parm=0)))))";
+
+static int32_t constantThroughPhi(int32_t x) { return 10 + x; }
+
+/*
+ * int32_t f(int32_t x) { int32_t flag = 1; int32_t r; if (flag == 0) r = x * 100; else r = 7; return r + x; }
+ *
+ * The arm storing x * 100 is never executable, so r is 7 at the join.
+ */
+static const char *deadArmTrees =
+   "(method return=Int32 args=[Int32]                                    "
+   "  (block                                                             "
+   "    (istore temp=\"flag\" (iconst 1))                                "
+   "    (ificmpne target=otherwise (iload temp=\"flag\") (iconst 0)))    "
+   "  (block                                                             "
+   "    (istore temp=\"r\" (imul (iload parm=0) (iconst 100)))           "
+   "    (goto target=join))                                              "
+   "  (block name=otherwise                                              "
+   "    (istore temp=\"r\" (iconst 7)))                                  "
+   "  (block name=join                                                   "
+   "    (ireturn (iadd (iload temp=\"r\") (iload parm=0)))))             ";
+
+static int32_t deadArm(int32_t x) { return 7 + x; }
+
+/*
+ * int32_t f(int32_t n)
+ *    {
+ *    int32_t k = 3, s = 0;
+ *    for (int32_t i = 0; i < n; i++) { s += i * k; k = 3; }
+ *    return s + k;
+ *    }
+ *
+ * k is merged with itself around the back edge and stays constant.
+ */
+static const char *loopConstantTrees =
+   "(method return=Int32 args=[Int32]                                    "
+   "  (block                                                             "
+   "    (istore temp=\"k\" (iconst 3))                                   "
+   "    (istore temp=\"s\" (iconst 0))                                   "
+   "    (istore temp=\"i\" (iconst 0))                                   "
+   "    (ificmple target=done (iload parm=0) (iconst 0)))                "
+   "  (block name=loop                                                   "
+   "    (istore temp=\"s\" (iadd (iload temp=\"s\") (imul (iload temp=\"i\") (iload temp=\"k\"))))"
+   "    (istore temp=\"k\" (iconst 3))                                   "
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))         "
+   "    (ificmplt target=loop (iload temp=\"i\") (iload parm=0)))        "
+   "  (block name=done                                                   "
+   "    (ireturn (iadd (iload temp=\"s\") (iload temp=\"k\")))))         ";
+
+static int32_t loopConstant(int32_t n)
+   {
+   int32_t k = 3, s = 0;
+   for (int32_t i = 0; i < n; i++) { s += i * k; k = 3; }
+   return s + k;
+   }
+
+/*
+ * int32_t f(int32_t x)
+ *    {
+ *    int32_t v = x;
+ *    for (int32_t i = 0; i < 4; i++) v = v * 2 + 1;
+ *    return v;
+ *    }
+ *
+ * v is overdefined around the loop, so nothing may be folded.
+ */
+static const char *loopVaryingTrees =
+   "(method return=Int32 args=[Int32]                                    "
+   "  (block                                                             "
+   "    (istore temp=\"v\" (iload parm=0))                               "
+   "    (istore temp=\"i\" (iconst 0)))                                  "
+   "  (block name=loop                                                   "
+   "    (istore temp=\"v\" (iadd (imul (iload temp=\"v\") (iconst 2)) (iconst 1)))"
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))         "
+   "    (ificmplt target=loop (iload temp=\"i\") (iconst 4)))            "
+   "  (block                                                             "
+   "    (ireturn (iload temp=\"v\"))))                                   ";
+
+static int32_t loopVarying(int32_t x)
+   {
+   int32_t v = x;
+   for (int32_t i = 0; i < 4; i++) v = v * 2 + 1;
+   return v;
+   }
+
+/*
+ * int64_t f(int64_t x)
+ *    {
+ *    int64_t b = (int64_t)((uint64_t)(1LL << 40) >> 8);
+ *    int32_t c = (uint32_t)-1 < (uint32_t)1;
+ *    if (c != 0) return 0;
+ *    return b + x;
+ *    }
+ */
+static const char *int64ShiftsTrees =
+   "(method return=Int64 args=[Int64]                                    "
+   "  (block                                                             "
+   "    (lstore temp=\"b\" (lushr (lshl (lconst 1) (iconst 40)) (iconst 8)))"
+   "    (istore temp=\"c\" (iucmplt (iconst -1) (iconst 1)))             "
+   "    (ificmpeq target=compute (iload temp=\"c\") (iconst 0)))         "
+   "  (block                                                             "
+   "    (lreturn (lconst 0)))                                            "
+   "  (block name=compute                                                "
+   "    (lreturn (ladd (lload temp=\"b\") (lload parm=0)))))             ";
+
+TEST_F(SCCPTest, ConstantThroughPhi)
+   {
+   auto trees = parseString(constantThroughPhiTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << constantThroughPhiTrees;
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t)>();
+
+   for (int32_t x = -5; x <= 5; x++)
+      EXPECT_EQ(constantThroughPhi(x), entry_point(x)) << "x = " << x;
+   }
+
+TEST_F(SCCPTest, DeadArm)
+   {
+   auto trees = parseString(deadArmTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << deadArmTrees;
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t)>();
+
+   for (int32_t x = -5; x <= 5; x++)
+      EXPECT_EQ(deadArm(x), entry_point(x)) << "x = " << x;
+   }
+
+TEST_F(SCCPTest, LoopConstant)
+   {
+   auto trees = parseString(loopConstantTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << loopConstantTrees;
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t)>();
+
+   for (int32_t n = -1; n <= 20; n++)
+      EXPECT_EQ(loopConstant(n), entry_point(n)) << "n = " << n;
+   }
+
+TEST_F(SCCPTest, LoopVarying)
+   {
+   auto trees = parseString(loopVaryingTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << loopVaryingTrees;
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t)>();
+
+   for (int32_t x = -5; x <= 5; x++)
+      EXPECT_EQ(loopVarying(x), entry_point(x)) << "x = " << x;
+   }
+
+TEST_F(SCCPTest, Int64Shifts)
+   {
+   auto trees = parseString(int64ShiftsTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << int64ShiftsTrees;
+   auto entry_point = compiler.getEntryPoint<int64_t (*)(int64_t)>();
+
+   const int64_t inputs[] = { 0, 1, -1, 12345678901LL, INT64_MIN + 1 };
+   for (int32_t i = 0; i < sizeof(inputs) / sizeof(*inputs); i++)
+      EXPECT_EQ((int64_t)((uint64_t)(1LL << 32) + (uint64_t)inputs[i]), entry_point(inputs[i])) << "x = " << inputs[i];
+   }
+
+/*
+ * Compile the Int32 methods above with SCCP, local value propagation and
+ * global value propagation in turn, check each compiled body and record
+ * how long each strategy took to compile the corpus.
+ */
+TEST_F(SCCPTest, CompareWithValuePropagation)
+   {
+   struct CorpusMethod
+      {
+      const char *trees;
+      int32_t (*oracle)(int32_t);
+      };
+   const CorpusMethod corpus[] =
+      {
+      { constantThroughPhiTrees, constantThroughPhi },
+      { deadArmTrees, deadArm },
+      { loopConstantTrees, loopConstant },
+      { loopVaryingTrees, loopVarying },
+      };
+
+   static const OptimizationStrategy sccpOpts[] = { { OMR::sparseConditionalConstantPropagation, OMR::MustBeDone }, { OMR::treeSimplification, OMR::MustBeDone }, { OMR::endOpts } };
+   static const OptimizationStrategy localVPOpts[] = { { OMR::localValuePropagation, OMR::MustBeDone }, { OMR::endOpts } };
+   static const OptimizationStrategy globalVPOpts[] = { { OMR::globalValuePropagation, OMR::MustBeDone }, { OMR::endOpts } };
+   struct Strategy
+      {
+      const char *name;
+      const OptimizationStrategy *opts;
+      };
+   const Strategy strategies[] =
+      {
+      { "sccpMillis", sccpOpts },
+      { "localVPMillis", localVPOpts },
+      { "globalVPMillis", globalVPOpts },
+      };
+
+   for (int32_t s = 0; s < sizeof(strategies) / sizeof(*strategies); s++)
+      {
+      TR::Optimizer::setMockStrategy(strategies[s].opts);
+      double compileMillis = 0;
+
+      for (int32_t m = 0; m < sizeof(corpus) / sizeof(*corpus); m++)
+         {
+         auto trees = parseString(corpus[m].trees);
+         ASSERT_NOTNULL(trees);
+
+         Tril::DefaultCompiler compiler(trees);
+         auto start = std::chrono::steady_clock::now();
+         int32_t rc = compiler.compile();
+         compileMillis += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+         ASSERT_EQ(0, rc) << "Compilation failed unexpectedly with " << strategies[s].name << "\n" << "Input trees: " << corpus[m].trees;
+
+         auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t)>();
+         for (int32_t x = -3; x <= 10; x++)
+            EXPECT_EQ(corpus[m].oracle(x), entry_point(x)) << strategies[s].name << ", x = " << x << "\n" << "Input trees: " << corpus[m].trees;
+         }
+
+      char buffer[64];
+      std::snprintf(buffer, sizeof(buffer), "%.3f", compileMillis);
+      RecordProperty(strategies[s].name, buffer);
+      }
+
+   TR::Optimizer::setMockStrategy(NULL);
+   }
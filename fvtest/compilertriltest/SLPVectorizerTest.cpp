@@ -0,0 +1,256 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+
+/**
+ * Test fixture that runs only the SLP vectorizer.
+ *
+ * Each method is straight-line code with a group of adjacent stores that
+ * the vectorizer may pack. The tests check the compiled bodies against a
+ * C++ oracle, so they hold whether or not the target supports the vector
+ * operations a group needs.
+ */
+class SLPVectorizerTest : public TRTest::JitOptTest
+   {
+   public:
+   SLPVectorizerTest()
+      {
+      addOptimization(OMR::slpVectorizer);
+      }
+   };
+
+/*
+ * void copy(int32_t *dst, int32_t *src)
+ *    dst[0] = src[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3];
+ */
+static const char *int32CopyTrees =
+   "(method return=NoType args=[Address, Address]                 "
+   "  (block                                                      "
+   "    (istorei offset=0 (aload parm=0) (iloadi offset=0 (aload parm=1)))  "
+   "    (istorei offset=4 (aload parm=0) (iloadi offset=4 (aload parm=1)))  "
+   "    (istorei offset=8 (aload parm=0) (iloadi offset=8 (aload parm=1)))  "
+   "    (istorei offset=12 (aload parm=0) (iloadi offset=12 (aload parm=1)))"
+   "    (return)))                                                ";
+
+TEST_F(SLPVectorizerTest, Int32Copy)
+   {
+   auto trees = parseString(int32CopyTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << int32CopyTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(int32_t *, int32_t *)>();
+
+   int32_t src[6] = { 11, -22, 33, -44, 55, -66 };
+   int32_t dst[6] = { 0, 0, 0, 0, 0, 0 };
+   entry_point(dst, src);
+   for (int32_t i = 0; i < 4; i++)
+      EXPECT_EQ(src[i], dst[i]) << "i = " << i;
+   EXPECT_EQ(0, dst[4]) << "Store past the group";
+   EXPECT_EQ(0, dst[5]) << "Store past the group";
+   }
+
+/*
+ * void add(float *dst, float *a, float *b)
+ *    dst[i] = a[i] + b[i] for i = 0..3, stored out of order
+ */
+static const char *floatAddTrees =
+   "(method return=NoType args=[Address, Address, Address]        "
+   "  (block                                                      "
+   "    (fstorei offset=8 (aload parm=0) (fadd (floadi offset=8 (aload parm=1)) (floadi offset=8 (aload parm=2))))  "
+   "    (fstorei offset=0 (aload parm=0) (fadd (floadi offset=0 (aload parm=1)) (floadi offset=0 (aload parm=2))))  "
+   "    (fstorei offset=12 (aload parm=0) (fadd (floadi offset=12 (aload parm=1)) (floadi offset=12 (aload parm=2))))"
+   "    (fstorei offset=4 (aload parm=0) (fadd (floadi offset=4 (aload parm=1)) (floadi offset=4 (aload parm=2))))  "
+   "    (return)))                                                ";
+
+TEST_F(SLPVectorizerTest, FloatAdd)
+   {
+   auto trees = parseString(floatAddTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << floatAddTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(float *, float *, float *)>();
+
+   float a[4] = { 1.5f, -2.25f, 3.0f, 1e10f };
+   float b[4] = { 0.5f, 2.25f, -7.125f, -1e10f };
+   float dst[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+   entry_point(dst, a, b);
+   for (int32_t i = 0; i < 4; i++)
+      EXPECT_FLOAT_EQ(a[i] + b[i], dst[i]) << "i = " << i;
+   }
+
+/*
+ * void scale(double *dst, double *a, double s)
+ *    dst[0] = a[0] * s; dst[1] = a[1] * s;
+ */
+static const char *doubleScaleTrees =
+   "(method return=NoType args=[Address, Address, Double]         "
+   "  (block                                                      "
+   "    (dstorei offset=0 (aload parm=0) (dmul (dloadi offset=0 (aload parm=1)) (dload parm=2 id=\"s\")))"
+   "    (dstorei offset=8 (aload parm=0) (dmul (dloadi offset=8 (aload parm=1)) (@id \"s\")))           "
+   "    (return)))                                                ";
+
+TEST_F(SLPVectorizerTest, DoubleScaleBySplat)
+   {
+   auto trees = parseString(doubleScaleTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << doubleScaleTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(double *, double *, double)>();
+
+   double a[2] = { 3.5, -0.125 };
+   double dst[2] = { 0.0, 0.0 };
+   entry_point(dst, a, 4.0);
+   EXPECT_DOUBLE_EQ(a[0] * 4.0, dst[0]);
+   EXPECT_DOUBLE_EQ(a[1] * 4.0, dst[1]);
+   }
+
+/*
+ * void fill(int64_t *dst)
+ *    dst[0] = dst[1] = dst[2] = dst[3] = 0x123456789;
+ */
+static const char *int64FillTrees =
+   "(method return=NoType args=[Address]                          "
+   "  (block                                                      "
+   "    (lstorei offset=0 (aload parm=0) (lconst 4886718345 id=\"c\"))"
+   "    (lstorei offset=8 (aload parm=0) (@id \"c\"))             "
+   "    (lstorei offset=16 (aload parm=0) (@id \"c\"))            "
+   "    (lstorei offset=24 (aload parm=0) (@id \"c\"))            "
+   "    (return)))                                                ";
+
+TEST_F(SLPVectorizerTest, Int64FillWithConstant)
+   {
+   auto trees = parseString(int64FillTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << int64FillTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(int64_t *)>();
+
+   int64_t dst[5] = { -1, -1, -1, -1, -1 };
+   entry_point(dst);
+   for (int32_t i = 0; i < 4; i++)
+      EXPECT_EQ(4886718345LL, dst[i]) << "i = " << i;
+   EXPECT_EQ(-1, dst[4]) << "Store past the group";
+   }
+
+/*
+ * void addScalars(int32_t *dst, int32_t *src, int32_t x0, int32_t x1, int32_t x2, int32_t x3)
+ *    dst[i] = src[i] + xi for i = 0..3
+ *
+ * The scalars have to be packed into a vector before the add.
+ */
+static const char *int32PackTrees =
+   "(method return=NoType args=[Address, Address, Int32, Int32, Int32, Int32]"
+   "  (block                                                      "
+   "    (istorei offset=0 (aload parm=0) (iadd (iloadi offset=0 (aload parm=1)) (iload parm=2)))  "
+   "    (istorei offset=4 (aload parm=0) (iadd (iloadi offset=4 (aload parm=1)) (iload parm=3)))  "
+   "    (istorei offset=8 (aload parm=0) (iadd (iloadi offset=8 (aload parm=1)) (iload parm=4)))  "
+   "    (istorei offset=12 (aload parm=0) (iadd (iloadi offset=12 (aload parm=1)) (iload parm=5)))"
+   "    (return)))                                                ";
+
+TEST_F(SLPVectorizerTest, Int32PackScalars)
+   {
+   auto trees = parseString(int32PackTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << int32PackTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(int32_t *, int32_t *, int32_t, int32_t, int32_t, int32_t)>();
+
+   int32_t src[4] = { 100, 200, 300, 400 };
+   int32_t dst[4] = { 0, 0, 0, 0 };
+   entry_point(dst, src, 1, -2, 3, -4);
+   EXPECT_EQ(101, dst[0]);
+   EXPECT_EQ(198, dst[1]);
+   EXPECT_EQ(303, dst[2]);
+   EXPECT_EQ(396, dst[3]);
+   }
+
+/*
+ * int32_t addAndReturn(int32_t *dst, int32_t *a, int32_t *b)
+ *    dst[i] = a[i] + b[i] for i = 0..3; return dst[0] + dst[3] computed from the sums
+ *
+ * Two of the packed sums are used again after the stores and have to be
+ * unpacked from the vector.
+ */
+static const char *int32UnpackTrees =
+   "(method return=Int32 args=[Address, Address, Address]         "
+   "  (block                                                      "
+   "    (istorei offset=0 (aload parm=0) (iadd id=\"s0\" (iloadi offset=0 (aload parm=1)) (iloadi offset=0 (aload parm=2))))   "
+   "    (istorei offset=4 (aload parm=0) (iadd (iloadi offset=4 (aload parm=1)) (iloadi offset=4 (aload parm=2))))             "
+   "    (istorei offset=8 (aload parm=0) (iadd (iloadi offset=8 (aload parm=1)) (iloadi offset=8 (aload parm=2))))             "
+   "    (istorei offset=12 (aload parm=0) (iadd id=\"s3\" (iloadi offset=12 (aload parm=1)) (iloadi offset=12 (aload parm=2))))"
+   "    (ireturn (isub (@id \"s0\") (@id \"s3\")))))              ";
+
+TEST_F(SLPVectorizerTest, Int32UnpackLanesUsedLater)
+   {
+   auto trees = parseString(int32UnpackTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << int32UnpackTrees;
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t *, int32_t *, int32_t *)>();
+
+   int32_t a[4] = { 7, 8, 9, 10 };
+   int32_t b[4] = { 70, 80, 90, 100 };
+   int32_t dst[4] = { 0, 0, 0, 0 };
+   EXPECT_EQ((a[0] + b[0]) - (a[3] + b[3]), entry_point(dst, a, b));
+   for (int32_t i = 0; i < 4; i++)
+      EXPECT_EQ(a[i] + b[i], dst[i]) << "i = " << i;
+   }
+
+/*
+ * int32_t copyAndPeek(int32_t *dst, int32_t *src)
+ *    dst[0] = src[0]; t = dst[0]; dst[1] = src[1]; dst[2] = src[2]; dst[3] = src[3]; return t;
+ *
+ * The load of dst[0] between the stores must see the first store, which
+ * keeps it from moving down to a vector store.
+ */
+static const char *int32InterveningLoadTrees =
+   "(method return=Int32 args=[Address, Address]                  "
+   "  (block                                                      "
+   "    (istorei offset=0 (aload parm=0) (iloadi offset=0 (aload parm=1)))  "
+   "    (istore temp=\"t\" (iloadi offset=0 (aload parm=0)))                "
+   "    (istorei offset=4 (aload parm=0) (iloadi offset=4 (aload parm=1)))  "
+   "    (istorei offset=8 (aload parm=0) (iloadi offset=8 (aload parm=1)))  "
+   "    (istorei offset=12 (aload parm=0) (iloadi offset=12 (aload parm=1)))"
+   "    (ireturn (iload temp=\"t\"))))                            ";
+
+TEST_F(SLPVectorizerTest, Int32InterveningLoad)
+   {
+   auto trees = parseString(int32InterveningLoadTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << int32InterveningLoadTrees;
+   auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t *, int32_t *)>();
+
+   int32_t src[4] = { 5, 6, 7, 8 };
+   int32_t dst[4] = { -1, -1, -1, -1 };
+   EXPECT_EQ(5, entry_point(dst, src));
+   for (int32_t i = 0; i < 4; i++)
+      EXPECT_EQ(src[i], dst[i]) << "i = " << i;
+   }
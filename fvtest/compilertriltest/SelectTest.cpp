@@ -1896,3 +1896,273 @@ INSTANTIATE_TEST_CASE_P(SelectCompareTest, Int32SelectDoubleCompareTest,
         ::testing::ValuesIn(allComparisons()),
         ::testing::ValuesIn(compareInputs<double>()),
         ::testing::ValuesIn(resultInputs<int32_t>())));
+
+/*
+ * The following tests branch around stores to a temp, in the shapes that
+ * if-conversion replaces by selects, and check that the result is that of
+ * the original control flow.
+ */
+
+class Int32IfConversionTest : public SelectCompareTest<int32_t, int32_t> {};
+
+TEST_P(Int32IfConversionTest, Diamond) {
+    auto param = to_struct(GetParam());
+
+    char inputTrees[1024] = {0};
+    std::snprintf(inputTrees, sizeof(inputTrees),
+        "(method return=Int32 args=[Int32, Int32, Int32, Int32]"
+        "  (block"
+        "    (ificmp%s target=taken (iload parm=0) (iload parm=1)))"
+        "  (block"
+        "    (istore temp=\"x\" (iload parm=3))"
+        "    (goto target=join))"
+        "  (block name=taken"
+        "    (istore temp=\"x\" (iload parm=2)))"
+        "  (block name=join"
+        "    (ireturn (iload temp=\"x\"))))",
+        xcmpSuffix<int32_t>(param.cmp));
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+
+    Tril::DefaultCompiler compiler(trees);
+
+    int32_t compileResult = compiler.compile();
+    ASSERT_EQ(0, compileResult) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t, int32_t, int32_t)>();
+    ASSERT_EQ(xselectOracle(xcmpOracle(param.cmp, param.c1, param.c2), param.v1, param.v2), entry_point(param.c1, param.c2, param.v1, param.v2));
+}
+
+TEST_P(Int32IfConversionTest, TakenTriangle) {
+    auto param = to_struct(GetParam());
+
+    char inputTrees[1024] = {0};
+    std::snprintf(inputTrees, sizeof(inputTrees),
+        "(method return=Int32 args=[Int32, Int32, Int32, Int32]"
+        "  (block"
+        "    (istore temp=\"x\" (iload parm=3))"
+        "    (ificmp%s target=taken (iload parm=0) (iload parm=1)))"
+        "  (block name=join"
+        "    (ireturn (iload temp=\"x\")))"
+        "  (block name=taken"
+        "    (istore temp=\"x\" (iadd (iload parm=2) (iconst 1)))"
+        "    (goto target=join)))",
+        xcmpSuffix<int32_t>(param.cmp));
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+
+    Tril::DefaultCompiler compiler(trees);
+
+    int32_t compileResult = compiler.compile();
+    ASSERT_EQ(0, compileResult) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t, int32_t, int32_t)>();
+    ASSERT_EQ(xselectOracle(xcmpOracle(param.cmp, param.c1, param.c2), param.v1 + 1, param.v2), entry_point(param.c1, param.c2, param.v1, param.v2));
+}
+
+TEST_P(Int32IfConversionTest, FallThroughTriangle) {
+    auto param = to_struct(GetParam());
+
+    char inputTrees[1024] = {0};
+    std::snprintf(inputTrees, sizeof(inputTrees),
+        "(method return=Int32 args=[Int32, Int32, Int32, Int32]"
+        "  (block"
+        "    (istore temp=\"x\" (iload parm=2))"
+        "    (ificmp%s target=join (iload parm=0) (iload parm=1)))"
+        "  (block"
+        "    (istore temp=\"x\" (iload parm=3)))"
+        "  (block name=join"
+        "    (ireturn (iload temp=\"x\"))))",
+        xcmpSuffix<int32_t>(param.cmp));
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+
+    Tril::DefaultCompiler compiler(trees);
+
+    int32_t compileResult = compiler.compile();
+    ASSERT_EQ(0, compileResult) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t, int32_t, int32_t)>();
+    ASSERT_EQ(xselectOracle(xcmpOracle(param.cmp, param.c1, param.c2), param.v1, param.v2), entry_point(param.c1, param.c2, param.v1, param.v2));
+}
+
+TEST_P(Int32IfConversionTest, Swap) {
+    auto param = to_struct(GetParam());
+
+    // Each store of the arm reads a temp that another store of it writes
+    char inputTrees[1024] = {0};
+    std::snprintf(inputTrees, sizeof(inputTrees),
+        "(method return=Int32 args=[Int32, Int32, Int32, Int32]"
+        "  (block"
+        "    (istore temp=\"x\" (iload parm=2))"
+        "    (istore temp=\"y\" (iload parm=3))"
+        "    (ificmp%s target=swap (iload parm=0) (iload parm=1)))"
+        "  (block name=join"
+        "    (ireturn (iadd (imul (iload temp=\"x\") (iconst 16)) (iload temp=\"y\"))))"
+        "  (block name=swap"
+        "    (istore temp=\"t\" (iload temp=\"x\"))"
+        "    (istore temp=\"x\" (iload temp=\"y\"))"
+        "    (istore temp=\"y\" (iload temp=\"t\"))"
+        "    (goto target=join)))",
+        xcmpSuffix<int32_t>(param.cmp));
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+
+    Tril::DefaultCompiler compiler(trees);
+
+    int32_t compileResult = compiler.compile();
+    ASSERT_EQ(0, compileResult) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t, int32_t, int32_t)>();
+    int32_t swapped = xcmpOracle(param.cmp, param.c1, param.c2);
+    int32_t x = swapped ? param.v2 : param.v1;
+    int32_t y = swapped ? param.v1 : param.v2;
+    ASSERT_EQ(x * 16 + y, entry_point(param.c1, param.c2, param.v1, param.v2));
+}
+
+TEST_P(Int32IfConversionTest, Nested) {
+    auto param = to_struct(GetParam());
+
+    char inputTrees[1024] = {0};
+    std::snprintf(inputTrees, sizeof(inputTrees),
+        "(method return=Int32 args=[Int32, Int32, Int32, Int32]"
+        "  (block"
+        "    (ificmp%s target=outer (iload parm=0) (iload parm=1)))"
+        "  (block"
+        "    (istore temp=\"x\" (iconst 3))"
+        "    (goto target=join))"
+        "  (block name=outer"
+        "    (ificmplt target=inner (iload parm=2) (iload parm=3)))"
+        "  (block"
+        "    (istore temp=\"x\" (iload parm=3))"
+        "    (goto target=innerJoin))"
+        "  (block name=inner"
+        "    (istore temp=\"x\" (iload parm=2)))"
+        "  (block name=innerJoin"
+        "    (goto target=join))"
+        "  (block name=join"
+        "    (ireturn (iload temp=\"x\"))))",
+        xcmpSuffix<int32_t>(param.cmp));
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+
+    Tril::DefaultCompiler compiler(trees);
+
+    int32_t compileResult = compiler.compile();
+    ASSERT_EQ(0, compileResult) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t, int32_t, int32_t)>();
+    ASSERT_EQ(xselectOracle(xcmpOracle(param.cmp, param.c1, param.c2), std::min(param.v1, param.v2), 3), entry_point(param.c1, param.c2, param.v1, param.v2));
+}
+
+TEST_P(Int32IfConversionTest, GuardedDivide) {
+    auto param = to_struct(GetParam());
+
+    // The divide must not be evaluated when the divisor is zero
+    char inputTrees[1024] = {0};
+    std::snprintf(inputTrees, sizeof(inputTrees),
+        "(method return=Int32 args=[Int32, Int32]"
+        "  (block"
+        "    (istore temp=\"x\" (iconst 0))"
+        "    (ificmpeq target=join (iload parm=1) (iconst 0)))"
+        "  (block"
+        "    (istore temp=\"x\" (idiv (iload parm=0) (iload parm=1))))"
+        "  (block name=join"
+        "    (ireturn (iload temp=\"x\"))))");
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+
+    Tril::DefaultCompiler compiler(trees);
+
+    int32_t compileResult = compiler.compile();
+    ASSERT_EQ(0, compileResult) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<int32_t (*)(int32_t, int32_t)>();
+    ASSERT_EQ(param.v2 == 0 ? 0 : param.v1 / param.v2, entry_point(param.v1, param.v2));
+}
+
+INSTANTIATE_TEST_CASE_P(IfConversionTest, Int32IfConversionTest,
+    ::testing::Combine(
+        ::testing::ValuesIn(allComparisons()),
+        ::testing::ValuesIn(compareInputs<int32_t>()),
+        ::testing::ValuesIn(resultInputs<int32_t>())));
+
+class Int64IfConversionTest : public SelectCompareTest<int64_t, int64_t> {};
+
+TEST_P(Int64IfConversionTest, Diamond) {
+    auto param = to_struct(GetParam());
+
+    char inputTrees[1024] = {0};
+    std::snprintf(inputTrees, sizeof(inputTrees),
+        "(method return=Int64 args=[Int64, Int64, Int64, Int64]"
+        "  (block"
+        "    (iflcmp%s target=taken (lload parm=0) (lload parm=1)))"
+        "  (block"
+        "    (lstore temp=\"x\" (lsub (lload parm=3) (lload parm=2)))"
+        "    (goto target=join))"
+        "  (block name=taken"
+        "    (lstore temp=\"x\" (lload parm=2)))"
+        "  (block name=join"
+        "    (lreturn (lload temp=\"x\"))))",
+        xcmpSuffix<int64_t>(param.cmp));
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+
+    Tril::DefaultCompiler compiler(trees);
+
+    int32_t compileResult = compiler.compile();
+    ASSERT_EQ(0, compileResult) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<int64_t (*)(int64_t, int64_t, int64_t, int64_t)>();
+    ASSERT_EQ(xselectOracle(xcmpOracle(param.cmp, param.c1, param.c2), param.v1, param.v2 - param.v1), entry_point(param.c1, param.c2, param.v1, param.v2));
+}
+
+INSTANTIATE_TEST_CASE_P(IfConversionTest, Int64IfConversionTest,
+    ::testing::Combine(
+        ::testing::ValuesIn(allComparisons()),
+        ::testing::ValuesIn(compareInputs<int64_t>()),
+        ::testing::ValuesIn(resultInputs<int64_t>())));
+
+class Int32DoubleCompareIfConversionTest : public SelectCompareTest<double, int32_t> {};
+
+TEST_P(Int32DoubleCompareIfConversionTest, Diamond) {
+    auto param = to_struct(GetParam());
+
+    char inputTrees[1024] = {0};
+    std::snprintf(inputTrees, sizeof(inputTrees),
+        "(method return=Int32 args=[Double, Double, Int32, Int32]"
+        "  (block"
+        "    (ifdcmp%s target=taken (dload parm=0) (dload parm=1)))"
+        "  (block"
+        "    (istore temp=\"x\" (iload parm=3))"
+        "    (goto target=join))"
+        "  (block name=taken"
+        "    (istore temp=\"x\" (iload parm=2)))"
+        "  (block name=join"
+        "    (ireturn (iload temp=\"x\"))))",
+        xcmpSuffix<double>(param.cmp));
+    auto trees = parseString(inputTrees);
+
+    ASSERT_NOTNULL(trees);
+
+    Tril::DefaultCompiler compiler(trees);
+
+    int32_t compileResult = compiler.compile();
+    ASSERT_EQ(0, compileResult) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<int32_t (*)(double, double, int32_t, int32_t)>();
+    ASSERT_EQ(xselectOracle(xcmpOracle(param.cmp, param.c1, param.c2), param.v1, param.v2), entry_point(param.c1, param.c2, param.v1, param.v2));
+}
+
+INSTANTIATE_TEST_CASE_P(IfConversionTest, Int32DoubleCompareIfConversionTest,
+    ::testing::Combine(
+        ::testing::ValuesIn(allComparisons()),
+        ::testing::ValuesIn(compareInputs<double>()),
+        ::testing::ValuesIn(resultInputs<int32_t>())));
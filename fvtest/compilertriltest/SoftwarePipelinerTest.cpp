@@ -0,0 +1,127 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+
+#include <vector>
+
+/**
+ * Test fixture that runs only the software pipeliner, which is disabled by
+ * default and enabled here for the duration of each test.
+ */
+class SoftwarePipelinerTest : public TRTest::JitOptTest
+   {
+   public:
+   SoftwarePipelinerTest()
+      {
+      addOptimization(OMR::softwarePipelining);
+      }
+
+   virtual void SetUp()
+      {
+      JitOptTest::SetUp();
+      TR::Options::getCmdLineOptions()->setDisabled(OMR::softwarePipelining, false);
+      }
+
+   virtual void TearDown()
+      {
+      TR::Options::getCmdLineOptions()->setDisabled(OMR::softwarePipelining, true);
+      JitOptTest::TearDown();
+      }
+   };
+
+static const int32_t tripCounts[] = { 1, 2, 3, 4, 5, 16, 17, 100 };
+
+/*
+ * void daxpy(double a, double *x, double *y, int32_t n)
+ *    for (int32_t i = 0; i < n; i++) y[i] = a * x[i] + y[i];
+ */
+static const char *daxpyTrees =
+   "(method return=NoType args=[Double, Address, Address, Int32] mayHaveLoops=1            "
+   "  (block                                                                               "
+   "    (istore temp=\"i\" (iconst 0))                                                    "
+   "    (ificmple target=done (iload parm=3) (iconst 0)))                                  "
+   "  (block name=loop                                                                     "
+   "    (dstorei offset=0                                                                  "
+   "      (aladd (aload parm=2) (lmul (i2l (iload temp=\"i\")) (lconst 8)))               "
+   "      (dadd                                                                            "
+   "        (dmul                                                                          "
+   "          (dload parm=0)                                                               "
+   "          (dloadi offset=0 (aladd (aload parm=1) (lmul (i2l (iload temp=\"i\")) (lconst 8)))))"
+   "        (dloadi offset=0 (aladd (aload parm=2) (lmul (i2l (iload temp=\"i\")) (lconst 8))))))"
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))                          "
+   "    (ificmplt target=loop (iload temp=\"i\") (iload parm=3)))                          "
+   "  (block name=done                                                                     "
+   "    (return)))                                                                         ";
+
+TEST_F(SoftwarePipelinerTest, Daxpy)
+   {
+   auto trees = parseString(daxpyTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << daxpyTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(double, double *, double *, int32_t)>();
+
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t n = tripCounts[t];
+      std::vector<double> x(n), y(n), expected(n);
+      for (int32_t i = 0; i < n; i++)
+         {
+         x[i] = i * 0.5 - 2.0;
+         y[i] = expected[i] = 3.0 - i;
+         }
+      for (int32_t i = 0; i < n; i++)
+         expected[i] = 1.5 * x[i] + expected[i];
+
+      entry_point(1.5, x.data(), y.data(), n);
+      for (int32_t i = 0; i < n; i++)
+         EXPECT_EQ(expected[i], y[i]) << "n = " << n << ", i = " << i;
+      }
+   }
+
+TEST_F(SoftwarePipelinerTest, DaxpyOverlapping)
+   {
+   auto trees = parseString(daxpyTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << daxpyTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(double, double *, double *, int32_t)>();
+
+   // y is one element ahead of x, so each iteration loads the element the
+   // previous one stored and the overlap check must select the original loop
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t n = tripCounts[t];
+      std::vector<double> data(n + 1), expected(n + 1);
+      for (int32_t i = 0; i <= n; i++)
+         data[i] = expected[i] = i + 1.0;
+      for (int32_t i = 0; i < n; i++)
+         expected[i + 1] = 2.0 * expected[i] + expected[i + 1];
+
+      entry_point(2.0, data.data(), data.data() + 1, n);
+      for (int32_t i = 0; i <= n; i++)
+         EXPECT_EQ(expected[i], data[i]) << "n = " << n << ", i = " << i;
+      }
+   }
@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+#include "il/Node.hpp"
+#include "infra/ILWalk.hpp"
+#include "ras/IlVerifier.hpp"
+#include "ras/IlVerifierHelpers.hpp"
+
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * Runs only the switch analyzer, so that the dispatch it chooses for each
+ * cluster of case values reaches the code generator unchanged.
+ */
+class SwitchLoweringTest : public TRTest::JitOptTest
+   {
+   public:
+   SwitchLoweringTest()
+      {
+      addOptimization(OMR::switchAnalyzer);
+      }
+   };
+
+/**
+ * Fails the compilation unless the switch was lowered to the expected mix of
+ * lookup, jump table and bit test dispatch.
+ */
+class SwitchShapeVerifier : public TR::IlVerifier
+   {
+   public:
+   SwitchShapeVerifier(bool expectLookup, bool expectTable, bool expectBitTest)
+      : _expectLookup(expectLookup), _expectTable(expectTable), _expectBitTest(expectBitTest)
+      {
+      }
+
+   int32_t verify(TR::ResolvedMethodSymbol *sym)
+      {
+      bool sawLookup = false;
+      bool sawTable = false;
+      bool sawBitTest = false;
+      for (TR::PreorderNodeIterator iter(sym->getFirstTreeTop(), sym->comp()); iter.currentTree(); ++iter)
+         {
+         TR::Node *node = iter.currentNode();
+         if (node->getOpCodeValue() == TR::lookup)
+            sawLookup = true;
+         else if (node->getOpCodeValue() == TR::table)
+            sawTable = true;
+         else if ((node->getOpCodeValue() == TR::iand || node->getOpCodeValue() == TR::land) &&
+                  node->getFirstChild()->getOpCode().isLeftShift())
+            sawBitTest = true;
+         }
+
+      return (sawLookup == _expectLookup && sawTable == _expectTable && sawBitTest == _expectBitTest) ? 0 : 1;
+      }
+
+   private:
+   bool _expectLookup;
+   bool _expectTable;
+   bool _expectBitTest;
+   };
+
+/*
+ * int32_t f(int32_t x) { switch (x) { case v: return r; ... default: return -1; } }
+ *
+ * Cases sharing a result branch to the same block.
+ */
+static const int32_t defaultResult = -1;
+
+static std::string
+lookupMethod(const std::map<int32_t, int32_t> &cases)
+   {
+   std::string source = "(method return=Int32 args=[Int32] (block (lookup (iload parm=0) (case target=\"default\")";
+   for (auto it = cases.begin(); it != cases.end(); ++it)
+      source += " (case value=" + std::to_string(it->first) + " target=\"r" + std::to_string(it->second) + "\")";
+   source += "))";
+
+   std::map<int32_t, bool> results;
+   for (auto it = cases.begin(); it != cases.end(); ++it)
+      {
+      if (results[it->second])
+         continue;
+      results[it->second] = true;
+      source += " (block name=\"r" + std::to_string(it->second) + "\" (ireturn (iconst " + std::to_string(it->second) + ")))";
+      }
+   source += " (block name=\"default\" (ireturn (iconst " + std::to_string(defaultResult) + "))))";
+   return source;
+   }
+
+static void
+checkDispatch(int32_t (*entry)(int32_t), const std::map<int32_t, int32_t> &cases, const std::string &source)
+   {
+   std::vector<int32_t> inputs = { 0, -1, 1, 63, 64, 65, std::numeric_limits<int32_t>::min(), std::numeric_limits<int32_t>::max() };
+   for (auto it = cases.begin(); it != cases.end(); ++it)
+      {
+      inputs.push_back(it->first - 1);
+      inputs.push_back(it->first);
+      inputs.push_back(it->first + 1);
+      inputs.push_back(it->first + 64);
+      }
+
+   for (auto it = inputs.begin(); it != inputs.end(); ++it)
+      {
+      auto match = cases.find(*it);
+      int32_t expected = match == cases.end() ? defaultResult : match->second;
+      EXPECT_EQ(expected, entry(*it)) << "Selector " << *it << "\nInput trees: " << source;
+      }
+   }
+
+static void
+compileAndCheck(const std::map<int32_t, int32_t> &cases, bool expectLookup, bool expectTable, bool expectBitTest)
+   {
+   std::string source = lookupMethod(cases);
+   auto trees = parseString(source.c_str());
+   ASSERT_NOTNULL(trees) << "Failed to parse " << source;
+
+   Tril::DefaultCompiler compiler(trees);
+   SwitchShapeVerifier verifier(expectLookup, expectTable, expectBitTest);
+   ASSERT_EQ(0, compiler.compileWithVerifier(&verifier)) << "Compilation failed or the switch was not lowered as expected\n" << "Input trees: " << source;
+
+   checkDispatch(compiler.getEntryPoint<int32_t (*)(int32_t)>(), cases, source);
+   }
+
+TEST_F(SwitchLoweringTest, DenseCasesUseJumpTable)
+   {
+   std::map<int32_t, int32_t> cases;
+   for (int32_t value = 10; value < 26; value++)
+      cases[value] = value * 3;
+
+   compileAndCheck(cases, false, true, false);
+   }
+
+TEST_F(SwitchLoweringTest, SparseCasesUseBinarySearch)
+   {
+   // Too sparse to cluster: the lookup is left to the code generator's
+   // binary search
+   std::map<int32_t, int32_t> cases;
+   cases[-100000] = 1;
+   cases[-700] = 2;
+   cases[3] = 3;
+   cases[1000] = 4;
+   cases[20000] = 5;
+   cases[300000] = 6;
+   cases[1 << 24] = 7;
+   cases[0x7fff0000] = 8;
+
+   compileAndCheck(cases, true, false, false);
+   }
+
+TEST_F(SwitchLoweringTest, FewTargetsUseBitTests)
+   {
+   // A lexer's character classes: white space and digits
+   std::map<int32_t, int32_t> cases;
+   cases['\t'] = 1;
+   cases['\n'] = 1;
+   cases['\r'] = 1;
+   cases[' '] = 1;
+   for (int32_t c = '0'; c <= '9'; c++)
+      cases[c] = 2;
+
+   compileAndCheck(cases, false, false, true);
+   }
+
+TEST_F(SwitchLoweringTest, NarrowBitTest)
+   {
+   std::map<int32_t, int32_t> cases;
+   cases[100] = 1;
+   cases[103] = 2;
+   cases[107] = 1;
+   cases[111] = 2;
+   cases[115] = 1;
+   cases[120] = 3;
+   cases[125] = 1;
+
+   compileAndCheck(cases, false, false, true);
+   }
+
+TEST_F(SwitchLoweringTest, MixedCasesCombineLowerings)
+   {
+   std::map<int32_t, int32_t> cases;
+   for (int32_t value = 0; value < 16; value++)
+      cases[value] = value + 100;
+   for (int32_t value = 200; value < 240; value += 3)
+      cases[value] = (value & 1) ? 1 : 2;
+   cases[5000] = 3;
+   cases[90000] = 4;
+   cases[-40000] = 5;
+
+   compileAndCheck(cases, false, true, true);
+   }
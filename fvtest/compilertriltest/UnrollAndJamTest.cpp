@@ -0,0 +1,342 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JitTest.hpp"
+#include "default_compiler.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/**
+ * Test fixture that runs only unroll-and-jam.
+ *
+ * Each kernel is checked against a C++ oracle for outer trip counts around
+ * the unroll factor, with and without aliasing between its arrays, and is
+ * timed against a compilation with no optimizations. Timings are recorded
+ * as test properties and are informational only.
+ */
+class UnrollAndJamTest : public TRTest::JitOptTest
+   {
+   public:
+   UnrollAndJamTest()
+      {
+      addOptimization(OMR::unrollAndJam);
+      }
+
+   int32_t compileScalar(Tril::DefaultCompiler &compiler)
+      {
+      static const OptimizationStrategy noOpts[] = { { OMR::endOpts } };
+      TR::Optimizer::setMockStrategy(noOpts);
+      int32_t rc = compiler.compile();
+      TR::Optimizer::setMockStrategy(NULL);
+      return rc;
+      }
+
+   template <typename F>
+   static double timeCalls(F call, int32_t repetitions)
+      {
+      auto start = std::chrono::steady_clock::now();
+      for (int32_t i = 0; i < repetitions; i++)
+         call();
+      return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+      }
+
+   void recordSpeedup(double baselineTime, double jammedTime)
+      {
+      char buffer[64];
+      std::snprintf(buffer, sizeof(buffer), "%.2f", jammedTime > 0 ? baselineTime / jammedTime : 0.0);
+      RecordProperty("speedup", buffer);
+      std::snprintf(buffer, sizeof(buffer), "%.3f", baselineTime);
+      RecordProperty("baselineMillis", buffer);
+      std::snprintf(buffer, sizeof(buffer), "%.3f", jammedTime);
+      RecordProperty("jammedMillis", buffer);
+      }
+   };
+
+static const int32_t tripCounts[] = { 1, 2, 3, 4, 5, 7, 8, 9, 31, 64 };
+static const int32_t matrixSize = 64;
+static const int32_t benchmarkRepetitions = 200;
+
+/*
+ * void multiply(double *a, double *b, double *c, int32_t n, int32_t m)
+ *    for (int32_t i = 0; i < n; i++)
+ *       for (int32_t j = 0; j < m; j++)
+ *          {
+ *          double sum = 0;
+ *          for (int32_t k = 0; k < 64; k++)
+ *             sum += a[i * 64 + k] * b[k * 64 + j];
+ *          c[i * 64 + j] = sum;
+ *          }
+ */
+static const char *matrixMultiplyTrees =
+   "(method return=NoType args=[Address, Address, Address, Int32, Int32] mayHaveLoops=1    "
+   "  (block                                                                               "
+   "    (istore temp=\"i\" (iconst 0))                                                    "
+   "    (ificmple target=done (iload parm=3) (iconst 0)))                                  "
+   "  (block name=rows                                                                     "
+   "    (istore temp=\"j\" (iconst 0)))                                                   "
+   "  (block name=columns                                                                  "
+   "    (dstore temp=\"sum\" (dconst 0.0))                                                "
+   "    (istore temp=\"k\" (iconst 0)))                                                   "
+   "  (block name=dot                                                                      "
+   "    (dstore temp=\"sum\"                                                              "
+   "      (dadd                                                                            "
+   "        (dload temp=\"sum\")                                                          "
+   "        (dmul                                                                          "
+   "          (dloadi offset=0 (aladd (aload parm=0)                                       "
+   "            (lmul (i2l (iadd (imul (iload temp=\"i\") (iconst 64)) (iload temp=\"k\"))) (lconst 8))))"
+   "          (dloadi offset=0 (aladd (aload parm=1)                                       "
+   "            (lmul (i2l (iadd (imul (iload temp=\"k\") (iconst 64)) (iload temp=\"j\"))) (lconst 8)))))))"
+   "    (istore temp=\"k\" (iadd (iload temp=\"k\") (iconst 1)))                          "
+   "    (ificmplt target=dot (iload temp=\"k\") (iconst 64)))                             "
+   "  (block                                                                               "
+   "    (dstorei offset=0 (aladd (aload parm=2)                                            "
+   "        (lmul (i2l (iadd (imul (iload temp=\"i\") (iconst 64)) (iload temp=\"j\"))) (lconst 8)))"
+   "      (dload temp=\"sum\"))                                                           "
+   "    (istore temp=\"j\" (iadd (iload temp=\"j\") (iconst 1)))                          "
+   "    (ificmplt target=columns (iload temp=\"j\") (iload parm=4)))                      "
+   "  (block                                                                               "
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))                          "
+   "    (ificmplt target=rows (iload temp=\"i\") (iload parm=3)))                         "
+   "  (block name=done                                                                     "
+   "    (return)))                                                                         ";
+
+static void multiplyOracle(const double *a, const double *b, double *c, int32_t n, int32_t m)
+   {
+   for (int32_t i = 0; i < n; i++)
+      for (int32_t j = 0; j < m; j++)
+         {
+         double sum = 0;
+         for (int32_t k = 0; k < matrixSize; k++)
+            sum += a[i * matrixSize + k] * b[k * matrixSize + j];
+         c[i * matrixSize + j] = sum;
+         }
+   }
+
+TEST_F(UnrollAndJamTest, MatrixMultiply)
+   {
+   auto trees = parseString(matrixMultiplyTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << matrixMultiplyTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(double *, double *, double *, int32_t, int32_t)>();
+
+   const int32_t n = 3;
+   std::vector<double> a(n * matrixSize), b(matrixSize * matrixSize);
+   for (int32_t i = 0; i < n * matrixSize; i++)
+      a[i] = (i % 13) * 0.25 - 1.0;
+   for (int32_t i = 0; i < matrixSize * matrixSize; i++)
+      b[i] = (i % 7) * 0.5 + 0.125;
+
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t m = tripCounts[t];
+      std::vector<double> c(n * matrixSize, -1.0), expected(n * matrixSize, -1.0);
+      multiplyOracle(a.data(), b.data(), expected.data(), n, m);
+
+      entry_point(a.data(), b.data(), c.data(), n, m);
+      for (int32_t i = 0; i < n * matrixSize; i++)
+         EXPECT_EQ(expected[i], c[i]) << "m = " << m << ", i = " << i;
+      }
+   }
+
+TEST_F(UnrollAndJamTest, MatrixMultiplyInPlace)
+   {
+   auto trees = parseString(matrixMultiplyTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << matrixMultiplyTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(double *, double *, double *, int32_t, int32_t)>();
+
+   // c is a, so each row is read after some of its elements are replaced and
+   // the overlap checks must select the original nest
+   const int32_t n = 2;
+   std::vector<double> b(matrixSize * matrixSize);
+   for (int32_t i = 0; i < matrixSize * matrixSize; i++)
+      b[i] = (i % 5) * 0.25;
+
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t m = tripCounts[t];
+      std::vector<double> data(n * matrixSize), expected(n * matrixSize);
+      for (int32_t i = 0; i < n * matrixSize; i++)
+         data[i] = expected[i] = (i % 11) - 5.0;
+      multiplyOracle(expected.data(), b.data(), expected.data(), n, m);
+
+      entry_point(data.data(), b.data(), data.data(), n, m);
+      for (int32_t i = 0; i < n * matrixSize; i++)
+         EXPECT_EQ(expected[i], data[i]) << "m = " << m << ", i = " << i;
+      }
+   }
+
+TEST_F(UnrollAndJamTest, MatrixMultiplySpeedup)
+   {
+   auto trees = parseString(matrixMultiplyTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler jammedCompiler(trees);
+   ASSERT_EQ(0, jammedCompiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << matrixMultiplyTrees;
+   Tril::DefaultCompiler baselineCompiler(trees);
+   ASSERT_EQ(0, compileScalar(baselineCompiler)) << "Compilation failed unexpectedly\n" << "Input trees: " << matrixMultiplyTrees;
+
+   auto jammed_entry = jammedCompiler.getEntryPoint<void (*)(double *, double *, double *, int32_t, int32_t)>();
+   auto baseline_entry = baselineCompiler.getEntryPoint<void (*)(double *, double *, double *, int32_t, int32_t)>();
+
+   std::vector<double> a(matrixSize * matrixSize), b(matrixSize * matrixSize);
+   std::vector<double> c(matrixSize * matrixSize), d(matrixSize * matrixSize);
+   for (int32_t i = 0; i < matrixSize * matrixSize; i++)
+      {
+      a[i] = (i % 9) * 0.5;
+      b[i] = (i % 4) - 1.5;
+      }
+
+   double baselineTime = timeCalls([&]() { baseline_entry(a.data(), b.data(), d.data(), matrixSize, matrixSize); }, benchmarkRepetitions);
+   double jammedTime = timeCalls([&]() { jammed_entry(a.data(), b.data(), c.data(), matrixSize, matrixSize); }, benchmarkRepetitions);
+   recordSpeedup(baselineTime, jammedTime);
+
+   for (int32_t i = 0; i < matrixSize * matrixSize; i++)
+      ASSERT_EQ(d[i], c[i]) << "i = " << i;
+   }
+
+/*
+ * void relax(double *in, double *out, int32_t rows)
+ *    for (int32_t i = 1; i < rows - 1; i++)
+ *       for (int32_t j = 1; j < 255; j++)
+ *          out[i * 256 + j] = ((in[(i - 1) * 256 + j] + in[(i + 1) * 256 + j]) +
+ *                              (in[i * 256 + j - 1] + in[i * 256 + j + 1])) * 0.25;
+ */
+static const char *stencilTrees =
+   "(method return=NoType args=[Address, Address, Int32] mayHaveLoops=1                    "
+   "  (block                                                                               "
+   "    (istore temp=\"i\" (iconst 1))                                                    "
+   "    (ificmple target=done (iload parm=2) (iconst 2)))                                  "
+   "  (block name=rows                                                                     "
+   "    (istore temp=\"j\" (iconst 1)))                                                   "
+   "  (block name=columns                                                                  "
+   "    (dstorei offset=0 (aladd (aload parm=1)                                            "
+   "        (lmul (i2l (iadd (imul (iload temp=\"i\") (iconst 256)) (iload temp=\"j\"))) (lconst 8)))"
+   "      (dmul                                                                            "
+   "        (dadd                                                                          "
+   "          (dadd                                                                        "
+   "            (dloadi offset=0 (aladd (aload parm=0)                                     "
+   "              (lmul (i2l (iadd (imul (isub (iload temp=\"i\") (iconst 1)) (iconst 256)) (iload temp=\"j\"))) (lconst 8))))"
+   "            (dloadi offset=0 (aladd (aload parm=0)                                     "
+   "              (lmul (i2l (iadd (imul (iadd (iload temp=\"i\") (iconst 1)) (iconst 256)) (iload temp=\"j\"))) (lconst 8)))))"
+   "          (dadd                                                                        "
+   "            (dloadi offset=0 (aladd (aload parm=0)                                     "
+   "              (lmul (i2l (iadd (imul (iload temp=\"i\") (iconst 256)) (isub (iload temp=\"j\") (iconst 1)))) (lconst 8))))"
+   "            (dloadi offset=0 (aladd (aload parm=0)                                     "
+   "              (lmul (i2l (iadd (imul (iload temp=\"i\") (iconst 256)) (iadd (iload temp=\"j\") (iconst 1)))) (lconst 8))))))"
+   "        (dconst 0.25)))                                                                "
+   "    (istore temp=\"j\" (iadd (iload temp=\"j\") (iconst 1)))                          "
+   "    (ificmplt target=columns (iload temp=\"j\") (iconst 255)))                        "
+   "  (block                                                                               "
+   "    (istore temp=\"i\" (iadd (iload temp=\"i\") (iconst 1)))                          "
+   "    (ificmplt target=rows (iload temp=\"i\") (isub (iload parm=2) (iconst 1))))       "
+   "  (block name=done                                                                     "
+   "    (return)))                                                                         ";
+
+static const int32_t stencilColumns = 256;
+
+static void stencilOracle(const double *in, double *out, int32_t rows)
+   {
+   for (int32_t i = 1; i < rows - 1; i++)
+      for (int32_t j = 1; j < stencilColumns - 1; j++)
+         out[i * stencilColumns + j] = ((in[(i - 1) * stencilColumns + j] + in[(i + 1) * stencilColumns + j]) +
+                                        (in[i * stencilColumns + j - 1] + in[i * stencilColumns + j + 1])) * 0.25;
+   }
+
+TEST_F(UnrollAndJamTest, Stencil)
+   {
+   auto trees = parseString(stencilTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << stencilTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(double *, double *, int32_t)>();
+
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t rows = tripCounts[t] + 2;
+      std::vector<double> in(rows * stencilColumns), out(rows * stencilColumns, 0.0), expected(rows * stencilColumns, 0.0);
+      for (int32_t i = 0; i < rows * stencilColumns; i++)
+         in[i] = (i % 17) * 0.5 - 3.0;
+      stencilOracle(in.data(), expected.data(), rows);
+
+      entry_point(in.data(), out.data(), rows);
+      for (int32_t i = 0; i < rows * stencilColumns; i++)
+         EXPECT_EQ(expected[i], out[i]) << "rows = " << rows << ", i = " << i;
+      }
+   }
+
+TEST_F(UnrollAndJamTest, StencilInPlace)
+   {
+   auto trees = parseString(stencilTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler compiler(trees);
+   ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << stencilTrees;
+   auto entry_point = compiler.getEntryPoint<void (*)(double *, double *, int32_t)>();
+
+   // Relaxing in place reads the rows updated by earlier outer iterations,
+   // which the jammed nest must not reorder
+   for (int32_t t = 0; t < sizeof(tripCounts) / sizeof(*tripCounts); t++)
+      {
+      int32_t rows = tripCounts[t] + 2;
+      std::vector<double> data(rows * stencilColumns), expected(rows * stencilColumns);
+      for (int32_t i = 0; i < rows * stencilColumns; i++)
+         data[i] = expected[i] = (i % 23) * 0.25;
+      stencilOracle(expected.data(), expected.data(), rows);
+
+      entry_point(data.data(), data.data(), rows);
+      for (int32_t i = 0; i < rows * stencilColumns; i++)
+         EXPECT_EQ(expected[i], data[i]) << "rows = " << rows << ", i = " << i;
+      }
+   }
+
+TEST_F(UnrollAndJamTest, StencilSpeedup)
+   {
+   auto trees = parseString(stencilTrees);
+   ASSERT_NOTNULL(trees);
+
+   Tril::DefaultCompiler jammedCompiler(trees);
+   ASSERT_EQ(0, jammedCompiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << stencilTrees;
+   Tril::DefaultCompiler baselineCompiler(trees);
+   ASSERT_EQ(0, compileScalar(baselineCompiler)) << "Compilation failed unexpectedly\n" << "Input trees: " << stencilTrees;
+
+   auto jammed_entry = jammedCompiler.getEntryPoint<void (*)(double *, double *, int32_t)>();
+   auto baseline_entry = baselineCompiler.getEntryPoint<void (*)(double *, double *, int32_t)>();
+
+   const int32_t rows = 128;
+   std::vector<double> in(rows * stencilColumns), out(rows * stencilColumns, 0.0), expected(rows * stencilColumns, 0.0);
+   for (int32_t i = 0; i < rows * stencilColumns; i++)
+      in[i] = (i % 29) * 0.125;
+
+   double baselineTime = timeCalls([&]() { baseline_entry(in.data(), expected.data(), rows); }, benchmarkRepetitions);
+   double jammedTime = timeCalls([&]() { jammed_entry(in.data(), out.data(), rows); }, benchmarkRepetitions);
+   recordSpeedup(baselineTime, jammedTime);
+
+   for (int32_t i = 0; i < rows * stencilColumns; i++)
+      ASSERT_EQ(expected[i], out[i]) << "i = " << i;
+   }
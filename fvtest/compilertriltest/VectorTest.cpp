@@ -21,9 +21,74 @@
 
 #include "JitTest.hpp"
 #include "default_compiler.hpp"
+#include "env/CompilerEnv.hpp"
+
+#include <cstdio>
 
 class VectorTest : public TRTest::JitTest {};
 
+/**
+ * Tests for the 256 and 512-bit vector types, which are generated on x86 CPUs
+ * with AVX2 and AVX-512. Each test applies an operation to two arrays of one
+ * wide vector each and checks every lane against a C++ oracle.
+ */
+class WideVectorTest : public TRTest::JitTest
+   {
+   public:
+
+   static bool supportsVectorLength(int32_t bits)
+      {
+#if defined(TR_TARGET_X86)
+      if (bits == 256)
+         return TR::Compiler->target.cpu.supportsAVX2();
+      if (bits == 512)
+         return TR::Compiler->target.cpu.supportsAVX512F() && TR::Compiler->target.cpu.supportsAVX512BW() && TR::Compiler->target.cpu.supportsAVX512DQ();
+#endif
+      return false;
+      }
+
+   template <typename T>
+   void testBinaryOp(const char *opName, const char *typeName, int32_t bits, T (*oracle)(T, T))
+      {
+      SKIP_IF(!supportsVectorLength(bits), MissingImplementation) << bits << "-bit vectors are not supported on this platform";
+
+      char inputTrees[512] = {0};
+      std::snprintf(inputTrees, sizeof(inputTrees),
+                    "(method return= NoType args=[Address,Address,Address]"
+                    "  (block"
+                    "     (vstorei type=%s offset=0"
+                    "         (aload parm=0)"
+                    "            (%s"
+                    "                 (vloadi type=%s (aload parm=1))"
+                    "                 (vloadi type=%s (aload parm=2))))"
+                    "     (return)))",
+                    typeName, opName, typeName, typeName);
+      auto trees = parseString(inputTrees);
+      ASSERT_NOTNULL(trees) << "Trees failed to parse\n" << inputTrees;
+
+      Tril::DefaultCompiler compiler(trees);
+      ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+      auto entry_point = compiler.getEntryPoint<void (*)(T[], T[], T[])>();
+
+      const int32_t lanes = bits / 8 / sizeof(T);
+      T output[64];
+      T inputA[64];
+      T inputB[64];
+      for (int32_t i = 0; i < lanes; i++)
+         {
+         output[i] = 0;
+         inputA[i] = static_cast<T>(3 * i - 7);
+         inputB[i] = static_cast<T>(i % 5 + 1);
+         }
+
+      entry_point(output, inputA, inputB);
+
+      for (int32_t i = 0; i < lanes; i++)
+         EXPECT_EQ(oracle(inputA[i], inputB[i]), output[i]) << "lane " << i << " of " << opName << " " << typeName;
+      }
+   };
+
 
 TEST_F(VectorTest, VDoubleAdd) { 
 
@@ -923,3 +988,114 @@ TEST_F(VectorTest, VInt8Not) {
         EXPECT_EQ(~inputA[i], output[i]);
     }
 }
+
+template <typename T> static T add(T a, T b) { return a + b; }
+template <typename T> static T sub(T a, T b) { return a - b; }
+template <typename T> static T mul(T a, T b) { return a * b; }
+template <typename T> static T div(T a, T b) { return a / b; }
+template <typename T> static T bitAnd(T a, T b) { return a & b; }
+template <typename T> static T bitOr(T a, T b) { return a | b; }
+template <typename T> static T bitXor(T a, T b) { return a ^ b; }
+
+TEST_F(WideVectorTest, V256Int8Add) { testBinaryOp<int8_t>("vadd", "Vector256Int8", 256, add); }
+TEST_F(WideVectorTest, V256Int16Mul) { testBinaryOp<int16_t>("vmul", "Vector256Int16", 256, mul); }
+TEST_F(WideVectorTest, V256Int32Sub) { testBinaryOp<int32_t>("vsub", "Vector256Int32", 256, sub); }
+TEST_F(WideVectorTest, V256Int64Add) { testBinaryOp<int64_t>("vadd", "Vector256Int64", 256, add); }
+TEST_F(WideVectorTest, V256Int32And) { testBinaryOp<int32_t>("vand", "Vector256Int32", 256, bitAnd); }
+TEST_F(WideVectorTest, V256Int64Or) { testBinaryOp<int64_t>("vor", "Vector256Int64", 256, bitOr); }
+TEST_F(WideVectorTest, V256Int32Xor) { testBinaryOp<int32_t>("vxor", "Vector256Int32", 256, bitXor); }
+TEST_F(WideVectorTest, V256FloatMul) { testBinaryOp<float>("vmul", "Vector256Float", 256, mul); }
+TEST_F(WideVectorTest, V256DoubleDiv) { testBinaryOp<double>("vdiv", "Vector256Double", 256, div); }
+
+TEST_F(WideVectorTest, V512Int8Sub) { testBinaryOp<int8_t>("vsub", "Vector512Int8", 512, sub); }
+TEST_F(WideVectorTest, V512Int16Add) { testBinaryOp<int16_t>("vadd", "Vector512Int16", 512, add); }
+TEST_F(WideVectorTest, V512Int32Mul) { testBinaryOp<int32_t>("vmul", "Vector512Int32", 512, mul); }
+TEST_F(WideVectorTest, V512Int64Sub) { testBinaryOp<int64_t>("vsub", "Vector512Int64", 512, sub); }
+TEST_F(WideVectorTest, V512Int32Xor) { testBinaryOp<int32_t>("vxor", "Vector512Int32", 512, bitXor); }
+TEST_F(WideVectorTest, V512FloatAdd) { testBinaryOp<float>("vadd", "Vector512Float", 512, add); }
+TEST_F(WideVectorTest, V512DoubleMul) { testBinaryOp<double>("vmul", "Vector512Double", 512, mul); }
+
+/*
+ * getvelem numbers the elements from the most significant end of the vector,
+ * the same as for 128-bit vectors, so the upper 128-bit lanes are read here.
+ */
+TEST_F(WideVectorTest, V256Int32GetElement) {
+    SKIP_IF(!supportsVectorLength(256), MissingImplementation) << "256-bit vectors are not supported on this platform";
+
+    auto inputTrees = "(method return=NoType args=[Address,Address]                   "
+                      "  (block                                                       "
+                      "     (istorei offset=0                                         "
+                      "        (aload parm=0)                                         "
+                      "        (getvelem (vloadi type=Vector256Int32 (aload parm=1))  "
+                      "                  (iconst 1)))                                 "
+                      "     (return)))                                                ";
+    auto trees = parseString(inputTrees);
+    ASSERT_NOTNULL(trees);
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<void (*)(int32_t *, int32_t[])>();
+
+    int32_t output = 0;
+    int32_t input[] = {10, 11, 12, 13, 14, 15, 16, 17};
+    entry_point(&output, input);
+    EXPECT_EQ(16, output);
+}
+
+TEST_F(WideVectorTest, V512DoubleGetElement) {
+    SKIP_IF(!supportsVectorLength(512), MissingImplementation) << "512-bit vectors are not supported on this platform";
+
+    auto inputTrees = "(method return=Double args=[Address]                           "
+                      "  (block                                                       "
+                      "     (dreturn                                                  "
+                      "        (getvelem (vloadi type=Vector512Double (aload parm=0)) "
+                      "                  (iconst 2)))))                               ";
+    auto trees = parseString(inputTrees);
+    ASSERT_NOTNULL(trees);
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<double (*)(double[])>();
+
+    double input[] = {1.5, 2.5, 3.5, 4.5, 5.5, 6.5, 7.5, 8.5};
+    EXPECT_DOUBLE_EQ(6.5, entry_point(input));
+}
+
+static double scalarSquare(double x) { return x * x; }
+
+/*
+ * The upper halves of the YMM registers are cleared before the call, so the
+ * callee's SSE code is not slowed down, without losing the vector result.
+ */
+TEST_F(WideVectorTest, V256CallAfterVectorOp) {
+    SKIP_IF(!supportsVectorLength(256), MissingImplementation) << "256-bit vectors are not supported on this platform";
+
+    char inputTrees[600] = {0};
+    std::snprintf(inputTrees, sizeof(inputTrees),
+                  "(method return=Double args=[Address,Address,Address]"
+                  "  (block"
+                  "     (vstorei type=Vector256Double offset=0"
+                  "         (aload parm=0)"
+                  "            (vadd"
+                  "                 (vloadi type=Vector256Double (aload parm=1))"
+                  "                 (vloadi type=Vector256Double (aload parm=2))))"
+                  "     (dreturn (dcall address=0x%jX args=[Double] (dloadi offset=8 (aload parm=0))))))",
+                  reinterpret_cast<uintmax_t>(&scalarSquare));
+    auto trees = parseString(inputTrees);
+    ASSERT_NOTNULL(trees) << "Trees failed to parse\n" << inputTrees;
+
+    Tril::DefaultCompiler compiler(trees);
+    ASSERT_EQ(0, compiler.compile()) << "Compilation failed unexpectedly\n" << "Input trees: " << inputTrees;
+
+    auto entry_point = compiler.getEntryPoint<double (*)(double[], double[], double[])>();
+
+    double output[] = {0.0, 0.0, 0.0, 0.0};
+    double inputA[] = {1.0, 2.0, 3.0, 4.0};
+    double inputB[] = {0.5, 1.0, 1.5, 2.0};
+
+    EXPECT_DOUBLE_EQ(9.0, entry_point(output, inputA, inputB));
+    for (int i = 0; i < 4; i++)
+        EXPECT_DOUBLE_EQ(inputA[i] + inputB[i], output[i]);
+}
@@ -0,0 +1,212 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "CompilerUnitTest.hpp"
+#include "env/FrontEnd.hpp"
+#include "runtime/CodeCache.hpp"
+#include "runtime/CodeCacheManager.hpp"
+
+#include <map>
+#include <random>
+
+/**
+ * Stress test for reusing freed code cache memory.
+ *
+ * Warm and cold blocks of random sizes are allocated from one code cache and
+ * freed again in random order. After every operation the free blocks must be
+ * sorted, coalesced and disjoint from the live blocks, and every allocation
+ * that can be satisfied from a free block must get the best fit.
+ */
+class CodeCacheTest : public ::testing::Test {
+protected:
+    CodeCacheTest() : _jitInit() {}
+
+    struct FreeBlockSummary {
+        OMR::CodeCacheFreeCacheBlock *bestFit;
+        size_t largestWarm;
+        size_t largestCold;
+        size_t bytesFree;
+    };
+
+    /*
+     * Check the free list against the blocks that are still allocated and
+     * find the block a best-fit allocation of the given size should return.
+     */
+    FreeBlockSummary checkFreeBlocks(TR::CodeCache *cache, size_t size, bool isCold) {
+        FreeBlockSummary summary = { NULL, 0, 0, 0 };
+        OMR::CodeCacheFreeCacheBlock *prev = NULL;
+        for (OMR::CodeCacheFreeCacheBlock *block = cache->freeBlockList(); block; block = block->_next) {
+            uint8_t *start = reinterpret_cast<uint8_t *>(block);
+            uint8_t *end = start + block->_size;
+            bool blockIsCold = start >= cache->getWarmCodeAlloc();
+
+            if (prev) {
+                uint8_t *prevEnd = reinterpret_cast<uint8_t *>(prev) + prev->_size;
+                bool prevIsCold = reinterpret_cast<uint8_t *>(prev) >= cache->getWarmCodeAlloc();
+                EXPECT_LT(prevEnd, start + (prevIsCold == blockIsCold ? 0 : 1)) << "Free blocks overlap or were not coalesced";
+            }
+
+            std::map<uint8_t *, size_t>::iterator live = _live.lower_bound(start);
+            if (live != _live.end())
+                EXPECT_LE(end, live->first) << "Free block overlaps a live block";
+            if (live != _live.begin()) {
+                --live;
+                EXPECT_LE(live->first + live->second, start) << "Free block overlaps a live block";
+            }
+
+            if (blockIsCold)
+                summary.largestCold = std::max(summary.largestCold, block->_size);
+            else
+                summary.largestWarm = std::max(summary.largestWarm, block->_size);
+            if (blockIsCold == isCold && block->_size >= size && (!summary.bestFit || block->_size < summary.bestFit->_size))
+                summary.bestFit = block;
+            summary.bytesFree += block->_size;
+            prev = block;
+        }
+        EXPECT_EQ(summary.largestWarm, cache->getSizeOfLargestFreeWarmBlock());
+        EXPECT_EQ(summary.largestCold, cache->getSizeOfLargestFreeColdBlock());
+        return summary;
+    }
+
+    void addLive(uint8_t *code) {
+        uint8_t *header = code - sizeof(OMR::CodeCacheMethodHeader);
+        size_t size = reinterpret_cast<OMR::CodeCacheMethodHeader *>(header)->_size;
+
+        std::map<uint8_t *, size_t>::iterator next = _live.lower_bound(header);
+        if (next != _live.end())
+            ASSERT_LE(header + size, next->first) << "Allocation overlaps a live block";
+        if (next != _live.begin()) {
+            --next;
+            ASSERT_LE(next->first + next->second, header) << "Allocation overlaps a live block";
+        }
+        _live[header] = size;
+    }
+
+    TRTest::JitInitializer _jitInit;
+    std::map<uint8_t *, size_t> _live;
+};
+
+TEST_F(CodeCacheTest, testRandomAllocateAndFree) {
+    TR::CodeCacheManager &manager = TR::FrontEnd::instance()->codeCacheManager();
+    int32_t numReserved = 0;
+    TR::CodeCache *cache = manager.reserveCodeCache(false, 0, 0, &numReserved);
+    ASSERT_TRUE(cache != NULL) << "Failed to reserve a code cache";
+
+    std::mt19937 random(1234);
+    size_t bestFitAllocations = 0;
+    size_t largestFragmentedBytes = 0;
+
+    for (int32_t op = 0; op < 20000; op++) {
+        bool allocate = _live.empty() || random() % 8 < 5;
+        if (allocate) {
+            bool withCold = random() % 4 == 0;
+            size_t warmSize = 8 + random() % 800;
+            size_t coldSize = withCold ? 8 + random() % 400 : 0;
+
+            size_t adjustedWarm = warmSize;
+            size_t adjustedCold = coldSize;
+            manager.performSizeAdjustments(adjustedWarm, adjustedCold, false, true);
+            FreeBlockSummary warmSummary = checkFreeBlocks(cache, adjustedWarm, false);
+            FreeBlockSummary coldSummary = checkFreeBlocks(cache, adjustedCold, true);
+
+            uint8_t *coldCode = NULL;
+            uint8_t *warmCode = cache->allocateCodeMemory(warmSize, coldSize, &coldCode, false);
+            if (!warmCode) {
+                allocate = false;
+            } else {
+                uint8_t *warmHeader = warmCode - sizeof(OMR::CodeCacheMethodHeader);
+                if (warmSummary.bestFit && warmSummary.largestWarm >= adjustedWarm) {
+                    EXPECT_EQ(reinterpret_cast<uint8_t *>(warmSummary.bestFit), warmHeader) << "Warm allocation was not a best fit";
+                    bestFitAllocations++;
+                }
+                addLive(warmCode);
+                if (withCold) {
+                    uint8_t *coldHeader = coldCode - sizeof(OMR::CodeCacheMethodHeader);
+                    if (coldSummary.bestFit && coldSummary.largestCold >= adjustedCold)
+                        EXPECT_EQ(reinterpret_cast<uint8_t *>(coldSummary.bestFit), coldHeader) << "Cold allocation was not a best fit";
+                    addLive(coldCode);
+                }
+                if (::testing::Test::HasFatalFailure())
+                    return;
+            }
+        }
+
+        if (!allocate) {
+            // Free up to three random blocks; the cache is full if the allocation failed
+            for (int32_t i = 0; i < 3 && !_live.empty(); i++) {
+                std::map<uint8_t *, size_t>::iterator victim = _live.begin();
+                std::advance(victim, random() % _live.size());
+                uint8_t *start = victim->first;
+                uint8_t *end = start + victim->second;
+                _live.erase(victim);
+                cache->addFreeBlock2(start, end);
+            }
+        }
+
+        FreeBlockSummary summary = checkFreeBlocks(cache, 0, false);
+        size_t largest = std::max(summary.largestWarm, summary.largestCold);
+        largestFragmentedBytes = std::max(largestFragmentedBytes, summary.bytesFree - largest);
+    }
+
+    EXPECT_GT(bestFitAllocations, 0) << "No allocation was satisfied from a free block";
+    RecordProperty("bestFitAllocations", static_cast<int>(bestFitAllocations));
+    RecordProperty("largestFragmentedBytes", static_cast<int>(largestFragmentedBytes));
+
+    manager.unreserveCodeCache(cache);
+}
+
+TEST_F(CodeCacheTest, testFreeCodeMemoryFreesColdCode) {
+    TR::CodeCacheManager &manager = TR::FrontEnd::instance()->codeCacheManager();
+    int32_t numReserved = 0;
+    TR::CodeCache *cache = manager.reserveCodeCache(false, 0, 0, &numReserved);
+    ASSERT_TRUE(cache != NULL) << "Failed to reserve a code cache";
+
+    uint8_t *coldCode = NULL;
+    uint8_t *warmCode = cache->allocateCodeMemory(512, 256, &coldCode, false);
+    ASSERT_TRUE(warmCode != NULL);
+    ASSERT_TRUE(coldCode != NULL);
+
+    // Keep both blocks away from the ends of the warm and cold allocations
+    uint8_t *otherCold = NULL;
+    ASSERT_TRUE(cache->allocateCodeMemory(512, 256, &otherCold, false) != NULL);
+
+    uint8_t *warmHeader = warmCode - sizeof(OMR::CodeCacheMethodHeader);
+    uint8_t *coldHeader = coldCode - sizeof(OMR::CodeCacheMethodHeader);
+    size_t warmSize = reinterpret_cast<OMR::CodeCacheMethodHeader *>(warmHeader)->_size;
+    size_t coldSize = reinterpret_cast<OMR::CodeCacheMethodHeader *>(coldHeader)->_size;
+
+    cache->freeCodeMemory(warmCode, coldCode);
+
+    bool warmFreed = false;
+    bool coldFreed = false;
+    for (OMR::CodeCacheFreeCacheBlock *block = cache->freeBlockList(); block; block = block->_next) {
+        uint8_t *start = reinterpret_cast<uint8_t *>(block);
+        uint8_t *end = start + block->_size;
+        warmFreed |= start <= warmHeader && warmHeader + warmSize <= end;
+        coldFreed |= start <= coldHeader && coldHeader + coldSize <= end;
+    }
+    EXPECT_TRUE(warmFreed) << "Warm code was not freed";
+    EXPECT_TRUE(coldFreed) << "Cold code was not freed";
+    EXPECT_LE(warmSize, cache->getSizeOfLargestFreeWarmBlock());
+    EXPECT_LE(coldSize, cache->getSizeOfLargestFreeColdBlock());
+
+    manager.unreserveCodeCache(cache);
+}
@@ -0,0 +1,189 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "CompilerUnitTest.hpp"
+#include "avl_api.h"
+#include "runtime/CodeMetaDataManager.hpp"
+#include "runtime/CodeMetaDataPOD.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+/**
+ * Tests for looking up method metadata by PC while other threads install and
+ * remove compiled code.
+ *
+ * The manager is given a fake code range so no code cache has to be
+ * allocated; the metadata ranges only ever have their addresses compared.
+ */
+class TestCodeMetaDataManager : public TR::CodeMetaDataManager {
+public:
+    bool addCodeRange(uintptr_t start, uintptr_t end) {
+        TR::MetaDataHashTable *table = allocateCodeMetaDataHash(start, end);
+        if (!table)
+            return false;
+        avl_insert(_metaDataAVL, reinterpret_cast<J9AVLTreeNode *>(table));
+        return true;
+    }
+};
+
+static const uintptr_t codeStart = 0x10000000;
+static const uintptr_t methodSize = 0x200;
+static const uintptr_t numMethods = 2048;
+
+class CodeMetaDataManagerTest : public ::testing::Test {
+protected:
+    CodeMetaDataManagerTest() : _jitInit(), _methods(numMethods) {
+        for (uintptr_t i = 0; i < numMethods; i++) {
+            _methods[i].startPC = codeStart + i * methodSize;
+            _methods[i].endPC = _methods[i].startPC + methodSize - 0x10;
+        }
+    }
+
+    TRTest::JitInitializer _jitInit;
+    TestCodeMetaDataManager _manager;
+    std::vector<TR::MethodMetaDataPOD> _methods;
+};
+
+TEST_F(CodeMetaDataManagerTest, testFindMetaDataForPC) {
+    ASSERT_TRUE(_manager.addCodeRange(codeStart, codeStart + numMethods * methodSize));
+    ASSERT_EQ(NULL, _manager.findMetaDataForPC(_methods[1].startPC));
+
+    ASSERT_TRUE(_manager.insertMetaData(&_methods[2]));
+    ASSERT_TRUE(_manager.insertMetaData(&_methods[0]));
+    ASSERT_TRUE(_manager.insertMetaData(&_methods[1]));
+
+    for (uintptr_t i = 0; i < 3; i++) {
+        ASSERT_EQ(&_methods[i], _manager.findMetaDataForPC(_methods[i].startPC));
+        ASSERT_EQ(&_methods[i], _manager.findMetaDataForPC(_methods[i].endPC - 1));
+        ASSERT_EQ(NULL, _manager.findMetaDataForPC(_methods[i].endPC));
+    }
+    ASSERT_EQ(NULL, _manager.findMetaDataForPC(_methods[3].startPC));
+
+    ASSERT_TRUE(_manager.removeMetaData(&_methods[1]));
+    ASSERT_FALSE(_manager.removeMetaData(&_methods[1]));
+    ASSERT_FALSE(_manager.containsMetaData(&_methods[1]));
+    ASSERT_EQ(NULL, _manager.findMetaDataForPC(_methods[1].startPC + 4));
+    ASSERT_TRUE(_manager.containsMetaData(&_methods[0]));
+    ASSERT_TRUE(_manager.containsMetaData(&_methods[2]));
+}
+
+TEST_F(CodeMetaDataManagerTest, testFailedInsertIsNotPublished) {
+    ASSERT_TRUE(_manager.addCodeRange(codeStart, codeStart + 2 * methodSize));
+
+    TR::MethodMetaDataPOD empty;
+    empty.startPC = codeStart;
+    empty.endPC = codeStart;
+    empty.startColdPC = 0;
+    empty.endColdPC = 0;
+    ASSERT_FALSE(_manager.insertMetaData(&empty));
+    ASSERT_EQ(NULL, _manager.findMetaDataForPC(codeStart));
+}
+
+TEST_F(CodeMetaDataManagerTest, testColdCodeRange) {
+    ASSERT_TRUE(_manager.addCodeRange(codeStart, codeStart + numMethods * methodSize));
+
+    // Cold code is placed far from the warm code, here in the last method's slot
+    TR::MethodMetaDataPOD &method = _methods[0];
+    method.startColdPC = _methods[numMethods - 1].startPC;
+    method.endColdPC = method.startColdPC + 0x40;
+    ASSERT_TRUE(_manager.insertMetaData(&method));
+    ASSERT_TRUE(_manager.insertMetaData(&_methods[1]));
+
+    ASSERT_EQ(&method, _manager.findMetaDataForPC(method.startPC));
+    ASSERT_EQ(&method, _manager.findMetaDataForPC(method.startColdPC));
+    ASSERT_EQ(&method, _manager.findMetaDataForPC(method.endColdPC - 1));
+    ASSERT_EQ(NULL, _manager.findMetaDataForPC(method.endColdPC));
+    ASSERT_EQ(&_methods[1], _manager.findMetaDataForPC(_methods[1].startPC));
+
+    ASSERT_TRUE(_manager.removeMetaData(&method));
+    ASSERT_EQ(NULL, _manager.findMetaDataForPC(method.startPC));
+    ASSERT_EQ(NULL, _manager.findMetaDataForPC(method.startColdPC));
+    ASSERT_TRUE(_manager.containsMetaData(&_methods[1]));
+}
+
+/*
+ * Half of the methods stay installed for the whole test and must always be
+ * found. The other half are installed and removed over and over by a writer
+ * thread, and a lookup may only ever see them or nothing.
+ */
+TEST_F(CodeMetaDataManagerTest, testLookupsDuringCodeInstallation) {
+    ASSERT_TRUE(_manager.addCodeRange(codeStart, codeStart + numMethods * methodSize));
+    for (uintptr_t i = 0; i < numMethods; i += 2)
+        ASSERT_TRUE(_manager.insertMetaData(&_methods[i]));
+
+    const int numReaders = 4;
+    const int writerRounds = 4;
+    std::atomic<bool> done(false);
+    std::atomic<uint64_t> lookups(0);
+    std::atomic<uint64_t> errors(0);
+    std::atomic<uint64_t> writerFailures(0);
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < numReaders; r++) {
+        readers.push_back(std::thread([&, r]() {
+            std::mt19937 random(r);
+            uint64_t count = 0;
+            uint64_t wrong = 0;
+            while (!done.load(std::memory_order_relaxed)) {
+                for (int n = 0; n < 1024; n++) {
+                    uintptr_t i = random() % numMethods;
+                    uintptr_t pc = _methods[i].startPC + random() % methodSize;
+                    const TR::MethodMetaDataPOD *found = _manager.findMetaDataForPC(pc);
+                    const TR::MethodMetaDataPOD *expected = pc < _methods[i].endPC ? &_methods[i] : NULL;
+                    if (found != expected && (found != NULL || i % 2 == 0))
+                        wrong++;
+                }
+                count += 1024;
+            }
+            lookups += count;
+            errors += wrong;
+        }));
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int round = 0; round < writerRounds; round++) {
+        for (uintptr_t i = 1; i < numMethods; i += 2)
+            if (!_manager.insertMetaData(&_methods[i]))
+                writerFailures++;
+        for (uintptr_t i = 1; i < numMethods; i += 2)
+            if (!_manager.removeMetaData(&_methods[i]))
+                writerFailures++;
+    }
+    done = true;
+    for (std::vector<std::thread>::iterator it = readers.begin(); it != readers.end(); ++it)
+        it->join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    EXPECT_EQ(0, writerFailures.load());
+    EXPECT_EQ(0, errors.load());
+    for (uintptr_t i = 0; i < numMethods; i++)
+        EXPECT_EQ(i % 2 == 0, _manager.containsMetaData(&_methods[i]));
+
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.0f", lookups.load() / seconds);
+    RecordProperty("lookupsPerSecond", buffer);
+    snprintf(buffer, sizeof(buffer), "%.0f", writerRounds * numMethods / seconds);
+    RecordProperty("updatesPerSecond", buffer);
+}
@@ -28,6 +28,7 @@
 #include "Jit.hpp"
 #include "codegen/CodeGenerator.hpp"
 #include "compile/Compilation.hpp"
+#include "control/Options.hpp"
 #include "env/ConcreteFE.hpp"
 #include "env/SystemSegmentProvider.hpp"
 #include "ilgen/IlGenRequest.hpp"
@@ -83,7 +84,7 @@ public:
         _dispatchRegion(_segmentProvider, _rawAllocator),
         _trMemory(*OMR::FrontEnd::singleton().persistentMemory(), _dispatchRegion),
         _types(),
-        _options(),
+        _options(*TR::Options::getCmdLineOptions()),
         _ilGenRequest(),
         _method("compunittest", "0", "test", 0, NULL, _types.NoType, NULL, NULL),
         _comp(0, NULL, &OMR::FrontEnd::singleton(), &_method, _ilGenRequest, _options, _dispatchRegion, &_trMemory, TR_OptimizationPlan::alloc(warm)) {
@@ -103,7 +104,7 @@ protected:
     TR::Region _dispatchRegion;
     TR_Memory _trMemory;
     TR::TypeDictionary _types;
-    TR::Options _options;
+    TR::Options _options; // copied from the command line options, as the default constructor leaves most fields unset
     NullIlGenRequest _ilGenRequest;
     TR::ResolvedMethodSymbol* _symbol;
     TR::ResolvedMethod _method;
@@ -0,0 +1,306 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <random>
+#include <set>
+#include "CompilerUnitTest.hpp"
+#include "infra/BitVector.hpp"
+#include "infra/HybridBitVector.hpp"
+
+class HybridBitVectorTest : public TRTest::CompilerUnitTest {
+protected:
+    static void expectSameBits(const std::set<int32_t> &expected, TR_HybridBitVector &actual) {
+        ASSERT_EQ(static_cast<int32_t>(expected.size()), actual.elementCount());
+        ASSERT_EQ(expected.empty(), actual.isEmpty());
+
+        TR_HybridBitVectorIterator it(actual);
+        for (auto bit = expected.begin(); bit != expected.end(); ++bit) {
+            ASSERT_TRUE(it.hasMoreElements());
+            ASSERT_EQ(*bit, it.getNextElement());
+            ASSERT_TRUE(actual.get(*bit));
+        }
+        ASSERT_FALSE(it.hasMoreElements());
+    }
+
+    static void fill(TR_HybridBitVector &bv, std::set<int32_t> &oracle, std::mt19937 &rng, int32_t numBits, int32_t count) {
+        std::uniform_int_distribution<int32_t> bit(0, numBits - 1);
+        for (int32_t i = 0; i < count; i++) {
+            int32_t n = bit(rng);
+            bv.set(n);
+            oracle.insert(n);
+        }
+    }
+};
+
+TEST_F(HybridBitVectorTest, testSetAndReset) {
+    TR_HybridBitVector bv(1024, region());
+    ASSERT_TRUE(bv.isEmpty());
+    ASSERT_FALSE(bv.isDense());
+
+    bv.set(700);
+    bv.set(3);
+    bv.set(70);
+    bv.set(3);
+    ASSERT_EQ(3, bv.elementCount());
+    ASSERT_TRUE(bv.get(3));
+    ASSERT_FALSE(bv.get(4));
+
+    bv.reset(70);
+    bv.reset(71);
+    std::set<int32_t> expected = {3, 700};
+    expectSameBits(expected, bv);
+
+    bv.empty();
+    ASSERT_TRUE(bv.isEmpty());
+}
+
+TEST_F(HybridBitVectorTest, testGrowsDenseAndShrinksBack) {
+    TR_HybridBitVector bv(64, region());
+    std::set<int32_t> expected;
+    for (int32_t i = 0; i < 2000; i += 3) {
+        bv.set(i);
+        expected.insert(i);
+    }
+    ASSERT_TRUE(bv.isDense());
+    expectSameBits(expected, bv);
+
+    // Clearing most of a dense set should bring it back to the sparse form
+    bv.resetAll(0, 1990);
+    expected.erase(expected.begin(), expected.lower_bound(1991));
+    ASSERT_FALSE(bv.isDense());
+    expectSameBits(expected, bv);
+}
+
+TEST_F(HybridBitVectorTest, testSetAll) {
+    TR_HybridBitVector bv(256, region());
+    bv.setAll(10, 200);
+    std::set<int32_t> expected;
+    for (int32_t i = 10; i <= 200; i++)
+        expected.insert(i);
+    expectSameBits(expected, bv);
+
+    // Bits already set are kept, as for TR_BitVector
+    bv.setAll(5);
+    for (int32_t i = 0; i < 5; i++)
+        expected.insert(i);
+    expectSameBits(expected, bv);
+}
+
+TEST_F(HybridBitVectorTest, testRandomizedSetOperations) {
+    std::mt19937 rng(88);
+    const int32_t numBits = 4096;
+    const int32_t populations[] = {2, 20, 200, 2000};
+
+    for (int32_t round = 0; round < 200; round++) {
+        int32_t leftCount = populations[round % 4];
+        int32_t rightCount = populations[(round / 4) % 4];
+
+        TR_HybridBitVector left(numBits, region());
+        TR_HybridBitVector right(numBits, region());
+        std::set<int32_t> leftBits, rightBits;
+        fill(left, leftBits, rng, numBits, leftCount);
+        fill(right, rightBits, rng, numBits, rightCount);
+
+        bool intersects = false;
+        for (auto it = rightBits.begin(); it != rightBits.end() && !intersects; ++it)
+            intersects = leftBits.count(*it) != 0;
+        ASSERT_EQ(intersects, left.intersects(right));
+
+        std::set<int32_t> expected;
+        switch (round % 3) {
+            case 0:
+                left |= right;
+                expected = leftBits;
+                expected.insert(rightBits.begin(), rightBits.end());
+                break;
+            case 1:
+                left &= right;
+                for (auto it = leftBits.begin(); it != leftBits.end(); ++it)
+                    if (rightBits.count(*it))
+                        expected.insert(*it);
+                break;
+            default:
+                left -= right;
+                for (auto it = leftBits.begin(); it != leftBits.end(); ++it)
+                    if (!rightBits.count(*it))
+                        expected.insert(*it);
+                break;
+        }
+        expectSameBits(expected, left);
+
+        TR_HybridBitVector copy(numBits, region());
+        copy = left;
+        ASSERT_TRUE(copy == left);
+        expectSameBits(expected, copy);
+    }
+}
+
+TEST_F(HybridBitVectorTest, testOperationsWithDenseBitVectors) {
+    std::mt19937 rng(1234);
+    const int32_t numBits = 2048;
+
+    for (int32_t round = 0; round < 60; round++) {
+        TR_HybridBitVector hybrid(numBits, region());
+        std::set<int32_t> hybridBits;
+        fill(hybrid, hybridBits, rng, numBits, round % 2 ? 10 : 1000);
+
+        TR_BitVector dense(numBits, &_trMemory, heapAlloc);
+        std::set<int32_t> denseBits;
+        std::uniform_int_distribution<int32_t> bit(0, numBits - 1);
+        for (int32_t i = 0; i < 300; i++) {
+            int32_t n = bit(rng);
+            dense.set(n);
+            denseBits.insert(n);
+        }
+
+        TR_BitVector intersection(numBits, &_trMemory, heapAlloc);
+        intersection = dense;
+        hybrid.intersectInto(intersection);
+        for (int32_t i = 0; i < numBits; i++)
+            ASSERT_EQ(hybridBits.count(i) && denseBits.count(i), static_cast<bool>(intersection.get(i)));
+
+        TR_BitVector unionBits(numBits, &_trMemory, heapAlloc);
+        unionBits = dense;
+        hybrid.unionInto(unionBits);
+        for (int32_t i = 0; i < numBits; i++)
+            ASSERT_EQ(hybridBits.count(i) || denseBits.count(i), static_cast<bool>(unionBits.get(i)));
+
+        std::set<int32_t> expected;
+        if (round % 3 == 0) {
+            hybrid -= dense;
+            for (auto it = hybridBits.begin(); it != hybridBits.end(); ++it)
+                if (!denseBits.count(*it))
+                    expected.insert(*it);
+        } else if (round % 3 == 1) {
+            hybrid &= dense;
+            for (auto it = hybridBits.begin(); it != hybridBits.end(); ++it)
+                if (denseBits.count(*it))
+                    expected.insert(*it);
+        } else {
+            hybrid |= dense;
+            expected = hybridBits;
+            expected.insert(denseBits.begin(), denseBits.end());
+        }
+        expectSameBits(expected, hybrid);
+    }
+}
+
+TEST_F(HybridBitVectorTest, testDenseChunkKernels) {
+    // Exercise the chunk kernels on lengths around the vector width, with unaligned starts
+    std::mt19937 rng(7);
+    for (int32_t count = 0; count < 40; count++) {
+        for (int32_t offset = 0; offset < 3; offset++) {
+            std::vector<chunk_t> a(count + offset), b(count + offset);
+            for (size_t i = 0; i < a.size(); i++) {
+                a[i] = (static_cast<chunk_t>(rng()) << 16) ^ rng();
+                b[i] = (static_cast<chunk_t>(rng()) << 16) ^ rng();
+            }
+
+            std::vector<chunk_t> orResult(a), andResult(a), andNotResult(a);
+            TR_BitVector::orChunks(orResult.data() + offset, b.data() + offset, count);
+            TR_BitVector::andChunks(andResult.data() + offset, b.data() + offset, count);
+            TR_BitVector::andNotChunks(andNotResult.data() + offset, b.data() + offset, count);
+
+            for (int32_t i = 0; i < offset; i++) {
+                ASSERT_EQ(a[i], orResult[i]);
+                ASSERT_EQ(a[i], andResult[i]);
+                ASSERT_EQ(a[i], andNotResult[i]);
+            }
+            for (int32_t i = offset; i < count + offset; i++) {
+                ASSERT_EQ(a[i] | b[i], orResult[i]);
+                ASSERT_EQ(a[i] & b[i], andResult[i]);
+                ASSERT_EQ(a[i] & ~b[i], andNotResult[i]);
+            }
+        }
+    }
+}
+
+/*
+ * Microbenchmark: the union/difference pattern of a reaching definitions
+ * sweep, on the hybrid container and on a plain TR_BitVector, at a sparse and
+ * a dense population. Timings are reported as test properties.
+ */
+template <typename Vector>
+static int64_t
+timeSetOperations(TR::Region &region, TR_Memory *trMemory, int32_t numBits, int32_t population, int32_t iterations);
+
+template <>
+int64_t
+timeSetOperations<TR_BitVector>(TR::Region &region, TR_Memory *trMemory, int32_t numBits, int32_t population, int32_t iterations) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> bit(0, numBits - 1);
+    TR_BitVector in(numBits, trMemory, heapAlloc), gen(numBits, trMemory, heapAlloc), kill(numBits, trMemory, heapAlloc);
+    TR_BitVector out(numBits, trMemory, heapAlloc);
+    for (int32_t i = 0; i < population; i++) {
+        in.set(bit(rng));
+        gen.set(bit(rng));
+        kill.set(bit(rng));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < iterations; i++) {
+        out = in;
+        out -= kill;
+        out |= gen;
+    }
+    EXPECT_FALSE(out.isEmpty());
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <>
+int64_t
+timeSetOperations<TR_HybridBitVector>(TR::Region &region, TR_Memory *trMemory, int32_t numBits, int32_t population, int32_t iterations) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int32_t> bit(0, numBits - 1);
+    TR_HybridBitVector in(numBits, region), gen(numBits, region), kill(numBits, region);
+    TR_HybridBitVector out(numBits, region);
+    for (int32_t i = 0; i < population; i++) {
+        in.set(bit(rng));
+        gen.set(bit(rng));
+        kill.set(bit(rng));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (int32_t i = 0; i < iterations; i++) {
+        out = in;
+        out -= kill;
+        out |= gen;
+    }
+    EXPECT_FALSE(out.isEmpty());
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+}
+
+TEST_F(HybridBitVectorTest, benchmarkAgainstBitVector) {
+    const int32_t numBits = 1 << 16;
+    const int32_t iterations = 2000;
+
+    int64_t sparseHybrid = timeSetOperations<TR_HybridBitVector>(region(), &_trMemory, numBits, 8, iterations);
+    int64_t sparseDense = timeSetOperations<TR_BitVector>(region(), &_trMemory, numBits, 8, iterations);
+    int64_t denseHybrid = timeSetOperations<TR_HybridBitVector>(region(), &_trMemory, numBits, numBits / 4, iterations);
+    int64_t denseDense = timeSetOperations<TR_BitVector>(region(), &_trMemory, numBits, numBits / 4, iterations);
+
+    RecordProperty("sparseHybridMicros", static_cast<int>(sparseHybrid));
+    RecordProperty("sparseBitVectorMicros", static_cast<int>(sparseDense));
+    RecordProperty("denseHybridMicros", static_cast<int>(denseHybrid));
+    RecordProperty("denseBitVectorMicros", static_cast<int>(denseDense));
+}
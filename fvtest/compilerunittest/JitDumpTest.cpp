@@ -0,0 +1,164 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "CompilerUnitTest.hpp"
+#include "runtime/JitDump.hpp"
+
+#if defined(LINUX)
+
+#include <elf.h>
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+
+extern "C"
+{
+struct jit_code_entry
+   {
+   struct jit_code_entry *next_entry;
+   struct jit_code_entry *prev_entry;
+   const char *symfile_addr;
+   uint64_t symfile_size;
+   };
+
+struct jit_descriptor
+   {
+   uint32_t version;
+   uint32_t action_flag;
+   struct jit_code_entry *relevant_entry;
+   struct jit_code_entry *first_entry;
+   };
+
+extern struct jit_descriptor __jit_debug_descriptor;
+}
+
+/**
+ * Tests for publishing code to perf through a jitdump file and to gdb through
+ * its JIT interface. The "code" is an ordinary buffer; neither consumer runs it.
+ */
+class JitDumpTest : public ::testing::Test {
+protected:
+    JitDumpTest() : _jitInit() {
+        for (size_t i = 0; i < sizeof(_code); i++)
+            _code[i] = static_cast<uint8_t>(i);
+    }
+
+    ~JitDumpTest() {
+        TR::JitDump::shutdown();
+    }
+
+    static std::vector<uint8_t> readJitDumpFile() {
+        char filename[64];
+        snprintf(filename, sizeof(filename), "/tmp/jit-%d.dump", static_cast<int>(getpid()));
+        std::vector<uint8_t> contents;
+        FILE *file = fopen(filename, "rb");
+        if (!file)
+            return contents;
+        uint8_t buffer[4096];
+        size_t length;
+        while ((length = fread(buffer, 1, sizeof(buffer), file)) > 0)
+            contents.insert(contents.end(), buffer, buffer + length);
+        fclose(file);
+        unlink(filename);
+        return contents;
+    }
+
+    template <typename T>
+    static T read(const std::vector<uint8_t> &contents, size_t offset) {
+        T value;
+        memcpy(&value, &contents[offset], sizeof(T));
+        return value;
+    }
+
+    TRTest::JitInitializer _jitInit;
+    uint8_t _code[256];
+};
+
+TEST_F(JitDumpTest, testJitDumpRecords) {
+    ASSERT_TRUE(TR::JitDump::initialize(true, false));
+
+    TR::JitDump::LineEntry lines[] = { { _code, 1 }, { _code + 16, 7 } };
+    TR::JitDump::instance()->codeLoaded("first", _code, 64, "source.c", lines, 2);
+    TR::JitDump::instance()->codeLoaded("second", _code + 64, 32, NULL, NULL, 0);
+    TR::JitDump::shutdown();
+
+    std::vector<uint8_t> contents = readJitDumpFile();
+    ASSERT_GE(contents.size(), 40u);
+    ASSERT_EQ(0x4A695444u, read<uint32_t>(contents, 0));
+    ASSERT_EQ(1u, read<uint32_t>(contents, 4));
+    ASSERT_EQ(static_cast<uint32_t>(getpid()), read<uint32_t>(contents, 20));
+
+    // Debug info must precede the load of the same code
+    std::vector<uint32_t> ids;
+    size_t offset = read<uint32_t>(contents, 8);
+    while (offset + 16 <= contents.size()) {
+        uint32_t id = read<uint32_t>(contents, offset);
+        uint32_t size = read<uint32_t>(contents, offset + 4);
+        ASSERT_LE(offset + size, contents.size());
+        ids.push_back(id);
+
+        if (id == 2) {
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(_code), read<uint64_t>(contents, offset + 16));
+            ASSERT_EQ(2u, read<uint64_t>(contents, offset + 24));
+            ASSERT_EQ(reinterpret_cast<uintptr_t>(_code + 16), read<uint64_t>(contents, offset + 32 + 16 + 9));
+            ASSERT_EQ(7, read<int32_t>(contents, offset + 32 + 16 + 9 + 8));
+        } else if (id == 0) {
+            uint64_t codeSize = read<uint64_t>(contents, offset + 40);
+            const char *name = reinterpret_cast<const char *>(&contents[offset + 56]);
+            const uint8_t *code = &contents[offset + 56 + strlen(name) + 1];
+            ASSERT_EQ(size, 56 + strlen(name) + 1 + codeSize);
+            ASSERT_EQ(0, memcmp(code, reinterpret_cast<uint8_t *>(read<uint64_t>(contents, offset + 32)), codeSize));
+        }
+        offset += size;
+    }
+
+    ASSERT_EQ(offset, contents.size());
+    uint32_t expected[] = { 2, 0, 0, 3 };
+    ASSERT_EQ(std::vector<uint32_t>(expected, expected + 4), ids);
+}
+
+TEST_F(JitDumpTest, testGDBRegistration) {
+    ASSERT_TRUE(TR::JitDump::initialize(false, true));
+    jit_code_entry *before = __jit_debug_descriptor.first_entry;
+
+    TR::JitDump::instance()->codeLoaded("first", _code, 64, NULL, NULL, 0);
+    TR::JitDump::instance()->codeLoaded("second", _code + 128, 64, NULL, NULL, 0);
+    TR::JitDump::instance()->flush();
+
+    int registered = 0;
+    for (jit_code_entry *entry = __jit_debug_descriptor.first_entry; entry != before; entry = entry->next_entry) {
+        ASSERT_GE(entry->symfile_size, sizeof(Elf64_Ehdr) + 64);
+        ASSERT_EQ(0, memcmp(entry->symfile_addr, ELFMAG, SELFMAG));
+        registered++;
+    }
+    ASSERT_EQ(2, registered);
+
+    TR::JitDump::instance()->codeUnloaded(_code, _code + 64);
+    TR::JitDump::instance()->flush();
+    ASSERT_NE(before, __jit_debug_descriptor.first_entry);
+    ASSERT_EQ(before, __jit_debug_descriptor.first_entry->next_entry);
+
+    TR::JitDump::shutdown();
+    ASSERT_EQ(before, __jit_debug_descriptor.first_entry);
+}
+
+#endif
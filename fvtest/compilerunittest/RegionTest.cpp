@@ -0,0 +1,151 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "env/RawAllocator.hpp"
+#include "env/Region.hpp"
+#include "env/SubRegion.hpp"
+#include "env/SystemSegmentProvider.hpp"
+#include "env/TypedAllocator.hpp"
+
+class RegionTest : public ::testing::Test {
+public:
+    RegionTest() :
+        _rawAllocator(),
+        _segmentProvider(1 << 16, _rawAllocator),
+        _region(_segmentProvider, _rawAllocator) {}
+
+protected:
+    TR::RawAllocator _rawAllocator;
+    TR::SystemSegmentProvider _segmentProvider;
+    TR::Region _region;
+};
+
+TEST_F(RegionTest, testDeallocateIsIgnoredWithoutFreeLists) {
+    void *first = _region.allocate(48);
+    _region.deallocate(first, 48);
+    void *second = _region.allocate(48);
+    ASSERT_NE(first, second);
+    // The freed block is not reused, but no longer counts as in use
+    ASSERT_EQ(48, _region.bytesInUse());
+    ASSERT_EQ(0, _region.bytesRecycled());
+}
+
+TEST_F(RegionTest, testSmallBlocksAreReusedBySizeClass) {
+    _region.enableFreeLists();
+    void *a = _region.allocate(40);
+    void *b = _region.allocate(100);
+    _region.deallocate(a, 40);
+    _region.deallocate(b, 100);
+    ASSERT_EQ(0, _region.bytesInUse());
+
+    // Same size class as a, but not as b
+    void *c = _region.allocate(33);
+    ASSERT_EQ(a, c);
+    void *d = _region.allocate(40);
+    ASSERT_NE(b, d);
+    void *e = _region.allocate(112);
+    ASSERT_EQ(b, e);
+    ASSERT_EQ(48 + 112, _region.bytesRecycled());
+}
+
+TEST_F(RegionTest, testLargeBlocksAreReusedFirstFit) {
+    _region.enableFreeLists();
+    void *small = _region.allocate(3000);
+    void *large = _region.allocate(3900);
+    _region.deallocate(small, 3000);
+    _region.deallocate(large, 3900);
+
+    // Both blocks share a size class; only the larger one fits
+    ASSERT_EQ(large, _region.allocate(3500));
+    ASSERT_EQ(small, _region.allocate(2500));
+
+    // Any block from the next size class up is large enough
+    void *huge = _region.allocate(9000);
+    _region.deallocate(huge, 9000);
+    ASSERT_EQ(huge, _region.allocate(5000));
+}
+
+TEST_F(RegionTest, testHighWaterMark) {
+    _region.enableFreeLists();
+    std::vector<void *> blocks;
+    for (int i = 0; i < 100; i++)
+        blocks.push_back(_region.allocate(64));
+    for (auto it = blocks.begin(); it != blocks.end(); ++it)
+        _region.deallocate(*it, 64);
+    for (int i = 0; i < 50; i++)
+        _region.allocate(64);
+
+    ASSERT_EQ(100 * 64, _region.highWaterMark());
+    ASSERT_EQ(50 * 64, _region.bytesInUse());
+    ASSERT_EQ(50 * 64, _region.bytesRecycled());
+}
+
+TEST_F(RegionTest, testCopiesInheritFreeLists) {
+    _region.enableFreeLists();
+    TR::Region copy(_region);
+    ASSERT_TRUE(copy.freeListsEnabled());
+}
+
+TEST_F(RegionTest, testContainerChurnStaysBounded) {
+    _region.enableFreeLists();
+    for (int round = 0; round < 50; round++) {
+        std::vector<int, TR::typed_allocator<int, TR::Region &> > values(_region);
+        for (int i = 0; i < 1000; i++)
+            values.push_back(i);
+    }
+
+    // Each round frees everything it allocated, so the peak stays close to
+    // that of a single round
+    ASSERT_LT(_region.highWaterMark(), 3 * 1024 * sizeof(int));
+    ASSERT_GT(_region.bytesRecycled(), 0);
+}
+
+TEST_F(RegionTest, testSubRegionsReuseParentMemory) {
+    _region.enableFreeLists();
+    size_t parentPeak = 0;
+    for (int round = 0; round < 20; round++) {
+        TR::SubRegion scratch(_region);
+        ASSERT_TRUE(scratch.freeListsEnabled());
+        for (int i = 0; i < 200; i++)
+            scratch.allocate(256);
+        if (round == 0)
+            parentPeak = _region.highWaterMark();
+    }
+
+    ASSERT_GT(parentPeak, 0);
+    ASSERT_EQ(parentPeak, _region.highWaterMark());
+    ASSERT_EQ(0, _region.bytesInUse());
+}
+
+TEST_F(RegionTest, testNestedSubRegions) {
+    _region.enableFreeLists();
+    TR::SubRegion outer(_region);
+    int *outerValue = new (outer) int(1);
+    {
+        TR::SubRegion inner(outer);
+        for (int i = 0; i < 1000; i++)
+            new (inner) int(i);
+        ASSERT_GT(outer.bytesInUse(), 0);
+    }
+    ASSERT_EQ(1, *outerValue);
+}
@@ -0,0 +1,144 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include <gtest/gtest.h>
+#include <vector>
+#include "env/RawAllocator.hpp"
+#include "env/Region.hpp"
+#include "env/SegmentCache.hpp"
+#include "env/SystemSegmentProvider.hpp"
+
+static const size_t segmentSize = 1 << 16;
+
+class SegmentCacheTest : public ::testing::Test {
+public:
+    SegmentCacheTest() :
+        _rawAllocator(),
+        _cache(_rawAllocator, segmentSize, 4 * segmentSize) {}
+
+protected:
+    TR::RawAllocator _rawAllocator;
+    TR::SegmentCache _cache;
+};
+
+TEST_F(SegmentCacheTest, testReleasedSegmentsAreReused) {
+    void *first = _cache.request();
+    ASSERT_NE((void *)NULL, first);
+    _cache.release(first);
+    ASSERT_EQ(segmentSize, _cache.statistics().bytesRetained);
+
+    void *second = _cache.request();
+    ASSERT_EQ(first, second);
+
+    TR::SegmentCache::Statistics stats = _cache.statistics();
+    ASSERT_EQ(1, stats.hits);
+    ASSERT_EQ(1, stats.misses);
+    ASSERT_EQ(0, stats.stashHits);
+    ASSERT_EQ(0, stats.bytesRetained);
+    _cache.release(second);
+}
+
+TEST_F(SegmentCacheTest, testRetentionTargetIsNotExceeded) {
+    std::vector<void *> segments;
+    for (int i = 0; i < 6; i++)
+        segments.push_back(_cache.request());
+    for (size_t i = 0; i < segments.size(); i++)
+        _cache.release(segments[i]);
+    ASSERT_EQ(4 * segmentSize, _cache.statistics().bytesRetained);
+
+    _cache.setRetentionTarget(segmentSize);
+    ASSERT_EQ(segmentSize, _cache.statistics().bytesRetained);
+    ASSERT_EQ(3 * segmentSize, _cache.statistics().bytesTrimmed);
+}
+
+TEST_F(SegmentCacheTest, testIdleSegmentsDecay) {
+    std::vector<void *> segments;
+    for (int i = 0; i < 4; i++)
+        segments.push_back(_cache.request());
+    for (size_t i = 0; i < segments.size(); i++)
+        _cache.release(segments[i]);
+
+    // Nothing was idle for a whole period yet
+    _cache.trim();
+    ASSERT_EQ(4 * segmentSize, _cache.statistics().bytesRetained);
+
+    // Half of the idle segments go at each step, until none are left
+    _cache.trim();
+    ASSERT_EQ(2 * segmentSize, _cache.statistics().bytesRetained);
+    _cache.trim();
+    ASSERT_EQ(1 * segmentSize, _cache.statistics().bytesRetained);
+    _cache.trim();
+    ASSERT_EQ(0, _cache.statistics().bytesRetained);
+    ASSERT_EQ(4 * segmentSize, _cache.statistics().bytesTrimmed);
+}
+
+TEST_F(SegmentCacheTest, testSegmentsInUseDoNotDecay) {
+    std::vector<void *> segments;
+    for (int i = 0; i < 4; i++)
+        segments.push_back(_cache.request());
+    for (size_t i = 0; i < segments.size(); i++)
+        _cache.release(segments[i]);
+    _cache.trim();
+
+    // Two segments are taken during the period, so only the other two were idle
+    void *a = _cache.request();
+    void *b = _cache.request();
+    _cache.release(a);
+    _cache.release(b);
+    _cache.trim();
+    ASSERT_EQ(3 * segmentSize, _cache.statistics().bytesRetained);
+}
+
+TEST_F(SegmentCacheTest, testFlushReleasesEverything) {
+    void *a = _cache.request();
+    void *b = _cache.request();
+    _cache.release(a);
+    _cache.release(b);
+    _cache.flush();
+
+    TR::SegmentCache::Statistics stats = _cache.statistics();
+    ASSERT_EQ(0, stats.bytesRetained);
+    ASSERT_EQ(2 * segmentSize, stats.bytesTrimmed);
+}
+
+TEST_F(SegmentCacheTest, testRegionsShareSegmentsThroughProviders) {
+    for (int compilation = 0; compilation < 3; compilation++) {
+        TR::SystemSegmentProvider segmentProvider(segmentSize, _rawAllocator, &_cache);
+        TR::Region region(segmentProvider, _rawAllocator);
+        region.allocate(1000);
+        region.allocate(segmentSize);   // Larger than a segment; not cached
+    }
+
+    TR::SegmentCache::Statistics stats = _cache.statistics();
+    ASSERT_EQ(1, stats.misses);
+    ASSERT_EQ(2, stats.hits);
+    ASSERT_EQ(segmentSize, stats.bytesRetained);
+}
+
+TEST(SegmentCacheInstanceTest, testThreadStashIsUsedFirst) {
+    TR::SegmentCache &cache = TR::SegmentCache::instance();
+    void *segment = cache.request();
+    size_t stashHits = cache.statistics().stashHits;
+    cache.release(segment);
+    ASSERT_EQ(segment, cache.request());
+    ASSERT_EQ(stashHits + 1, cache.statistics().stashHits);
+    cache.release(segment);
+}
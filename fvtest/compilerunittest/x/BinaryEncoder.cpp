@@ -0,0 +1,123 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "../CodeGenTest.hpp"
+
+#include "codegen/X86Instruction.hpp"
+
+#include <vector>
+
+class X86BinaryEncoderTest : public TRTest::CodeGenTest {
+public:
+    uint8_t buf[64];
+
+    TR::RealRegister *reg(TR::RealRegister::RegNum regNum) {
+        return cg()->machine()->getRealRegister(regNum);
+    }
+
+    std::vector<uint8_t> encodeInstruction(TR::Instruction *instr) {
+        instr->estimateBinaryLength(0);
+        cg()->setBinaryBufferStart(buf);
+        cg()->setBinaryBufferCursor(buf);
+
+        instr->generateBinaryEncoding();
+        return std::vector<uint8_t>(buf, buf + instr->getBinaryLength());
+    }
+
+    std::vector<TR::InstOpCode::Mnemonic> mnemonics() {
+        std::vector<TR::InstOpCode::Mnemonic> ops;
+        for (TR::Instruction *instr = cg()->getFirstInstruction(); instr != NULL; instr = instr->getNext())
+            ops.push_back(instr->getOpCodeValue());
+        return ops;
+    }
+};
+
+TEST_F(X86BinaryEncoderTest, testVZEROUPPER) {
+    if (!cg()->comp()->target().cpu.supportsAVX())
+        return;
+
+    TR::Instruction *instr = generateInstruction(TR::InstOpCode::VZEROUPPER, fakeNode, cg());
+    const uint8_t expected[] = { 0xc5, 0xf8, 0x77 };
+    ASSERT_EQ(std::vector<uint8_t>(expected, expected + sizeof(expected)), encodeInstruction(instr));
+}
+
+TEST_F(X86BinaryEncoderTest, testVEXEncodedPTEST) {
+    if (!cg()->comp()->target().cpu.supportsAVX())
+        return;
+
+    TR::Instruction *instr = generateRegRegInstruction(TR::InstOpCode::PTESTRegReg, fakeNode, reg(TR::RealRegister::xmm1), reg(TR::RealRegister::xmm2), cg());
+    const uint8_t expected[] = { 0xc4, 0xe2, 0x79, 0x17, 0xca };
+    ASSERT_EQ(std::vector<uint8_t>(expected, expected + sizeof(expected)), encodeInstruction(instr));
+}
+
+TEST_F(X86BinaryEncoderTest, testVEX256) {
+    if (!cg()->comp()->target().cpu.supportsAVX2())
+        return;
+
+    TR::Instruction *instr = generateRegRegInstruction(TR::InstOpCode::VPADDDRegReg, fakeNode, reg(TR::RealRegister::xmm1), reg(TR::RealRegister::xmm2), cg());
+    const uint8_t expected[] = { 0xc5, 0xf5, 0xfe, 0xca };
+    ASSERT_EQ(std::vector<uint8_t>(expected, expected + sizeof(expected)), encodeInstruction(instr));
+}
+
+TEST_F(X86BinaryEncoderTest, testEVEX512) {
+    if (!cg()->comp()->target().cpu.supportsAVX512F())
+        return;
+
+    TR::Instruction *instr = generateRegRegInstruction(TR::InstOpCode::VPADDD512RegReg, fakeNode, reg(TR::RealRegister::xmm1), reg(TR::RealRegister::xmm2), cg());
+    const uint8_t expected[] = { 0x62, 0xf1, 0x75, 0x48, 0xfe, 0xca };
+    ASSERT_EQ(std::vector<uint8_t>(expected, expected + sizeof(expected)), encodeInstruction(instr));
+}
+
+TEST_F(X86BinaryEncoderTest, testVZEROUPPERBeforeCallAndReturn) {
+    if (!cg()->comp()->target().cpu.supportsAVX2())
+        return;
+
+    generateRegRegInstruction(TR::InstOpCode::VPADDDRegReg, fakeNode, reg(TR::RealRegister::xmm1), reg(TR::RealRegister::xmm2), cg());
+    generateRegInstruction(TR::InstOpCode::CALLReg, fakeNode, reg(TR::RealRegister::eax), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    cg()->insertVZeroUpperInstructions();
+
+    const TR::InstOpCode::Mnemonic expected[] = {
+        TR::InstOpCode::VPADDDRegReg,
+        TR::InstOpCode::VZEROUPPER,
+        TR::InstOpCode::CALLReg,
+        TR::InstOpCode::VZEROUPPER,
+        TR::InstOpCode::RET
+    };
+    ASSERT_EQ(std::vector<TR::InstOpCode::Mnemonic>(expected, expected + 5), mnemonics());
+}
+
+TEST_F(X86BinaryEncoderTest, testNoVZEROUPPERWithoutWideVectors) {
+    generateRegRegInstruction(TR::InstOpCode::PADDDRegReg, fakeNode, reg(TR::RealRegister::xmm1), reg(TR::RealRegister::xmm2), cg());
+    generateRegInstruction(TR::InstOpCode::CALLReg, fakeNode, reg(TR::RealRegister::eax), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    cg()->insertVZeroUpperInstructions();
+
+    const TR::InstOpCode::Mnemonic expected[] = {
+        TR::InstOpCode::PADDDRegReg,
+        TR::InstOpCode::CALLReg,
+        TR::InstOpCode::RET
+    };
+    ASSERT_EQ(std::vector<TR::InstOpCode::Mnemonic>(expected, expected + 3), mnemonics());
+}
@@ -0,0 +1,146 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "../CodeGenTest.hpp"
+
+#include "codegen/MemoryReference.hpp"
+#include "codegen/X86Instruction.hpp"
+#include "codegen/X86InstructionScheduler.hpp"
+#include "il/LabelSymbol.hpp"
+
+class InstructionSchedulerTest : public TRTest::CodeGenTest {
+public:
+    InstructionSchedulerTest() {
+        cg()->comp()->getOptions()->setOptLevel(warm);
+    }
+
+    TR::RealRegister *reg(TR::RealRegister::RegNum regNum) {
+        return cg()->machine()->getRealRegister(regNum);
+    }
+
+    bool perform(const TR_X86SchedulingModel *model = &TR_X86SchedulingModel::Skylake) {
+        TR_X86InstructionScheduler scheduler(cg(), model);
+        return scheduler.perform();
+    }
+
+    int32_t position(TR::Instruction *target) {
+        int32_t pos = 0;
+        for (TR::Instruction *instr = cg()->getFirstInstruction(); instr != NULL; instr = instr->getNext(), pos++) {
+            if (instr == target)
+                return pos;
+        }
+        return -1;
+    }
+};
+
+TEST_F(InstructionSchedulerTest, testHoistLoadAboveIndependentALU) {
+    generateRegRegInstruction(TR::InstOpCode::ADD8RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    generateRegRegInstruction(TR::InstOpCode::ADD8RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    TR::Instruction *load = generateRegMemInstruction(TR::InstOpCode::L8RegMem, fakeNode, reg(TR::RealRegister::ecx), generateX86MemoryReference(reg(TR::RealRegister::edx), 8, cg()), cg());
+    TR::Instruction *use = generateRegRegInstruction(TR::InstOpCode::ADD8RegReg, fakeNode, reg(TR::RealRegister::ecx), reg(TR::RealRegister::esi), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_TRUE(perform());
+    ASSERT_EQ(load, cg()->getFirstInstruction());
+    ASSERT_LT(position(load), position(use));
+    ASSERT_EQ(4, position(cg()->getAppendInstruction()));
+}
+
+TEST_F(InstructionSchedulerTest, testKeepLoadAfterAliasingStore) {
+    TR::Instruction *store = generateMemRegInstruction(TR::InstOpCode::S8MemReg, fakeNode, generateX86MemoryReference(reg(TR::RealRegister::eax), 8, cg()), reg(TR::RealRegister::ebx), cg());
+    TR::Instruction *load = generateRegMemInstruction(TR::InstOpCode::L8RegMem, fakeNode, reg(TR::RealRegister::ecx), generateX86MemoryReference(reg(TR::RealRegister::edx), 0, cg()), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    perform();
+    ASSERT_LT(position(store), position(load));
+}
+
+TEST_F(InstructionSchedulerTest, testHoistLoadAboveDisjointStore) {
+    TR::Instruction *store = generateMemRegInstruction(TR::InstOpCode::S8MemReg, fakeNode, generateX86MemoryReference(reg(TR::RealRegister::eax), 8, cg()), reg(TR::RealRegister::ebx), cg());
+    TR::Instruction *load = generateRegMemInstruction(TR::InstOpCode::L8RegMem, fakeNode, reg(TR::RealRegister::ecx), generateX86MemoryReference(reg(TR::RealRegister::eax), 16, cg()), cg());
+    generateRegRegInstruction(TR::InstOpCode::ADD8RegReg, fakeNode, reg(TR::RealRegister::ecx), reg(TR::RealRegister::esi), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_TRUE(perform());
+    ASSERT_LT(position(load), position(store));
+}
+
+TEST_F(InstructionSchedulerTest, testKeepFlagsBetweenCompareAndSet) {
+    TR::Instruction *cmp = generateRegRegInstruction(TR::InstOpCode::CMP8RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    TR::Instruction *set = generateRegInstruction(TR::InstOpCode::SETE1Reg, fakeNode, reg(TR::RealRegister::ecx), cg());
+    TR::Instruction *load = generateRegMemInstruction(TR::InstOpCode::L8RegMem, fakeNode, reg(TR::RealRegister::edx), generateX86MemoryReference(reg(TR::RealRegister::esi), 0, cg()), cg());
+    TR::Instruction *add = generateRegImmInstruction(TR::InstOpCode::ADD8RegImms, fakeNode, reg(TR::RealRegister::edx), 1, cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    perform();
+    ASSERT_EQ(load, cg()->getFirstInstruction());
+    ASSERT_LT(position(cmp), position(set));
+    ASSERT_GT(position(add), position(set));
+}
+
+TEST_F(InstructionSchedulerTest, testLabelEndsRegion) {
+    TR::LabelSymbol *label = generateLabelSymbol(cg());
+
+    TR::Instruction *add = generateRegRegInstruction(TR::InstOpCode::ADD8RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    generateRegRegInstruction(TR::InstOpCode::ADD8RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    TR::Instruction *labelInstr = generateLabelInstruction(TR::InstOpCode::label, fakeNode, label, cg());
+    TR::Instruction *load = generateRegMemInstruction(TR::InstOpCode::L8RegMem, fakeNode, reg(TR::RealRegister::ecx), generateX86MemoryReference(reg(TR::RealRegister::edx), 8, cg()), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_FALSE(perform());
+    ASSERT_EQ(add, cg()->getFirstInstruction());
+    ASSERT_EQ(load, labelInstr->getNext());
+}
+
+TEST_F(InstructionSchedulerTest, testStartDivideEarly) {
+    generateRegRegInstruction(TR::InstOpCode::ADDSDRegReg, fakeNode, reg(TR::RealRegister::xmm0), reg(TR::RealRegister::xmm1), cg());
+    generateRegRegInstruction(TR::InstOpCode::ADDSDRegReg, fakeNode, reg(TR::RealRegister::xmm0), reg(TR::RealRegister::xmm1), cg());
+    TR::Instruction *div = generateRegRegInstruction(TR::InstOpCode::DIVSDRegReg, fakeNode, reg(TR::RealRegister::xmm2), reg(TR::RealRegister::xmm3), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_TRUE(perform(&TR_X86SchedulingModel::Zen));
+    ASSERT_EQ(div, cg()->getFirstInstruction());
+}
+
+TEST_F(InstructionSchedulerTest, testKeepDependentChain) {
+    TR::Instruction *load = generateRegMemInstruction(TR::InstOpCode::L8RegMem, fakeNode, reg(TR::RealRegister::eax), generateX86MemoryReference(reg(TR::RealRegister::edx), 0, cg()), cg());
+    TR::Instruction *mul = generateRegRegInstruction(TR::InstOpCode::IMUL8RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    TR::Instruction *add = generateRegRegInstruction(TR::InstOpCode::ADD8RegReg, fakeNode, reg(TR::RealRegister::ecx), reg(TR::RealRegister::eax), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_FALSE(perform());
+    ASSERT_EQ(load, cg()->getFirstInstruction());
+    ASSERT_EQ(mul, load->getNext());
+    ASSERT_EQ(add, mul->getNext());
+}
+
+TEST_F(InstructionSchedulerTest, testOperationClass) {
+    TR::Instruction *mul = generateRegRegInstruction(TR::InstOpCode::IMUL8RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    TR::Instruction *div = generateRegRegInstruction(TR::InstOpCode::DIVSDRegReg, fakeNode, reg(TR::RealRegister::xmm0), reg(TR::RealRegister::xmm1), cg());
+    TR::Instruction *push = generateRegInstruction(TR::InstOpCode::PUSHReg, fakeNode, reg(TR::RealRegister::eax), cg());
+    TR::Instruction *ret = generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(TR_X86IntMultiply, TR_X86InstructionScheduler::getOperationClass(mul));
+    ASSERT_EQ(TR_X86FPDivide, TR_X86InstructionScheduler::getOperationClass(div));
+    ASSERT_EQ(TR_X86Unschedulable, TR_X86InstructionScheduler::getOperationClass(push));
+    ASSERT_EQ(TR_X86Unschedulable, TR_X86InstructionScheduler::getOperationClass(ret));
+}
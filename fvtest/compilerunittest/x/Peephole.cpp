@@ -0,0 +1,216 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "../CodeGenTest.hpp"
+
+#include "codegen/MemoryReference.hpp"
+#include "codegen/Peephole.hpp"
+#include "codegen/X86Instruction.hpp"
+#include "il/LabelSymbol.hpp"
+
+class PeepholeTest : public TRTest::CodeGenTest {
+public:
+    PeepholeTest() {
+        // Peephole optimizations are not performed at noOpt
+        cg()->comp()->getOptions()->setOptLevel(warm);
+    }
+
+    TR::RealRegister *reg(TR::RealRegister::RegNum regNum) {
+        return cg()->machine()->getRealRegister(regNum);
+    }
+
+    int32_t performAndCountInstructions() {
+        TR::Peephole peephole(cg()->comp());
+        peephole.perform();
+
+        int32_t count = 0;
+        for (TR::Instruction *instr = cg()->getFirstInstruction(); instr != NULL; instr = instr->getNext())
+            count++;
+        return count;
+    }
+};
+
+TEST_F(PeepholeTest, testRemoveCopyBack) {
+    TR::Instruction *mov = generateRegRegInstruction(TR::InstOpCode::MOV8RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    generateRegRegInstruction(TR::InstOpCode::MOV8RegReg, fakeNode, reg(TR::RealRegister::ebx), reg(TR::RealRegister::eax), cg());
+    TR::Instruction *ret = generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(2, performAndCountInstructions());
+    ASSERT_EQ(mov, cg()->getFirstInstruction());
+    ASSERT_EQ(ret, mov->getNext());
+}
+
+TEST_F(PeepholeTest, testKeepZeroExtendingCopyBack) {
+    if (!cg()->comp()->target().is64Bit())
+        return;
+
+    generateRegRegInstruction(TR::InstOpCode::MOV4RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    generateRegRegInstruction(TR::InstOpCode::MOV4RegReg, fakeNode, reg(TR::RealRegister::ebx), reg(TR::RealRegister::eax), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(3, performAndCountInstructions());
+}
+
+TEST_F(PeepholeTest, testRemoveTestBeforeEqualityBranch) {
+    TR::LabelSymbol *label = generateLabelSymbol(cg());
+
+    TR::Instruction *sub = generateRegRegInstruction(TR::InstOpCode::SUB4RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    generateRegRegInstruction(TR::InstOpCode::TEST4RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::eax), cg());
+    TR::Instruction *je = generateLabelInstruction(TR::InstOpCode::JE4, fakeNode, label, cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+    generateLabelInstruction(TR::InstOpCode::label, fakeNode, label, cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(5, performAndCountInstructions());
+    ASSERT_EQ(je, sub->getNext());
+}
+
+TEST_F(PeepholeTest, testKeepTestBeforeCarryBranch) {
+    TR::LabelSymbol *label = generateLabelSymbol(cg());
+
+    generateRegRegInstruction(TR::InstOpCode::SUB4RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    generateRegImmInstruction(TR::InstOpCode::CMP4RegImms, fakeNode, reg(TR::RealRegister::eax), 0, cg());
+    generateLabelInstruction(TR::InstOpCode::JB4, fakeNode, label, cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+    generateLabelInstruction(TR::InstOpCode::label, fakeNode, label, cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(6, performAndCountInstructions());
+}
+
+TEST_F(PeepholeTest, testKeepTestBeforeUnknownBranchTarget) {
+    generateRegRegInstruction(TR::InstOpCode::ADD4RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    generateRegRegInstruction(TR::InstOpCode::TEST4RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::eax), cg());
+    generateLabelInstruction(TR::InstOpCode::JMP4, fakeNode, generateLabelSymbol(cg()), cg());
+
+    ASSERT_EQ(3, performAndCountInstructions());
+}
+
+TEST_F(PeepholeTest, testFoldLEAChain) {
+    TR::Instruction *lea = generateRegMemInstruction(TR::InstOpCode::LEA8RegMem, fakeNode, reg(TR::RealRegister::eax), generateX86MemoryReference(reg(TR::RealRegister::ebx), reg(TR::RealRegister::ecx), 2, 8, cg()), cg());
+    generateRegMemInstruction(TR::InstOpCode::LEA8RegMem, fakeNode, reg(TR::RealRegister::eax), generateX86MemoryReference(reg(TR::RealRegister::eax), 16, cg()), cg());
+    generateRegImmInstruction(TR::InstOpCode::ADD8RegImms, fakeNode, reg(TR::RealRegister::eax), 4, cg());
+    generateRegImmInstruction(TR::InstOpCode::SUB8RegImms, fakeNode, reg(TR::RealRegister::eax), 1, cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(2, performAndCountInstructions());
+    ASSERT_EQ(27, lea->getMemoryReference()->getDisplacement());
+    ASSERT_EQ(reg(TR::RealRegister::ebx), lea->getMemoryReference()->getBaseRegister());
+    ASSERT_EQ(reg(TR::RealRegister::ecx), lea->getMemoryReference()->getIndexRegister());
+}
+
+TEST_F(PeepholeTest, testKeepLEAChainWithLiveFlags) {
+    TR::LabelSymbol *label = generateLabelSymbol(cg());
+
+    generateRegMemInstruction(TR::InstOpCode::LEA8RegMem, fakeNode, reg(TR::RealRegister::eax), generateX86MemoryReference(reg(TR::RealRegister::ebx), 8, cg()), cg());
+    generateRegImmInstruction(TR::InstOpCode::ADD8RegImms, fakeNode, reg(TR::RealRegister::eax), 4, cg());
+    generateLabelInstruction(TR::InstOpCode::JE4, fakeNode, label, cg());
+    generateLabelInstruction(TR::InstOpCode::label, fakeNode, label, cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(5, performAndCountInstructions());
+}
+
+TEST_F(PeepholeTest, testMergeAdjacentIntStores) {
+    if (!cg()->comp()->target().is64Bit())
+        return;
+
+    TR::Instruction *store = generateMemImmInstruction(TR::InstOpCode::S4MemImm4, fakeNode, generateX86MemoryReference(reg(TR::RealRegister::eax), 12, cg()), 0, cg());
+    generateMemImmInstruction(TR::InstOpCode::S4MemImm4, fakeNode, generateX86MemoryReference(reg(TR::RealRegister::eax), 8, cg()), 5, cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(2, performAndCountInstructions());
+    ASSERT_EQ(TR::InstOpCode::S8MemImm4, store->getOpCodeValue());
+    ASSERT_EQ(8, store->getMemoryReference()->getDisplacement());
+    ASSERT_EQ(5, static_cast<TR::X86MemImmInstruction *>(store)->getSourceImmediate());
+}
+
+TEST_F(PeepholeTest, testKeepIntStoresNotSignExtendable) {
+    generateMemImmInstruction(TR::InstOpCode::S4MemImm4, fakeNode, generateX86MemoryReference(reg(TR::RealRegister::eax), 8, cg()), 0, cg());
+    generateMemImmInstruction(TR::InstOpCode::S4MemImm4, fakeNode, generateX86MemoryReference(reg(TR::RealRegister::eax), 12, cg()), 1, cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(3, performAndCountInstructions());
+}
+
+TEST_F(PeepholeTest, testMergeAdjacentByteStores) {
+    TR::Instruction *store = generateMemImmInstruction(TR::InstOpCode::S1MemImm1, fakeNode, generateX86MemoryReference(reg(TR::RealRegister::eax), 4, cg()), 0x12, cg());
+    generateMemImmInstruction(TR::InstOpCode::S1MemImm1, fakeNode, generateX86MemoryReference(reg(TR::RealRegister::eax), 5, cg()), 0x34, cg());
+    generateMemImmInstruction(TR::InstOpCode::S2MemImm2, fakeNode, generateX86MemoryReference(reg(TR::RealRegister::eax), 6, cg()), 0x5678, cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(2, performAndCountInstructions());
+    ASSERT_EQ(TR::InstOpCode::S4MemImm4, store->getOpCodeValue());
+    ASSERT_EQ(4, store->getMemoryReference()->getDisplacement());
+    ASSERT_EQ(0x56783412, static_cast<TR::X86MemImmInstruction *>(store)->getSourceImmediate());
+}
+
+TEST_F(PeepholeTest, testReduceNotAndToANDN) {
+    if (!cg()->comp()->target().cpu.supportsFeature(OMR_FEATURE_X86_BMI1) || !cg()->comp()->target().cpu.supportsAVX())
+        return;
+
+    generateRegRegInstruction(TR::InstOpCode::MOV4RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    generateRegInstruction(TR::InstOpCode::NOT4Reg, fakeNode, reg(TR::RealRegister::eax), cg());
+    generateRegRegInstruction(TR::InstOpCode::AND4RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::edx), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(2, performAndCountInstructions());
+
+    TR::Instruction *andn = cg()->getFirstInstruction();
+    ASSERT_EQ(TR::InstOpCode::ANDN4RegRegReg, andn->getOpCodeValue());
+    ASSERT_EQ(reg(TR::RealRegister::eax), andn->getTargetRegister());
+    ASSERT_EQ(reg(TR::RealRegister::ebx), static_cast<TR::X86RegRegRegInstruction *>(andn)->getSource2ndRegister());
+    ASSERT_EQ(reg(TR::RealRegister::edx), andn->getSourceRegister());
+}
+
+TEST_F(PeepholeTest, testKeepNotAndOfSameRegister) {
+    generateRegInstruction(TR::InstOpCode::NOT4Reg, fakeNode, reg(TR::RealRegister::eax), cg());
+    generateRegRegInstruction(TR::InstOpCode::AND4RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::eax), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(3, performAndCountInstructions());
+}
+
+TEST_F(PeepholeTest, testKeepNotAndAddressedThroughInvertedRegister) {
+    generateRegInstruction(TR::InstOpCode::NOT8Reg, fakeNode, reg(TR::RealRegister::eax), cg());
+    generateRegMemInstruction(TR::InstOpCode::AND8RegMem, fakeNode, reg(TR::RealRegister::eax), generateX86MemoryReference(reg(TR::RealRegister::eax), 8, cg()), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(3, performAndCountInstructions());
+}
+
+TEST_F(PeepholeTest, testReduceShiftToSHLX) {
+    if (!cg()->comp()->target().cpu.supportsFeature(OMR_FEATURE_X86_BMI2) || !cg()->comp()->target().cpu.supportsAVX())
+        return;
+
+    generateRegRegInstruction(TR::InstOpCode::MOV4RegReg, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ebx), cg());
+    generateRegRegInstruction(TR::InstOpCode::SHL4RegCL, fakeNode, reg(TR::RealRegister::eax), reg(TR::RealRegister::ecx), cg());
+    generateInstruction(TR::InstOpCode::RET, fakeNode, cg());
+
+    ASSERT_EQ(2, performAndCountInstructions());
+
+    TR::Instruction *shlx = cg()->getFirstInstruction();
+    ASSERT_EQ(TR::InstOpCode::SHLX4RegRegReg, shlx->getOpCodeValue());
+    ASSERT_EQ(reg(TR::RealRegister::eax), shlx->getTargetRegister());
+    ASSERT_EQ(reg(TR::RealRegister::ecx), static_cast<TR::X86RegRegRegInstruction *>(shlx)->getSource2ndRegister());
+    ASSERT_EQ(reg(TR::RealRegister::ebx), shlx->getSourceRegister());
+}
@@ -0,0 +1,197 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+
+#include "JBTestUtil.hpp"
+
+#include <stdio.h>
+
+#define AOT_CODE_CACHE_FILE "jitbuilderAOTCodeCacheTest.cache"
+#define AOT_CODE_CACHE_OPTIONS "-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,aotCodeCache=" AOT_CODE_CACHE_FILE
+
+static int32_t
+aotCallee(int32_t x)
+   {
+   #define AOT_CALLEE_LINE LINETOSTR(__LINE__)
+   return x * 3;
+   }
+
+typedef int32_t (*Int32Function)(int32_t);
+
+DEFINE_BUILDER(AOTSumTo,
+               Int32,
+               PARAM("n", Int32))
+   {
+   Store("total", ConstInt32(0));
+
+   OMR::JitBuilder::IlBuilder *loop = NULL;
+   ForLoopUp((char *)"i", &loop, ConstInt32(1), Add(Load("n"), ConstInt32(1)), ConstInt32(1));
+   loop->Store("total", loop->Add(loop->Load("total"), loop->Load("i")));
+
+   Return(Load("total"));
+   return true;
+   }
+
+DEFINE_BUILDER(AOTCallNative,
+               Int32,
+               PARAM("x", Int32))
+   {
+   DefineFunction((char *)"aotCallee",
+                  (char *)__FILE__,
+                  (char *)AOT_CALLEE_LINE,
+                  (void *)&aotCallee,
+                  Int32,
+                  1,
+                  Int32);
+
+   Return(Add(Call("aotCallee", 1, Load("x")), ConstInt32(1)));
+   return true;
+   }
+
+class AOTAddConstant : public OMR::JitBuilder::MethodBuilder
+   {
+   public:
+   AOTAddConstant(OMR::JitBuilder::TypeDictionary *types, int32_t constant)
+      : OMR::JitBuilder::MethodBuilder(types), _constant(constant)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("aotAddConstant");
+      DefineParameter("x", Int32);
+      DefineReturnType(Int32);
+      }
+
+   virtual bool buildIL()
+      {
+      Return(Add(Load("x"), ConstInt32(_constant)));
+      return true;
+      }
+
+   private:
+   int32_t _constant;
+   };
+
+static long
+cacheFileSize()
+   {
+   FILE *file = fopen(AOT_CODE_CACHE_FILE, "rb");
+   if (file == NULL)
+      return -1;
+   fseek(file, 0, SEEK_END);
+   long size = ftell(file);
+   fclose(file);
+   return size;
+   }
+
+class AOTCodeCacheTest : public ::testing::Test
+   {
+   public:
+
+   static void SetUpTestCase()
+      {
+      remove(AOT_CODE_CACHE_FILE);
+      ASSERT_TRUE(initializeJitWithOptions((char *)AOT_CODE_CACHE_OPTIONS)) << "Failed to initialize the JIT.";
+      }
+
+   static void TearDownTestCase()
+      {
+      shutdownJit();
+      remove(AOT_CODE_CACHE_FILE);
+      }
+   };
+
+TEST_F(AOTCodeCacheTest, IdenticalMethodIsSavedOnce)
+   {
+   Int32Function first;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, AOTSumTo, first);
+   long sizeAfterFirst = cacheFileSize();
+   ASSERT_GT(sizeAfterFirst, 16) << "The body was not saved";
+
+   // The second compile installs the saved body
+   Int32Function second;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, AOTSumTo, second);
+   ASSERT_EQ(sizeAfterFirst, cacheFileSize());
+   ASSERT_NE((void *)first, (void *)second);
+
+   ASSERT_EQ(55, first(10));
+   ASSERT_EQ(55, second(10));
+   ASSERT_EQ(5050, second(100));
+   }
+
+TEST_F(AOTCodeCacheTest, CallTargetsAreBoundOnLoad)
+   {
+   Int32Function first;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, AOTCallNative, first);
+   long sizeAfterFirst = cacheFileSize();
+
+   Int32Function second;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, AOTCallNative, second);
+   ASSERT_EQ(sizeAfterFirst, cacheFileSize());
+
+   ASSERT_EQ(7, first(2));
+   ASSERT_EQ(7, second(2));
+   ASSERT_EQ(-29, second(-10));
+   }
+
+TEST_F(AOTCodeCacheTest, DifferentConstantsAreSavedSeparately)
+   {
+   OMR::JitBuilder::TypeDictionary types;
+   AOTAddConstant addFive(&types, 5);
+   AOTAddConstant addNine(&types, 9);
+   void *entry = NULL;
+
+   long sizeBefore = cacheFileSize();
+   ASSERT_EQ(0, compileMethodBuilder(&addFive, &entry));
+   Int32Function five = (Int32Function)entry;
+   long sizeAfterFive = cacheFileSize();
+   ASSERT_GT(sizeAfterFive, sizeBefore);
+
+   ASSERT_EQ(0, compileMethodBuilder(&addNine, &entry));
+   Int32Function nine = (Int32Function)entry;
+   ASSERT_GT(cacheFileSize(), sizeAfterFive);
+
+   ASSERT_EQ(6, five(1));
+   ASSERT_EQ(10, nine(1));
+   }
+
+TEST_F(AOTCodeCacheTest, DifferentOptionsAreSavedSeparately)
+   {
+   Int32Function first;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, AOTSumTo, first);
+   long sizeAfterFirst = cacheFileSize();
+   ASSERT_EQ(55, first(10));
+
+   // The body saved under the first options must not be installed
+   shutdownJit();
+   ASSERT_TRUE(initializeJitWithOptions((char *)AOT_CODE_CACHE_OPTIONS ",disableLocalCSE")) << "Failed to initialize the JIT.";
+   Int32Function second;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, AOTSumTo, second);
+   long sizeAfterSecond = cacheFileSize();
+   ASSERT_GT(sizeAfterSecond, sizeAfterFirst);
+   ASSERT_EQ(55, second(10));
+
+   shutdownJit();
+   ASSERT_TRUE(initializeJitWithOptions((char *)AOT_CODE_CACHE_OPTIONS)) << "Failed to initialize the JIT.";
+   Int32Function third;
+   ASSERT_COMPILE(OMR::JitBuilder::TypeDictionary, AOTSumTo, third);
+   ASSERT_EQ(sizeAfterSecond, cacheFileSize());
+   ASSERT_EQ(5050, third(100));
+   }
@@ -0,0 +1,279 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+struct AsyncPoint
+   {
+   int32_t x;
+   int32_t y;
+   };
+
+DEFINE_TYPES(AsyncPointTypes)
+   {
+   DefineStruct("AsyncPoint");
+   DefineField("AsyncPoint", "x", Int32, offsetof(AsyncPoint, x));
+   DefineField("AsyncPoint", "y", Int32, offsetof(AsyncPoint, y));
+   CloseStruct("AsyncPoint");
+   }
+
+typedef int32_t (*AddConstantFunction)(int32_t);
+typedef int32_t (*ScaledSumFunction)(AsyncPoint *);
+
+/*
+ * Each instance compiles to a different body so that a result reaching the
+ * wrong entry slot is caught.
+ */
+class AddConstantBuilder : public OMR::JitBuilder::MethodBuilder
+   {
+   public:
+   AddConstantBuilder(OMR::JitBuilder::TypeDictionary *types, int32_t constant)
+      : OMR::JitBuilder::MethodBuilder(types), _constant(constant)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("addConstant");
+      DefineParameter("x", Int32);
+      DefineReturnType(Int32);
+      }
+
+   virtual bool buildIL()
+      {
+      Return(Add(Load("x"), ConstInt32(_constant)));
+      return true;
+      }
+
+   private:
+   int32_t _constant;
+   };
+
+/*
+ * Field accesses make the compile populate the symbol reference cache of
+ * the shared TypeDictionary.
+ */
+class ScaledSumBuilder : public OMR::JitBuilder::MethodBuilder
+   {
+   public:
+   ScaledSumBuilder(OMR::JitBuilder::TypeDictionary *types, int32_t scale)
+      : OMR::JitBuilder::MethodBuilder(types), _scale(scale)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("scaledSum");
+      DefineParameter("p", types->PointerTo("AsyncPoint"));
+      DefineReturnType(Int32);
+      }
+
+   virtual bool buildIL()
+      {
+      OMR::JitBuilder::IlValue *x = LoadIndirect("AsyncPoint", "x", Load("p"));
+      OMR::JitBuilder::IlValue *y = LoadIndirect("AsyncPoint", "y", Load("p"));
+      Return(Mul(Add(x, y), ConstInt32(_scale)));
+      return true;
+      }
+
+   private:
+   int32_t _scale;
+   };
+
+static void
+countCompletion(void *entryPoint, int32_t returnCode, void *userData)
+   {
+   if (entryPoint != NULL && returnCode == 0)
+      *static_cast<int32_t *>(userData) += 1;
+   }
+
+class AsyncCompileTest : public ::testing::Test
+   {
+   public:
+
+   static void SetUpTestCase()
+      {
+      ASSERT_TRUE(initializeJitWithOptions((char *)"-Xjit:acceptHugeMethods,enableBasicBlockHoisting,omitFramePointer,useILValidator,compilationThreads=4")) << "Failed to initialize the JIT.";
+      }
+
+   static void TearDownTestCase()
+      {
+      shutdownJit();
+      }
+   };
+
+TEST_F(AsyncCompileTest, ConcurrentCompilesShareCodeCache)
+   {
+   const int32_t numBuilders = 32;
+   std::vector<OMR::JitBuilder::TypeDictionary *> types;
+   std::vector<AddConstantBuilder *> builders;
+   std::vector<void *> entries(numBuilders, (void *)NULL);
+
+   for (int32_t i = 0; i < numBuilders; ++i)
+      {
+      types.push_back(new OMR::JitBuilder::TypeDictionary());
+      builders.push_back(new AddConstantBuilder(types[i], i * 10));
+      ASSERT_TRUE(compileMethodBuilderAsync(builders[i], i % 4, &entries[i], NULL, NULL));
+      }
+
+   for (int32_t i = 0; i < numBuilders; ++i)
+      {
+      ASSERT_EQ(0, waitForCompilation(builders[i])) << "Compilation " << i << " failed";
+      ASSERT_TRUE(entries[i] != NULL);
+      }
+
+   for (int32_t i = 0; i < numBuilders; ++i)
+      {
+      for (int32_t j = 0; j < numBuilders; ++j)
+         {
+         if (i != j)
+            ASSERT_NE(entries[i], entries[j]);
+         }
+      AddConstantFunction addConstant = (AddConstantFunction)entries[i];
+      ASSERT_EQ(i * 10 + 7, addConstant(7));
+      }
+
+   for (int32_t i = 0; i < numBuilders; ++i)
+      {
+      delete builders[i];
+      delete types[i];
+      }
+   }
+
+TEST_F(AsyncCompileTest, SharedTypeDictionary)
+   {
+   const int32_t numBuilders = 8;
+   AsyncPointTypes types;
+   std::vector<ScaledSumBuilder *> builders;
+   std::vector<void *> entries(numBuilders, (void *)NULL);
+
+   for (int32_t i = 0; i < numBuilders; ++i)
+      {
+      builders.push_back(new ScaledSumBuilder(&types, i + 1));
+      ASSERT_TRUE(compileMethodBuilderAsync(builders[i], 0, &entries[i], NULL, NULL));
+      }
+
+   AsyncPoint point = { 3, 4 };
+   for (int32_t i = 0; i < numBuilders; ++i)
+      {
+      ASSERT_EQ(0, waitForCompilation(builders[i]));
+      ScaledSumFunction scaledSum = (ScaledSumFunction)entries[i];
+      ASSERT_EQ(7 * (i + 1), scaledSum(&point));
+      delete builders[i];
+      }
+   }
+
+TEST_F(AsyncCompileTest, EntrySlotAndCallback)
+   {
+   OMR::JitBuilder::TypeDictionary types;
+   AddConstantBuilder builder(&types, 42);
+   void * volatile entry = NULL;
+   int32_t completions = 0;
+
+   ASSERT_TRUE(compileMethodBuilderAsync(&builder, 0, (void **)&entry, (void *)countCompletion, &completions));
+
+   // The requester keeps "interpreting" until the body is installed
+   while (entry == NULL)
+      ;
+
+   AddConstantFunction addConstant = (AddConstantFunction)entry;
+   ASSERT_EQ(43, addConstant(1));
+   ASSERT_EQ(0, waitForCompilation(&builder));
+   ASSERT_EQ(1, completions);
+
+   // Once collected, the same builder can be queued again
+   void *recompiled = NULL;
+   ASSERT_TRUE(compileMethodBuilderAsync(&builder, 0, &recompiled, (void *)countCompletion, &completions));
+   ASSERT_EQ(0, waitForCompilation(&builder));
+   ASSERT_EQ(2, completions);
+   ASSERT_EQ(43, ((AddConstantFunction)recompiled)(1));
+   }
+
+class SumToBuilder : public OMR::JitBuilder::MethodBuilder
+   {
+   public:
+   SumToBuilder(OMR::JitBuilder::TypeDictionary *types)
+      : OMR::JitBuilder::MethodBuilder(types)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("sumTo");
+      DefineParameter("n", Int32);
+      DefineLocal("sum", Int32);
+      DefineReturnType(Int32);
+      }
+
+   virtual bool buildIL()
+      {
+      Store("sum", ConstInt32(0));
+      OMR::JitBuilder::IlBuilder *body = NULL;
+      ForLoopUp("i", &body, ConstInt32(0), Load("n"), ConstInt32(1));
+      body->Store("sum", body->Add(body->Load("sum"), body->Load("i")));
+      Return(Load("sum"));
+      return true;
+      }
+   };
+
+typedef int32_t (*SumToFunction)(int32_t);
+
+class TieredCompileTest : public ::testing::Test
+   {
+   public:
+
+   static void SetUpTestCase()
+      {
+      ASSERT_TRUE(initializeJitWithOptions((char *)"-Xjit:acceptHugeMethods,omitFramePointer,useILValidator,compilationThreads=2,enableTieredCompilation,tieredRecompileThreshold=50")) << "Failed to initialize the JIT.";
+      }
+
+   static void TearDownTestCase()
+      {
+      shutdownJit();
+      }
+   };
+
+TEST_F(TieredCompileTest, CountersTriggerRecompile)
+   {
+   // The builder has to outlive any recompile, which may be queued until
+   // the JIT shuts down
+   static OMR::JitBuilder::TypeDictionary types;
+   static SumToBuilder builder(&types);
+   static void * volatile entry = NULL;
+
+   ASSERT_TRUE(compileMethodBuilderAsync(&builder, 0, (void **)&entry, NULL, NULL));
+   ASSERT_EQ(0, waitForCompilation(&builder));
+   void *firstTier = entry;
+   ASSERT_TRUE(firstTier != NULL);
+
+   // Every call runs the loop 10 times, so a handful of calls exhausts the
+   // counter; keep calling through the slot until the second tier lands
+   for (int32_t i = 0; i < 1000 && entry == firstTier; ++i)
+      {
+      for (int32_t j = 0; j < 100; ++j)
+         ASSERT_EQ(45, ((SumToFunction)entry)(10));
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+      }
+
+   void *secondTier = entry;
+   ASSERT_NE(firstTier, secondTier) << "first tier body was never replaced";
+   ASSERT_EQ(0, waitForCompilation(&builder));
+   ASSERT_EQ(45, ((SumToFunction)secondTier)(10));
+   ASSERT_EQ(4950, ((SumToFunction)secondTier)(100));
+   }
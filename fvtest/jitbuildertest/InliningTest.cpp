@@ -0,0 +1,226 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "JBTestUtil.hpp"
+
+#include <vector>
+
+typedef int32_t (*MaddFunction)(int32_t, int32_t);
+typedef int32_t (*SumFunction)(int32_t);
+
+/*
+ * A small callee: the first instance is compiled on its own and registered as
+ * the prototype of "madd", later instances are constructed with the calling
+ * MethodBuilder and generate the body of "madd" at an inlined call site.
+ */
+class MaddBuilder : public OMR::JitBuilder::MethodBuilder
+   {
+   public:
+   MaddBuilder(OMR::JitBuilder::TypeDictionary *types)
+      : OMR::JitBuilder::MethodBuilder(types)
+      {
+      define();
+      }
+
+   MaddBuilder(OMR::JitBuilder::MethodBuilder *callerMB)
+      : OMR::JitBuilder::MethodBuilder(callerMB)
+      {
+      define();
+      }
+
+   virtual bool buildIL()
+      {
+      Return(Add(Mul(Load("x"), Load("k")), ConstInt32(1)));
+      return true;
+      }
+
+   private:
+   void define()
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("madd");
+      DefineParameter("x", Int32);
+      DefineParameter("k", Int32);
+      DefineReturnType(Int32);
+      }
+   };
+
+/*
+ * A callee that is too large to be worth inlining: a long chain of dependent
+ * additions that computes x + LONG_CHAIN_LENGTH * k.
+ */
+#define LONG_CHAIN_LENGTH 400
+
+class LongChainBuilder : public OMR::JitBuilder::MethodBuilder
+   {
+   public:
+   LongChainBuilder(OMR::JitBuilder::TypeDictionary *types)
+      : OMR::JitBuilder::MethodBuilder(types)
+      {
+      define();
+      }
+
+   LongChainBuilder(OMR::JitBuilder::MethodBuilder *callerMB)
+      : OMR::JitBuilder::MethodBuilder(callerMB)
+      {
+      define();
+      }
+
+   virtual bool buildIL()
+      {
+      for (int32_t i = 0; i < LONG_CHAIN_LENGTH; ++i)
+         Store("x", Add(Load("x"), Load("k")));
+      Return(Load("x"));
+      return true;
+      }
+
+   private:
+   void define()
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("longChain");
+      DefineParameter("x", Int32);
+      DefineParameter("k", Int32);
+      DefineReturnType(Int32);
+      }
+   };
+
+/*
+ * Sums callee(i, 3) for i in [0, n), calling the callee from inside a loop.
+ * Every MethodBuilder handed back for an inlined call site is counted.
+ */
+template <class Callee>
+class CallInLoopBuilder : public OMR::JitBuilder::MethodBuilder
+   {
+   public:
+   CallInLoopBuilder(OMR::JitBuilder::TypeDictionary *types, Callee *prototype, void *entryPoint)
+      : OMR::JitBuilder::MethodBuilder(types), _prototype(prototype), _entryPoint(entryPoint)
+      {
+      DefineLine(LINETOSTR(__LINE__));
+      DefineFile(__FILE__);
+      DefineName("callInLoop");
+      DefineParameter("n", Int32);
+      DefineLocal("sum", Int32);
+      DefineReturnType(Int32);
+      }
+
+   ~CallInLoopBuilder()
+      {
+      for (size_t i = 0; i < _inlinedCallees.size(); ++i)
+         delete _inlinedCallees[i];
+      }
+
+   virtual bool buildIL()
+      {
+      DefineFunction(_prototype, _entryPoint);
+
+      Store("sum", ConstInt32(0));
+      OMR::JitBuilder::IlBuilder *body = NULL;
+      ForLoopUp("i", &body, ConstInt32(0), Load("n"), ConstInt32(1));
+      OMR::JitBuilder::IlValue *args[] = { body->Load("i"), body->ConstInt32(3) };
+      OMR::JitBuilder::IlValue *value = body->Call(_prototype->GetMethodName(), 2, args);
+      body->Store("sum", body->Add(body->Load("sum"), value));
+      Return(Load("sum"));
+      return true;
+      }
+
+   virtual OMR::JitBuilder::MethodBuilder *RequestInlinedFunction(const char *name)
+      {
+      Callee *callee = new Callee(this);
+      _inlinedCallees.push_back(callee);
+      return callee;
+      }
+
+   size_t numInlinedCalls() { return _inlinedCallees.size(); }
+
+   private:
+   Callee *_prototype;
+   void *_entryPoint;
+   std::vector<Callee *> _inlinedCallees;
+   };
+
+class InliningTest : public ::testing::Test
+   {
+   public:
+
+   static void SetUpTestCase()
+      {
+      ASSERT_TRUE(initializeJitWithOptions((char *)"-Xjit:acceptHugeMethods,omitFramePointer,useILValidator")) << "Failed to initialize the JIT.";
+      }
+
+   static void TearDownTestCase()
+      {
+      shutdownJit();
+      }
+   };
+
+TEST_F(InliningTest, SmallCalleeInLoopIsInlined)
+   {
+   OMR::JitBuilder::TypeDictionary types;
+   MaddBuilder madd(&types);
+   void *maddEntry = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(&madd, &maddEntry));
+   ASSERT_EQ(7, ((MaddFunction)maddEntry)(2, 3));
+
+   CallInLoopBuilder<MaddBuilder> caller(&types, &madd, maddEntry);
+   void *entry = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(&caller, &entry));
+   ASSERT_EQ(1u, caller.numInlinedCalls());
+
+   SumFunction sum = (SumFunction)entry;
+   ASSERT_EQ(0, sum(0));
+   ASSERT_EQ(1, sum(1));
+   ASSERT_EQ(145, sum(10));
+   }
+
+TEST_F(InliningTest, CalleeOfUnknownSizeIsCalled)
+   {
+   // The prototype is never compiled, so the size of its IL is unknown and
+   // the call goes to the (separately compiled) entry point
+   OMR::JitBuilder::TypeDictionary types;
+   MaddBuilder compiled(&types);
+   void *maddEntry = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(&compiled, &maddEntry));
+
+   MaddBuilder madd(&types);
+   CallInLoopBuilder<MaddBuilder> caller(&types, &madd, maddEntry);
+   void *entry = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(&caller, &entry));
+   ASSERT_EQ(0u, caller.numInlinedCalls());
+   ASSERT_EQ(145, ((SumFunction)entry)(10));
+   }
+
+TEST_F(InliningTest, LargeCalleeIsCalled)
+   {
+   OMR::JitBuilder::TypeDictionary types;
+   LongChainBuilder longChain(&types);
+   void *longChainEntry = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(&longChain, &longChainEntry));
+   ASSERT_EQ(LONG_CHAIN_LENGTH + 5, ((MaddFunction)longChainEntry)(5, 1));
+
+   CallInLoopBuilder<LongChainBuilder> caller(&types, &longChain, longChainEntry);
+   void *entry = NULL;
+   ASSERT_EQ(0, compileMethodBuilder(&caller, &entry));
+   ASSERT_EQ(0u, caller.numInlinedCalls());
+   ASSERT_EQ(45 + 30 * LONG_CHAIN_LENGTH, ((SumFunction)entry)(10));
+   }
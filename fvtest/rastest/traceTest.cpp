@@ -93,6 +93,18 @@ TEST(RASTraceTest, TraceAgent)
 	Trc_OMR_Test_Int(vmthread, 10);
 	Trc_OMR_Test_ManyParms(vmthread, "Hello again!", vmthread, 10);
 
+	/* Time a span. Outlier=0 also logs every span as an event. */
+	uint64_t spanStart = Trc_OMR_Test_Span_Begin(vmthread);
+	ASSERT_NE((uint64_t)0, spanStart);
+	Trc_OMR_Test_Span_End(vmthread, spanStart, "Hello span!");
+
+	OMR_TraceSpanHistogram histogram;
+	OMRTEST_ASSERT_ERROR_NONE(testVM.omrVM._trcEngine->omrTraceIntfS.GetSpanHistogram("omr_test", 6, &histogram));
+	ASSERT_EQ((uint64_t)1, histogram.count);
+	ASSERT_EQ(histogram.minNanos, histogram.maxNanos);
+	ASSERT_EQ(histogram.totalNanos, histogram.maxNanos);
+	OMRTEST_ASSERT_ERROR(testVM.omrVM._trcEngine->omrTraceIntfS.GetSpanHistogram("omr_test", 5, &histogram), OMR_ERROR_NOT_AVAILABLE);
+
 	/* Fire some trace points in another thread. */
 	OMRTEST_ASSERT_ERROR_NONE(startTestChildThread(&testVM, vmthread, &childThread, &childData));
 
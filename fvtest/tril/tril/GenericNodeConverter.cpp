@@ -185,6 +185,19 @@ TR::Node* GenericNodeConverter::impl(const ASTNode* tree, IlGenState* state) {
         TraceIL("  created temporary %s n%dn (%p)\n", c1->getOpCode().getName(), c1->getGlobalIndex(), c1);
         node = TR::Node::createif(opcode.getOpCodeValue(), c1, c2, targetEntry);
     }
+    else if (opcode.isCase()) {
+        const auto targetName = tree->getArgByName("target")->getValue()->getString();
+        auto targetId = state->findBlockByName(targetName);
+        auto targetEntry = state->blocks()[targetId]->getEntry();
+
+        // the default case of a switch and the cases of a table have no value
+        CASECONST_TYPE value = 0;
+        if (tree->getArgByName("value") != NULL) {
+            value = tree->getArgByName("value")->getValue()->get<int32_t>();
+        }
+        TraceIL("  is case %d with target block %d (%s, entry = %p)\n", value, targetId, targetName, targetEntry);
+        node = TR::Node::createCase(NULL, targetEntry, value);
+    }
     else if (opcode.isBranch()) {
         const auto targetName = tree->getArgByName("target")->getValue()->getString();
         auto targetId = state->findBlockByName(targetName);
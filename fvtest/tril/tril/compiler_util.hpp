@@ -47,6 +47,18 @@ static TR::DataTypes getTRDataTypes(const std::string& name) {
    else if (name == "VectorInt64") return TR::VectorInt64;
    else if (name == "VectorFloat") return TR::VectorFloat;
    else if (name == "VectorDouble") return TR::VectorDouble;
+   else if (name == "Vector256Int8") return TR::Vector256Int8;
+   else if (name == "Vector256Int16") return TR::Vector256Int16;
+   else if (name == "Vector256Int32") return TR::Vector256Int32;
+   else if (name == "Vector256Int64") return TR::Vector256Int64;
+   else if (name == "Vector256Float") return TR::Vector256Float;
+   else if (name == "Vector256Double") return TR::Vector256Double;
+   else if (name == "Vector512Int8") return TR::Vector512Int8;
+   else if (name == "Vector512Int16") return TR::Vector512Int16;
+   else if (name == "Vector512Int32") return TR::Vector512Int32;
+   else if (name == "Vector512Int64") return TR::Vector512Int64;
+   else if (name == "Vector512Float") return TR::Vector512Float;
+   else if (name == "Vector512Double") return TR::Vector512Double;
    else if (name == "NoType") return TR::NoType;
    else {
       throw std::runtime_error(static_cast<const std::string&>(std::string("Unknown type name: ").append(name)));
@@ -104,7 +104,9 @@ bool Tril::TRLangBuilder::cfgFor(const ASTNode* const tree, IlGenState* state) {
    else if (opcode.isBranch()) {
       const auto targetName = tree->getArgByName("target")->getValue()->getString();
       auto targetId = state->findBlockByName(targetName);
-      cfg()->addEdge(_currentBlock, _blocks[targetId]);
+      // several cases of a switch may branch to the same block
+      if (!_currentBlock->hasSuccessor(_blocks[targetId]))
+         cfg()->addEdge(_currentBlock, _blocks[targetId]);
       isFallthroughNeeded = isFallthroughNeeded && opcode.isIf();
       TraceIL("Added CFG edge from block %d to block %d (\"%s\") -> %s\n", _currentBlockNumber, targetId, targetName, tree->getName());
    }
@@ -129,6 +131,11 @@ bool Tril::TRLangBuilder::injectIL() {
     state->setSymRefTab(_symRefTab);
     state->setMethodSymbol(_methodSymbol);
     state->setComp(comp());
+
+    // loop optimizations only run on methods that may have loops
+    if (_mayHaveLoops)
+        _methodSymbol->setMayHaveLoops(true);
+
     TraceIL("=== %s ===\n", "Generating Blocks");
 
     // the top level nodes of the AST should be all the basic blocks
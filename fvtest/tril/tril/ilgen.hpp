@@ -90,9 +90,10 @@ class TRLangBuilder : public TR::IlInjector {
          * @param trees is the list of AST nodes representing the TR::Node instances to be generated
          * @param d is the type dictionary to be used this IL generator
          * @param converter is the root of the ASTNode that needed to be converted into TRNode
+         * @param mayHaveLoops is true if the method is marked as possibly having loops
          */
-        TRLangBuilder(const ASTNode* trees, TR::TypeDictionary* d, ASTToTRNode* converter)
-              : TR::IlInjector(d), _converter(converter), _trees(trees) {}
+        TRLangBuilder(const ASTNode* trees, TR::TypeDictionary* d, ASTToTRNode* converter, bool mayHaveLoops = false)
+              : TR::IlInjector(d), _converter(converter), _trees(trees), _mayHaveLoops(mayHaveLoops) {}
 
         bool injectIL(); /* override */
 
@@ -116,6 +117,7 @@ class TRLangBuilder : public TR::IlInjector {
         ASTToTRNode* _converter;
         TR::TypeDictionary _types;
         const ASTNode* _trees;    // pointer to the AST node list representing Trees
+        bool _mayHaveLoops;
 };
 
 } // namespace Tril
@@ -51,6 +51,9 @@ class MethodInfo {
             if (nameArg != NULL) {
                 _name = nameArg->getValue()->get<ASTValue::String_t>();
             }
+
+            auto mayHaveLoopsArg = _methodNode->getArgByName("mayHaveLoops");
+            _mayHaveLoops = mayHaveLoopsArg != NULL && mayHaveLoopsArg->getValue()->getInteger() != 0;
         }
 
         /**
@@ -83,11 +86,17 @@ class MethodInfo {
          */
         std::size_t getArgCount() const { return _argTypes.size(); }
 
+        /**
+         * @brief Returns true if the method is marked as possibly having loops
+         */
+        bool mayHaveLoops() const { return _mayHaveLoops; }
+
     private:
         const ASTNode* _methodNode;
         std::string _name;
         TR::DataTypes _returnType;
         std::vector<TR::DataTypes> _argTypes;
+        bool _mayHaveLoops;
 };
 
 } // namespace Tril
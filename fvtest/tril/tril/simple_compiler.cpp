@@ -51,7 +51,7 @@ int32_t Tril::SimpleCompiler::compileWithVerifier(TR::IlVerifier* verifier) {
     TR::TypeDictionary types;
     GenericNodeConverter genericNodeConverter;
     CallConverter callConverter(&genericNodeConverter);
-    Tril::TRLangBuilder ilgenerator(methodInfo.getBodyAST(), &types, &callConverter);
+    Tril::TRLangBuilder ilgenerator(methodInfo.getBodyAST(), &types, &callConverter, methodInfo.mayHaveLoops());
 
     // get a list of the method's argument types and transform it
     // into a list of `TR::IlType`
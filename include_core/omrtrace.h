@@ -94,6 +94,28 @@ typedef struct OMR_TraceThread {
 	int indent;						/* Iprint indentation count        */
 } OMR_TraceThread;
 
+/*
+ * =============================================================================
+ * Span tracepoint latency histograms
+ *
+ * Durations are recorded in nanoseconds into log-linear buckets. Values below
+ * OMR_TRACE_SPAN_SUB_BUCKETS get one bucket each; every power of two above that
+ * is split into OMR_TRACE_SPAN_SUB_BUCKETS equal-width buckets, so the relative
+ * error of any bucket is at most 1/OMR_TRACE_SPAN_SUB_BUCKETS.
+ * =============================================================================
+ */
+#define OMR_TRACE_SPAN_SUB_BUCKET_BITS	3
+#define OMR_TRACE_SPAN_SUB_BUCKETS		(1 << OMR_TRACE_SPAN_SUB_BUCKET_BITS)
+#define OMR_TRACE_SPAN_BUCKETS			((64 - OMR_TRACE_SPAN_SUB_BUCKET_BITS + 1) * OMR_TRACE_SPAN_SUB_BUCKETS)
+
+typedef struct OMR_TraceSpanHistogram {
+	uint64_t count;							/* Number of spans recorded        */
+	uint64_t totalNanos;					/* Sum of all recorded durations   */
+	uint64_t minNanos;						/* Shortest recorded duration      */
+	uint64_t maxNanos;						/* Longest recorded duration       */
+	uint64_t buckets[OMR_TRACE_SPAN_BUCKETS];
+} OMR_TraceSpanHistogram;
+
 typedef struct OMR_TraceInterface {
 	omr_error_t (*RegisterRecordSubscriber)(struct OMR_TraceThread *thr, const char *description,
 		utsSubscriberCallback func, utsSubscriberAlarmCallback alarm,
@@ -102,6 +124,7 @@ typedef struct OMR_TraceInterface {
 	omr_error_t (*FlushTraceData)(struct OMR_TraceThread *thr);
 	omr_error_t (*GetTraceMetadata)(void **data, int32_t *length);
 	omr_error_t (*SetOptions)(struct OMR_TraceThread *thr, const char *opts[]);
+	omr_error_t (*GetSpanHistogram)(const char *componentName, int32_t tracepoint, OMR_TraceSpanHistogram *histogram);
 } OMR_TraceInterface;
 
 /*
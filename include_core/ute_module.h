@@ -142,6 +142,12 @@ struct  UtModuleInterface {
 	void (*TraceState)(void *env, UtModuleInfo *modInfo, uint32_t traceId, const char *, ...);
 	void (*TraceInit)(void *env, UtModuleInfo *mod);
 	void (*TraceTerm)(void *env, UtModuleInfo *mod);
+	/* Span tracepoints. TraceSpanBegin returns a non-zero start time, or 0 if the span
+	 * should not be timed. TraceSpanEnd records the elapsed time into the tracepoint's
+	 * latency histogram and returns it in nanoseconds.
+	 */
+	uint64_t (*TraceSpanBegin)(void *env, UtModuleInfo *modInfo, uint32_t traceId);
+	uint64_t (*TraceSpanEnd)(void *env, UtModuleInfo *modInfo, uint32_t traceId, uint64_t startTime);
 };
 
 #ifdef  __cplusplus
@@ -0,0 +1,514 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#include "control/CompilationQueue.hpp"
+
+#include "compile/Compilation.hpp"
+#include "env/CompilerEnv.hpp"
+#include "env/PersistentAllocator.hpp"
+#include "control/Options.hpp"
+#include "ilgen/MethodBuilder.hpp"
+#include "infra/Assert.hpp"
+
+#if !defined(TR_TARGET_POWER) || !defined(__clang__)
+#include "AtomicSupport.hpp"
+#endif
+
+extern int32_t internal_compileMethodBuilderAtLevel(TR::MethodBuilder *m, void **entry, TR_Hotness hotness, int32_t *recompilationCounter);
+
+// The compiler recurses over trees and blocks; the omrthread default stack
+// is far too small for that.
+#define COMPILATION_THREAD_STACK_SIZE (4 * 1024 * 1024)
+
+// How often idle compilation threads look for first tier bodies whose
+// recompilation counter has run out
+#define TIERING_SAMPLE_INTERVAL_MS 10
+
+JitBuilder::CompilationQueue *JitBuilder::CompilationQueue::_instance = NULL;
+
+namespace
+{
+
+/**
+ * Every thread that touches a monitor has to be known to the thread
+ * library. Interpreter threads that were never attached are attached on
+ * their first request and stay attached.
+ */
+void
+attachCurrentThread()
+   {
+   if (omrthread_self() == NULL)
+      {
+      omrthread_t self;
+      omrthread_attach_ex(&self, J9THREAD_ATTR_DEFAULT);
+      }
+   }
+
+class QueueLock
+   {
+   public:
+   QueueLock(omrthread_monitor_t monitor) : _monitor(monitor) { omrthread_monitor_enter(_monitor); }
+   ~QueueLock() { omrthread_monitor_exit(_monitor); }
+
+   private:
+   omrthread_monitor_t _monitor;
+   };
+
+}
+
+JitBuilder::CompilationRequest::CompilationRequest(
+      TR::MethodBuilder *methodBuilder,
+      int32_t priority,
+      void **entrySlot,
+      CompletionCallback callback,
+      void *userData) :
+   _methodBuilder(methodBuilder),
+   _types(methodBuilder->typeDictionary()),
+   _hotness(warm),
+   _recompilationCounter(NULL),
+   _priority(priority),
+   _sequence(0),
+   _entrySlot(entrySlot),
+   _callback(callback),
+   _userData(userData),
+   _entryPoint(NULL),
+   _returnCode(COMPILATION_REQUESTED),
+   _done(false),
+   _next(NULL)
+   {
+   }
+
+bool
+JitBuilder::CompilationRequest::isDone() const
+   {
+   bool done = _done;
+#if !defined(TR_TARGET_POWER) || !defined(__clang__)
+   VM_AtomicSupport::readBarrier();
+#endif
+   return done;
+   }
+
+bool
+JitBuilder::CompilationQueue::initialize()
+   {
+   TR_ASSERT_FATAL(_instance == NULL, "CompilationQueue initialized twice");
+
+   if (omrthread_init_library() != 0)
+      return false;
+   attachCurrentThread();
+
+   void *storage = TR::Compiler->persistentAllocator().allocate(sizeof(CompilationQueue), std::nothrow);
+   if (storage == NULL)
+      return false;
+
+   CompilationQueue *queue = new (storage) CompilationQueue();
+   if (omrthread_monitor_init_with_name(&queue->_monitor, 0, "JIT-CompilationQueueMonitor") != 0)
+      {
+      TR::Compiler->persistentAllocator().deallocate(storage);
+      return false;
+      }
+
+   _instance = queue;
+   return true;
+   }
+
+void
+JitBuilder::CompilationQueue::shutdown()
+   {
+   CompilationQueue *queue = _instance;
+   if (queue == NULL)
+      return;
+
+   attachCurrentThread();
+   queue->drain();
+   queue->stopThreads();
+
+   // Results nobody waited for
+   CompilationRequest *request = queue->_completed;
+   while (request)
+      {
+      CompilationRequest *next = request->_next;
+      TR::Compiler->persistentAllocator().deallocate(request);
+      request = next;
+      }
+
+   TieredMethod *tiered = queue->_tieredMethods;
+   while (tiered)
+      {
+      TieredMethod *next = tiered->_next;
+      TR::Compiler->persistentAllocator().deallocate(tiered);
+      tiered = next;
+      }
+
+   omrthread_monitor_destroy(queue->_monitor);
+   _instance = NULL;
+   TR::Compiler->persistentAllocator().deallocate(queue);
+   }
+
+JitBuilder::CompilationQueue::CompilationQueue() :
+   _monitor(NULL),
+   _pending(NULL),
+   _inProgress(NULL),
+   _completed(NULL),
+   _tieredMethods(NULL),
+   _nextSequence(0),
+   _numThreads(0),
+   _numActiveThreads(0),
+   _stopping(false)
+   {
+   }
+
+JitBuilder::CompilationRequest *
+JitBuilder::CompilationQueue::enqueue(
+      TR::MethodBuilder *methodBuilder,
+      int32_t priority,
+      void **entrySlot,
+      CompletionCallback callback,
+      void *userData)
+   {
+   attachCurrentThread();
+   QueueLock lock(_monitor);
+
+   if (_stopping)
+      return NULL;
+
+   // A single worker until concurrent compilations are known to be safe
+   if (_numThreads == 0 && !startThreads(1))
+      return NULL;
+
+   CompilationRequest *request = createRequest(methodBuilder, priority, entrySlot, callback, userData);
+   if (request == NULL)
+      return NULL;
+
+   if (entrySlot && TR::Options::getCmdLineOptions()->getOption(TR_EnableTieredCompilation))
+      {
+      TieredMethod *tiered = startTiering(methodBuilder, priority, entrySlot);
+      if (tiered)
+         {
+         request->_hotness = cold;
+         request->_recompilationCounter = &tiered->_counter;
+         }
+      }
+
+   insertPending(request);
+   omrthread_monitor_notify_all(_monitor);
+   return request;
+   }
+
+JitBuilder::CompilationRequest *
+JitBuilder::CompilationQueue::createRequest(
+      TR::MethodBuilder *methodBuilder,
+      int32_t priority,
+      void **entrySlot,
+      CompletionCallback callback,
+      void *userData)
+   {
+   CompilationRequest *request = findRequest(methodBuilder);
+   if (request)
+      {
+      if (!request->_done)
+         return NULL;
+
+      // Recycle the previous, unclaimed result for this builder
+      unlinkRequest(request);
+      request = new (request) CompilationRequest(methodBuilder, priority, entrySlot, callback, userData);
+      }
+   else
+      {
+      void *storage = TR::Compiler->persistentAllocator().allocate(sizeof(CompilationRequest), std::nothrow);
+      if (storage == NULL)
+         return NULL;
+      request = new (storage) CompilationRequest(methodBuilder, priority, entrySlot, callback, userData);
+      }
+
+   request->_sequence = _nextSequence++;
+   return request;
+   }
+
+int32_t
+JitBuilder::CompilationQueue::wait(TR::MethodBuilder *methodBuilder)
+   {
+   attachCurrentThread();
+   QueueLock lock(_monitor);
+
+   CompilationRequest *request = findRequest(methodBuilder);
+   if (request == NULL)
+      return COMPILATION_REQUESTED;
+
+   while (!request->_done)
+      omrthread_monitor_wait(_monitor);
+
+   int32_t rc = request->_returnCode;
+   unlinkRequest(request);
+   TR::Compiler->persistentAllocator().deallocate(request);
+   return rc;
+   }
+
+void
+JitBuilder::CompilationQueue::drain()
+   {
+   QueueLock lock(_monitor);
+   while (_pending || _inProgress)
+      omrthread_monitor_wait(_monitor);
+   }
+
+bool
+JitBuilder::CompilationQueue::startThreads(int32_t numThreads)
+   {
+   if (numThreads <= 0)
+      numThreads = 1;
+
+   for (int32_t i = 0; i < numThreads; ++i)
+      {
+      omrthread_t thread;
+      if (omrthread_create(&thread, COMPILATION_THREAD_STACK_SIZE, J9THREAD_PRIORITY_NORMAL, 0, compilationThreadProc, this) != 0)
+         break;
+      _numThreads++;
+      _numActiveThreads++;
+      }
+
+   return _numThreads > 0;
+   }
+
+void
+JitBuilder::CompilationQueue::stopThreads()
+   {
+   QueueLock lock(_monitor);
+   _stopping = true;
+   omrthread_monitor_notify_all(_monitor);
+   while (_numActiveThreads > 0)
+      omrthread_monitor_wait(_monitor);
+   }
+
+JitBuilder::CompilationRequest *
+JitBuilder::CompilationQueue::findRequest(TR::MethodBuilder *methodBuilder)
+   {
+   CompilationRequest *lists[] = { _pending, _inProgress, _completed };
+   for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); ++i)
+      {
+      for (CompilationRequest *request = lists[i]; request; request = request->_next)
+         {
+         if (request->_methodBuilder == methodBuilder)
+            return request;
+         }
+      }
+   return NULL;
+   }
+
+void
+JitBuilder::CompilationQueue::unlinkRequest(CompilationRequest *request)
+   {
+   CompilationRequest **lists[] = { &_pending, &_inProgress, &_completed };
+   for (size_t i = 0; i < sizeof(lists) / sizeof(lists[0]); ++i)
+      {
+      for (CompilationRequest **link = lists[i]; *link; link = &(*link)->_next)
+         {
+         if (*link == request)
+            {
+            *link = request->_next;
+            request->_next = NULL;
+            return;
+            }
+         }
+      }
+   }
+
+void
+JitBuilder::CompilationQueue::insertPending(CompilationRequest *request)
+   {
+   CompilationRequest **link = &_pending;
+   while (*link && (*link)->_priority >= request->_priority)
+      link = &(*link)->_next;
+   request->_next = *link;
+   *link = request;
+   }
+
+JitBuilder::TieredMethod *
+JitBuilder::CompilationQueue::startTiering(TR::MethodBuilder *methodBuilder, int32_t priority, void **entrySlot)
+   {
+   TieredMethod *tiered;
+   for (tiered = _tieredMethods; tiered; tiered = tiered->_next)
+      {
+      if (tiered->_methodBuilder == methodBuilder)
+         break;
+      }
+
+   if (tiered == NULL)
+      {
+      tiered = (TieredMethod *)TR::Compiler->persistentAllocator().allocate(sizeof(TieredMethod), std::nothrow);
+      if (tiered == NULL)
+         return NULL;
+      tiered->_methodBuilder = methodBuilder;
+      tiered->_next = _tieredMethods;
+      _tieredMethods = tiered;
+      }
+
+   tiered->_entrySlot = entrySlot;
+   tiered->_priority = priority;
+   tiered->_counter = TR::Options::getCmdLineOptions()->getTieredRecompileThreshold();
+   tiered->_upgraded = false;
+   return tiered;
+   }
+
+/**
+ * Queues a warm recompile for every first tier body whose counter has run
+ * out. A builder that still has a compile queued or running is looked at
+ * again on the next pass.
+ *
+ * @return true if some first tier body is still waiting for its upgrade
+ */
+bool
+JitBuilder::CompilationQueue::scheduleUpgrades()
+   {
+   bool waiting = false;
+   for (TieredMethod *tiered = _tieredMethods; tiered; tiered = tiered->_next)
+      {
+      if (tiered->_upgraded)
+         continue;
+
+      if (tiered->_counter > 0)
+         {
+         waiting = true;
+         continue;
+         }
+
+      CompilationRequest *request = createRequest(tiered->_methodBuilder, tiered->_priority, tiered->_entrySlot, NULL, NULL);
+      if (request == NULL)
+         {
+         waiting = true;
+         continue;
+         }
+
+      tiered->_upgraded = true;
+      insertPending(request);
+      }
+   return waiting;
+   }
+
+bool
+JitBuilder::CompilationQueue::isBeingCompiled(TR::TypeDictionary *types)
+   {
+   for (CompilationRequest *request = _inProgress; request; request = request->_next)
+      {
+      if (request->_types == types)
+         return true;
+      }
+   return false;
+   }
+
+JitBuilder::CompilationRequest *
+JitBuilder::CompilationQueue::takeNextCompilable()
+   {
+   for (CompilationRequest **link = &_pending; *link; link = &(*link)->_next)
+      {
+      CompilationRequest *request = *link;
+      if (!isBeingCompiled(request->_types))
+         {
+         *link = request->_next;
+         request->_next = _inProgress;
+         _inProgress = request;
+         return request;
+         }
+      }
+   return NULL;
+   }
+
+void
+JitBuilder::CompilationQueue::compile(CompilationRequest *request)
+   {
+   void *entry = NULL;
+   int32_t rc = internal_compileMethodBuilderAtLevel(request->_methodBuilder, &entry, request->_hotness, request->_recompilationCounter);
+   if (rc != COMPILATION_SUCCEEDED)
+      {
+      entry = NULL;
+
+      // Try the second tier right away rather than never
+      if (request->_recompilationCounter)
+         *request->_recompilationCounter = 0;
+      }
+
+   request->_entryPoint = entry;
+   request->_returnCode = rc;
+
+   // Publish the body before anyone can observe it through the entry slot
+   // or the done flag.
+#if !defined(TR_TARGET_POWER) || !defined(__clang__)
+   VM_AtomicSupport::writeBarrier();
+#endif
+   if (request->_entrySlot && entry)
+      *request->_entrySlot = entry;
+
+   if (request->_callback)
+      request->_callback(entry, rc, request->_userData);
+   }
+
+void
+JitBuilder::CompilationQueue::run()
+   {
+   omrthread_monitor_enter(_monitor);
+   while (true)
+      {
+      CompilationRequest *request = takeNextCompilable();
+      if (request == NULL)
+         {
+         if (_stopping)
+            break;
+
+         uint64_t sequence = _nextSequence;
+         bool waitingForUpgrade = scheduleUpgrades();
+         if (_nextSequence != sequence)
+            continue;
+
+         if (waitingForUpgrade)
+            omrthread_monitor_wait_timed(_monitor, TIERING_SAMPLE_INTERVAL_MS, 0);
+         else
+            omrthread_monitor_wait(_monitor);
+         continue;
+         }
+
+      omrthread_monitor_exit(_monitor);
+      compile(request);
+      omrthread_monitor_enter(_monitor);
+
+      unlinkRequest(request);
+      request->_next = _completed;
+      _completed = request;
+#if !defined(TR_TARGET_POWER) || !defined(__clang__)
+      VM_AtomicSupport::writeBarrier();
+#endif
+      request->_done = true;
+
+      // Wakes waiters and any worker that skipped a request sharing this
+      // request's TypeDictionary
+      omrthread_monitor_notify_all(_monitor);
+      }
+
+   _numActiveThreads--;
+   omrthread_monitor_notify_all(_monitor);
+   omrthread_exit(_monitor);
+   }
+
+int J9THREAD_PROC
+JitBuilder::CompilationQueue::compilationThreadProc(void *entryArg)
+   {
+   static_cast<CompilationQueue *>(entryArg)->run();
+   return 0;
+   }
@@ -0,0 +1,207 @@
+/*******************************************************************************
+ * Copyright (c) 2021, 2021 IBM Corp. and others
+ *
+ * This program and the accompanying materials are made available under
+ * the terms of the Eclipse Public License 2.0 which accompanies this
+ * distribution and is available at http://eclipse.org/legal/epl-2.0
+ * or the Apache License, Version 2.0 which accompanies this distribution
+ * and is available at https://www.apache.org/licenses/LICENSE-2.0.
+ *
+ * This Source Code may also be made available under the following Secondary
+ * Licenses when the conditions for such availability set forth in the
+ * Eclipse Public License, v. 2.0 are satisfied: GNU General Public License,
+ * version 2 with the GNU Classpath Exception [1] and GNU General Public
+ * License, version 2 with the OpenJDK Assembly Exception [2].
+ *
+ * [1] https://www.gnu.org/software/classpath/license.html
+ * [2] http://openjdk.java.net/legal/assembly-exception.html
+ *
+ * SPDX-License-Identifier: EPL-2.0 OR Apache-2.0 OR GPL-2.0 WITH Classpath-exception-2.0 OR LicenseRef-GPL-2.0 WITH Assembly-exception
+ *******************************************************************************/
+
+#ifndef JITBUILDER_COMPILATIONQUEUE_INCL
+#define JITBUILDER_COMPILATIONQUEUE_INCL
+
+#include <stdint.h>
+#include "compile/CompilationTypes.hpp"
+#include "omrthread.h"
+
+namespace TR { class MethodBuilder; }
+namespace TR { class TypeDictionary; }
+
+namespace JitBuilder
+{
+
+/**
+ * @brief Function called on the compilation thread once an asynchronous
+ *        compile has finished, whether or not it succeeded.
+ *
+ * `entryPoint` is NULL if the compile failed, in which case `returnCode`
+ * holds the reason.
+ */
+typedef void (*CompletionCallback)(void *entryPoint, int32_t returnCode, void *userData);
+
+class CompilationQueue;
+
+/**
+ * @brief A request to compile a MethodBuilder on a background thread.
+ *
+ * A request doubles as the future for its compile: isDone() may be polled
+ * from any thread and, once it answers true, entryPoint() and returnCode()
+ * hold the outcome.
+ */
+class CompilationRequest
+   {
+   friend class CompilationQueue;
+
+   public:
+
+   bool isDone() const;
+   void *entryPoint() const { return _entryPoint; }
+   int32_t returnCode() const { return _returnCode; }
+
+   TR::MethodBuilder *methodBuilder() const { return _methodBuilder; }
+   int32_t priority() const { return _priority; }
+
+   private:
+
+   CompilationRequest(TR::MethodBuilder *methodBuilder, int32_t priority, void **entrySlot, CompletionCallback callback, void *userData);
+
+   TR::MethodBuilder *_methodBuilder;
+   TR::TypeDictionary *_types;
+   TR_Hotness _hotness;
+   int32_t *_recompilationCounter;
+   int32_t _priority;
+   uint64_t _sequence;
+   void **_entrySlot;
+   CompletionCallback _callback;
+   void *_userData;
+
+   void * volatile _entryPoint;
+   volatile int32_t _returnCode;
+   volatile bool _done;
+
+   CompilationRequest *_next;
+   };
+
+/**
+ * @brief Tiering state of a builder whose first tier body is running.
+ *
+ * The record, and so the counter the body decrements, lives until the
+ * queue shuts down because the first tier body may still be running
+ * after the second tier body has been installed.
+ */
+struct TieredMethod
+   {
+   TR::MethodBuilder *_methodBuilder;
+   void **_entrySlot;
+   int32_t _priority;
+   int32_t _counter;
+   bool _upgraded;
+   TieredMethod *_next;
+   };
+
+/**
+ * @brief Compiles MethodBuilders on a pool of background threads so that the
+ *        requesting thread can keep interpreting until code is installed.
+ *
+ * Pending requests are kept ordered by descending priority and then by
+ * arrival. Each worker runs the ordinary synchronous compile path, so every
+ * compile gets its own scratch Region and SegmentProvider on the worker's
+ * stack, and all of them allocate from the shared CodeCacheManager.
+ *
+ * Builders that share a TypeDictionary are never compiled concurrently: the
+ * dictionary caches symbol references for struct and union fields for the
+ * duration of a compile. A worker skips over such a request and leaves it
+ * for whichever thread finishes the conflicting compile.
+ *
+ * The worker thread is started by the first asynchronous request. Only one
+ * is started for now, whatever the `compilationThreads=` option says, as
+ * the compiler still has state shared between compilations.
+ *
+ * With enableTieredCompilation, a request that has an entry slot is first
+ * compiled cold with a recompilation counter, which the body decrements on
+ * entry and on loop back edges. Idle workers check the counters every few
+ * milliseconds and queue a warm recompile for each one that has run out.
+ * The warm body is installed by storing it to the same entry slot, so
+ * callers that always call through the slot pick it up on their next call.
+ * Builders and entry slots of tiered requests must therefore stay valid
+ * until shutdownJit.
+ */
+class CompilationQueue
+   {
+   public:
+
+   static CompilationQueue *instance() { return _instance; }
+
+   static bool initialize();
+   static void shutdown();
+
+   /**
+    * @brief Queues a compile of `methodBuilder`.
+    *
+    * When the compile finishes, the entry point is stored to `*entrySlot`
+    * (if it is not NULL) before the request is marked done and before
+    * `callback` is run.
+    *
+    * @return the request, or NULL if the builder already has a compile
+    *         pending or the worker threads could not be started
+    */
+   CompilationRequest *enqueue(TR::MethodBuilder *methodBuilder, int32_t priority, void **entrySlot, CompletionCallback callback, void *userData);
+
+   /**
+    * @brief Blocks until the most recent request for `methodBuilder` has
+    *        finished and releases it.
+    *
+    * @return the compile's return code, or COMPILATION_REQUESTED if the
+    *         builder has never been queued
+    */
+   int32_t wait(TR::MethodBuilder *methodBuilder);
+
+   /**
+    * @brief Blocks until every queued request has finished.
+    */
+   void drain();
+
+   int32_t numThreads() const { return _numThreads; }
+
+   private:
+
+   CompilationQueue();
+
+   bool startThreads(int32_t numThreads);
+   void stopThreads();
+
+   CompilationRequest *createRequest(TR::MethodBuilder *methodBuilder, int32_t priority, void **entrySlot, CompletionCallback callback, void *userData);
+   CompilationRequest *findRequest(TR::MethodBuilder *methodBuilder);
+   void unlinkRequest(CompilationRequest *request);
+   void insertPending(CompilationRequest *request);
+   CompilationRequest *takeNextCompilable();
+   bool isBeingCompiled(TR::TypeDictionary *types);
+
+   TieredMethod *startTiering(TR::MethodBuilder *methodBuilder, int32_t priority, void **entrySlot);
+   bool scheduleUpgrades();
+
+   void compile(CompilationRequest *request);
+   void run();
+
+   static int J9THREAD_PROC compilationThreadProc(void *entryArg);
+
+   static CompilationQueue *_instance;
+
+   omrthread_monitor_t _monitor;
+
+   CompilationRequest *_pending;     // ordered by priority, then sequence
+   CompilationRequest *_inProgress;  // unordered
+   CompilationRequest *_completed;   // unordered, released by wait()
+   TieredMethod *_tieredMethods;
+
+   uint64_t _nextSequence;
+   int32_t _numThreads;
+   int32_t _numActiveThreads;
+   bool _stopping;
+   };
+
+} // namespace JitBuilder
+
+#endif // !defined(JITBUILDER_COMPILATIONQUEUE_INCL)
@@ -22,16 +22,20 @@
 
 #include <stdio.h>
 #include "codegen/CodeGenerator.hpp"
+#include "compile/Compilation.hpp"
 #include "compile/CompilationTypes.hpp"
 #include "compile/Method.hpp"
+#include "control/CompilationQueue.hpp"
 #include "control/CompileMethod.hpp"
 #include "env/CompilerEnv.hpp"
 #include "env/FrontEnd.hpp"
 #include "env/IO.hpp"
 #include "env/RawAllocator.hpp"
+#include "env/SegmentCache.hpp"
 #include "ilgen/IlGeneratorMethodDetails_inlines.hpp"
 #include "ilgen/MethodBuilder.hpp"
 #include "ilgen/TypeDictionary.hpp"
+#include "runtime/AOTCodeCache.hpp"
 #include "runtime/CodeCache.hpp"
 #include "runtime/Runtime.hpp"
 #include "runtime/JBJitConfig.hpp"
@@ -109,6 +113,29 @@ initializeCodeCache(TR::CodeCacheManager & codeCacheManager)
    TR::CodeCache *firstCodeCache = codeCacheManager.initialize(true, 1);
    }
 
+// The port library is only needed for the file backing the AOT code cache
+static OMRPortLibrary aotPortLibrary;
+
+static bool
+initializeAOTCodeCache()
+   {
+   const char *fileName = TR::Options::getCmdLineOptions()->getAOTCodeCacheFileName();
+   if (fileName == NULL)
+      return true;
+
+   if (omrport_init_library(&aotPortLibrary, sizeof(OMRPortLibrary)) != 0)
+      return false;
+
+   if (!TR_AOTCodeCache::initialize(&aotPortLibrary, fileName))
+      {
+      fprintf(stderr, "JIT: cannot open AOT code cache %s\n", fileName);
+      aotPortLibrary.port_shutdown_library(&aotPortLibrary);
+      return false;
+      }
+
+   return true;
+   }
+
 // helperIDs is an array of helper id corresponding to the addresses passed in "helpers"
 // helpers is an array of pointers to helpers that compiled code needs to reference
 //   currently this argument isn't needed by anything so this function can stay internal
@@ -145,6 +172,12 @@ initializeJitBuilder(TR_RuntimeHelper *helperIDs, void **helperAddresses, int32_
 
    initializeCodeCache(fe.codeCacheManager());
 
+   if (!JitBuilder::CompilationQueue::initialize())
+      return false;
+
+   if (!initializeAOTCodeCache())
+      return false;
+
    return true;
    }
 
@@ -166,6 +199,8 @@ initializeJitBuilder(TR_RuntimeHelper *helperIDs, void **helperAddresses, int32_
 // An individual program should link statically against JitBuilder, then call:
 //     initializeJit() or initializeJitWithOptions() to initialize the Jit
 //     compileMethodBuilder() as many times as needed to create compiled code
+//       (or compileMethodBuilderAsync() to compile on a background thread
+//        and waitForCompilation() to collect the result)
 //     shuwdownJit() when the test is complete
 //
 
@@ -185,9 +220,9 @@ internal_initializeJit()
    }
 
 int32_t
-internal_compileMethodBuilder(TR::MethodBuilder *m, void **entry)
+internal_compileMethodBuilderAtLevel(TR::MethodBuilder *m, void **entry, TR_Hotness hotness, int32_t *recompilationCounter)
    {
-   auto rc = m->Compile(entry);
+   auto rc = m->Compile(entry, hotness, recompilationCounter);
 
 #if defined(AIXPPC)
    struct FunctionDescriptor
@@ -210,13 +245,52 @@ internal_compileMethodBuilder(TR::MethodBuilder *m, void **entry)
    return rc;
    }
 
+int32_t
+internal_compileMethodBuilder(TR::MethodBuilder *m, void **entry)
+   {
+   return internal_compileMethodBuilderAtLevel(m, entry, warm, NULL);
+   }
+
+bool
+internal_compileMethodBuilderAsync(TR::MethodBuilder *m, int32_t priority, void **entry, void *completionCallback, void *userData)
+   {
+   JitBuilder::CompilationQueue *queue = JitBuilder::CompilationQueue::instance();
+   if (queue == NULL)
+      return false;
+
+   JitBuilder::CompletionCallback callback = (JitBuilder::CompletionCallback)completionCallback;
+   return queue->enqueue(m, priority, entry, callback, userData) != NULL;
+   }
+
+int32_t
+internal_waitForCompilation(TR::MethodBuilder *m)
+   {
+   JitBuilder::CompilationQueue *queue = JitBuilder::CompilationQueue::instance();
+   if (queue == NULL)
+      return COMPILATION_REQUESTED;
+
+   return queue->wait(m);
+   }
+
 void
 internal_shutdownJit()
    {
+   // Let queued compiles finish before the code cache goes away
+   JitBuilder::CompilationQueue::shutdown();
+
+   if (TR_AOTCodeCache::instance())
+      {
+      TR_AOTCodeCache::shutdown();
+      aotPortLibrary.port_shutdown_library(&aotPortLibrary);
+      }
+
    auto fe = JitBuilder::FrontEnd::instance();
 
    TR::CodeCacheManager &codeCacheManager = fe->codeCacheManager();
    codeCacheManager.destroy();
 
    TR::CompilationController::shutdown();
+
+   // Nothing compiles after this, so there is no reason to keep memory cached for it
+   TR::SegmentCache::instance().flush();
    }
@@ -61,6 +61,7 @@
 #include "optimizer/RegDepCopyRemoval.hpp"
 #include "optimizer/Simplifier.hpp"
 #include "optimizer/SinkStores.hpp"
+#include "optimizer/SLPVectorizer.hpp"
 #include "optimizer/TrivialDeadBlockRemover.hpp"
 #include "optimizer/GlobalValuePropagation.hpp"
 #include "optimizer/LocalValuePropagation.hpp"
@@ -101,6 +102,7 @@ static const OptimizationStrategy JBcoldStrategyOpts[] =
    { OMR::localCSE                                                                 },
    { OMR::basicBlockExtension                                                      },
    { OMR::cheapTacticalGlobalRegisterAllocatorGroup                                },
+   { OMR::endOpts                                                                  },
    };
 
 static const OptimizationStrategy JBwarmStrategyOpts[] =
@@ -137,6 +139,7 @@ static const OptimizationStrategy JBwarmStrategyOpts[] =
    { OMR::globalDeadStoreGroup,                                                    },
    { OMR::redundantGotoElimination,                  OMR::IfEnabled                }, // if global register allocator created new block
    { OMR::rematerialization                                                        },
+   { OMR::slpVectorizer                                                            }, // pack adjacent stores in straight-line code
    { OMR::deadTreesElimination,                      OMR::IfEnabled                }, // remove dead anchors created by check/store removal
    { OMR::deadTreesElimination,                      OMR::IfEnabled                }, // remove dead RegStores produced by previous deadTrees pass
    { OMR::regDepCopyRemoval                                                        },
@@ -197,6 +200,8 @@ Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *methodSymb
       new (comp->allocator()) TR::OptimizationManager(self(), TR_TrivialInliner::create, OMR::inlining);
    _opts[OMR::switchAnalyzer] =
       new (comp->allocator()) TR::OptimizationManager(self(), TR::SwitchAnalyzer::create, OMR::switchAnalyzer);
+   _opts[OMR::slpVectorizer] =
+      new (comp->allocator()) TR::OptimizationManager(self(), TR_SLPVectorizer::create, OMR::slpVectorizer);
 
    // Initialize optimization groups
    _opts[OMR::cheapTacticalGlobalRegisterAllocatorGroup] =
@@ -211,7 +216,7 @@ Optimizer::Optimizer(TR::Compilation *comp, TR::ResolvedMethodSymbol *methodSymb
 
 
    omrCompilationStrategies[noOpt] = JBwarmStrategyOpts;
-   omrCompilationStrategies[cold]  = JBwarmStrategyOpts;
+   omrCompilationStrategies[cold]  = JBcoldStrategyOpts;
    omrCompilationStrategies[warm]  = JBwarmStrategyOpts;
    omrCompilationStrategies[hot]   = JBwarmStrategyOpts;
 
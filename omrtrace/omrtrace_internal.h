@@ -183,6 +183,7 @@ typedef struct UtComponentData {
 	int                    numFormats;
 	char                   **tracepointFormattingStrings;
 	uint64_t               *tracepointcounters;
+	OMR_TraceSpanHistogram **spanHistograms;
 	int                    alreadyfailedtoloaddetails;
 	char                   *formatStringsFileName;
 	struct UtComponentData *prev;
@@ -274,6 +275,8 @@ omr_error_t setTracePointGroupTo(const char *groupName, UtComponentData *compone
 omr_error_t setTracePointsByLevelTo(UtComponentData *componentData, int level, unsigned char value, int32_t setActive);
 omr_error_t processComponentDefferedConfig(UtComponentData *componentData, UtComponentList *componentList);
 uint64_t incrementTraceCounter(UtModuleInfo *moduleInfo, UtComponentList *componentList, int32_t tracepoint);
+void recordSpanDuration(UtModuleInfo *moduleInfo, UtComponentList *componentList, int32_t tracepoint, uint64_t duration);
+omr_error_t copySpanHistogram(UtComponentData *componentData, int32_t tracepoint, OMR_TraceSpanHistogram *histogram);
 omr_error_t addTraceConfig(OMR_TraceThread *thr, const char *cmd);
 omr_error_t addTraceConfigKeyValuePair(OMR_TraceThread *thr, const char *cmdKey, const char *cmdValue);
 
@@ -471,6 +474,7 @@ BOOLEAN findRecordSubscriber(UtSubscription *subscription);
 omr_error_t destroyRecordSubscriber(OMR_TraceThread *thr, UtSubscription *subscription, BOOLEAN callAlarm);
 
 void listCounters(void);
+void listSpanHistograms(void);
 void initHeader(UtDataHeader *header, const char *name, uintptr_t size);
 int32_t getTraceLock(OMR_TraceThread *thr);
 int32_t freeTraceLock(OMR_TraceThread *thr);
@@ -509,11 +513,14 @@ void reportCommandLineError(BOOLEAN atRuntime, const char *detailStr, ...);
 omr_error_t trcRegisterRecordSubscriber(OMR_TraceThread *thr, const char *description, utsSubscriberCallback subscriber,
 										utsSubscriberAlarmCallback alarm, void *userData, UtSubscription **subscriptionReference);
 omr_error_t trcDeregisterRecordSubscriber(OMR_TraceThread *thr, UtSubscription *subscriptionID);
+omr_error_t trcGetSpanHistogram(const char *componentName, int32_t tracepoint, OMR_TraceSpanHistogram *histogram);
 
 /** Functions exposed to the outside world via the module interface and used outside main.c
  *  All functions on the module interface (and only functions on the module interface) start
  *  with j9 **/
 void omrTrace(void *env, UtModuleInfo *modInfo, uint32_t traceId, const char *spec, ...);
+uint64_t omrTraceSpanBegin(void *env, UtModuleInfo *modInfo, uint32_t traceId);
+uint64_t omrTraceSpanEnd(void *env, UtModuleInfo *modInfo, uint32_t traceId, uint64_t startTime);
 
 
 /**
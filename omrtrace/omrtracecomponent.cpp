@@ -41,6 +41,8 @@
 #include "ute_core.h"
 #include "omrutil.h"
 
+#include "AtomicSupport.hpp"
+
 static const char *UT_MISSING_TRACE_FORMAT = "  Tracepoint format not in dat file";
 #define MAX_QUALIFIED_NAME_LENGTH 16
 
@@ -96,6 +98,7 @@ initializeComponentData(UtComponentData **componentDataPtr, UtModuleInfo *module
 	componentData->numFormats = 0;
 	componentData->tracepointFormattingStrings = NULL;
 	componentData->tracepointcounters = NULL;
+	componentData->spanHistograms = NULL;
 	componentData->alreadyfailedtoloaddetails = 0;
 	componentData->next = NULL;
 	componentData->prev = NULL;
@@ -138,6 +141,15 @@ freeComponentData(OMR_TraceGlobal *global, UtComponentData *componentDataPtr)
 		omrmem_free_memory(componentDataPtr->tracepointcounters);
 	}
 
+	if (componentDataPtr->spanHistograms != NULL) {
+		for (i = 0; i < componentDataPtr->tracepointCount; i++) {
+			if (componentDataPtr->spanHistograms[i] != NULL) {
+				omrmem_free_memory(componentDataPtr->spanHistograms[i]);
+			}
+		}
+		omrmem_free_memory(componentDataPtr->spanHistograms);
+	}
+
 	if (componentDataPtr->qualifiedComponentName != componentDataPtr->componentName && componentDataPtr->qualifiedComponentName != NULL) {
 		omrmem_free_memory(componentDataPtr->qualifiedComponentName);
 	}
@@ -1460,3 +1472,128 @@ incrementTraceCounter(UtModuleInfo *moduleInfo, UtComponentList *componentList,
 	return ++compData->tracepointcounters[tracepoint];
 }
 
+/*
+ * Map a duration to its log-linear histogram bucket. See OMR_TraceSpanHistogram.
+ */
+static uintptr_t
+spanBucketIndex(uint64_t duration)
+{
+	uintptr_t highBit = 0;
+	uintptr_t shift = 32;
+	uint64_t value = duration;
+
+	if (duration < OMR_TRACE_SPAN_SUB_BUCKETS) {
+		return (uintptr_t)duration;
+	}
+	/* Binary search for the most significant set bit. */
+	while (shift > 0) {
+		if (0 != (value >> shift)) {
+			value >>= shift;
+			highBit += shift;
+		}
+		shift >>= 1;
+	}
+
+	return ((highBit - OMR_TRACE_SPAN_SUB_BUCKET_BITS + 1) << OMR_TRACE_SPAN_SUB_BUCKET_BITS)
+		+ (uintptr_t)((duration >> (highBit - OMR_TRACE_SPAN_SUB_BUCKET_BITS)) & (OMR_TRACE_SPAN_SUB_BUCKETS - 1));
+}
+
+/*
+ * Lazily allocate the histogram for a span tracepoint. Racing threads may both allocate;
+ * the loser frees its copy and uses the published one.
+ */
+static OMR_TraceSpanHistogram *
+getSpanHistogram(UtComponentData *compData, int32_t tracepoint)
+{
+	OMR_TraceSpanHistogram **histograms = compData->spanHistograms;
+	OMR_TraceSpanHistogram *histogram = NULL;
+
+	OMRPORT_ACCESS_FROM_OMRPORT(OMR_TRACEGLOBAL(portLibrary));
+
+	if (histograms == NULL) {
+		uintptr_t size = sizeof(OMR_TraceSpanHistogram *) * compData->moduleInfo->count;
+		histograms = (OMR_TraceSpanHistogram **)omrmem_allocate_memory(size, OMRMEM_CATEGORY_TRACE);
+		if (histograms == NULL) {
+			UT_DBGOUT(1, ("<UT> Unable to allocate span histograms for %s\n", compData->qualifiedComponentName));
+			return NULL;
+		}
+		memset(histograms, 0, size);
+		if (0 != VM_AtomicSupport::lockCompareExchange((volatile uintptr_t *)&compData->spanHistograms, (uintptr_t)NULL, (uintptr_t)histograms)) {
+			omrmem_free_memory(histograms);
+			histograms = compData->spanHistograms;
+		}
+	}
+
+	histogram = histograms[tracepoint];
+	if (histogram == NULL) {
+		histogram = (OMR_TraceSpanHistogram *)omrmem_allocate_memory(sizeof(OMR_TraceSpanHistogram), OMRMEM_CATEGORY_TRACE);
+		if (histogram == NULL) {
+			UT_DBGOUT(1, ("<UT> Unable to allocate span histogram for %s.%d\n", compData->qualifiedComponentName, tracepoint));
+			return NULL;
+		}
+		memset(histogram, 0, sizeof(OMR_TraceSpanHistogram));
+		histogram->minNanos = (uint64_t)-1;
+		if (0 != VM_AtomicSupport::lockCompareExchange((volatile uintptr_t *)&histograms[tracepoint], (uintptr_t)NULL, (uintptr_t)histogram)) {
+			omrmem_free_memory(histogram);
+			histogram = histograms[tracepoint];
+		}
+	}
+
+	return histogram;
+}
+
+void
+recordSpanDuration(UtModuleInfo *moduleInfo, UtComponentList *componentList, int32_t tracepoint, uint64_t duration)
+{
+	UtComponentData *compData = NULL;
+	OMR_TraceSpanHistogram *histogram = NULL;
+	uint64_t oldValue = 0;
+
+	if (moduleInfo == NULL) {
+		return;
+	}
+	compData = getComponentDataForModule(moduleInfo, componentList);
+	if ((compData == NULL) || (compData->moduleInfo == NULL) || (tracepoint >= compData->moduleInfo->count)) {
+		UT_DBGOUT(1, ("<UT> Unable to record span duration %s.%d - no such loaded component\n", moduleInfo->name, tracepoint));
+		return;
+	}
+	histogram = getSpanHistogram(compData, tracepoint);
+	if (histogram == NULL) {
+		return;
+	}
+
+	VM_AtomicSupport::addU64(&histogram->buckets[spanBucketIndex(duration)], 1);
+	VM_AtomicSupport::addU64(&histogram->totalNanos, duration);
+	VM_AtomicSupport::addU64(&histogram->count, 1);
+
+	oldValue = histogram->minNanos;
+	while ((duration < oldValue) && (oldValue != VM_AtomicSupport::lockCompareExchangeU64(&histogram->minNanos, oldValue, duration))) {
+		oldValue = histogram->minNanos;
+	}
+	oldValue = histogram->maxNanos;
+	while ((duration > oldValue) && (oldValue != VM_AtomicSupport::lockCompareExchangeU64(&histogram->maxNanos, oldValue, duration))) {
+		oldValue = histogram->maxNanos;
+	}
+}
+
+omr_error_t
+copySpanHistogram(UtComponentData *componentData, int32_t tracepoint, OMR_TraceSpanHistogram *histogram)
+{
+	OMR_TraceSpanHistogram *source = NULL;
+
+	if ((tracepoint < 0) || (tracepoint >= componentData->tracepointCount)) {
+		return OMR_ERROR_ILLEGAL_ARGUMENT;
+	}
+	if (componentData->spanHistograms != NULL) {
+		source = componentData->spanHistograms[tracepoint];
+	}
+	if (source == NULL) {
+		return OMR_ERROR_NOT_AVAILABLE;
+	}
+
+	memcpy(histogram, source, sizeof(OMR_TraceSpanHistogram));
+	if (0 == histogram->count) {
+		histogram->minNanos = 0;
+	}
+	return OMR_ERROR_NONE;
+}
@@ -1198,6 +1198,51 @@ omrTrace(void *env, UtModuleInfo *modInfo, uint32_t traceId, const char *spec, .
 	}
 }
 
+/*******************************************************************************
+ * name        - omrTraceSpanBegin
+ * description - Start timing a span tracepoint
+ * parameters  - env, module info and tracepoint identifier.
+ * returns     - A non-zero start time, or 0 if trace is not running.
+ ******************************************************************************/
+uint64_t
+omrTraceSpanBegin(void *env, UtModuleInfo *modInfo, uint32_t traceId)
+{
+	uint64_t startTime = 0;
+
+	if ((NULL != omrTraceGlobal) && (OMR_TRACE_ENGINE_SHUTDOWN_STARTED != OMR_TRACEGLOBAL(initState))) {
+		OMRPORT_ACCESS_FROM_OMRPORT(OMR_TRACEGLOBAL(portLibrary));
+		startTime = omrtime_nano_time();
+		if (0 == startTime) {
+			/* 0 means "not timed" to the generated _End macro. */
+			startTime = 1;
+		}
+	}
+	return startTime;
+}
+
+/*******************************************************************************
+ * name        - omrTraceSpanEnd
+ * description - Record the duration of a span tracepoint in its histogram
+ * parameters  - env, module info, tracepoint identifier and the start time
+ *               returned by omrTraceSpanBegin.
+ * returns     - The span duration in nanoseconds.
+ ******************************************************************************/
+uint64_t
+omrTraceSpanEnd(void *env, UtModuleInfo *modInfo, uint32_t traceId, uint64_t startTime)
+{
+	uint64_t duration = 0;
+
+	if ((NULL != omrTraceGlobal) && (OMR_TRACE_ENGINE_SHUTDOWN_STARTED != OMR_TRACEGLOBAL(initState))) {
+		OMRPORT_ACCESS_FROM_OMRPORT(OMR_TRACEGLOBAL(portLibrary));
+		uint64_t endTime = omrtime_nano_time();
+		if (endTime > startTime) {
+			duration = endTime - startTime;
+		}
+		recordSpanDuration(modInfo, OMR_TRACEGLOBAL(componentList), (int32_t)((traceId >> 8) & UT_TRC_ID_MASK), duration);
+	}
+	return duration;
+}
+
 /*******************************************************************************
  * name        - doTracePoint
  * description - Make a tracepoint, not called directly outside of rastrace
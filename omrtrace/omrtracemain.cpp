@@ -310,6 +310,8 @@ utTerminateTrace(void)
 		listCounters();
 	}
 
+	listSpanHistograms();
+
 	if (OMR_TRACEGLOBAL(lostRecords) != 0) {
 		UT_DBGOUT(1, ("<UT> Discarded %d trace buffers\n", OMR_TRACEGLOBAL(lostRecords)));
 	}
@@ -797,6 +799,31 @@ trcSetOptions(OMR_TraceThread *thr, const char *opts[])
 	return setOptions(thr, opts, TRUE);
 }
 
+/*******************************************************************************
+ * name        - trcGetSpanHistogram
+ * description - Copies the latency histogram of a span tracepoint
+ * parameters  - componentName, tracepoint, histogram
+ * returns     - OMR_ERROR_NOT_AVAILABLE if the span has never been recorded
+ ******************************************************************************/
+omr_error_t
+trcGetSpanHistogram(const char *componentName, int32_t tracepoint, OMR_TraceSpanHistogram *histogram)
+{
+	UtComponentData *componentData = NULL;
+
+	if ((NULL == componentName) || (NULL == histogram)) {
+		return OMR_ERROR_ILLEGAL_ARGUMENT;
+	}
+	if (NULL == omrTraceGlobal) {
+		return OMR_ERROR_NOT_AVAILABLE;
+	}
+
+	componentData = getComponentData(componentName, OMR_TRACEGLOBAL(componentList));
+	if (NULL == componentData) {
+		return OMR_ERROR_NOT_AVAILABLE;
+	}
+	return copySpanHistogram(componentData, tracepoint, histogram);
+}
+
 static void
 setStartTime(void)
 {
@@ -841,6 +868,7 @@ fillInUTInterfaces(UtInterface **utIntf, OMR_TraceInterface *omrTraceIntf, UtMod
 		omrTraceIntf->FlushTraceData				= trcFlushTraceData;
 		omrTraceIntf->GetTraceMetadata				= trcGetTraceMetadata;
 		omrTraceIntf->SetOptions					= trcSetOptions;
+		omrTraceIntf->GetSpanHistogram				= trcGetSpanHistogram;
 
 		/*
 		 * Initialize the direct module interface, these are
@@ -851,6 +879,8 @@ fillInUTInterfaces(UtInterface **utIntf, OMR_TraceInterface *omrTraceIntf, UtMod
 		utModuleIntf->Trace           = omrTrace;
 		utModuleIntf->TraceInit       = omrTraceInit;
 		utModuleIntf->TraceTerm       = omrTraceTerm;
+		utModuleIntf->TraceSpanBegin  = omrTraceSpanBegin;
+		utModuleIntf->TraceSpanEnd    = omrTraceSpanEnd;
 
 		/*
 		 * Make the interfaces available.
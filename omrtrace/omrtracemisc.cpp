@@ -254,6 +254,95 @@ listCounters(void)
 #undef TEMPBUFLEN
 }
 
+/*******************************************************************************
+ * name        - spanPercentile
+ * description - Estimate a percentile from a span histogram
+ * parameters  - histogram, percentile in tenths of a percent
+ * returns     - the upper bound of the bucket holding the percentile, in ns
+ ******************************************************************************/
+static uint64_t
+spanPercentile(OMR_TraceSpanHistogram *histogram, uint64_t permille)
+{
+	uint64_t target = ((histogram->count * permille) + 999) / 1000;
+	uint64_t seen = 0;
+	uintptr_t i = 0;
+
+	for (i = 0; i < OMR_TRACE_SPAN_BUCKETS; i++) {
+		seen += histogram->buckets[i];
+		if (seen >= target) {
+			uint64_t upper = i;
+			if (i >= OMR_TRACE_SPAN_SUB_BUCKETS) {
+				uintptr_t shift = (i >> OMR_TRACE_SPAN_SUB_BUCKET_BITS) - 1;
+				uint64_t lower = ((uint64_t)OMR_TRACE_SPAN_SUB_BUCKETS + (i & (OMR_TRACE_SPAN_SUB_BUCKETS - 1))) << shift;
+				upper = lower + (((uint64_t)1 << shift) - 1);
+			}
+			return (upper < histogram->maxNanos) ? upper : histogram->maxNanos;
+		}
+	}
+	return histogram->maxNanos;
+}
+
+/*******************************************************************************
+ * name        - listSpanHistograms
+ * description - Print a latency summary for every span tracepoint that
+ *               recorded at least one duration.
+ * parameters  - void
+ * returns     - void
+ ******************************************************************************/
+void
+listSpanHistograms(void)
+{
+	int           i;
+#define TEMPBUFLEN 256
+	char          tempBuf[TEMPBUFLEN];
+	intptr_t         f = -1;
+	BOOLEAN       opened = FALSE;
+	UtComponentList *lists[2];
+	int           listIndex;
+	OMRPORT_ACCESS_FROM_OMRPORT(OMR_TRACEGLOBAL(portLibrary));
+
+	lists[0] = OMR_TRACEGLOBAL(componentList);
+	lists[1] = OMR_TRACEGLOBAL(unloadedComponentList);
+
+	for (listIndex = 0; listIndex < 2; listIndex++) {
+		UtComponentData *compData = (NULL == lists[listIndex]) ? NULL : lists[listIndex]->head;
+		while (compData != NULL) {
+			if (compData->spanHistograms != NULL) {
+				for (i = 0; i < compData->tracepointCount; i++) {
+					OMR_TraceSpanHistogram *histogram = compData->spanHistograms[i];
+					if ((histogram != NULL) && (histogram->count > 0)) {
+						if (!opened) {
+							UT_DBGOUT(1, ("<UT> Listing span histograms\n"));
+							if ((f = omrfile_open("utTrcSpans", EsOpenText | EsOpenWrite | EsOpenTruncate | EsOpenCreateNoTag, 0)) < 0) {
+								f = omrfile_open("utTrcSpans", EsOpenText | EsOpenWrite | EsOpenCreate | EsOpenCreateNoTag, 0666);
+							}
+							opened = TRUE;
+						}
+						omrstr_printf(tempBuf, TEMPBUFLEN, "%s.%d count=%llu min=%llu mean=%llu p50=%llu p90=%llu p99=%llu p99.9=%llu max=%llu ns\n",
+							compData->qualifiedComponentName, i, histogram->count, histogram->minNanos,
+							histogram->totalNanos / histogram->count,
+							spanPercentile(histogram, 500), spanPercentile(histogram, 900),
+							spanPercentile(histogram, 990), spanPercentile(histogram, 999),
+							histogram->maxNanos);
+						if (f < 0) {
+							omrtty_err_printf("%s", tempBuf);
+						} else {
+							/* convert to ebcdic if on zos */
+							omrfile_write_text(f, tempBuf, strlen(tempBuf));
+						}
+					}
+				}
+			}
+			compData = compData->next;
+		}
+	}
+
+	if (f >= 0) {
+		omrfile_close(f);
+	}
+#undef TEMPBUFLEN
+}
+
 /*******************************************************************************
  * name        - getTimestamp
  * description - Get the time in various component units
@@ -636,7 +636,9 @@ void *
 omrvmem_commit_memory(struct OMRPortLibrary *portLibrary, void *address, uintptr_t byteAmount, struct J9PortVmemIdentifier *identifier)
 {
 	void *rc = NULL;
+	uint64_t spanStart = 0;
 	Trc_PRT_vmem_omrvmem_commit_memory_Entry(address, byteAmount);
+	spanStart = Trc_PRT_vmem_omrvmem_commit_memory_Span_Begin();
 
 	if (rangeIsValid(identifier, address, byteAmount)) {
 		ASSERT_VALUE_IS_PAGE_SIZE_ALIGNED(address, identifier->pageSize);
@@ -668,6 +670,7 @@ omrvmem_commit_memory(struct OMRPortLibrary *portLibrary, void *address, uintptr
 	printf("\t\tomrvmem_commit_memory returning %p\n", rc);
 	fflush(stdout);
 #endif
+	Trc_PRT_vmem_omrvmem_commit_memory_Span_End(spanStart, address, byteAmount, rc);
 	Trc_PRT_vmem_omrvmem_commit_memory_Exit(rc);
 	return rc;
 }
@@ -833,6 +833,7 @@ omrfile_sync(struct OMRPortLibrary *portLibrary, intptr_t inFD)
 {
 	int fd = (int)inFD;
 	int32_t result = 0;
+	uint64_t spanStart = 0;
 
 	Trc_PRT_file_sync_Entry(inFD);
 
@@ -854,7 +855,9 @@ omrfile_sync(struct OMRPortLibrary *portLibrary, intptr_t inFD)
 #error FD_BIAS must be 0
 #endif
 
+	spanStart = Trc_PRT_file_sync_Span_Begin();
 	result = fsync(fd - FD_BIAS);
+	Trc_PRT_file_sync_Span_End(spanStart, inFD, result);
 	Trc_PRT_file_sync_Exit(result);
 	return result;
 }
@@ -42,6 +42,7 @@ DATFileWriter::writeOutputFiles(J9TDFOptions *options, J9TDFFile *tdf)
 	char entryExitChar = ' ';
 	char explicitChar = 'N';
 	const char *format = NULL;
+	TraceEventType datType = UT_EVENT_TYPE;
 
 	const char *fileName = FileUtils::getTargetFileName(options, tdf->fileName, UT_FILENAME_PREFIX, tdf->header.executable, ".pdat");
 
@@ -113,7 +114,12 @@ DATFileWriter::writeOutputFiles(J9TDFOptions *options, J9TDFFile *tdf)
 				explicitChar = 'Y';
 			}
 
-			fprintf(datFile, datLineTemplate, tdf->header.executable, id, tp->type, tp->overhead, tp->level, explicitChar, tp->name, exceptChar, entryExitChar, format);
+			/* Only the outlier event of a span is ever written to a trace buffer, so
+			 * formatters see it as a regular event.
+			 */
+			datType = (UT_SPAN_TYPE == tp->type) ? UT_EVENT_TYPE : tp->type;
+
+			fprintf(datFile, datLineTemplate, tdf->header.executable, id, datType, tp->overhead, tp->level, explicitChar, tp->name, exceptChar, entryExitChar, format);
 			tp = tp->nexttp;
 			id += 1;
 		}
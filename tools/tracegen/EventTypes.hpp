@@ -43,7 +43,8 @@ typedef enum TraceEventType {
 	UT_PERF_TYPE		= 10,
 	UT_PERF_EXCPT_TYPE	= 11,
 	UT_ASSERT_TYPE		= 12,
-	UT_MAX_TYPES		= 13,
+	UT_SPAN_TYPE		= 13,
+	UT_MAX_TYPES		= 14,
 	TraceEventType_EnsureWideEnum = 0x1000000 /* force 4-byte enum */
 } TraceEventType;
 
@@ -75,6 +75,7 @@ TDFParser::parse()
 		 *   TracePerf (Unused)
 		 *   TracePerf-Exception (Unused)
 		 *   TraceAssert
+		 *   TraceSpan
 		 */
 		if (0 == strlen(line) || StringUtils::startsWithUpperLower(line, "//") || StringUtils::startsWithUpperLower(line, "\n") || StringUtils::startsWithUpperLower(line, "\r")) {
 			/* skip */
@@ -267,6 +268,18 @@ TDFParser::processTracePointDetail(const char *line, J9TDFTracepoint *tp, const
 			Port::omrmem_free((void **)&tokLine);
 			tokLine = strdup(line);
 			tok = strtok(tokLine, " \t");
+		} else if (StringUtils::startsWithUpperLower(tok, "Outlier=")) {
+			if (RC_OK != StringUtils::getPositiveIntValue(tok, "Outlier=", &tp->outlierMicros)) {
+				goto failed;
+			}
+			tp->hasOutlier = true;
+			line = line + strlen(tok);
+			while ((' ' == *line  || '\t' == *line) && '\0' != *line) {
+				line = line + 1;
+			}
+			Port::omrmem_free((void **)&tokLine);
+			tokLine = strdup(line);
+			tok = strtok(tokLine, " \t");
 		} else if (StringUtils::startsWithUpperLower(tok, "Group=")) {
 			tp->groups = getGroups(tok);
 			line = line + strlen(tok);
@@ -298,6 +311,30 @@ TDFParser::processTracePointDetail(const char *line, J9TDFTracepoint *tp, const
 		strcpy(tp ->format,  "null");
 	}
 
+	if (tp->hasOutlier && (UT_SPAN_TYPE != tp->type)) {
+		FileUtils::printError("WARNING : keyword 'Outlier' is only valid for TraceSpan in %s:%u\n", fileName, lineNumber);
+		tp->hasOutlier = false;
+	}
+
+	if (UT_SPAN_TYPE == tp->type) {
+		/* The outlier event of a span records the measured duration as its first parameter. */
+		const char *spanPrefix = "%llu ns ";
+		char *spanFormat = NULL;
+		if (0 == strcmp(tp->format, "null")) {
+			spanPrefix = "%llu ns";
+			tp->format[0] = '\0';
+		}
+		spanFormat = (char *)Port::omrmem_calloc(1, strlen(spanPrefix) + strlen(tp->format) + 1);
+		if (NULL == spanFormat) {
+			FileUtils::printError("Failed to allocate memory\n");
+			goto failed;
+		}
+		strcpy(spanFormat, spanPrefix);
+		strcat(spanFormat, tp->format);
+		Port::omrmem_free((void **)&tp->format);
+		tp->format = spanFormat;
+	}
+
 	if (UT_ASSERT_TYPE == tp->type) {
 		/* Assertion parameters are always \"\\377\\4\\377\" for "** ASSERTION FAILED ** at %s:%d: %s" */
 		tp->parameters = NULL;
@@ -881,7 +918,8 @@ TDFParser::findTraceTypeIndex(const char *traceLine, int *result)
 		"TraceDebug-Exception",
 		"TracePerf",
 		"TracePerf-Exception",
-		"TraceAssert"
+		"TraceAssert",
+		"TraceSpan"
 	};
 
 	for (int type = 0; UT_MAX_TYPES > type; type++) {
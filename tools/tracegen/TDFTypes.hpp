@@ -74,6 +74,8 @@ typedef struct J9TDFTracepoint {
 	unsigned int overhead;
 	unsigned int level;
 	unsigned int parmCount;
+	unsigned int outlierMicros;
+	bool hasOutlier;
 	bool hasEnv;
 	bool obsolete;
 	bool test;
@@ -88,6 +90,8 @@ typedef struct J9TDFTracepoint {
 		, overhead(0)
 		, level(0)
 		, parmCount(0)
+		, outlierMicros(0)
+		, hasOutlier(false)
 		, hasEnv(false)
 		, obsolete(false)
 		, test(false)
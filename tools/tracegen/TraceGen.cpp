@@ -405,7 +405,8 @@ TraceGen::calculateGroups(J9TDFOptions *options, J9TDFFile *tdf, unsigned int *g
 		"Debug-Exception",
 		"Perf",
 		"Perf-Exception",
-		"Assertion"
+		"Assertion",
+		"Span"
 	};
 
 	J9TDFTracepoint *tp = tdf->tracepoints;
@@ -127,6 +127,38 @@ const char *TP_TEMPLATE =
 "#define %s(%s%s)   /* tracepoint name: %s.%u */\n"
 "#endif\n\n";
 
+/* Span trace point template.
+ * A span expands to a pair of macros: <name>_Begin yields a start time (0 if the
+ * tracepoint is disabled) and <name>_End records the elapsed time into the
+ * tracepoint's latency histogram. When an outlier threshold is given, spans that
+ * take at least that long are also logged as a regular event whose first
+ * parameter is the duration in nanoseconds.
+ */
+const char *TP_SPAN_TEMPLATE =
+"#if UT_TRACE_OVERHEAD >= %u\n"
+"%s" /* Place holder for option test macro (specified by "Test" option in tp spec) */
+"#define %s_Begin(%s) ((((unsigned char) %s_UtActive[%u] != 0) && (NULL != %s_UtModuleInfo.intf->TraceSpanBegin)) ? \\\n"
+"	%s_UtModuleInfo.intf->TraceSpanBegin(%s, &%s_UtModuleInfo, (%uu << 8)) : (uint64_t)0) /* tracepoint name: %s.%u */\n"
+"#define %s_End(%s%s) do { /* tracepoint name: %s.%u */ \\\n"
+"	if (((unsigned char) %s_UtActive[%u] != 0) && (0 != (start))){ \\\n"
+"		uint64_t utSpanDuration = %s_UtModuleInfo.intf->TraceSpanEnd(%s, &%s_UtModuleInfo, ((%uu << 8) | %s_UtActive[%u]), (start)); \\\n"
+"%s" /* Place holder for the outlier event */
+"		(void)utSpanDuration;} \\\n"
+"	} while(0)\n"
+"#else\n"
+"%s" /* Place holder for option test macro (specified by "Test" option in tp spec) */
+"#define %s_Begin(%s) ((uint64_t)0)   /* tracepoint name: %s.%u */\n"
+"#define %s_End(%s%s)   /* tracepoint name: %s.%u */\n"
+"#endif\n\n";
+
+const char *TP_SPAN_OUTLIER_TEMPLATE =
+"		if (utSpanDuration >= ((uint64_t)%u * 1000)) { \\\n"
+"			%s_UtModuleInfo.intf->Trace(%s, &%s_UtModuleInfo, ((%uu << 8) | %s_UtActive[%u]), %s, utSpanDuration%s);} \\\n";
+
+/* Outlier=0 logs every span. */
+const char *TP_SPAN_ALWAYS_TEMPLATE =
+"		%s_UtModuleInfo.intf->Trace(%s, &%s_UtModuleInfo, ((%uu << 8) | %s_UtActive[%u]), %s, utSpanDuration%s); \\\n";
+
 RCType
 TraceHeaderWriter::writeOutputFiles(J9TDFOptions *options, J9TDFFile *tdf)
 {
@@ -166,6 +198,8 @@ TraceHeaderWriter::writeOutputFiles(J9TDFOptions *options, J9TDFFile *tdf)
 		if (!tp->obsolete) {
 			if (UT_ASSERT_TYPE == tp->type) {
 				tpAssert(fd, tp->overhead, tp->test, tp->name, tdf->header.executable, id, tp->hasEnv, tp->format, tp->parmCount);
+			} else if (UT_SPAN_TYPE == tp->type) {
+				tpSpan(fd, tp->overhead, tp->test, tp->name, tdf->header.executable, id, tp->hasEnv, tp->parameters, tp->parmCount, tp->hasOutlier, tp->outlierMicros);
 			} else {
 				tpTemplate(fd, tp->overhead, tp->test, tp->name, tdf->header.executable, id, tp->hasEnv, tp->parameters, tp->parmCount, tdf->header.auxiliary);
 			}
@@ -436,6 +470,132 @@ failed:
 	return rc;
 }
 
+/* Span trace point.
+ * parmCount includes the leading duration parameter that the parser added to the
+ * template, so the macros take parmCount - 1 user parameters.
+ */
+RCType
+TraceHeaderWriter::tpSpan(FILE *fd, unsigned int overhead, unsigned int test, const char *name, const char *module, unsigned int id, unsigned int envParam, const char *parameters, unsigned int parmCount, bool hasOutlier, unsigned int outlierMicros)
+{
+	RCType rc = RC_FAILED;
+	unsigned int userParmCount = (parmCount > 0) ? (parmCount - 1) : 0;
+	const char *envString = envParam ? UT_ENV_PARAM : UT_NOENV_PARAM;
+
+	/* 5 characters allows "P999, " or nearly 1000 parameters. */
+	char *parmString = NULL;
+	char *outlier = NULL;
+	char *pos = NULL;
+	char *testMacro =  NULL;
+	char *testNop =  NULL;
+	char *testMacroTemplate = (char *)  "#define TrcEnabled_%s  (%s_UtActive[%u] != 0)\n";
+	char *testNopTemplate = (char *) "#define TrcEnabled_%s  (0)\n";
+
+	parmString = (char *)Port::omrmem_calloc(1, (userParmCount * sizeof(char) * 5) + 1);
+	if (NULL == parmString) {
+		eprintf("Failed to allocate memory");
+		goto failed;
+	}
+	pos = parmString;
+	for (unsigned int i = 0; i < userParmCount; i++) {
+		pos += sprintf(pos, ", P%u", i + 1);
+	}
+
+	if (hasOutlier) {
+		/* Allow 10 digits for each number + 1 for the null byte. */
+		outlier = (char *)Port::omrmem_calloc(1, strlen(TP_SPAN_OUTLIER_TEMPLATE) + (4 * strlen(module)) + strlen(envString) + strlen(parameters) + strlen(parmString) + 31);
+		if (NULL == outlier) {
+			eprintf("Failed to allocate memory");
+			goto failed;
+		}
+		if (0 == outlierMicros) {
+			sprintf(outlier, TP_SPAN_ALWAYS_TEMPLATE, module, envString, module, id, module, id, parameters, parmString);
+		} else {
+			sprintf(outlier, TP_SPAN_OUTLIER_TEMPLATE, outlierMicros, module, envString, module, id, module, id, parameters, parmString);
+		}
+	} else {
+		outlier = (char *)Port::omrmem_calloc(1, 1);
+		if (NULL == outlier) {
+			eprintf("Failed to allocate memory");
+			goto failed;
+		}
+	}
+
+	if (test) {
+		/* Allow 7 digits for tracepoints + 1 for the null byte. (Millions of trace points are unlikely.) */
+		testMacro = (char *)Port::omrmem_calloc(1, (strlen(testMacroTemplate) + strlen(name) + strlen(module) + 8));
+		if (NULL == testMacro) {
+			eprintf("Failed to allocate memory");
+			goto failed;
+		}
+		sprintf(testMacro, testMacroTemplate, name, module, id);
+
+		testNop = (char *)Port::omrmem_calloc(1, (strlen(testMacroTemplate) + strlen(name) + 1));
+		if (NULL == testNop) {
+			eprintf("Failed to allocate memory");
+			goto failed;
+		}
+		sprintf(testNop, testNopTemplate, name);
+	} else {
+		testMacro = (char *) "";
+		testNop = (char *) "";
+	}
+
+	if (0 <= fprintf(fd, TP_SPAN_TEMPLATE
+			, overhead
+			, testMacro
+			, name
+			, envParam ? "thr" : ""
+			, module
+			, id
+			, module
+			, module
+			, envString
+			, module
+			, id
+			, module
+			, id
+			, name
+			, envParam ? "thr, start" : "start"
+			, parmString
+			, module
+			, id
+			, module
+			, id
+			, module
+			, envString
+			, module
+			, id
+			, module
+			, id
+			, outlier
+			, testNop
+			, name
+			, envParam ? "thr" : ""
+			, module
+			, id
+			, name
+			, envParam ? "thr, start" : "start"
+			, parmString
+			, module
+			, id
+	)) {
+		rc = RC_OK;
+	} else {
+		rc = RC_FAILED;
+	}
+
+failed:
+	Port::omrmem_free((void **)&parmString);
+	Port::omrmem_free((void **)&outlier);
+
+	if (test) {
+		Port::omrmem_free((void **)&testMacro);
+		Port::omrmem_free((void **)&testNop);
+	}
+
+	return rc;
+}
+
 RCType
 TraceHeaderWriter::headerTemplate(J9TDFOptions *options, FILE *fd, const char *moduleName)
 {
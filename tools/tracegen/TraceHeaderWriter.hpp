@@ -53,6 +53,13 @@ private:
 	 */
 	RCType tpAssert(FILE *fd, unsigned int overhead, unsigned int test, const char *name, const char *module, unsigned int id, unsigned int envparam, const char *format, unsigned int formatParamCount);
 
+	/**
+	 * Output span trace point (Begin/End macro pair)
+	 * @param fd Output stream
+	 * @return RC_OK on success, RC_FAILED on failure
+	 */
+	RCType tpSpan(FILE *fd, unsigned int overhead, unsigned int test, const char *name, const char *module, unsigned int id, unsigned int envparam, const char *format, unsigned int formatParamCount, bool hasOutlier, unsigned int outlierMicros);
+
 	/**
 	 * Output file header
 	 * @param fd Output stream